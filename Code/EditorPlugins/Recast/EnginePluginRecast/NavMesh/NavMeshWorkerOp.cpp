@@ -4,6 +4,7 @@
 
 #include <Core/Assets/AssetFileHeader.h>
 #include <EditorEngineProcessFramework/EngineProcess/EngineProcessDocumentContext.h>
+#include <Foundation/IO/FileSystem/FileReader.h>
 #include <Foundation/IO/FileSystem/FileWriter.h>
 #include <Foundation/Utilities/Progress.h>
 #include <ToolsFoundation/Document/DocumentManager.h>
@@ -41,10 +42,24 @@ ezResult ezLongOpWorker_BuildNavMesh::Execute(ezProgress& progress, ezStreamWrit
   ezRecastNavMeshBuilder NavMeshBuilder;
   ezRecastNavMeshResourceDescriptor desc;
 
+  // the previous result is used to only rebuild the tiles whose geometry has changed
+  ezRecastNavMeshResourceDescriptor previousDesc;
+  bool bHasPreviousNavMesh = false;
+
+  {
+    ezFileReader file;
+    if (file.Open(m_sOutputPath).Succeeded())
+    {
+      ezAssetFileHeader header;
+      bHasPreviousNavMesh = header.Read(file).Succeeded() && previousDesc.Deserialize(file).Succeeded();
+    }
+  }
+
   if (!pgRange.BeginNextStep("Building NavMesh"))
     return EZ_FAILURE;
 
-  EZ_SUCCEED_OR_RETURN(NavMeshBuilder.Build(m_NavMeshConfig, m_ExtractedWorldGeometry, desc, progress));
+  EZ_SUCCEED_OR_RETURN(
+    NavMeshBuilder.Build(m_NavMeshConfig, m_ExtractedWorldGeometry, desc, progress, bHasPreviousNavMesh ? &previousDesc : nullptr));
 
   if (!pgRange.BeginNextStep("Writing Result"))
     return EZ_FAILURE;
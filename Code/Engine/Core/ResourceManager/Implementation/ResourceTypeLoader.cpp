@@ -67,6 +67,12 @@ void ezResourceLoaderFromFile::CloseDataStream(const ezResource* pResource, cons
   EZ_DEFAULT_DELETE(pData);
 }
 
+bool ezResourceLoaderFromFile::GetFileToPrefetch(const ezResource* pResource, ezStringBuilder& out_sFile) const
+{
+  out_sFile = pResource->GetResourceID();
+  return true;
+}
+
 bool ezResourceLoaderFromFile::IsResourceOutdated(const ezResource* pResource) const
 {
   // if we cannot find the target file, there is no point in trying to reload it -> claim it's up to date
@@ -15,6 +15,9 @@ void ezResourceManagerWorkerDataLoad::Execute()
   ezResource* pResourceToLoad = nullptr;
   ezResourceTypeLoader* pLoader = nullptr;
   ezUniquePtr<ezResourceTypeLoader> pCustomLoader;
+  constexpr ezUInt32 uiMaxFilesToPrefetch = 4;
+  ezHybridArray<ezString, uiMaxFilesToPrefetch> filesToPrefetch;
+  ezStringBuilder sFileToPrefetch;
 
   {
     EZ_LOCK(ezResourceManager::s_ResourceMutex);
@@ -38,6 +41,34 @@ void ezResourceManagerWorkerDataLoad::Execute()
       pResourceToLoad->m_Flags.Remove(ezResourceFlags::HasCustomDataLoader);
       pResourceToLoad->m_Flags.Add(ezResourceFlags::PreventFileReload);
     }
+
+    // the resources that are next in line will most likely be read from disk right after this one,
+    // so let the file system already bring their data into memory while this one is being loaded
+    auto& loadingQueue = ezResourceManager::s_State->s_LoadingQueue;
+    for (ezUInt32 i = 0; i < ezMath::Min(loadingQueue.GetCount(), uiMaxFilesToPrefetch); ++i)
+    {
+      ezResourceManager::LoadingInfo& li = loadingQueue[i];
+
+      if (li.m_bPrefetched || li.m_pResource->m_Flags.IsSet(ezResourceFlags::HasCustomDataLoader))
+        continue;
+
+      li.m_bPrefetched = true;
+
+      // only the loader knows whether the resource ID is a file
+      const ezResourceTypeLoader* pQueuedLoader = ezResourceManager::s_State->s_ResourceTypeLoader.GetValueOrDefault(li.m_pResource->GetDynamicRTTI(), nullptr);
+      if (pQueuedLoader == nullptr)
+        pQueuedLoader = li.m_pResource->GetDefaultResourceTypeLoader();
+
+      if (pQueuedLoader != nullptr && pQueuedLoader->GetFileToPrefetch(li.m_pResource, sFileToPrefetch))
+      {
+        filesToPrefetch.PushBack(sFileToPrefetch);
+      }
+    }
+  }
+
+  for (const ezString& sFile : filesToPrefetch)
+  {
+    ezFileSystem::PrefetchFile(sFile);
   }
 
   if (pLoader == nullptr)
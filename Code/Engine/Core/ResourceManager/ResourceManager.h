@@ -424,6 +424,7 @@ private:
   {
     float m_fPriority = 0;
     ezResource* m_pResource = nullptr;
+    bool m_bPrefetched = false; ///< Whether the file of the resource was already prefetched, or it has no file to prefetch.
 
     EZ_ALWAYS_INLINE bool operator==(const LoadingInfo& rhs) const { return m_pResource == rhs.m_pResource; }
     EZ_ALWAYS_INLINE bool operator<(const LoadingInfo& rhs) const { return m_fPriority < rhs.m_fPriority; }
@@ -49,6 +49,12 @@ public:
   /// Call ezResource::GetLoadedFileModificationTime() to query the file modification time that was returned
   /// through ezResourceLoadData::m_LoadedFileModificationDate.
   virtual bool IsResourceOutdated(const ezResource* pResource) const { return false; }
+
+  /// \brief If OpenDataStream() reads the data of the given resource from a single file, this function returns true and the path to that file.
+  ///
+  /// The resource manager uses this to prefetch the files of resources that are queued for loading. The default implementation returns false,
+  /// because resource IDs are not necessarily file paths.
+  virtual bool GetFileToPrefetch(const ezResource* pResource, ezStringBuilder& out_sFile) const { return false; }
 };
 
 /// \brief A default implementation of ezResourceTypeLoader for standard file loading.
@@ -62,6 +68,7 @@ public:
   virtual ezResourceLoadData OpenDataStream(const ezResource* pResource) override;
   virtual void CloseDataStream(const ezResource* pResource, const ezResourceLoadData& LoaderData) override;
   virtual bool IsResourceOutdated(const ezResource* pResource) const override;
+  virtual bool GetFileToPrefetch(const ezResource* pResource, ezStringBuilder& out_sFile) const override;
 };
 
 
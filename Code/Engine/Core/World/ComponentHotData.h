@@ -0,0 +1,84 @@
+#pragma once
+
+#include <Foundation/Containers/DynamicArray.h>
+
+#include <tuple>
+
+/// \brief Stores the frequently updated ('hot') fields of components in one array per field (structure of arrays).
+///
+/// Used by ezComponentManagerSoA. Element i of every field array belongs to the component at index i in the component storage.
+/// Fields are addressed by their index in the template argument list, e.g. GetField<0>() returns the first field.
+template <typename... Fields>
+class ezComponentHotData
+{
+public:
+  template <ezUInt32 FieldIndex>
+  using FieldType = typename std::tuple_element<FieldIndex, std::tuple<Fields...>>::type;
+
+  /// \brief A contiguous range of elements, which is passed to batched update functions.
+  class Slice
+  {
+  public:
+    /// \brief Returns the index of the first element in the slice. This is also the index of the corresponding component in the component storage.
+    ezUInt32 GetStartIndex() const { return m_uiStartIndex; }
+
+    /// \brief Returns the number of elements in the slice.
+    ezUInt32 GetCount() const { return m_uiCount; }
+
+    /// \brief Returns the contiguous values of the given field for all elements in the slice.
+    template <ezUInt32 FieldIndex>
+    ezArrayPtr<FieldType<FieldIndex>> GetField() const
+    {
+      return m_pHotData->template GetFieldArray<FieldIndex>().GetSubArray(m_uiStartIndex, m_uiCount);
+    }
+
+  private:
+    friend class ezComponentHotData<Fields...>;
+
+    Slice(ezComponentHotData<Fields...>* pHotData, ezUInt32 uiStartIndex, ezUInt32 uiCount);
+
+    ezComponentHotData<Fields...>* m_pHotData;
+    ezUInt32 m_uiStartIndex;
+    ezUInt32 m_uiCount;
+  };
+
+  ezComponentHotData(ezAllocatorBase* pAllocator);
+
+  /// \brief Returns the number of elements in each field array.
+  ezUInt32 GetCount() const;
+
+  /// \brief Returns the value of the given field for the element at uiIndex.
+  template <ezUInt32 FieldIndex>
+  FieldType<FieldIndex>& GetField(ezUInt32 uiIndex);
+
+  /// \brief Returns the value of the given field for the element at uiIndex.
+  template <ezUInt32 FieldIndex>
+  const FieldType<FieldIndex>& GetField(ezUInt32 uiIndex) const;
+
+  /// \brief Returns all values of the given field.
+  template <ezUInt32 FieldIndex>
+  ezArrayPtr<FieldType<FieldIndex>> GetFieldArray();
+
+  /// \brief Returns a slice over uiCount elements starting at uiStartIndex. The count is clamped to the available elements.
+  Slice GetSlice(ezUInt32 uiStartIndex, ezUInt32 uiCount);
+
+  /// \brief Appends a default constructed element to every field array.
+  void PushBack();
+
+  /// \brief Removes the element at uiIndex from every field array by moving the last element into its place.
+  void RemoveAtAndSwap(ezUInt32 uiIndex);
+
+  /// \brief Removes all elements.
+  void Clear();
+
+private:
+  template <typename Field>
+  static ezAllocatorBase* GetAllocatorForField(ezAllocatorBase* pAllocator)
+  {
+    return pAllocator;
+  }
+
+  std::tuple<ezDynamicArray<Fields>...> m_Fields;
+};
+
+#include <Core/World/Implementation/ComponentHotData_inl.h>
@@ -78,6 +78,11 @@ protected:
   virtual ezComponent* CreateComponentStorage() = 0;
   virtual void DeleteComponentStorage(ezComponent* pComponent, ezComponent*& out_pMovedComponent) = 0;
 
+  friend class ezComponent;
+
+  /// \brief Called whenever the result of IsActiveAndInitialized() might have changed for the given component.
+  virtual void OnComponentActiveStateChanged(ezComponent* pComponent);
+
   /// \endcond
 
   ezIdTable<ezComponentId, ezComponent*> m_Components;
@@ -154,6 +159,59 @@ private:
 
 //////////////////////////////////////////////////////////////////////////
 
+/// \brief Component manager that keeps the hot data of its components in parallel arrays and updates them in batches.
+///
+/// Simple per-frame components usually only read and write a few fields in their update, but these fields are interleaved with
+/// all the other (cold) data of the component. This manager stores the hot fields separately as a structure of arrays, which makes
+/// batched updates cache friendly and allows them to be vectorized.
+///
+/// ComponentType has to declare the type of its hot data (see Core/World/ComponentHotData.h) and a static batched update function:
+/// \code{.cpp}
+///   typedef ezComponentHotData<ezAngle, float> HotData;
+///   static void UpdateBatch(const HotData::Slice& slice, const ezWorld* pWorld);
+/// \endcode
+///
+/// The components are stored compactly, so the index of a component in the component storage is also the index of its hot data.
+/// Use GetHotField() to access the hot data of an individual component, e.g. in property setters or OnSimulationStarted().
+/// Slices passed to UpdateBatch() only contain components that are active and initialized. The manager keeps a flag per component
+/// next to the hot data for this, so the batched update never touches the components themselves.
+///
+/// If uiAsyncGranularity is not zero, UpdateBatch() is called in the Async phase, split into tasks of (at least) that many components.
+/// In that case UpdateBatch() must only write to the hot data inside the given slice.
+template <typename ComponentType, ezComponentUpdateType::Enum UpdateType, ezUInt16 uiAsyncGranularity = 0>
+class ezComponentManagerSoA final : public ezComponentManager<ComponentType, ezBlockStorageType::Compact>
+{
+public:
+  typedef typename ComponentType::HotData HotData;
+
+  ezComponentManagerSoA(ezWorld* pWorld);
+
+  virtual void Initialize() override;
+
+  /// \brief Returns the hot data of all components.
+  HotData& GetHotData() { return m_HotData; }
+
+  /// \brief Returns the hot data of all components.
+  const HotData& GetHotData() const { return m_HotData; }
+
+  /// \brief Returns the given hot field of a single component. The index of the component is looked up, which is O(number of storage blocks).
+  template <ezUInt32 FieldIndex>
+  typename HotData::template FieldType<FieldIndex>& GetHotField(const ComponentType* pComponent);
+
+  /// \brief Calls UpdateBatch() for all ranges of active components in the given update context.
+  void BatchedUpdate(const ezWorldModule::UpdateContext& context);
+
+protected:
+  virtual ezComponent* CreateComponentStorage() override;
+  virtual void DeleteComponentStorage(ezComponent* pComponent, ezComponent*& out_pMovedComponent) override;
+  virtual void OnComponentActiveStateChanged(ezComponent* pComponent) override;
+
+  HotData m_HotData;
+  ezDynamicArray<bool> m_ActiveFlags; // same index as the hot data, whether the component is active and initialized
+};
+
+//////////////////////////////////////////////////////////////////////////
+
 #define EZ_ADD_COMPONENT_FUNCTIONALITY(componentType, baseType, managerType)                                                                         \
 public:                                                                                                                                              \
   typedef managerType ComponentManagerType;                                                                                                          \
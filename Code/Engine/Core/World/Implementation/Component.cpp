@@ -31,6 +31,7 @@ void ezComponent::UpdateActiveState(bool bOwnerActive)
   if (m_ComponentFlags.IsSet(ezObjectFlags::ActiveState) != bSelfActive)
   {
     m_ComponentFlags.AddOrRemove(ezObjectFlags::ActiveState, bSelfActive);
+    m_pManager->OnComponentActiveStateChanged(this);
 
     if (IsInitialized())
     {
@@ -87,6 +88,7 @@ void ezComponent::EnsureInitialized()
 
     m_ComponentFlags.Remove(ezObjectFlags::Initializing);
     m_ComponentFlags.Add(ezObjectFlags::Initialized);
+    m_pManager->OnComponentActiveStateChanged(this);
   }
 }
 
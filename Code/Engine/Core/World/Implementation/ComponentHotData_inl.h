@@ -0,0 +1,70 @@
+
+template <typename... Fields>
+EZ_ALWAYS_INLINE ezComponentHotData<Fields...>::Slice::Slice(ezComponentHotData<Fields...>* pHotData, ezUInt32 uiStartIndex, ezUInt32 uiCount)
+  : m_pHotData(pHotData)
+  , m_uiStartIndex(uiStartIndex)
+  , m_uiCount(uiCount)
+{
+}
+
+template <typename... Fields>
+ezComponentHotData<Fields...>::ezComponentHotData(ezAllocatorBase* pAllocator)
+  : m_Fields(GetAllocatorForField<Fields>(pAllocator)...)
+{
+}
+
+template <typename... Fields>
+EZ_ALWAYS_INLINE ezUInt32 ezComponentHotData<Fields...>::GetCount() const
+{
+  return std::get<0>(m_Fields).GetCount();
+}
+
+template <typename... Fields>
+template <ezUInt32 FieldIndex>
+EZ_ALWAYS_INLINE typename ezComponentHotData<Fields...>::template FieldType<FieldIndex>& ezComponentHotData<Fields...>::GetField(ezUInt32 uiIndex)
+{
+  return std::get<FieldIndex>(m_Fields)[uiIndex];
+}
+
+template <typename... Fields>
+template <ezUInt32 FieldIndex>
+EZ_ALWAYS_INLINE const typename ezComponentHotData<Fields...>::template FieldType<FieldIndex>& ezComponentHotData<Fields...>::GetField(
+  ezUInt32 uiIndex) const
+{
+  return std::get<FieldIndex>(m_Fields)[uiIndex];
+}
+
+template <typename... Fields>
+template <ezUInt32 FieldIndex>
+EZ_ALWAYS_INLINE ezArrayPtr<typename ezComponentHotData<Fields...>::template FieldType<FieldIndex>> ezComponentHotData<Fields...>::GetFieldArray()
+{
+  return std::get<FieldIndex>(m_Fields).GetArrayPtr();
+}
+
+template <typename... Fields>
+typename ezComponentHotData<Fields...>::Slice ezComponentHotData<Fields...>::GetSlice(ezUInt32 uiStartIndex, ezUInt32 uiCount)
+{
+  const ezUInt32 uiTotalCount = GetCount();
+  uiStartIndex = ezMath::Min(uiStartIndex, uiTotalCount);
+  uiCount = ezMath::Min(uiCount, uiTotalCount - uiStartIndex);
+
+  return Slice(this, uiStartIndex, uiCount);
+}
+
+template <typename... Fields>
+void ezComponentHotData<Fields...>::PushBack()
+{
+  std::apply([](auto&... fieldArrays) { (fieldArrays.PushBack(Fields()), ...); }, m_Fields);
+}
+
+template <typename... Fields>
+void ezComponentHotData<Fields...>::RemoveAtAndSwap(ezUInt32 uiIndex)
+{
+  std::apply([uiIndex](auto&... fieldArrays) { (fieldArrays.RemoveAtAndSwap(uiIndex), ...); }, m_Fields);
+}
+
+template <typename... Fields>
+void ezComponentHotData<Fields...>::Clear()
+{
+  std::apply([](auto&... fieldArrays) { (fieldArrays.Clear(), ...); }, m_Fields);
+}
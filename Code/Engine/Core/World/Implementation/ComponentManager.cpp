@@ -41,6 +41,7 @@ void ezComponentManagerBase::DeleteComponent(ezComponent* pComponent)
 
   pComponent->m_InternalId.Invalidate();
   pComponent->m_ComponentFlags.Remove(ezObjectFlags::ActiveFlag | ezObjectFlags::ActiveState);
+  OnComponentActiveStateChanged(pComponent);
 
   GetWorld()->m_Data.m_DeadComponents.Insert(pComponent);
 }
@@ -97,6 +98,7 @@ void ezComponentManagerBase::DeinitializeComponent(ezComponent* pComponent)
   {
     pComponent->Deinitialize();
     pComponent->m_ComponentFlags.Remove(ezObjectFlags::Initialized);
+    OnComponentActiveStateChanged(pComponent);
   }
 
   if (ezGameObject* pOwner = pComponent->GetOwner())
@@ -105,6 +107,8 @@ void ezComponentManagerBase::DeinitializeComponent(ezComponent* pComponent)
   }
 }
 
+void ezComponentManagerBase::OnComponentActiveStateChanged(ezComponent* pComponent) {}
+
 void ezComponentManagerBase::PatchIdTable(ezComponent* pComponent)
 {
   ezComponentId id = pComponent->m_InternalId;
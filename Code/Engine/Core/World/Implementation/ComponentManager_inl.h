@@ -212,3 +212,98 @@ void ezComponentManagerSimple<ComponentType, UpdateType, StorageType>::SimpleUpd
     out_sName = sName;
   }
 }
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename ComponentType, ezComponentUpdateType::Enum UpdateType, ezUInt16 uiAsyncGranularity>
+ezComponentManagerSoA<ComponentType, UpdateType, uiAsyncGranularity>::ezComponentManagerSoA(ezWorld* pWorld)
+  : ezComponentManager<ComponentType, ezBlockStorageType::Compact>(pWorld)
+  , m_HotData(this->GetAllocator())
+  , m_ActiveFlags(this->GetAllocator())
+{
+}
+
+template <typename ComponentType, ezComponentUpdateType::Enum UpdateType, ezUInt16 uiAsyncGranularity>
+void ezComponentManagerSoA<ComponentType, UpdateType, uiAsyncGranularity>::Initialize()
+{
+  typedef ezComponentManagerSoA<ComponentType, UpdateType, uiAsyncGranularity> OwnType;
+
+  ezStringBuilder functionName;
+  functionName.Set(ezGetStaticRTTI<ComponentType>()->GetTypeName(), "::BatchedUpdate");
+
+  auto desc = ezWorldModule::UpdateFunctionDesc(ezWorldModule::UpdateFunction(&OwnType::BatchedUpdate, this), functionName);
+  desc.m_bOnlyUpdateWhenSimulating = (UpdateType == ezComponentUpdateType::WhenSimulating);
+
+  if (uiAsyncGranularity != 0)
+  {
+    desc.m_Phase = ezWorldModule::UpdateFunctionDesc::Phase::Async;
+    desc.m_uiGranularity = uiAsyncGranularity;
+  }
+
+  this->RegisterUpdateFunction(desc);
+}
+
+template <typename ComponentType, ezComponentUpdateType::Enum UpdateType, ezUInt16 uiAsyncGranularity>
+template <ezUInt32 FieldIndex>
+EZ_FORCE_INLINE typename ezComponentManagerSoA<ComponentType, UpdateType, uiAsyncGranularity>::HotData::template FieldType<FieldIndex>&
+ezComponentManagerSoA<ComponentType, UpdateType, uiAsyncGranularity>::GetHotField(const ComponentType* pComponent)
+{
+  return m_HotData.template GetField<FieldIndex>(this->m_ComponentStorage.GetIndex(pComponent));
+}
+
+template <typename ComponentType, ezComponentUpdateType::Enum UpdateType, ezUInt16 uiAsyncGranularity>
+void ezComponentManagerSoA<ComponentType, UpdateType, uiAsyncGranularity>::BatchedUpdate(const ezWorldModule::UpdateContext& context)
+{
+  const typename HotData::Slice slice = m_HotData.GetSlice(context.m_uiFirstComponentIndex, context.m_uiComponentCount);
+  const ezWorld* pWorld = this->GetWorld();
+
+  // split the range into runs of active components, in the common case of all components being active this is a single run
+  const ezUInt32 uiEndIndex = slice.GetStartIndex() + slice.GetCount();
+  ezUInt32 uiRunStart = slice.GetStartIndex();
+  ezUInt32 uiIndex = uiRunStart;
+
+  for (; uiIndex < uiEndIndex; ++uiIndex)
+  {
+    if (!m_ActiveFlags[uiIndex])
+    {
+      if (uiIndex > uiRunStart)
+      {
+        ComponentType::UpdateBatch(m_HotData.GetSlice(uiRunStart, uiIndex - uiRunStart), pWorld);
+      }
+
+      uiRunStart = uiIndex + 1;
+    }
+  }
+
+  if (uiIndex > uiRunStart)
+  {
+    ComponentType::UpdateBatch(m_HotData.GetSlice(uiRunStart, uiIndex - uiRunStart), pWorld);
+  }
+}
+
+template <typename ComponentType, ezComponentUpdateType::Enum UpdateType, ezUInt16 uiAsyncGranularity>
+ezComponent* ezComponentManagerSoA<ComponentType, UpdateType, uiAsyncGranularity>::CreateComponentStorage()
+{
+  // compact storage always appends, so the new component and its hot data have the same index
+  m_HotData.PushBack();
+  m_ActiveFlags.PushBack(false);
+  return this->m_ComponentStorage.Create();
+}
+
+template <typename ComponentType, ezComponentUpdateType::Enum UpdateType, ezUInt16 uiAsyncGranularity>
+void ezComponentManagerSoA<ComponentType, UpdateType, uiAsyncGranularity>::DeleteComponentStorage(
+  ezComponent* pComponent, ezComponent*& out_pMovedComponent)
+{
+  // compact storage moves the last component into the gap, mirror that for the hot data
+  const ezUInt32 uiIndex = this->m_ComponentStorage.GetIndex(static_cast<ComponentType*>(pComponent));
+  m_HotData.RemoveAtAndSwap(uiIndex);
+  m_ActiveFlags.RemoveAtAndSwap(uiIndex);
+
+  ezComponentManager<ComponentType, ezBlockStorageType::Compact>::DeleteComponentStorage(pComponent, out_pMovedComponent);
+}
+
+template <typename ComponentType, ezComponentUpdateType::Enum UpdateType, ezUInt16 uiAsyncGranularity>
+void ezComponentManagerSoA<ComponentType, UpdateType, uiAsyncGranularity>::OnComponentActiveStateChanged(ezComponent* pComponent)
+{
+  m_ActiveFlags[this->m_ComponentStorage.GetIndex(static_cast<ComponentType*>(pComponent))] = pComponent->IsActiveAndInitialized();
+}
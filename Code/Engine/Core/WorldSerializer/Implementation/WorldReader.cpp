@@ -5,6 +5,23 @@
 #include <Foundation/Types/ScopeExit.h>
 #include <Foundation/Utilities/Progress.h>
 
+// clang-format off
+EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezParallelDeserializationAttribute, 1, ezRTTIDefaultAllocator<ezParallelDeserializationAttribute>)
+EZ_END_DYNAMIC_REFLECTED_TYPE;
+// clang-format on
+
+namespace
+{
+  /// \brief The stream that a DeserializeTask reads from on the current thread, returned by ezWorldReader::GetStream() instead of m_pStream.
+  struct TaskStream
+  {
+    const ezWorldReader* m_pReader = nullptr;
+    ezStreamReader* m_pStream = nullptr;
+  };
+
+  thread_local TaskStream s_TaskStream;
+} // namespace
+
 ezWorldReader::FindComponentTypeCallback ezWorldReader::s_FindComponentTypeCallback;
 
 ezWorldReader::ezWorldReader() = default;
@@ -64,6 +81,7 @@ ezResult ezWorldReader::ReadWorldDescription(ezStreamReader& stream)
     ReadGameObjectDesc(m_ChildObjectsToCreate.ExpandAndGetRef());
   }
 
+  m_ComponentTypes.Clear();
   m_ComponentTypes.SetCount(uiNumComponentTypes);
   m_ComponentTypeVersions.Reserve(uiNumComponentTypes);
   for (ezUInt32 i = 0; i < uiNumComponentTypes; ++i)
@@ -92,10 +110,52 @@ ezUniquePtr<ezWorldReader::InstantiationContextBase> ezWorldReader::InstantiateP
     world, true, rootTransform, hParent, out_CreatedRootObjects, out_CreatedChildObjects, pOverrideTeamID, bForceDynamic, maxStepTime, pProgress);
 }
 
+void ezWorldReader::InstantiatePrefabs(ezWorld& world, ezArrayPtr<const ezTransform> rootTransforms, ezGameObjectHandle hParent,
+  ezDynamicArray<ezGameObject*>* out_CreatedRootObjects, const ezUInt16* pOverrideTeamID, bool bForceDynamic)
+{
+  EZ_PROFILE_SCOPE("ezWorldReader::InstantiatePrefabs");
+
+  EZ_LOCK(world.GetWriteMarker());
+
+  m_pWorld = &world;
+  ClearComponentManagers();
+
+  ezHybridArray<ezGameObject*, 8> createdRootObjects;
+
+  if (out_CreatedRootObjects != nullptr)
+  {
+    out_CreatedRootObjects->Reserve(out_CreatedRootObjects->GetCount() + rootTransforms.GetCount() * m_RootObjectsToCreate.GetCount());
+  }
+
+  for (const ezTransform& rootTransform : rootTransforms)
+  {
+    ClearHandles();
+    createdRootObjects.Clear();
+
+    InstantiationContext context(*this, true, rootTransform, hParent, out_CreatedRootObjects != nullptr ? &createdRootObjects : nullptr, nullptr,
+      pOverrideTeamID, bForceDynamic, ezTime::Zero(), nullptr);
+
+    EZ_VERIFY(context.Step(), "Instantiation should be completed after this call");
+
+    if (out_CreatedRootObjects != nullptr)
+    {
+      out_CreatedRootObjects->PushBackRange(createdRootObjects);
+    }
+  }
+}
+
+ezStreamReader& ezWorldReader::GetStream() const
+{
+  if (s_TaskStream.m_pReader == this)
+    return *s_TaskStream.m_pStream;
+
+  return *m_pStream;
+}
+
 ezGameObjectHandle ezWorldReader::ReadGameObjectHandle()
 {
   ezUInt32 idx = 0;
-  *m_pStream >> idx;
+  GetStream() >> idx;
 
   return m_IndexToGameObjectHandle[idx];
 }
@@ -105,8 +165,9 @@ void ezWorldReader::ReadComponentHandle(ezComponentHandle& out_hComponent)
   ezUInt16 uiTypeIndex = 0;
   ezUInt32 uiIndex = 0;
 
-  *m_pStream >> uiTypeIndex;
-  *m_pStream >> uiIndex;
+  ezStreamReader& stream = GetStream();
+  stream >> uiTypeIndex;
+  stream >> uiIndex;
 
   out_hComponent.Invalidate();
 
@@ -145,18 +206,18 @@ void ezWorldReader::ClearAndCompact()
   m_ComponentTypeVersions.Clear();
   m_ComponentTypeVersions.Compact();
 
-  m_ComponentCreationStream.Clear();
-  m_ComponentCreationStream.Compact();
-
   m_ComponentDataStream.Clear();
   m_ComponentDataStream.Compact();
+
+  m_CreatedComponents.Clear();
+  m_CreatedComponents.Compact();
 }
 
 ezUInt64 ezWorldReader::GetHeapMemoryUsage() const
 {
   return m_IndexToGameObjectHandle.GetHeapMemoryUsage() + m_RootObjectsToCreate.GetHeapMemoryUsage() + m_ChildObjectsToCreate.GetHeapMemoryUsage() +
-         m_ComponentTypes.GetHeapMemoryUsage() + m_ComponentTypeVersions.GetHeapMemoryUsage() + m_ComponentCreationStream.GetHeapMemoryUsage() +
-         m_ComponentDataStream.GetHeapMemoryUsage();
+         m_ComponentTypes.GetHeapMemoryUsage() + m_ComponentTypeVersions.GetHeapMemoryUsage() + m_ComponentDataStream.GetHeapMemoryUsage() +
+         m_CreatedComponents.GetHeapMemoryUsage();
 }
 
 ezUInt32 ezWorldReader::GetRootObjectCount() const
@@ -223,67 +284,99 @@ void ezWorldReader::ReadComponentTypeInfo(ezUInt32 uiComponentTypeIdx)
   }
 
   m_ComponentTypes[uiComponentTypeIdx].m_pRtti = pRtti;
+  m_ComponentTypes[uiComponentTypeIdx].m_bParallelDeserialization = pRtti != nullptr && pRtti->GetAttributeByType<ezParallelDeserializationAttribute>() != nullptr;
   m_ComponentTypeVersions[pRtti] = uiRttiVersion;
 }
 
 void ezWorldReader::ReadComponentDataToMemStream()
 {
-  auto WriteToMemStream = [&](ezMemoryStreamWriter& writer, bool bReadNumComponents) {
-    ezUInt8 Temp[4096];
-    for (auto& compTypeInfo : m_ComponentTypes)
+  // the creation data is parsed into the instantiation template right away, so instantiating only needs to read the component data stream
+  for (auto& compTypeInfo : m_ComponentTypes)
+  {
+    ezUInt32 uiAllComponentsSize = 0;
+    *m_pStream >> uiAllComponentsSize;
+
+    if (compTypeInfo.m_pRtti == nullptr)
     {
-      ezUInt32 uiAllComponentsSize = 0;
-      *m_pStream >> uiAllComponentsSize;
+      ezLog::Warning("Skipping components of unknown type");
 
-      if (compTypeInfo.m_pRtti == nullptr)
-      {
-        ezLog::Warning("Skipping components of unknown type");
+      m_pStream->SkipBytes(uiAllComponentsSize);
+      continue;
+    }
 
-        m_pStream->SkipBytes(uiAllComponentsSize);
-      }
-      else
-      {
-        if (bReadNumComponents)
-        {
-          *m_pStream >> compTypeInfo.m_uiNumComponents;
-          uiAllComponentsSize -= sizeof(ezUInt32);
+    *m_pStream >> compTypeInfo.m_uiNumComponents;
+    m_uiTotalNumComponents += compTypeInfo.m_uiNumComponents;
 
-          m_uiTotalNumComponents += compTypeInfo.m_uiNumComponents;
-        }
+    compTypeInfo.m_ComponentsToCreate.SetCountUninitialized(compTypeInfo.m_uiNumComponents);
 
-        while (uiAllComponentsSize > 0)
-        {
-          const ezUInt64 uiRead = m_pStream->ReadBytes(Temp, ezMath::Min<ezUInt32>(uiAllComponentsSize, EZ_ARRAY_SIZE(Temp)));
+    for (ezUInt32 i = 0; i < compTypeInfo.m_uiNumComponents; ++i)
+    {
+      ComponentToCreate& compToCreate = compTypeInfo.m_ComponentsToCreate[i];
 
-          writer.WriteBytes(Temp, uiRead);
+      ezUInt32 uiComponentIdx = 0;
+      *m_pStream >> compToCreate.m_uiOwnerIndex;
+      *m_pStream >> uiComponentIdx;
+      *m_pStream >> compToCreate.m_bActive;
+      *m_pStream >> compToCreate.m_uiUserFlags;
 
-          uiAllComponentsSize -= (ezUInt32)uiRead;
-        }
-      }
+      EZ_ASSERT_DEBUG(uiComponentIdx == i + 1, "Component index doesn't match");
     }
-  };
-
-  {
-    ezMemoryStreamWriter writer(&m_ComponentCreationStream);
-    WriteToMemStream(writer, true);
   }
 
+  ezMemoryStreamWriter writer(&m_ComponentDataStream);
+  ezUInt8 Temp[4096];
+
+  for (auto& compTypeInfo : m_ComponentTypes)
   {
-    ezMemoryStreamWriter writer(&m_ComponentDataStream);
-    WriteToMemStream(writer, false);
+    ezUInt32 uiAllComponentsSize = 0;
+    *m_pStream >> uiAllComponentsSize;
+
+    if (compTypeInfo.m_pRtti == nullptr)
+    {
+      ezLog::Warning("Skipping components of unknown type");
+
+      m_pStream->SkipBytes(uiAllComponentsSize);
+    }
+    else
+    {
+      compTypeInfo.m_uiDataOffset = writer.GetWritePosition();
+      compTypeInfo.m_uiDataSize = uiAllComponentsSize;
+
+      while (uiAllComponentsSize > 0)
+      {
+        const ezUInt64 uiRead = m_pStream->ReadBytes(Temp, ezMath::Min<ezUInt32>(uiAllComponentsSize, EZ_ARRAY_SIZE(Temp)));
+
+        writer.WriteBytes(Temp, uiRead);
+
+        uiAllComponentsSize -= (ezUInt32)uiRead;
+      }
+    }
   }
 }
 
 void ezWorldReader::ClearHandles()
 {
   m_IndexToGameObjectHandle.Clear();
+  m_IndexToGameObjectHandle.Reserve(m_RootObjectsToCreate.GetCount() + m_ChildObjectsToCreate.GetCount() + 1);
   m_IndexToGameObjectHandle.PushBack(ezGameObjectHandle());
 
   for (auto& compTypeInfo : m_ComponentTypes)
   {
     compTypeInfo.m_ComponentIndexToHandle.Clear();
+    compTypeInfo.m_ComponentIndexToHandle.Reserve(compTypeInfo.m_uiNumComponents + 1);
     compTypeInfo.m_ComponentIndexToHandle.PushBack(ezComponentHandle());
   }
+
+  m_CreatedComponents.Clear();
+}
+
+void ezWorldReader::ClearComponentManagers()
+{
+  // the managers are looked up again for every instantiation call, since the world may have changed in the meantime
+  for (auto& compTypeInfo : m_ComponentTypes)
+  {
+    compTypeInfo.m_pManager = nullptr;
+  }
 }
 
 ezUniquePtr<ezWorldReader::InstantiationContextBase> ezWorldReader::Instantiate(ezWorld& world, bool bUseTransform, const ezTransform& rootTransform,
@@ -293,6 +386,7 @@ ezUniquePtr<ezWorldReader::InstantiationContextBase> ezWorldReader::Instantiate(
   m_pWorld = &world;
 
   ClearHandles();
+  ClearComponentManagers();
 
   if (maxStepTime <= ezTime::Zero())
   {
@@ -320,6 +414,8 @@ ezWorldReader::InstantiationContext::InstantiationContext(ezWorldReader& worldRe
   , m_pCreatedChildObjects(out_CreatedChildObjects)
   , m_pOverrideTeamID(pOverrideTeamID)
   , m_bForceDynamic(bForceDynamic)
+  , m_bTimeSliced(maxStepTime.IsPositive())
+  , m_bDeserializeInParallel(worldReader.m_bDeserializeComponentsInParallel)
   , m_MaxStepTime(maxStepTime.IsPositive() ? maxStepTime : ezTime::Hours(10000))
 {
   m_Phase = Phase::CreateRootObjects;
@@ -384,25 +480,14 @@ bool ezWorldReader::InstantiationContext::Step()
     if (!CreateGameObjects<false>(m_WorldReader.m_ChildObjectsToCreate, ezGameObjectHandle(), m_pCreatedChildObjects, endTime))
       return false;
 
-    m_CurrentReader.SetStorage(&m_WorldReader.m_ComponentCreationStream);
     m_Phase = Phase::CreateComponents;
     BeginNextProgressStep("CreateComponents");
   }
 
   if (m_Phase == Phase::CreateComponents)
   {
-    if (m_WorldReader.m_ComponentCreationStream.GetStorageSize() > 0)
-    {
-      m_WorldReader.m_pStringDedupReadContext->SetActive(true);
-
-      ezStreamReader* pPrevReader = m_WorldReader.m_pStream;
-      m_WorldReader.m_pStream = &m_CurrentReader;
-
-      EZ_SCOPE_EXIT(m_WorldReader.m_pStream = pPrevReader; m_WorldReader.m_pStringDedupReadContext->SetActive(false););
-
-      if (!CreateComponents(endTime))
-        return false;
-    }
+    if (!CreateComponents(endTime))
+      return false;
 
     m_CurrentReader.SetStorage(&m_WorldReader.m_ComponentDataStream);
     m_Phase = Phase::DeserializeComponents;
@@ -413,6 +498,9 @@ bool ezWorldReader::InstantiationContext::Step()
   {
     if (m_WorldReader.m_ComponentDataStream.GetStorageSize() > 0)
     {
+      if (!DeserializeComponentsInParallel(endTime))
+        return false;
+
       m_WorldReader.m_pStringDedupReadContext->SetActive(true);
 
       ezStreamReader* pPrevReader = m_WorldReader.m_pStream;
@@ -516,7 +604,7 @@ bool ezWorldReader::InstantiationContext::CreateGameObjects(
     ++m_uiCurrentIndex;
 
     // exit here to ensure that we at least did some work
-    if (ezTime::Now() >= endTime)
+    if (IsStepTimeUp(endTime))
     {
       SetSubProgressCompletion(static_cast<double>(m_uiCurrentIndex) / objects.GetCount());
       return false;
@@ -532,31 +620,27 @@ bool ezWorldReader::InstantiationContext::CreateComponents(ezTime endTime)
 {
   EZ_PROFILE_SCOPE("ezWorldReader::CreateComponents");
 
-  ezStreamReader& s = *m_WorldReader.m_pStream;
-
   for (; m_uiCurrentComponentTypeIndex < m_WorldReader.m_ComponentTypes.GetCount(); ++m_uiCurrentComponentTypeIndex)
   {
     auto& compTypeInfo = m_WorldReader.m_ComponentTypes[m_uiCurrentComponentTypeIndex];
+    compTypeInfo.m_uiFirstCreatedComponent = m_WorldReader.m_CreatedComponents.GetCount();
 
     // will be the case for all abstract component types
     if (compTypeInfo.m_pRtti == nullptr || compTypeInfo.m_uiNumComponents == 0)
       continue;
 
-    ezComponentManagerBase* pManager = m_WorldReader.m_pWorld->GetOrCreateManagerForComponentType(compTypeInfo.m_pRtti);
+    if (compTypeInfo.m_pManager == nullptr)
+    {
+      compTypeInfo.m_pManager = m_WorldReader.m_pWorld->GetOrCreateManagerForComponentType(compTypeInfo.m_pRtti);
+    }
+
+    ezComponentManagerBase* pManager = compTypeInfo.m_pManager;
     EZ_ASSERT_DEV(pManager != nullptr, "Cannot create components of type '{0}', manager is not available.", compTypeInfo.m_pRtti->GetTypeName());
 
     while (m_uiCurrentIndex < compTypeInfo.m_uiNumComponents)
     {
-      const ezGameObjectHandle hOwner = m_WorldReader.ReadGameObjectHandle();
-
-      ezUInt32 uiComponentIdx = 0;
-      s >> uiComponentIdx;
-
-      bool bActive = true;
-      s >> bActive;
-
-      ezUInt8 userFlags = 0;
-      s >> userFlags;
+      const ComponentToCreate& compToCreate = compTypeInfo.m_ComponentsToCreate[m_uiCurrentIndex];
+      const ezGameObjectHandle hOwner = m_WorldReader.m_IndexToGameObjectHandle[compToCreate.m_uiOwnerIndex];
 
       ezGameObject* pOwnerObject = nullptr;
       m_WorldReader.m_pWorld->TryGetObject(hOwner, pOwnerObject);
@@ -566,21 +650,26 @@ bool ezWorldReader::InstantiationContext::CreateComponents(ezTime endTime)
       ezComponent* pComponent = nullptr;
       auto hComponent = pManager->CreateComponentNoInit(pOwnerObject, pComponent);
 
-      pComponent->SetActiveFlag(bActive);
+      pComponent->SetActiveFlag(compToCreate.m_bActive);
 
       for (ezUInt8 j = 0; j < 8; ++j)
       {
-        pComponent->SetUserFlag(j, (userFlags & EZ_BIT(j)) != 0);
+        pComponent->SetUserFlag(j, (compToCreate.m_uiUserFlags & EZ_BIT(j)) != 0);
       }
 
-      EZ_ASSERT_DEBUG(uiComponentIdx == compTypeInfo.m_ComponentIndexToHandle.GetCount(), "Component index doesn't match");
       compTypeInfo.m_ComponentIndexToHandle.PushBack(hComponent);
 
+      if (!m_bTimeSliced)
+      {
+        // nothing can delete components before this context has finished, so the pointers stay valid
+        m_WorldReader.m_CreatedComponents.PushBack(pComponent);
+      }
+
       ++m_uiCurrentIndex;
       ++m_uiCurrentNumComponentsProcessed;
 
       // exit here to ensure that we at least did some work
-      if (ezTime::Now() >= endTime)
+      if (IsStepTimeUp(endTime))
       {
         SetSubProgressCompletion((double)m_uiCurrentNumComponentsProcessed / m_WorldReader.m_uiTotalNumComponents);
         return false;
@@ -601,14 +690,36 @@ bool ezWorldReader::InstantiationContext::DeserializeComponents(ezTime endTime)
 {
   EZ_PROFILE_SCOPE("ezWorldReader::DeserializeComponents");
 
-  ezStreamReader& s = *m_WorldReader.m_pStream;
+  if (!m_bTimeSliced)
+  {
+    for (const auto& compTypeInfo : m_WorldReader.m_ComponentTypes)
+    {
+      if (compTypeInfo.m_pRtti == nullptr || IsDeserializedInParallel(compTypeInfo))
+        continue;
+
+      m_CurrentReader.SetReadPosition(compTypeInfo.m_uiDataOffset);
+
+      const ezUInt32 uiEndIndex = compTypeInfo.m_uiFirstCreatedComponent + compTypeInfo.m_uiNumComponents;
+      for (ezUInt32 i = compTypeInfo.m_uiFirstCreatedComponent; i < uiEndIndex; ++i)
+      {
+        m_WorldReader.m_CreatedComponents[i]->DeserializeComponent(m_WorldReader);
+      }
+    }
+
+    return true;
+  }
 
   for (; m_uiCurrentComponentTypeIndex < m_WorldReader.m_ComponentTypes.GetCount(); ++m_uiCurrentComponentTypeIndex)
   {
     auto& compTypeInfo = m_WorldReader.m_ComponentTypes[m_uiCurrentComponentTypeIndex];
-    if (compTypeInfo.m_pRtti == nullptr)
+    if (compTypeInfo.m_pRtti == nullptr || IsDeserializedInParallel(compTypeInfo))
       continue;
 
+    if (m_uiCurrentIndex == 0)
+    {
+      m_CurrentReader.SetReadPosition(compTypeInfo.m_uiDataOffset);
+    }
+
     while (m_uiCurrentIndex < compTypeInfo.m_ComponentIndexToHandle.GetCount())
     {
       ezComponent* pComponent = nullptr;
@@ -621,7 +732,7 @@ bool ezWorldReader::InstantiationContext::DeserializeComponents(ezTime endTime)
       ++m_uiCurrentNumComponentsProcessed;
 
       // exit here to ensure that we at least did some work
-      if (ezTime::Now() >= endTime)
+      if (IsStepTimeUp(endTime))
       {
         SetSubProgressCompletion((double)m_uiCurrentNumComponentsProcessed / m_WorldReader.m_uiTotalNumComponents);
         return false;
@@ -638,10 +749,154 @@ bool ezWorldReader::InstantiationContext::DeserializeComponents(ezTime endTime)
   return true;
 }
 
+bool ezWorldReader::InstantiationContext::DeserializeComponentsInParallel(ezTime endTime)
+{
+  if (!m_bDeserializeInParallel)
+    return true;
+
+  EZ_PROFILE_SCOPE("ezWorldReader::DeserializeComponentsInParallel");
+
+  if (!m_bParallelDeserializationStarted)
+  {
+    m_bParallelDeserializationStarted = true;
+
+    for (ezUInt32 uiTypeIndex = 0; uiTypeIndex < m_WorldReader.m_ComponentTypes.GetCount(); ++uiTypeIndex)
+    {
+      const auto& compTypeInfo = m_WorldReader.m_ComponentTypes[uiTypeIndex];
+      if (compTypeInfo.m_pRtti == nullptr || compTypeInfo.m_uiNumComponents == 0 || !compTypeInfo.m_bParallelDeserialization)
+        continue;
+
+      ezSharedPtr<DeserializeTask> pTask = EZ_DEFAULT_NEW(DeserializeTask);
+      pTask->ConfigureTask(compTypeInfo.m_pRtti->GetTypeName(), ezTaskNesting::Maybe);
+      pTask->m_pContext = this;
+      pTask->m_uiComponentTypeIndex = uiTypeIndex;
+      m_DeserializeTasks.PushBack(pTask);
+    }
+  }
+
+  if (m_DeserializeTasks.IsEmpty())
+    return true;
+
+  // the tasks are always waited for within the step, so no other code can modify the world while they are running
+  ezTaskGroupID taskGroupId = ezTaskSystem::CreateTaskGroup(ezTaskPriority::EarlyThisFrame);
+
+  for (auto& pTask : m_DeserializeTasks)
+  {
+    const auto& compTypeInfo = m_WorldReader.m_ComponentTypes[pTask->m_uiComponentTypeIndex];
+    if (pTask->m_uiCurrentIndex < compTypeInfo.m_uiNumComponents)
+    {
+      if (m_bTimeSliced)
+      {
+        // components may have been moved or deleted since the last step
+        pTask->m_Components.SetCountUninitialized(compTypeInfo.m_uiNumComponents - pTask->m_uiCurrentIndex);
+
+        for (ezUInt32 i = 0; i < pTask->m_Components.GetCount(); ++i)
+        {
+          pTask->m_Components[i] = nullptr;
+
+          // the first handle is the invalid one for index 0
+          m_WorldReader.m_pWorld->TryGetComponent(compTypeInfo.m_ComponentIndexToHandle[pTask->m_uiCurrentIndex + i + 1], pTask->m_Components[i]);
+        }
+      }
+
+      pTask->m_EndTime = endTime;
+      ezTaskSystem::AddTaskToGroup(taskGroupId, pTask);
+    }
+  }
+
+  ezTaskSystem::StartTaskGroup(taskGroupId);
+  ezTaskSystem::WaitForGroup(taskGroupId);
+
+  bool bFinished = true;
+  ezUInt64 uiNumComponentsProcessed = 0;
+
+  for (auto& pTask : m_DeserializeTasks)
+  {
+    bFinished &= pTask->m_uiCurrentIndex == m_WorldReader.m_ComponentTypes[pTask->m_uiComponentTypeIndex].m_uiNumComponents;
+    uiNumComponentsProcessed += pTask->m_uiCurrentIndex;
+  }
+
+  if (!bFinished)
+  {
+    SetSubProgressCompletion((double)uiNumComponentsProcessed / m_WorldReader.m_uiTotalNumComponents);
+    return false;
+  }
+
+  m_DeserializeTasks.Clear();
+  m_uiCurrentNumComponentsProcessed = uiNumComponentsProcessed;
+
+  return true;
+}
+
+void ezWorldReader::InstantiationContext::DeserializeTask::Execute()
+{
+  ezWorldReader& worldReader = m_pContext->m_WorldReader;
+  const ComponentTypeInfo& compTypeInfo = worldReader.m_ComponentTypes[m_uiComponentTypeIndex];
+
+  ezRawMemoryStreamReader stream(worldReader.m_ComponentDataStream.GetData() + compTypeInfo.m_uiDataOffset, compTypeInfo.m_uiDataSize);
+  stream.SetReadPosition(m_uiReadPosition);
+
+  // the task may run inline while this thread waits, e.g. on the thread that is in the middle of deserializing the world,
+  // so the context and stream of that thread are swapped out for the duration of the task and restored afterwards
+  ezStringDeduplicationReadContext* pOuterContext = ezStringDeduplicationReadContext::GetContext();
+  const TaskStream outerStream = s_TaskStream;
+
+  if (pOuterContext != nullptr)
+    pOuterContext->SetActive(false);
+
+  // the string table is only read during deserialization, so all tasks can share it
+  worldReader.m_pStringDedupReadContext->SetActive(true);
+  s_TaskStream.m_pReader = &worldReader;
+  s_TaskStream.m_pStream = &stream;
+
+  EZ_SCOPE_EXIT(s_TaskStream = outerStream; worldReader.m_pStringDedupReadContext->SetActive(false);
+                if (pOuterContext != nullptr) { pOuterContext->SetActive(true); });
+
+  const ezUInt32 uiFirstIndex = m_uiCurrentIndex;
+
+  while (m_uiCurrentIndex < compTypeInfo.m_uiNumComponents)
+  {
+    ezComponent* pComponent = nullptr;
+
+    if (m_pContext->m_bTimeSliced)
+    {
+      pComponent = m_Components[m_uiCurrentIndex - uiFirstIndex];
+    }
+    else
+    {
+      pComponent = worldReader.m_CreatedComponents[compTypeInfo.m_uiFirstCreatedComponent + m_uiCurrentIndex];
+    }
+
+    if (pComponent != nullptr)
+    {
+      pComponent->DeserializeComponent(worldReader);
+    }
+
+    ++m_uiCurrentIndex;
+
+    // exit here to ensure that we at least did some work
+    if (m_pContext->IsStepTimeUp(m_EndTime))
+      break;
+  }
+
+  m_uiReadPosition = stream.GetReadPosition();
+}
+
 bool ezWorldReader::InstantiationContext::AddComponentsToBatch(ezTime endTime)
 {
   EZ_PROFILE_SCOPE("ezWorldReader::AddComponentsToBatch");
 
+  if (!m_bTimeSliced)
+  {
+    for (ezComponent* pComponent : m_WorldReader.m_CreatedComponents)
+    {
+      pComponent->GetOwningManager()->InitializeComponent(pComponent);
+    }
+
+    m_WorldReader.m_CreatedComponents.Clear();
+    return true;
+  }
+
   ezUInt32 uiInitializedComponents = 0;
 
   if (!m_hComponentInitBatch.IsInvalidated())
@@ -668,7 +923,7 @@ bool ezWorldReader::InstantiationContext::AddComponentsToBatch(ezTime endTime)
       ++m_uiCurrentNumComponentsProcessed;
 
       // exit here to ensure that we at least did some work
-      if (ezTime::Now() >= endTime)
+      if (IsStepTimeUp(endTime))
       {
         SetSubProgressCompletion((double)m_uiCurrentNumComponentsProcessed / m_WorldReader.m_uiTotalNumComponents);
 
@@ -3,12 +3,23 @@
 #include <Core/World/World.h>
 #include <Foundation/IO/MemoryStream.h>
 #include <Foundation/IO/Stream.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <Foundation/Types/UniquePtr.h>
 
 class ezStringDeduplicationReadContext;
 class ezProgress;
 class ezProgressRange;
 
+/// \brief Add this attribute to a component type to allow ezWorldReader to deserialize components of that type on worker threads.
+///
+/// See ezWorldReader::SetDeserializeComponentsInParallel(). Only add this attribute if DeserializeComponent() exclusively reads from
+/// the given ezWorldReader and writes to members of the component itself. It must not access the world, the owner object, other
+/// components or any other shared state. The attribute is not inherited, derived component types have to add it themselves.
+class EZ_CORE_DLL ezParallelDeserializationAttribute : public ezPropertyAttribute
+{
+  EZ_ADD_DYNAMIC_REFLECTION(ezParallelDeserializationAttribute, ezPropertyAttribute);
+};
+
 /// \brief Reads a world description from a stream. Allows to instantiate that world multiple times
 ///        in different locations and different ezWorld's.
 ///
@@ -80,8 +91,29 @@ public:
     ezHybridArray<ezGameObject*, 8>* out_CreatedRootObjects, ezHybridArray<ezGameObject*, 8>* out_CreatedChildObjects,
     const ezUInt16* pOverrideTeamID, bool bForceDynamic, ezTime maxStepTime = ezTime::Zero(), ezProgress* pProgress = nullptr);
 
+  /// \brief Creates one instance of the world per given root transform, e.g. to spawn many copies of the same prefab at once.
+  ///
+  /// This is equivalent to calling InstantiatePrefab() for every transform, but component managers are only resolved once and all
+  /// bookkeeping arrays are reused between the instances. Instantiation always happens immediately.
+  /// If out_CreatedRootObjects is valid, the root objects of all instances are appended to it.
+  void InstantiatePrefabs(ezWorld& world, ezArrayPtr<const ezTransform> rootTransforms, ezGameObjectHandle hParent,
+    ezDynamicArray<ezGameObject*>* out_CreatedRootObjects, const ezUInt16* pOverrideTeamID, bool bForceDynamic);
+
+  /// \brief Enables deserializing the components of all types with an ezParallelDeserializationAttribute on the ezTaskSystem.
+  ///
+  /// The components are partitioned by type and every type is deserialized by a separate task, while the calling thread
+  /// takes care of the remaining types afterwards. Creating the objects and components as well as initializing them
+  /// still happens on the calling thread. Time sliced instantiations respect the maxStepTime in every task, so a step
+  /// doesn't take longer than it would without this option. Disabled by default.
+  void SetDeserializeComponentsInParallel(bool bEnable) { m_bDeserializeComponentsInParallel = bEnable; }
+
+  /// \brief Returns whether components with an ezParallelDeserializationAttribute are deserialized on the ezTaskSystem.
+  bool GetDeserializeComponentsInParallel() const { return m_bDeserializeComponentsInParallel; }
+
   /// \brief Gives access to the stream of data. Use this inside component deserialization functions to read data.
-  ezStreamReader& GetStream() const { return *m_pStream; }
+  ///
+  /// While components are deserialized in parallel, this returns a separate stream for every task.
+  ezStreamReader& GetStream() const;
 
   /// \brief Used during component deserialization to read a handle to a game object.
   ezGameObjectHandle ReadGameObjectHandle();
@@ -127,6 +159,7 @@ private:
   void ReadComponentTypeInfo(ezUInt32 uiComponentTypeIdx);
   void ReadComponentDataToMemStream();
   void ClearHandles();
+  void ClearComponentManagers();
   ezUniquePtr<InstantiationContextBase> Instantiate(ezWorld& world, bool bUseTransform, const ezTransform& rootTransform, ezGameObjectHandle hParent,
     ezHybridArray<ezGameObject*, 8>* out_CreatedRootObjects, ezHybridArray<ezGameObject*, 8>* out_CreatedChildObjects,
     const ezUInt16* pOverrideTeamID, bool bForceDynamic, ezTime maxStepTime, ezProgress* pProgress);
@@ -140,18 +173,45 @@ private:
   ezDynamicArray<GameObjectToCreate> m_RootObjectsToCreate;
   ezDynamicArray<GameObjectToCreate> m_ChildObjectsToCreate;
 
+  /// \brief The creation data of a single component, parsed once in ReadWorldDescription() so that instantiation doesn't need to read a stream.
+  struct ComponentToCreate
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt32 m_uiOwnerIndex;
+    bool m_bActive;
+    ezUInt8 m_uiUserFlags;
+  };
+
   struct ComponentTypeInfo
   {
     const ezRTTI* m_pRtti = nullptr;
     ezDynamicArray<ezComponentHandle> m_ComponentIndexToHandle;
+    ezDynamicArray<ComponentToCreate> m_ComponentsToCreate;
     ezUInt32 m_uiNumComponents = 0;
+
+    /// \brief The range of this type in m_ComponentDataStream.
+    ezUInt32 m_uiDataOffset = 0;
+    ezUInt32 m_uiDataSize = 0;
+
+    /// \brief Whether the type has an ezParallelDeserializationAttribute.
+    bool m_bParallelDeserialization = false;
+
+    /// \brief Index of the first component of this type in m_CreatedComponents.
+    ezUInt32 m_uiFirstCreatedComponent = 0;
+
+    /// \brief The manager for this component type in m_pWorld, resolved once per instantiation call.
+    ezComponentManagerBase* m_pManager = nullptr;
   };
 
   ezDynamicArray<ComponentTypeInfo> m_ComponentTypes;
   ezHashTable<const ezRTTI*, ezUInt32> m_ComponentTypeVersions;
-  ezMemoryStreamStorage m_ComponentCreationStream;
   ezMemoryStreamStorage m_ComponentDataStream;
   ezUInt64 m_uiTotalNumComponents = 0;
+  bool m_bDeserializeComponentsInParallel = false;
+
+  /// \brief All components created by an immediate instantiation, in the order of the component data stream.
+  ezDynamicArray<ezComponent*> m_CreatedComponents;
 
   ezUniquePtr<ezStringDeduplicationReadContext> m_pStringDedupReadContext;
 
@@ -172,9 +232,34 @@ private:
 
     bool CreateComponents(ezTime endTime);
     bool DeserializeComponents(ezTime endTime);
+    bool DeserializeComponentsInParallel(ezTime endTime);
     bool AddComponentsToBatch(ezTime endTime);
 
   private:
+    /// \brief Deserializes the components of one type that has an ezParallelDeserializationAttribute and remembers how far it got.
+    struct DeserializeTask final : public ezTask
+    {
+      virtual void Execute() override;
+
+      InstantiationContext* m_pContext = nullptr;
+      ezUInt32 m_uiComponentTypeIndex = 0;
+      ezUInt32 m_uiCurrentIndex = 0;
+      ezUInt64 m_uiReadPosition = 0;
+      ezTime m_EndTime;
+
+      /// \brief For time sliced instantiations: the remaining components of the type, starting at m_uiCurrentIndex.
+      /// Looked up before every step on the thread that holds the write marker, since the tasks must not access the world.
+      ezDynamicArray<ezComponent*> m_Components;
+    };
+
+    EZ_ALWAYS_INLINE bool IsDeserializedInParallel(const ComponentTypeInfo& compTypeInfo) const
+    {
+      return m_bDeserializeInParallel && compTypeInfo.m_bParallelDeserialization;
+    }
+
+    /// \brief Only time sliced instantiations ever run out of time, immediate ones skip the timer query.
+    EZ_ALWAYS_INLINE bool IsStepTimeUp(ezTime endTime) const { return m_bTimeSliced && ezTime::Now() >= endTime; }
+
     void BeginNextProgressStep(const char* szName);
     void SetSubProgressCompletion(double fCompletion);
 
@@ -183,6 +268,8 @@ private:
 
     bool m_bUseTransform = false;
     bool m_bForceDynamic = false;
+    bool m_bTimeSliced = false;
+    bool m_bDeserializeInParallel = false;
     ezTransform m_RootTransform;
     ezGameObjectHandle m_hParent;
     ezHybridArray<ezGameObject*, 8>* m_pCreatedRootObjects;
@@ -213,6 +300,8 @@ private:
     ezUInt32 m_uiCurrentComponentTypeIndex = 0;
     ezUInt64 m_uiCurrentNumComponentsProcessed = 0;
     ezMemoryStreamReader m_CurrentReader;
+    ezDynamicArray<ezSharedPtr<DeserializeTask>> m_DeserializeTasks;
+    bool m_bParallelDeserializationStarted = false;
 
     ezUniquePtr<ezProgressRange> m_pOverallProgressRange;
     ezUniquePtr<ezProgressRange> m_pSubProgressRange;
@@ -1,6 +1,8 @@
 #include <FoundationPCH.h>
 
 #include <Foundation/Memory/CommonAllocators.h>
+#include <Foundation/Memory/ThreadCachingAllocator.h>
+#include <Foundation/Utilities/CommandLineUtils.h>
 
 #if EZ_ENABLED(EZ_USE_GUARDED_ALLOCATIONS)
 typedef ezGuardedAllocator DefaultHeapType;
@@ -12,13 +14,16 @@ typedef ezAlignedHeapAllocator DefaultAlignedHeapType;
 typedef ezHeapAllocator DefaultStaticHeapType;
 #endif
 
+typedef ezThreadCachingAllocator<> ThreadCachingHeapType;
+
 enum
 {
   HEAP_ALLOCATOR_BUFFER_SIZE = sizeof(DefaultHeapType),
+  DEFAULT_ALLOCATOR_BUFFER_SIZE = sizeof(DefaultHeapType) > sizeof(ThreadCachingHeapType) ? sizeof(DefaultHeapType) : sizeof(ThreadCachingHeapType),
   ALIGNED_ALLOCATOR_BUFFER_SIZE = sizeof(DefaultAlignedHeapType)
 };
 
-EZ_ALIGN_VARIABLE(static ezUInt8 s_DefaultAllocatorBuffer[HEAP_ALLOCATOR_BUFFER_SIZE], EZ_ALIGNMENT_MINIMUM);
+EZ_ALIGN_VARIABLE(static ezUInt8 s_DefaultAllocatorBuffer[DEFAULT_ALLOCATOR_BUFFER_SIZE], EZ_ALIGNMENT_MINIMUM);
 EZ_ALIGN_VARIABLE(static ezUInt8 s_StaticAllocatorBuffer[HEAP_ALLOCATOR_BUFFER_SIZE], EZ_ALIGNMENT_MINIMUM);
 
 EZ_ALIGN_VARIABLE(static ezUInt8 s_AlignedAllocatorBuffer[ALIGNED_ALLOCATOR_BUFFER_SIZE], EZ_ALIGNMENT_MINIMUM);
@@ -38,7 +43,17 @@ void ezFoundation::Initialize()
 
   if (s_pDefaultAllocator == nullptr)
   {
-    s_pDefaultAllocator = new (s_DefaultAllocatorBuffer) DefaultHeapType("DefaultHeap");
+#if EZ_DISABLED(EZ_USE_GUARDED_ALLOCATIONS)
+    // ezApplication sets the command line before the base systems are started
+    if (ezCommandLineUtils::GetGlobalInstance()->GetBoolOption("-ThreadCachingAllocator", EZ_ENABLED(EZ_USE_THREAD_CACHING_ALLOCATOR)))
+    {
+      s_pDefaultAllocator = new (s_DefaultAllocatorBuffer) ThreadCachingHeapType("DefaultHeap");
+    }
+    else
+#endif
+    {
+      s_pDefaultAllocator = new (s_DefaultAllocatorBuffer) DefaultHeapType("DefaultHeap");
+    }
   }
 
   if (s_pAlignedAllocator == nullptr)
@@ -0,0 +1,463 @@
+#pragma once
+
+#include <Foundation/Algorithm/Comparer.h>
+#include <Foundation/Types/ArrayPtr.h>
+
+template <typename KeyType, typename Comparer>
+class ezBTreeSetBase;
+
+namespace ezInternal
+{
+  /// \brief Returns how many elements of the given size fit into one B-tree node of roughly 256 bytes (four cache lines).
+  constexpr ezUInt32 BTreeNodeCapacity(ezUInt32 uiElementSize)
+  {
+    return (256 / uiElementSize) < 4 ? 4 : ((256 / uiElementSize) > 128 ? 128 : (256 / uiElementSize));
+  }
+} // namespace ezInternal
+
+/// \brief An associative container with the same interface as ezMap, implemented as a B+ tree.
+///
+/// ezMap allocates one node per element, so iterating over it or searching ranges means following a pointer for every element.
+/// ezBTreeMap stores many elements in one node instead. Leaf nodes hold the sorted key/value pairs (keys and values in separate arrays) and are
+/// linked with each other, inner nodes only hold separator keys and child pointers. Nodes have a size of a few cache lines, so iteration is
+/// mostly linear memory access and a lookup only touches a handful of nodes.
+///
+/// All insertion/erasure/lookup functions take O(log n) time. In contrast to ezMap, inserting or removing elements invalidates all iterators
+/// and pointers to keys and values, since elements move between nodes.
+///
+/// Large maps that are known up front (e.g. loaded from disk) should be built with BuildFromSorted(), which is O(n) and creates fully packed nodes.
+///
+/// KeyType must be copyable, since inner nodes store copies of keys as separators.
+template <typename KeyType, typename ValueType, typename Comparer>
+class ezBTreeMapBase
+{
+private:
+  struct Node;
+  struct LeafNode;
+  struct InnerNode;
+
+public:
+  /// \brief Base class for all iterators.
+  struct ConstIterator
+  {
+    typedef std::forward_iterator_tag iterator_category;
+    using value_type = ConstIterator;
+    using difference_type = ptrdiff_t;
+    using pointer = ConstIterator*;
+    using reference = ConstIterator&;
+
+    EZ_DECLARE_POD_TYPE();
+
+    /// \brief Constructs an invalid iterator.
+    EZ_ALWAYS_INLINE ConstIterator()
+      : m_pLeaf(nullptr)
+      , m_uiIndex(0)
+    {
+    } // [tested]
+
+    /// \brief Checks whether this iterator points to a valid element.
+    EZ_ALWAYS_INLINE bool IsValid() const { return (m_pLeaf != nullptr); } // [tested]
+
+    /// \brief Checks whether the two iterators point to the same element.
+    EZ_ALWAYS_INLINE bool operator==(const typename ezBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator& it2) const
+    {
+      return (m_pLeaf == it2.m_pLeaf && m_uiIndex == it2.m_uiIndex);
+    }
+
+    /// \brief Checks whether the two iterators point to the same element.
+    EZ_ALWAYS_INLINE bool operator!=(const typename ezBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator& it2) const { return !(*this == it2); }
+
+    /// \brief Returns the 'key' of the element that this iterator points to.
+    EZ_FORCE_INLINE const KeyType& Key() const
+    {
+      EZ_ASSERT_DEBUG(IsValid(), "Cannot access the 'key' of an invalid iterator.");
+      return m_pLeaf->Keys()[m_uiIndex];
+    } // [tested]
+
+    /// \brief Returns the 'value' of the element that this iterator points to.
+    EZ_FORCE_INLINE const ValueType& Value() const
+    {
+      EZ_ASSERT_DEBUG(IsValid(), "Cannot access the 'value' of an invalid iterator.");
+      return m_pLeaf->Values()[m_uiIndex];
+    } // [tested]
+
+    /// \brief Returns '*this' to enable foreach
+    EZ_ALWAYS_INLINE ConstIterator& operator*() { return *this; } // [tested]
+
+    /// \brief Advances the iterator to the next element in the map. The iterator will not be valid anymore, if the end is reached.
+    void Next(); // [tested]
+
+    /// \brief Advances the iterator to the previous element in the map. The iterator will not be valid anymore, if the end is reached.
+    void Prev(); // [tested]
+
+    /// \brief Shorthand for 'Next'
+    EZ_ALWAYS_INLINE void operator++() { Next(); } // [tested]
+
+    /// \brief Shorthand for 'Prev'
+    EZ_ALWAYS_INLINE void operator--() { Prev(); } // [tested]
+
+  protected:
+    friend class ezBTreeMapBase<KeyType, ValueType, Comparer>;
+    template <typename, typename>
+    friend class ezBTreeSetBase;
+
+    EZ_ALWAYS_INLINE ConstIterator(LeafNode* pLeaf, ezUInt32 uiIndex)
+      : m_pLeaf(pLeaf)
+      , m_uiIndex(uiIndex)
+    {
+    }
+
+    LeafNode* m_pLeaf;
+    ezUInt32 m_uiIndex;
+  };
+
+  /// \brief Forward Iterator to iterate over all elements in sorted order.
+  struct Iterator : public ConstIterator
+  {
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Iterator;
+    using difference_type = ptrdiff_t;
+    using pointer = Iterator*;
+    using reference = Iterator&;
+
+    // this is required to pull in the const version of this function
+    using ConstIterator::Value;
+
+    EZ_DECLARE_POD_TYPE();
+
+    /// \brief Constructs an invalid iterator.
+    EZ_ALWAYS_INLINE Iterator()
+      : ConstIterator()
+    {
+    }
+
+    /// \brief Returns the 'value' of the element that this iterator points to.
+    EZ_FORCE_INLINE ValueType& Value()
+    {
+      EZ_ASSERT_DEBUG(this->IsValid(), "Cannot access the 'value' of an invalid iterator.");
+      return this->m_pLeaf->Values()[this->m_uiIndex];
+    }
+
+    /// \brief Returns '*this' to enable foreach
+    EZ_ALWAYS_INLINE Iterator& operator*() { return *this; } // [tested]
+
+  private:
+    friend class ezBTreeMapBase<KeyType, ValueType, Comparer>;
+    template <typename, typename>
+    friend class ezBTreeSetBase;
+
+    EZ_ALWAYS_INLINE Iterator(LeafNode* pLeaf, ezUInt32 uiIndex)
+      : ConstIterator(pLeaf, uiIndex)
+    {
+    }
+  };
+
+protected:
+  /// \brief Initializes the map to be empty.
+  ezBTreeMapBase(const Comparer& comparer, ezAllocatorBase* pAllocator); // [tested]
+
+  /// \brief Copies all key/value pairs from the given map into this one.
+  ezBTreeMapBase(const ezBTreeMapBase<KeyType, ValueType, Comparer>& cc, ezAllocatorBase* pAllocator); // [tested]
+
+  /// \brief Destroys all elements from the map.
+  ~ezBTreeMapBase(); // [tested]
+
+  /// \brief Copies all key/value pairs from the given map into this one.
+  void operator=(const ezBTreeMapBase<KeyType, ValueType, Comparer>& rhs);
+
+public:
+  /// \brief Returns whether there are no elements in the map. O(1) operation.
+  bool IsEmpty() const; // [tested]
+
+  /// \brief Returns the number of elements currently stored in the map. O(1) operation.
+  ezUInt32 GetCount() const; // [tested]
+
+  /// \brief Destroys all elements in the map and resets its size to zero.
+  void Clear(); // [tested]
+
+  /// \brief Replaces the content of the map with the given keys and values. O(n) operation.
+  ///
+  /// The keys must be sorted in ascending order and must not contain duplicates. All nodes are filled completely, so this is much faster
+  /// than inserting the elements one by one and results in a more compact tree.
+  void BuildFromSorted(ezArrayPtr<const KeyType> keys, ezArrayPtr<const ValueType> values); // [tested]
+
+  /// \brief Returns an Iterator to the very first element.
+  Iterator GetIterator(); // [tested]
+
+  /// \brief Returns a constant Iterator to the very first element.
+  ConstIterator GetIterator() const; // [tested]
+
+  /// \brief Returns an Iterator to the very last element. For reverse traversal.
+  Iterator GetLastIterator(); // [tested]
+
+  /// \brief Returns a constant Iterator to the very last element. For reverse traversal.
+  ConstIterator GetLastIterator() const; // [tested]
+
+  /// \brief Inserts the key/value pair into the tree and returns an Iterator to it. O(log n) operation.
+  template <typename CompatibleKeyType, typename CompatibleValueType>
+  Iterator Insert(CompatibleKeyType&& key, CompatibleValueType&& value); // [tested]
+
+  /// \brief Erases the key/value pair with the given key, if it exists. O(log n) operation.
+  template <typename CompatibleKeyType>
+  bool Remove(const CompatibleKeyType& key); // [tested]
+
+  /// \brief Erases the key/value pair at the given Iterator. O(log n) operation. Returns an iterator to the element after the given
+  /// iterator.
+  Iterator Remove(const Iterator& pos); // [tested]
+
+  /// \brief Searches for the given key and returns an iterator to it. If it did not exist yet, it is default-created. \a bExisted is set to
+  /// true, if the key was found, false if it needed to be created.
+  template <typename CompatibleKeyType>
+  Iterator FindOrAdd(CompatibleKeyType&& key, bool* bExisted = nullptr); // [tested]
+
+  /// \brief Allows read/write access to the value stored under the given key. If there is no such key, a new element is
+  /// default-constructed.
+  template <typename CompatibleKeyType>
+  ValueType& operator[](const CompatibleKeyType& key); // [tested]
+
+  /// \brief Returns whether an entry with the given key was found and if found writes out the corresponding value to out_value.
+  template <typename CompatibleKeyType>
+  bool TryGetValue(const CompatibleKeyType& key, ValueType& out_value) const; // [tested]
+
+  /// \brief Returns whether an entry with the given key was found and if found writes out the pointer to the corresponding value to out_pValue.
+  template <typename CompatibleKeyType>
+  bool TryGetValue(const CompatibleKeyType& key, const ValueType*& out_pValue) const; // [tested]
+
+  /// \brief Returns whether an entry with the given key was found and if found writes out the pointer to the corresponding value to out_pValue.
+  template <typename CompatibleKeyType>
+  bool TryGetValue(const CompatibleKeyType& key, ValueType*& out_pValue) const; // [tested]
+
+  /// \brief Returns a pointer to the value of the entry with the given key if found, otherwise returns nullptr.
+  template <typename CompatibleKeyType>
+  const ValueType* GetValue(const CompatibleKeyType& key) const; // [tested]
+
+  /// \brief Returns a pointer to the value of the entry with the given key if found, otherwise returns nullptr.
+  template <typename CompatibleKeyType>
+  ValueType* GetValue(const CompatibleKeyType& key); // [tested]
+
+  /// \brief Either returns the value of the entry with the given key, if found, or the provided default value.
+  template <typename CompatibleKeyType>
+  const ValueType& GetValueOrDefault(const CompatibleKeyType& key, const ValueType& defaultValue) const; // [tested]
+
+  /// \brief Searches for key, returns an Iterator to it or an invalid iterator, if no such key is found. O(log n) operation.
+  template <typename CompatibleKeyType>
+  Iterator Find(const CompatibleKeyType& key); // [tested]
+
+  /// \brief Returns an Iterator to the element with a key equal or larger than the given key. Returns an invalid iterator, if there is no
+  /// such element.
+  template <typename CompatibleKeyType>
+  Iterator LowerBound(const CompatibleKeyType& key); // [tested]
+
+  /// \brief Returns an Iterator to the element with a key that is LARGER than the given key. Returns an invalid iterator, if there is no
+  /// such element.
+  template <typename CompatibleKeyType>
+  Iterator UpperBound(const CompatibleKeyType& key); // [tested]
+
+  /// \brief Searches for key, returns an Iterator to it or an invalid iterator, if no such key is found. O(log n) operation.
+  template <typename CompatibleKeyType>
+  ConstIterator Find(const CompatibleKeyType& key) const; // [tested]
+
+  /// \brief Checks whether the given key is in the container.
+  template <typename CompatibleKeyType>
+  bool Contains(const CompatibleKeyType& key) const; // [tested]
+
+  /// \brief Returns an Iterator to the element with a key equal or larger than the given key. Returns an invalid iterator, if there is no
+  /// such element.
+  template <typename CompatibleKeyType>
+  ConstIterator LowerBound(const CompatibleKeyType& key) const; // [tested]
+
+  /// \brief Returns an Iterator to the element with a key that is LARGER than the given key. Returns an invalid iterator, if there is no
+  /// such element.
+  template <typename CompatibleKeyType>
+  ConstIterator UpperBound(const CompatibleKeyType& key) const; // [tested]
+
+  /// \brief Returns the allocator that is used by this instance.
+  ezAllocatorBase* GetAllocator() const { return m_pAllocator; }
+
+  /// \brief Comparison operator
+  bool operator==(const ezBTreeMapBase<KeyType, ValueType, Comparer>& rhs) const; // [tested]
+
+  /// \brief Comparison operator
+  bool operator!=(const ezBTreeMapBase<KeyType, ValueType, Comparer>& rhs) const; // [tested]
+
+  /// \brief Returns the amount of bytes that are currently allocated on the heap.
+  ezUInt64 GetHeapMemoryUsage() const; // [tested]
+
+  /// \brief Swaps this map with the other one.
+  void Swap(ezBTreeMapBase<KeyType, ValueType, Comparer>& other); // [tested]
+
+private:
+  template <typename, typename>
+  friend class ezBTreeSetBase;
+
+  /// \brief The maximum number of elements in a leaf node.
+  static constexpr ezUInt32 LeafCapacity = ezInternal::BTreeNodeCapacity(sizeof(KeyType) + sizeof(ValueType));
+
+  /// \brief The maximum number of children of an inner node.
+  static constexpr ezUInt32 InnerCapacity = ezInternal::BTreeNodeCapacity(sizeof(KeyType) + sizeof(void*));
+
+  static constexpr ezUInt32 MinLeafCount = LeafCapacity / 2;
+  static constexpr ezUInt32 MinInnerCount = InnerCapacity / 2;
+
+  /// \brief Every level at least halves the number of elements, so 32 levels are enough for any ezUInt32 element count.
+  static constexpr ezUInt32 MaxDepth = 32;
+
+  struct Node
+  {
+    /// \brief For leaf nodes the number of elements, for inner nodes the number of children.
+    ezUInt16 m_uiCount;
+  };
+
+  struct LeafNode : public Node
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    LeafNode* m_pPrev;
+    LeafNode* m_pNext;
+
+    alignas(KeyType) ezUInt8 m_KeyStorage[sizeof(KeyType) * LeafCapacity];
+    alignas(ValueType) ezUInt8 m_ValueStorage[sizeof(ValueType) * LeafCapacity];
+
+    EZ_ALWAYS_INLINE KeyType* Keys() { return reinterpret_cast<KeyType*>(m_KeyStorage); }
+    EZ_ALWAYS_INLINE ValueType* Values() { return reinterpret_cast<ValueType*>(m_ValueStorage); }
+  };
+
+  struct InnerNode : public Node
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    Node* m_pChildren[InnerCapacity];
+
+    /// \brief Key i separates child i from child i + 1: All keys in child i are smaller, all keys in child i + 1 are equal or larger.
+    alignas(KeyType) ezUInt8 m_KeyStorage[sizeof(KeyType) * (InnerCapacity - 1)];
+
+    EZ_ALWAYS_INLINE KeyType* Keys() { return reinterpret_cast<KeyType*>(m_KeyStorage); }
+  };
+
+  /// \brief The inner nodes visited on the way from the root to a leaf, and which child was taken in each of them.
+  struct Path
+  {
+    InnerNode* m_pNodes[MaxDepth];
+    ezUInt32 m_uiChildIndices[MaxDepth];
+  };
+
+  /// \brief Moves uiCount elements from pSource into the uninitialized pDestination. The ranges may overlap.
+  template <typename T>
+  static void RelocateElements(T* pDestination, T* pSource, ezUInt32 uiCount);
+
+  template <typename CompatibleKeyType>
+  ezUInt32 LowerBoundInNode(const KeyType* pKeys, ezUInt32 uiCount, const CompatibleKeyType& key) const;
+  template <typename CompatibleKeyType>
+  ezUInt32 UpperBoundInNode(const KeyType* pKeys, ezUInt32 uiCount, const CompatibleKeyType& key) const;
+
+  /// \brief Descends to the leaf that may contain the given key. Records the path, if pPath is not null.
+  template <typename CompatibleKeyType>
+  LeafNode* FindLeaf(const CompatibleKeyType& key, Path* pPath) const;
+
+  template <typename CompatibleKeyType>
+  ConstIterator Internal_Find(const CompatibleKeyType& key) const;
+  template <typename CompatibleKeyType>
+  ConstIterator Internal_LowerBound(const CompatibleKeyType& key) const;
+  template <typename CompatibleKeyType>
+  ConstIterator Internal_UpperBound(const CompatibleKeyType& key) const;
+
+  /// \brief Finds the element with the given key or makes room for it. If it did not exist, the key and value at the returned position are
+  /// NOT constructed yet.
+  template <typename CompatibleKeyType>
+  ConstIterator Internal_FindOrInsertSlot(const CompatibleKeyType& key, bool& out_bExisted);
+
+  /// \brief Inserts pRight as the child right of pLeft into the parent at the given level of the path, splitting nodes as necessary.
+  void InsertIntoParent(Path& path, ezUInt32 uiLevel, Node* pLeft, const KeyType& separator, Node* pRight);
+
+  Iterator Internal_RemoveAt(Path& path, LeafNode* pLeaf, ezUInt32 uiIndex);
+  void RebalanceLeaf(Path& path, LeafNode* pLeaf, LeafNode*& ref_pNextLeaf, ezUInt32& ref_uiNextIndex);
+  void RebalanceInner(Path& path, ezUInt32 uiLevel);
+
+  /// \brief Removes child uiChildIndex (which must be larger than zero) and the separator in front of it from the inner node at the given level.
+  void RemoveChildFromInner(Path& path, ezUInt32 uiLevel, ezUInt32 uiChildIndex);
+
+  /// \brief Replaces the content with uiCount elements, which are constructed in order by calling constructElement(KeyType*, ValueType*).
+  template <typename ConstructFunc>
+  void Internal_BuildFromSorted(ezUInt32 uiCount, ConstructFunc constructElement);
+
+  LeafNode* AcquireLeaf();
+  InnerNode* AcquireInner();
+  void ReleaseLeaf(LeafNode* pLeaf);
+  void ReleaseInner(InnerNode* pInner);
+  void DestroySubTree(Node* pNode, ezUInt32 uiDepth);
+
+  /// \brief Root node of the tree, nullptr when the map is empty.
+  Node* m_pRoot;
+
+  /// \brief Number of inner node levels above the leaves. Zero when the root is a leaf.
+  ezUInt32 m_uiDepth;
+
+  LeafNode* m_pFirstLeaf;
+  LeafNode* m_pLastLeaf;
+
+  /// \brief Number of elements in the tree.
+  ezUInt32 m_uiCount;
+
+  ezUInt32 m_uiNumLeafNodes;
+  ezUInt32 m_uiNumInnerNodes;
+
+  ezAllocatorBase* m_pAllocator;
+
+  /// \brief Comparer object
+  Comparer m_Comparer;
+};
+
+
+/// \brief \see ezBTreeMapBase
+template <typename KeyType, typename ValueType, typename Comparer = ezCompareHelper<KeyType>, typename AllocatorWrapper = ezDefaultAllocatorWrapper>
+class ezBTreeMap : public ezBTreeMapBase<KeyType, ValueType, Comparer>
+{
+public:
+  ezBTreeMap();
+  ezBTreeMap(ezAllocatorBase* pAllocator);
+  ezBTreeMap(const Comparer& comparer, ezAllocatorBase* pAllocator);
+
+  ezBTreeMap(const ezBTreeMap<KeyType, ValueType, Comparer, AllocatorWrapper>& other);
+  ezBTreeMap(const ezBTreeMapBase<KeyType, ValueType, Comparer>& other);
+
+  void operator=(const ezBTreeMap<KeyType, ValueType, Comparer, AllocatorWrapper>& rhs);
+  void operator=(const ezBTreeMapBase<KeyType, ValueType, Comparer>& rhs);
+};
+
+template <typename KeyType, typename ValueType, typename Comparer>
+typename ezBTreeMapBase<KeyType, ValueType, Comparer>::Iterator begin(ezBTreeMapBase<KeyType, ValueType, Comparer>& container)
+{
+  return container.GetIterator();
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+typename ezBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator begin(const ezBTreeMapBase<KeyType, ValueType, Comparer>& container)
+{
+  return container.GetIterator();
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+typename ezBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator cbegin(const ezBTreeMapBase<KeyType, ValueType, Comparer>& container)
+{
+  return container.GetIterator();
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+typename ezBTreeMapBase<KeyType, ValueType, Comparer>::Iterator end(ezBTreeMapBase<KeyType, ValueType, Comparer>& container)
+{
+  return typename ezBTreeMapBase<KeyType, ValueType, Comparer>::Iterator();
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+typename ezBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator end(const ezBTreeMapBase<KeyType, ValueType, Comparer>& container)
+{
+  return typename ezBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator();
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+typename ezBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator cend(const ezBTreeMapBase<KeyType, ValueType, Comparer>& container)
+{
+  return typename ezBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator();
+}
+
+#include <Foundation/Containers/Implementation/BTreeMap_inl.h>
@@ -0,0 +1,1088 @@
+#pragma once
+
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Math/Math.h>
+
+// ***** Const Iterator *****
+
+template <typename KeyType, typename ValueType, typename Comparer>
+void ezBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator::Next()
+{
+  if (m_pLeaf == nullptr)
+  {
+    EZ_ASSERT_DEV(m_pLeaf != nullptr, "The Iterator is invalid (end).");
+    return;
+  }
+
+  ++m_uiIndex;
+
+  if (m_uiIndex >= m_pLeaf->m_uiCount)
+  {
+    m_pLeaf = m_pLeaf->m_pNext;
+    m_uiIndex = 0;
+  }
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+void ezBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator::Prev()
+{
+  if (m_pLeaf == nullptr)
+  {
+    EZ_ASSERT_DEV(m_pLeaf != nullptr, "The Iterator is invalid (end).");
+    return;
+  }
+
+  if (m_uiIndex > 0)
+  {
+    --m_uiIndex;
+    return;
+  }
+
+  m_pLeaf = m_pLeaf->m_pPrev;
+  m_uiIndex = (m_pLeaf != nullptr) ? m_pLeaf->m_uiCount - 1 : 0;
+}
+
+// ***** ezBTreeMapBase *****
+
+template <typename KeyType, typename ValueType, typename Comparer>
+ezBTreeMapBase<KeyType, ValueType, Comparer>::ezBTreeMapBase(const Comparer& comparer, ezAllocatorBase* pAllocator)
+  : m_pRoot(nullptr)
+  , m_uiDepth(0)
+  , m_pFirstLeaf(nullptr)
+  , m_pLastLeaf(nullptr)
+  , m_uiCount(0)
+  , m_uiNumLeafNodes(0)
+  , m_uiNumInnerNodes(0)
+  , m_pAllocator(pAllocator)
+  , m_Comparer(comparer)
+{
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+ezBTreeMapBase<KeyType, ValueType, Comparer>::ezBTreeMapBase(const ezBTreeMapBase<KeyType, ValueType, Comparer>& cc, ezAllocatorBase* pAllocator)
+  : m_pRoot(nullptr)
+  , m_uiDepth(0)
+  , m_pFirstLeaf(nullptr)
+  , m_pLastLeaf(nullptr)
+  , m_uiCount(0)
+  , m_uiNumLeafNodes(0)
+  , m_uiNumInnerNodes(0)
+  , m_pAllocator(pAllocator)
+  , m_Comparer(cc.m_Comparer)
+{
+  operator=(cc);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+ezBTreeMapBase<KeyType, ValueType, Comparer>::~ezBTreeMapBase()
+{
+  Clear();
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+void ezBTreeMapBase<KeyType, ValueType, Comparer>::operator=(const ezBTreeMapBase<KeyType, ValueType, Comparer>& rhs)
+{
+  if (this == &rhs)
+    return;
+
+  // rhs is sorted already, so the tree can be built bottom-up
+  ConstIterator it = rhs.GetIterator();
+  Internal_BuildFromSorted(rhs.GetCount(), [&it](KeyType* pKey, ValueType* pValue) {
+    ezMemoryUtils::CopyConstruct(pKey, it.Key(), 1);
+    ezMemoryUtils::CopyConstruct(pValue, it.Value(), 1);
+    it.Next();
+  });
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+EZ_ALWAYS_INLINE bool ezBTreeMapBase<KeyType, ValueType, Comparer>::IsEmpty() const
+{
+  return (m_uiCount == 0);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+EZ_ALWAYS_INLINE ezUInt32 ezBTreeMapBase<KeyType, ValueType, Comparer>::GetCount() const
+{
+  return m_uiCount;
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+void ezBTreeMapBase<KeyType, ValueType, Comparer>::Clear()
+{
+  if (m_pRoot != nullptr)
+  {
+    DestroySubTree(m_pRoot, m_uiDepth);
+  }
+
+  m_pRoot = nullptr;
+  m_uiDepth = 0;
+  m_pFirstLeaf = nullptr;
+  m_pLastLeaf = nullptr;
+  m_uiCount = 0;
+
+  EZ_ASSERT_DEBUG(m_uiNumLeafNodes == 0 && m_uiNumInnerNodes == 0, "Implementation error, not all nodes were released.");
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+void ezBTreeMapBase<KeyType, ValueType, Comparer>::BuildFromSorted(ezArrayPtr<const KeyType> keys, ezArrayPtr<const ValueType> values)
+{
+  EZ_ASSERT_DEV(keys.GetCount() == values.GetCount(), "Number of keys ({0}) and values ({1}) must match.", keys.GetCount(), values.GetCount());
+
+  ezUInt32 uiIndex = 0;
+  Internal_BuildFromSorted(keys.GetCount(), [&](KeyType* pKey, ValueType* pValue) {
+    ezMemoryUtils::CopyConstruct(pKey, keys[uiIndex], 1);
+    ezMemoryUtils::CopyConstruct(pValue, values[uiIndex], 1);
+    ++uiIndex;
+  });
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+EZ_FORCE_INLINE typename ezBTreeMapBase<KeyType, ValueType, Comparer>::Iterator ezBTreeMapBase<KeyType, ValueType, Comparer>::GetIterator()
+{
+  return Iterator(m_pFirstLeaf, 0);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+EZ_FORCE_INLINE typename ezBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator ezBTreeMapBase<KeyType, ValueType, Comparer>::GetIterator() const
+{
+  return ConstIterator(m_pFirstLeaf, 0);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+EZ_FORCE_INLINE typename ezBTreeMapBase<KeyType, ValueType, Comparer>::Iterator ezBTreeMapBase<KeyType, ValueType, Comparer>::GetLastIterator()
+{
+  return Iterator(m_pLastLeaf, m_pLastLeaf != nullptr ? m_pLastLeaf->m_uiCount - 1 : 0);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+EZ_FORCE_INLINE typename ezBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator ezBTreeMapBase<KeyType, ValueType, Comparer>::GetLastIterator() const
+{
+  return ConstIterator(m_pLastLeaf, m_pLastLeaf != nullptr ? m_pLastLeaf->m_uiCount - 1 : 0);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType, typename CompatibleValueType>
+typename ezBTreeMapBase<KeyType, ValueType, Comparer>::Iterator ezBTreeMapBase<KeyType, ValueType, Comparer>::Insert(CompatibleKeyType&& key, CompatibleValueType&& value)
+{
+  bool bExisted = false;
+  ConstIterator it = Internal_FindOrInsertSlot(key, bExisted);
+
+  if (bExisted)
+  {
+    it.m_pLeaf->Values()[it.m_uiIndex] = std::forward<CompatibleValueType>(value);
+  }
+  else
+  {
+    ezMemoryUtils::CopyOrMoveConstruct<KeyType>(&it.m_pLeaf->Keys()[it.m_uiIndex], std::forward<CompatibleKeyType>(key));
+    ezMemoryUtils::CopyOrMoveConstruct<ValueType>(&it.m_pLeaf->Values()[it.m_uiIndex], std::forward<CompatibleValueType>(value));
+  }
+
+  return Iterator(it.m_pLeaf, it.m_uiIndex);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+typename ezBTreeMapBase<KeyType, ValueType, Comparer>::Iterator ezBTreeMapBase<KeyType, ValueType, Comparer>::FindOrAdd(CompatibleKeyType&& key, bool* bExisted)
+{
+  bool bFound = false;
+  ConstIterator it = Internal_FindOrInsertSlot(key, bFound);
+
+  if (!bFound)
+  {
+    ezMemoryUtils::CopyOrMoveConstruct<KeyType>(&it.m_pLeaf->Keys()[it.m_uiIndex], std::forward<CompatibleKeyType>(key));
+    ezMemoryUtils::DefaultConstruct(&it.m_pLeaf->Values()[it.m_uiIndex], 1);
+  }
+
+  if (bExisted != nullptr)
+    *bExisted = bFound;
+
+  return Iterator(it.m_pLeaf, it.m_uiIndex);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+EZ_FORCE_INLINE ValueType& ezBTreeMapBase<KeyType, ValueType, Comparer>::operator[](const CompatibleKeyType& key)
+{
+  return FindOrAdd(key).Value();
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+bool ezBTreeMapBase<KeyType, ValueType, Comparer>::Remove(const CompatibleKeyType& key)
+{
+  if (m_pRoot == nullptr)
+    return false;
+
+  Path path;
+  LeafNode* pLeaf = FindLeaf(key, &path);
+
+  const ezUInt32 uiIndex = LowerBoundInNode(pLeaf->Keys(), pLeaf->m_uiCount, key);
+  if (uiIndex >= pLeaf->m_uiCount || m_Comparer.Less(key, pLeaf->Keys()[uiIndex]))
+    return false;
+
+  Internal_RemoveAt(path, pLeaf, uiIndex);
+  return true;
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+typename ezBTreeMapBase<KeyType, ValueType, Comparer>::Iterator ezBTreeMapBase<KeyType, ValueType, Comparer>::Remove(const Iterator& pos)
+{
+  EZ_ASSERT_DEV(pos.IsValid(), "The Iterator(pos) is invalid.");
+
+  // the keys are unique, so following the key of the element leads to its leaf and records the path on the way
+  Path path;
+  EZ_VERIFY(FindLeaf(pos.Key(), &path) == pos.m_pLeaf, "The Iterator(pos) does not belong to this container.");
+
+  return Internal_RemoveAt(path, pos.m_pLeaf, pos.m_uiIndex);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+bool ezBTreeMapBase<KeyType, ValueType, Comparer>::TryGetValue(const CompatibleKeyType& key, ValueType& out_value) const
+{
+  ConstIterator it = Internal_Find(key);
+  if (it.IsValid())
+  {
+    out_value = it.Value();
+    return true;
+  }
+
+  return false;
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+bool ezBTreeMapBase<KeyType, ValueType, Comparer>::TryGetValue(const CompatibleKeyType& key, const ValueType*& out_pValue) const
+{
+  ConstIterator it = Internal_Find(key);
+  if (it.IsValid())
+  {
+    out_pValue = &it.Value();
+    return true;
+  }
+
+  return false;
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+bool ezBTreeMapBase<KeyType, ValueType, Comparer>::TryGetValue(const CompatibleKeyType& key, ValueType*& out_pValue) const
+{
+  ConstIterator it = Internal_Find(key);
+  if (it.IsValid())
+  {
+    out_pValue = &it.m_pLeaf->Values()[it.m_uiIndex];
+    return true;
+  }
+
+  return false;
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+const ValueType* ezBTreeMapBase<KeyType, ValueType, Comparer>::GetValue(const CompatibleKeyType& key) const
+{
+  ConstIterator it = Internal_Find(key);
+  return it.IsValid() ? &it.Value() : nullptr;
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+ValueType* ezBTreeMapBase<KeyType, ValueType, Comparer>::GetValue(const CompatibleKeyType& key)
+{
+  ConstIterator it = Internal_Find(key);
+  return it.IsValid() ? &it.m_pLeaf->Values()[it.m_uiIndex] : nullptr;
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+const ValueType& ezBTreeMapBase<KeyType, ValueType, Comparer>::GetValueOrDefault(const CompatibleKeyType& key, const ValueType& defaultValue) const
+{
+  ConstIterator it = Internal_Find(key);
+  return it.IsValid() ? it.Value() : defaultValue;
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+EZ_FORCE_INLINE typename ezBTreeMapBase<KeyType, ValueType, Comparer>::Iterator ezBTreeMapBase<KeyType, ValueType, Comparer>::Find(const CompatibleKeyType& key)
+{
+  ConstIterator it = Internal_Find(key);
+  return Iterator(it.m_pLeaf, it.m_uiIndex);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+EZ_FORCE_INLINE typename ezBTreeMapBase<KeyType, ValueType, Comparer>::Iterator ezBTreeMapBase<KeyType, ValueType, Comparer>::LowerBound(const CompatibleKeyType& key)
+{
+  ConstIterator it = Internal_LowerBound(key);
+  return Iterator(it.m_pLeaf, it.m_uiIndex);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+EZ_FORCE_INLINE typename ezBTreeMapBase<KeyType, ValueType, Comparer>::Iterator ezBTreeMapBase<KeyType, ValueType, Comparer>::UpperBound(const CompatibleKeyType& key)
+{
+  ConstIterator it = Internal_UpperBound(key);
+  return Iterator(it.m_pLeaf, it.m_uiIndex);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+EZ_FORCE_INLINE typename ezBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator ezBTreeMapBase<KeyType, ValueType, Comparer>::Find(const CompatibleKeyType& key) const
+{
+  return Internal_Find(key);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+EZ_FORCE_INLINE bool ezBTreeMapBase<KeyType, ValueType, Comparer>::Contains(const CompatibleKeyType& key) const
+{
+  return Internal_Find(key).IsValid();
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+EZ_FORCE_INLINE typename ezBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator ezBTreeMapBase<KeyType, ValueType, Comparer>::LowerBound(const CompatibleKeyType& key) const
+{
+  return Internal_LowerBound(key);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+EZ_FORCE_INLINE typename ezBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator ezBTreeMapBase<KeyType, ValueType, Comparer>::UpperBound(const CompatibleKeyType& key) const
+{
+  return Internal_UpperBound(key);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+bool ezBTreeMapBase<KeyType, ValueType, Comparer>::operator==(const ezBTreeMapBase<KeyType, ValueType, Comparer>& rhs) const
+{
+  if (GetCount() != rhs.GetCount())
+    return false;
+
+  auto itLhs = GetIterator();
+  auto itRhs = rhs.GetIterator();
+
+  while (itLhs.IsValid())
+  {
+    if (!m_Comparer.Equal(itLhs.Key(), itRhs.Key()))
+      return false;
+
+    if (itLhs.Value() != itRhs.Value())
+      return false;
+
+    itLhs.Next();
+    itRhs.Next();
+  }
+
+  return true;
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+EZ_ALWAYS_INLINE bool ezBTreeMapBase<KeyType, ValueType, Comparer>::operator!=(const ezBTreeMapBase<KeyType, ValueType, Comparer>& rhs) const
+{
+  return !operator==(rhs);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+ezUInt64 ezBTreeMapBase<KeyType, ValueType, Comparer>::GetHeapMemoryUsage() const
+{
+  return (ezUInt64)m_uiNumLeafNodes * sizeof(LeafNode) + (ezUInt64)m_uiNumInnerNodes * sizeof(InnerNode);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+void ezBTreeMapBase<KeyType, ValueType, Comparer>::Swap(ezBTreeMapBase<KeyType, ValueType, Comparer>& other)
+{
+  // the nodes do not point back into the container, so swapping all members is enough
+  ezMath::Swap(this->m_pRoot, other.m_pRoot);
+  ezMath::Swap(this->m_uiDepth, other.m_uiDepth);
+  ezMath::Swap(this->m_pFirstLeaf, other.m_pFirstLeaf);
+  ezMath::Swap(this->m_pLastLeaf, other.m_pLastLeaf);
+  ezMath::Swap(this->m_uiCount, other.m_uiCount);
+  ezMath::Swap(this->m_uiNumLeafNodes, other.m_uiNumLeafNodes);
+  ezMath::Swap(this->m_uiNumInnerNodes, other.m_uiNumInnerNodes);
+  ezMath::Swap(this->m_pAllocator, other.m_pAllocator);
+  ezMath::Swap(this->m_Comparer, other.m_Comparer);
+}
+
+// ***** private functions *****
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename T>
+void ezBTreeMapBase<KeyType, ValueType, Comparer>::RelocateElements(T* pDestination, T* pSource, ezUInt32 uiCount)
+{
+  if (pDestination == pSource || uiCount == 0)
+    return;
+
+  if constexpr (ezGetTypeClass<T>::value != ezTypeIsClass::value)
+  {
+    memmove(static_cast<void*>(pDestination), pSource, uiCount * sizeof(T));
+  }
+  else if (pDestination < pSource)
+  {
+    for (ezUInt32 i = 0; i < uiCount; ++i)
+    {
+      ezMemoryUtils::RelocateConstruct(pDestination + i, pSource + i, 1);
+    }
+  }
+  else
+  {
+    for (ezUInt32 i = uiCount; i > 0; --i)
+    {
+      ezMemoryUtils::RelocateConstruct(pDestination + i - 1, pSource + i - 1, 1);
+    }
+  }
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+EZ_FORCE_INLINE ezUInt32 ezBTreeMapBase<KeyType, ValueType, Comparer>::LowerBoundInNode(
+  const KeyType* pKeys, ezUInt32 uiCount, const CompatibleKeyType& key) const
+{
+  ezUInt32 uiFirst = 0;
+
+  while (uiCount > 0)
+  {
+    const ezUInt32 uiHalf = uiCount / 2;
+
+    if (m_Comparer.Less(pKeys[uiFirst + uiHalf], key))
+    {
+      uiFirst += uiHalf + 1;
+      uiCount -= uiHalf + 1;
+    }
+    else
+    {
+      uiCount = uiHalf;
+    }
+  }
+
+  return uiFirst;
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+EZ_FORCE_INLINE ezUInt32 ezBTreeMapBase<KeyType, ValueType, Comparer>::UpperBoundInNode(
+  const KeyType* pKeys, ezUInt32 uiCount, const CompatibleKeyType& key) const
+{
+  ezUInt32 uiFirst = 0;
+
+  while (uiCount > 0)
+  {
+    const ezUInt32 uiHalf = uiCount / 2;
+
+    if (!m_Comparer.Less(key, pKeys[uiFirst + uiHalf]))
+    {
+      uiFirst += uiHalf + 1;
+      uiCount -= uiHalf + 1;
+    }
+    else
+    {
+      uiCount = uiHalf;
+    }
+  }
+
+  return uiFirst;
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+typename ezBTreeMapBase<KeyType, ValueType, Comparer>::LeafNode* ezBTreeMapBase<KeyType, ValueType, Comparer>::FindLeaf(
+  const CompatibleKeyType& key, Path* pPath) const
+{
+  Node* pNode = m_pRoot;
+
+  for (ezUInt32 uiLevel = 0; uiLevel < m_uiDepth; ++uiLevel)
+  {
+    InnerNode* pInner = static_cast<InnerNode*>(pNode);
+
+    // keys equal to a separator are stored in the child right of it
+    const ezUInt32 uiChild = UpperBoundInNode(pInner->Keys(), pInner->m_uiCount - 1u, key);
+
+    if (pPath != nullptr)
+    {
+      pPath->m_pNodes[uiLevel] = pInner;
+      pPath->m_uiChildIndices[uiLevel] = uiChild;
+    }
+
+    pNode = pInner->m_pChildren[uiChild];
+  }
+
+  return static_cast<LeafNode*>(pNode);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+typename ezBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator ezBTreeMapBase<KeyType, ValueType, Comparer>::Internal_Find(
+  const CompatibleKeyType& key) const
+{
+  ConstIterator it = Internal_LowerBound(key);
+
+  if (it.IsValid() && m_Comparer.Less(key, it.Key()))
+    return ConstIterator();
+
+  return it;
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+typename ezBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator ezBTreeMapBase<KeyType, ValueType, Comparer>::Internal_LowerBound(
+  const CompatibleKeyType& key) const
+{
+  if (m_pRoot == nullptr)
+    return ConstIterator();
+
+  LeafNode* pLeaf = FindLeaf(key, nullptr);
+  const ezUInt32 uiIndex = LowerBoundInNode(pLeaf->Keys(), pLeaf->m_uiCount, key);
+
+  // all keys in the next leaf are larger than the separator that led here, so its first key is the result
+  if (uiIndex >= pLeaf->m_uiCount)
+    return ConstIterator(pLeaf->m_pNext, 0);
+
+  return ConstIterator(pLeaf, uiIndex);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+typename ezBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator ezBTreeMapBase<KeyType, ValueType, Comparer>::Internal_UpperBound(
+  const CompatibleKeyType& key) const
+{
+  if (m_pRoot == nullptr)
+    return ConstIterator();
+
+  LeafNode* pLeaf = FindLeaf(key, nullptr);
+  const ezUInt32 uiIndex = UpperBoundInNode(pLeaf->Keys(), pLeaf->m_uiCount, key);
+
+  if (uiIndex >= pLeaf->m_uiCount)
+    return ConstIterator(pLeaf->m_pNext, 0);
+
+  return ConstIterator(pLeaf, uiIndex);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+typename ezBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator ezBTreeMapBase<KeyType, ValueType, Comparer>::Internal_FindOrInsertSlot(
+  const CompatibleKeyType& key, bool& out_bExisted)
+{
+  if (m_pRoot == nullptr)
+  {
+    LeafNode* pLeaf = AcquireLeaf();
+    m_pRoot = pLeaf;
+    m_pFirstLeaf = pLeaf;
+    m_pLastLeaf = pLeaf;
+  }
+
+  Path path;
+  LeafNode* pLeaf = FindLeaf(key, &path);
+  ezUInt32 uiIndex = LowerBoundInNode(pLeaf->Keys(), pLeaf->m_uiCount, key);
+
+  if (uiIndex < pLeaf->m_uiCount && !m_Comparer.Less(key, pLeaf->Keys()[uiIndex]))
+  {
+    out_bExisted = true;
+    return ConstIterator(pLeaf, uiIndex);
+  }
+
+  out_bExisted = false;
+
+  if (pLeaf->m_uiCount == LeafCapacity)
+  {
+    // move the upper half into a new leaf right of this one
+    LeafNode* pRight = AcquireLeaf();
+    const ezUInt32 uiKeep = LeafCapacity / 2;
+    const ezUInt32 uiMove = LeafCapacity - uiKeep;
+
+    RelocateElements(pRight->Keys(), pLeaf->Keys() + uiKeep, uiMove);
+    RelocateElements(pRight->Values(), pLeaf->Values() + uiKeep, uiMove);
+    pLeaf->m_uiCount = static_cast<ezUInt16>(uiKeep);
+    pRight->m_uiCount = static_cast<ezUInt16>(uiMove);
+
+    pRight->m_pPrev = pLeaf;
+    pRight->m_pNext = pLeaf->m_pNext;
+    if (pLeaf->m_pNext != nullptr)
+      pLeaf->m_pNext->m_pPrev = pRight;
+    else
+      m_pLastLeaf = pRight;
+    pLeaf->m_pNext = pRight;
+
+    // the new key is not the first one in the right leaf (it is larger than the separator), so the separator stays valid after the insertion
+    InsertIntoParent(path, m_uiDepth, pLeaf, pRight->Keys()[0], pRight);
+
+    if (uiIndex > uiKeep)
+    {
+      uiIndex -= uiKeep;
+      pLeaf = pRight;
+    }
+  }
+
+  RelocateElements(pLeaf->Keys() + uiIndex + 1, pLeaf->Keys() + uiIndex, pLeaf->m_uiCount - uiIndex);
+  RelocateElements(pLeaf->Values() + uiIndex + 1, pLeaf->Values() + uiIndex, pLeaf->m_uiCount - uiIndex);
+  ++pLeaf->m_uiCount;
+  ++m_uiCount;
+
+  return ConstIterator(pLeaf, uiIndex);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+void ezBTreeMapBase<KeyType, ValueType, Comparer>::InsertIntoParent(Path& path, ezUInt32 uiLevel, Node* pLeft, const KeyType& separator, Node* pRight)
+{
+  if (uiLevel == 0)
+  {
+    // pLeft was the root, grow the tree by one level
+    InnerNode* pRoot = AcquireInner();
+    pRoot->m_uiCount = 2;
+    pRoot->m_pChildren[0] = pLeft;
+    pRoot->m_pChildren[1] = pRight;
+    ezMemoryUtils::CopyConstruct(pRoot->Keys(), separator, 1);
+
+    m_pRoot = pRoot;
+    ++m_uiDepth;
+    return;
+  }
+
+  InnerNode* pParent = path.m_pNodes[uiLevel - 1];
+  ezUInt32 uiChild = path.m_uiChildIndices[uiLevel - 1];
+
+  if (pParent->m_uiCount < InnerCapacity)
+  {
+    const ezUInt32 uiNumKeys = pParent->m_uiCount - 1u;
+
+    RelocateElements(pParent->Keys() + uiChild + 1, pParent->Keys() + uiChild, uiNumKeys - uiChild);
+    ezMemoryUtils::CopyConstruct(pParent->Keys() + uiChild, separator, 1);
+
+    RelocateElements(pParent->m_pChildren + uiChild + 2, pParent->m_pChildren + uiChild + 1, pParent->m_uiCount - uiChild - 1);
+    pParent->m_pChildren[uiChild + 1] = pRight;
+
+    ++pParent->m_uiCount;
+    return;
+  }
+
+  // The parent is full. Split it into two halves, the key between them moves up one level.
+  InnerNode* pNewInner = AcquireInner();
+  const ezUInt32 uiKeep = InnerCapacity / 2;
+  const ezUInt32 uiMove = InnerCapacity - uiKeep;
+
+  KeyType upKey(std::move(pParent->Keys()[uiKeep - 1]));
+  ezMemoryUtils::Destruct(pParent->Keys() + uiKeep - 1, 1);
+
+  RelocateElements(pNewInner->Keys(), pParent->Keys() + uiKeep, uiMove - 1);
+  RelocateElements(pNewInner->m_pChildren, pParent->m_pChildren + uiKeep, uiMove);
+  pParent->m_uiCount = static_cast<ezUInt16>(uiKeep);
+  pNewInner->m_uiCount = static_cast<ezUInt16>(uiMove);
+
+  // now there is room for the new child in one of the halves
+  InnerNode* pTarget = pParent;
+  if (uiChild >= uiKeep)
+  {
+    pTarget = pNewInner;
+    uiChild -= uiKeep;
+  }
+
+  const ezUInt32 uiNumKeys = pTarget->m_uiCount - 1u;
+  RelocateElements(pTarget->Keys() + uiChild + 1, pTarget->Keys() + uiChild, uiNumKeys - uiChild);
+  ezMemoryUtils::CopyConstruct(pTarget->Keys() + uiChild, separator, 1);
+  RelocateElements(pTarget->m_pChildren + uiChild + 2, pTarget->m_pChildren + uiChild + 1, pTarget->m_uiCount - uiChild - 1);
+  pTarget->m_pChildren[uiChild + 1] = pRight;
+  ++pTarget->m_uiCount;
+
+  InsertIntoParent(path, uiLevel - 1, pParent, upKey, pNewInner);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+typename ezBTreeMapBase<KeyType, ValueType, Comparer>::Iterator ezBTreeMapBase<KeyType, ValueType, Comparer>::Internal_RemoveAt(
+  Path& path, LeafNode* pLeaf, ezUInt32 uiIndex)
+{
+  ezMemoryUtils::Destruct(pLeaf->Keys() + uiIndex, 1);
+  ezMemoryUtils::Destruct(pLeaf->Values() + uiIndex, 1);
+
+  RelocateElements(pLeaf->Keys() + uiIndex, pLeaf->Keys() + uiIndex + 1, pLeaf->m_uiCount - uiIndex - 1);
+  RelocateElements(pLeaf->Values() + uiIndex, pLeaf->Values() + uiIndex + 1, pLeaf->m_uiCount - uiIndex - 1);
+  --pLeaf->m_uiCount;
+  --m_uiCount;
+
+  if (m_uiCount == 0)
+  {
+    ReleaseLeaf(pLeaf);
+    m_pRoot = nullptr;
+    m_uiDepth = 0;
+    m_pFirstLeaf = nullptr;
+    m_pLastLeaf = nullptr;
+    return Iterator();
+  }
+
+  // the element after the removed one is now at the same index (which may be one past the end of the leaf)
+  LeafNode* pNextLeaf = pLeaf;
+  ezUInt32 uiNextIndex = uiIndex;
+
+  if (m_uiDepth > 0 && pLeaf->m_uiCount < MinLeafCount)
+  {
+    RebalanceLeaf(path, pLeaf, pNextLeaf, uiNextIndex);
+  }
+
+  if (uiNextIndex >= pNextLeaf->m_uiCount)
+  {
+    pNextLeaf = pNextLeaf->m_pNext;
+    uiNextIndex = 0;
+  }
+
+  return Iterator(pNextLeaf, uiNextIndex);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+void ezBTreeMapBase<KeyType, ValueType, Comparer>::RebalanceLeaf(Path& path, LeafNode* pLeaf, LeafNode*& ref_pNextLeaf, ezUInt32& ref_uiNextIndex)
+{
+  InnerNode* pParent = path.m_pNodes[m_uiDepth - 1];
+  const ezUInt32 uiChild = path.m_uiChildIndices[m_uiDepth - 1];
+
+  LeafNode* pLeftSibling = (uiChild > 0) ? static_cast<LeafNode*>(pParent->m_pChildren[uiChild - 1]) : nullptr;
+  LeafNode* pRightSibling = (uiChild + 1 < pParent->m_uiCount) ? static_cast<LeafNode*>(pParent->m_pChildren[uiChild + 1]) : nullptr;
+
+  if (pLeftSibling != nullptr && pLeftSibling->m_uiCount > MinLeafCount)
+  {
+    // borrow the last element of the left sibling
+    RelocateElements(pLeaf->Keys() + 1, pLeaf->Keys(), pLeaf->m_uiCount);
+    RelocateElements(pLeaf->Values() + 1, pLeaf->Values(), pLeaf->m_uiCount);
+
+    const ezUInt32 uiLast = pLeftSibling->m_uiCount - 1u;
+    RelocateElements(pLeaf->Keys(), pLeftSibling->Keys() + uiLast, 1);
+    RelocateElements(pLeaf->Values(), pLeftSibling->Values() + uiLast, 1);
+
+    --pLeftSibling->m_uiCount;
+    ++pLeaf->m_uiCount;
+    ++ref_uiNextIndex;
+
+    pParent->Keys()[uiChild - 1] = pLeaf->Keys()[0];
+    return;
+  }
+
+  if (pRightSibling != nullptr && pRightSibling->m_uiCount > MinLeafCount)
+  {
+    // borrow the first element of the right sibling
+    RelocateElements(pLeaf->Keys() + pLeaf->m_uiCount, pRightSibling->Keys(), 1);
+    RelocateElements(pLeaf->Values() + pLeaf->m_uiCount, pRightSibling->Values(), 1);
+
+    RelocateElements(pRightSibling->Keys(), pRightSibling->Keys() + 1, pRightSibling->m_uiCount - 1u);
+    RelocateElements(pRightSibling->Values(), pRightSibling->Values() + 1, pRightSibling->m_uiCount - 1u);
+
+    --pRightSibling->m_uiCount;
+    ++pLeaf->m_uiCount;
+
+    pParent->Keys()[uiChild] = pRightSibling->Keys()[0];
+    return;
+  }
+
+  // neither sibling can spare an element, so merge with one of them
+  LeafNode* pMergeLeft = pLeaf;
+  LeafNode* pMergeRight = pRightSibling;
+  ezUInt32 uiRemovedChild = uiChild + 1;
+
+  if (pLeftSibling != nullptr)
+  {
+    pMergeLeft = pLeftSibling;
+    pMergeRight = pLeaf;
+    uiRemovedChild = uiChild;
+
+    ref_pNextLeaf = pLeftSibling;
+    ref_uiNextIndex += pLeftSibling->m_uiCount;
+  }
+
+  RelocateElements(pMergeLeft->Keys() + pMergeLeft->m_uiCount, pMergeRight->Keys(), pMergeRight->m_uiCount);
+  RelocateElements(pMergeLeft->Values() + pMergeLeft->m_uiCount, pMergeRight->Values(), pMergeRight->m_uiCount);
+  pMergeLeft->m_uiCount = static_cast<ezUInt16>(pMergeLeft->m_uiCount + pMergeRight->m_uiCount);
+  pMergeRight->m_uiCount = 0;
+
+  pMergeLeft->m_pNext = pMergeRight->m_pNext;
+  if (pMergeRight->m_pNext != nullptr)
+    pMergeRight->m_pNext->m_pPrev = pMergeLeft;
+  else
+    m_pLastLeaf = pMergeLeft;
+
+  ReleaseLeaf(pMergeRight);
+
+  RemoveChildFromInner(path, m_uiDepth - 1, uiRemovedChild);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+void ezBTreeMapBase<KeyType, ValueType, Comparer>::RemoveChildFromInner(Path& path, ezUInt32 uiLevel, ezUInt32 uiChildIndex)
+{
+  InnerNode* pInner = path.m_pNodes[uiLevel];
+  EZ_ASSERT_DEBUG(uiChildIndex > 0 && uiChildIndex < pInner->m_uiCount, "Invalid child index");
+
+  const ezUInt32 uiNumKeys = pInner->m_uiCount - 1u;
+  ezMemoryUtils::Destruct(pInner->Keys() + uiChildIndex - 1, 1);
+  RelocateElements(pInner->Keys() + uiChildIndex - 1, pInner->Keys() + uiChildIndex, uiNumKeys - uiChildIndex);
+  RelocateElements(pInner->m_pChildren + uiChildIndex, pInner->m_pChildren + uiChildIndex + 1, pInner->m_uiCount - uiChildIndex - 1u);
+  --pInner->m_uiCount;
+
+  if (uiLevel == 0)
+  {
+    // the root may have fewer children than the others, but once it only has one child, that child becomes the new root
+    if (pInner->m_uiCount == 1)
+    {
+      m_pRoot = pInner->m_pChildren[0];
+      --m_uiDepth;
+      ReleaseInner(pInner);
+    }
+
+    return;
+  }
+
+  if (pInner->m_uiCount < MinInnerCount)
+  {
+    RebalanceInner(path, uiLevel);
+  }
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+void ezBTreeMapBase<KeyType, ValueType, Comparer>::RebalanceInner(Path& path, ezUInt32 uiLevel)
+{
+  InnerNode* pInner = path.m_pNodes[uiLevel];
+  InnerNode* pParent = path.m_pNodes[uiLevel - 1];
+  const ezUInt32 uiChild = path.m_uiChildIndices[uiLevel - 1];
+
+  InnerNode* pLeftSibling = (uiChild > 0) ? static_cast<InnerNode*>(pParent->m_pChildren[uiChild - 1]) : nullptr;
+  InnerNode* pRightSibling = (uiChild + 1 < pParent->m_uiCount) ? static_cast<InnerNode*>(pParent->m_pChildren[uiChild + 1]) : nullptr;
+
+  if (pLeftSibling != nullptr && pLeftSibling->m_uiCount > MinInnerCount)
+  {
+    // rotate the last child of the left sibling over the separator in the parent
+    RelocateElements(pInner->Keys() + 1, pInner->Keys(), pInner->m_uiCount - 1u);
+    RelocateElements(pInner->m_pChildren + 1, pInner->m_pChildren, pInner->m_uiCount);
+
+    const ezUInt32 uiLastKey = pLeftSibling->m_uiCount - 2u;
+    ezMemoryUtils::MoveConstruct(pInner->Keys(), std::move(pParent->Keys()[uiChild - 1]));
+    pParent->Keys()[uiChild - 1] = std::move(pLeftSibling->Keys()[uiLastKey]);
+    ezMemoryUtils::Destruct(pLeftSibling->Keys() + uiLastKey, 1);
+    pInner->m_pChildren[0] = pLeftSibling->m_pChildren[uiLastKey + 1];
+
+    --pLeftSibling->m_uiCount;
+    ++pInner->m_uiCount;
+    return;
+  }
+
+  if (pRightSibling != nullptr && pRightSibling->m_uiCount > MinInnerCount)
+  {
+    // rotate the first child of the right sibling over the separator in the parent
+    ezMemoryUtils::MoveConstruct(pInner->Keys() + pInner->m_uiCount - 1, std::move(pParent->Keys()[uiChild]));
+    pInner->m_pChildren[pInner->m_uiCount] = pRightSibling->m_pChildren[0];
+    pParent->Keys()[uiChild] = std::move(pRightSibling->Keys()[0]);
+    ezMemoryUtils::Destruct(pRightSibling->Keys(), 1);
+
+    RelocateElements(pRightSibling->Keys(), pRightSibling->Keys() + 1, pRightSibling->m_uiCount - 2u);
+    RelocateElements(pRightSibling->m_pChildren, pRightSibling->m_pChildren + 1, pRightSibling->m_uiCount - 1u);
+
+    --pRightSibling->m_uiCount;
+    ++pInner->m_uiCount;
+    return;
+  }
+
+  // merge with one of the siblings, the separator between the two moves down into the merged node
+  InnerNode* pMergeLeft = pInner;
+  InnerNode* pMergeRight = pRightSibling;
+  ezUInt32 uiRemovedChild = uiChild + 1;
+
+  if (pLeftSibling != nullptr)
+  {
+    pMergeLeft = pLeftSibling;
+    pMergeRight = pInner;
+    uiRemovedChild = uiChild;
+  }
+
+  ezMemoryUtils::MoveConstruct(pMergeLeft->Keys() + pMergeLeft->m_uiCount - 1, std::move(pParent->Keys()[uiRemovedChild - 1]));
+  RelocateElements(pMergeLeft->Keys() + pMergeLeft->m_uiCount, pMergeRight->Keys(), pMergeRight->m_uiCount - 1u);
+  RelocateElements(pMergeLeft->m_pChildren + pMergeLeft->m_uiCount, pMergeRight->m_pChildren, pMergeRight->m_uiCount);
+  pMergeLeft->m_uiCount = static_cast<ezUInt16>(pMergeLeft->m_uiCount + pMergeRight->m_uiCount);
+  pMergeRight->m_uiCount = 0;
+
+  ReleaseInner(pMergeRight);
+
+  RemoveChildFromInner(path, uiLevel - 1, uiRemovedChild);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename ConstructFunc>
+void ezBTreeMapBase<KeyType, ValueType, Comparer>::Internal_BuildFromSorted(ezUInt32 uiCount, ConstructFunc constructElement)
+{
+  Clear();
+
+  if (uiCount == 0)
+    return;
+
+  // first create all leaves, distributing the elements evenly, so that all of them are at least half full
+  ezDynamicArray<Node*> nodes(m_pAllocator);
+  ezDynamicArray<const KeyType*> firstKeys(m_pAllocator);
+
+  const ezUInt32 uiNumLeaves = (uiCount + LeafCapacity - 1) / LeafCapacity;
+  nodes.Reserve(uiNumLeaves);
+  firstKeys.Reserve(uiNumLeaves);
+
+  const KeyType* pPrevKey = nullptr;
+  LeafNode* pPrevLeaf = nullptr;
+
+  for (ezUInt32 uiLeaf = 0; uiLeaf < uiNumLeaves; ++uiLeaf)
+  {
+    LeafNode* pLeaf = AcquireLeaf();
+    pLeaf->m_uiCount = static_cast<ezUInt16>(uiCount / uiNumLeaves + ((uiLeaf < uiCount % uiNumLeaves) ? 1 : 0));
+
+    for (ezUInt32 i = 0; i < pLeaf->m_uiCount; ++i)
+    {
+      constructElement(pLeaf->Keys() + i, pLeaf->Values() + i);
+
+      EZ_ASSERT_DEBUG(pPrevKey == nullptr || m_Comparer.Less(*pPrevKey, pLeaf->Keys()[i]), "The keys must be sorted and unique.");
+      pPrevKey = pLeaf->Keys() + i;
+    }
+
+    pLeaf->m_pPrev = pPrevLeaf;
+    if (pPrevLeaf != nullptr)
+      pPrevLeaf->m_pNext = pLeaf;
+    else
+      m_pFirstLeaf = pLeaf;
+    pPrevLeaf = pLeaf;
+
+    nodes.PushBack(pLeaf);
+    firstKeys.PushBack(pLeaf->Keys());
+  }
+
+  m_pLastLeaf = pPrevLeaf;
+  m_uiCount = uiCount;
+
+  // then build the inner levels on top of each other until only the root is left
+  while (nodes.GetCount() > 1)
+  {
+    const ezUInt32 uiNumChildren = nodes.GetCount();
+    const ezUInt32 uiNumParents = (uiNumChildren + InnerCapacity - 1) / InnerCapacity;
+
+    ezUInt32 uiNextChild = 0;
+    for (ezUInt32 uiParent = 0; uiParent < uiNumParents; ++uiParent)
+    {
+      InnerNode* pInner = AcquireInner();
+      pInner->m_uiCount = static_cast<ezUInt16>(uiNumChildren / uiNumParents + ((uiParent < uiNumChildren % uiNumParents) ? 1 : 0));
+
+      const ezUInt32 uiFirstChild = uiNextChild;
+      for (ezUInt32 i = 0; i < pInner->m_uiCount; ++i)
+      {
+        pInner->m_pChildren[i] = nodes[uiFirstChild + i];
+
+        if (i > 0)
+        {
+          ezMemoryUtils::CopyConstruct(pInner->Keys() + i - 1, *firstKeys[uiFirstChild + i], 1);
+        }
+      }
+
+      uiNextChild += pInner->m_uiCount;
+
+      // the parents are written in place, they never overtake the children that are still needed
+      nodes[uiParent] = pInner;
+      firstKeys[uiParent] = firstKeys[uiFirstChild];
+    }
+
+    nodes.SetCount(uiNumParents);
+    firstKeys.SetCount(uiNumParents);
+    ++m_uiDepth;
+  }
+
+  m_pRoot = nodes[0];
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+typename ezBTreeMapBase<KeyType, ValueType, Comparer>::LeafNode* ezBTreeMapBase<KeyType, ValueType, Comparer>::AcquireLeaf()
+{
+  LeafNode* pLeaf = EZ_NEW(m_pAllocator, LeafNode);
+  pLeaf->m_uiCount = 0;
+  pLeaf->m_pPrev = nullptr;
+  pLeaf->m_pNext = nullptr;
+
+  ++m_uiNumLeafNodes;
+  return pLeaf;
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+typename ezBTreeMapBase<KeyType, ValueType, Comparer>::InnerNode* ezBTreeMapBase<KeyType, ValueType, Comparer>::AcquireInner()
+{
+  InnerNode* pInner = EZ_NEW(m_pAllocator, InnerNode);
+  pInner->m_uiCount = 0;
+
+  ++m_uiNumInnerNodes;
+  return pInner;
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+void ezBTreeMapBase<KeyType, ValueType, Comparer>::ReleaseLeaf(LeafNode* pLeaf)
+{
+  ezMemoryUtils::Destruct(pLeaf->Keys(), pLeaf->m_uiCount);
+  ezMemoryUtils::Destruct(pLeaf->Values(), pLeaf->m_uiCount);
+
+  EZ_DELETE(m_pAllocator, pLeaf);
+  --m_uiNumLeafNodes;
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+void ezBTreeMapBase<KeyType, ValueType, Comparer>::ReleaseInner(InnerNode* pInner)
+{
+  if (pInner->m_uiCount > 0)
+  {
+    ezMemoryUtils::Destruct(pInner->Keys(), pInner->m_uiCount - 1u);
+  }
+
+  EZ_DELETE(m_pAllocator, pInner);
+  --m_uiNumInnerNodes;
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+void ezBTreeMapBase<KeyType, ValueType, Comparer>::DestroySubTree(Node* pNode, ezUInt32 uiDepth)
+{
+  if (uiDepth == 0)
+  {
+    ReleaseLeaf(static_cast<LeafNode*>(pNode));
+    return;
+  }
+
+  InnerNode* pInner = static_cast<InnerNode*>(pNode);
+  for (ezUInt32 i = 0; i < pInner->m_uiCount; ++i)
+  {
+    DestroySubTree(pInner->m_pChildren[i], uiDepth - 1);
+  }
+
+  ReleaseInner(pInner);
+}
+
+
+template <typename KeyType, typename ValueType, typename Comparer, typename AllocatorWrapper>
+ezBTreeMap<KeyType, ValueType, Comparer, AllocatorWrapper>::ezBTreeMap()
+  : ezBTreeMapBase<KeyType, ValueType, Comparer>(Comparer(), AllocatorWrapper::GetAllocator())
+{
+}
+
+template <typename KeyType, typename ValueType, typename Comparer, typename AllocatorWrapper>
+ezBTreeMap<KeyType, ValueType, Comparer, AllocatorWrapper>::ezBTreeMap(ezAllocatorBase* pAllocator)
+  : ezBTreeMapBase<KeyType, ValueType, Comparer>(Comparer(), pAllocator)
+{
+}
+
+template <typename KeyType, typename ValueType, typename Comparer, typename AllocatorWrapper>
+ezBTreeMap<KeyType, ValueType, Comparer, AllocatorWrapper>::ezBTreeMap(const Comparer& comparer, ezAllocatorBase* pAllocator)
+  : ezBTreeMapBase<KeyType, ValueType, Comparer>(comparer, pAllocator)
+{
+}
+
+template <typename KeyType, typename ValueType, typename Comparer, typename AllocatorWrapper>
+ezBTreeMap<KeyType, ValueType, Comparer, AllocatorWrapper>::ezBTreeMap(const ezBTreeMap<KeyType, ValueType, Comparer, AllocatorWrapper>& other)
+  : ezBTreeMapBase<KeyType, ValueType, Comparer>(other, AllocatorWrapper::GetAllocator())
+{
+}
+
+template <typename KeyType, typename ValueType, typename Comparer, typename AllocatorWrapper>
+ezBTreeMap<KeyType, ValueType, Comparer, AllocatorWrapper>::ezBTreeMap(const ezBTreeMapBase<KeyType, ValueType, Comparer>& other)
+  : ezBTreeMapBase<KeyType, ValueType, Comparer>(other, AllocatorWrapper::GetAllocator())
+{
+}
+
+template <typename KeyType, typename ValueType, typename Comparer, typename AllocatorWrapper>
+void ezBTreeMap<KeyType, ValueType, Comparer, AllocatorWrapper>::operator=(const ezBTreeMap<KeyType, ValueType, Comparer, AllocatorWrapper>& rhs)
+{
+  ezBTreeMapBase<KeyType, ValueType, Comparer>::operator=(rhs);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer, typename AllocatorWrapper>
+void ezBTreeMap<KeyType, ValueType, Comparer, AllocatorWrapper>::operator=(const ezBTreeMapBase<KeyType, ValueType, Comparer>& rhs)
+{
+  ezBTreeMapBase<KeyType, ValueType, Comparer>::operator=(rhs);
+}
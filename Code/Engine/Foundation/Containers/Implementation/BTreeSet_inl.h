@@ -0,0 +1,200 @@
+#pragma once
+
+template <typename KeyType, typename Comparer>
+ezBTreeSetBase<KeyType, Comparer>::ezBTreeSetBase(const Comparer& comparer, ezAllocatorBase* pAllocator)
+  : MapBase(comparer, pAllocator)
+{
+}
+
+template <typename KeyType, typename Comparer>
+ezBTreeSetBase<KeyType, Comparer>::ezBTreeSetBase(const ezBTreeSetBase<KeyType, Comparer>& cc, ezAllocatorBase* pAllocator)
+  : MapBase(cc, pAllocator)
+{
+}
+
+template <typename KeyType, typename Comparer>
+void ezBTreeSetBase<KeyType, Comparer>::operator=(const ezBTreeSetBase<KeyType, Comparer>& rhs)
+{
+  MapBase::operator=(rhs);
+}
+
+template <typename KeyType, typename Comparer>
+void ezBTreeSetBase<KeyType, Comparer>::BuildFromSorted(ezArrayPtr<const KeyType> keys)
+{
+  ezUInt32 uiIndex = 0;
+  MapBase::Internal_BuildFromSorted(keys.GetCount(), [&](KeyType* pKey, ezInternal::BTreeSetEmptyValue*) {
+    ezMemoryUtils::CopyConstruct(pKey, keys[uiIndex], 1);
+    ++uiIndex;
+  });
+}
+
+template <typename KeyType, typename Comparer>
+template <typename CompatibleKeyType>
+EZ_FORCE_INLINE typename ezBTreeSetBase<KeyType, Comparer>::Iterator ezBTreeSetBase<KeyType, Comparer>::Insert(CompatibleKeyType&& key)
+{
+  return Iterator(MapBase::FindOrAdd(std::forward<CompatibleKeyType>(key)));
+}
+
+template <typename KeyType, typename Comparer>
+template <typename CompatibleKeyType>
+EZ_FORCE_INLINE bool ezBTreeSetBase<KeyType, Comparer>::Remove(const CompatibleKeyType& key)
+{
+  return MapBase::Remove(key);
+}
+
+template <typename KeyType, typename Comparer>
+typename ezBTreeSetBase<KeyType, Comparer>::Iterator ezBTreeSetBase<KeyType, Comparer>::Remove(const Iterator& pos)
+{
+  EZ_ASSERT_DEV(pos.IsValid(), "The Iterator(pos) is invalid.");
+
+  typename MapBase::Iterator it(pos.m_It.m_pLeaf, pos.m_It.m_uiIndex);
+  return Iterator(MapBase::Remove(it));
+}
+
+template <typename KeyType, typename Comparer>
+template <typename CompatibleKeyType>
+EZ_FORCE_INLINE typename ezBTreeSetBase<KeyType, Comparer>::Iterator ezBTreeSetBase<KeyType, Comparer>::Find(const CompatibleKeyType& key) const
+{
+  return Iterator(MapBase::Find(key));
+}
+
+template <typename KeyType, typename Comparer>
+template <typename CompatibleKeyType>
+EZ_FORCE_INLINE bool ezBTreeSetBase<KeyType, Comparer>::Contains(const CompatibleKeyType& key) const
+{
+  return MapBase::Contains(key);
+}
+
+template <typename KeyType, typename Comparer>
+bool ezBTreeSetBase<KeyType, Comparer>::ContainsSet(const ezBTreeSetBase<KeyType, Comparer>& operand) const
+{
+  for (const KeyType& key : operand)
+  {
+    if (!Contains(key))
+      return false;
+  }
+
+  return true;
+}
+
+template <typename KeyType, typename Comparer>
+template <typename CompatibleKeyType>
+EZ_FORCE_INLINE typename ezBTreeSetBase<KeyType, Comparer>::Iterator ezBTreeSetBase<KeyType, Comparer>::LowerBound(const CompatibleKeyType& key) const
+{
+  return Iterator(MapBase::LowerBound(key));
+}
+
+template <typename KeyType, typename Comparer>
+template <typename CompatibleKeyType>
+EZ_FORCE_INLINE typename ezBTreeSetBase<KeyType, Comparer>::Iterator ezBTreeSetBase<KeyType, Comparer>::UpperBound(const CompatibleKeyType& key) const
+{
+  return Iterator(MapBase::UpperBound(key));
+}
+
+template <typename KeyType, typename Comparer>
+void ezBTreeSetBase<KeyType, Comparer>::Union(const ezBTreeSetBase<KeyType, Comparer>& operand)
+{
+  MergeWith(operand, [](bool bInThis, bool bInOperand) { return bInThis || bInOperand; });
+}
+
+template <typename KeyType, typename Comparer>
+void ezBTreeSetBase<KeyType, Comparer>::Difference(const ezBTreeSetBase<KeyType, Comparer>& operand)
+{
+  MergeWith(operand, [](bool bInThis, bool bInOperand) { return bInThis && !bInOperand; });
+}
+
+template <typename KeyType, typename Comparer>
+void ezBTreeSetBase<KeyType, Comparer>::Intersection(const ezBTreeSetBase<KeyType, Comparer>& operand)
+{
+  MergeWith(operand, [](bool bInThis, bool bInOperand) { return bInThis && bInOperand; });
+}
+
+template <typename KeyType, typename Comparer>
+template <typename KeepFunc>
+void ezBTreeSetBase<KeyType, Comparer>::MergeWith(const ezBTreeSetBase<KeyType, Comparer>& operand, KeepFunc keepKey)
+{
+  if (this == &operand)
+  {
+    if (!keepKey(true, true))
+      Clear();
+
+    return;
+  }
+
+  ezDynamicArray<KeyType> keys(GetAllocator());
+  keys.Reserve(GetCount() + operand.GetCount());
+
+  Iterator itThis = GetIterator();
+  Iterator itOperand = operand.GetIterator();
+
+  while (itThis.IsValid() || itOperand.IsValid())
+  {
+    if (!itOperand.IsValid() || (itThis.IsValid() && this->m_Comparer.Less(itThis.Key(), itOperand.Key())))
+    {
+      if (keepKey(true, false))
+        keys.PushBack(itThis.Key());
+
+      itThis.Next();
+    }
+    else if (!itThis.IsValid() || this->m_Comparer.Less(itOperand.Key(), itThis.Key()))
+    {
+      if (keepKey(false, true))
+        keys.PushBack(itOperand.Key());
+
+      itOperand.Next();
+    }
+    else
+    {
+      if (keepKey(true, true))
+        keys.PushBack(itThis.Key());
+
+      itThis.Next();
+      itOperand.Next();
+    }
+  }
+
+  BuildFromSorted(keys);
+}
+
+
+template <typename KeyType, typename Comparer, typename AllocatorWrapper>
+ezBTreeSet<KeyType, Comparer, AllocatorWrapper>::ezBTreeSet()
+  : ezBTreeSetBase<KeyType, Comparer>(Comparer(), AllocatorWrapper::GetAllocator())
+{
+}
+
+template <typename KeyType, typename Comparer, typename AllocatorWrapper>
+ezBTreeSet<KeyType, Comparer, AllocatorWrapper>::ezBTreeSet(ezAllocatorBase* pAllocator)
+  : ezBTreeSetBase<KeyType, Comparer>(Comparer(), pAllocator)
+{
+}
+
+template <typename KeyType, typename Comparer, typename AllocatorWrapper>
+ezBTreeSet<KeyType, Comparer, AllocatorWrapper>::ezBTreeSet(const Comparer& comparer, ezAllocatorBase* pAllocator)
+  : ezBTreeSetBase<KeyType, Comparer>(comparer, pAllocator)
+{
+}
+
+template <typename KeyType, typename Comparer, typename AllocatorWrapper>
+ezBTreeSet<KeyType, Comparer, AllocatorWrapper>::ezBTreeSet(const ezBTreeSet<KeyType, Comparer, AllocatorWrapper>& other)
+  : ezBTreeSetBase<KeyType, Comparer>(other, AllocatorWrapper::GetAllocator())
+{
+}
+
+template <typename KeyType, typename Comparer, typename AllocatorWrapper>
+ezBTreeSet<KeyType, Comparer, AllocatorWrapper>::ezBTreeSet(const ezBTreeSetBase<KeyType, Comparer>& other)
+  : ezBTreeSetBase<KeyType, Comparer>(other, AllocatorWrapper::GetAllocator())
+{
+}
+
+template <typename KeyType, typename Comparer, typename AllocatorWrapper>
+void ezBTreeSet<KeyType, Comparer, AllocatorWrapper>::operator=(const ezBTreeSet<KeyType, Comparer, AllocatorWrapper>& rhs)
+{
+  ezBTreeSetBase<KeyType, Comparer>::operator=(rhs);
+}
+
+template <typename KeyType, typename Comparer, typename AllocatorWrapper>
+void ezBTreeSet<KeyType, Comparer, AllocatorWrapper>::operator=(const ezBTreeSetBase<KeyType, Comparer>& rhs)
+{
+  ezBTreeSetBase<KeyType, Comparer>::operator=(rhs);
+}
@@ -0,0 +1,848 @@
+/// \brief Value used by containers for indices to indicate an invalid index.
+#ifndef ezInvalidIndex
+#  define ezInvalidIndex 0xFFFFFFFF
+#endif
+
+// SSE2 is always available on 64 bit x86
+#if EZ_ENABLED(EZ_PLATFORM_ARCH_X86) && (EZ_ENABLED(EZ_PLATFORM_64BIT) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#  define EZ_FLATHASHTABLE_USE_SSE2 EZ_ON
+#  include <emmintrin.h>
+#else
+#  define EZ_FLATHASHTABLE_USE_SSE2 EZ_OFF
+#endif
+
+// ***** Const Iterator *****
+
+template <typename K, typename V, typename H>
+ezFlatHashTableBase<K, V, H>::ConstIterator::ConstIterator(const ezFlatHashTableBase<K, V, H>& hashTable)
+  : m_hashTable(&hashTable)
+{
+}
+
+template <typename K, typename V, typename H>
+void ezFlatHashTableBase<K, V, H>::ConstIterator::SetToBegin()
+{
+  if (m_hashTable->IsEmpty())
+  {
+    m_uiCurrentIndex = m_hashTable->m_uiCapacity;
+    return;
+  }
+
+  m_uiCurrentIndex = m_hashTable->FindNextValidEntry(0);
+}
+
+template <typename K, typename V, typename H>
+inline void ezFlatHashTableBase<K, V, H>::ConstIterator::SetToEnd()
+{
+  m_uiCurrentCount = m_hashTable->m_uiCount;
+  m_uiCurrentIndex = m_hashTable->m_uiCapacity;
+}
+
+template <typename K, typename V, typename H>
+EZ_FORCE_INLINE bool ezFlatHashTableBase<K, V, H>::ConstIterator::IsValid() const
+{
+  return m_uiCurrentCount < m_hashTable->m_uiCount;
+}
+
+template <typename K, typename V, typename H>
+EZ_FORCE_INLINE bool ezFlatHashTableBase<K, V, H>::ConstIterator::operator==(
+  const typename ezFlatHashTableBase<K, V, H>::ConstIterator& rhs) const
+{
+  return m_uiCurrentIndex == rhs.m_uiCurrentIndex && m_hashTable->m_pEntries == rhs.m_hashTable->m_pEntries;
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE bool ezFlatHashTableBase<K, V, H>::ConstIterator::operator!=(
+  const typename ezFlatHashTableBase<K, V, H>::ConstIterator& rhs) const
+{
+  return !(*this == rhs);
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE const K& ezFlatHashTableBase<K, V, H>::ConstIterator::Key() const
+{
+  return m_hashTable->m_pEntries[m_uiCurrentIndex].key;
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE const V& ezFlatHashTableBase<K, V, H>::ConstIterator::Value() const
+{
+  return m_hashTable->m_pEntries[m_uiCurrentIndex].value;
+}
+
+template <typename K, typename V, typename H>
+void ezFlatHashTableBase<K, V, H>::ConstIterator::Next()
+{
+  // if we already iterated over the amount of valid elements that the hash-table stores, early out
+  if (m_uiCurrentCount >= m_hashTable->m_uiCount)
+    return;
+
+  ++m_uiCurrentCount;
+  m_uiCurrentIndex = m_hashTable->FindNextValidEntry(m_uiCurrentIndex + 1);
+
+  // if we reached the end of all elements in the container, set the m_uiCurrentCount to maximum,
+  // to enable early-out in the future and to make 'IsValid' return 'false'
+  if (m_uiCurrentIndex >= m_hashTable->m_uiCapacity)
+  {
+    m_uiCurrentCount = m_hashTable->m_uiCount;
+  }
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE void ezFlatHashTableBase<K, V, H>::ConstIterator::operator++()
+{
+  Next();
+}
+
+
+// ***** Iterator *****
+
+template <typename K, typename V, typename H>
+ezFlatHashTableBase<K, V, H>::Iterator::Iterator(const ezFlatHashTableBase<K, V, H>& hashTable)
+  : ConstIterator(hashTable)
+{
+}
+
+template <typename K, typename V, typename H>
+ezFlatHashTableBase<K, V, H>::Iterator::Iterator(const typename ezFlatHashTableBase<K, V, H>::Iterator& rhs)
+  : ConstIterator(*rhs.m_hashTable)
+{
+  this->m_uiCurrentIndex = rhs.m_uiCurrentIndex;
+  this->m_uiCurrentCount = rhs.m_uiCurrentCount;
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE void ezFlatHashTableBase<K, V, H>::Iterator::operator=(const Iterator& rhs) // [tested]
+{
+  this->m_hashTable = rhs.m_hashTable;
+  this->m_uiCurrentIndex = rhs.m_uiCurrentIndex;
+  this->m_uiCurrentCount = rhs.m_uiCurrentCount;
+}
+
+template <typename K, typename V, typename H>
+EZ_FORCE_INLINE V& ezFlatHashTableBase<K, V, H>::Iterator::Value()
+{
+  return this->m_hashTable->m_pEntries[this->m_uiCurrentIndex].value;
+}
+
+
+// ***** ezFlatHashTableBase *****
+
+template <typename K, typename V, typename H>
+ezFlatHashTableBase<K, V, H>::ezFlatHashTableBase(ezAllocatorBase* pAllocator)
+{
+  m_pEntries = nullptr;
+  m_pControlBytes = nullptr;
+  m_uiCount = 0;
+  m_uiCapacity = 0;
+  m_uiDeletedCount = 0;
+  m_pAllocator = pAllocator;
+}
+
+template <typename K, typename V, typename H>
+ezFlatHashTableBase<K, V, H>::ezFlatHashTableBase(const ezFlatHashTableBase<K, V, H>& other, ezAllocatorBase* pAllocator)
+{
+  m_pEntries = nullptr;
+  m_pControlBytes = nullptr;
+  m_uiCount = 0;
+  m_uiCapacity = 0;
+  m_uiDeletedCount = 0;
+  m_pAllocator = pAllocator;
+
+  *this = other;
+}
+
+template <typename K, typename V, typename H>
+ezFlatHashTableBase<K, V, H>::ezFlatHashTableBase(ezFlatHashTableBase<K, V, H>&& other, ezAllocatorBase* pAllocator)
+{
+  m_pEntries = nullptr;
+  m_pControlBytes = nullptr;
+  m_uiCount = 0;
+  m_uiCapacity = 0;
+  m_uiDeletedCount = 0;
+  m_pAllocator = pAllocator;
+
+  *this = std::move(other);
+}
+
+template <typename K, typename V, typename H>
+ezFlatHashTableBase<K, V, H>::~ezFlatHashTableBase()
+{
+  Clear();
+  EZ_DELETE_RAW_BUFFER(m_pAllocator, m_pEntries);
+  if (m_pControlBytes != nullptr)
+    m_pAllocator->Deallocate(m_pControlBytes);
+  m_uiCapacity = 0;
+}
+
+template <typename K, typename V, typename H>
+void ezFlatHashTableBase<K, V, H>::operator=(const ezFlatHashTableBase<K, V, H>& rhs)
+{
+  Clear();
+  Reserve(rhs.GetCount());
+
+  for (ezUInt32 i = rhs.FindNextValidEntry(0); i < rhs.m_uiCapacity; i = rhs.FindNextValidEntry(i + 1))
+  {
+    Insert(rhs.m_pEntries[i].key, rhs.m_pEntries[i].value);
+  }
+}
+
+template <typename K, typename V, typename H>
+void ezFlatHashTableBase<K, V, H>::operator=(ezFlatHashTableBase<K, V, H>&& rhs)
+{
+  // Clear any existing data (calls destructors if necessary)
+  Clear();
+
+  if (m_pAllocator != rhs.m_pAllocator)
+  {
+    Reserve(rhs.m_uiCount);
+
+    for (ezUInt32 i = rhs.FindNextValidEntry(0); i < rhs.m_uiCapacity; i = rhs.FindNextValidEntry(i + 1))
+    {
+      Insert(std::move(rhs.m_pEntries[i].key), std::move(rhs.m_pEntries[i].value));
+    }
+
+    rhs.Clear();
+  }
+  else
+  {
+    EZ_DELETE_RAW_BUFFER(m_pAllocator, m_pEntries);
+    if (m_pControlBytes != nullptr)
+      m_pAllocator->Deallocate(m_pControlBytes);
+
+    // Move all data over.
+    m_pEntries = rhs.m_pEntries;
+    m_pControlBytes = rhs.m_pControlBytes;
+    m_uiCount = rhs.m_uiCount;
+    m_uiCapacity = rhs.m_uiCapacity;
+    m_uiDeletedCount = rhs.m_uiDeletedCount;
+
+    // Temp copy forgets all its state.
+    rhs.m_pEntries = nullptr;
+    rhs.m_pControlBytes = nullptr;
+    rhs.m_uiCount = 0;
+    rhs.m_uiCapacity = 0;
+    rhs.m_uiDeletedCount = 0;
+  }
+}
+
+template <typename K, typename V, typename H>
+bool ezFlatHashTableBase<K, V, H>::operator==(const ezFlatHashTableBase<K, V, H>& rhs) const
+{
+  if (m_uiCount != rhs.m_uiCount)
+    return false;
+
+  for (ezUInt32 i = FindNextValidEntry(0); i < m_uiCapacity; i = FindNextValidEntry(i + 1))
+  {
+    const V* pRhsValue = nullptr;
+    if (!rhs.TryGetValue(m_pEntries[i].key, pRhsValue))
+      return false;
+
+    if (m_pEntries[i].value != *pRhsValue)
+      return false;
+  }
+
+  return true;
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE bool ezFlatHashTableBase<K, V, H>::operator!=(const ezFlatHashTableBase<K, V, H>& rhs) const
+{
+  return !(*this == rhs);
+}
+
+template <typename K, typename V, typename H>
+void ezFlatHashTableBase<K, V, H>::Reserve(ezUInt32 uiCapacity)
+{
+  if (uiCapacity <= GetMaxLoad(m_uiCapacity))
+    return;
+
+  SetCapacity(GetCapacityForCount(uiCapacity));
+}
+
+template <typename K, typename V, typename H>
+void ezFlatHashTableBase<K, V, H>::Compact()
+{
+  if (IsEmpty())
+  {
+    // completely deallocate all data, if the table is empty.
+    EZ_DELETE_RAW_BUFFER(m_pAllocator, m_pEntries);
+    if (m_pControlBytes != nullptr)
+      m_pAllocator->Deallocate(m_pControlBytes);
+    m_pControlBytes = nullptr;
+    m_uiCapacity = 0;
+    m_uiDeletedCount = 0;
+  }
+  else
+  {
+    const ezUInt32 uiNewCapacity = GetCapacityForCount(m_uiCount);
+    if (m_uiCapacity != uiNewCapacity || m_uiDeletedCount > 0)
+      SetCapacity(uiNewCapacity);
+  }
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE ezUInt32 ezFlatHashTableBase<K, V, H>::GetCount() const
+{
+  return m_uiCount;
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE bool ezFlatHashTableBase<K, V, H>::IsEmpty() const
+{
+  return m_uiCount == 0;
+}
+
+template <typename K, typename V, typename H>
+void ezFlatHashTableBase<K, V, H>::Clear()
+{
+  for (ezUInt32 i = FindNextValidEntry(0); i < m_uiCapacity; i = FindNextValidEntry(i + 1))
+  {
+    ezMemoryUtils::Destruct(&m_pEntries[i].key, 1);
+    ezMemoryUtils::Destruct(&m_pEntries[i].value, 1);
+  }
+
+  if (m_pControlBytes != nullptr)
+  {
+    ezMemoryUtils::PatternFill(reinterpret_cast<ezUInt8*>(m_pControlBytes), static_cast<ezUInt8>(CONTROL_FREE), m_uiCapacity);
+  }
+
+  m_uiCount = 0;
+  m_uiDeletedCount = 0;
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType, typename CompatibleValueType>
+bool ezFlatHashTableBase<K, V, H>::Insert(CompatibleKeyType&& key, CompatibleValueType&& value, V* out_oldValue /*= nullptr*/)
+{
+  const ezUInt32 uiHash = MixHash(H::Hash(key));
+
+  ezUInt32 uiIndex = FindEntry(uiHash, key);
+  if (uiIndex != ezInvalidIndex)
+  {
+    if (out_oldValue != nullptr)
+      *out_oldValue = std::move(m_pEntries[uiIndex].value);
+
+    m_pEntries[uiIndex].value = std::forward<CompatibleValueType>(value); // Either move or copy assignment.
+    return true;
+  }
+
+  uiIndex = PrepareInsert(uiHash);
+
+  // Both constructions might either be a move or a copy.
+  ezMemoryUtils::CopyOrMoveConstruct(&m_pEntries[uiIndex].key, std::forward<CompatibleKeyType>(key));
+  ezMemoryUtils::CopyOrMoveConstruct(&m_pEntries[uiIndex].value, std::forward<CompatibleValueType>(value));
+  ++m_uiCount;
+
+  return false;
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+bool ezFlatHashTableBase<K, V, H>::Remove(const CompatibleKeyType& key, V* out_oldValue /*= nullptr*/)
+{
+  ezUInt32 uiIndex = FindEntry(key);
+  if (uiIndex != ezInvalidIndex)
+  {
+    if (out_oldValue != nullptr)
+      *out_oldValue = std::move(m_pEntries[uiIndex].value);
+
+    RemoveInternal(uiIndex);
+    return true;
+  }
+
+  return false;
+}
+
+template <typename K, typename V, typename H>
+typename ezFlatHashTableBase<K, V, H>::Iterator ezFlatHashTableBase<K, V, H>::Remove(const typename ezFlatHashTableBase<K, V, H>::Iterator& pos)
+{
+  Iterator it = pos;
+  ezUInt32 uiIndex = pos.m_uiCurrentIndex;
+  ++it;
+  --it.m_uiCurrentCount;
+  RemoveInternal(uiIndex);
+  return it;
+}
+
+template <typename K, typename V, typename H>
+void ezFlatHashTableBase<K, V, H>::RemoveInternal(ezUInt32 uiIndex)
+{
+  ezMemoryUtils::Destruct(&m_pEntries[uiIndex].key, 1);
+  ezMemoryUtils::Destruct(&m_pEntries[uiIndex].value, 1);
+
+  // Lookups stop at the first group that contains a free entry. If the group of this entry already contains a free entry,
+  // no lookup ever continued past this group and the entry can be marked as free right away.
+  const ezUInt32 uiGroupStart = uiIndex & ~(GROUP_SIZE - 1);
+  if (MatchFree(m_pControlBytes + uiGroupStart) != 0)
+  {
+    m_pControlBytes[uiIndex] = CONTROL_FREE;
+  }
+  else
+  {
+    m_pControlBytes[uiIndex] = CONTROL_DELETED;
+    ++m_uiDeletedCount;
+  }
+
+  --m_uiCount;
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+inline bool ezFlatHashTableBase<K, V, H>::TryGetValue(const CompatibleKeyType& key, V& out_value) const
+{
+  ezUInt32 uiIndex = FindEntry(key);
+  if (uiIndex != ezInvalidIndex)
+  {
+    out_value = m_pEntries[uiIndex].value;
+    return true;
+  }
+
+  return false;
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+inline bool ezFlatHashTableBase<K, V, H>::TryGetValue(const CompatibleKeyType& key, const V*& out_pValue) const
+{
+  ezUInt32 uiIndex = FindEntry(key);
+  if (uiIndex != ezInvalidIndex)
+  {
+    out_pValue = &m_pEntries[uiIndex].value;
+    return true;
+  }
+
+  return false;
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+inline bool ezFlatHashTableBase<K, V, H>::TryGetValue(const CompatibleKeyType& key, V*& out_pValue) const
+{
+  ezUInt32 uiIndex = FindEntry(key);
+  if (uiIndex != ezInvalidIndex)
+  {
+    out_pValue = &m_pEntries[uiIndex].value;
+    return true;
+  }
+
+  return false;
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+inline typename ezFlatHashTableBase<K, V, H>::ConstIterator ezFlatHashTableBase<K, V, H>::Find(const CompatibleKeyType& key) const
+{
+  ezUInt32 uiIndex = FindEntry(key);
+  if (uiIndex == ezInvalidIndex)
+  {
+    return GetEndIterator();
+  }
+
+  ConstIterator it(*this);
+  it.m_uiCurrentIndex = uiIndex;
+  it.m_uiCurrentCount = 0; // we do not know the 'count' (which is used as an optimization), so we just use 0
+
+  return it;
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+inline typename ezFlatHashTableBase<K, V, H>::Iterator ezFlatHashTableBase<K, V, H>::Find(const CompatibleKeyType& key)
+{
+  ezUInt32 uiIndex = FindEntry(key);
+  if (uiIndex == ezInvalidIndex)
+  {
+    return GetEndIterator();
+  }
+
+  Iterator it(*this);
+  it.m_uiCurrentIndex = uiIndex;
+  it.m_uiCurrentCount = 0; // we do not know the 'count' (which is used as an optimization), so we just use 0
+  return it;
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+inline const V* ezFlatHashTableBase<K, V, H>::GetValue(const CompatibleKeyType& key) const
+{
+  ezUInt32 uiIndex = FindEntry(key);
+  return (uiIndex != ezInvalidIndex) ? &m_pEntries[uiIndex].value : nullptr;
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+inline V* ezFlatHashTableBase<K, V, H>::GetValue(const CompatibleKeyType& key)
+{
+  ezUInt32 uiIndex = FindEntry(key);
+  return (uiIndex != ezInvalidIndex) ? &m_pEntries[uiIndex].value : nullptr;
+}
+
+template <typename K, typename V, typename H>
+inline V& ezFlatHashTableBase<K, V, H>::operator[](const K& key)
+{
+  const ezUInt32 uiHash = MixHash(H::Hash(key));
+  ezUInt32 uiIndex = FindEntry(uiHash, key);
+
+  if (uiIndex == ezInvalidIndex)
+  {
+    uiIndex = PrepareInsert(uiHash);
+
+    // new entry
+    ezMemoryUtils::CopyConstruct(&m_pEntries[uiIndex].key, key, 1);
+    ezMemoryUtils::DefaultConstruct(&m_pEntries[uiIndex].value, 1);
+    ++m_uiCount;
+  }
+  return m_pEntries[uiIndex].value;
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+EZ_FORCE_INLINE bool ezFlatHashTableBase<K, V, H>::Contains(const CompatibleKeyType& key) const
+{
+  return FindEntry(key) != ezInvalidIndex;
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE typename ezFlatHashTableBase<K, V, H>::Iterator ezFlatHashTableBase<K, V, H>::GetIterator()
+{
+  Iterator iterator(*this);
+  iterator.SetToBegin();
+  return iterator;
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE typename ezFlatHashTableBase<K, V, H>::Iterator ezFlatHashTableBase<K, V, H>::GetEndIterator()
+{
+  Iterator iterator(*this);
+  iterator.SetToEnd();
+  return iterator;
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE typename ezFlatHashTableBase<K, V, H>::ConstIterator ezFlatHashTableBase<K, V, H>::GetIterator() const
+{
+  ConstIterator iterator(*this);
+  iterator.SetToBegin();
+  return iterator;
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE typename ezFlatHashTableBase<K, V, H>::ConstIterator ezFlatHashTableBase<K, V, H>::GetEndIterator() const
+{
+  ConstIterator iterator(*this);
+  iterator.SetToEnd();
+  return iterator;
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE ezAllocatorBase* ezFlatHashTableBase<K, V, H>::GetAllocator() const
+{
+  return m_pAllocator;
+}
+
+template <typename K, typename V, typename H>
+ezUInt64 ezFlatHashTableBase<K, V, H>::GetHeapMemoryUsage() const
+{
+  return (ezUInt64)m_uiCapacity * (sizeof(Entry) + sizeof(ezInt8));
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+void ezFlatHashTableBase<KeyType, ValueType, Hasher>::Swap(ezFlatHashTableBase<KeyType, ValueType, Hasher>& other)
+{
+  ezMath::Swap(this->m_pEntries, other.m_pEntries);
+  ezMath::Swap(this->m_pControlBytes, other.m_pControlBytes);
+  ezMath::Swap(this->m_uiCount, other.m_uiCount);
+  ezMath::Swap(this->m_uiCapacity, other.m_uiCapacity);
+  ezMath::Swap(this->m_uiDeletedCount, other.m_uiDeletedCount);
+  ezMath::Swap(this->m_pAllocator, other.m_pAllocator);
+}
+
+// private methods
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE ezUInt32 ezFlatHashTableBase<K, V, H>::MixHash(ezUInt32 uiHash)
+{
+  // Murmur3 finalizer. Many hash helpers are a plain multiplication, which leaves the lower bits (used for the group index) badly distributed
+  // and the upper bits (used for the control bytes) correlated with them.
+  uiHash ^= uiHash >> 16;
+  uiHash *= 0x85ebca6bu;
+  uiHash ^= uiHash >> 13;
+  uiHash *= 0xc2b2ae35u;
+  uiHash ^= uiHash >> 16;
+  return uiHash;
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE ezUInt32 ezFlatHashTableBase<K, V, H>::GetMaxLoad(ezUInt32 uiCapacity)
+{
+  return uiCapacity - uiCapacity / 8;
+}
+
+template <typename K, typename V, typename H>
+ezUInt32 ezFlatHashTableBase<K, V, H>::GetCapacityForCount(ezUInt32 uiCount)
+{
+  EZ_ASSERT_DEBUG(uiCount <= GetMaxLoad(0x80000000u), "ezFlatHashTable does not support more than 1.8 billion entries.");
+
+  ezUInt32 uiCapacity = ezMath::Max<ezUInt32>(ezMath::PowerOfTwo_Ceil(uiCount), GROUP_SIZE);
+  if (GetMaxLoad(uiCapacity) < uiCount)
+    uiCapacity *= 2;
+
+  return uiCapacity;
+}
+
+template <typename K, typename V, typename H>
+EZ_FORCE_INLINE ezUInt32 ezFlatHashTableBase<K, V, H>::MatchControlByte(const ezInt8* pGroup, ezInt8 iControlByte)
+{
+#if EZ_ENABLED(EZ_FLATHASHTABLE_USE_SSE2)
+  const __m128i group = _mm_load_si128(reinterpret_cast<const __m128i*>(pGroup));
+  return static_cast<ezUInt32>(_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(iControlByte))));
+#else
+  ezUInt32 uiMask = 0;
+  for (ezUInt32 i = 0; i < GROUP_SIZE; ++i)
+  {
+    uiMask |= static_cast<ezUInt32>(pGroup[i] == iControlByte) << i;
+  }
+  return uiMask;
+#endif
+}
+
+template <typename K, typename V, typename H>
+EZ_FORCE_INLINE ezUInt32 ezFlatHashTableBase<K, V, H>::MatchFree(const ezInt8* pGroup)
+{
+  return MatchControlByte(pGroup, static_cast<ezInt8>(CONTROL_FREE));
+}
+
+template <typename K, typename V, typename H>
+EZ_FORCE_INLINE ezUInt32 ezFlatHashTableBase<K, V, H>::MatchFreeOrDeleted(const ezInt8* pGroup)
+{
+#if EZ_ENABLED(EZ_FLATHASHTABLE_USE_SSE2)
+  // free and deleted are the only negative values below -1
+  const __m128i group = _mm_load_si128(reinterpret_cast<const __m128i*>(pGroup));
+  return static_cast<ezUInt32>(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(-1), group)));
+#else
+  ezUInt32 uiMask = 0;
+  for (ezUInt32 i = 0; i < GROUP_SIZE; ++i)
+  {
+    uiMask |= static_cast<ezUInt32>(pGroup[i] < -1) << i;
+  }
+  return uiMask;
+#endif
+}
+
+template <typename K, typename V, typename H>
+EZ_FORCE_INLINE ezUInt32 ezFlatHashTableBase<K, V, H>::MatchValid(const ezInt8* pGroup)
+{
+#if EZ_ENABLED(EZ_FLATHASHTABLE_USE_SSE2)
+  // valid entries are the ones without the sign bit
+  const __m128i group = _mm_load_si128(reinterpret_cast<const __m128i*>(pGroup));
+  return static_cast<ezUInt32>(_mm_movemask_epi8(group)) ^ 0xFFFFu;
+#else
+  ezUInt32 uiMask = 0;
+  for (ezUInt32 i = 0; i < GROUP_SIZE; ++i)
+  {
+    uiMask |= static_cast<ezUInt32>(pGroup[i] >= 0) << i;
+  }
+  return uiMask;
+#endif
+}
+
+template <typename K, typename V, typename H>
+void ezFlatHashTableBase<K, V, H>::SetCapacity(ezUInt32 uiCapacity)
+{
+  EZ_ASSERT_DEV(ezMath::IsPowerOf2(uiCapacity) && uiCapacity >= GROUP_SIZE, "uiCapacity must be a power of two and at least the group size.");
+  const ezUInt32 uiOldCapacity = m_uiCapacity;
+
+  Entry* pOldEntries = m_pEntries;
+  ezInt8* pOldControlBytes = m_pControlBytes;
+
+  m_uiCapacity = uiCapacity;
+  m_uiDeletedCount = 0;
+  m_pEntries = EZ_NEW_RAW_BUFFER(m_pAllocator, Entry, m_uiCapacity);
+  m_pControlBytes = static_cast<ezInt8*>(m_pAllocator->Allocate(m_uiCapacity, GROUP_SIZE));
+  ezMemoryUtils::PatternFill(reinterpret_cast<ezUInt8*>(m_pControlBytes), static_cast<ezUInt8>(CONTROL_FREE), m_uiCapacity);
+
+  for (ezUInt32 i = 0; i < uiOldCapacity; ++i)
+  {
+    if (pOldControlBytes[i] >= 0)
+    {
+      const ezUInt32 uiHash = MixHash(H::Hash(pOldEntries[i].key));
+      const ezUInt32 uiIndex = FindInsertIndex(uiHash);
+      m_pControlBytes[uiIndex] = static_cast<ezInt8>(uiHash >> 25);
+
+      ezMemoryUtils::CopyOrMoveConstruct(&m_pEntries[uiIndex].key, std::move(pOldEntries[i].key));
+      ezMemoryUtils::CopyOrMoveConstruct(&m_pEntries[uiIndex].value, std::move(pOldEntries[i].value));
+
+      ezMemoryUtils::Destruct(&pOldEntries[i].key, 1);
+      ezMemoryUtils::Destruct(&pOldEntries[i].value, 1);
+    }
+  }
+
+  EZ_DELETE_RAW_BUFFER(m_pAllocator, pOldEntries);
+  if (pOldControlBytes != nullptr)
+    m_pAllocator->Deallocate(pOldControlBytes);
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+EZ_ALWAYS_INLINE ezUInt32 ezFlatHashTableBase<K, V, H>::FindEntry(const CompatibleKeyType& key) const
+{
+  return FindEntry(MixHash(H::Hash(key)), key);
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+inline ezUInt32 ezFlatHashTableBase<K, V, H>::FindEntry(ezUInt32 uiHash, const CompatibleKeyType& key) const
+{
+  if (m_uiCapacity == 0)
+    return ezInvalidIndex;
+
+  // the lower bits select the first group to look at, the upper 7 bits are stored in the control byte
+  const ezInt8 iControlByte = static_cast<ezInt8>(uiHash >> 25);
+  const ezUInt32 uiGroupMask = m_uiCapacity / GROUP_SIZE - 1;
+  ezUInt32 uiGroup = uiHash & uiGroupMask;
+
+  // triangular probing visits every group exactly once
+  for (ezUInt32 uiStep = 1; uiStep <= uiGroupMask + 1; ++uiStep)
+  {
+    const ezUInt32 uiGroupStart = uiGroup * GROUP_SIZE;
+    const ezInt8* pGroup = m_pControlBytes + uiGroupStart;
+
+    for (ezUInt32 uiMatches = MatchControlByte(pGroup, iControlByte); uiMatches != 0; uiMatches &= uiMatches - 1)
+    {
+      const ezUInt32 uiIndex = uiGroupStart + ezMath::FirstBitLow(uiMatches);
+      if (H::Equal(m_pEntries[uiIndex].key, key))
+        return uiIndex;
+    }
+
+    if (MatchFree(pGroup) != 0)
+      break;
+
+    uiGroup = (uiGroup + uiStep) & uiGroupMask;
+  }
+
+  // not found
+  return ezInvalidIndex;
+}
+
+template <typename K, typename V, typename H>
+ezUInt32 ezFlatHashTableBase<K, V, H>::PrepareInsert(ezUInt32 uiHash)
+{
+  if (m_uiCount + m_uiDeletedCount + 1 > GetMaxLoad(m_uiCapacity))
+  {
+    // if a good part of the load are deleted entries, just clean those up instead of growing
+    if ((ezUInt64)(m_uiCount + 1) * 32 <= (ezUInt64)m_uiCapacity * 25)
+      SetCapacity(m_uiCapacity);
+    else
+      SetCapacity(ezMath::Max(GetCapacityForCount(m_uiCount + 1), m_uiCapacity * 2));
+  }
+
+  const ezUInt32 uiIndex = FindInsertIndex(uiHash);
+
+  if (m_pControlBytes[uiIndex] == CONTROL_DELETED)
+    --m_uiDeletedCount;
+
+  m_pControlBytes[uiIndex] = static_cast<ezInt8>(uiHash >> 25);
+  return uiIndex;
+}
+
+template <typename K, typename V, typename H>
+ezUInt32 ezFlatHashTableBase<K, V, H>::FindInsertIndex(ezUInt32 uiHash) const
+{
+  const ezUInt32 uiGroupMask = m_uiCapacity / GROUP_SIZE - 1;
+  ezUInt32 uiGroup = uiHash & uiGroupMask;
+
+  for (ezUInt32 uiStep = 1;; ++uiStep)
+  {
+    const ezUInt32 uiMatches = MatchFreeOrDeleted(m_pControlBytes + uiGroup * GROUP_SIZE);
+    if (uiMatches != 0)
+      return uiGroup * GROUP_SIZE + ezMath::FirstBitLow(uiMatches);
+
+    EZ_ASSERT_DEBUG(uiStep <= uiGroupMask + 1, "Implementation error, the table is full");
+    uiGroup = (uiGroup + uiStep) & uiGroupMask;
+  }
+}
+
+template <typename K, typename V, typename H>
+ezUInt32 ezFlatHashTableBase<K, V, H>::FindNextValidEntry(ezUInt32 uiEntryIndex) const
+{
+  while (uiEntryIndex < m_uiCapacity)
+  {
+    const ezUInt32 uiGroupStart = uiEntryIndex & ~(GROUP_SIZE - 1);
+    const ezUInt32 uiMatches = MatchValid(m_pControlBytes + uiGroupStart) & ~((1u << (uiEntryIndex - uiGroupStart)) - 1);
+
+    if (uiMatches != 0)
+      return uiGroupStart + ezMath::FirstBitLow(uiMatches);
+
+    uiEntryIndex = uiGroupStart + GROUP_SIZE;
+  }
+
+  return m_uiCapacity;
+}
+
+template <typename K, typename V, typename H>
+EZ_FORCE_INLINE bool ezFlatHashTableBase<K, V, H>::IsValidEntry(ezUInt32 uiEntryIndex) const
+{
+  return m_pControlBytes[uiEntryIndex] >= 0;
+}
+
+
+template <typename K, typename V, typename H, typename A>
+ezFlatHashTable<K, V, H, A>::ezFlatHashTable()
+  : ezFlatHashTableBase<K, V, H>(A::GetAllocator())
+{
+}
+
+template <typename K, typename V, typename H, typename A>
+ezFlatHashTable<K, V, H, A>::ezFlatHashTable(ezAllocatorBase* pAllocator)
+  : ezFlatHashTableBase<K, V, H>(pAllocator)
+{
+}
+
+template <typename K, typename V, typename H, typename A>
+ezFlatHashTable<K, V, H, A>::ezFlatHashTable(const ezFlatHashTable<K, V, H, A>& other)
+  : ezFlatHashTableBase<K, V, H>(other, A::GetAllocator())
+{
+}
+
+template <typename K, typename V, typename H, typename A>
+ezFlatHashTable<K, V, H, A>::ezFlatHashTable(const ezFlatHashTableBase<K, V, H>& other)
+  : ezFlatHashTableBase<K, V, H>(other, A::GetAllocator())
+{
+}
+
+template <typename K, typename V, typename H, typename A>
+ezFlatHashTable<K, V, H, A>::ezFlatHashTable(ezFlatHashTable<K, V, H, A>&& other)
+  : ezFlatHashTableBase<K, V, H>(std::move(other), other.GetAllocator())
+{
+}
+
+template <typename K, typename V, typename H, typename A>
+ezFlatHashTable<K, V, H, A>::ezFlatHashTable(ezFlatHashTableBase<K, V, H>&& other)
+  : ezFlatHashTableBase<K, V, H>(std::move(other), other.GetAllocator())
+{
+}
+
+template <typename K, typename V, typename H, typename A>
+void ezFlatHashTable<K, V, H, A>::operator=(const ezFlatHashTable<K, V, H, A>& rhs)
+{
+  ezFlatHashTableBase<K, V, H>::operator=(rhs);
+}
+
+template <typename K, typename V, typename H, typename A>
+void ezFlatHashTable<K, V, H, A>::operator=(const ezFlatHashTableBase<K, V, H>& rhs)
+{
+  ezFlatHashTableBase<K, V, H>::operator=(rhs);
+}
+
+template <typename K, typename V, typename H, typename A>
+void ezFlatHashTable<K, V, H, A>::operator=(ezFlatHashTable<K, V, H, A>&& rhs)
+{
+  ezFlatHashTableBase<K, V, H>::operator=(std::move(rhs));
+}
+
+template <typename K, typename V, typename H, typename A>
+void ezFlatHashTable<K, V, H, A>::operator=(ezFlatHashTableBase<K, V, H>&& rhs)
+{
+  ezFlatHashTableBase<K, V, H>::operator=(std::move(rhs));
+}
@@ -72,10 +72,7 @@ private:
   T* GetStaticArray();
 
   /// \brief The fixed size array.
-  struct : ezAligned<EZ_ALIGNMENT_OF(T)>
-  {
-    ezUInt8 m_Data[Capacity * sizeof(T)];
-  };
+  alignas(EZ_ALIGNMENT_OF(T)) ezUInt8 m_Data[Capacity * sizeof(T)];
 
   T* m_pElements;
   ezUInt32 m_uiCount;
@@ -91,6 +91,8 @@ EZ_STATICLINK_LIBRARY(Foundation)
   EZ_STATICLINK_REFERENCE(Foundation_IO_Implementation_StreamOperations);
   EZ_STATICLINK_REFERENCE(Foundation_IO_Implementation_StreamOperationsOther);
   EZ_STATICLINK_REFERENCE(Foundation_IO_Implementation_StringDeduplicationContext);
+  EZ_STATICLINK_REFERENCE(Foundation_Logging_Implementation_AsyncLog);
+  EZ_STATICLINK_REFERENCE(Foundation_Logging_Implementation_BinaryWriter);
   EZ_STATICLINK_REFERENCE(Foundation_Logging_Implementation_ConsoleWriter);
   EZ_STATICLINK_REFERENCE(Foundation_Logging_Implementation_ETWWriter);
   EZ_STATICLINK_REFERENCE(Foundation_Logging_Implementation_HTMLWriter);
@@ -111,7 +113,10 @@ EZ_STATICLINK_LIBRARY(Foundation)
   EZ_STATICLINK_REFERENCE(Foundation_Memory_Implementation_MemoryTracker);
   EZ_STATICLINK_REFERENCE(Foundation_Memory_Implementation_MemoryUtils);
   EZ_STATICLINK_REFERENCE(Foundation_Memory_Implementation_PageAllocator);
+  EZ_STATICLINK_REFERENCE(Foundation_Memory_Implementation_SampledHeapProfile);
   EZ_STATICLINK_REFERENCE(Foundation_Memory_Policies_GuardedAllocation);
+  EZ_STATICLINK_REFERENCE(Foundation_Memory_Policies_ThreadArenaAllocation);
+  EZ_STATICLINK_REFERENCE(Foundation_Memory_Policies_ThreadCachingAllocation);
   EZ_STATICLINK_REFERENCE(Foundation_Profiling_Implementation_Profiling);
   EZ_STATICLINK_REFERENCE(Foundation_Reflection_Implementation_PropertyAttributes);
   EZ_STATICLINK_REFERENCE(Foundation_Reflection_Implementation_PropertyPath);
@@ -180,5 +185,6 @@ EZ_STATICLINK_LIBRARY(Foundation)
   EZ_STATICLINK_REFERENCE(Foundation_Utilities_Implementation_EnvironmentVariableUtils);
   EZ_STATICLINK_REFERENCE(Foundation_Utilities_Implementation_GraphicsUtils);
   EZ_STATICLINK_REFERENCE(Foundation_Utilities_Implementation_Progress);
+  EZ_STATICLINK_REFERENCE(Foundation_Utilities_Implementation_StatMetrics);
   EZ_STATICLINK_REFERENCE(Foundation_Utilities_Implementation_Stats);
 }
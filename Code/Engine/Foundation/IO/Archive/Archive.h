@@ -12,6 +12,7 @@ enum class ezArchiveCompressionMode : ezUInt8
   Uncompressed,
   Compressed_zstd,
   Compressed_zip,
+  Compressed_zstd_chunked, ///< Independently zstd compressed chunks plus a seek table, for random access into large entries.
 };
 
 /// \brief Data for a single file entry in an ezArchive file
@@ -23,6 +24,7 @@ public:
   ezUInt64 m_uiStoredDataSize = 0;       ///< The amount of (compressed) bytes actually stored in the ezArchive.
   ezUInt32 m_uiPathStringOffset = 0;     ///< Byte offset into ezArchiveTOC::m_AllPathStrings where the path string for this entry resides.
   ezArchiveCompressionMode m_CompressionMode = ezArchiveCompressionMode::Uncompressed;
+  ezUInt32 m_uiDictionaryIndex = ezInvalidIndex; ///< Index into ezArchiveTOC::m_Dictionaries, if the data was compressed with a dictionary.
 
   ezResult Serialize(ezStreamWriter& stream) const;
   ezResult Deserialize(ezStreamReader& stream);
@@ -106,6 +108,8 @@ public:
   ezHashTable<ezArchiveStoredString, ezUInt32> m_PathToEntryIndex;
   /// one large array holding all path strings for the file entries, to reduce allocations
   ezDynamicArray<ezUInt8> m_AllPathStrings;
+  /// zstd dictionaries that entries may reference through ezArchiveEntry::m_uiDictionaryIndex
+  ezDynamicArray<ezDynamicArray<ezUInt8>> m_Dictionaries;
 
   /// \brief Returns the entry index for the given file or ezInvalidIndex, if not found.
   ezUInt32 FindEntry(const char* szFile) const;
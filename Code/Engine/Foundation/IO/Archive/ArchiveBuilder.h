@@ -3,6 +3,7 @@
 #include <Foundation/IO/Archive/Archive.h>
 
 #include <Foundation/Containers/Deque.h>
+#include <Foundation/Time/Time.h>
 #include <Foundation/Types/Delegate.h>
 
 /// \brief Utility class to build an ezArchive file from files/folders on disk
@@ -21,6 +22,45 @@ public:
   // all the source files from disk that should be put into the ezArchive
   ezDeque<SourceEntry> m_Entries;
 
+  /// \brief Upper limit for the size of the source files that are compressed concurrently by WriteArchive().
+  ///
+  /// Every entry that is in flight is held in memory until it has been appended to the output. At least one entry is always in flight,
+  /// independent of its size.
+  ezUInt64 m_uiMaxInFlightBytes = 512 * 1024 * 1024;
+
+  /// \brief If enabled, WriteArchive() trains a zstd dictionary for the small zstd-compressed entries of each file extension.
+  ///
+  /// Every entry is compressed on its own, so small files compress poorly. With a dictionary that was trained on files of the same type,
+  /// the common parts don't need to be stored in every entry. Extensions with only a few small files don't get a dictionary.
+  /// Archives with dictionaries can't be read by versions of ezArchiveReader that don't support them.
+  bool m_bTrainDictionaries = false;
+
+  /// \brief Upper limit for the size of each trained dictionary. All dictionaries are kept in memory while the archive is open.
+  ezUInt32 m_uiMaxDictionarySize = 64 * 1024;
+
+  /// \brief If enabled, entries with identical content are only stored once and share their data range in the archive.
+  bool m_bDeduplicateContent = true;
+
+  /// \brief zstd-compressed entries of at least this size are stored with ezArchiveCompressionMode::Compressed_zstd_chunked.
+  ///
+  /// Chunked entries compress slightly worse, but they can be read at any offset without decompressing everything before it, and
+  /// ezArchiveReader::ReadEntryRange() decompresses their chunks in parallel. Set to ezMath::MaxValue<ezUInt64>() to disable this.
+  ezUInt64 m_uiChunkedCompressionThreshold = 4 * 1024 * 1024;
+
+  /// \brief Information about the last call to WriteArchive()
+  struct WriteStats
+  {
+    ezUInt32 m_uiNumEntries = 0;
+    ezUInt64 m_uiUncompressedBytes = 0;      ///< Sum of the sizes of all source files
+    ezUInt64 m_uiStoredBytes = 0;            ///< Sum of the sizes of all data ranges stored in the archive, excluding the TOC
+    ezUInt32 m_uiNumDeduplicatedEntries = 0; ///< Number of entries that share the data of an earlier entry
+    ezUInt64 m_uiDeduplicatedBytes = 0;      ///< Sum of the stored sizes of the deduplicated entries, ie. the bytes that were saved
+    ezUInt32 m_uiNumDictionaries = 0;
+    ezUInt32 m_uiNumDictionaryEntries = 0; ///< Number of entries that are compressed with a dictionary
+    ezUInt64 m_uiDictionaryBytes = 0;      ///< Sum of the sizes of all dictionaries stored in the TOC
+    ezTime m_Duration;                     ///< Time spent in WriteArchive()
+  };
+
   enum class InclusionMode
   {
     Exclude,       ///< Do not add this file to the archive
@@ -40,14 +80,19 @@ public:
     InclusionCallback callback = InclusionCallback());
 
   /// \brief Overwrites the given file with the archive
-  ezResult WriteArchive(const char* szFile) const;
+  ezResult WriteArchive(const char* szFile, WriteStats* out_pStats = nullptr) const;
 
   /// \brief Writes the previously gathered files to the file stream
-  ezResult WriteArchive(ezStreamWriter& stream) const;
+  ///
+  /// The entries are read and compressed on the ezTaskSystem in parallel, see m_uiMaxInFlightBytes.
+  /// They are appended to the stream in the order of m_Entries, so the output does not depend on the scheduling.
+  /// Dictionaries are trained before that, see m_bTrainDictionaries.
+  ezResult WriteArchive(ezStreamWriter& stream, WriteStats* out_pStats = nullptr) const;
 
 protected:
-  /// Override this to get a callback when the next file is being written to the output
+  /// Override this to get a callback when the next file is being written to the output. Always called on the thread that calls WriteArchive().
   virtual bool WriteNextFileCallback(ezUInt32 uiCurEntry, ezUInt32 uiMaxEntries, const char* szSourceFile) const;
-  /// Override this to get a progress report for writing a single file to the output
+  /// Override this to get a progress report for writing a single file to the output. Always called on the thread that calls WriteArchive(),
+  /// while the entry is read and compressed and once more after it has been appended.
   virtual bool WriteFileProgressCallback(ezUInt64 bytesWritten, ezUInt64 bytesTotal) const;
 };
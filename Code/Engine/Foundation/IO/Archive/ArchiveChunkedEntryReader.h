@@ -0,0 +1,75 @@
+#pragma once
+
+#include <Foundation/Containers/Bitfield.h>
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/IO/CompressedStreamZstd.h>
+#include <Foundation/IO/MemoryStream.h>
+
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+
+/// \brief Reads the data of an archive entry that was stored with ezArchiveCompressionMode::Compressed_zstd_chunked.
+///
+/// Such an entry is split into chunks of a fixed uncompressed size, which are compressed independently of each other, followed by a
+/// seek table with the stored size of every chunk. Reading sequentially only decompresses one chunk at a time. SetReadPosition() and
+/// SkipBytes() jump directly to the chunk that contains the target position, so reading the end of a large entry does not require
+/// decompressing everything before it. ReadRange() decompresses all chunks of a range in parallel.
+///
+/// See ezArchiveUtils::WriteEntry() for the layout of the stored data.
+class EZ_FOUNDATION_DLL ezArchiveChunkedEntryReader : public ezStreamReader
+{
+  EZ_DISALLOW_COPY_AND_ASSIGN(ezArchiveChunkedEntryReader);
+
+public:
+  ezArchiveChunkedEntryReader();
+  ~ezArchiveChunkedEntryReader();
+
+  /// \brief Sets up the reader for the stored data of an entry and resets the read position. Fails if the seek table is invalid.
+  ///
+  /// The stored data is not copied, it has to stay available while the reader is in use.
+  ezResult Configure(const void* pStoredData, ezUInt64 uiStoredDataSize, ezUInt64 uiUncompressedDataSize); // [tested]
+
+  /// \brief Reads the next bytes, decompressing chunks on demand.
+  virtual ezUInt64 ReadBytes(void* pReadBuffer, ezUInt64 uiBytesToRead) override; // [tested]
+
+  /// \brief Advances the read position without decompressing the chunks that are skipped over.
+  virtual ezUInt64 SkipBytes(ezUInt64 uiBytesToSkip) override; // [tested]
+
+  /// \brief Moves the read position to the given offset in the uncompressed data. Only the chunk that contains it is decompressed.
+  void SetReadPosition(ezUInt64 uiPosition); // [tested]
+
+  /// \brief Returns the current read position in the uncompressed data.
+  ezUInt64 GetReadPosition() const { return m_uiReadPosition; } // [tested]
+
+  /// \brief Decompresses up to uiBytes of the uncompressed data, starting at uiOffset, into pBuffer. Returns the number of bytes read.
+  ///
+  /// This does not depend on or modify the read position. If bParallel is true, the chunks that overlap the range are decompressed
+  /// on the ezTaskSystem in parallel.
+  ezUInt64 ReadRange(ezUInt64 uiOffset, void* pBuffer, ezUInt64 uiBytes, bool bParallel = true) const; // [tested]
+
+  /// \brief Returns the size of the uncompressed data.
+  ezUInt64 GetUncompressedSize() const { return m_uiUncompressedSize; }
+
+  /// \brief Returns the uncompressed size of the chunks. Only the last chunk may be smaller.
+  ezUInt32 GetChunkSize() const { return m_uiChunkSize; }
+
+  /// \brief Returns the number of chunks.
+  ezUInt32 GetNumChunks() const { return m_ChunkOffsets.GetCount() - 1; }
+
+private:
+  ezUInt32 GetChunkUncompressedSize(ezUInt32 uiChunk) const;
+  ezResult DecompressChunk(ezUInt32 uiChunk, ezUInt8* pTarget, ezCompressedStreamReaderZstd& decompressor) const;
+
+  const ezUInt8* m_pStoredData = nullptr;
+  ezUInt64 m_uiUncompressedSize = 0;
+  ezUInt32 m_uiChunkSize = 0;
+
+  ezDynamicArray<ezUInt64> m_ChunkOffsets; ///< Offset of every chunk in the stored data, plus the end of the last chunk
+  ezDynamicBitfield m_ChunkIsUncompressed;  ///< Chunks that could not be compressed are stored as they are
+
+  ezUInt64 m_uiReadPosition = 0;
+  ezUInt32 m_uiCurrentChunk = ezInvalidIndex;
+  ezDynamicArray<ezUInt8> m_CurrentChunkData;
+  ezCompressedStreamReaderZstd m_Decompressor;
+};
+
+#endif // BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
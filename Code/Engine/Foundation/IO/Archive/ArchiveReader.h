@@ -2,21 +2,45 @@
 
 #include <Foundation/IO/Archive/Archive.h>
 #include <Foundation/IO/MemoryMappedFile.h>
+#include <Foundation/Time/Time.h>
 #include <Foundation/Types/UniquePtr.h>
 
 class ezRawMemoryStreamReader;
 class ezStreamReader;
+class ezCompressedStreamZstdDictionary;
+class ezArchiveChunkedEntryReader;
 
 /// \brief A utility class for reading from ezArchive files
 class EZ_FOUNDATION_DLL ezArchiveReader
 {
 public:
+  ezArchiveReader();
+  ~ezArchiveReader();
+
+  /// \brief Information about the archive that was opened with OpenArchive()
+  struct Stats
+  {
+    ezUInt32 m_uiNumEntries = 0;
+    ezUInt32 m_uiNumDataRanges = 0;     ///< Number of distinct data ranges, entries with identical content share one
+    ezUInt64 m_uiUncompressedBytes = 0; ///< Sum of the uncompressed sizes of all entries
+    ezUInt64 m_uiStoredBytes = 0;       ///< Sum of the sizes of all distinct data ranges
+    ezUInt32 m_uiNumDictionaries = 0;
+    ezUInt64 m_uiDictionaryBytes = 0; ///< Sum of the sizes of all dictionaries
+    ezTime m_LoadTime;                ///< Time spent in OpenArchive(), including reading the TOC and preparing the dictionaries
+  };
+
   /// \brief Opens the given file and validates that it is a valid archive file.
   ezResult OpenArchive(const char* szPath);
 
   /// \brief Returns the table-of-contents for the previously opened archive.
   const ezArchiveTOC& GetArchiveTOC();
 
+  /// \brief Returns information about the previously opened archive.
+  const Stats& GetStats() const { return m_Stats; }
+
+  /// \brief Returns the dictionary that is needed to decompress the given entry, or nullptr, if it doesn't use one.
+  const ezCompressedStreamZstdDictionary* GetEntryDictionary(ezUInt32 uiEntryIdx) const;
+
   /// \brief Extracts the given entry to the target folder.
   ///
   /// Calls ExtractFileProgressCallback() to report progress.
@@ -27,12 +51,32 @@ public:
   /// Calls ExtractNextFileCallback() for every file that is being extracted.
   ezResult ExtractAllFiles(const char* szTargetFolder) const;
 
+  /// \brief Returns the raw (potentially compressed) data that is stored for the given entry, inside the memory mapped archive file.
+  ///
+  /// The data is m_uiStoredDataSize bytes large and stays valid as long as the archive is open.
+  const void* GetEntryStoredData(ezUInt32 uiEntryIdx) const;
+
+  /// \brief Hints the OS to read the stored data of the given entry from disk in the background. Does not block.
+  void PrefetchEntry(ezUInt32 uiEntryIdx) const;
+
   /// \brief Sets up \a memReader for reading the raw (potentially compressed) data that is stored for the given entry in the archive.
   void ConfigureRawMemoryStreamReader(ezUInt32 uiEntryIdx, ezRawMemoryStreamReader& memReader) const;
 
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+  /// \brief Sets up \a reader for an entry that was stored with ezArchiveCompressionMode::Compressed_zstd_chunked.
+  ezResult ConfigureChunkedEntryReader(ezUInt32 uiEntryIdx, ezArchiveChunkedEntryReader& reader) const;
+#endif
+
   /// \brief Creates a reader that will decompress the given file entry.
   ezUniquePtr<ezStreamReader> CreateEntryReader(ezUInt32 uiEntryIdx) const;
 
+  /// \brief Reads up to uiBytes of the uncompressed data of the given entry, starting at uiOffset. Returns the number of bytes read.
+  ///
+  /// For uncompressed entries this is a plain copy. Entries with ezArchiveCompressionMode::Compressed_zstd_chunked only decompress the
+  /// chunks that overlap the range, in parallel. Other compressed entries have to be decompressed from the start up to the end of the range.
+  /// This function is thread-safe.
+  ezUInt64 ReadEntryRange(ezUInt32 uiEntryIdx, ezUInt64 uiOffset, void* pBuffer, ezUInt64 uiBytes) const;
+
 protected:
   /// \brief Called by ExtractAllFiles() for progress reporting. Return false to abort.
   virtual bool ExtractNextFileCallback(ezUInt32 uiCurEntry, ezUInt32 uiMaxEntries, const char* szSourceFile) const;
@@ -45,4 +89,8 @@ protected:
   ezUInt8 m_uiArchiveVersion = 0;
   const void* m_pDataStart = nullptr;
   ezUInt64 m_uiMemFileSize = 0;
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+  ezDynamicArray<ezUniquePtr<ezCompressedStreamZstdDictionary>> m_Dictionaries;
+#endif
+  Stats m_Stats;
 };
@@ -10,12 +10,16 @@ class ezMemoryMappedFile;
 class ezArchiveTOC;
 class ezArchiveEntry;
 class ezRawMemoryStreamReader;
+class ezCompressedStreamZstdDictionary;
 
 /// \brief Utilities for working with ezArchive files
 namespace ezArchiveUtils
 {
   typedef ezDelegate<bool(ezUInt64, ezUInt64)> FileWriteProgressCallback;
 
+  /// \brief The uncompressed size of the chunks that ezArchiveCompressionMode::Compressed_zstd_chunked splits an entry into.
+  constexpr ezUInt32 ChunkedCompressionChunkSize = 256 * 1024;
+
   /// \brief Returns a modifiable array of file extensions that the engine considers to be valid ezArchive file extensions.
   ///
   /// By default it always contains 'ezArchive'.
@@ -41,15 +45,31 @@ namespace ezArchiveUtils
   ///
   /// Appends information to the TOC for finding the data in the stream. Reads and updates inout_uiCurrentStreamPosition with the data byte
   /// offset. The progress callback is executed for every couple of KB of data that were written.
+  /// If a dictionary is given, zstd compression uses it. The caller has to store the dictionary index in the TOC entry, if the entry
+  /// actually ended up compressed with zstd.
+  ///
+  /// With ezArchiveCompressionMode::Compressed_zstd_chunked, the file is split into chunks of ChunkedCompressionChunkSize bytes, each
+  /// written as a separate zstd stream. The chunks are followed by a seek table with one ezUInt32 per chunk, holding the stored size of
+  /// the chunk, with the highest bit set for chunks that are stored uncompressed, because compression didn't make them smaller.
+  /// The entry ends with the chunk size and the number of chunks, both as ezUInt32. Dictionaries are not used for chunked entries.
   EZ_FOUNDATION_DLL ezResult WriteEntry(ezStreamWriter& stream, const char* szAbsSourcePath, ezUInt32 uiPathStringOffset,
     ezArchiveCompressionMode compression, ezArchiveEntry& tocEntry, ezUInt64& inout_uiCurrentStreamPosition,
-    FileWriteProgressCallback progress = FileWriteProgressCallback());
+    FileWriteProgressCallback progress = FileWriteProgressCallback(), const ezCompressedStreamZstdDictionary* pDictionary = nullptr);
 
   /// \brief Similar to WriteEntry, but if compression is enabled, checks that compression makes enough of a difference.
   /// If compression does not reduce file size enough, the file is stored uncompressed instead.
   EZ_FOUNDATION_DLL ezResult WriteEntryOptimal(ezStreamWriter& stream, const char* szAbsSourcePath, ezUInt32 uiPathStringOffset,
     ezArchiveCompressionMode compression, ezArchiveEntry& tocEntry, ezUInt64& inout_uiCurrentStreamPosition,
-    FileWriteProgressCallback progress = FileWriteProgressCallback());
+    FileWriteProgressCallback progress = FileWriteProgressCallback(), const ezCompressedStreamZstdDictionary* pDictionary = nullptr);
+
+  /// \brief Builds a zstd dictionary of at most uiMaxDictionarySize bytes from the given samples.
+  ///
+  /// The dictionary is raw content: it consists of the segments of the samples that contain the most byte sequences which are shared
+  /// with other samples. The most valuable segments are placed at the end, where zstd can reference them most cheaply.
+  /// The samples should be representative for the data that is compressed with the dictionary later, e.g. files of the same type.
+  /// If all samples together are smaller than uiMaxDictionarySize, they are used as they are.
+  EZ_FOUNDATION_DLL void TrainDictionary(
+    ezArrayPtr<const ezArrayPtr<const ezUInt8>> samples, ezUInt32 uiMaxDictionarySize, ezDynamicArray<ezUInt8>& out_Dictionary);
 
   /// \brief Configures \a memReader as a view into the data stored for \a entry in the archive file.
   ///
@@ -60,7 +80,9 @@ namespace ezArchiveUtils
   /// \brief Creates a new stream reader which allows to read the uncompressed data for the given archive entry.
   ///
   /// Under the hood it may create different types of stream readers to uncompress or decode the data.
-  EZ_FOUNDATION_DLL ezUniquePtr<ezStreamReader> CreateEntryReader(const ezArchiveEntry& entry, const void* pStartOfArchiveData);
+  /// If the entry references a dictionary, \a pDictionary must be that dictionary, initialized for decompression.
+  EZ_FOUNDATION_DLL ezUniquePtr<ezStreamReader> CreateEntryReader(
+    const ezArchiveEntry& entry, const void* pStartOfArchiveData, const ezCompressedStreamZstdDictionary* pDictionary = nullptr);
 
   EZ_FOUNDATION_DLL ezResult ReadZipHeader(ezStreamReader& stream, ezUInt8& out_uiVersion);
   EZ_FOUNDATION_DLL ezResult ExtractZipTOC(ezMemoryMappedFile& memFile, ezArchiveTOC& toc);
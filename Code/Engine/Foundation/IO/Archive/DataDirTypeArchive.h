@@ -1,5 +1,6 @@
 #pragma once
 
+#include <Foundation/IO/Archive/ArchiveChunkedEntryReader.h>
 #include <Foundation/IO/Archive/ArchiveReader.h>
 #include <Foundation/IO/CompressedStreamZlib.h>
 #include <Foundation/IO/CompressedStreamZstd.h>
@@ -14,6 +15,7 @@ namespace ezDataDirectory
 {
   class ArchiveReaderUncompressed;
   class ArchiveReaderZstd;
+  class ArchiveReaderZstdChunked;
   class ArchiveReaderZip;
 
   class EZ_FOUNDATION_DLL ArchiveType : public ezDataDirectoryType
@@ -35,6 +37,8 @@ namespace ezDataDirectory
 
     virtual ezResult GetFileStats(const char* szFileOrFolder, bool bOneSpecificDataDir, ezFileStats& out_Stats) override;
 
+    virtual bool PrefetchFile(const char* szFile, bool bOneSpecificDataDir) override;
+
     virtual ezResult InternalInitializeDataDirectory(const char* szDirectory) override;
 
     virtual void OnReaderWriterClose(ezDataDirectoryReaderWriterBase* pClosed) override;
@@ -51,6 +55,8 @@ namespace ezDataDirectory
 #ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
     ezHybridArray<ezUniquePtr<ArchiveReaderZstd>, 4> m_ReadersZstd;
     ezHybridArray<ArchiveReaderZstd*, 4> m_FreeReadersZstd;
+    ezHybridArray<ezUniquePtr<ArchiveReaderZstdChunked>, 4> m_ReadersZstdChunked;
+    ezHybridArray<ArchiveReaderZstdChunked*, 4> m_FreeReadersZstdChunked;
 #endif
 #ifdef BUILDSYSTEM_ENABLE_ZLIB_SUPPORT
     ezHybridArray<ezUniquePtr<ArchiveReaderZip>, 4> m_ReadersZip;
@@ -68,6 +74,7 @@ namespace ezDataDirectory
 
     virtual ezUInt64 Read(void* pBuffer, ezUInt64 uiBytes) override;
     virtual ezUInt64 GetFileSize() const override;
+    virtual ezArrayPtr<const ezUInt8> GetMappedData() const override;
 
   protected:
     virtual ezResult InternalOpen(ezFileShareMode::Enum FileShareMode) override;
@@ -77,6 +84,7 @@ namespace ezDataDirectory
 
     ezUInt64 m_uiUncompressedSize = 0;
     ezUInt64 m_uiCompressedSize = 0;
+    const void* m_pStoredData = nullptr;
     ezRawMemoryStreamReader m_MemStreamReader;
   };
 
@@ -97,6 +105,25 @@ namespace ezDataDirectory
     friend class ArchiveType;
 
     ezCompressedStreamReaderZstd m_CompressedStreamReader;
+    const ezCompressedStreamZstdDictionary* m_pDictionary = nullptr;
+  };
+
+  class EZ_FOUNDATION_DLL ArchiveReaderZstdChunked : public ArchiveReaderUncompressed
+  {
+    EZ_DISALLOW_COPY_AND_ASSIGN(ArchiveReaderZstdChunked);
+
+  public:
+    ArchiveReaderZstdChunked(ezInt32 iDataDirUserData);
+    ~ArchiveReaderZstdChunked();
+
+    virtual ezUInt64 Read(void* pBuffer, ezUInt64 uiBytes) override;
+
+  protected:
+    virtual ezResult InternalOpen(ezFileShareMode::Enum FileShareMode) override;
+
+    friend class ArchiveType;
+
+    ezArchiveChunkedEntryReader m_ChunkedReader;
   };
 #endif
 
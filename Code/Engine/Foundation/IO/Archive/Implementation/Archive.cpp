@@ -38,7 +38,7 @@ const char* ezArchiveTOC::GetEntryPathString(ezUInt32 uiEntryIdx) const
 
 ezResult ezArchiveTOC::Serialize(ezStreamWriter& stream) const
 {
-  stream.WriteVersion(2);
+  stream.WriteVersion(3);
 
   EZ_SUCCEED_OR_RETURN(stream.WriteArray(m_Entries));
 
@@ -47,12 +47,24 @@ ezResult ezArchiveTOC::Serialize(ezStreamWriter& stream) const
 
   EZ_SUCCEED_OR_RETURN(stream.WriteArray(m_AllPathStrings));
 
+  // version 3 added the dictionaries
+  stream << m_Dictionaries.GetCount();
+  for (const auto& dictionary : m_Dictionaries)
+  {
+    EZ_SUCCEED_OR_RETURN(stream.WriteArray(dictionary));
+  }
+
+  for (const auto& entry : m_Entries)
+  {
+    stream << entry.m_uiDictionaryIndex;
+  }
+
   return EZ_SUCCESS;
 }
 
 ezResult ezArchiveTOC::Deserialize(ezStreamReader& stream)
 {
-  ezTypeVersion version = stream.ReadVersion(2);
+  ezTypeVersion version = stream.ReadVersion(3);
 
   EZ_SUCCEED_OR_RETURN(stream.ReadArray(m_Entries));
 
@@ -71,6 +83,29 @@ ezResult ezArchiveTOC::Deserialize(ezStreamReader& stream)
 
   EZ_SUCCEED_OR_RETURN(stream.ReadArray(m_AllPathStrings));
 
+  if (version >= 3)
+  {
+    ezUInt32 uiNumDictionaries = 0;
+    stream >> uiNumDictionaries;
+
+    m_Dictionaries.SetCount(uiNumDictionaries);
+    for (auto& dictionary : m_Dictionaries)
+    {
+      EZ_SUCCEED_OR_RETURN(stream.ReadArray(dictionary));
+    }
+
+    for (auto& entry : m_Entries)
+    {
+      stream >> entry.m_uiDictionaryIndex;
+
+      if (entry.m_uiDictionaryIndex != ezInvalidIndex && entry.m_uiDictionaryIndex >= uiNumDictionaries)
+      {
+        ezLog::Error("Archive is corrupt. Invalid entry dictionary index.");
+        return EZ_FAILURE;
+      }
+    }
+  }
+
   if (version == 1 || version == 2)
   {
     // version 1 stores an older way for the path/hash -> entry lookup table, which is prone to hash collisions
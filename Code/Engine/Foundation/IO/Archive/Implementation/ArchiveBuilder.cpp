@@ -2,9 +2,200 @@
 
 #include <Foundation/IO/Archive/ArchiveBuilder.h>
 #include <Foundation/IO/Archive/ArchiveUtils.h>
+#include <Foundation/IO/CompressedStreamZstd.h>
+#include <Foundation/IO/FileSystem/FileReader.h>
 #include <Foundation/IO/FileSystem/FileWriter.h>
+#include <Foundation/IO/MemoryStream.h>
 #include <Foundation/IO/OSFile.h>
 #include <Foundation/Logging/Log.h>
+#include <Foundation/Threading/TaskSystem.h>
+#include <Foundation/Threading/ThreadSignal.h>
+
+namespace
+{
+  /// Reads and compresses one entry into memory, the result is appended to the archive by WriteArchive()
+  class ezArchiveEntryWriteTask final : public ezTask
+  {
+  public:
+    ezArchiveEntryWriteTask() { ConfigureTask("Write Archive Entry", ezTaskNesting::Never); }
+
+    virtual void Execute() override
+    {
+      ezMemoryStreamWriter writer(&m_Storage);
+      ezUInt64 uiStreamPos = 0;
+
+      m_Result = ezArchiveUtils::WriteEntryOptimal(writer, m_pEntry->m_sAbsSourcePath, 0, m_CompressionMode, m_TocEntry,
+        uiStreamPos, ezMakeDelegate(&ezArchiveEntryWriteTask::Progress, this), m_pDictionary);
+
+      m_iFinished.Set(1);
+      m_ProgressSignal.RaiseSignal();
+    }
+
+    /// Stores the progress for WriteArchive(), which passes it on to WriteFileProgressCallback() on its own thread
+    bool Progress(ezUInt64 uiBytesWritten, ezUInt64 uiBytesTotal)
+    {
+      m_iBytesTotal.Set(static_cast<ezInt64>(uiBytesTotal));
+      m_iBytesWritten.Set(static_cast<ezInt64>(uiBytesWritten));
+      m_ProgressSignal.RaiseSignal();
+
+      return *m_pCancel == 0;
+    }
+
+    void ResetProgress()
+    {
+      m_iBytesWritten.Set(0);
+      m_iBytesTotal.Set(0);
+      m_iFinished.Set(0);
+    }
+
+    const ezArchiveBuilder::SourceEntry* m_pEntry = nullptr;
+    ezArchiveCompressionMode m_CompressionMode = ezArchiveCompressionMode::Uncompressed;
+    const ezAtomicInteger32* m_pCancel = nullptr;
+    const ezCompressedStreamZstdDictionary* m_pDictionary = nullptr;
+
+    ezMemoryStreamStorage m_Storage;
+    ezArchiveEntry m_TocEntry;
+    ezResult m_Result = EZ_FAILURE;
+
+    ezAtomicInteger64 m_iBytesWritten;
+    ezAtomicInteger64 m_iBytesTotal;
+    ezAtomicInteger32 m_iFinished;
+    ezThreadSignal m_ProgressSignal;
+  };
+
+  struct PendingEntry
+  {
+    ezSharedPtr<ezArchiveEntryWriteTask> m_pTask;
+    ezTaskGroupID m_TaskGroup;
+    ezUInt64 m_uiSourceSize = 0;
+  };
+
+  /// Writes the stored data of the given entry into memory again and compares it against storedData.
+  bool IsStoredDataEqual(const char* szAbsSourcePath, ezArchiveCompressionMode compression, const ezCompressedStreamZstdDictionary* pDictionary,
+    const ezMemoryStreamStorage& storedData)
+  {
+    ezMemoryStreamStorage existingData;
+    ezMemoryStreamWriter writer(&existingData);
+    ezArchiveEntry tocEntry;
+    ezUInt64 uiStreamPos = 0;
+
+    if (ezArchiveUtils::WriteEntryOptimal(writer, szAbsSourcePath, 0, compression, tocEntry, uiStreamPos, {}, pDictionary).Failed())
+      return false;
+
+    return existingData.GetStorageSize() == storedData.GetStorageSize() &&
+           ezMemoryUtils::IsEqual(existingData.GetData(), storedData.GetData(), static_cast<size_t>(storedData.GetStorageSize()));
+  }
+
+  ezUInt64 GetSourceFileSize(const char* szAbsSourcePath)
+  {
+#if EZ_ENABLED(EZ_SUPPORTS_FILE_STATS)
+    ezFileStats stats;
+    if (ezOSFile::GetFileStats(szAbsSourcePath, stats).Succeeded())
+    {
+      return stats.m_uiFileSize;
+    }
+#endif
+
+    return 0;
+  }
+
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+
+  // larger files have enough history of their own, a dictionary doesn't help them much
+  constexpr ezUInt64 s_uiMaxDictionaryEntrySize = 128 * 1024;
+  constexpr ezUInt32 s_uiMinDictionaryGroupSize = 8;
+  constexpr ezUInt32 s_uiMaxDictionarySampleSize = 16 * 1024;
+
+  struct DictionaryGroup
+  {
+    ezDynamicArray<ezUInt32> m_Entries;
+    ezDynamicArray<ezUInt8> m_Dictionary;
+  };
+
+  /// Trains one dictionary per file extension and returns for each entry the index of the dictionary in toc.m_Dictionaries, if any
+  void TrainArchiveDictionaries(const ezDeque<ezArchiveBuilder::SourceEntry>& entries, ezUInt32 uiMaxDictionarySize, ezArchiveTOC& toc,
+    ezDynamicArray<ezUInt32>& out_EntryDictionary)
+  {
+    out_EntryDictionary.SetCount(entries.GetCount(), ezInvalidIndex);
+
+    ezMap<ezString, DictionaryGroup> groupsByExtension;
+    ezStringBuilder sExtension;
+
+    for (ezUInt32 i = 0; i < entries.GetCount(); ++i)
+    {
+      const ezArchiveBuilder::SourceEntry& e = entries[i];
+
+      if (e.m_CompressionMode != ezArchiveCompressionMode::Compressed_zstd)
+        continue;
+
+      const ezUInt64 uiSourceSize = GetSourceFileSize(e.m_sAbsSourcePath);
+      if (uiSourceSize == 0 || uiSourceSize > s_uiMaxDictionaryEntrySize)
+        continue;
+
+      sExtension = ezPathUtils::GetFileExtension(e.m_sAbsSourcePath);
+      sExtension.ToLower();
+
+      groupsByExtension[sExtension].m_Entries.PushBack(i);
+    }
+
+    ezDynamicArray<DictionaryGroup*> groups;
+    for (auto it : groupsByExtension)
+    {
+      if (it.Value().m_Entries.GetCount() >= s_uiMinDictionaryGroupSize)
+      {
+        groups.PushBack(&it.Value());
+      }
+    }
+
+    ezTaskSystem::ParallelForSingle(
+      groups.GetArrayPtr(),
+      [&](DictionaryGroup* pGroup) {
+        // about 100 times the dictionary size is a good amount of sample data, spread the samples evenly over the group
+        const ezUInt64 uiMaxSampleBytes = 100ull * uiMaxDictionarySize;
+        const ezUInt32 uiNumSamples =
+          ezMath::Min(pGroup->m_Entries.GetCount(), static_cast<ezUInt32>(uiMaxSampleBytes / s_uiMaxDictionarySampleSize));
+
+        ezDynamicArray<ezDynamicArray<ezUInt8>> sampleData;
+        sampleData.SetCount(uiNumSamples);
+
+        ezDynamicArray<ezArrayPtr<const ezUInt8>> samples;
+        samples.Reserve(uiNumSamples);
+
+        for (ezUInt32 s = 0; s < uiNumSamples; ++s)
+        {
+          const ezUInt32 uiEntryIdx = pGroup->m_Entries[static_cast<ezUInt32>((ezUInt64)s * pGroup->m_Entries.GetCount() / uiNumSamples)];
+
+          ezFileReader file;
+          if (file.Open(entries[uiEntryIdx].m_sAbsSourcePath).Failed())
+            continue;
+
+          ezDynamicArray<ezUInt8>& data = sampleData[s];
+          data.SetCountUninitialized(s_uiMaxDictionarySampleSize);
+          data.SetCountUninitialized(static_cast<ezUInt32>(file.ReadBytes(data.GetData(), s_uiMaxDictionarySampleSize)));
+
+          samples.PushBack(data);
+        }
+
+        ezArchiveUtils::TrainDictionary(samples, uiMaxDictionarySize, pGroup->m_Dictionary);
+      },
+      "Train Archive Dictionary");
+
+    for (DictionaryGroup* pGroup : groups)
+    {
+      if (pGroup->m_Dictionary.IsEmpty())
+        continue;
+
+      for (ezUInt32 uiEntryIdx : pGroup->m_Entries)
+      {
+        out_EntryDictionary[uiEntryIdx] = toc.m_Dictionaries.GetCount();
+      }
+
+      toc.m_Dictionaries.PushBack(std::move(pGroup->m_Dictionary));
+    }
+  }
+
+#endif
+} // namespace
 
 void ezArchiveBuilder::AddFolder(const char* szAbsFolderPath, ezArchiveCompressionMode defaultMode /*= ezArchiveCompressionMode::Uncompressed*/,
   InclusionCallback callback /*= InclusionCallback()*/)
@@ -61,7 +252,7 @@ void ezArchiveBuilder::AddFolder(const char* szAbsFolderPath, ezArchiveCompressi
 #endif
 }
 
-ezResult ezArchiveBuilder::WriteArchive(const char* szFile) const
+ezResult ezArchiveBuilder::WriteArchive(const char* szFile, WriteStats* out_pStats /*= nullptr*/) const
 {
   EZ_LOG_BLOCK("WriteArchive", szFile);
 
@@ -72,11 +263,13 @@ ezResult ezArchiveBuilder::WriteArchive(const char* szFile) const
     return EZ_FAILURE;
   }
 
-  return WriteArchive(file);
+  return WriteArchive(file, out_pStats);
 }
 
-ezResult ezArchiveBuilder::WriteArchive(ezStreamWriter& stream) const
+ezResult ezArchiveBuilder::WriteArchive(ezStreamWriter& stream, WriteStats* out_pStats /*= nullptr*/) const
 {
+  const ezTime tStart = ezTime::Now();
+
   EZ_SUCCEED_OR_RETURN(ezArchiveUtils::WriteHeader(stream));
 
   ezArchiveTOC toc;
@@ -84,10 +277,154 @@ ezResult ezArchiveBuilder::WriteArchive(ezStreamWriter& stream) const
   ezStringBuilder sHashablePath;
 
   ezUInt64 uiStreamSize = 0;
+  ezUInt64 uiUncompressedSize = 0;
   const ezUInt32 uiNumEntries = m_Entries.GetCount();
 
+  // for each entry the index of its dictionary in toc.m_Dictionaries, empty if no dictionaries are used
+  ezDynamicArray<ezUInt32> entryDictionary;
+
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+  ezDynamicArray<ezUniquePtr<ezCompressedStreamZstdDictionary>> dictionaries;
+
+  if (m_bTrainDictionaries)
+  {
+    TrainArchiveDictionaries(m_Entries, m_uiMaxDictionarySize, toc, entryDictionary);
+
+    for (const auto& dictionaryData : toc.m_Dictionaries)
+    {
+      auto& pDictionary = dictionaries.ExpandAndGetRef();
+      pDictionary = EZ_DEFAULT_NEW(ezCompressedStreamZstdDictionary);
+
+      if (pDictionary->InitializeForCompression(dictionaryData).Failed())
+      {
+        ezLog::Error("Failed to prepare a zstd dictionary of size {}", ezArgFileSize(dictionaryData.GetCount()));
+        return EZ_FAILURE;
+      }
+    }
+  }
+#endif
+
+  auto GetEntryDictionaryIndex = [&](ezUInt32 uiEntryIdx) -> ezUInt32 {
+    return entryDictionary.IsEmpty() ? ezInvalidIndex : entryDictionary[uiEntryIdx];
+  };
+
+  auto GetDictionary = [&](ezUInt32 uiDictionaryIdx) -> const ezCompressedStreamZstdDictionary* {
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+    if (uiDictionaryIdx != ezInvalidIndex)
+      return dictionaries[uiDictionaryIdx].Borrow();
+#endif
+    return nullptr;
+  };
+
+  auto GetCompressionMode = [&](const SourceEntry& e, ezUInt64 uiSourceSize) -> ezArchiveCompressionMode {
+    if (e.m_CompressionMode == ezArchiveCompressionMode::Compressed_zstd && uiSourceSize >= m_uiChunkedCompressionThreshold)
+      return ezArchiveCompressionMode::Compressed_zstd_chunked;
+
+    return e.m_CompressionMode;
+  };
+
+  // maps the hash of the stored data to the first TOC entry that uses it
+  ezHashTable<ezUInt64, ezUInt32> storedDataToEntry;
+  ezUInt32 uiNumDeduplicatedEntries = 0;
+  ezUInt64 uiDeduplicatedBytes = 0;
+  ezUInt32 uiNumDictionaryEntries = 0;
+
+  // two tasks per thread, so that a thread never waits for the writer to pick up its result
+  const ezUInt32 uiMaxPendingEntries = ezMath::Max(2u, 2 * ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::LongTasks));
+
+  ezAtomicInteger32 iCancel;
+  ezDeque<PendingEntry> pendingEntries;
+  ezDynamicArray<ezSharedPtr<ezArchiveEntryWriteTask>> unusedTasks;
+  ezUInt32 uiNextEntryToSchedule = 0;
+  ezUInt64 uiPendingBytes = 0;
+
+  auto ScheduleEntries = [&]() {
+    while (uiNextEntryToSchedule < uiNumEntries && pendingEntries.GetCount() < uiMaxPendingEntries)
+    {
+      const SourceEntry& e = m_Entries[uiNextEntryToSchedule];
+
+      const ezUInt64 uiSourceSize = GetSourceFileSize(e.m_sAbsSourcePath);
+
+      // entries that don't fit into memory at all are written directly, when it is their turn
+      if (uiSourceSize > m_uiMaxInFlightBytes)
+      {
+        pendingEntries.ExpandAndGetRef().m_uiSourceSize = uiSourceSize;
+        ++uiNextEntryToSchedule;
+        continue;
+      }
+
+      if (uiPendingBytes + uiSourceSize > m_uiMaxInFlightBytes && uiPendingBytes > 0)
+        break;
+
+      PendingEntry& pending = pendingEntries.ExpandAndGetRef();
+
+      if (unusedTasks.IsEmpty())
+      {
+        pending.m_pTask = EZ_DEFAULT_NEW(ezArchiveEntryWriteTask);
+      }
+      else
+      {
+        pending.m_pTask = unusedTasks.PeekBack();
+        unusedTasks.PopBack();
+      }
+
+      pending.m_pTask->m_pEntry = &e;
+      pending.m_pTask->m_CompressionMode = GetCompressionMode(e, uiSourceSize);
+      pending.m_pTask->m_pCancel = &iCancel;
+      pending.m_pTask->m_pDictionary = pending.m_pTask->m_CompressionMode == ezArchiveCompressionMode::Compressed_zstd
+                                         ? GetDictionary(GetEntryDictionaryIndex(uiNextEntryToSchedule))
+                                         : nullptr;
+      pending.m_pTask->ResetProgress();
+      pending.m_uiSourceSize = uiSourceSize;
+      pending.m_TaskGroup = ezTaskSystem::StartSingleTask(pending.m_pTask, ezTaskPriority::LongRunning);
+
+      uiPendingBytes += uiSourceSize;
+      ++uiNextEntryToSchedule;
+    }
+  };
+
+  // the tasks reference the entries and the cancel flag, they must be finished before returning
+  auto CancelPendingEntries = [&]() {
+    iCancel.Set(1);
+
+    for (auto& pending : pendingEntries)
+    {
+      if (pending.m_pTask != nullptr)
+      {
+        ezTaskSystem::WaitForGroup(pending.m_TaskGroup);
+      }
+    }
+
+    pendingEntries.Clear();
+  };
+
+  // passes the progress of the task on to WriteFileProgressCallback() while the entry is being written, returns false when it cancels
+  auto WaitForTask = [&](ezArchiveEntryWriteTask& task) -> bool {
+    ezInt64 iReportedBytes = 0;
+
+    // the final progress is reported once the entry has been appended
+    while (task.m_iFinished == 0)
+    {
+      const ezInt64 iBytesWritten = task.m_iBytesWritten;
+
+      if (iBytesWritten != iReportedBytes)
+      {
+        iReportedBytes = iBytesWritten;
+
+        if (!WriteFileProgressCallback(static_cast<ezUInt64>(iBytesWritten), static_cast<ezUInt64>(task.m_iBytesTotal)))
+          return false;
+      }
+
+      task.m_ProgressSignal.WaitForSignal();
+    }
+
+    return true;
+  };
+
   for (ezUInt32 i = 0; i < uiNumEntries; ++i)
   {
+    ScheduleEntries();
+
     const SourceEntry& e = m_Entries[i];
 
     const ezUInt32 uiPathStringOffset = toc.m_AllPathStrings.GetCount();
@@ -101,14 +438,163 @@ ezResult ezArchiveBuilder::WriteArchive(ezStreamWriter& stream) const
       toc.m_Entries.GetCount();
 
     if (!WriteNextFileCallback(i + 1, uiNumEntries, e.m_sAbsSourcePath))
+    {
+      CancelPendingEntries();
+      return EZ_FAILURE;
+    }
+
+    PendingEntry& pending = pendingEntries.PeekFront();
+
+    const ezArchiveCompressionMode compression = GetCompressionMode(e, pending.m_uiSourceSize);
+
+    // chunked entries are never compressed with a dictionary
+    const ezUInt32 uiDictionaryIdx = compression == ezArchiveCompressionMode::Compressed_zstd ? GetEntryDictionaryIndex(i) : ezInvalidIndex;
+    const ezCompressedStreamZstdDictionary* pDictionary = GetDictionary(uiDictionaryIdx);
+
+    if (pending.m_pTask == nullptr)
+    {
+      pendingEntries.PopFront();
+
+      // too large to be held in memory, so it is not deduplicated either
+      ezArchiveEntry& tocEntry = toc.m_Entries.ExpandAndGetRef();
+      if (ezArchiveUtils::WriteEntryOptimal(stream, e.m_sAbsSourcePath, uiPathStringOffset, compression, tocEntry, uiStreamSize,
+            ezMakeDelegate(&ezArchiveBuilder::WriteFileProgressCallback, this), pDictionary)
+            .Failed())
+      {
+        CancelPendingEntries();
+        return EZ_FAILURE;
+      }
+
+      if (pDictionary != nullptr && tocEntry.m_CompressionMode == ezArchiveCompressionMode::Compressed_zstd)
+      {
+        tocEntry.m_uiDictionaryIndex = uiDictionaryIdx;
+        ++uiNumDictionaryEntries;
+      }
+
+      uiUncompressedSize += tocEntry.m_uiUncompressedDataSize;
+      continue;
+    }
+
+    ezArchiveEntryWriteTask& task = *pending.m_pTask;
+
+    if (!WaitForTask(task))
+    {
+      CancelPendingEntries();
+      return EZ_FAILURE;
+    }
+
+    ezTaskSystem::WaitForGroup(pending.m_TaskGroup);
+
+    if (task.m_Result.Failed())
+    {
+      ezLog::Error("Failed to write archive entry for '{}'", e.m_sAbsSourcePath);
+      CancelPendingEntries();
       return EZ_FAILURE;
+    }
+
+    const ezUInt32 uiTocEntryIdx = toc.m_Entries.GetCount();
+    ezArchiveEntry& tocEntry = toc.m_Entries.ExpandAndGetRef();
+    tocEntry = task.m_TocEntry;
+    tocEntry.m_uiPathStringOffset = uiPathStringOffset;
+    tocEntry.m_uiDataStartOffset = uiStreamSize;
+
+    if (pDictionary != nullptr && tocEntry.m_CompressionMode == ezArchiveCompressionMode::Compressed_zstd)
+    {
+      tocEntry.m_uiDictionaryIndex = uiDictionaryIdx;
+      ++uiNumDictionaryEntries;
+    }
+
+    bool bDeduplicated = false;
+
+    if (m_bDeduplicateContent)
+    {
+      // compression is deterministic, so identical content results in identical stored data, as long as the same dictionary is used
+      const ezUInt64 uiStoredDataHash = ezHashingUtils::xxHash64(
+        task.m_Storage.GetData(), static_cast<size_t>(task.m_Storage.GetStorageSize()), tocEntry.m_uiDictionaryIndex);
+
+      ezUInt32 uiExistingEntryIdx = 0;
+      if (storedDataToEntry.TryGetValue(uiStoredDataHash, uiExistingEntryIdx))
+      {
+        const ezArchiveEntry& existing = toc.m_Entries[uiExistingEntryIdx];
+
+        bool bIsEqual = existing.m_uiStoredDataSize == tocEntry.m_uiStoredDataSize &&
+                        existing.m_uiUncompressedDataSize == tocEntry.m_uiUncompressedDataSize &&
+                        existing.m_CompressionMode == tocEntry.m_CompressionMode && existing.m_uiDictionaryIndex == tocEntry.m_uiDictionaryIndex;
+
+        if (bIsEqual)
+        {
+          // the stored data of the existing entry has already been written out, so it is produced again to rule out hash collisions
+          const SourceEntry& existingSource = m_Entries[uiExistingEntryIdx];
+          const ezArchiveCompressionMode existingCompression = GetCompressionMode(existingSource, existing.m_uiUncompressedDataSize);
+          const ezCompressedStreamZstdDictionary* pExistingDictionary =
+            existingCompression == ezArchiveCompressionMode::Compressed_zstd ? GetDictionary(GetEntryDictionaryIndex(uiExistingEntryIdx)) : nullptr;
+
+          bIsEqual = IsStoredDataEqual(existingSource.m_sAbsSourcePath, existingCompression, pExistingDictionary, task.m_Storage);
+        }
+
+        if (bIsEqual)
+        {
+          tocEntry.m_uiDataStartOffset = existing.m_uiDataStartOffset;
+          bDeduplicated = true;
 
-    EZ_SUCCEED_OR_RETURN(ezArchiveUtils::WriteEntryOptimal(stream, e.m_sAbsSourcePath, uiPathStringOffset, e.m_CompressionMode,
-      toc.m_Entries.ExpandAndGetRef(), uiStreamSize, ezMakeDelegate(&ezArchiveBuilder::WriteFileProgressCallback, this)));
+          ++uiNumDeduplicatedEntries;
+          uiDeduplicatedBytes += tocEntry.m_uiStoredDataSize;
+        }
+      }
+      else
+      {
+        storedDataToEntry.Insert(uiStoredDataHash, uiTocEntryIdx);
+      }
+    }
+
+    if (!bDeduplicated)
+    {
+      if (stream.WriteBytes(task.m_Storage.GetData(), task.m_Storage.GetStorageSize()).Failed())
+      {
+        CancelPendingEntries();
+        return EZ_FAILURE;
+      }
+
+      uiStreamSize += tocEntry.m_uiStoredDataSize;
+    }
+
+    uiUncompressedSize += tocEntry.m_uiUncompressedDataSize;
+
+    // don't keep the memory of large entries around
+    task.m_Storage.Clear();
+    task.m_Storage.Compact();
+
+    uiPendingBytes -= pending.m_uiSourceSize;
+    unusedTasks.PushBack(pending.m_pTask);
+    pendingEntries.PopFront();
+
+    if (!WriteFileProgressCallback(tocEntry.m_uiUncompressedDataSize, tocEntry.m_uiUncompressedDataSize))
+    {
+      CancelPendingEntries();
+      return EZ_FAILURE;
+    }
   }
 
   EZ_SUCCEED_OR_RETURN(ezArchiveUtils::AppendTOC(stream, toc));
 
+  if (out_pStats != nullptr)
+  {
+    out_pStats->m_uiNumEntries = uiNumEntries;
+    out_pStats->m_uiUncompressedBytes = uiUncompressedSize;
+    out_pStats->m_uiStoredBytes = uiStreamSize;
+    out_pStats->m_uiNumDeduplicatedEntries = uiNumDeduplicatedEntries;
+    out_pStats->m_uiDeduplicatedBytes = uiDeduplicatedBytes;
+    out_pStats->m_uiNumDictionaries = toc.m_Dictionaries.GetCount();
+    out_pStats->m_uiNumDictionaryEntries = uiNumDictionaryEntries;
+    out_pStats->m_uiDictionaryBytes = 0;
+
+    for (const auto& dictionaryData : toc.m_Dictionaries)
+    {
+      out_pStats->m_uiDictionaryBytes += dictionaryData.GetCount();
+    }
+    out_pStats->m_Duration = ezTime::Now() - tStart;
+  }
+
   return EZ_SUCCESS;
 }
 
@@ -0,0 +1,236 @@
+#include <FoundationPCH.h>
+
+#include <Foundation/IO/Archive/ArchiveChunkedEntryReader.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Threading/TaskSystem.h>
+
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+
+ezArchiveChunkedEntryReader::ezArchiveChunkedEntryReader() = default;
+ezArchiveChunkedEntryReader::~ezArchiveChunkedEntryReader() = default;
+
+ezResult ezArchiveChunkedEntryReader::Configure(const void* pStoredData, ezUInt64 uiStoredDataSize, ezUInt64 uiUncompressedDataSize)
+{
+  m_pStoredData = static_cast<const ezUInt8*>(pStoredData);
+  m_uiUncompressedSize = uiUncompressedDataSize;
+  m_uiChunkSize = 0;
+  m_uiReadPosition = 0;
+  m_uiCurrentChunk = ezInvalidIndex;
+  m_ChunkOffsets.Clear();
+  m_ChunkIsUncompressed.Clear();
+
+  // the stored data ends with the seek table, the chunk size and the number of chunks
+  const ezUInt64 uiTrailerSize = sizeof(ezUInt32) * 2;
+
+  if (uiStoredDataSize < uiTrailerSize)
+  {
+    ezLog::Error("Archive is corrupt. Chunked entry is too small.");
+    return EZ_FAILURE;
+  }
+
+  ezUInt32 uiNumChunks = 0;
+  {
+    ezRawMemoryStreamReader reader(m_pStoredData + uiStoredDataSize - uiTrailerSize, uiTrailerSize);
+    reader >> m_uiChunkSize;
+    reader >> uiNumChunks;
+  }
+
+  if (m_uiChunkSize == 0 || uiNumChunks != (uiUncompressedDataSize + m_uiChunkSize - 1) / m_uiChunkSize)
+  {
+    ezLog::Error("Archive is corrupt. Invalid chunk size or count.");
+    return EZ_FAILURE;
+  }
+
+  const ezUInt64 uiSeekTableSize = (ezUInt64)uiNumChunks * sizeof(ezUInt32);
+
+  if (uiSeekTableSize + uiTrailerSize > uiStoredDataSize)
+  {
+    ezLog::Error("Archive is corrupt. Chunked entry seek table is cut off.");
+    return EZ_FAILURE;
+  }
+
+  const ezUInt64 uiChunkDataSize = uiStoredDataSize - uiSeekTableSize - uiTrailerSize;
+
+  m_ChunkOffsets.SetCountUninitialized(uiNumChunks + 1);
+  m_ChunkIsUncompressed.SetCount(uiNumChunks);
+
+  ezRawMemoryStreamReader seekTable(m_pStoredData + uiChunkDataSize, uiSeekTableSize);
+
+  ezUInt64 uiOffset = 0;
+  for (ezUInt32 i = 0; i < uiNumChunks; ++i)
+  {
+    // the highest bit marks chunks that are stored uncompressed
+    ezUInt32 uiStoredChunkSize = 0;
+    seekTable >> uiStoredChunkSize;
+
+    if ((uiStoredChunkSize & 0x80000000u) != 0)
+    {
+      m_ChunkIsUncompressed.SetBit(i);
+      uiStoredChunkSize &= 0x7FFFFFFFu;
+
+      if (uiStoredChunkSize != GetChunkUncompressedSize(i))
+      {
+        ezLog::Error("Archive is corrupt. Invalid size of uncompressed chunk.");
+        return EZ_FAILURE;
+      }
+    }
+
+    m_ChunkOffsets[i] = uiOffset;
+    uiOffset += uiStoredChunkSize;
+  }
+
+  m_ChunkOffsets[uiNumChunks] = uiOffset;
+
+  if (uiOffset != uiChunkDataSize)
+  {
+    ezLog::Error("Archive is corrupt. Chunked entry seek table does not match the data size.");
+    return EZ_FAILURE;
+  }
+
+  return EZ_SUCCESS;
+}
+
+ezUInt64 ezArchiveChunkedEntryReader::ReadBytes(void* pReadBuffer, ezUInt64 uiBytesToRead)
+{
+  if (pReadBuffer == nullptr)
+    return SkipBytes(uiBytesToRead);
+
+  ezUInt8* pTarget = static_cast<ezUInt8*>(pReadBuffer);
+  ezUInt64 uiBytesRead = 0;
+
+  while (uiBytesRead < uiBytesToRead && m_uiReadPosition < m_uiUncompressedSize)
+  {
+    const ezUInt32 uiChunk = static_cast<ezUInt32>(m_uiReadPosition / m_uiChunkSize);
+
+    if (uiChunk != m_uiCurrentChunk)
+    {
+      m_CurrentChunkData.SetCountUninitialized(GetChunkUncompressedSize(uiChunk));
+
+      if (DecompressChunk(uiChunk, m_CurrentChunkData.GetData(), m_Decompressor).Failed())
+      {
+        m_uiCurrentChunk = ezInvalidIndex;
+        break;
+      }
+
+      m_uiCurrentChunk = uiChunk;
+    }
+
+    const ezUInt32 uiOffsetInChunk = static_cast<ezUInt32>(m_uiReadPosition - (ezUInt64)uiChunk * m_uiChunkSize);
+    const ezUInt32 uiToCopy = static_cast<ezUInt32>(ezMath::Min<ezUInt64>(m_CurrentChunkData.GetCount() - uiOffsetInChunk, uiBytesToRead - uiBytesRead));
+
+    ezMemoryUtils::Copy(pTarget + uiBytesRead, m_CurrentChunkData.GetData() + uiOffsetInChunk, uiToCopy);
+
+    uiBytesRead += uiToCopy;
+    m_uiReadPosition += uiToCopy;
+  }
+
+  return uiBytesRead;
+}
+
+ezUInt64 ezArchiveChunkedEntryReader::SkipBytes(ezUInt64 uiBytesToSkip)
+{
+  const ezUInt64 uiSkipped = ezMath::Min(uiBytesToSkip, m_uiUncompressedSize - m_uiReadPosition);
+  m_uiReadPosition += uiSkipped;
+  return uiSkipped;
+}
+
+void ezArchiveChunkedEntryReader::SetReadPosition(ezUInt64 uiPosition)
+{
+  m_uiReadPosition = ezMath::Min(uiPosition, m_uiUncompressedSize);
+}
+
+ezUInt64 ezArchiveChunkedEntryReader::ReadRange(ezUInt64 uiOffset, void* pBuffer, ezUInt64 uiBytes, bool bParallel /*= true*/) const
+{
+  if (uiOffset >= m_uiUncompressedSize)
+    return 0;
+
+  uiBytes = ezMath::Min(uiBytes, m_uiUncompressedSize - uiOffset);
+
+  if (uiBytes == 0)
+    return 0;
+
+  const ezUInt64 uiEnd = uiOffset + uiBytes;
+  const ezUInt32 uiFirstChunk = static_cast<ezUInt32>(uiOffset / m_uiChunkSize);
+  const ezUInt32 uiLastChunk = static_cast<ezUInt32>((uiEnd - 1) / m_uiChunkSize);
+
+  ezAtomicInteger32 iFailed;
+
+  auto DecompressChunks = [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex) {
+    ezCompressedStreamReaderZstd decompressor;
+    ezDynamicArray<ezUInt8> tempChunk;
+
+    for (ezUInt32 uiChunk = uiFirstChunk + uiStartIndex; uiChunk < uiFirstChunk + uiEndIndex; ++uiChunk)
+    {
+      const ezUInt64 uiChunkStart = (ezUInt64)uiChunk * m_uiChunkSize;
+      const ezUInt32 uiChunkSize = GetChunkUncompressedSize(uiChunk);
+
+      const ezUInt64 uiCopyStart = ezMath::Max(uiChunkStart, uiOffset);
+      const ezUInt64 uiCopyEnd = ezMath::Min(uiChunkStart + uiChunkSize, uiEnd);
+      ezUInt8* pTarget = static_cast<ezUInt8*>(pBuffer) + (uiCopyStart - uiOffset);
+
+      if (uiCopyStart == uiChunkStart && uiCopyEnd == uiChunkStart + uiChunkSize)
+      {
+        // the whole chunk is requested, decompress it in place
+        if (DecompressChunk(uiChunk, pTarget, decompressor).Failed())
+          iFailed.Set(1);
+      }
+      else
+      {
+        tempChunk.SetCountUninitialized(uiChunkSize);
+
+        if (DecompressChunk(uiChunk, tempChunk.GetData(), decompressor).Failed())
+        {
+          iFailed.Set(1);
+          continue;
+        }
+
+        ezMemoryUtils::Copy(pTarget, tempChunk.GetData() + (uiCopyStart - uiChunkStart), static_cast<size_t>(uiCopyEnd - uiCopyStart));
+      }
+    }
+  };
+
+  const ezUInt32 uiNumChunks = uiLastChunk - uiFirstChunk + 1;
+
+  if (bParallel && uiNumChunks > 1)
+  {
+    ezTaskSystem::ParallelForIndexed(0, uiNumChunks, DecompressChunks, "Decompress Archive Chunks");
+  }
+  else
+  {
+    DecompressChunks(0, uiNumChunks);
+  }
+
+  return iFailed == 0 ? uiBytes : 0;
+}
+
+ezUInt32 ezArchiveChunkedEntryReader::GetChunkUncompressedSize(ezUInt32 uiChunk) const
+{
+  return static_cast<ezUInt32>(ezMath::Min<ezUInt64>(m_uiChunkSize, m_uiUncompressedSize - (ezUInt64)uiChunk * m_uiChunkSize));
+}
+
+ezResult ezArchiveChunkedEntryReader::DecompressChunk(ezUInt32 uiChunk, ezUInt8* pTarget, ezCompressedStreamReaderZstd& decompressor) const
+{
+  const ezUInt32 uiChunkSize = GetChunkUncompressedSize(uiChunk);
+  const ezUInt8* pChunkData = m_pStoredData + m_ChunkOffsets[uiChunk];
+
+  if (m_ChunkIsUncompressed.IsBitSet(uiChunk))
+  {
+    ezMemoryUtils::Copy(pTarget, pChunkData, uiChunkSize);
+    return EZ_SUCCESS;
+  }
+
+  ezRawMemoryStreamReader chunkReader(pChunkData, m_ChunkOffsets[uiChunk + 1] - m_ChunkOffsets[uiChunk]);
+  decompressor.SetInputStream(&chunkReader);
+
+  if (decompressor.ReadBytes(pTarget, uiChunkSize) != uiChunkSize)
+  {
+    ezLog::Error("Archive is corrupt. Failed to decompress chunk {}.", uiChunk);
+    return EZ_FAILURE;
+  }
+
+  return EZ_SUCCESS;
+}
+
+#endif
+
+EZ_STATICLINK_FILE(Foundation, Foundation_IO_Archive_Implementation_ArchiveChunkedEntryReader);
@@ -1,9 +1,11 @@
 #include <FoundationPCH.h>
 
+#include <Foundation/IO/Archive/ArchiveChunkedEntryReader.h>
 #include <Foundation/IO/Archive/ArchiveReader.h>
 #include <Foundation/IO/Archive/ArchiveUtils.h>
 
-#include <Foundation/IO/Archive/ArchiveUtils.h>
+#include <Foundation/Containers/HashSet.h>
+#include <Foundation/IO/CompressedStreamZstd.h>
 #include <Foundation/IO/FileSystem/FileWriter.h>
 #include <Foundation/IO/MemoryStream.h>
 #include <Foundation/Logging/Log.h>
@@ -11,11 +13,21 @@
 
 #include <Foundation/Logging/Log.h>
 
+ezArchiveReader::ezArchiveReader() = default;
+ezArchiveReader::~ezArchiveReader() = default;
+
 ezResult ezArchiveReader::OpenArchive(const char* szPath)
 {
 #if EZ_ENABLED(EZ_SUPPORTS_MEMORY_MAPPED_FILE)
   EZ_LOG_BLOCK("OpenArchive", szPath);
 
+  const ezTime tStart = ezTime::Now();
+
+#  ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+  m_Dictionaries.Clear();
+#  endif
+  m_Stats = Stats();
+
   EZ_SUCCEED_OR_RETURN(m_MemFile.Open(szPath, ezMemoryMappedFile::Mode::ReadOnly));
   m_uiMemFileSize = m_MemFile.GetFileSize();
 
@@ -70,7 +82,8 @@ ezResult ezArchiveReader::OpenArchive(const char* szPath)
         return EZ_FAILURE;
       }
 
-      if (e.m_uiUncompressedDataSize < e.m_uiStoredDataSize)
+      // chunked entries may be slightly larger than their content, their seek table is validated when a reader is created
+      if (e.m_uiUncompressedDataSize < e.m_uiStoredDataSize && e.m_CompressionMode != ezArchiveCompressionMode::Compressed_zstd_chunked)
       {
         ezLog::Error("Archive is corrupt. Invalid compression info.");
         return EZ_FAILURE;
@@ -81,9 +94,60 @@ ezResult ezArchiveReader::OpenArchive(const char* szPath)
         ezLog::Error("Archive is corrupt. Invalid entry path-string offset.");
         return EZ_FAILURE;
       }
+
+      if (e.m_uiDictionaryIndex != ezInvalidIndex && e.m_CompressionMode != ezArchiveCompressionMode::Compressed_zstd)
+      {
+        ezLog::Error("Archive is corrupt. Dictionary used without zstd compression.");
+        return EZ_FAILURE;
+      }
     }
   }
 
+  // prepare the dictionaries once, all entry readers share them
+  if (!m_ArchiveTOC.m_Dictionaries.IsEmpty())
+  {
+#  ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+    m_Dictionaries.SetCount(m_ArchiveTOC.m_Dictionaries.GetCount());
+
+    for (ezUInt32 i = 0; i < m_Dictionaries.GetCount(); ++i)
+    {
+      m_Dictionaries[i] = EZ_DEFAULT_NEW(ezCompressedStreamZstdDictionary);
+
+      if (m_Dictionaries[i]->InitializeForDecompression(m_ArchiveTOC.m_Dictionaries[i]).Failed())
+      {
+        ezLog::Error("Archive is corrupt. Invalid dictionary data.");
+        return EZ_FAILURE;
+      }
+
+      m_Stats.m_uiDictionaryBytes += m_ArchiveTOC.m_Dictionaries[i].GetCount();
+    }
+#  else
+    ezLog::Error("Archive uses zstd dictionaries, but zstd support is not compiled in.");
+    return EZ_FAILURE;
+#  endif
+  }
+
+  {
+    ezHashSet<ezUInt64> dataRanges;
+    dataRanges.Reserve(m_ArchiveTOC.m_Entries.GetCount());
+
+    for (const auto& e : m_ArchiveTOC.m_Entries)
+    {
+      m_Stats.m_uiUncompressedBytes += e.m_uiUncompressedDataSize;
+
+      if (!dataRanges.Insert(e.m_uiDataStartOffset))
+      {
+        m_Stats.m_uiStoredBytes += e.m_uiStoredDataSize;
+      }
+    }
+
+    m_Stats.m_uiNumEntries = m_ArchiveTOC.m_Entries.GetCount();
+    m_Stats.m_uiNumDataRanges = dataRanges.GetCount();
+    m_Stats.m_uiNumDictionaries = m_ArchiveTOC.m_Dictionaries.GetCount();
+  }
+
+  m_Stats.m_LoadTime = ezTime::Now() - tStart;
+
   return EZ_SUCCESS;
 #else
   EZ_REPORT_FAILURE("Memory mapped files are unsupported on this platform.");
@@ -115,14 +179,94 @@ ezResult ezArchiveReader::ExtractAllFiles(const char* szTargetFolder) const
   return EZ_SUCCESS;
 }
 
+const void* ezArchiveReader::GetEntryStoredData(ezUInt32 uiEntryIdx) const
+{
+  return ezMemoryUtils::AddByteOffset(m_pDataStart, static_cast<ptrdiff_t>(m_ArchiveTOC.m_Entries[uiEntryIdx].m_uiDataStartOffset));
+}
+
+void ezArchiveReader::PrefetchEntry(ezUInt32 uiEntryIdx) const
+{
+  const ezArchiveEntry& entry = m_ArchiveTOC.m_Entries[uiEntryIdx];
+
+  // the entry offsets are relative to m_pDataStart, the mapping starts at the beginning of the file
+  const ezUInt64 uiDataStartInFile =
+    static_cast<ezUInt64>(static_cast<const ezUInt8*>(m_pDataStart) - static_cast<const ezUInt8*>(m_MemFile.GetReadPointer()));
+
+  m_MemFile.Prefetch(uiDataStartInFile + entry.m_uiDataStartOffset, entry.m_uiStoredDataSize);
+}
+
 void ezArchiveReader::ConfigureRawMemoryStreamReader(ezUInt32 uiEntryIdx, ezRawMemoryStreamReader& memReader) const
 {
   ezArchiveUtils::ConfigureRawMemoryStreamReader(m_ArchiveTOC.m_Entries[uiEntryIdx], m_pDataStart, memReader);
 }
 
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+ezResult ezArchiveReader::ConfigureChunkedEntryReader(ezUInt32 uiEntryIdx, ezArchiveChunkedEntryReader& reader) const
+{
+  const ezArchiveEntry& entry = m_ArchiveTOC.m_Entries[uiEntryIdx];
+  EZ_ASSERT_DEV(entry.m_CompressionMode == ezArchiveCompressionMode::Compressed_zstd_chunked, "The archive entry is not chunked");
+
+  return reader.Configure(ezMemoryUtils::AddByteOffset(m_pDataStart, static_cast<ptrdiff_t>(entry.m_uiDataStartOffset)),
+    entry.m_uiStoredDataSize, entry.m_uiUncompressedDataSize);
+}
+#endif
+
 ezUniquePtr<ezStreamReader> ezArchiveReader::CreateEntryReader(ezUInt32 uiEntryIdx) const
 {
-  return ezArchiveUtils::CreateEntryReader(m_ArchiveTOC.m_Entries[uiEntryIdx], m_pDataStart);
+  return ezArchiveUtils::CreateEntryReader(m_ArchiveTOC.m_Entries[uiEntryIdx], m_pDataStart, GetEntryDictionary(uiEntryIdx));
+}
+
+ezUInt64 ezArchiveReader::ReadEntryRange(ezUInt32 uiEntryIdx, ezUInt64 uiOffset, void* pBuffer, ezUInt64 uiBytes) const
+{
+  const ezArchiveEntry& entry = m_ArchiveTOC.m_Entries[uiEntryIdx];
+
+  if (uiOffset >= entry.m_uiUncompressedDataSize)
+    return 0;
+
+  uiBytes = ezMath::Min(uiBytes, entry.m_uiUncompressedDataSize - uiOffset);
+
+  switch (entry.m_CompressionMode)
+  {
+    case ezArchiveCompressionMode::Uncompressed:
+    {
+      ezMemoryUtils::Copy(static_cast<ezUInt8*>(pBuffer),
+        static_cast<const ezUInt8*>(m_pDataStart) + entry.m_uiDataStartOffset + uiOffset, static_cast<size_t>(uiBytes));
+      return uiBytes;
+    }
+
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+    case ezArchiveCompressionMode::Compressed_zstd_chunked:
+    {
+      ezArchiveChunkedEntryReader reader;
+      if (ConfigureChunkedEntryReader(uiEntryIdx, reader).Failed())
+        return 0;
+
+      return reader.ReadRange(uiOffset, pBuffer, uiBytes);
+    }
+#endif
+
+    default:
+    {
+      ezUniquePtr<ezStreamReader> pReader = CreateEntryReader(uiEntryIdx);
+
+      if (pReader == nullptr || pReader->SkipBytes(uiOffset) != uiOffset)
+        return 0;
+
+      return pReader->ReadBytes(pBuffer, uiBytes);
+    }
+  }
+}
+
+const ezCompressedStreamZstdDictionary* ezArchiveReader::GetEntryDictionary(ezUInt32 uiEntryIdx) const
+{
+  const ezUInt32 uiDictionaryIdx = m_ArchiveTOC.m_Entries[uiEntryIdx].m_uiDictionaryIndex;
+
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+  if (uiDictionaryIdx != ezInvalidIndex)
+    return m_Dictionaries[uiDictionaryIdx].Borrow();
+#endif
+
+  return nullptr;
 }
 
 ezResult ezArchiveReader::ExtractFile(ezUInt32 uiEntryIdx, const char* szTargetFolder) const
@@ -132,6 +276,9 @@ ezResult ezArchiveReader::ExtractFile(ezUInt32 uiEntryIdx, const char* szTargetF
 
   ezUniquePtr<ezStreamReader> pReader = CreateEntryReader(uiEntryIdx);
 
+  if (pReader == nullptr)
+    return EZ_FAILURE;
+
   ezStringBuilder sOutputFile = szTargetFolder;
   sOutputFile.AppendPath(szFilePath);
 
@@ -1,5 +1,6 @@
 #include <FoundationPCH.h>
 
+#include <Foundation/IO/Archive/ArchiveChunkedEntryReader.h>
 #include <Foundation/IO/Archive/ArchiveUtils.h>
 
 #include <Foundation/IO/CompressedStreamZlib.h>
@@ -84,9 +85,77 @@ ezResult ezArchiveUtils::ReadHeader(ezStreamReader& stream, ezUInt8& out_uiVersi
   return EZ_SUCCESS;
 }
 
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+
+static ezResult WriteChunkedEntryData(ezStreamReader& file, ezUInt64 uiMaxBytes, ezStreamWriter& stream, ezArchiveEntry& tocEntry,
+  const ezArchiveUtils::FileWriteProgressCallback& progress)
+{
+  ezDynamicArray<ezUInt8> chunk;
+  chunk.SetCountUninitialized(ezArchiveUtils::ChunkedCompressionChunkSize);
+
+  ezDynamicArray<ezUInt32> seekTable;
+  ezMemoryStreamStorage compressedChunk;
+  ezCompressedStreamWriterZstd zstdWriter;
+
+  tocEntry.m_uiStoredDataSize = 0;
+
+  while (true)
+  {
+    const ezUInt32 uiChunkSize = static_cast<ezUInt32>(file.ReadBytes(chunk.GetData(), chunk.GetCount()));
+
+    if (uiChunkSize == 0)
+      break;
+
+    tocEntry.m_uiUncompressedDataSize += uiChunkSize;
+
+    if (progress.IsValid())
+    {
+      if (!progress(tocEntry.m_uiUncompressedDataSize, uiMaxBytes))
+        return EZ_FAILURE;
+    }
+
+    // every chunk is a separate zstd stream, so that it can be decompressed without the chunks before it
+    compressedChunk.Clear();
+    ezMemoryStreamWriter chunkWriter(&compressedChunk);
+    zstdWriter.SetOutputStream(&chunkWriter);
+    EZ_SUCCEED_OR_RETURN(zstdWriter.WriteBytes(chunk.GetData(), uiChunkSize));
+    EZ_SUCCEED_OR_RETURN(zstdWriter.FinishCompressedStream());
+
+    if (compressedChunk.GetStorageSize() < uiChunkSize)
+    {
+      EZ_SUCCEED_OR_RETURN(stream.WriteBytes(compressedChunk.GetData(), compressedChunk.GetStorageSize()));
+      seekTable.PushBack(compressedChunk.GetStorageSize());
+    }
+    else
+    {
+      // incompressible data is stored as it is, marked by the highest bit
+      EZ_SUCCEED_OR_RETURN(stream.WriteBytes(chunk.GetData(), uiChunkSize));
+      seekTable.PushBack(uiChunkSize | 0x80000000u);
+    }
+
+    tocEntry.m_uiStoredDataSize += seekTable.PeekBack() & 0x7FFFFFFFu;
+
+    if (uiChunkSize < chunk.GetCount())
+      break;
+  }
+
+  for (ezUInt32 uiStoredChunkSize : seekTable)
+  {
+    stream << uiStoredChunkSize;
+  }
+
+  stream << static_cast<ezUInt32>(ezArchiveUtils::ChunkedCompressionChunkSize);
+  stream << seekTable.GetCount();
+
+  tocEntry.m_uiStoredDataSize += (seekTable.GetCount() + 2) * sizeof(ezUInt32);
+  return EZ_SUCCESS;
+}
+
+#endif
+
 ezResult ezArchiveUtils::WriteEntry(ezStreamWriter& stream, const char* szAbsSourcePath, ezUInt32 uiPathStringOffset,
   ezArchiveCompressionMode compression, ezArchiveEntry& tocEntry, ezUInt64& inout_uiCurrentStreamPosition,
-  FileWriteProgressCallback progress /*= FileWriteProgressCallback()*/)
+  FileWriteProgressCallback progress /*= FileWriteProgressCallback()*/, const ezCompressedStreamZstdDictionary* pDictionary /*= nullptr*/)
 {
   ezFileReader file;
   EZ_SUCCEED_OR_RETURN(file.Open(szAbsSourcePath, 1024 * 1024));
@@ -113,12 +182,28 @@ ezResult ezArchiveUtils::WriteEntry(ezStreamWriter& stream, const char* szAbsSou
     case ezArchiveCompressionMode::Compressed_zstd:
 #ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
       zstdWriter.SetOutputStream(&stream);
+      if (pDictionary != nullptr)
+      {
+        zstdWriter.SetDictionary(pDictionary);
+      }
       pWriter = &zstdWriter;
 #else
       compression = ezArchiveCompressionMode::Uncompressed;
 #endif
       break;
 
+    case ezArchiveCompressionMode::Compressed_zstd_chunked:
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+      EZ_ASSERT_DEV(pDictionary == nullptr, "Chunked entries can't be compressed with a dictionary");
+      tocEntry.m_CompressionMode = compression;
+      EZ_SUCCEED_OR_RETURN(WriteChunkedEntryData(file, uiMaxBytes, stream, tocEntry, progress));
+      inout_uiCurrentStreamPosition += tocEntry.m_uiStoredDataSize;
+      return EZ_SUCCESS;
+#else
+      compression = ezArchiveCompressionMode::Uncompressed;
+      break;
+#endif
+
     default:
       EZ_ASSERT_NOT_IMPLEMENTED;
   }
@@ -167,7 +252,7 @@ ezResult ezArchiveUtils::WriteEntry(ezStreamWriter& stream, const char* szAbsSou
 
 ezResult ezArchiveUtils::WriteEntryOptimal(ezStreamWriter& stream, const char* szAbsSourcePath, ezUInt32 uiPathStringOffset,
   ezArchiveCompressionMode compression, ezArchiveEntry& tocEntry, ezUInt64& inout_uiCurrentStreamPosition,
-  FileWriteProgressCallback progress /*= FileWriteProgressCallback()*/)
+  FileWriteProgressCallback progress /*= FileWriteProgressCallback()*/, const ezCompressedStreamZstdDictionary* pDictionary /*= nullptr*/)
 {
   if (compression == ezArchiveCompressionMode::Uncompressed)
   {
@@ -180,7 +265,7 @@ ezResult ezArchiveUtils::WriteEntryOptimal(ezStreamWriter& stream, const char* s
     ezMemoryStreamWriter writer(&storage);
 
     ezUInt64 streamPos = inout_uiCurrentStreamPosition;
-    EZ_SUCCEED_OR_RETURN(WriteEntry(writer, szAbsSourcePath, uiPathStringOffset, compression, tocEntry, streamPos, progress));
+    EZ_SUCCEED_OR_RETURN(WriteEntry(writer, szAbsSourcePath, uiPathStringOffset, compression, tocEntry, streamPos, progress, pDictionary));
 
     if (tocEntry.m_uiStoredDataSize * 12 >= tocEntry.m_uiUncompressedDataSize * 10)
     {
@@ -198,6 +283,144 @@ ezResult ezArchiveUtils::WriteEntryOptimal(ezStreamWriter& stream, const char* s
   }
 }
 
+void ezArchiveUtils::TrainDictionary(
+  ezArrayPtr<const ezArrayPtr<const ezUInt8>> samples, ezUInt32 uiMaxDictionarySize, ezDynamicArray<ezUInt8>& out_Dictionary)
+{
+  // This follows the idea of zstd's COVER dictionary builder: byte sequences (d-mers) that occur in many samples are valuable,
+  // so the dictionary is assembled from the segments that contain the most valuable d-mers, one segment per epoch of the input.
+
+  out_Dictionary.Clear();
+
+  ezUInt64 uiTotalSize = 0;
+  for (const auto& sample : samples)
+  {
+    uiTotalSize += sample.GetCount();
+  }
+
+  if (uiTotalSize <= uiMaxDictionarySize)
+  {
+    for (const auto& sample : samples)
+    {
+      out_Dictionary.PushBackRange(sample);
+    }
+
+    return;
+  }
+
+  constexpr ezUInt32 uiDmerSize = 8;
+  constexpr ezUInt32 uiSegmentSize = 1024;
+  constexpr ezUInt32 uiHashBits = 20;
+
+  auto ComputeDmerHash = [](const ezUInt8* pData) -> ezUInt32 {
+    ezUInt64 uiDmer;
+    ezMemoryUtils::RawByteCopy(&uiDmer, pData, uiDmerSize);
+    return static_cast<ezUInt32>((uiDmer * 0xCF1BBCDCB7A56463ull) >> (64 - uiHashBits));
+  };
+
+  ezDynamicArray<ezUInt8> allSamples;
+  allSamples.Reserve(static_cast<ezUInt32>(uiTotalSize));
+
+  // count in how many samples each d-mer occurs
+  ezDynamicArray<ezUInt32> frequencies;
+  frequencies.SetCount(1u << uiHashBits, 0);
+
+  {
+    ezDynamicArray<ezUInt32> lastSample;
+    lastSample.SetCount(1u << uiHashBits, ezInvalidIndex);
+
+    for (ezUInt32 s = 0; s < samples.GetCount(); ++s)
+    {
+      const ezArrayPtr<const ezUInt8>& sample = samples[s];
+      allSamples.PushBackRange(sample);
+
+      for (ezUInt32 uiPos = 0; uiPos + uiDmerSize <= sample.GetCount(); ++uiPos)
+      {
+        const ezUInt32 uiHash = ComputeDmerHash(sample.GetPtr() + uiPos);
+
+        if (lastSample[uiHash] != s)
+        {
+          lastSample[uiHash] = s;
+          ++frequencies[uiHash];
+        }
+      }
+    }
+
+    // a d-mer that only occurs in a single sample doesn't help any other sample
+    for (ezUInt32& uiFrequency : frequencies)
+    {
+      uiFrequency = uiFrequency > 0 ? uiFrequency - 1 : 0;
+    }
+  }
+
+  struct Segment
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt32 m_uiStart;
+    ezUInt32 m_uiSize;
+    ezUInt64 m_uiScore;
+
+    bool operator<(const Segment& rhs) const { return m_uiScore < rhs.m_uiScore; }
+  };
+
+  ezDynamicArray<Segment> segments;
+
+  const ezUInt32 uiDataSize = allSamples.GetCount();
+  const ezUInt32 uiNumEpochs = ezMath::Max(1u, uiMaxDictionarySize / uiSegmentSize);
+
+  for (ezUInt32 uiEpoch = 0; uiEpoch < uiNumEpochs; ++uiEpoch)
+  {
+    const ezUInt32 uiEpochStart = static_cast<ezUInt32>((ezUInt64)uiDataSize * uiEpoch / uiNumEpochs);
+    const ezUInt32 uiEpochEnd = static_cast<ezUInt32>((ezUInt64)uiDataSize * (uiEpoch + 1) / uiNumEpochs);
+    const ezUInt32 uiWindowSize = ezMath::Min(uiSegmentSize, ezMath::Min(uiEpochEnd - uiEpochStart, uiMaxDictionarySize));
+
+    if (uiWindowSize < uiDmerSize)
+      continue;
+
+    const ezUInt32 uiDmersPerWindow = uiWindowSize - uiDmerSize + 1;
+
+    // slide a window over the epoch and find the segment with the highest sum of d-mer frequencies
+    ezUInt64 uiScore = 0;
+    for (ezUInt32 i = 0; i < uiDmersPerWindow; ++i)
+    {
+      uiScore += frequencies[ComputeDmerHash(allSamples.GetData() + uiEpochStart + i)];
+    }
+
+    Segment best = {uiEpochStart, uiWindowSize, uiScore};
+
+    for (ezUInt32 uiStart = uiEpochStart + 1; uiStart + uiWindowSize <= uiEpochEnd; ++uiStart)
+    {
+      uiScore -= frequencies[ComputeDmerHash(allSamples.GetData() + uiStart - 1)];
+      uiScore += frequencies[ComputeDmerHash(allSamples.GetData() + uiStart + uiDmersPerWindow - 1)];
+
+      if (uiScore > best.m_uiScore)
+      {
+        best.m_uiStart = uiStart;
+        best.m_uiScore = uiScore;
+      }
+    }
+
+    if (best.m_uiScore == 0)
+      continue;
+
+    // the d-mers of the chosen segment are covered now, don't let them make other segments look valuable
+    for (ezUInt32 i = 0; i < uiDmersPerWindow; ++i)
+    {
+      frequencies[ComputeDmerHash(allSamples.GetData() + best.m_uiStart + i)] = 0;
+    }
+
+    segments.PushBack(best);
+  }
+
+  // zstd references recent data more cheaply, so the most valuable segments go last
+  segments.Sort();
+
+  for (const Segment& segment : segments)
+  {
+    out_Dictionary.PushBackRange(allSamples.GetArrayPtr().GetSubArray(segment.m_uiStart, segment.m_uiSize));
+  }
+}
+
 #ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
 
 class ezCompressedStreamReaderZstdWithSource : public ezCompressedStreamReaderZstd
@@ -218,8 +441,11 @@ public:
 
 #endif
 
-ezUniquePtr<ezStreamReader> ezArchiveUtils::CreateEntryReader(const ezArchiveEntry& entry, const void* pStartOfArchiveData)
+ezUniquePtr<ezStreamReader> ezArchiveUtils::CreateEntryReader(
+  const ezArchiveEntry& entry, const void* pStartOfArchiveData, const ezCompressedStreamZstdDictionary* pDictionary /*= nullptr*/)
 {
+  EZ_ASSERT_DEV(entry.m_uiDictionaryIndex == ezInvalidIndex || pDictionary != nullptr, "The archive entry requires a dictionary");
+
   ezUniquePtr<ezStreamReader> reader;
 
   switch (entry.m_CompressionMode)
@@ -239,6 +465,24 @@ ezUniquePtr<ezStreamReader> ezArchiveUtils::CreateEntryReader(const ezArchiveEnt
       ezCompressedStreamReaderZstdWithSource* pRawReader = static_cast<ezCompressedStreamReaderZstdWithSource*>(reader.Borrow());
       ConfigureRawMemoryStreamReader(entry, pStartOfArchiveData, pRawReader->m_Source);
       pRawReader->SetInputStream(&pRawReader->m_Source);
+      if (pDictionary != nullptr)
+      {
+        pRawReader->SetDictionary(pDictionary);
+      }
+      break;
+    }
+
+    case ezArchiveCompressionMode::Compressed_zstd_chunked:
+    {
+      ezUniquePtr<ezArchiveChunkedEntryReader> pChunkedReader = EZ_DEFAULT_NEW(ezArchiveChunkedEntryReader);
+
+      if (pChunkedReader
+            ->Configure(ezMemoryUtils::AddByteOffset(pStartOfArchiveData, static_cast<ptrdiff_t>(entry.m_uiDataStartOffset)),
+              entry.m_uiStoredDataSize, entry.m_uiUncompressedDataSize)
+            .Succeeded())
+      {
+        reader = std::move(pChunkedReader);
+      }
       break;
     }
 #endif
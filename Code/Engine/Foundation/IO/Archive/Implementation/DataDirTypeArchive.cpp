@@ -88,6 +88,21 @@ ezDataDirectoryReader* ezDataDirectory::ArchiveType::OpenFileToRead(
         }
         break;
       }
+
+      case ezArchiveCompressionMode::Compressed_zstd_chunked:
+      {
+        if (!m_FreeReadersZstdChunked.IsEmpty())
+        {
+          pReader = m_FreeReadersZstdChunked.PeekBack();
+          m_FreeReadersZstdChunked.PopBack();
+        }
+        else
+        {
+          m_ReadersZstdChunked.PushBack(EZ_DEFAULT_NEW(ArchiveReaderZstdChunked, 3));
+          pReader = m_ReadersZstdChunked.PeekBack().Borrow();
+        }
+        break;
+      }
 #endif
 #ifdef BUILDSYSTEM_ENABLE_ZLIB_SUPPORT
       case ezArchiveCompressionMode::Compressed_zip:
@@ -114,9 +129,28 @@ ezDataDirectoryReader* ezDataDirectory::ArchiveType::OpenFileToRead(
 
   pReader->m_uiUncompressedSize = pEntry->m_uiUncompressedDataSize;
   pReader->m_uiCompressedSize = pEntry->m_uiStoredDataSize;
+  pReader->m_pStoredData = m_ArchiveReader.GetEntryStoredData(uiEntryIndex);
 
   m_ArchiveReader.ConfigureRawMemoryStreamReader(uiEntryIndex, pReader->m_MemStreamReader);
 
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+  if (pEntry->m_CompressionMode == ezArchiveCompressionMode::Compressed_zstd)
+  {
+    static_cast<ArchiveReaderZstd*>(pReader)->m_pDictionary = m_ArchiveReader.GetEntryDictionary(uiEntryIndex);
+  }
+  else if (pEntry->m_CompressionMode == ezArchiveCompressionMode::Compressed_zstd_chunked)
+  {
+    ArchiveReaderZstdChunked* pChunkedReader = static_cast<ArchiveReaderZstdChunked*>(pReader);
+
+    if (m_ArchiveReader.ConfigureChunkedEntryReader(uiEntryIndex, pChunkedReader->m_ChunkedReader).Failed())
+    {
+      EZ_LOCK(m_ReaderMutex);
+      m_FreeReadersZstdChunked.PushBack(pChunkedReader);
+      return nullptr;
+    }
+  }
+#endif
+
   if (pReader->Open(sArchivePath, this, FileShareMode).Failed())
   {
     EZ_DEFAULT_DELETE(pReader);
@@ -139,6 +173,19 @@ bool ezDataDirectory::ArchiveType::ExistsFile(const char* szFile, bool bOneSpeci
   return m_ArchiveReader.GetArchiveTOC().FindEntry(sArchivePath) != ezInvalidIndex;
 }
 
+bool ezDataDirectory::ArchiveType::PrefetchFile(const char* szFile, bool bOneSpecificDataDir)
+{
+  ezStringBuilder sArchivePath = m_sArchiveSubFolder;
+  sArchivePath.AppendPath(szFile);
+  const ezUInt32 uiEntryIndex = m_ArchiveReader.GetArchiveTOC().FindEntry(sArchivePath);
+
+  if (uiEntryIndex == ezInvalidIndex)
+    return false;
+
+  m_ArchiveReader.PrefetchEntry(uiEntryIndex);
+  return true;
+}
+
 ezResult ezDataDirectory::ArchiveType::GetFileStats(const char* szFileOrFolder, bool bOneSpecificDataDir, ezFileStats& out_Stats)
 {
   const ezArchiveTOC& toc = m_ArchiveReader.GetArchiveTOC();
@@ -220,6 +267,11 @@ endloop:
 
   EZ_SUCCEED_OR_RETURN(m_ArchiveReader.OpenArchive(sArchivePath));
 
+  const ezArchiveReader::Stats& archiveStats = m_ArchiveReader.GetStats();
+  ezLog::Dev("{} entries in {} data ranges ({} -> {}), {} dictionaries ({}), opened in {}", archiveStats.m_uiNumEntries,
+    archiveStats.m_uiNumDataRanges, ezArgFileSize(archiveStats.m_uiUncompressedBytes), ezArgFileSize(archiveStats.m_uiStoredBytes),
+    archiveStats.m_uiNumDictionaries, ezArgFileSize(archiveStats.m_uiDictionaryBytes), archiveStats.m_LoadTime);
+
   ReloadExternalConfigs();
 
   return EZ_SUCCESS;
@@ -241,6 +293,12 @@ void ezDataDirectory::ArchiveType::OnReaderWriterClose(ezDataDirectoryReaderWrit
     m_FreeReadersZstd.PushBack(static_cast<ArchiveReaderZstd*>(pClosed));
     return;
   }
+
+  if (pClosed->GetDataDirUserData() == 3)
+  {
+    m_FreeReadersZstdChunked.PushBack(static_cast<ArchiveReaderZstdChunked*>(pClosed));
+    return;
+  }
 #endif
 
 #ifdef BUILDSYSTEM_ENABLE_ZLIB_SUPPORT
@@ -273,6 +331,15 @@ ezUInt64 ezDataDirectory::ArchiveReaderUncompressed::GetFileSize() const
   return m_uiUncompressedSize;
 }
 
+ezArrayPtr<const ezUInt8> ezDataDirectory::ArchiveReaderUncompressed::GetMappedData() const
+{
+  // only the uncompressed reader stores the file content as is, the derived readers have to decompress it
+  if (GetDataDirUserData() != 0 || m_uiUncompressedSize > ezMath::MaxValue<ezUInt32>())
+    return ezArrayPtr<const ezUInt8>();
+
+  return ezArrayPtr<const ezUInt8>(static_cast<const ezUInt8*>(m_pStoredData), static_cast<ezUInt32>(m_uiUncompressedSize));
+}
+
 ezResult ezDataDirectory::ArchiveReaderUncompressed::InternalOpen(ezFileShareMode::Enum FileShareMode)
 {
   EZ_ASSERT_DEBUG(
@@ -309,6 +376,30 @@ ezResult ezDataDirectory::ArchiveReaderZstd::InternalOpen(ezFileShareMode::Enum
     FileShareMode != ezFileShareMode::Exclusive, "Archives only support shared reading of files. Exclusive access cannot be guaranteed.");
 
   m_CompressedStreamReader.SetInputStream(&m_MemStreamReader);
+  m_CompressedStreamReader.SetDictionary(m_pDictionary);
+  return EZ_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+ezDataDirectory::ArchiveReaderZstdChunked::ArchiveReaderZstdChunked(ezInt32 iDataDirUserData)
+  : ArchiveReaderUncompressed(iDataDirUserData)
+{
+}
+
+ezDataDirectory::ArchiveReaderZstdChunked::~ArchiveReaderZstdChunked() = default;
+
+ezUInt64 ezDataDirectory::ArchiveReaderZstdChunked::Read(void* pBuffer, ezUInt64 uiBytes)
+{
+  return m_ChunkedReader.ReadBytes(pBuffer, uiBytes);
+}
+
+ezResult ezDataDirectory::ArchiveReaderZstdChunked::InternalOpen(ezFileShareMode::Enum FileShareMode)
+{
+  EZ_ASSERT_DEBUG(
+    FileShareMode != ezFileShareMode::Exclusive, "Archives only support shared reading of files. Exclusive access cannot be guaranteed.");
+
+  // the reader was already configured by ArchiveType::OpenFileToRead()
   return EZ_SUCCESS;
 }
 
@@ -7,6 +7,8 @@
 
 #ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
 
+class ezCompressedStreamZstdDictionary;
+
 /// \brief A stream reader that will decompress data that was stored using the ezCompressedStreamWriterZstd.
 ///
 /// The reader takes another reader as its source for the compressed data (e.g. a file or a memory stream).
@@ -26,6 +28,12 @@ public:
   /// one.
   void SetInputStream(ezStreamReader* pInputStream); // [tested]
 
+  /// \brief Decompresses the current input stream with the given dictionary, which must be the one the data was compressed with.
+  ///
+  /// Has to be called after SetInputStream() and before reading any bytes. The dictionary must stay alive until the stream is read.
+  /// Passing nullptr reads the stream without a dictionary.
+  void SetDictionary(const ezCompressedStreamZstdDictionary* pDictionary); // [tested]
+
   /// \brief Reads either uiBytesToRead or the amount of remaining bytes in the stream into pReadBuffer.
   ///
   /// It is valid to pass nullptr for pReadBuffer, in this case the memory stream position is only advanced by the given number of bytes.
@@ -94,6 +102,13 @@ public:
   /// allocate internal structures once that final decision is made.
   void SetOutputStream(ezStreamWriter* pOutputStream, Compression Ratio = Compression::Default, ezUInt32 uiCompressionCacheSizeKB = 4); // [tested]
 
+  /// \brief Compresses the current output stream with the given dictionary.
+  ///
+  /// Has to be called after SetOutputStream() and before writing any bytes. The compression level of the dictionary replaces the one
+  /// passed to SetOutputStream(). The dictionary must stay alive until FinishCompressedStream() was called.
+  /// Passing nullptr compresses without a dictionary.
+  void SetDictionary(const ezCompressedStreamZstdDictionary* pDictionary); // [tested]
+
   /// \brief Compresses \a uiBytesToWrite from \a pWriteBuffer.
   ///
   /// Will output bursts of 256 bytes to the output stream every once in a while.
@@ -154,4 +169,42 @@ private:
   ezDynamicArray<ezUInt8> m_CompressedCache;
 };
 
+/// \brief A zstd dictionary that can be shared by any number of ezCompressedStreamReaderZstd and ezCompressedStreamWriterZstd instances.
+///
+/// Small data compresses poorly on its own, because the compressor has no history that it can refer back to. A dictionary that was built
+/// from similar data (see ezArchiveUtils::TrainDictionary()) provides that history up front. Data that was compressed with a dictionary
+/// can only be decompressed with the same dictionary.
+/// The dictionary is read-only after initialization and may be used by multiple streams on different threads at the same time.
+class EZ_FOUNDATION_DLL ezCompressedStreamZstdDictionary
+{
+  EZ_DISALLOW_COPY_AND_ASSIGN(ezCompressedStreamZstdDictionary);
+
+public:
+  ezCompressedStreamZstdDictionary();
+  ~ezCompressedStreamZstdDictionary();
+
+  /// \brief Prepares the dictionary for ezCompressedStreamWriterZstd::SetDictionary(). The data is copied.
+  ///
+  /// The dictionary may be raw content or a dictionary in the zstd format.
+  ezResult InitializeForCompression(ezArrayPtr<const ezUInt8> dictionary,
+    ezCompressedStreamWriterZstd::Compression Ratio = ezCompressedStreamWriterZstd::Compression::Default); // [tested]
+
+  /// \brief Prepares the dictionary for ezCompressedStreamReaderZstd::SetDictionary(). The data is copied.
+  ezResult InitializeForDecompression(ezArrayPtr<const ezUInt8> dictionary); // [tested]
+
+  /// \brief Releases the internal zstd structures.
+  void Clear();
+
+  /// \brief Returns the size of the dictionary data, as passed to the initialize functions.
+  ezUInt32 GetDictionarySize() const { return m_uiDictionarySize; }
+
+private:
+  friend class ezCompressedStreamReaderZstd;
+  friend class ezCompressedStreamWriterZstd;
+
+  ezUInt32 m_uiDictionarySize = 0;
+  /*ZSTD_CDict*/ void* m_pZstdCDict = nullptr;
+  /*ZSTD_DDict*/ void* m_pZstdDDict = nullptr;
+};
+
 #endif // BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
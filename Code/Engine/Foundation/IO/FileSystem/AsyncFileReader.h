@@ -0,0 +1,67 @@
+#pragma once
+
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Strings/String.h>
+#include <Foundation/Types/Delegate.h>
+#include <Foundation/Types/UniquePtr.h>
+
+struct ezAsyncFileReaderImpl;
+
+/// \brief The result of a read that was started with ezAsyncFileReader::ReadFile().
+struct ezAsyncFileReadResult
+{
+  ezUInt32 m_uiRequestID = 0;
+  ezString m_sFile;                 ///< The path that was passed to ReadFile()
+  ezResult m_Result = EZ_FAILURE;   ///< Fails if the file does not exist or could not be read completely
+  ezDynamicArray<ezUInt8> m_Data;   ///< The data that was read. The callback may move it somewhere else.
+};
+
+/// \brief Reads files through ezFileSystem without blocking the calling thread, with many reads in flight at the same time.
+///
+/// ReadFile() queues a read and returns immediately. Finished reads are reported through their callback, which is always called on
+/// the thread that calls Poll() or WaitForAll(), so it may freely start tasks or process the data right away.
+///
+/// Files that are stored as regular files on disk (see ezFileSystem::GetOSFilePath()) are read with the asynchronous I/O of the OS,
+/// which is io_uring on Linux. There a single thread keeps all reads in flight and large files are read in several pieces in parallel.
+/// Everything else (e.g. files in archives, or all files on platforms without support) is read through ezFileReader on
+/// long running worker tasks instead of the single file access thread, so those reads are done in parallel as well.
+///
+/// Only the data is read asynchronously, opening a file is still a blocking call on the calling thread. Files that are read directly
+/// from disk do not trigger ezFileSystem file events. An instance must only be used from one thread at a time.
+class EZ_FOUNDATION_DLL ezAsyncFileReader
+{
+  EZ_DISALLOW_COPY_AND_ASSIGN(ezAsyncFileReader);
+
+public:
+  using CompletionCallback = ezDelegate<void(ezAsyncFileReadResult& result)>;
+
+  /// \brief uiQueueDepth is the maximum number of pieces that the OS reads at the same time, for each instance.
+  ezAsyncFileReader(ezUInt32 uiQueueDepth = 64);
+
+  /// \brief Waits for all reads that are still in flight, but does not call their callbacks anymore.
+  ~ezAsyncFileReader();
+
+  /// \brief Starts reading up to uiMaxBytes of the given file, starting at uiOffset. Returns an ID that identifies the read in its result.
+  ///
+  /// The callback is called with the result from inside Poll() or WaitForAll(), also when the read failed.
+  /// Files larger than 4 GB have to be read in multiple parts.
+  ezUInt32 ReadFile(const char* szFile, const CompletionCallback& callback, ezUInt64 uiOffset = 0,
+    ezUInt64 uiMaxBytes = ezMath::MaxValue<ezUInt64>()); // [tested]
+
+  /// \brief Hands new pieces to the OS, if there is room for them, and calls the callbacks of all finished reads. Never blocks.
+  ///
+  /// Returns the number of reads that were finished.
+  ezUInt32 Poll(); // [tested]
+
+  /// \brief Blocks until all reads are finished and their callbacks were called.
+  void WaitForAll(); // [tested]
+
+  /// \brief Returns the number of reads whose callbacks were not called yet.
+  ezUInt32 GetNumPendingReads() const;
+
+  /// \brief Returns whether files on disk are read with the asynchronous I/O of the OS, otherwise all reads use worker tasks.
+  bool UsesOSAsyncIO() const;
+
+private:
+  ezUniquePtr<ezAsyncFileReaderImpl> m_pImpl;
+};
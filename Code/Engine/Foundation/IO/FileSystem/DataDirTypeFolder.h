@@ -49,6 +49,7 @@ namespace ezDataDirectory
     virtual void RemoveDataDirectory() override;
     virtual void DeleteFile(const char* szFile) override;
     virtual bool ExistsFile(const char* szFile, bool bOneSpecificDataDir) override;
+    virtual bool LocateFile(const char* szFile, bool bOneSpecificDataDir, ezStringBuilder& out_sOSFilePath) override;
     virtual ezResult GetFileStats(const char* szFileOrFolder, bool bOneSpecificDataDir, ezFileStats& out_Stats) override;
     virtual FolderReader* CreateFolderReader() const;
     virtual FolderWriter* CreateFolderWriter() const;
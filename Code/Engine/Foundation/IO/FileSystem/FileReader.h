@@ -18,6 +18,7 @@ public:
     : m_uiBytesCached(0)
     , m_uiCacheReadPosition(0)
     , m_bEOF(true)
+    , m_pMappedData(nullptr)
   {
   }
 
@@ -26,6 +27,9 @@ public:
 
   /// \brief Opens the given file for reading. Returns EZ_SUCCESS if the file could be opened. A cache is created to speed up small reads.
   ///
+  /// If the data directory keeps the file content in memory (see GetMappedData()), no cache is allocated and all reads copy directly
+  /// from that memory.
+  ///
   /// You should typically not disable bAllowFileEvents, unless you need to prevent recursive file events,
   /// which is only the case, if you are doing file accesses from within a File Event Handler.
   ezResult Open(const char* szFile, ezUInt32 uiCacheSize = 1024 * 64, ezFileShareMode::Enum FileShareMode = ezFileShareMode::Default,
@@ -37,9 +41,13 @@ public:
   /// \brief Attempts to read the given number of bytes into the buffer. Returns the actual number of bytes read.
   virtual ezUInt64 ReadBytes(void* pReadBuffer, ezUInt64 uiBytesToRead) override;
 
+  /// \brief Skips bytes in the file. Does not read the skipped data, if the file content is mapped.
+  virtual ezUInt64 SkipBytes(ezUInt64 uiBytesToSkip) override;
+
 private:
   ezUInt64 m_uiBytesCached;
   ezUInt64 m_uiCacheReadPosition;
   ezDynamicArray<ezUInt8> m_Cache;
   bool m_bEOF;
+  const ezUInt8* m_pMappedData; ///< If set, m_uiBytesCached is the file size and m_uiCacheReadPosition the read position in it
 };
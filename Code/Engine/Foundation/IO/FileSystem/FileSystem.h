@@ -4,6 +4,7 @@
 #include <Foundation/Containers/HybridArray.h>
 #include <Foundation/Containers/Map.h>
 #include <Foundation/IO/FileSystem/Implementation/DataDirType.h>
+#include <Foundation/Threading/AtomicInteger.h>
 #include <Foundation/Threading/Mutex.h>
 
 /// \brief The ezFileSystem provides high-level functionality to manage files in a virtual file system.
@@ -206,6 +207,20 @@ public:
   /// retrieving all data (e.g. GetFileStats on folders might not always work).
   static ezResult GetFileStats(const char* szFileOrFolder, ezFileStats& out_Stats);
 
+  /// \brief If the given file is read from a data directory that stores it as a regular file on disk, returns the absolute path to it.
+  ///
+  /// Fails if the file does not exist, or if its data directory has to be accessed through ezFileReader, e.g. because the file is
+  /// stored inside an archive. Used by ezAsyncFileReader to read files with the asynchronous I/O of the OS.
+  /// Note that reading a file directly from disk bypasses the ezFileSystem file events.
+  static ezResult GetOSFilePath(const char* szFile, ezStringBuilder& out_sAbsolutePath);
+
+  /// \brief Hints that the given file will be read soon. Data directories that support it (e.g. archives) then start bringing its data
+  /// into memory in the background.
+  ///
+  /// Does not block and does nothing for files that do not exist or data directories that don't support prefetching.
+  /// The data directories are called without holding the file system mutex, so concurrent file accesses are not delayed.
+  static void PrefetchFile(const char* szFile);
+
   /// \brief Tries to resolve the given path and returns the absolute and relative path to the final file.
   ///
   /// If the given path is a rooted path, for instance something like ":appdata/UserData.txt", (which is necessary for writing to files),
@@ -288,8 +303,14 @@ private:
 
     ezEvent<const FileEvent&, ezMutex> m_Event;
     ezMutex m_FsMutex;
+
+    // data directories that are currently called by PrefetchFile() without holding m_FsMutex
+    ezAtomicInteger32 m_iPrefetchesInFlight;
   };
 
+  /// \brief Waits until no PrefetchFile() call uses any data directory anymore. m_FsMutex must be locked, so that no new calls start.
+  static void WaitForPrefetches();
+
   /// \brief Returns a list of data directory categories that were embedded in the path.
   static const char* ExtractRootName(const char* szPath, ezString& rootName);
 
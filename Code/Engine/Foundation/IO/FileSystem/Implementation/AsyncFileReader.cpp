@@ -0,0 +1,429 @@
+#include <FoundationPCH.h>
+
+#include <Foundation/IO/FileSystem/AsyncFileReader.h>
+#include <Foundation/IO/FileSystem/FileSystem.h>
+#include <Foundation/IO/FileSystem/Implementation/FileReaderWriterBase.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Threading/TaskSystem.h>
+#include <errno.h>
+
+#if EZ_ENABLED(EZ_PLATFORM_LINUX)
+#  include <Foundation/IO/Implementation/Linux/AsyncFileIO_linux.h>
+#else
+/// \brief No asynchronous file I/O of the OS is used on this platform, all reads go through worker tasks.
+class ezAsyncFileIO
+{
+public:
+  ezResult Initialize(ezUInt32 uiQueueDepth) { return EZ_FAILURE; }
+  ezResult OpenFile(const char* szAbsolutePath, ezInt64& out_iFile, ezUInt64& out_uiFileSize) { return EZ_FAILURE; }
+  void CloseFile(ezInt64 iFile) {}
+  bool QueueRead(ezInt64 iFile, void* pBuffer, ezUInt32 uiBytes, ezUInt64 uiFileOffset, ezUInt64 uiUserData) { return false; }
+
+  template <typename Func>
+  ezUInt32 ProcessCompletions(bool bWait, Func&& func)
+  {
+    return 0;
+  }
+
+  ezUInt32 GetNumInFlight() const { return 0; }
+};
+#endif
+
+namespace
+{
+  // large files are split into pieces of this size, which are read in parallel
+  constexpr ezUInt32 s_uiAsyncReadPieceSize = 512 * 1024;
+
+  struct ezAsyncFileReadRequest
+  {
+    ezAsyncFileReadResult m_Result;
+    ezAsyncFileReader::CompletionCallback m_Callback;
+    ezUInt64 m_uiFileOffset = 0;
+    ezUInt64 m_uiMaxBytes = 0;
+
+    // reads through the OS
+    ezInt64 m_iFile = -1;
+    ezUInt32 m_uiNextPieceOffset = 0;
+    ezUInt32 m_uiNumPiecesInFlight = 0;
+    bool m_bFailed = false;
+
+    // reads through worker tasks
+    ezSharedPtr<ezTask> m_pTask;
+    ezTaskGroupID m_TaskGroup;
+  };
+
+  /// Reads straight from the data directory reader, ezFileReader would copy everything through its cache.
+  class ezAsyncFileReadStream : public ezFileReaderBase
+  {
+  public:
+    ~ezAsyncFileReadStream()
+    {
+      if (m_pDataDirReader != nullptr)
+        m_pDataDirReader->Close();
+    }
+
+    ezResult Open(const char* szFile)
+    {
+      m_pDataDirReader = GetFileReader(szFile, ezFileShareMode::SharedReads, true);
+      return m_pDataDirReader != nullptr ? EZ_SUCCESS : EZ_FAILURE;
+    }
+
+    virtual ezUInt64 ReadBytes(void* pReadBuffer, ezUInt64 uiBytesToRead) override
+    {
+      ezUInt64 uiBytesRead = 0;
+
+      while (uiBytesRead < uiBytesToRead)
+      {
+        const ezUInt64 uiRead = m_pDataDirReader->Read(ezMemoryUtils::AddByteOffset(pReadBuffer, static_cast<ptrdiff_t>(uiBytesRead)),
+          uiBytesToRead - uiBytesRead);
+
+        if (uiRead == 0)
+          break;
+
+        uiBytesRead += uiRead;
+      }
+
+      return uiBytesRead;
+    }
+  };
+
+  class ezAsyncFileReadTask final : public ezTask
+  {
+  public:
+    ezAsyncFileReadTask(ezAsyncFileReadRequest* pRequest)
+      : m_pRequest(pRequest)
+    {
+      ConfigureTask("Async File Read", ezTaskNesting::Never);
+    }
+
+    virtual void Execute() override
+    {
+      ezAsyncFileReadResult& result = m_pRequest->m_Result;
+
+      ezAsyncFileReadStream file;
+      if (file.Open(result.m_sFile).Failed())
+        return;
+
+      const ezUInt64 uiFileSize = file.GetFileSize();
+      const ezUInt64 uiOffset = ezMath::Min(m_pRequest->m_uiFileOffset, uiFileSize);
+      const ezUInt64 uiBytes = ezMath::Min(m_pRequest->m_uiMaxBytes, uiFileSize - uiOffset);
+
+      if (uiBytes > ezMath::MaxValue<ezUInt32>())
+      {
+        ezLog::Error("Cannot read {} of '{}' at once", ezArgFileSize(uiBytes), result.m_sFile);
+        return;
+      }
+
+      result.m_Data.SetCountUninitialized(static_cast<ezUInt32>(uiBytes));
+
+      // e.g. uncompressed files in archives
+      const ezArrayPtr<const ezUInt8> mappedData = file.GetMappedData();
+      if (!mappedData.IsEmpty())
+      {
+        ezMemoryUtils::Copy(result.m_Data.GetData(), mappedData.GetPtr() + uiOffset, static_cast<size_t>(uiBytes));
+        result.m_Result = EZ_SUCCESS;
+        return;
+      }
+
+      if (file.SkipBytes(uiOffset) != uiOffset || file.ReadBytes(result.m_Data.GetData(), uiBytes) != uiBytes)
+        return;
+
+      result.m_Result = EZ_SUCCESS;
+    }
+
+  private:
+    ezAsyncFileReadRequest* m_pRequest = nullptr;
+  };
+} // namespace
+
+struct ezAsyncFileReaderImpl
+{
+  /// Identifies the part of a request that one read of the OS fills. The index of a piece is the user data of the read.
+  struct Piece
+  {
+    ezAsyncFileReadRequest* m_pRequest = nullptr;
+    ezUInt32 m_uiOffset = 0;
+    ezUInt32 m_uiSize = 0;
+  };
+
+  ezAsyncFileIO m_OSFileIO;
+  bool m_bUseOSFileIO = false;
+
+  ezUInt32 m_uiNextRequestID = 0;
+  ezDynamicArray<ezUniquePtr<ezAsyncFileReadRequest>> m_Requests;
+  ezDynamicArray<ezAsyncFileReadRequest*> m_FinishedRequests;
+
+  ezDynamicArray<Piece> m_Pieces;
+  ezDynamicArray<ezUInt32> m_FreePieces;
+
+  bool StartOSRead(ezAsyncFileReadRequest& request, const char* szAbsolutePath)
+  {
+    ezUInt64 uiFileSize = 0;
+    if (m_OSFileIO.OpenFile(szAbsolutePath, request.m_iFile, uiFileSize).Failed())
+      return false;
+
+    const ezUInt64 uiOffset = ezMath::Min(request.m_uiFileOffset, uiFileSize);
+    const ezUInt64 uiBytes = ezMath::Min(request.m_uiMaxBytes, uiFileSize - uiOffset);
+
+    if (uiBytes > ezMath::MaxValue<ezUInt32>())
+    {
+      ezLog::Error("Cannot read {} of '{}' at once", ezArgFileSize(uiBytes), request.m_Result.m_sFile);
+      request.m_bFailed = true;
+    }
+    else
+    {
+      request.m_uiFileOffset = uiOffset;
+      request.m_Result.m_Data.SetCountUninitialized(static_cast<ezUInt32>(uiBytes));
+    }
+
+    if (request.m_bFailed || uiBytes == 0)
+    {
+      FinishOSRead(request);
+    }
+    else
+    {
+      QueuePieces();
+    }
+
+    return true;
+  }
+
+  void FinishOSRead(ezAsyncFileReadRequest& request)
+  {
+    m_OSFileIO.CloseFile(request.m_iFile);
+    request.m_iFile = -1;
+    request.m_Result.m_Result = request.m_bFailed ? EZ_FAILURE : EZ_SUCCESS;
+    m_FinishedRequests.PushBack(&request);
+  }
+
+  /// Queues as many pieces as the OS queue takes, in the order in which the files were requested.
+  void QueuePieces()
+  {
+    for (auto& pRequest : m_Requests)
+    {
+      ezAsyncFileReadRequest& request = *pRequest;
+
+      if (request.m_iFile < 0 || request.m_bFailed)
+        continue;
+
+      while (request.m_uiNextPieceOffset < request.m_Result.m_Data.GetCount())
+      {
+        const ezUInt32 uiSize = ezMath::Min(s_uiAsyncReadPieceSize, request.m_Result.m_Data.GetCount() - request.m_uiNextPieceOffset);
+
+        if (!QueuePiece(request, request.m_uiNextPieceOffset, uiSize))
+          return;
+
+        request.m_uiNextPieceOffset += uiSize;
+      }
+    }
+  }
+
+  bool QueuePiece(ezAsyncFileReadRequest& request, ezUInt32 uiOffset, ezUInt32 uiSize)
+  {
+    ezUInt32 uiPiece;
+    if (!m_FreePieces.IsEmpty())
+    {
+      uiPiece = m_FreePieces.PeekBack();
+      m_FreePieces.PopBack();
+    }
+    else
+    {
+      uiPiece = m_Pieces.GetCount();
+      m_Pieces.ExpandAndGetRef();
+    }
+
+    if (!m_OSFileIO.QueueRead(request.m_iFile, request.m_Result.m_Data.GetData() + uiOffset, uiSize, request.m_uiFileOffset + uiOffset, uiPiece))
+    {
+      m_FreePieces.PushBack(uiPiece);
+      return false;
+    }
+
+    Piece& piece = m_Pieces[uiPiece];
+    piece.m_pRequest = &request;
+    piece.m_uiOffset = uiOffset;
+    piece.m_uiSize = uiSize;
+
+    ++request.m_uiNumPiecesInFlight;
+    return true;
+  }
+
+  void OnPieceCompleted(ezUInt64 uiPiece, ezInt64 iResult)
+  {
+    Piece piece = m_Pieces[static_cast<ezUInt32>(uiPiece)];
+    m_FreePieces.PushBack(static_cast<ezUInt32>(uiPiece));
+
+    ezAsyncFileReadRequest& request = *piece.m_pRequest;
+    --request.m_uiNumPiecesInFlight;
+
+    if (iResult == -EAGAIN || iResult == -EINTR)
+    {
+      iResult = 0;
+    }
+    else if (iResult <= 0)
+    {
+      // an error, or the file got shorter in the meantime
+      request.m_bFailed = true;
+    }
+
+    // a short read, read the rest in a new piece
+    if (!request.m_bFailed && static_cast<ezUInt64>(iResult) < piece.m_uiSize)
+    {
+      const ezUInt32 uiRead = static_cast<ezUInt32>(iResult);
+      EZ_VERIFY(QueuePiece(request, piece.m_uiOffset + uiRead, piece.m_uiSize - uiRead), "A slot in the queue was just freed");
+      return;
+    }
+
+    // the buffer must stay valid until no more reads are in flight
+    if (request.m_uiNumPiecesInFlight == 0 && (request.m_bFailed || request.m_uiNextPieceOffset == request.m_Result.m_Data.GetCount()))
+    {
+      FinishOSRead(request);
+    }
+  }
+
+  void ProcessOSReads(bool bWait)
+  {
+    if (!m_bUseOSFileIO)
+      return;
+
+    QueuePieces();
+    m_OSFileIO.ProcessCompletions(bWait, [this](ezUInt64 uiPiece, ezInt64 iResult) { OnPieceCompleted(uiPiece, iResult); });
+    QueuePieces();
+  }
+
+  void ProcessTaskReads(bool bWait)
+  {
+    for (auto& pRequest : m_Requests)
+    {
+      ezAsyncFileReadRequest& request = *pRequest;
+
+      if (request.m_pTask == nullptr)
+        continue;
+
+      if (!ezTaskSystem::IsTaskGroupFinished(request.m_TaskGroup))
+      {
+        if (!bWait)
+          continue;
+
+        ezTaskSystem::WaitForGroup(request.m_TaskGroup);
+      }
+
+      request.m_pTask = nullptr;
+      m_FinishedRequests.PushBack(&request);
+    }
+  }
+
+  ezUInt32 CallCallbacks(bool bCallCallbacks)
+  {
+    // take the finished requests out first, a callback may start new reads
+    ezHybridArray<ezUniquePtr<ezAsyncFileReadRequest>, 16> finishedRequests;
+
+    for (ezAsyncFileReadRequest* pFinished : m_FinishedRequests)
+    {
+      for (ezUInt32 i = 0; i < m_Requests.GetCount(); ++i)
+      {
+        if (m_Requests[i].Borrow() == pFinished)
+        {
+          finishedRequests.PushBack(std::move(m_Requests[i]));
+          m_Requests.RemoveAtAndCopy(i);
+          break;
+        }
+      }
+    }
+
+    m_FinishedRequests.Clear();
+
+    if (bCallCallbacks)
+    {
+      for (auto& pRequest : finishedRequests)
+      {
+        if (pRequest->m_Callback.IsValid())
+        {
+          pRequest->m_Callback(pRequest->m_Result);
+        }
+      }
+    }
+
+    return finishedRequests.GetCount();
+  }
+
+  ezUInt32 Poll(bool bWait, bool bCallCallbacks)
+  {
+    // with OS reads in flight, tasks are only checked without waiting, so that neither kind of read waits for the other
+    const bool bWaitForOSReads = bWait && m_OSFileIO.GetNumInFlight() > 0;
+
+    ProcessOSReads(bWaitForOSReads);
+    ProcessTaskReads(bWait && !bWaitForOSReads);
+
+    return CallCallbacks(bCallCallbacks);
+  }
+};
+
+ezAsyncFileReader::ezAsyncFileReader(ezUInt32 uiQueueDepth /*= 64*/)
+{
+  m_pImpl = EZ_DEFAULT_NEW(ezAsyncFileReaderImpl);
+  m_pImpl->m_bUseOSFileIO = m_pImpl->m_OSFileIO.Initialize(ezMath::Clamp(uiQueueDepth, 1u, 4096u)).Succeeded();
+}
+
+ezAsyncFileReader::~ezAsyncFileReader()
+{
+  // the OS and the tasks write into the buffers of the requests
+  while (!m_pImpl->m_Requests.IsEmpty())
+  {
+    m_pImpl->Poll(true, false);
+  }
+}
+
+ezUInt32 ezAsyncFileReader::ReadFile(
+  const char* szFile, const CompletionCallback& callback, ezUInt64 uiOffset /*= 0*/, ezUInt64 uiMaxBytes /*= ezMath::MaxValue<ezUInt64>()*/)
+{
+  ezUniquePtr<ezAsyncFileReadRequest> pNewRequest = EZ_DEFAULT_NEW(ezAsyncFileReadRequest);
+  ezAsyncFileReadRequest& request = *pNewRequest;
+  m_pImpl->m_Requests.PushBack(std::move(pNewRequest));
+
+  request.m_Result.m_uiRequestID = ++m_pImpl->m_uiNextRequestID;
+  request.m_Result.m_sFile = szFile;
+  request.m_Callback = callback;
+  request.m_uiFileOffset = uiOffset;
+  request.m_uiMaxBytes = uiMaxBytes;
+
+  if (m_pImpl->m_bUseOSFileIO)
+  {
+    ezStringBuilder sAbsolutePath;
+    if (ezFileSystem::GetOSFilePath(szFile, sAbsolutePath).Succeeded() && m_pImpl->StartOSRead(request, sAbsolutePath))
+    {
+      // hand the first pieces to the OS right away
+      m_pImpl->ProcessOSReads(false);
+      return request.m_Result.m_uiRequestID;
+    }
+  }
+
+  request.m_pTask = EZ_DEFAULT_NEW(ezAsyncFileReadTask, &request);
+  request.m_TaskGroup = ezTaskSystem::StartSingleTask(request.m_pTask, ezTaskPriority::LongRunning);
+
+  return request.m_Result.m_uiRequestID;
+}
+
+ezUInt32 ezAsyncFileReader::Poll()
+{
+  return m_pImpl->Poll(false, true);
+}
+
+void ezAsyncFileReader::WaitForAll()
+{
+  while (!m_pImpl->m_Requests.IsEmpty())
+  {
+    m_pImpl->Poll(true, true);
+  }
+}
+
+ezUInt32 ezAsyncFileReader::GetNumPendingReads() const
+{
+  return m_pImpl->m_Requests.GetCount();
+}
+
+bool ezAsyncFileReader::UsesOSAsyncIO() const
+{
+  return m_pImpl->m_bUseOSFileIO;
+}
+
+EZ_STATICLINK_FILE(Foundation, Foundation_IO_FileSystem_Implementation_AsyncFileReader);
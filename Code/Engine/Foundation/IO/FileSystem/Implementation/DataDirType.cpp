@@ -25,6 +25,12 @@ bool ezDataDirectoryType::ExistsFile(const char* szFile, bool bOneSpecificDataDi
   return ezOSFile::ExistsFile(sPath);
 }
 
+bool ezDataDirectoryType::LocateFile(const char* szFile, bool bOneSpecificDataDir, ezStringBuilder& out_sOSFilePath)
+{
+  out_sOSFilePath.Clear();
+  return ExistsFile(szFile, bOneSpecificDataDir);
+}
+
 void ezDataDirectoryReaderWriterBase::Close()
 {
   InternalClose();
@@ -3,6 +3,7 @@
 #include <Foundation/Basics.h>
 #include <Foundation/IO/FileEnums.h>
 #include <Foundation/Strings/String.h>
+#include <Foundation/Types/ArrayPtr.h>
 
 class ezDataDirectoryReaderWriterBase;
 class ezDataDirectoryReader;
@@ -75,9 +76,23 @@ protected:
   /// An optimized implementation might look this information up in some hash-map.
   virtual bool ExistsFile(const char* szFile, bool bOneSpecificDataDir);
 
+  /// \brief Checks whether the given file exists in this data directory and whether it is stored as a regular file on disk.
+  ///
+  /// If it is, out_sOSFilePath is set to the absolute path of that file, so that it can be read with the asynchronous I/O of the OS
+  /// (see ezAsyncFileReader). Otherwise out_sOSFilePath is cleared and the file can only be read through OpenFileToRead().
+  /// The default implementation calls ExistsFile() and never returns a path.
+  virtual bool LocateFile(const char* szFile, bool bOneSpecificDataDir, ezStringBuilder& out_sOSFilePath);
+
   /// \brief Upon success returns the ezFileStats for a file in this data directory.
   virtual ezResult GetFileStats(const char* szFileOrFolder, bool bOneSpecificDataDir, ezFileStats& out_Stats) = 0;
 
+  /// \brief Hints that the given file will be opened soon, so that its data can already be brought into memory in the background.
+  ///
+  /// Returns true if this data directory took care of the file, then ezFileSystem::PrefetchFile() does not ask any data directories
+  /// with lower priority. Must not block and must not call into ezFileSystem, it is called without holding the file system mutex.
+  /// The default implementation does nothing and returns false.
+  virtual bool PrefetchFile(const char* szFile, bool bOneSpecificDataDir) { return false; }
+
   /// \brief If this data directory knows how to redirect the given path, it should do so and return true.
   /// Called by ezFileSystem::ResolveAssetRedirection
   virtual bool ResolveAssetRedirection(const char* szPathOrAssetGuid, ezStringBuilder& out_sRedirection) { return false; }
@@ -163,6 +178,12 @@ public:
   }
 
   virtual ezUInt64 Read(void* pBuffer, ezUInt64 uiBytes) = 0;
+
+  /// \brief If the entire file content is accessible in memory (e.g. an uncompressed entry in a memory mapped archive), returns it.
+  ///
+  /// Readers can then access the data directly instead of copying it through Read(). Returns an empty array, if that is not possible.
+  /// The memory stays valid until the reader is closed.
+  virtual ezArrayPtr<const ezUInt8> GetMappedData() const { return ezArrayPtr<const ezUInt8>(); }
 };
 
 /// \brief A base class for writers that handle writing to a (virtual) file inside a data directory.
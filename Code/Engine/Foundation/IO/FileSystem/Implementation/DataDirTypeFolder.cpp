@@ -169,6 +169,21 @@ namespace ezDataDirectory
     return ezOSFile::ExistsFile(sPath);
   }
 
+  bool FolderType::LocateFile(const char* szFile, bool bOneSpecificDataDir, ezStringBuilder& out_sOSFilePath)
+  {
+    ezStringBuilder sRedirectedAsset;
+    ResolveAssetRedirection(szFile, sRedirectedAsset);
+
+    out_sOSFilePath = GetRedirectedDataDirectoryPath();
+    out_sOSFilePath.AppendPath(sRedirectedAsset);
+
+    if (ezOSFile::ExistsFile(out_sOSFilePath))
+      return true;
+
+    out_sOSFilePath.Clear();
+    return false;
+  }
+
   ezResult FolderType::GetFileStats(const char* szFileOrFolder, bool bOneSpecificDataDir, ezFileStats& out_Stats)
   {
     ezStringBuilder sRedirectedAsset;
@@ -14,6 +14,16 @@ ezResult ezFileReader::Open(const char* szFile, ezUInt32 uiCacheSize /*= 1024 *
   if (!m_pDataDirReader)
     return EZ_FAILURE;
 
+  const ezArrayPtr<const ezUInt8> mappedData = m_pDataDirReader->GetMappedData();
+  if (!mappedData.IsEmpty())
+  {
+    m_pMappedData = mappedData.GetPtr();
+    m_uiBytesCached = mappedData.GetCount();
+    m_uiCacheReadPosition = 0;
+    m_bEOF = false;
+    return EZ_SUCCESS;
+  }
+
   m_Cache.SetCountUninitialized(uiCacheSize);
 
   m_uiCacheReadPosition = 0;
@@ -29,6 +39,7 @@ void ezFileReader::Close()
     m_pDataDirReader->Close();
 
   m_pDataDirReader = nullptr;
+  m_pMappedData = nullptr;
   m_bEOF = true;
 }
 
@@ -38,6 +49,15 @@ ezUInt64 ezFileReader::ReadBytes(void* pReadBuffer, ezUInt64 uiBytesToRead)
   if (m_bEOF)
     return 0;
 
+  if (m_pMappedData != nullptr)
+  {
+    const ezUInt64 uiChunkSize = ezMath::Min(uiBytesToRead, m_uiBytesCached - m_uiCacheReadPosition);
+    ezMemoryUtils::Copy(static_cast<ezUInt8*>(pReadBuffer), m_pMappedData + m_uiCacheReadPosition, static_cast<size_t>(uiChunkSize));
+    m_uiCacheReadPosition += uiChunkSize;
+    m_bEOF = m_uiCacheReadPosition >= m_uiBytesCached;
+    return uiChunkSize;
+  }
+
   ezUInt64 uiBufferPosition = 0; // how much was read, yet
   ezUInt8* pBuffer = (ezUInt8*)pReadBuffer;
 
@@ -83,6 +103,22 @@ ezUInt64 ezFileReader::ReadBytes(void* pReadBuffer, ezUInt64 uiBytesToRead)
   return uiBufferPosition;
 }
 
+ezUInt64 ezFileReader::SkipBytes(ezUInt64 uiBytesToSkip)
+{
+  EZ_ASSERT_DEV(m_pDataDirReader != nullptr, "The file has not been opened (successfully).");
+
+  if (m_pMappedData == nullptr)
+    return ezFileReaderBase::SkipBytes(uiBytesToSkip);
+
+  if (m_bEOF)
+    return 0;
+
+  const ezUInt64 uiSkipped = ezMath::Min(uiBytesToSkip, m_uiBytesCached - m_uiCacheReadPosition);
+  m_uiCacheReadPosition += uiSkipped;
+  m_bEOF = m_uiCacheReadPosition >= m_uiBytesCached;
+  return uiSkipped;
+}
+
 
 
 EZ_STATICLINK_FILE(Foundation, Foundation_IO_FileSystem_Implementation_FileReader);
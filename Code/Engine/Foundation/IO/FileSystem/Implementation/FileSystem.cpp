@@ -4,6 +4,8 @@
 #include <Foundation/IO/FileSystem/FileSystem.h>
 #include <Foundation/IO/OSFile.h>
 #include <Foundation/Logging/Log.h>
+#include <Foundation/Threading/ThreadUtils.h>
+#include <Foundation/Types/ScopeExit.h>
 
 // clang-format off
 EZ_BEGIN_SUBSYSTEM_DECLARATION(Foundation, FileSystem)
@@ -165,6 +167,8 @@ bool ezFileSystem::RemoveDataDirectory(const char* szRootName)
         s_Data->m_Event.Broadcast(fe);
       }
 
+      WaitForPrefetches();
+
       s_Data->m_DataDirectories[i].m_pDataDirectory->RemoveDataDirectory();
       s_Data->m_DataDirectories.RemoveAtAndCopy(i);
 
@@ -201,6 +205,8 @@ ezUInt32 ezFileSystem::RemoveDataDirectoryGroup(const char* szGroup)
 
       ++uiRemoved;
 
+      WaitForPrefetches();
+
       s_Data->m_DataDirectories[i].m_pDataDirectory->RemoveDataDirectory();
       s_Data->m_DataDirectories.RemoveAtAndCopy(i);
     }
@@ -217,6 +223,8 @@ void ezFileSystem::ClearAllDataDirectories()
 
   EZ_LOCK(s_Data->m_FsMutex);
 
+  WaitForPrefetches();
+
   for (ezInt32 i = s_Data->m_DataDirectories.GetCount() - 1; i >= 0; --i)
   {
     {
@@ -394,6 +402,84 @@ bool ezFileSystem::ExistsFile(const char* szFile)
   return false;
 }
 
+ezResult ezFileSystem::GetOSFilePath(const char* szFile, ezStringBuilder& out_sAbsolutePath)
+{
+  EZ_ASSERT_DEV(s_Data != nullptr, "FileSystem is not initialized.");
+
+  ezString sRootName;
+  szFile = ExtractRootName(szFile, sRootName);
+
+  const bool bOneSpecificDataDir = !sRootName.IsEmpty();
+
+  EZ_LOCK(s_Data->m_FsMutex);
+
+  for (ezInt32 i = (ezInt32)s_Data->m_DataDirectories.GetCount() - 1; i >= 0; --i)
+  {
+    if (!sRootName.IsEmpty() && s_Data->m_DataDirectories[i].m_sRootName != sRootName)
+      continue;
+
+    const char* szRelPath = GetDataDirRelativePath(szFile, i);
+
+    // the first data directory that contains the file decides how it has to be read
+    if (s_Data->m_DataDirectories[i].m_pDataDirectory->LocateFile(szRelPath, bOneSpecificDataDir, out_sAbsolutePath))
+      return out_sAbsolutePath.IsEmpty() ? EZ_FAILURE : EZ_SUCCESS;
+  }
+
+  out_sAbsolutePath.Clear();
+  return EZ_FAILURE;
+}
+
+void ezFileSystem::PrefetchFile(const char* szFile)
+{
+  EZ_ASSERT_DEV(s_Data != nullptr, "FileSystem is not initialized.");
+
+  ezString sRootName;
+  szFile = ExtractRootName(szFile, sRootName);
+
+  const bool bOneSpecificDataDir = !sRootName.IsEmpty();
+
+  struct Candidate
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezDataDirectoryType* m_pDataDirectory;
+    const char* m_szRelPath;
+  };
+
+  ezHybridArray<Candidate, 16> candidates;
+
+  {
+    EZ_LOCK(s_Data->m_FsMutex);
+
+    for (ezInt32 i = (ezInt32)s_Data->m_DataDirectories.GetCount() - 1; i >= 0; --i)
+    {
+      if (!sRootName.IsEmpty() && s_Data->m_DataDirectories[i].m_sRootName != sRootName)
+        continue;
+
+      candidates.PushBack({s_Data->m_DataDirectories[i].m_pDataDirectory, GetDataDirRelativePath(szFile, i)});
+    }
+
+    // the data directories must not be removed while they are used below, see WaitForPrefetches()
+    s_Data->m_iPrefetchesInFlight.Increment();
+  }
+
+  EZ_SCOPE_EXIT(s_Data->m_iPrefetchesInFlight.Decrement());
+
+  for (const Candidate& candidate : candidates)
+  {
+    // the first data directory that takes care of the file is also the one that will be used for reading it
+    if (candidate.m_pDataDirectory->PrefetchFile(candidate.m_szRelPath, bOneSpecificDataDir))
+      return;
+  }
+}
+
+void ezFileSystem::WaitForPrefetches()
+{
+  while (s_Data->m_iPrefetchesInFlight > 0)
+  {
+    ezThreadUtils::YieldTimeSlice();
+  }
+}
 
 ezResult ezFileSystem::GetFileStats(const char* szFileOrFolder, ezFileStats& out_Stats)
 {
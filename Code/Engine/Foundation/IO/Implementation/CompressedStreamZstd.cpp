@@ -37,6 +37,16 @@ void ezCompressedStreamReaderZstd::SetInputStream(ezStreamReader* pInputStream)
   ZSTD_initDStream(reinterpret_cast<ZSTD_DStream*>(m_pZstdDStream));
 }
 
+void ezCompressedStreamReaderZstd::SetDictionary(const ezCompressedStreamZstdDictionary* pDictionary)
+{
+  EZ_ASSERT_DEV(m_pZstdDStream != nullptr, "SetInputStream() has to be called before SetDictionary()");
+  EZ_ASSERT_DEV(pDictionary == nullptr || pDictionary->m_pZstdDDict != nullptr, "The dictionary was not initialized for decompression");
+
+  const size_t res = ZSTD_DCtx_refDDict(
+    reinterpret_cast<ZSTD_DStream*>(m_pZstdDStream), pDictionary != nullptr ? reinterpret_cast<const ZSTD_DDict*>(pDictionary->m_pZstdDDict) : nullptr);
+  EZ_VERIFY(!ZSTD_isError(res), "Setting the zstd decompression dictionary failed: '{0}'", ZSTD_getErrorName(res));
+}
+
 ezUInt64 ezCompressedStreamReaderZstd::ReadBytes(void* pReadBuffer, ezUInt64 uiBytesToRead)
 {
   EZ_ASSERT_DEV(m_pInputStream != nullptr, "No input stream has been specified");
@@ -193,6 +203,17 @@ void ezCompressedStreamWriterZstd::SetOutputStream(
   }
 }
 
+void ezCompressedStreamWriterZstd::SetDictionary(const ezCompressedStreamZstdDictionary* pDictionary)
+{
+  EZ_ASSERT_DEV(m_pOutputStream != nullptr, "SetOutputStream() has to be called before SetDictionary()");
+  EZ_ASSERT_DEV(m_uiUncompressedSize == 0, "SetDictionary() has to be called before writing any data");
+  EZ_ASSERT_DEV(pDictionary == nullptr || pDictionary->m_pZstdCDict != nullptr, "The dictionary was not initialized for compression");
+
+  const size_t res = ZSTD_CCtx_refCDict(
+    reinterpret_cast<ZSTD_CStream*>(m_pZstdCStream), pDictionary != nullptr ? reinterpret_cast<const ZSTD_CDict*>(pDictionary->m_pZstdCDict) : nullptr);
+  EZ_VERIFY(!ZSTD_isError(res), "Setting the zstd compression dictionary failed: '{0}'", ZSTD_getErrorName(res));
+}
+
 ezResult ezCompressedStreamWriterZstd::FinishCompressedStream()
 {
   if (m_pOutputStream == nullptr)
@@ -289,6 +310,61 @@ ezResult ezCompressedStreamWriterZstd::WriteBytes(const void* pWriteBuffer, ezUI
   return EZ_SUCCESS;
 }
 
+//////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////
+
+ezCompressedStreamZstdDictionary::ezCompressedStreamZstdDictionary() = default;
+
+ezCompressedStreamZstdDictionary::~ezCompressedStreamZstdDictionary()
+{
+  Clear();
+}
+
+ezResult ezCompressedStreamZstdDictionary::InitializeForCompression(
+  ezArrayPtr<const ezUInt8> dictionary, ezCompressedStreamWriterZstd::Compression Ratio /*= ezCompressedStreamWriterZstd::Compression::Default*/)
+{
+  Clear();
+
+  m_pZstdCDict = ZSTD_createCDict(dictionary.GetPtr(), dictionary.GetCount(), (int)Ratio);
+  if (m_pZstdCDict == nullptr)
+    return EZ_FAILURE;
+
+  m_uiDictionarySize = dictionary.GetCount();
+  return EZ_SUCCESS;
+}
+
+ezResult ezCompressedStreamZstdDictionary::InitializeForDecompression(ezArrayPtr<const ezUInt8> dictionary)
+{
+  Clear();
+
+  m_pZstdDDict = ZSTD_createDDict(dictionary.GetPtr(), dictionary.GetCount());
+  if (m_pZstdDDict == nullptr)
+    return EZ_FAILURE;
+
+  m_uiDictionarySize = dictionary.GetCount();
+  return EZ_SUCCESS;
+}
+
+void ezCompressedStreamZstdDictionary::Clear()
+{
+  if (m_pZstdCDict != nullptr)
+  {
+    ZSTD_freeCDict(reinterpret_cast<ZSTD_CDict*>(m_pZstdCDict));
+    m_pZstdCDict = nullptr;
+  }
+
+  if (m_pZstdDDict != nullptr)
+  {
+    ZSTD_freeDDict(reinterpret_cast<ZSTD_DDict*>(m_pZstdDDict));
+    m_pZstdDDict = nullptr;
+  }
+
+  m_uiDictionarySize = 0;
+}
+
 #endif
 
 
@@ -1,5 +1,6 @@
 #include <FoundationPCH.h>
 
+#include <Foundation/IO/Implementation/TextScanning.h>
 #include <Foundation/IO/JSONParser.h>
 #include <Foundation/Logging/Log.h>
 #include <Foundation/Utilities/ConversionUtils.h>
@@ -9,6 +10,8 @@ ezJSONParser::ezJSONParser()
   m_uiCurByte = '\0';
   m_uiNextByte = '\0';
   m_pInput = nullptr;
+  m_pInputCur = nullptr;
+  m_pInputEnd = nullptr;
   m_bSkippingMode = false;
   m_pLogInterface = nullptr;
   m_uiCurLine = 1;
@@ -16,6 +19,28 @@ ezJSONParser::ezJSONParser()
 }
 
 void ezJSONParser::SetInputStream(ezStreamReader& stream, ezUInt32 uiFirstLineOffset)
+{
+  m_pInput = &stream;
+  m_InputBuffer.SetCountUninitialized(16 * 1024);
+  m_pInputCur = m_InputBuffer.GetData();
+  m_pInputEnd = m_InputBuffer.GetData();
+
+  StartInput(uiFirstLineOffset);
+}
+
+void ezJSONParser::SetInputMemory(ezArrayPtr<const ezUInt8> data, ezUInt32 uiFirstLineOffset)
+{
+  // empty input must not look like a parser that was never set up
+  static const ezUInt8 s_EmptyInput = 0;
+
+  m_pInput = nullptr;
+  m_pInputCur = data.IsEmpty() ? &s_EmptyInput : data.GetPtr();
+  m_pInputEnd = m_pInputCur + data.GetCount();
+
+  StartInput(uiFirstLineOffset);
+}
+
+void ezJSONParser::StartInput(ezUInt32 uiFirstLineOffset)
 {
   m_StateStack.Clear();
   m_uiCurByte = '\0';
@@ -24,8 +49,6 @@ void ezJSONParser::SetInputStream(ezStreamReader& stream, ezUInt32 uiFirstLineOf
   m_uiCurLine = 1 + uiFirstLineOffset;
   m_uiCurColumn = 0;
 
-  m_pInput = &stream;
-
   m_uiNextByte = ' ';
   ReadCharacter(true);
 
@@ -457,9 +480,30 @@ void ezJSONParser::ContinueSeparator()
   }
 }
 
-void ezJSONParser::ReadNextByte()
+bool ezJSONParser::RefillInput()
 {
-  m_pInput->ReadBytes(&m_uiNextByte, sizeof(ezUInt8));
+  if (m_pInput == nullptr)
+    return false;
+
+  const ezUInt64 uiRead = m_pInput->ReadBytes(m_InputBuffer.GetData(), m_InputBuffer.GetCount());
+
+  m_pInputCur = m_InputBuffer.GetData();
+  m_pInputEnd = m_InputBuffer.GetData() + uiRead;
+
+  return uiRead > 0;
+}
+
+EZ_FORCE_INLINE void ezJSONParser::ReadNextByte()
+{
+  if (m_pInputCur != m_pInputEnd || RefillInput())
+  {
+    m_uiNextByte = *m_pInputCur;
+    ++m_pInputCur;
+  }
+  else
+  {
+    m_uiNextByte = '\0';
+  }
 
   if (m_uiNextByte == '\n')
   {
@@ -517,10 +561,34 @@ bool ezJSONParser::ReadCharacter(bool bSkipComments)
 
 void ezJSONParser::SkipWhitespace()
 {
-  EZ_ASSERT_DEBUG(m_pInput != nullptr, "Input Stream is not set up.");
+  EZ_ASSERT_DEBUG(m_pInputEnd != nullptr, "Input Stream is not set up.");
 
   do
   {
+    // skip all whitespace that follows the next byte at once, the last one of them becomes the next byte
+    if (m_uiNextByte >= 1 && m_uiNextByte <= 32)
+    {
+      ezUInt32 uiNumNewLines = 0;
+      ezUInt32 uiLastNewLine = 0;
+      const ezUInt32 uiNumWhitespace = ezTextScanning::CountWhitespaceBytes(m_pInputCur, m_pInputEnd, uiNumNewLines, uiLastNewLine);
+
+      if (uiNumWhitespace > 0)
+      {
+        m_pInputCur += uiNumWhitespace;
+        m_uiNextByte = m_pInputCur[-1];
+
+        if (uiNumNewLines > 0)
+        {
+          m_uiCurLine += uiNumNewLines;
+          m_uiCurColumn = uiNumWhitespace - 1 - uiLastNewLine;
+        }
+        else
+        {
+          m_uiCurColumn += uiNumWhitespace;
+        }
+      }
+    }
+
     m_uiCurByte = '\0';
 
     if (!ReadCharacter(true))
@@ -530,7 +598,7 @@ void ezJSONParser::SkipWhitespace()
 
 void ezJSONParser::SkipString()
 {
-  EZ_ASSERT_DEBUG(m_pInput != nullptr, "Input Stream is not set up.");
+  EZ_ASSERT_DEBUG(m_pInputEnd != nullptr, "Input Stream is not set up.");
 
   m_TempString.Clear();
   m_TempString.PushBack('\0');
@@ -554,7 +622,7 @@ void ezJSONParser::SkipString()
 
 void ezJSONParser::ReadString()
 {
-  EZ_ASSERT_DEBUG(m_pInput != nullptr, "Input Stream is not set up.");
+  EZ_ASSERT_DEBUG(m_pInputEnd != nullptr, "Input Stream is not set up.");
 
   m_TempString.Clear();
 
@@ -562,6 +630,11 @@ void ezJSONParser::ReadString()
 
   while (true)
   {
+    if (m_uiCurByte != '\\' && m_uiNextByte != '\"' && m_uiNextByte != '\\' && m_uiNextByte != '\n' && m_uiNextByte != '\0')
+    {
+      AppendPlainStringBytes();
+    }
+
     bEscapeSequence = (m_uiCurByte == '\\');
 
     m_uiCurByte = '\0';
@@ -676,9 +749,24 @@ void ezJSONParser::ReadString()
   m_TempString.PushBack('\0');
 }
 
+void ezJSONParser::AppendPlainStringBytes()
+{
+  // m_uiNextByte is the first of the plain characters, copy it together with all that follow in the input buffer
+  const ezUInt8* pStart = m_pInputCur - 1;
+  const ezUInt32 uiLength = 1 + ezTextScanning::CountPlainStringBytes(m_pInputCur, m_pInputEnd);
+
+  m_TempString.PushBackRange(ezArrayPtr<const ezUInt8>(pStart, uiLength));
+
+  // the last copied character becomes the current one, none of them is a line break
+  m_pInputCur = pStart + uiLength;
+  m_uiCurColumn += uiLength - 1;
+  m_uiCurByte = m_pInputCur[-1];
+  ReadNextByte();
+}
+
 void ezJSONParser::ReadWord()
 {
-  EZ_ASSERT_DEBUG(m_pInput != nullptr, "Input Stream is not set up.");
+  EZ_ASSERT_DEBUG(m_pInputEnd != nullptr, "Input Stream is not set up.");
 
   m_TempString.Clear();
 
@@ -697,7 +785,7 @@ void ezJSONParser::ReadWord()
 
 double ezJSONParser::ReadNumber()
 {
-  EZ_ASSERT_DEBUG(m_pInput != nullptr, "Input Stream is not set up.");
+  EZ_ASSERT_DEBUG(m_pInputEnd != nullptr, "Input Stream is not set up.");
 
   m_TempString.Clear();
 
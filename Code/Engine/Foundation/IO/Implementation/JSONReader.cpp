@@ -16,6 +16,22 @@ ezResult ezJSONReader::Parse(ezStreamReader& InputStream, ezUInt32 uiFirstLineOf
 
   SetInputStream(InputStream, uiFirstLineOffset);
 
+  return ParseInput();
+}
+
+ezResult ezJSONReader::Parse(ezArrayPtr<const ezUInt8> data, ezUInt32 uiFirstLineOffset)
+{
+  m_bParsingError = false;
+  m_Stack.Clear();
+  m_sLastName.Clear();
+
+  SetInputMemory(data, uiFirstLineOffset);
+
+  return ParseInput();
+}
+
+ezResult ezJSONReader::ParseInput()
+{
   while (!m_bParsingError && ContinueParsing())
   {
   }
@@ -0,0 +1,229 @@
+#include <Foundation/FoundationPCH.h>
+EZ_FOUNDATION_INTERNAL_HEADER
+
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+/// \brief Reads files with io_uring, used by ezAsyncFileReader.
+///
+/// Only uses the raw system calls, so liburing is not needed. All functions must be called from the same thread.
+class ezAsyncFileIO
+{
+public:
+  ezAsyncFileIO() = default;
+  ~ezAsyncFileIO() { Deinitialize(); }
+
+  /// \brief Fails if io_uring is not available, e.g. because the kernel is too old or a sandbox blocks it.
+  ezResult Initialize(ezUInt32 uiQueueDepth)
+  {
+    io_uring_params params;
+    ezMemoryUtils::ZeroFill(&params, 1);
+
+    m_iRing = static_cast<int>(syscall(__NR_io_uring_setup, uiQueueDepth, &params));
+    if (m_iRing < 0)
+    {
+      m_iRing = -1;
+      return EZ_FAILURE;
+    }
+
+    // IORING_OP_READ was added in the same kernel version (5.6) as this feature flag
+    if ((params.features & IORING_FEAT_RW_CUR_POS) == 0)
+    {
+      Deinitialize();
+      return EZ_FAILURE;
+    }
+
+    m_uiSqRingSize = params.sq_off.array + params.sq_entries * sizeof(ezUInt32);
+    m_uiCqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    m_uiSqesSize = params.sq_entries * sizeof(io_uring_sqe);
+
+    // newer kernels map both rings with a single mmap
+    const bool bSingleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (bSingleMap)
+    {
+      m_uiSqRingSize = ezMath::Max(m_uiSqRingSize, m_uiCqRingSize);
+    }
+
+    m_pSqRing = Map(m_uiSqRingSize, IORING_OFF_SQ_RING);
+    m_pCqRing = bSingleMap ? m_pSqRing : Map(m_uiCqRingSize, IORING_OFF_CQ_RING);
+    m_pSqes = static_cast<io_uring_sqe*>(Map(m_uiSqesSize, IORING_OFF_SQES));
+
+    if (m_pSqRing == nullptr || m_pCqRing == nullptr || m_pSqes == nullptr)
+    {
+      Deinitialize();
+      return EZ_FAILURE;
+    }
+
+    ezUInt8* pSq = static_cast<ezUInt8*>(m_pSqRing);
+    m_pSqTail = reinterpret_cast<ezUInt32*>(pSq + params.sq_off.tail);
+    m_pSqArray = reinterpret_cast<ezUInt32*>(pSq + params.sq_off.array);
+    m_uiSqMask = *reinterpret_cast<ezUInt32*>(pSq + params.sq_off.ring_mask);
+
+    ezUInt8* pCq = static_cast<ezUInt8*>(m_pCqRing);
+    m_pCqHead = reinterpret_cast<ezUInt32*>(pCq + params.cq_off.head);
+    m_pCqTail = reinterpret_cast<ezUInt32*>(pCq + params.cq_off.tail);
+    m_pCqes = reinterpret_cast<io_uring_cqe*>(pCq + params.cq_off.cqes);
+    m_uiCqMask = *reinterpret_cast<ezUInt32*>(pCq + params.cq_off.ring_mask);
+
+    // the completion queue is twice as large, so as long as no more reads are in flight than the submission queue has entries,
+    // neither queue can overflow
+    m_uiMaxInFlight = ezMath::Min(uiQueueDepth, params.sq_entries);
+    return EZ_SUCCESS;
+  }
+
+  void Deinitialize()
+  {
+    if (m_pSqes != nullptr)
+      munmap(m_pSqes, m_uiSqesSize);
+    if (m_pCqRing != nullptr && m_pCqRing != m_pSqRing)
+      munmap(m_pCqRing, m_uiCqRingSize);
+    if (m_pSqRing != nullptr)
+      munmap(m_pSqRing, m_uiSqRingSize);
+    if (m_iRing >= 0)
+      close(m_iRing);
+
+    m_pSqes = nullptr;
+    m_pCqRing = nullptr;
+    m_pSqRing = nullptr;
+    m_iRing = -1;
+    m_uiNumInFlight = 0;
+    m_uiNumToSubmit = 0;
+  }
+
+  ezResult OpenFile(const char* szAbsolutePath, ezInt64& out_iFile, ezUInt64& out_uiFileSize)
+  {
+    const int iFile = open(szAbsolutePath, O_RDONLY | O_CLOEXEC);
+    if (iFile < 0)
+      return EZ_FAILURE;
+
+    struct stat sb;
+    if (fstat(iFile, &sb) != 0)
+    {
+      close(iFile);
+      return EZ_FAILURE;
+    }
+
+    out_iFile = iFile;
+    out_uiFileSize = static_cast<ezUInt64>(sb.st_size);
+    return EZ_SUCCESS;
+  }
+
+  void CloseFile(ezInt64 iFile) { close(static_cast<int>(iFile)); }
+
+  /// \brief Queues a read, which is handed to the kernel with the next call to ProcessCompletions(). Returns false if the queue is full.
+  bool QueueRead(ezInt64 iFile, void* pBuffer, ezUInt32 uiBytes, ezUInt64 uiFileOffset, ezUInt64 uiUserData)
+  {
+    if (m_uiNumInFlight >= m_uiMaxInFlight)
+      return false;
+
+    // only this thread writes the tail
+    const ezUInt32 uiTail = *m_pSqTail;
+    const ezUInt32 uiIndex = uiTail & m_uiSqMask;
+
+    io_uring_sqe& sqe = m_pSqes[uiIndex];
+    ezMemoryUtils::ZeroFill(&sqe, 1);
+    sqe.opcode = IORING_OP_READ;
+    sqe.fd = static_cast<int>(iFile);
+    sqe.addr = reinterpret_cast<ezUInt64>(pBuffer);
+    sqe.len = uiBytes;
+    sqe.off = uiFileOffset;
+    sqe.user_data = uiUserData;
+
+    m_pSqArray[uiIndex] = uiIndex;
+    __atomic_store_n(m_pSqTail, uiTail + 1, __ATOMIC_RELEASE);
+
+    ++m_uiNumToSubmit;
+    ++m_uiNumInFlight;
+    return true;
+  }
+
+  /// \brief Hands all queued reads to the kernel and calls func(uiUserData, iResult) for every finished read.
+  ///
+  /// iResult is the number of bytes that were read or a negative error code. func may queue new reads.
+  /// If bWait is set and reads are in flight, blocks until at least one of them is finished.
+  template <typename Func>
+  ezUInt32 ProcessCompletions(bool bWait, Func&& func)
+  {
+    bWait = bWait && m_uiNumInFlight > 0;
+
+    if (m_uiNumToSubmit > 0 || bWait)
+    {
+      Enter(bWait);
+    }
+
+    // only this thread writes the head
+    ezUInt32 uiHead = *m_pCqHead;
+    const ezUInt32 uiTail = __atomic_load_n(m_pCqTail, __ATOMIC_ACQUIRE);
+
+    ezUInt32 uiNumCompleted = 0;
+    for (; uiHead != uiTail; ++uiHead)
+    {
+      const io_uring_cqe& cqe = m_pCqes[uiHead & m_uiCqMask];
+      const ezUInt64 uiUserData = cqe.user_data;
+      const ezInt64 iResult = cqe.res;
+
+      --m_uiNumInFlight;
+      ++uiNumCompleted;
+
+      // the entry is copied, so it is fine that func queues new reads before the head is updated
+      func(uiUserData, iResult);
+    }
+
+    __atomic_store_n(m_pCqHead, uiHead, __ATOMIC_RELEASE);
+    return uiNumCompleted;
+  }
+
+  ezUInt32 GetNumInFlight() const { return m_uiNumInFlight; }
+
+private:
+  void* Map(size_t uiSize, off_t offset)
+  {
+    void* pMapped = mmap(nullptr, uiSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_iRing, offset);
+    return pMapped == MAP_FAILED ? nullptr : pMapped;
+  }
+
+  void Enter(bool bWait)
+  {
+    while (true)
+    {
+      const int iSubmitted = static_cast<int>(
+        syscall(__NR_io_uring_enter, m_iRing, m_uiNumToSubmit, bWait ? 1 : 0, bWait ? IORING_ENTER_GETEVENTS : 0, nullptr, 0));
+
+      if (iSubmitted >= 0)
+      {
+        m_uiNumToSubmit -= static_cast<ezUInt32>(iSubmitted);
+        return;
+      }
+
+      // on EAGAIN or EBUSY the kernel is out of resources, the reads stay queued and are submitted with the next call
+      if (errno != EINTR)
+        return;
+    }
+  }
+
+  int m_iRing = -1;
+  ezUInt32 m_uiMaxInFlight = 0;
+  ezUInt32 m_uiNumInFlight = 0; ///< Queued and submitted reads, whose completion was not processed yet
+  ezUInt32 m_uiNumToSubmit = 0;
+
+  void* m_pSqRing = nullptr;
+  void* m_pCqRing = nullptr;
+  io_uring_sqe* m_pSqes = nullptr;
+  size_t m_uiSqRingSize = 0;
+  size_t m_uiCqRingSize = 0;
+  size_t m_uiSqesSize = 0;
+
+  ezUInt32* m_pSqTail = nullptr;
+  ezUInt32* m_pSqArray = nullptr;
+  ezUInt32 m_uiSqMask = 0;
+
+  ezUInt32* m_pCqHead = nullptr;
+  ezUInt32* m_pCqTail = nullptr;
+  io_uring_cqe* m_pCqes = nullptr;
+  ezUInt32 m_uiCqMask = 0;
+};
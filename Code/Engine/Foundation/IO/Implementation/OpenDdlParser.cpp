@@ -1,5 +1,6 @@
 #include <FoundationPCH.h>
 
+#include <Foundation/IO/Implementation/TextScanning.h>
 #include <Foundation/IO/OpenDdlParser.h>
 #include <Foundation/Logging/Log.h>
 #include <Foundation/Utilities/ConversionUtils.h>
@@ -41,7 +42,26 @@ void ezOpenDdlParser::SetInputStream(ezStreamReader& stream, ezUInt32 uiFirstLin
   EZ_ASSERT_DEV(m_StateStack.IsEmpty(), "OpenDDL Parser cannot be restarted");
 
   m_pInput = &stream;
+  m_InputBuffer.SetCountUninitialized(16 * 1024);
+  m_pInputCur = m_InputBuffer.GetData();
+  m_pInputEnd = m_InputBuffer.GetData();
 
+  StartInput(uiFirstLineOffset);
+}
+
+void ezOpenDdlParser::SetInputMemory(ezArrayPtr<const ezUInt8> data, ezUInt32 uiFirstLineOffset /*= 0*/)
+{
+  EZ_ASSERT_DEV(m_StateStack.IsEmpty(), "OpenDDL Parser cannot be restarted");
+
+  m_pInput = nullptr;
+  m_pInputCur = data.GetPtr();
+  m_pInputEnd = data.GetPtr() + data.GetCount();
+
+  StartInput(uiFirstLineOffset);
+}
+
+void ezOpenDdlParser::StartInput(ezUInt32 uiFirstLineOffset)
+{
   m_bSkippingMode = false;
   m_uiCurLine = 1 + uiFirstLineOffset;
   m_uiCurColumn = 0;
@@ -183,9 +203,30 @@ void ezOpenDdlParser::ParsingError(const char* szMessage, bool bFatal)
 }
 
 
-void ezOpenDdlParser::ReadNextByte()
+bool ezOpenDdlParser::RefillInput()
 {
-  m_pInput->ReadBytes(&m_uiNextByte, sizeof(ezUInt8));
+  if (m_pInput == nullptr)
+    return false;
+
+  const ezUInt64 uiRead = m_pInput->ReadBytes(m_InputBuffer.GetData(), m_InputBuffer.GetCount());
+
+  m_pInputCur = m_InputBuffer.GetData();
+  m_pInputEnd = m_InputBuffer.GetData() + uiRead;
+
+  return uiRead > 0;
+}
+
+EZ_FORCE_INLINE void ezOpenDdlParser::ReadNextByte()
+{
+  if (m_pInputCur != m_pInputEnd || RefillInput())
+  {
+    m_uiNextByte = *m_pInputCur;
+    ++m_pInputCur;
+  }
+  else
+  {
+    m_uiNextByte = '\0';
+  }
 
   if (m_uiNextByte == '\n')
   {
@@ -255,6 +296,30 @@ void ezOpenDdlParser::SkipWhitespace()
 {
   do
   {
+    // skip all whitespace that follows the next byte at once, the last one of them becomes the next byte
+    if (m_uiNextByte >= 1 && m_uiNextByte <= 32)
+    {
+      ezUInt32 uiNumNewLines = 0;
+      ezUInt32 uiLastNewLine = 0;
+      const ezUInt32 uiNumWhitespace = ezTextScanning::CountWhitespaceBytes(m_pInputCur, m_pInputEnd, uiNumNewLines, uiLastNewLine);
+
+      if (uiNumWhitespace > 0)
+      {
+        m_pInputCur += uiNumWhitespace;
+        m_uiNextByte = m_pInputCur[-1];
+
+        if (uiNumNewLines > 0)
+        {
+          m_uiCurLine += uiNumNewLines;
+          m_uiCurColumn = uiNumWhitespace - 1 - uiLastNewLine;
+        }
+        else
+        {
+          m_uiCurColumn += uiNumWhitespace;
+        }
+      }
+    }
+
     m_uiCurByte = '\0';
 
     if (!ReadCharacterSkipComments())
@@ -589,12 +654,40 @@ void ezOpenDdlParser::ReadIdentifier(ezUInt8* szString, ezUInt32& count)
   SkipWhitespace();
 }
 
-void ezOpenDdlParser::ReadString()
+static EZ_ALWAYS_INLINE bool IsDdlPlainStringCharacter(ezUInt8 byte)
 {
+  return byte != '\"' && byte != '\\' && byte != '\n' && byte != '\0';
+}
+
+ezStringView ezOpenDdlParser::ReadString()
+{
+  // when parsing from memory, strings without escape sequences are returned as views into the input data
+  if (m_pInput == nullptr && m_uiNextByte != '\0')
+  {
+    const ezUInt8* pStart = m_pInputCur - 1;
+    const ezUInt32 uiLength = ezTextScanning::CountPlainStringBytes(pStart, m_pInputEnd);
+
+    if (pStart + uiLength < m_pInputEnd && pStart[uiLength] == '\"')
+    {
+      // skip the string and the closing quote, none of which is a line break
+      m_pInputCur = pStart + uiLength + 1;
+      m_uiCurColumn += uiLength;
+      m_uiCurByte = '\"';
+      ReadNextByte();
+
+      return ezStringView(reinterpret_cast<const char*>(pStart), reinterpret_cast<const char*>(pStart + uiLength));
+    }
+  }
+
   m_uiTempStringLength = 0;
 
   while (true)
   {
+    if (m_uiCurByte != '\\' && IsDdlPlainStringCharacter(m_uiNextByte))
+    {
+      AppendPlainStringBytes();
+    }
+
     const bool bEscapeSequence = (m_uiCurByte == '\\');
 
     m_uiCurByte = '\0';
@@ -674,6 +767,30 @@ void ezOpenDdlParser::ReadString()
   }
 
   m_TempString[m_uiTempStringLength] = '\0';
+
+  const char* szString = reinterpret_cast<const char*>(m_TempString.GetData());
+  return ezStringView(szString, szString + m_uiTempStringLength);
+}
+
+void ezOpenDdlParser::AppendPlainStringBytes()
+{
+  // m_uiNextByte is the first of the plain characters, copy it together with all that follow in the input buffer
+  const ezUInt8* pStart = m_pInputCur - 1;
+  const ezUInt32 uiLength = 1 + ezTextScanning::CountPlainStringBytes(m_pInputCur, m_pInputEnd);
+
+  while (m_uiTempStringLength + uiLength + 2 >= m_TempString.GetCount())
+  {
+    m_TempString.SetCountUninitialized(m_TempString.GetCount() * 2);
+  }
+
+  ezMemoryUtils::Copy(m_TempString.GetData() + m_uiTempStringLength, pStart, uiLength);
+  m_uiTempStringLength += uiLength;
+
+  // the last copied character becomes the current one, none of them is a line break
+  m_pInputCur = pStart + uiLength;
+  m_uiCurColumn += uiLength - 1;
+  m_uiCurByte = m_pInputCur[-1];
+  ReadNextByte();
 }
 
 void ezOpenDdlParser::ReadWord()
@@ -797,9 +914,11 @@ void ezOpenDdlParser::ContinueString()
   {
     case '\"':
     {
+      ezStringView view;
+
       if (!m_bSkippingMode)
       {
-        ReadString();
+        view = ReadString();
       }
       else
       {
@@ -810,8 +929,6 @@ void ezOpenDdlParser::ContinueString()
 
       if (!m_bSkippingMode)
       {
-        ezStringView view((const char*)&m_TempString[0], (const char*)&m_TempString[m_uiTempStringLength]);
-
         OnPrimitiveString(1, &view, false);
       }
 
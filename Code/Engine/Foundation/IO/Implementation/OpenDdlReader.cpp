@@ -21,6 +21,22 @@ ezResult ezOpenDdlReader::ParseDocument(ezStreamReader& stream, ezUInt32 uiFirst
   SetCacheSize(uiCacheSizeInKB);
   SetInputStream(stream, uiFirstLineOffset);
 
+  return ParseInput();
+}
+
+ezResult ezOpenDdlReader::ParseDocument(ezArrayPtr<const ezUInt8> data, ezUInt32 uiFirstLineOffset, ezLogInterface* pLog, ezUInt32 uiCacheSizeInKB)
+{
+  EZ_ASSERT_DEBUG(m_ObjectStack.IsEmpty(), "A reader can only be used once.");
+
+  SetLogInterface(pLog);
+  SetCacheSize(uiCacheSizeInKB);
+  SetInputMemory(data, uiFirstLineOffset);
+
+  return ParseInput();
+}
+
+ezResult ezOpenDdlReader::ParseInput()
+{
   m_TempCache.Reserve(s_uiChunkSize);
 
   ezOpenDdlReaderElement* pElement = &m_Elements.ExpandAndGetRef();
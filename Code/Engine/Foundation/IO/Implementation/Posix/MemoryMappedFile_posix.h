@@ -14,9 +14,7 @@ EZ_FOUNDATION_INTERNAL_HEADER
 #  include <linux/version.h>
 #endif
 
-#if EZ_ENABLED(EZ_PLATFORM_OSX)
-#  include <unistd.h>
-#endif
+#include <unistd.h>
 
 struct ezMemoryMappedFileImpl
 {
@@ -84,11 +82,8 @@ ezResult ezMemoryMappedFile::Open(const char* szAbsolutePath, Mode mode)
     prot |= PROT_WRITE;
     flags = MAP_SHARED;
   }
-#  if EZ_ENABLED(EZ_PLATFORM_LINUX)
-#    if LINUX_VERSION_CODE > KERNEL_VERSION(2, 6, 22)
-  flags |= MAP_POPULATE;
-#    endif
-#  endif
+
+  // no MAP_POPULATE here, large files (e.g. archives) should only be read from disk where they are accessed, see Prefetch()
   m_Impl->m_hFile = open(szAbsolutePath, access, 0);
   if (m_Impl->m_hFile == -1)
   {
@@ -217,3 +212,18 @@ ezUInt64 ezMemoryMappedFile::GetFileSize() const
 {
   return m_Impl->m_uiFileSize;
 }
+
+void ezMemoryMappedFile::Prefetch(ezUInt64 uiOffset, ezUInt64 uiSize) const
+{
+  if (m_Impl->m_pMappedFilePtr == nullptr || uiOffset >= m_Impl->m_uiFileSize)
+    return;
+
+  uiSize = ezMath::Min(uiSize, m_Impl->m_uiFileSize - uiOffset);
+
+  // madvise requires a page aligned start address
+  static const ezUInt64 s_uiPageSize = static_cast<ezUInt64>(sysconf(_SC_PAGESIZE));
+  const ezUInt64 uiAlignedOffset = uiOffset - (uiOffset % s_uiPageSize);
+
+  posix_madvise(ezMemoryUtils::AddByteOffset(m_Impl->m_pMappedFilePtr, static_cast<ptrdiff_t>(uiAlignedOffset)),
+    static_cast<size_t>(uiSize + (uiOffset - uiAlignedOffset)), POSIX_MADV_WILLNEED);
+}
@@ -13,21 +13,49 @@
 #include <Foundation/Math/Vec3.h>
 #include <Foundation/Math/Vec4.h>
 
+// The math types are stored exactly as they are laid out in memory, so each value, and each array of values, is read and written with a
+// single call. Only the types whose members are stored in a different order (ezTransformTemplate, ezBoundingBoxTemplate) are
+// serialized member by member.
+
+#define EZ_DECLARE_STREAM_POD_TEMPLATE(Template, NumComponents)                                                                  \
+  template <typename Type>                                                                                                       \
+  struct ezStreamPodType<Template<Type>>                                                                                         \
+  {                                                                                                                              \
+    static_assert(ezIsStreamPodType<Type>, #Template " can only be serialized with a component type that is a stream POD type"); \
+    static_assert(sizeof(Template<Type>) == NumComponents * sizeof(Type), #Template " must not contain padding");                \
+    using ComponentType = typename ezStreamPodType<Type>::ComponentType;                                                         \
+  }
+
+EZ_DECLARE_STREAM_POD_TEMPLATE(ezVec2Template, 2);
+EZ_DECLARE_STREAM_POD_TEMPLATE(ezVec3Template, 3);
+EZ_DECLARE_STREAM_POD_TEMPLATE(ezVec4Template, 4);
+EZ_DECLARE_STREAM_POD_TEMPLATE(ezMat3Template, 9);
+EZ_DECLARE_STREAM_POD_TEMPLATE(ezMat4Template, 16);
+EZ_DECLARE_STREAM_POD_TEMPLATE(ezPlaneTemplate, 4);
+EZ_DECLARE_STREAM_POD_TEMPLATE(ezQuatTemplate, 4);
+EZ_DECLARE_STREAM_POD_TEMPLATE(ezBoundingSphereTemplate, 4);
+EZ_DECLARE_STREAM_POD_TEMPLATE(ezBoundingBoxSphereTemplate, 7);
+
+#undef EZ_DECLARE_STREAM_POD_TEMPLATE
+
+EZ_DECLARE_STREAM_POD_TYPE(ezColor, float);
+EZ_DECLARE_STREAM_POD_TYPE(ezColorGammaUB, ezUInt8);
+EZ_DECLARE_STREAM_POD_TYPE(ezColorLinearUB, ezUInt8);
+EZ_DECLARE_STREAM_POD_TYPE(ezAngle, float);
+
 // ezVec2Template
 
 template <typename Type>
 inline ezStreamWriter& operator<<(ezStreamWriter& Stream, const ezVec2Template<Type>& Value)
 {
-  Stream << Value.x;
-  Stream << Value.y;
+  Stream.WriteElements(&Value, 1);
   return Stream;
 }
 
 template <typename Type>
 inline ezStreamReader& operator>>(ezStreamReader& Stream, ezVec2Template<Type>& Value)
 {
-  Stream >> Value.x;
-  Stream >> Value.y;
+  Stream.ReadElements(&Value, 1);
   return Stream;
 }
 
@@ -36,18 +64,14 @@ inline ezStreamReader& operator>>(ezStreamReader& Stream, ezVec2Template<Type>&
 template <typename Type>
 inline ezStreamWriter& operator<<(ezStreamWriter& Stream, const ezVec3Template<Type>& Value)
 {
-  Stream << Value.x;
-  Stream << Value.y;
-  Stream << Value.z;
+  Stream.WriteElements(&Value, 1);
   return Stream;
 }
 
 template <typename Type>
 inline ezStreamReader& operator>>(ezStreamReader& Stream, ezVec3Template<Type>& Value)
 {
-  Stream >> Value.x;
-  Stream >> Value.y;
-  Stream >> Value.z;
+  Stream.ReadElements(&Value, 1);
   return Stream;
 }
 
@@ -56,20 +80,14 @@ inline ezStreamReader& operator>>(ezStreamReader& Stream, ezVec3Template<Type>&
 template <typename Type>
 inline ezStreamWriter& operator<<(ezStreamWriter& Stream, const ezVec4Template<Type>& Value)
 {
-  Stream << Value.x;
-  Stream << Value.y;
-  Stream << Value.z;
-  Stream << Value.w;
+  Stream.WriteElements(&Value, 1);
   return Stream;
 }
 
 template <typename Type>
 inline ezStreamReader& operator>>(ezStreamReader& Stream, ezVec4Template<Type>& Value)
 {
-  Stream >> Value.x;
-  Stream >> Value.y;
-  Stream >> Value.z;
-  Stream >> Value.w;
+  Stream.ReadElements(&Value, 1);
   return Stream;
 }
 
@@ -78,18 +96,14 @@ inline ezStreamReader& operator>>(ezStreamReader& Stream, ezVec4Template<Type>&
 template <typename Type>
 inline ezStreamWriter& operator<<(ezStreamWriter& Stream, const ezMat3Template<Type>& Value)
 {
-  for (ezUInt32 i = 0; i < 9; ++i)
-    Stream << Value.m_fElementsCM[i];
-
+  Stream.WriteElements(&Value, 1);
   return Stream;
 }
 
 template <typename Type>
 inline ezStreamReader& operator>>(ezStreamReader& Stream, ezMat3Template<Type>& Value)
 {
-  for (ezUInt32 i = 0; i < 9; ++i)
-    Stream >> Value.m_fElementsCM[i];
-
+  Stream.ReadElements(&Value, 1);
   return Stream;
 }
 
@@ -98,18 +112,14 @@ inline ezStreamReader& operator>>(ezStreamReader& Stream, ezMat3Template<Type>&
 template <typename Type>
 inline ezStreamWriter& operator<<(ezStreamWriter& Stream, const ezMat4Template<Type>& Value)
 {
-  for (ezUInt32 i = 0; i < 16; ++i)
-    Stream << Value.m_fElementsCM[i];
-
+  Stream.WriteElements(&Value, 1);
   return Stream;
 }
 
 template <typename Type>
 inline ezStreamReader& operator>>(ezStreamReader& Stream, ezMat4Template<Type>& Value)
 {
-  for (ezUInt32 i = 0; i < 16; ++i)
-    Stream >> Value.m_fElementsCM[i];
-
+  Stream.ReadElements(&Value, 1);
   return Stream;
 }
 
@@ -140,20 +150,14 @@ inline ezStreamReader& operator>>(ezStreamReader& Stream, ezTransformTemplate<Ty
 template <typename Type>
 inline ezStreamWriter& operator<<(ezStreamWriter& Stream, const ezPlaneTemplate<Type>& Value)
 {
-  Stream << Value.m_vNormal.x;
-  Stream << Value.m_vNormal.y;
-  Stream << Value.m_vNormal.z;
-  Stream << Value.m_fNegDistance;
+  Stream.WriteElements(&Value, 1);
   return Stream;
 }
 
 template <typename Type>
 inline ezStreamReader& operator>>(ezStreamReader& Stream, ezPlaneTemplate<Type>& Value)
 {
-  Stream >> Value.m_vNormal.x;
-  Stream >> Value.m_vNormal.y;
-  Stream >> Value.m_vNormal.z;
-  Stream >> Value.m_fNegDistance;
+  Stream.ReadElements(&Value, 1);
   return Stream;
 }
 
@@ -162,20 +166,14 @@ inline ezStreamReader& operator>>(ezStreamReader& Stream, ezPlaneTemplate<Type>&
 template <typename Type>
 inline ezStreamWriter& operator<<(ezStreamWriter& Stream, const ezQuatTemplate<Type>& Value)
 {
-  Stream << Value.v.x;
-  Stream << Value.v.y;
-  Stream << Value.v.z;
-  Stream << Value.w;
+  Stream.WriteElements(&Value, 1);
   return Stream;
 }
 
 template <typename Type>
 inline ezStreamReader& operator>>(ezStreamReader& Stream, ezQuatTemplate<Type>& Value)
 {
-  Stream >> Value.v.x;
-  Stream >> Value.v.y;
-  Stream >> Value.v.z;
-  Stream >> Value.w;
+  Stream.ReadElements(&Value, 1);
   return Stream;
 }
 
@@ -202,16 +200,14 @@ inline ezStreamReader& operator>>(ezStreamReader& Stream, ezBoundingBoxTemplate<
 template <typename Type>
 inline ezStreamWriter& operator<<(ezStreamWriter& Stream, const ezBoundingSphereTemplate<Type>& Value)
 {
-  Stream << Value.m_vCenter;
-  Stream << Value.m_fRadius;
+  Stream.WriteElements(&Value, 1);
   return Stream;
 }
 
 template <typename Type>
 inline ezStreamReader& operator>>(ezStreamReader& Stream, ezBoundingSphereTemplate<Type>& Value)
 {
-  Stream >> Value.m_vCenter;
-  Stream >> Value.m_fRadius;
+  Stream.ReadElements(&Value, 1);
   return Stream;
 }
 
@@ -220,56 +216,40 @@ inline ezStreamReader& operator>>(ezStreamReader& Stream, ezBoundingSphereTempla
 template <typename Type>
 inline ezStreamWriter& operator<<(ezStreamWriter& Stream, const ezBoundingBoxSphereTemplate<Type>& Value)
 {
-  Stream << Value.m_vCenter;
-  Stream << Value.m_fSphereRadius;
-  Stream << Value.m_vBoxHalfExtends;
+  Stream.WriteElements(&Value, 1);
   return Stream;
 }
 
 template <typename Type>
 inline ezStreamReader& operator>>(ezStreamReader& Stream, ezBoundingBoxSphereTemplate<Type>& Value)
 {
-  Stream >> Value.m_vCenter;
-  Stream >> Value.m_fSphereRadius;
-  Stream >> Value.m_vBoxHalfExtends;
+  Stream.ReadElements(&Value, 1);
   return Stream;
 }
 
 // ezColor
 inline ezStreamWriter& operator<<(ezStreamWriter& Stream, const ezColor& Value)
 {
-  Stream << Value.r;
-  Stream << Value.g;
-  Stream << Value.b;
-  Stream << Value.a;
+  Stream.WriteElements(&Value, 1);
   return Stream;
 }
 
 inline ezStreamReader& operator>>(ezStreamReader& Stream, ezColor& Value)
 {
-  Stream >> Value.r;
-  Stream >> Value.g;
-  Stream >> Value.b;
-  Stream >> Value.a;
+  Stream.ReadElements(&Value, 1);
   return Stream;
 }
 
 // ezColorGammaUB
 inline ezStreamWriter& operator<<(ezStreamWriter& Stream, const ezColorGammaUB& Value)
 {
-  Stream << Value.r;
-  Stream << Value.g;
-  Stream << Value.b;
-  Stream << Value.a;
+  Stream.WriteElements(&Value, 1);
   return Stream;
 }
 
 inline ezStreamReader& operator>>(ezStreamReader& Stream, ezColorGammaUB& Value)
 {
-  Stream >> Value.r;
-  Stream >> Value.g;
-  Stream >> Value.b;
-  Stream >> Value.a;
+  Stream.ReadElements(&Value, 1);
   return Stream;
 }
 
@@ -290,18 +270,12 @@ inline ezStreamReader& operator>>(ezStreamReader& Stream, ezAngle& Value)
 // ezColor8Unorm
 inline ezStreamWriter& operator<<(ezStreamWriter& Stream, const ezColorLinearUB& Value)
 {
-  Stream << Value.r;
-  Stream << Value.g;
-  Stream << Value.b;
-  Stream << Value.a;
+  Stream.WriteElements(&Value, 1);
   return Stream;
 }
 
 inline ezStreamReader& operator>>(ezStreamReader& Stream, ezColorLinearUB& Value)
 {
-  Stream >> Value.r;
-  Stream >> Value.g;
-  Stream >> Value.b;
-  Stream >> Value.a;
+  Stream.ReadElements(&Value, 1);
   return Stream;
 }
@@ -152,6 +152,20 @@ inline ezStreamReader& operator>>(ezStreamReader& Stream, double& fValue)
   return Stream;
 }
 
+// Arrays of these are read and written with a single call, see ezStreamPodType
+// bool is not declared, because reading arbitrary bytes into a bool is undefined
+
+EZ_DECLARE_STREAM_POD_TYPE(ezUInt8, ezUInt8);
+EZ_DECLARE_STREAM_POD_TYPE(ezUInt16, ezUInt16);
+EZ_DECLARE_STREAM_POD_TYPE(ezUInt32, ezUInt32);
+EZ_DECLARE_STREAM_POD_TYPE(ezUInt64, ezUInt64);
+EZ_DECLARE_STREAM_POD_TYPE(ezInt8, ezInt8);
+EZ_DECLARE_STREAM_POD_TYPE(ezInt16, ezInt16);
+EZ_DECLARE_STREAM_POD_TYPE(ezInt32, ezInt32);
+EZ_DECLARE_STREAM_POD_TYPE(ezInt64, ezInt64);
+EZ_DECLARE_STREAM_POD_TYPE(float, float);
+EZ_DECLARE_STREAM_POD_TYPE(double, double);
+
 // C-style strings
 // No read equivalent for C-style strings (but can be read as ezString & ezStringBuilder instances)
 
@@ -62,7 +62,7 @@ ezResult ezStreamWriter::WriteDWordValue(const T* pDWordValue)
 {
   EZ_CHECK_AT_COMPILETIME(sizeof(T) == sizeof(ezUInt32));
 
-  ezUInt32 uiTemp = *reinterpret_cast<const ezUInt16*>(pDWordValue);
+  ezUInt32 uiTemp = *reinterpret_cast<const ezUInt32*>(pDWordValue);
   uiTemp = ezEndianHelper::Switch(uiTemp);
 
   return WriteBytes(reinterpret_cast<ezUInt8*>(&uiTemp), sizeof(T));
@@ -79,6 +79,20 @@ ezResult ezStreamWriter::WriteQWordValue(const T* pQWordValue)
   return WriteBytes(reinterpret_cast<ezUInt8*>(&uiTemp), sizeof(T));
 }
 
+namespace ezInternal
+{
+  template <typename ComponentType>
+  void StreamSwitchEndianess(ComponentType* pComponents, ezUInt32 uiCount)
+  {
+    if constexpr (sizeof(ComponentType) == 2)
+      ezEndianHelper::SwitchWords(reinterpret_cast<ezUInt16*>(pComponents), uiCount);
+    else if constexpr (sizeof(ComponentType) == 4)
+      ezEndianHelper::SwitchDWords(reinterpret_cast<ezUInt32*>(pComponents), uiCount);
+    else if constexpr (sizeof(ComponentType) == 8)
+      ezEndianHelper::SwitchQWords(reinterpret_cast<ezUInt64*>(pComponents), uiCount);
+  }
+} // namespace ezInternal
+
 #else
 
 template <typename T>
@@ -188,18 +202,58 @@ namespace ezStreamWriterUtil
   }
 } // namespace ezStreamWriterUtil
 
+template <typename ValueType>
+ezResult ezStreamWriter::WriteElements(const ValueType* pElements, ezUInt64 uiCount)
+{
+  if constexpr (ezIsStreamPodType<ValueType>)
+  {
+#if EZ_ENABLED(EZ_PLATFORM_BIG_ENDIAN)
+    using ComponentType = typename ezStreamPodType<ValueType>::ComponentType;
+
+    if constexpr (sizeof(ComponentType) > 1)
+    {
+      // the data must not be modified, so switch the endianess in a temporary buffer
+      ComponentType buffer[1024];
+
+      const ComponentType* pComponents = reinterpret_cast<const ComponentType*>(pElements);
+      ezUInt64 uiRemaining = uiCount * (sizeof(ValueType) / sizeof(ComponentType));
+
+      while (uiRemaining > 0)
+      {
+        const ezUInt32 uiChunk = static_cast<ezUInt32>(ezMath::Min<ezUInt64>(uiRemaining, EZ_ARRAY_SIZE(buffer)));
+
+        ezMemoryUtils::Copy(buffer, pComponents, uiChunk);
+        ezInternal::StreamSwitchEndianess(buffer, uiChunk);
+        EZ_SUCCEED_OR_RETURN(WriteBytes(buffer, uiChunk * sizeof(ComponentType)));
+
+        pComponents += uiChunk;
+        uiRemaining -= uiChunk;
+      }
+
+      return EZ_SUCCESS;
+    }
+#endif
+
+    return WriteBytes(pElements, uiCount * sizeof(ValueType));
+  }
+  else
+  {
+    for (ezUInt64 i = 0; i < uiCount; ++i)
+    {
+      EZ_SUCCEED_OR_RETURN(ezStreamWriterUtil::Serialize<ValueType>(*this, pElements[i]));
+    }
+
+    return EZ_SUCCESS;
+  }
+}
+
 template <typename ArrayType, typename ValueType>
 ezResult ezStreamWriter::WriteArray(const ezArrayBase<ValueType, ArrayType>& Array)
 {
   const ezUInt64 uiCount = Array.GetCount();
   WriteQWordValue(&uiCount);
 
-  for (ezUInt32 i = 0; i < static_cast<ezUInt32>(uiCount); ++i)
-  {
-    EZ_SUCCEED_OR_RETURN(ezStreamWriterUtil::Serialize<ValueType>(*this, Array[i]));
-  }
-
-  return EZ_SUCCESS;
+  return WriteElements(Array.GetData(), uiCount);
 }
 
 template <typename ValueType, ezUInt32 uiSize>
@@ -208,12 +262,7 @@ ezResult ezStreamWriter::WriteArray(const ValueType (&Array)[uiSize])
   const ezUInt64 uiWriteSize = uiSize;
   WriteQWordValue(&uiWriteSize);
 
-  for (ezUInt32 i = 0; i < static_cast<ezUInt32>(uiSize); ++i)
-  {
-    EZ_SUCCEED_OR_RETURN(ezStreamWriterUtil::Serialize<ValueType>(*this, Array[i]));
-  }
-
-  return EZ_SUCCESS;
+  return WriteElements(Array, uiWriteSize);
 }
 
 template <typename KeyType, typename Comparer>
@@ -289,6 +338,47 @@ namespace ezStreamReaderUtil
   }
 } // namespace ezStreamReaderUtil
 
+template <typename ValueType>
+ezResult ezStreamReader::ReadElements(ValueType* pElements, ezUInt64 uiCount)
+{
+  if constexpr (ezIsStreamPodType<ValueType>)
+  {
+    const ezUInt64 uiBytes = uiCount * sizeof(ValueType);
+    if (ReadBytes(pElements, uiBytes) != uiBytes)
+      return EZ_FAILURE;
+
+#if EZ_ENABLED(EZ_PLATFORM_BIG_ENDIAN)
+    using ComponentType = typename ezStreamPodType<ValueType>::ComponentType;
+
+    if constexpr (sizeof(ComponentType) > 1)
+    {
+      ComponentType* pComponents = reinterpret_cast<ComponentType*>(pElements);
+      ezUInt64 uiRemaining = uiCount * (sizeof(ValueType) / sizeof(ComponentType));
+
+      while (uiRemaining > 0)
+      {
+        const ezUInt32 uiChunk = static_cast<ezUInt32>(ezMath::Min<ezUInt64>(uiRemaining, ezMath::MaxValue<ezUInt32>()));
+        ezInternal::StreamSwitchEndianess(pComponents, uiChunk);
+
+        pComponents += uiChunk;
+        uiRemaining -= uiChunk;
+      }
+    }
+#endif
+
+    return EZ_SUCCESS;
+  }
+  else
+  {
+    for (ezUInt64 i = 0; i < uiCount; ++i)
+    {
+      EZ_SUCCEED_OR_RETURN(ezStreamReaderUtil::Deserialize<ValueType>(*this, pElements[i]));
+    }
+
+    return EZ_SUCCESS;
+  }
+}
+
 template <typename ArrayType, typename ValueType>
 ezResult ezStreamReader::ReadArray(ezArrayBase<ValueType, ArrayType>& Array)
 {
@@ -299,7 +389,18 @@ ezResult ezStreamReader::ReadArray(ezArrayBase<ValueType, ArrayType>& Array)
   {
     Array.Clear();
 
-    if (uiCount > 0)
+    if constexpr (ezIsStreamPodType<ValueType>)
+    {
+      Array.SetCountUninitialized(static_cast<ezUInt32>(uiCount));
+
+      if (ReadElements(Array.GetData(), uiCount).Failed())
+      {
+        // don't leave uninitialized elements behind
+        Array.Clear();
+        return EZ_FAILURE;
+      }
+    }
+    else if (uiCount > 0)
     {
       static_cast<ArrayType&>(Array).Reserve(static_cast<ezUInt32>(uiCount));
 
@@ -329,12 +430,7 @@ ezResult ezStreamReader::ReadArray(ValueType (&Array)[uiSize])
 
   if (uiCount < ezMath::MaxValue<ezUInt32>())
   {
-    for (ezUInt32 i = 0; i < static_cast<ezUInt32>(uiCount); ++i)
-    {
-      EZ_SUCCEED_OR_RETURN(ezStreamReaderUtil::Deserialize<ValueType>(*this, Array[i]));
-    }
-
-    return EZ_SUCCESS;
+    return ReadElements(Array, uiCount);
   }
 
   // Containers currently use 32 bit for counts internally. Value from file is too large.
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <Foundation/Basics.h>
+#include <Foundation/Math/Math.h>
+
+// SSE2 is always available on 64 bit x86
+#if EZ_ENABLED(EZ_PLATFORM_ARCH_X86) && (EZ_ENABLED(EZ_PLATFORM_64BIT) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#  define EZ_TEXTSCANNING_USE_SSE2 EZ_ON
+#  include <emmintrin.h>
+#else
+#  define EZ_TEXTSCANNING_USE_SSE2 EZ_OFF
+#endif
+
+/// \brief Helpers for the text parsers (ezJSONParser, ezOpenDdlParser) to skip over runs of uninteresting bytes at once.
+///
+/// All functions scan the range [pStart; pEnd) and process 16 bytes per step where SSE2 is available.
+namespace ezTextScanning
+{
+  /// \brief Returns the number of bytes at the start of the range that can be copied into a string as they are.
+  ///
+  /// The scan stops at quotes, backslashes, line breaks and zero bytes, which all need special handling by the parsers.
+  EZ_FORCE_INLINE ezUInt32 CountPlainStringBytes(const ezUInt8* pStart, const ezUInt8* pEnd)
+  {
+    const ezUInt8* pCur = pStart;
+
+#if EZ_ENABLED(EZ_TEXTSCANNING_USE_SSE2)
+    const __m128i quote = _mm_set1_epi8('\"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i newline = _mm_set1_epi8('\n');
+    const __m128i zero = _mm_setzero_si128();
+
+    while (pEnd - pCur >= 16)
+    {
+      const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pCur));
+      const __m128i special = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(bytes, quote), _mm_cmpeq_epi8(bytes, backslash)),
+        _mm_or_si128(_mm_cmpeq_epi8(bytes, newline), _mm_cmpeq_epi8(bytes, zero)));
+
+      const ezUInt32 uiMask = static_cast<ezUInt32>(_mm_movemask_epi8(special));
+      if (uiMask != 0)
+        return static_cast<ezUInt32>(pCur - pStart) + ezMath::FirstBitLow(uiMask);
+
+      pCur += 16;
+    }
+#endif
+
+    while (pCur < pEnd && *pCur != '\"' && *pCur != '\\' && *pCur != '\n' && *pCur != '\0')
+      ++pCur;
+
+    return static_cast<ezUInt32>(pCur - pStart);
+  }
+
+  /// \brief Returns the number of whitespace bytes (as defined by ezStringUtils::IsWhiteSpace()) at the start of the range.
+  ///
+  /// Additionally returns how many of those are line breaks and the index of the last one, so that the caller can update its line
+  /// and column counters. out_uiLastNewLine is only written, if out_uiNumNewLines is not zero.
+  EZ_FORCE_INLINE ezUInt32 CountWhitespaceBytes(
+    const ezUInt8* pStart, const ezUInt8* pEnd, ezUInt32& out_uiNumNewLines, ezUInt32& out_uiLastNewLine)
+  {
+    const ezUInt8* pCur = pStart;
+    out_uiNumNewLines = 0;
+
+#if EZ_ENABLED(EZ_TEXTSCANNING_USE_SSE2)
+    const __m128i one = _mm_set1_epi8(1);
+    const __m128i maxWhitespace = _mm_set1_epi8(31);
+    const __m128i newline = _mm_set1_epi8('\n');
+
+    while (pEnd - pCur >= 16)
+    {
+      const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pCur));
+
+      // whitespace is the range [1; 32], subtracting one maps it to [0; 31] and zero to 255
+      const __m128i shifted = _mm_sub_epi8(bytes, one);
+      const __m128i whitespace = _mm_cmpeq_epi8(_mm_min_epu8(shifted, maxWhitespace), shifted);
+
+      const ezUInt32 uiNonWhitespaceMask = ~static_cast<ezUInt32>(_mm_movemask_epi8(whitespace)) & 0xFFFFu;
+      const ezUInt32 uiNumWhitespace = uiNonWhitespaceMask != 0 ? ezMath::FirstBitLow(uiNonWhitespaceMask) : 16;
+
+      ezUInt32 uiNewLineMask = static_cast<ezUInt32>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, newline)));
+      uiNewLineMask &= (1u << uiNumWhitespace) - 1u;
+
+      if (uiNewLineMask != 0)
+      {
+        out_uiNumNewLines += ezMath::CountBits(uiNewLineMask);
+        out_uiLastNewLine = static_cast<ezUInt32>(pCur - pStart) + ezMath::FirstBitHigh(uiNewLineMask);
+      }
+
+      pCur += uiNumWhitespace;
+
+      if (uiNumWhitespace < 16)
+        return static_cast<ezUInt32>(pCur - pStart);
+    }
+#endif
+
+    while (pCur < pEnd && *pCur >= 1 && *pCur <= 32)
+    {
+      if (*pCur == '\n')
+      {
+        ++out_uiNumNewLines;
+        out_uiLastNewLine = static_cast<ezUInt32>(pCur - pStart);
+      }
+
+      ++pCur;
+    }
+
+    return static_cast<ezUInt32>(pCur - pStart);
+  }
+} // namespace ezTextScanning
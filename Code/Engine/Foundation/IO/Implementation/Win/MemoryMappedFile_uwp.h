@@ -51,3 +51,8 @@ ezUInt64 ezMemoryMappedFile::GetFileSize() const
 {
   return m_Impl->m_uiFileSize;
 }
+
+void ezMemoryMappedFile::Prefetch(ezUInt64 uiOffset, ezUInt64 uiSize) const
+{
+  // not supported
+}
@@ -22,8 +22,15 @@ public:
 
 protected:
   /// \brief Resets the parser to the start state and configures it to read from the given stream.
+  ///
+  /// The stream is read in blocks, so it may be read beyond the end of the document.
   void SetInputStream(ezStreamReader& stream, ezUInt32 uiFirstLineOffset = 0);
 
+  /// \brief Resets the parser to the start state and configures it to read directly from the given memory.
+  ///
+  /// This is faster than reading from a stream. The data is not copied, it must stay valid and unchanged until parsing is finished.
+  void SetInputMemory(ezArrayPtr<const ezUInt8> data, ezUInt32 uiFirstLineOffset = 0);
+
   /// \brief Does one parsing step.
   ///
   /// While this function returns true, the document has not been parsed completely.
@@ -116,10 +123,14 @@ private:
     State m_State;
   };
 
+  void StartInput(ezUInt32 uiFirstLineOffset);
+  bool RefillInput();
+
   void StartParsing();
   void SkipWhitespace();
   void SkipString();
   void ReadString();
+  void AppendPlainStringBytes();
   double ReadNumber();
   void ReadWord();
 
@@ -139,7 +150,13 @@ private:
   ezUInt32 m_uiCurLine;
   ezUInt32 m_uiCurColumn;
 
+  // the input is always read from memory, which is either the memory given to SetInputMemory() or m_InputBuffer,
+  // which is refilled from m_pInput. After a byte was read into m_uiNextByte, it is also at m_pInputCur[-1].
   ezStreamReader* m_pInput;
+  ezDynamicArray<ezUInt8> m_InputBuffer;
+  const ezUInt8* m_pInputCur;
+  const ezUInt8* m_pInputEnd;
+
   ezHybridArray<JSONState, 32> m_StateStack;
   ezHybridArray<ezUInt8, 4096> m_TempString;
 
@@ -19,6 +19,9 @@ public:
   /// error occurred.
   ezResult Parse(ezStreamReader& pInput, ezUInt32 uiFirstLineOffset = 0);
 
+  /// \brief Same as the stream version of Parse(), but parses directly from memory, which is considerably faster.
+  ezResult Parse(ezArrayPtr<const ezUInt8> data, ezUInt32 uiFirstLineOffset = 0);
+
   /// \brief Returns the top-level object of the JSON document.
   const ezVariantDictionary& GetTopLevelObject() const { return m_Stack.PeekBack().m_Dictionary; }
 
@@ -53,6 +56,8 @@ private:
   virtual void OnParsingError(const char* szMessage, bool bFatal, ezUInt32 uiLine, ezUInt32 uiColumn) override;
 
 protected:
+  ezResult ParseInput();
+
   enum class ElementMode : ezInt8
   {
     Array,
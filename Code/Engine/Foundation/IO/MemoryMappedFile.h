@@ -61,6 +61,12 @@ public:
   /// \brief Returns a pointer for writing the mapped file. Asserts that the memory mapping was successful and the mode was ReadWrite.
   void* GetWritePointer(ezUInt64 uiOffset = 0, OffsetBase base = OffsetBase::Start);
 
+  /// \brief Hints the OS that the given byte range of the mapping will be accessed soon.
+  ///
+  /// The OS may then read the range from disk in the background, so that the first access does not have to wait for page faults.
+  /// This never blocks and does nothing on platforms that do not support it.
+  void Prefetch(ezUInt64 uiOffset, ezUInt64 uiSize) const;
+
 private:
   ezUniquePtr<ezMemoryMappedFileImpl> m_Impl;
 };
@@ -52,8 +52,17 @@ protected:
   void SetCacheSize(ezUInt32 uiSizeInKB);
 
   /// \brief Configures the parser to read from the given stream. This can only be called once on a parser instance.
+  ///
+  /// The stream is read in blocks, so it may be read beyond the end of the document.
   void SetInputStream(ezStreamReader& stream, ezUInt32 uiFirstLineOffset = 0); // [tested]
 
+  /// \brief Configures the parser to read directly from the given memory, e.g. a loaded file or an ezMemoryMappedFile.
+  ///
+  /// This is faster than reading from a stream. The data is not copied, it must stay valid and unchanged until parsing is finished.
+  /// Strings that don't contain escape sequences are passed to OnPrimitiveString() as views into this memory.
+  /// This can only be called once on a parser instance.
+  void SetInputMemory(ezArrayPtr<const ezUInt8> data, ezUInt32 uiFirstLineOffset = 0); // [tested]
+
   /// \brief Call this to parse the next piece of the document. This may trigger a callback through which data is returned.
   ///
   /// This function returns false when the end of the document has been reached, or a fatal parsing error has been reported.
@@ -160,13 +169,16 @@ private:
     State m_State;
   };
 
+  void StartInput(ezUInt32 uiFirstLineOffset);
+  bool RefillInput();
   void ReadNextByte();
   bool ReadCharacter();
   bool ReadCharacterSkipComments();
   void SkipWhitespace();
   void ContinueIdle();
   void ReadIdentifier(ezUInt8* szString, ezUInt32& count);
-  void ReadString();
+  ezStringView ReadString();
+  void AppendPlainStringBytes();
   void ReadWord();
   ezUInt64 ReadDecimalLiteral();
   void PurgeCachedPrimitives(bool bThisIsAll);
@@ -181,9 +193,15 @@ private:
   void ReadHexString();
 
   ezHybridArray<DdlState, 32> m_StateStack;
-  ezStreamReader* m_pInput;
   ezDynamicArray<ezUInt8> m_Cache;
 
+  // the input is always read from memory, which is either the memory given to SetInputMemory() or m_InputBuffer,
+  // which is refilled from m_pInput. After a byte was read into m_uiNextByte, it is also at m_pInputCur[-1].
+  ezStreamReader* m_pInput = nullptr;
+  ezDynamicArray<ezUInt8> m_InputBuffer;
+  const ezUInt8* m_pInputCur = nullptr;
+  const ezUInt8* m_pInputEnd = nullptr;
+
   static const ezUInt32 s_uiMaxIdentifierLength = 64;
 
   ezUInt8 m_uiCurByte;
@@ -16,6 +16,30 @@ struct ezHybridString;
 
 using ezString = ezHybridString<32, ezDefaultAllocatorWrapper>;
 
+/// \brief Declares that T is serialized as a tightly packed sequence of ComponentType values, exactly in the order they have in memory.
+///
+/// ComponentType must be a type of 1, 2, 4 or 8 bytes, its size is used to switch the endianess on big endian platforms.
+/// Arrays of such types are read and written with a single call to ReadBytes() / WriteBytes(), instead of one call per member.
+/// Only specialize this for POD types that have no padding, otherwise the data in the stream would change.
+template <typename T>
+struct ezStreamPodType
+{
+  using ComponentType = void;
+};
+
+/// \brief Whether T was declared with ezStreamPodType.
+template <typename T>
+constexpr bool ezIsStreamPodType = !std::is_void<typename ezStreamPodType<T>::ComponentType>::value;
+
+/// \brief Declares a (non-template) type as a stream POD type, see ezStreamPodType.
+#define EZ_DECLARE_STREAM_POD_TYPE(Type, Component)                                                      \
+  template <>                                                                                            \
+  struct ezStreamPodType<Type>                                                                           \
+  {                                                                                                      \
+    static_assert(sizeof(Type) % sizeof(Component) == 0, "Type must consist of a number of components"); \
+    using ComponentType = Component;                                                                     \
+  }
+
 /// \brief Interface for binary in (read) streams.
 class EZ_FOUNDATION_DLL ezStreamReader
 {
@@ -52,6 +76,12 @@ public:
   template <typename ValueType, ezUInt32 uiSize>
   ezResult ReadArray(ValueType (&Array)[uiSize]);
 
+  /// \brief Reads uiCount elements that were written with ezStreamWriter::WriteElements(), without a count.
+  ///
+  /// Types that are declared with ezStreamPodType are read with a single call to ReadBytes(), all other types one by one.
+  template <typename ValueType>
+  ezResult ReadElements(ValueType* pElements, ezUInt64 uiCount); // [tested]
+
   /// \brief Reads a set
   template <typename KeyType, typename Comparer>
   ezResult ReadSet(ezSetBase<KeyType, Comparer>& Set); // [tested]
@@ -143,6 +173,13 @@ public:
   template <typename ValueType, ezUInt32 uiSize>
   ezResult WriteArray(const ValueType (&Array)[uiSize]);
 
+  /// \brief Writes uiCount elements, without a count.
+  ///
+  /// Types that are declared with ezStreamPodType are written with a single call to WriteBytes() (in chunks on big endian platforms),
+  /// all other types one by one. WriteArray() uses this as well, so the data in the stream is the same either way.
+  template <typename ValueType>
+  ezResult WriteElements(const ValueType* pElements, ezUInt64 uiCount); // [tested]
+
   /// \brief Writes a set
   template <typename KeyType, typename Comparer>
   ezResult WriteSet(const ezSetBase<KeyType, Comparer>& Set); // [tested]
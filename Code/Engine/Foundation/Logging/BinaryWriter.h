@@ -0,0 +1,133 @@
+#pragma once
+
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Containers/HashTable.h>
+#include <Foundation/IO/CompressedStreamZstd.h>
+#include <Foundation/IO/FileSystem/FileWriter.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Strings/String.h>
+
+/// \brief One log message as it is stored in a binary log file. See ezLogWriter::Binary.
+struct EZ_FOUNDATION_DLL ezBinaryLogEntry
+{
+  /// \brief Microseconds since the Unix epoch, in UTC.
+  ezInt64 m_iTimestamp = 0;
+
+  /// \brief A small number that identifies the thread on which the message was logged. Threads are numbered in the order in which they first log something.
+  ezUInt16 m_uiThreadIndex = 0;
+
+  ezLogMsgType::Enum m_Type = ezLogMsgType::None;
+
+  /// \brief The nesting depth of ezLogBlock's at the time the message was logged.
+  ezUInt8 m_uiIndentation = 0;
+
+  /// \brief The index of the interned message template. All messages that only differ in their numbers share the same template.
+  ezUInt32 m_uiTemplateIndex = 0;
+
+  /// \brief The message text, with all arguments re-inserted.
+  ezStringBuilder m_sText;
+
+  ezStringBuilder m_sTag;
+
+  /// \brief The duration of the log block, only set for ezLogMsgType::EndGroup.
+  double m_fSeconds = 0;
+};
+
+namespace ezLogWriter
+{
+  /// \brief A log writer that writes out log messages in a compact binary format.
+  ///
+  /// Every message stores a timestamp, the thread that logged it, its ezLogMsgType, the log block nesting depth and its tag.
+  /// The message text is split into a template and arguments: all runs of decimal digits are taken out as arguments,
+  /// the remaining template is interned and only written to the file the first time it is encountered.
+  /// Since ezLog only passes along fully formatted text, this is how the original format strings are recovered.
+  ///
+  /// Optionally the entire file content is compressed with zstd, see ezCompressedStreamWriterZstd.
+  /// Use ezBinaryLogReader to read the file back, the LogTool application can filter such logs and convert them to text.
+  ///
+  /// Create an instance of this class, register the LogMessageHandler at ezLog and pass the pointer
+  /// to the instance as the pPassThrough argument to it.
+  class EZ_FOUNDATION_DLL Binary
+  {
+  public:
+    Binary();
+    ~Binary();
+
+    /// \brief Register this at ezLog to write all log messages to a binary file.
+    void LogMessageHandler(const ezLoggingEventData& eventData);
+
+    /// \brief Opens the given file for writing the log. From now on all incoming log messages are written into it.
+    ///
+    /// If bCompress is true and zstd support is available, the file content is compressed.
+    void BeginLog(const char* szFile, bool bCompress = true);
+
+    /// \brief Writes the log into the given stream instead of a file. The stream must stay valid until EndLog() is called.
+    void BeginLog(ezStreamWriter& stream, bool bCompress = true);
+
+    /// \brief Finishes the compressed stream (if any), closes the file and stops logging the incoming messages.
+    void EndLog();
+
+    /// \brief Returns the log-file that was really opened. Might be slightly different than what was given to BeginLog, to allow parallel
+    /// execution of the same application.
+    const ezFileWriter& GetOpenedLogFile() const;
+
+    /// \brief Returns how many messages were written since BeginLog().
+    ezUInt64 GetNumWrittenMessages() const { return m_uiNumWrittenMessages; }
+
+    /// \brief Once this many distinct templates were written, the string table is reset to bound the memory usage of long running
+    /// applications.
+    static constexpr ezUInt32 MaxInternedStrings = 1024 * 16;
+
+  private:
+    ezUInt32 InternString(const char* szString);
+
+    ezFileWriter m_File;
+    ezStreamWriter* m_pOutput = nullptr;
+
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+    ezCompressedStreamWriterZstd m_Compressor;
+    bool m_bCompressed = false;
+#endif
+
+    ezInt64 m_iLastTimestamp = 0;
+    ezUInt64 m_uiNumWrittenMessages = 0;
+    ezHashTable<ezString, ezUInt32> m_InternedStrings;
+    ezStringBuilder m_sTemplate;
+    ezDynamicArray<ezUInt32> m_ArgumentRanges;
+  };
+} // namespace ezLogWriter
+
+/// \brief Reads log files that were written with ezLogWriter::Binary.
+class EZ_FOUNDATION_DLL ezBinaryLogReader
+{
+public:
+  ezBinaryLogReader();
+  ~ezBinaryLogReader();
+
+  /// \brief Reads the file header from the given stream. The stream must stay valid as long as entries are read.
+  ///
+  /// Fails if the stream does not contain a binary log or if the log is compressed and zstd support is not available.
+  ezResult Open(ezStreamReader& stream);
+
+  /// \brief Reads the next message. Returns EZ_FAILURE once the end of the log is reached.
+  ///
+  /// Logs of crashed applications may be truncated, in this case all complete messages are returned.
+  ezResult ReadNextEntry(ezBinaryLogEntry& out_Entry);
+
+  /// \brief Returns whether the log content is compressed.
+  bool IsCompressed() const { return m_bCompressed; }
+
+  /// \brief Converts an entry to a single line of text, similar to what the text based log writers output.
+  static void FormatEntry(const ezBinaryLogEntry& entry, ezStringBuilder& out_sText, ezLog::TimestampMode timestampMode = ezLog::TimestampMode::Numeric);
+
+private:
+  ezStreamReader* m_pInput = nullptr;
+
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+  ezCompressedStreamReaderZstd m_Decompressor;
+#endif
+
+  bool m_bCompressed = false;
+  ezInt64 m_iLastTimestamp = 0;
+  ezDynamicArray<ezString> m_Strings;
+};
@@ -0,0 +1,472 @@
+#include <FoundationPCH.h>
+
+#include <Foundation/Configuration/Startup.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Strings/StringBuilder.h>
+#include <Foundation/Threading/Thread.h>
+#include <Foundation/Threading/ThreadSignal.h>
+#include <Foundation/Threading/ThreadUtils.h>
+
+// clang-format off
+EZ_BEGIN_SUBSYSTEM_DECLARATION(Foundation, AsyncLog)
+
+  // no dependencies
+
+  ON_CORESYSTEMS_SHUTDOWN
+  {
+    ezGlobalLog::DisableAsyncMode();
+  }
+
+EZ_END_SUBSYSTEM_DECLARATION;
+// clang-format on
+
+namespace
+{
+  /// \brief Header of every message in a thread's ring buffer. The text and tag follow directly after it.
+  /// EndGroup messages additionally store the duration of the log block after the tag.
+  struct MessageHeader
+  {
+    ezUInt64 m_uiSequence;
+    ezInt64 m_iTimestamp; ///< When the message was logged, in microseconds, see ezTimestamp.
+    ezUInt32 m_uiRecordSize; ///< Size of the entire record, including the header. Always a multiple of sizeof(MessageHeader).
+    ezUInt32 m_uiTextLength;
+    ezUInt16 m_uiTagLength;
+    ezLogMsgType::Enum m_EventType;
+    ezUInt8 m_uiIndentation;
+    bool m_bIsPadding; ///< Marks unused space at the end of the ring buffer, the next record starts at offset zero.
+    bool m_bNullText;
+    ezUInt8 m_Padding[2];
+  };
+
+  EZ_CHECK_AT_COMPILETIME(sizeof(MessageHeader) == 32);
+
+  /// \brief Single producer / single consumer ring buffer that holds the messages of one thread.
+  ///
+  /// The write position is only modified by the owning thread, the read position only by the thread that processes the messages
+  /// (which holds s_ProcessMutex). Both positions increase monotonically, the offset into the buffer is position & (capacity - 1).
+  struct ThreadBuffer
+  {
+    /// \brief Must be created by the owning thread.
+    ThreadBuffer(ezUInt32 uiCapacity)
+      : m_uiCapacity(uiCapacity)
+      , m_uiThreadIndex(ezLog::GetCurrentThreadIndex())
+    {
+      // use new, not EZ_DEFAULT_NEW, threads may outlive the allocators
+      m_pData = new ezUInt8[uiCapacity];
+    }
+
+    ~ThreadBuffer() { delete[] m_pData; }
+
+    bool IsEmpty() const { return m_iWritePos == m_iReadPos; }
+
+    ezUInt8* m_pData = nullptr;
+    const ezUInt32 m_uiCapacity;
+    const ezUInt16 m_uiThreadIndex;
+    ezAtomicInteger64 m_iWritePos;
+    ezAtomicInteger64 m_iReadPos;
+    ezAtomicInteger64 m_iDroppedMessages;
+
+    /// One reference is held by the owning thread, one by the list of all buffers.
+    ezAtomicInteger32 m_iRefCount = 2;
+    ezAtomicBool m_bThreadExited;
+    ezAtomicBool m_bRegistered = true;
+  };
+
+  void ReleaseBuffer(ThreadBuffer* pBuffer)
+  {
+    if (pBuffer->m_iRefCount.Decrement() == 0)
+    {
+      delete pBuffer;
+    }
+  }
+
+  /// \brief Releases the buffer of a thread when the thread exits.
+  struct ThreadBufferHolder
+  {
+    ~ThreadBufferHolder()
+    {
+      if (m_pBuffer != nullptr)
+      {
+        m_pBuffer->m_bThreadExited = true;
+        ReleaseBuffer(m_pBuffer);
+      }
+    }
+
+    ThreadBuffer* m_pBuffer = nullptr;
+  };
+
+  struct QueuedMessage
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt64 m_uiSequence;
+    const MessageHeader* m_pHeader;
+    ezUInt16 m_uiThreadIndex;
+
+    bool operator<(const QueuedMessage& rhs) const { return m_uiSequence < rhs.m_uiSequence; }
+  };
+
+  static ezAsyncLogConfig s_Config;
+  static ezLoggingEvent* s_pLoggingEvent = nullptr;
+
+  static ezAtomicBool s_bAsyncModeEnabled;
+  static ezAtomicInteger32 s_iActiveProducers;
+  static ezAtomicInteger64 s_iNextSequence;
+  static ezAtomicInteger64 s_iTotalDroppedMessages;
+
+  static ezMutex s_BuffersMutex;
+  static ezDynamicArray<ThreadBuffer*, ezStaticAllocatorWrapper> s_AllBuffers;
+
+  /// Only one thread at a time may pass queued messages to the log writers, otherwise the order could not be guaranteed.
+  static ezMutex s_ProcessMutex;
+  static ezDynamicArray<QueuedMessage, ezStaticAllocatorWrapper> s_ProcessBatch;
+  static ezDynamicArray<ThreadBuffer*, ezStaticAllocatorWrapper> s_ProcessBuffers;
+  static ezDynamicArray<ezInt64, ezStaticAllocatorWrapper> s_ProcessBufferEnds;
+
+  /// Set on threads that currently pass messages to the log writers. Messages that the writers log themselves are broadcast immediately.
+  static thread_local bool s_bIsProcessingThread = false;
+  static thread_local ThreadBufferHolder s_ThreadBuffer;
+
+  static ezThreadSignal s_WakeUpSignal;
+
+  void ProcessQueuedMessages()
+  {
+    EZ_LOCK(s_ProcessMutex);
+
+    const bool bWasProcessingThread = s_bIsProcessingThread;
+    s_bIsProcessingThread = true;
+
+    {
+      EZ_LOCK(s_BuffersMutex);
+      s_ProcessBuffers = s_AllBuffers;
+    }
+
+    s_ProcessBatch.Clear();
+    s_ProcessBufferEnds.SetCountUninitialized(s_ProcessBuffers.GetCount());
+
+    // gather everything that was fully written up to now
+    for (ezUInt32 b = 0; b < s_ProcessBuffers.GetCount(); ++b)
+    {
+      ThreadBuffer* pBuffer = s_ProcessBuffers[b];
+
+      const ezInt64 iEnd = pBuffer->m_iWritePos;
+      s_ProcessBufferEnds[b] = iEnd;
+
+      for (ezInt64 iPos = pBuffer->m_iReadPos; iPos < iEnd;)
+      {
+        const MessageHeader* pHeader = reinterpret_cast<const MessageHeader*>(pBuffer->m_pData + (iPos & (pBuffer->m_uiCapacity - 1)));
+        iPos += pHeader->m_uiRecordSize;
+
+        if (pHeader->m_bIsPadding)
+          continue;
+
+        QueuedMessage& msg = s_ProcessBatch.ExpandAndGetRef();
+        msg.m_uiSequence = pHeader->m_uiSequence;
+        msg.m_pHeader = pHeader;
+        msg.m_uiThreadIndex = pBuffer->m_uiThreadIndex;
+      }
+    }
+
+    // restore the global order across threads
+    s_ProcessBatch.Sort();
+
+    for (const QueuedMessage& msg : s_ProcessBatch)
+    {
+      const char* szText = reinterpret_cast<const char*>(msg.m_pHeader + 1);
+
+      ezLoggingEventData le;
+      le.m_EventType = msg.m_pHeader->m_EventType;
+      le.m_uiIndentation = msg.m_pHeader->m_uiIndentation;
+      le.m_szText = msg.m_pHeader->m_bNullText ? nullptr : szText;
+      le.m_szTag = szText + msg.m_pHeader->m_uiTextLength + 1;
+      le.m_Timestamp = ezTimestamp(msg.m_pHeader->m_iTimestamp, ezSIUnitOfTime::Microsecond);
+      le.m_iThreadIndex = msg.m_uiThreadIndex;
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+      if (le.m_EventType == ezLogMsgType::EndGroup)
+      {
+        ezMemoryUtils::RawByteCopy(&le.m_fSeconds, le.m_szTag + msg.m_pHeader->m_uiTagLength + 1, sizeof(double));
+      }
+#endif
+
+      s_pLoggingEvent->Broadcast(le);
+    }
+
+    // only now the memory may be reused by the producers
+    for (ezUInt32 b = 0; b < s_ProcessBuffers.GetCount(); ++b)
+    {
+      ThreadBuffer* pBuffer = s_ProcessBuffers[b];
+      pBuffer->m_iReadPos = s_ProcessBufferEnds[b];
+
+      const ezInt64 iDropped = pBuffer->m_iDroppedMessages.Set(0);
+      if (iDropped > 0)
+      {
+        ezStringBuilder sText;
+        sText.Format("{0} log messages were dropped, because a thread logged more than {1} bytes between two log updates.", iDropped,
+          pBuffer->m_uiCapacity);
+
+        ezLoggingEventData le;
+        le.m_EventType = ezLogMsgType::WarningMsg;
+        le.m_szText = sText;
+        s_pLoggingEvent->Broadcast(le);
+      }
+    }
+
+    // free the buffers of threads that do not exist anymore
+    {
+      EZ_LOCK(s_BuffersMutex);
+
+      for (ezUInt32 b = s_AllBuffers.GetCount(); b > 0; --b)
+      {
+        ThreadBuffer* pBuffer = s_AllBuffers[b - 1];
+
+        if (pBuffer->m_bThreadExited && pBuffer->IsEmpty())
+        {
+          s_AllBuffers.RemoveAtAndSwap(b - 1);
+          ReleaseBuffer(pBuffer);
+        }
+      }
+    }
+
+    s_ProcessBuffers.Clear();
+    s_bIsProcessingThread = bWasProcessingThread;
+  }
+
+  ThreadBuffer* GetThreadBuffer()
+  {
+    ThreadBuffer* pBuffer = s_ThreadBuffer.m_pBuffer;
+
+    if (pBuffer != nullptr && !pBuffer->m_bRegistered)
+    {
+      // left over from a previous activation of the async mode
+      ReleaseBuffer(pBuffer);
+      pBuffer = nullptr;
+    }
+
+    if (pBuffer == nullptr)
+    {
+      pBuffer = new ThreadBuffer(s_Config.m_uiBufferSizePerThread);
+
+      EZ_LOCK(s_BuffersMutex);
+      s_AllBuffers.PushBack(pBuffer);
+    }
+
+    s_ThreadBuffer.m_pBuffer = pBuffer;
+    return pBuffer;
+  }
+
+  /// \brief Reserves uiRecordSize contiguous bytes in the buffer. Returns the start position or -1 if the buffer is full.
+  ezInt64 AllocateRecord(ThreadBuffer* pBuffer, ezUInt32 uiRecordSize)
+  {
+    const ezInt64 iWritePos = pBuffer->m_iWritePos;
+    const ezUInt32 uiOffset = static_cast<ezUInt32>(iWritePos & (pBuffer->m_uiCapacity - 1));
+    const ezUInt32 uiContiguous = pBuffer->m_uiCapacity - uiOffset;
+    const ezUInt32 uiPadding = uiContiguous < uiRecordSize ? uiContiguous : 0;
+
+    if (iWritePos + uiPadding + uiRecordSize - pBuffer->m_iReadPos > pBuffer->m_uiCapacity)
+      return -1;
+
+    if (uiPadding > 0)
+    {
+      // not enough space at the end, mark the remainder as unused and start at the beginning again
+      MessageHeader* pHeader = reinterpret_cast<MessageHeader*>(pBuffer->m_pData + uiOffset);
+      pHeader->m_uiRecordSize = uiPadding;
+      pHeader->m_bIsPadding = true;
+    }
+
+    return iWritePos + uiPadding;
+  }
+
+  class ezAsyncLogThread : public ezThread
+  {
+  public:
+    ezAsyncLogThread()
+      : ezThread("Async Log")
+    {
+    }
+
+    ezAtomicBool m_bKeepRunning = true;
+
+  private:
+    virtual ezUInt32 Run() override
+    {
+      // anything the log writers log themselves has to be broadcast synchronously
+      s_bIsProcessingThread = true;
+
+      while (m_bKeepRunning)
+      {
+        s_WakeUpSignal.WaitForSignal(s_Config.m_ProcessingInterval);
+        ProcessQueuedMessages();
+      }
+
+      return 0;
+    }
+  };
+
+  static ezAsyncLogThread* s_pLogThread = nullptr;
+} // namespace
+
+void ezGlobalLog::EnableAsyncMode(const ezAsyncLogConfig& config /*= ezAsyncLogConfig()*/)
+{
+  if (s_bAsyncModeEnabled)
+    return;
+
+  s_Config = config;
+  s_Config.m_uiBufferSizePerThread = ezMath::PowerOfTwo_Ceil(ezMath::Max<ezUInt32>(config.m_uiBufferSizePerThread, 1024));
+  s_pLoggingEvent = &s_LoggingEvent;
+
+  s_pLogThread = new ezAsyncLogThread();
+  s_pLogThread->Start();
+
+  s_bAsyncModeEnabled = true;
+}
+
+void ezGlobalLog::DisableAsyncMode()
+{
+  if (!s_bAsyncModeEnabled)
+    return;
+
+  s_bAsyncModeEnabled = false;
+
+  // wait until no thread is in the middle of queuing a message anymore
+  while (s_iActiveProducers > 0)
+  {
+    ezThreadUtils::YieldTimeSlice();
+  }
+
+  s_pLogThread->m_bKeepRunning = false;
+  s_WakeUpSignal.RaiseSignal();
+  s_pLogThread->Join();
+
+  delete s_pLogThread;
+  s_pLogThread = nullptr;
+
+  ProcessQueuedMessages();
+
+  EZ_LOCK(s_ProcessMutex);
+  EZ_LOCK(s_BuffersMutex);
+
+  for (ThreadBuffer* pBuffer : s_AllBuffers)
+  {
+    pBuffer->m_bRegistered = false;
+    ReleaseBuffer(pBuffer);
+  }
+
+  s_AllBuffers.Clear();
+  s_AllBuffers.Compact();
+  s_ProcessBatch.Clear();
+  s_ProcessBatch.Compact();
+  s_ProcessBuffers.Compact();
+  s_ProcessBufferEnds.Clear();
+  s_ProcessBufferEnds.Compact();
+}
+
+bool ezGlobalLog::IsAsyncModeEnabled()
+{
+  return s_bAsyncModeEnabled;
+}
+
+void ezGlobalLog::FlushAsyncMessages()
+{
+  if (!s_bAsyncModeEnabled)
+    return;
+
+  ProcessQueuedMessages();
+}
+
+ezUInt64 ezGlobalLog::GetNumDroppedAsyncMessages()
+{
+  return static_cast<ezUInt64>(static_cast<ezInt64>(s_iTotalDroppedMessages));
+}
+
+bool ezGlobalLog::QueueAsyncMessage(const ezLoggingEventData& le)
+{
+  if (!s_bAsyncModeEnabled || s_bIsProcessingThread)
+    return false;
+
+  s_iActiveProducers.Increment();
+  EZ_SCOPE_EXIT(s_iActiveProducers.Decrement());
+
+  // re-check, DisableAsyncMode() may have been called in between
+  if (!s_bAsyncModeEnabled)
+    return false;
+
+  ThreadBuffer* pBuffer = GetThreadBuffer();
+
+  const char* szText = le.m_szText != nullptr ? le.m_szText : "";
+  const char* szTag = le.m_szTag != nullptr ? le.m_szTag : "";
+
+  // overly long messages are truncated, so that they always fit into the buffer
+  const ezUInt32 uiMaxTextLength = pBuffer->m_uiCapacity / 4;
+  const ezUInt32 uiTextLength = ezMath::Min(ezStringUtils::GetStringElementCount(szText), uiMaxTextLength);
+  const ezUInt32 uiTagLength = ezMath::Min<ezUInt32>(ezStringUtils::GetStringElementCount(szTag), 255);
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  const ezUInt32 uiDurationSize = le.m_EventType == ezLogMsgType::EndGroup ? sizeof(double) : 0;
+#else
+  const ezUInt32 uiDurationSize = 0;
+#endif
+  const ezUInt32 uiRecordSize =
+    ezMemoryUtils::AlignSize<ezUInt32>(sizeof(MessageHeader) + uiTextLength + 1 + uiTagLength + 1 + uiDurationSize, sizeof(MessageHeader));
+
+  // taken before waiting for space in the buffer, the time of logging is what matters
+  const ezInt64 iTimestamp = ezTimestamp::CurrentTimestamp().GetInt64(ezSIUnitOfTime::Microsecond);
+
+  const bool bIsImportant = le.m_EventType == ezLogMsgType::ErrorMsg || le.m_EventType == ezLogMsgType::SeriousWarningMsg;
+  const bool bBlock = s_Config.m_OverflowPolicy == ezAsyncLogConfig::OverflowPolicy::Block || (bIsImportant && s_Config.m_bNeverDropErrors);
+
+  ezInt64 iRecordPos = AllocateRecord(pBuffer, uiRecordSize);
+
+  while (iRecordPos < 0)
+  {
+    if (!bBlock)
+    {
+      pBuffer->m_iDroppedMessages.Increment();
+      s_iTotalDroppedMessages.Increment();
+      return true;
+    }
+
+    s_WakeUpSignal.RaiseSignal();
+    ezThreadUtils::YieldTimeSlice();
+
+    iRecordPos = AllocateRecord(pBuffer, uiRecordSize);
+  }
+
+  ezUInt8* pRecord = pBuffer->m_pData + (iRecordPos & (pBuffer->m_uiCapacity - 1));
+
+  MessageHeader* pHeader = reinterpret_cast<MessageHeader*>(pRecord);
+  pHeader->m_uiSequence = static_cast<ezUInt64>(s_iNextSequence.PostIncrement());
+  pHeader->m_iTimestamp = iTimestamp;
+  pHeader->m_uiRecordSize = uiRecordSize;
+  pHeader->m_uiTextLength = uiTextLength;
+  pHeader->m_uiTagLength = static_cast<ezUInt16>(uiTagLength);
+  pHeader->m_EventType = le.m_EventType;
+  pHeader->m_uiIndentation = le.m_uiIndentation;
+  pHeader->m_bIsPadding = false;
+  pHeader->m_bNullText = le.m_szText == nullptr;
+  char* szTextDst = reinterpret_cast<char*>(pHeader + 1);
+  ezMemoryUtils::Copy(szTextDst, szText, uiTextLength);
+  szTextDst[uiTextLength] = '\0';
+
+  char* szTagDst = szTextDst + uiTextLength + 1;
+  ezMemoryUtils::Copy(szTagDst, szTag, uiTagLength);
+  szTagDst[uiTagLength] = '\0';
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  if (uiDurationSize > 0)
+  {
+    ezMemoryUtils::RawByteCopy(szTagDst + uiTagLength + 1, &le.m_fSeconds, sizeof(double));
+  }
+#endif
+
+  // publishes the record to the log thread
+  pBuffer->m_iWritePos = iRecordPos + uiRecordSize;
+
+  // errors and flush requests should reach the writers as soon as possible, also wake up the log thread before the buffer overflows
+  if (bIsImportant || le.m_EventType == ezLogMsgType::Flush || (pBuffer->m_iWritePos - pBuffer->m_iReadPos) > pBuffer->m_uiCapacity / 2)
+  {
+    s_WakeUpSignal.RaiseSignal();
+  }
+
+  return true;
+}
+
+EZ_STATICLINK_FILE(Foundation, Foundation_Logging_Implementation_AsyncLog);
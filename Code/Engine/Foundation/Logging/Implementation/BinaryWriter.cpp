@@ -0,0 +1,537 @@
+#include <FoundationPCH.h>
+
+#include <Foundation/Logging/BinaryWriter.h>
+#include <Foundation/Threading/AtomicInteger.h>
+#include <Foundation/Time/Timestamp.h>
+
+// File layout:
+//   Header:  'E' 'Z' 'B' 'L', ezUInt8 version, ezUInt8 flags
+//   Records: everything after the header, optionally zstd compressed
+//
+// Each record starts with an ezUInt8 record type:
+//   DefineString: ezUInt32 length + string bytes, the string gets the next free index
+//   ResetStrings: all previously defined strings are discarded
+//   Message:      varint zigzag timestamp delta (us), varint thread index, ezInt8 msg type, ezUInt8 indentation,
+//                 varint template index, varint tag index, varint argument count, arguments,
+//                 double seconds (only for EndGroup)
+//
+// An argument is a run of decimal digits. Short canonical numbers are stored as (value << 1),
+// everything else (leading zeros, very long runs) as ((length << 1) | 1) followed by the digit characters.
+
+namespace
+{
+  static constexpr ezUInt8 s_BinaryLogMagic[4] = {'E', 'Z', 'B', 'L'};
+  static constexpr ezUInt8 s_uiBinaryLogVersion = 1;
+  static constexpr ezUInt8 s_uiFlagCompressed = EZ_BIT(0);
+
+  // marks the position of an argument inside a template
+  static constexpr char s_ArgumentMarker = '\x1F';
+
+  enum class RecordType : ezUInt8
+  {
+    DefineString = 1,
+    ResetStrings = 2,
+    Message = 3,
+  };
+
+  using RecordBuffer = ezHybridArray<ezUInt8, 256>;
+
+  void WriteVarInt(RecordBuffer& buffer, ezUInt64 uiValue)
+  {
+    while (uiValue >= 0x80)
+    {
+      buffer.PushBack(static_cast<ezUInt8>(uiValue | 0x80));
+      uiValue >>= 7;
+    }
+
+    buffer.PushBack(static_cast<ezUInt8>(uiValue));
+  }
+
+  void WriteRaw(RecordBuffer& buffer, const void* pData, ezUInt32 uiBytes)
+  {
+    const ezUInt32 uiOffset = buffer.GetCount();
+    buffer.SetCountUninitialized(uiOffset + uiBytes);
+    ezMemoryUtils::Copy(buffer.GetData() + uiOffset, static_cast<const ezUInt8*>(pData), uiBytes);
+  }
+
+  ezResult ReadVarInt(ezStreamReader& stream, ezUInt64& out_uiValue)
+  {
+    out_uiValue = 0;
+
+    for (ezUInt32 uiShift = 0; uiShift < 64; uiShift += 7)
+    {
+      ezUInt8 uiByte = 0;
+      if (stream.ReadBytes(&uiByte, 1) != 1)
+        return EZ_FAILURE;
+
+      out_uiValue |= static_cast<ezUInt64>(uiByte & 0x7F) << uiShift;
+
+      if ((uiByte & 0x80) == 0)
+        return EZ_SUCCESS;
+    }
+
+    return EZ_FAILURE;
+  }
+
+  ezUInt64 ZigZagEncode(ezInt64 iValue) { return (static_cast<ezUInt64>(iValue) << 1) ^ static_cast<ezUInt64>(iValue >> 63); }
+  ezInt64 ZigZagDecode(ezUInt64 uiValue) { return static_cast<ezInt64>(uiValue >> 1) ^ -static_cast<ezInt64>(uiValue & 1); }
+
+  bool IsDigit(char c) { return c >= '0' && c <= '9'; }
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+
+ezLogWriter::Binary::Binary() = default;
+
+ezLogWriter::Binary::~Binary()
+{
+  EndLog();
+}
+
+void ezLogWriter::Binary::BeginLog(const char* szFile, bool bCompress /*= true*/)
+{
+  const ezUInt32 uiLogCache = 1024 * 10;
+
+  if (m_File.Open(szFile, uiLogCache, ezFileShareMode::SharedReads) == EZ_FAILURE)
+  {
+    for (ezUInt32 i = 1; i < 32; ++i)
+    {
+      const ezStringBuilder sName = ezPathUtils::GetFileName(szFile);
+
+      ezStringBuilder sNewName;
+      sNewName.Format("{0}_{1}", sName, i);
+
+      ezStringBuilder sPath = szFile;
+      sPath.ChangeFileName(sNewName.GetData());
+
+      if (m_File.Open(sPath.GetData(), uiLogCache) == EZ_SUCCESS)
+        break;
+    }
+  }
+
+  if (!m_File.IsOpen())
+  {
+    ezLog::Error("Could not open Log-File \"{0}\".", szFile);
+    return;
+  }
+
+  BeginLog(m_File, bCompress);
+}
+
+void ezLogWriter::Binary::BeginLog(ezStreamWriter& stream, bool bCompress /*= true*/)
+{
+  m_iLastTimestamp = 0;
+  m_uiNumWrittenMessages = 0;
+  m_InternedStrings.Clear();
+
+  ezUInt8 uiFlags = 0;
+
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+  m_bCompressed = bCompress;
+
+  if (bCompress)
+  {
+    uiFlags |= s_uiFlagCompressed;
+  }
+#endif
+
+  stream.WriteBytes(s_BinaryLogMagic, sizeof(s_BinaryLogMagic));
+  stream << s_uiBinaryLogVersion;
+  stream << uiFlags;
+
+  m_pOutput = &stream;
+
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+  if (m_bCompressed)
+  {
+    m_Compressor.SetOutputStream(&stream, ezCompressedStreamWriterZstd::Compression::Fastest);
+    m_pOutput = &m_Compressor;
+  }
+#endif
+}
+
+void ezLogWriter::Binary::EndLog()
+{
+  if (m_pOutput == nullptr)
+    return;
+
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+  if (m_bCompressed)
+  {
+    m_Compressor.FinishCompressedStream();
+    m_bCompressed = false;
+  }
+#endif
+
+  m_pOutput = nullptr;
+  m_InternedStrings.Clear();
+
+  if (m_File.IsOpen())
+  {
+    m_File.Close();
+  }
+}
+
+const ezFileWriter& ezLogWriter::Binary::GetOpenedLogFile() const
+{
+  return m_File;
+}
+
+void ezLogWriter::Binary::LogMessageHandler(const ezLoggingEventData& eventData)
+{
+  if (m_pOutput == nullptr)
+    return;
+
+  if (eventData.m_EventType == ezLogMsgType::Flush)
+  {
+    m_pOutput->Flush();
+    return;
+  }
+
+  const char* szText = eventData.m_szText != nullptr ? eventData.m_szText : "";
+  const char* szTag = eventData.m_szTag != nullptr ? eventData.m_szTag : "";
+
+  // split the text into the template and the digit runs, unless the text already contains the marker character
+  m_sTemplate.Clear();
+  m_ArgumentRanges.Clear();
+
+  if (ezStringUtils::FindSubString(szText, "\x1F") == nullptr)
+  {
+    const char* szPos = szText;
+    const char* szFlushedUpTo = szText;
+
+    while (*szPos != '\0')
+    {
+      if (!IsDigit(*szPos))
+      {
+        ++szPos;
+        continue;
+      }
+
+      const char* szArgStart = szPos;
+      while (IsDigit(*szPos))
+        ++szPos;
+
+      m_sTemplate.Append(ezStringView(szFlushedUpTo, szArgStart));
+      m_sTemplate.Append(s_ArgumentMarker);
+      m_ArgumentRanges.PushBack(static_cast<ezUInt32>(szArgStart - szText));
+      m_ArgumentRanges.PushBack(static_cast<ezUInt32>(szPos - szText));
+      szFlushedUpTo = szPos;
+    }
+
+    m_sTemplate.Append(szFlushedUpTo);
+  }
+  else
+  {
+    m_sTemplate = szText;
+  }
+
+  const ezUInt32 uiTemplateIndex = InternString(m_sTemplate);
+  const ezUInt32 uiTagIndex = InternString(szTag);
+
+  // in async mode the writer runs on the log thread, so the time and thread have to come from the event
+  const ezTimestamp timestamp = eventData.m_Timestamp.IsValid() ? eventData.m_Timestamp : ezTimestamp::CurrentTimestamp();
+  const ezInt64 iTimestamp = timestamp.GetInt64(ezSIUnitOfTime::Microsecond);
+  const ezUInt16 uiThreadIndex = eventData.m_iThreadIndex >= 0 ? static_cast<ezUInt16>(eventData.m_iThreadIndex) : ezLog::GetCurrentThreadIndex();
+
+  RecordBuffer record;
+  record.PushBack(static_cast<ezUInt8>(RecordType::Message));
+  WriteVarInt(record, ZigZagEncode(iTimestamp - m_iLastTimestamp));
+  WriteVarInt(record, uiThreadIndex);
+  record.PushBack(static_cast<ezUInt8>(eventData.m_EventType));
+  record.PushBack(eventData.m_uiIndentation);
+  WriteVarInt(record, uiTemplateIndex);
+  WriteVarInt(record, uiTagIndex);
+  WriteVarInt(record, m_ArgumentRanges.GetCount() / 2);
+
+  for (ezUInt32 i = 0; i < m_ArgumentRanges.GetCount(); i += 2)
+  {
+    const char* szArg = szText + m_ArgumentRanges[i];
+    const ezUInt32 uiLength = m_ArgumentRanges[i + 1] - m_ArgumentRanges[i];
+
+    // numbers with leading zeros would not survive the round trip through an integer
+    if (uiLength <= 18 && (uiLength == 1 || szArg[0] != '0'))
+    {
+      ezUInt64 uiValue = 0;
+      for (ezUInt32 c = 0; c < uiLength; ++c)
+      {
+        uiValue = uiValue * 10 + static_cast<ezUInt64>(szArg[c] - '0');
+      }
+
+      WriteVarInt(record, uiValue << 1);
+    }
+    else
+    {
+      WriteVarInt(record, (static_cast<ezUInt64>(uiLength) << 1) | 1);
+      WriteRaw(record, szArg, uiLength);
+    }
+  }
+
+  if (eventData.m_EventType == ezLogMsgType::EndGroup)
+  {
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+    const double fSeconds = eventData.m_fSeconds;
+#else
+    const double fSeconds = 0.0;
+#endif
+    WriteRaw(record, &fSeconds, sizeof(fSeconds));
+  }
+
+  m_pOutput->WriteBytes(record.GetData(), record.GetCount());
+
+  m_iLastTimestamp = iTimestamp;
+  ++m_uiNumWrittenMessages;
+
+  // make sure errors end up on disk, in case the application crashes shortly after
+  if (eventData.m_EventType == ezLogMsgType::ErrorMsg || eventData.m_EventType == ezLogMsgType::SeriousWarningMsg)
+  {
+    m_pOutput->Flush();
+  }
+}
+
+ezUInt32 ezLogWriter::Binary::InternString(const char* szString)
+{
+  ezUInt32 uiIndex = 0;
+  if (m_InternedStrings.TryGetValue(szString, uiIndex))
+    return uiIndex;
+
+  if (m_InternedStrings.GetCount() >= MaxInternedStrings)
+  {
+    const ezUInt8 uiType = static_cast<ezUInt8>(RecordType::ResetStrings);
+    m_pOutput->WriteBytes(&uiType, 1);
+    m_InternedStrings.Clear();
+  }
+
+  uiIndex = m_InternedStrings.GetCount();
+  m_InternedStrings.Insert(szString, uiIndex);
+
+  const ezUInt8 uiType = static_cast<ezUInt8>(RecordType::DefineString);
+  m_pOutput->WriteBytes(&uiType, 1);
+  m_pOutput->WriteString(szString);
+
+  return uiIndex;
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+ezBinaryLogReader::ezBinaryLogReader() = default;
+ezBinaryLogReader::~ezBinaryLogReader() = default;
+
+ezResult ezBinaryLogReader::Open(ezStreamReader& stream)
+{
+  m_pInput = nullptr;
+  m_bCompressed = false;
+  m_iLastTimestamp = 0;
+  m_Strings.Clear();
+
+  ezUInt8 magic[4];
+  if (stream.ReadBytes(magic, sizeof(magic)) != sizeof(magic) || !ezMemoryUtils::IsEqual(magic, s_BinaryLogMagic, sizeof(magic)))
+  {
+    ezLog::Error("Stream does not contain a binary log");
+    return EZ_FAILURE;
+  }
+
+  ezUInt8 uiVersion = 0;
+  ezUInt8 uiFlags = 0;
+  stream >> uiVersion;
+  stream >> uiFlags;
+
+  if (uiVersion == 0 || uiVersion > s_uiBinaryLogVersion)
+  {
+    ezLog::Error("Unsupported binary log version {0}", uiVersion);
+    return EZ_FAILURE;
+  }
+
+  m_pInput = &stream;
+  m_bCompressed = (uiFlags & s_uiFlagCompressed) != 0;
+
+  if (m_bCompressed)
+  {
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+    m_Decompressor.SetInputStream(&stream);
+    m_pInput = &m_Decompressor;
+#else
+    ezLog::Error("Binary log is compressed, but zstd support is not available");
+    m_pInput = nullptr;
+    return EZ_FAILURE;
+#endif
+  }
+
+  return EZ_SUCCESS;
+}
+
+ezResult ezBinaryLogReader::ReadNextEntry(ezBinaryLogEntry& out_Entry)
+{
+  if (m_pInput == nullptr)
+    return EZ_FAILURE;
+
+  ezStreamReader& stream = *m_pInput;
+
+  while (true)
+  {
+    ezUInt8 uiType = 0;
+    if (stream.ReadBytes(&uiType, 1) != 1)
+      return EZ_FAILURE;
+
+    switch (static_cast<RecordType>(uiType))
+    {
+      case RecordType::DefineString:
+      {
+        ezStringBuilder sString;
+        EZ_SUCCEED_OR_RETURN(stream.ReadString(sString));
+        m_Strings.PushBack(sString);
+        break;
+      }
+
+      case RecordType::ResetStrings:
+        m_Strings.Clear();
+        break;
+
+      case RecordType::Message:
+      {
+        ezUInt64 uiValue = 0;
+
+        EZ_SUCCEED_OR_RETURN(ReadVarInt(stream, uiValue));
+        m_iLastTimestamp += ZigZagDecode(uiValue);
+        out_Entry.m_iTimestamp = m_iLastTimestamp;
+
+        EZ_SUCCEED_OR_RETURN(ReadVarInt(stream, uiValue));
+        out_Entry.m_uiThreadIndex = static_cast<ezUInt16>(uiValue);
+
+        ezInt8 iMsgType = 0;
+        if (stream.ReadBytes(&iMsgType, 1) != 1 || stream.ReadBytes(&out_Entry.m_uiIndentation, 1) != 1)
+          return EZ_FAILURE;
+
+        out_Entry.m_Type = static_cast<ezLogMsgType::Enum>(iMsgType);
+
+        ezUInt64 uiTagIndex = 0;
+        ezUInt64 uiNumArgs = 0;
+        EZ_SUCCEED_OR_RETURN(ReadVarInt(stream, uiValue));
+        EZ_SUCCEED_OR_RETURN(ReadVarInt(stream, uiTagIndex));
+        EZ_SUCCEED_OR_RETURN(ReadVarInt(stream, uiNumArgs));
+
+        if (uiValue >= m_Strings.GetCount() || uiTagIndex >= m_Strings.GetCount())
+        {
+          ezLog::Error("Binary log is corrupted, invalid string index");
+          return EZ_FAILURE;
+        }
+
+        out_Entry.m_uiTemplateIndex = static_cast<ezUInt32>(uiValue);
+        out_Entry.m_sTag = m_Strings[static_cast<ezUInt32>(uiTagIndex)];
+        out_Entry.m_sText.Clear();
+
+        const char* szTemplate = m_Strings[out_Entry.m_uiTemplateIndex].GetData();
+        const char* szFlushedUpTo = szTemplate;
+
+        for (ezUInt64 arg = 0; arg < uiNumArgs; ++arg)
+        {
+          const char* szMarker = ezStringUtils::FindSubString(szFlushedUpTo, "\x1F");
+          if (szMarker == nullptr)
+          {
+            ezLog::Error("Binary log is corrupted, argument count does not match the template");
+            return EZ_FAILURE;
+          }
+
+          out_Entry.m_sText.Append(ezStringView(szFlushedUpTo, szMarker));
+          szFlushedUpTo = szMarker + 1;
+
+          EZ_SUCCEED_OR_RETURN(ReadVarInt(stream, uiValue));
+
+          if ((uiValue & 1) == 0)
+          {
+            out_Entry.m_sText.AppendFormat("{0}", uiValue >> 1);
+          }
+          else
+          {
+            char szDigits[256];
+            ezUInt64 uiRemaining = uiValue >> 1;
+
+            while (uiRemaining > 0)
+            {
+              const ezUInt32 uiChunk = static_cast<ezUInt32>(ezMath::Min<ezUInt64>(uiRemaining, sizeof(szDigits) - 1));
+              if (stream.ReadBytes(szDigits, uiChunk) != uiChunk)
+                return EZ_FAILURE;
+
+              szDigits[uiChunk] = '\0';
+              out_Entry.m_sText.Append(szDigits);
+              uiRemaining -= uiChunk;
+            }
+          }
+        }
+
+        out_Entry.m_sText.Append(szFlushedUpTo);
+
+        out_Entry.m_fSeconds = 0;
+        if (out_Entry.m_Type == ezLogMsgType::EndGroup)
+        {
+          if (stream.ReadBytes(&out_Entry.m_fSeconds, sizeof(double)) != sizeof(double))
+            return EZ_FAILURE;
+        }
+
+        return EZ_SUCCESS;
+      }
+
+      default:
+        ezLog::Error("Binary log is corrupted, unknown record type {0}", uiType);
+        return EZ_FAILURE;
+    }
+  }
+}
+
+void ezBinaryLogReader::FormatEntry(const ezBinaryLogEntry& entry, ezStringBuilder& out_sText, ezLog::TimestampMode timestampMode /*= ezLog::TimestampMode::Numeric*/)
+{
+  out_sText.Clear();
+
+  const ezDateTime dateTime(ezTimestamp(entry.m_iTimestamp, ezSIUnitOfTime::Microsecond));
+
+  switch (timestampMode)
+  {
+    case ezLog::TimestampMode::Numeric:
+      out_sText.Format("[{}] ", ezArgDateTime(dateTime, ezArgDateTime::ShowDate | ezArgDateTime::ShowMilliseconds | ezArgDateTime::ShowTimeZone));
+      break;
+    case ezLog::TimestampMode::TimeOnly:
+      out_sText.Format("[{}] ", ezArgDateTime(dateTime, ezArgDateTime::ShowMilliseconds));
+      break;
+    case ezLog::TimestampMode::Textual:
+      out_sText.Format(
+        "[{}] ", ezArgDateTime(dateTime, ezArgDateTime::TextualDate | ezArgDateTime::ShowMilliseconds | ezArgDateTime::ShowTimeZone));
+      break;
+    default:
+      break;
+  }
+
+  out_sText.AppendFormat("[T{0}] ", entry.m_uiThreadIndex);
+
+  for (ezUInt32 i = 0; i < entry.m_uiIndentation; ++i)
+    out_sText.Append(" ");
+
+  switch (entry.m_Type)
+  {
+    case ezLogMsgType::BeginGroup:
+      out_sText.AppendFormat("+++++ {0} ({1}) +++++", entry.m_sText, entry.m_sTag);
+      break;
+
+    case ezLogMsgType::EndGroup:
+      out_sText.AppendFormat("----- {0} ({1} sec)-----", entry.m_sText, ezArgF(entry.m_fSeconds, 6));
+      break;
+
+    case ezLogMsgType::ErrorMsg:
+      out_sText.AppendFormat("Error: {0}", entry.m_sText);
+      break;
+
+    case ezLogMsgType::SeriousWarningMsg:
+      out_sText.AppendFormat("Seriously: {0}", entry.m_sText);
+      break;
+
+    case ezLogMsgType::WarningMsg:
+      out_sText.AppendFormat("Warning: {0}", entry.m_sText);
+      break;
+
+    default:
+      out_sText.Append(entry.m_sText.GetView());
+      break;
+  }
+}
+
+
+EZ_STATICLINK_FILE(Foundation, Foundation_Logging_Implementation_BinaryWriter);
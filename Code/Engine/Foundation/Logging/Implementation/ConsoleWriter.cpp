@@ -29,7 +29,7 @@ ezLog::TimestampMode ezLogWriter::Console::s_TimestampMode = ezLog::TimestampMod
 void ezLogWriter::Console::LogMessageHandler(const ezLoggingEventData& eventData)
 {
   ezStringBuilder sTimestamp;
-  ezLog::GenerateFormattedTimestamp(s_TimestampMode, sTimestamp);
+  ezLog::GenerateFormattedTimestamp(s_TimestampMode, sTimestamp, eventData.m_Timestamp);
 
   static ezMutex WriterLock; // will only be created if this writer is used at all
   EZ_LOCK(WriterLock);
@@ -91,7 +91,7 @@ void ezLogWriter::HTML::LogMessageHandler(const ezLoggingEventData& eventData)
   sTag.ReplaceAll(">", "&gt;");
 
   ezStringBuilder sTimestamp;
-  ezLog::GenerateFormattedTimestamp(m_TimestampMode, sTimestamp);
+  ezLog::GenerateFormattedTimestamp(m_TimestampMode, sTimestamp, eventData.m_Timestamp);
 
   bool bFlushWriteCache = false;
 
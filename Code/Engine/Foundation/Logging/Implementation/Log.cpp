@@ -76,6 +76,9 @@ void ezGlobalLog::HandleLogMessage(const ezLoggingEventData& le)
     if ((ThisType > ezLogMsgType::None) && (ThisType < ezLogMsgType::All))
       s_uiMessageCount[ThisType].Increment();
 
+    if (QueueAsyncMessage(le))
+      return;
+
     s_LoggingEvent.Broadcast(le);
   }
 }
@@ -247,7 +250,7 @@ void ezLog::Printf(const char* szFormat, ...)
   va_end(args);
 }
 
-void ezLog::GenerateFormattedTimestamp(TimestampMode mode, ezStringBuilder& sTimestampOut)
+void ezLog::GenerateFormattedTimestamp(TimestampMode mode, ezStringBuilder& sTimestampOut, ezTimestamp timestamp /*= ezTimestamp()*/)
 {
   // if mode is 'None', early out to not even retrieve a timestamp
   if (mode == TimestampMode::None)
@@ -255,7 +258,7 @@ void ezLog::GenerateFormattedTimestamp(TimestampMode mode, ezStringBuilder& sTim
     return;
   }
 
-  const ezDateTime dateTime(ezTimestamp::CurrentTimestamp());
+  const ezDateTime dateTime(timestamp.IsValid() ? timestamp : ezTimestamp::CurrentTimestamp());
 
   switch (mode)
   {
@@ -275,6 +278,19 @@ void ezLog::GenerateFormattedTimestamp(TimestampMode mode, ezStringBuilder& sTim
   }
 }
 
+ezUInt16 ezLog::GetCurrentThreadIndex()
+{
+  static ezAtomicInteger32 s_iNextThreadIndex;
+  static thread_local ezInt32 s_iThreadIndex = -1;
+
+  if (s_iThreadIndex < 0)
+  {
+    s_iThreadIndex = s_iNextThreadIndex.PostIncrement();
+  }
+
+  return static_cast<ezUInt16>(s_iThreadIndex);
+}
+
 void ezLog::SetThreadLocalLogSystem(ezLogInterface* pInterface)
 {
   EZ_ASSERT_DEV(pInterface != nullptr,
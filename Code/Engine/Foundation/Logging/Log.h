@@ -5,6 +5,7 @@
 #include <Foundation/Strings/StringUtils.h>
 #include <Foundation/Threading/AtomicInteger.h>
 #include <Foundation/Time/Time.h>
+#include <Foundation/Time/Timestamp.h>
 
 /// \brief Use this helper macro to easily create a scoped logging group. Will generate unique variable names to make the static code
 /// analysis happy.
@@ -63,6 +64,14 @@ struct EZ_FOUNDATION_DLL ezLoggingEventData
   /// \brief Used by log-blocks for profiling the duration of the block
   double m_fSeconds = 0;
 #endif
+
+  /// \brief When the message was logged. Only set if the message reaches the log writers later, e.g. in the async mode of ezGlobalLog.
+  /// If it is invalid, the message is being logged right now.
+  ezTimestamp m_Timestamp;
+
+  /// \brief ezLog::GetCurrentThreadIndex() of the thread that logged the message. Only set if the log writers are called on another
+  /// thread, -1 means the message comes from the current thread.
+  ezInt32 m_iThreadIndex = -1;
 };
 
 using ezLoggingEvent = ezEvent<const ezLoggingEventData &, ezMutex>;
@@ -103,10 +112,37 @@ public:
 };
 
 
+/// \brief Configures the asynchronous mode of ezGlobalLog. See ezGlobalLog::EnableAsyncMode().
+struct EZ_FOUNDATION_DLL ezAsyncLogConfig
+{
+  /// \brief What to do when a thread logs more messages than fit into its buffer, before the log thread was able to process them.
+  enum class OverflowPolicy
+  {
+    Drop,  ///< The message is discarded. The number of dropped messages is reported through a warning later.
+    Block, ///< The logging thread waits until the log thread has made room in the buffer.
+  };
+
+  /// \brief How many bytes of messages each thread can have in flight. Rounded up to the next power of two.
+  ezUInt32 m_uiBufferSizePerThread = 64 * 1024;
+
+  /// \brief What happens when a thread's buffer is full.
+  OverflowPolicy m_OverflowPolicy = OverflowPolicy::Drop;
+
+  /// \brief If set, errors and serious warnings are never dropped, but always block when the buffer is full.
+  bool m_bNeverDropErrors = true;
+
+  /// \brief How often the log thread passes queued messages to the log writers. Errors and flush requests wake it up immediately.
+  ezTime m_ProcessingInterval = ezTime::Milliseconds(10);
+};
+
 /// \brief This is the standard log system that ezLog sends all messages to.
 ///
 /// It allows to register log writers, such that you can be informed of all log messages and write them
 /// to different outputs.
+///
+/// By default all log writers are executed synchronously on the thread that logs a message. In asynchronous mode (see EnableAsyncMode())
+/// messages are instead copied into a lock-free per-thread buffer and a dedicated log thread passes them to the log writers in batches,
+/// in the same order in which they were logged. This prevents that slow log writers (console, file I/O) stall the logging threads.
 class EZ_FOUNDATION_DLL ezGlobalLog : public ezLogInterface
 {
 public:
@@ -132,7 +168,34 @@ public:
   /// override is set at the moment.
   static void SetGlobalLogOverride(ezLogInterface* pInterface);
 
+  /// \brief Switches to asynchronous mode, in which log writers are executed on a dedicated log thread.
+  ///
+  /// Message formatting and filtering still happens on the logging thread, only the final text is copied into the queue.
+  /// Since log writers are executed later, timestamps that they generate may be slightly delayed.
+  /// Call FlushAsyncMessages() before anything needs to rely on all messages being written, e.g. in a crash handler.
+  static void EnableAsyncMode(const ezAsyncLogConfig& config = ezAsyncLogConfig());
+
+  /// \brief Passes all queued messages to the log writers, stops the log thread and returns to synchronous mode.
+  ///
+  /// This is called automatically during engine shutdown.
+  static void DisableAsyncMode();
+
+  /// \brief Returns whether the asynchronous mode is currently active.
+  static bool IsAsyncModeEnabled();
+
+  /// \brief Blocks until all messages that were logged before this call have been passed to the log writers.
+  ///
+  /// The queued messages are processed on the calling thread, so this works even if the log thread is stalled.
+  /// Does nothing if the asynchronous mode is not active.
+  static void FlushAsyncMessages();
+
+  /// \brief Returns how many messages were dropped in asynchronous mode, because a thread's buffer was full.
+  static ezUInt64 GetNumDroppedAsyncMessages();
+
 private:
+  /// \brief Queues the message for the log thread. Returns false if the message has to be broadcast synchronously.
+  static bool QueueAsyncMessage(const ezLoggingEventData& le);
+
   /// \brief Counts the number of messages of each type.
   static ezAtomicInteger32 s_uiMessageCount[ezLogMsgType::ENUM_COUNT];
 
@@ -344,7 +407,13 @@ public:
     TimeOnly = 3, ///< A short timestamp (time only, no timezone indicator) is added. Ex: [13:40:30.345] Log message.
   };
 
-  static void GenerateFormattedTimestamp(TimestampMode mode, ezStringBuilder& sTimestampOut);
+  /// \brief Formats \a timestamp, or the current time if it is invalid, see ezLoggingEventData::m_Timestamp.
+  static void GenerateFormattedTimestamp(TimestampMode mode, ezStringBuilder& sTimestampOut, ezTimestamp timestamp = ezTimestamp());
+
+  /// \brief Returns a small number that identifies the calling thread in log output.
+  ///
+  /// Threads are numbered in the order in which they first call this function.
+  static ezUInt16 GetCurrentThreadIndex();
 
 private:
   // Needed to call 'EndLogBlock'
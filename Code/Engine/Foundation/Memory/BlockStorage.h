@@ -63,6 +63,12 @@ public:
   void Delete(T* pObject, T*& out_pMovedObject);
 
   ezUInt32 GetCount() const;
+
+  /// \brief Returns the index of the given object, as used by GetIterator(). O(number of blocks) operation.
+  ///
+  /// For compact storage the index of the last object changes when another object is deleted, see Delete().
+  ezUInt32 GetIndex(const T* pObject) const;
+
   Iterator GetIterator(ezUInt32 uiStartIndex = 0, ezUInt32 uiCount = ezInvalidIndex);
   ConstIterator GetIterator(ezUInt32 uiStartIndex = 0, ezUInt32 uiCount = ezInvalidIndex) const;
 
@@ -86,6 +86,11 @@ void* ezInternal::ezAllocatorImpl<A, TrackingFlags>::Allocate(size_t uiSize, siz
     ezMemoryTracker::AddAllocation(this->m_Id, flags, ptr, uiSize, uiAlign, ezTime::Now() - fAllocationTime);
   }
 
+  if ((TrackingFlags & ezMemoryTrackingFlags::EnableAllocationSampling) != 0)
+  {
+    ezMemoryTracker::SampleAllocation(this->m_Id, ptr, uiSize);
+  }
+
   return ptr;
 }
 
@@ -97,6 +102,11 @@ void ezInternal::ezAllocatorImpl<A, TrackingFlags>::Deallocate(void* ptr)
     ezMemoryTracker::RemoveAllocation(this->m_Id, ptr);
   }
 
+  if ((TrackingFlags & ezMemoryTrackingFlags::EnableAllocationSampling) != 0)
+  {
+    ezMemoryTracker::RemoveSampledAllocation(ptr);
+  }
+
   m_allocator.Deallocate(ptr);
 }
 
@@ -154,6 +164,11 @@ void* ezInternal::ezAllocatorMixinReallocate<A, TrackingFlags, true>::Reallocate
     ezMemoryTracker::RemoveAllocation(this->m_Id, ptr);
   }
 
+  if ((TrackingFlags & ezMemoryTrackingFlags::EnableAllocationSampling) != 0)
+  {
+    ezMemoryTracker::RemoveSampledAllocation(ptr);
+  }
+
   ezTime fAllocationTime = ezTime::Now();
 
   void* pNewMem = this->m_allocator.Reallocate(ptr, uiCurrentSize, uiNewSize, uiAlign);
@@ -165,5 +180,11 @@ void* ezInternal::ezAllocatorMixinReallocate<A, TrackingFlags, true>::Reallocate
 
     ezMemoryTracker::AddAllocation(this->m_Id, flags, pNewMem, uiNewSize, uiAlign, ezTime::Now() - fAllocationTime);
   }
+
+  if ((TrackingFlags & ezMemoryTrackingFlags::EnableAllocationSampling) != 0)
+  {
+    ezMemoryTracker::SampleAllocation(this->m_Id, pNewMem, uiNewSize);
+  }
+
   return pNewMem;
 }
@@ -206,6 +206,24 @@ EZ_ALWAYS_INLINE ezUInt32 ezBlockStorage<T, BlockSize, StorageType>::GetCount()
   return m_uiCount;
 }
 
+template <typename T, ezUInt32 BlockSize, ezBlockStorageType::Enum StorageType>
+ezUInt32 ezBlockStorage<T, BlockSize, StorageType>::GetIndex(const T* pObject) const
+{
+  ezUInt32 uiIndex = ezInvalidIndex;
+  for (ezUInt32 uiBlockIndex = 0; uiBlockIndex < m_Blocks.GetCount(); ++uiBlockIndex)
+  {
+    ptrdiff_t diff = pObject - m_Blocks[uiBlockIndex].m_pData;
+    if (diff >= 0 && diff < ezDataBlock<T, BlockSize>::CAPACITY)
+    {
+      uiIndex = uiBlockIndex * ezDataBlock<T, BlockSize>::CAPACITY + (ezInt32)diff;
+      break;
+    }
+  }
+
+  EZ_ASSERT_DEV(uiIndex != ezInvalidIndex, "Invalid object {0} was not found in block storage.", ezArgP(pObject));
+  return uiIndex;
+}
+
 template <typename T, ezUInt32 BlockSize, ezBlockStorageType::Enum StorageType>
 EZ_ALWAYS_INLINE typename ezBlockStorage<T, BlockSize, StorageType>::Iterator ezBlockStorage<T, BlockSize, StorageType>::GetIterator(
   ezUInt32 uiStartIndex /*= 0*/, ezUInt32 uiCount /*= ezInvalidIndex*/)
@@ -248,18 +266,7 @@ EZ_FORCE_INLINE void ezBlockStorage<T, BlockSize, StorageType>::Delete(T* pObjec
 template <typename T, ezUInt32 BlockSize, ezBlockStorageType::Enum StorageType>
 EZ_FORCE_INLINE void ezBlockStorage<T, BlockSize, StorageType>::Delete(T* pObject, T*& out_pMovedObject, ezTraitInt<ezBlockStorageType::FreeList>)
 {
-  ezUInt32 uiIndex = ezInvalidIndex;
-  for (ezUInt32 uiBlockIndex = 0; uiBlockIndex < m_Blocks.GetCount(); ++uiBlockIndex)
-  {
-    ptrdiff_t diff = pObject - m_Blocks[uiBlockIndex].m_pData;
-    if (diff >= 0 && diff < ezDataBlock<T, BlockSize>::CAPACITY)
-    {
-      uiIndex = uiBlockIndex * ezDataBlock<T, BlockSize>::CAPACITY + (ezInt32)diff;
-      break;
-    }
-  }
-
-  EZ_ASSERT_DEV(uiIndex != ezInvalidIndex, "Invalid object {0} was not found in block storage.", ezArgP(pObject));
+  const ezUInt32 uiIndex = GetIndex(pObject);
 
   m_UsedEntries.ClearBit(uiIndex);
 
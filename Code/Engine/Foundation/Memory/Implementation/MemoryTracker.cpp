@@ -3,12 +3,15 @@
 #include <Foundation/Containers/HashTable.h>
 #include <Foundation/Containers/IdTable.h>
 #include <Foundation/Logging/Log.h>
+#include <Foundation/Math/Math.h>
 #include <Foundation/Memory/Allocator.h>
 #include <Foundation/Memory/Policies/HeapAllocation.h>
 #include <Foundation/Strings/String.h>
 #include <Foundation/System/StackTracer.h>
+#include <Foundation/Threading/AtomicUtils.h>
 #include <Foundation/Threading/Lock.h>
 #include <Foundation/Threading/Mutex.h>
+#include <Foundation/Time/Time.h>
 
 #if EZ_ENABLED(EZ_PLATFORM_WINDOWS)
 #  include <Foundation/Basics/Platform/Win/IncludeWindows.h>
@@ -84,6 +87,88 @@ namespace
     s_bIsInitializing = false;
   }
 
+  // Live sampled allocations. The keys are the allocation pointers, a sample is looked up by probing at most MaxProbes slots starting at
+  // the hash of the pointer. Removed keys are set back to zero, which is why lookups always check all MaxProbes slots.
+  struct SampleTable
+  {
+    enum
+    {
+      MaxProbes = 16
+    };
+
+    volatile ezInt64 m_Keys[ezMemoryTracker::MaxSampledAllocations];
+    volatile ezInt32 m_Valid[ezMemoryTracker::MaxSampledAllocations];
+    ezMemoryTracker::SampledAllocation m_Samples[ezMemoryTracker::MaxSampledAllocations];
+
+    volatile ezInt32 m_iNumSamples;
+    volatile ezInt64 m_iNumDroppedSamples;
+
+    static EZ_ALWAYS_INLINE ezUInt32 GetStartSlot(ezInt64 iKey)
+    {
+      EZ_CHECK_AT_COMPILETIME(ezMemoryTracker::MaxSampledAllocations == (1 << 13));
+      return static_cast<ezUInt32>(((static_cast<ezUInt64>(iKey) >> 4) * 0x9E3779B97F4A7C15ull) >> (64 - 13));
+    }
+  };
+
+  struct SamplingThreadState
+  {
+    ezInt64 m_iBytesUntilSample;
+    ezUInt64 m_uiRandomState;
+  };
+
+  static SampleTable* volatile s_pSampleTable = nullptr;
+  static volatile ezInt32 s_iSamplingInterval = ezMemoryTracker::DefaultSamplingInterval;
+  static thread_local SamplingThreadState t_SamplingState;
+
+  static ezInt64 ComputeNextSampleDistance(SamplingThreadState& state, ezUInt32 uiInterval)
+  {
+    // xorshift64*
+    state.m_uiRandomState ^= state.m_uiRandomState >> 12;
+    state.m_uiRandomState ^= state.m_uiRandomState << 25;
+    state.m_uiRandomState ^= state.m_uiRandomState >> 27;
+    const ezUInt64 uiRandom = state.m_uiRandomState * 0x2545F4914F6CDD1Dull;
+
+    // exponentially distributed distance, so that every allocated byte has the same chance of being sampled
+    const float fUniform = (static_cast<float>(uiRandom >> 40) + 1.0f) / static_cast<float>(1 << 24);
+    return static_cast<ezInt64>(-ezMath::Ln(fUniform) * uiInterval) + 1;
+  }
+
+  static double ComputeSampleWeight(size_t uiSize, ezUInt32 uiInterval)
+  {
+    // an allocation of size s is sampled with probability 1 - e^(-s/interval)
+    const double fRatio = static_cast<double>(uiSize) / uiInterval;
+    const double fProbability = fRatio < 0.01 ? fRatio * (1.0 - fRatio * 0.5) : 1.0 - ezMath::Exp(static_cast<float>(-fRatio));
+    return 1.0 / fProbability;
+  }
+
+  static void RecordSample(SampleTable* pTable, ezAllocatorId allocatorId, const void* ptr, size_t uiSize, ezUInt32 uiInterval)
+  {
+    const ezInt64 iKey = reinterpret_cast<ezInt64>(ptr);
+    const ezUInt32 uiStartSlot = SampleTable::GetStartSlot(iKey);
+
+    for (ezUInt32 i = 0; i < SampleTable::MaxProbes; ++i)
+    {
+      const ezUInt32 uiSlot = (uiStartSlot + i) & (ezMemoryTracker::MaxSampledAllocations - 1);
+
+      if (pTable->m_Keys[uiSlot] == 0 && ezAtomicUtils::TestAndSet(pTable->m_Keys[uiSlot], 0, iKey))
+      {
+        ezMemoryTracker::SampledAllocation& sample = pTable->m_Samples[uiSlot];
+        sample.m_AllocatorId = allocatorId;
+        sample.m_uiSize = uiSize;
+        sample.m_fWeight = ComputeSampleWeight(uiSize, uiInterval);
+
+        ezArrayPtr<void*> stackTrace(sample.m_StackTrace);
+        sample.m_uiStackTraceLength = ezStackTracer::GetStackTrace(stackTrace);
+
+        ezAtomicUtils::Set(pTable->m_Valid[uiSlot], 1);
+        ezAtomicUtils::Increment(pTable->m_iNumSamples);
+        return;
+      }
+    }
+
+    ezAtomicUtils::Increment(pTable->m_iNumDroppedSamples);
+  }
+
   static void DumpLeak(const ezMemoryTracker::AllocationInfo& info, const char* szAllocatorName)
   {
     char szBuffer[512];
@@ -183,6 +268,18 @@ void ezMemoryTracker::DeregisterAllocator(ezAllocatorId allocatorId)
   }
 
   s_pTrackerData->m_AllocatorData.Remove(allocatorId);
+
+  // drop samples of allocations that were not freed through the allocator, e.g. because it was reset as a whole
+  if (SampleTable* pTable = s_pSampleTable)
+  {
+    for (ezUInt32 uiSlot = 0; uiSlot < MaxSampledAllocations; ++uiSlot)
+    {
+      if (pTable->m_Valid[uiSlot] != 0 && pTable->m_Samples[uiSlot].m_AllocatorId == allocatorId)
+      {
+        ezMemoryTracker::RemoveSampledAllocation(reinterpret_cast<const void*>(pTable->m_Keys[uiSlot]));
+      }
+    }
+  }
 }
 
 // static
@@ -423,6 +520,118 @@ void ezMemoryTracker::DumpMemoryLeaks()
   }
 }
 
+// static
+void ezMemoryTracker::SetAllocationSamplingInterval(ezUInt32 uiAverageBytes)
+{
+  ezAtomicUtils::Set(s_iSamplingInterval, static_cast<ezInt32>(ezMath::Min<ezUInt32>(uiAverageBytes, ezMath::MaxValue<ezInt32>())));
+}
+
+// static
+ezUInt32 ezMemoryTracker::GetAllocationSamplingInterval()
+{
+  return static_cast<ezUInt32>(s_iSamplingInterval);
+}
+
+// static
+void ezMemoryTracker::SampleAllocation(ezAllocatorId allocatorId, const void* ptr, size_t uiSize)
+{
+  const ezUInt32 uiInterval = static_cast<ezUInt32>(s_iSamplingInterval);
+  if (uiInterval == 0)
+    return;
+
+  SamplingThreadState& state = t_SamplingState;
+  state.m_iBytesUntilSample -= static_cast<ezInt64>(uiSize);
+
+  if (state.m_iBytesUntilSample > 0)
+    return;
+
+  if (state.m_uiRandomState == 0)
+  {
+    // first allocation on this thread, thread local data is zero initialized
+    state.m_uiRandomState = (reinterpret_cast<ezUInt64>(&state) ^ static_cast<ezUInt64>(ezTime::Now().GetNanoseconds())) | 1;
+    state.m_iBytesUntilSample = ComputeNextSampleDistance(state, uiInterval) - static_cast<ezInt64>(uiSize);
+
+    if (state.m_iBytesUntilSample > 0)
+      return;
+  }
+
+  state.m_iBytesUntilSample = ComputeNextSampleDistance(state, uiInterval);
+
+  SampleTable* pTable = s_pSampleTable;
+  if (pTable == nullptr)
+  {
+    EZ_LOCK(*s_pTrackerData);
+
+    if (s_pSampleTable == nullptr)
+    {
+      s_pSampleTable = EZ_NEW(s_pTrackerDataAllocator, SampleTable);
+    }
+
+    pTable = s_pSampleTable;
+  }
+
+  RecordSample(pTable, allocatorId, ptr, uiSize, uiInterval);
+}
+
+// static
+void ezMemoryTracker::RemoveSampledAllocation(const void* ptr)
+{
+  // Plain volatile reads, the atomic read functions would write to the shared cache lines.
+  SampleTable* pTable = s_pSampleTable;
+  if (pTable == nullptr || pTable->m_iNumSamples == 0 || ptr == nullptr)
+    return;
+
+  const ezInt64 iKey = reinterpret_cast<ezInt64>(ptr);
+  const ezUInt32 uiStartSlot = SampleTable::GetStartSlot(iKey);
+
+  for (ezUInt32 i = 0; i < SampleTable::MaxProbes; ++i)
+  {
+    const ezUInt32 uiSlot = (uiStartSlot + i) & (MaxSampledAllocations - 1);
+
+    if (pTable->m_Keys[uiSlot] == iKey)
+    {
+      ezAtomicUtils::Set(pTable->m_Valid[uiSlot], 0);
+      ezAtomicUtils::Set(pTable->m_Keys[uiSlot], 0);
+      ezAtomicUtils::Decrement(pTable->m_iNumSamples);
+      return;
+    }
+  }
+}
+
+// static
+ezUInt32 ezMemoryTracker::GetSampledAllocations(ezArrayPtr<SampledAllocation> out_Samples)
+{
+  SampleTable* pTable = s_pSampleTable;
+  if (pTable == nullptr)
+    return 0;
+
+  ezUInt32 uiNumSamples = 0;
+
+  for (ezUInt32 uiSlot = 0; uiSlot < MaxSampledAllocations && uiNumSamples < out_Samples.GetCount(); ++uiSlot)
+  {
+    const ezInt64 iKey = pTable->m_Keys[uiSlot];
+    if (iKey == 0 || pTable->m_Valid[uiSlot] == 0)
+      continue;
+
+    out_Samples[uiNumSamples] = pTable->m_Samples[uiSlot];
+
+    // skip the sample if it was removed while copying it
+    if (pTable->m_Keys[uiSlot] == iKey && pTable->m_Valid[uiSlot] != 0)
+    {
+      ++uiNumSamples;
+    }
+  }
+
+  return uiNumSamples;
+}
+
+// static
+ezUInt64 ezMemoryTracker::GetNumDroppedSamples()
+{
+  SampleTable* pTable = s_pSampleTable;
+  return pTable != nullptr ? static_cast<ezUInt64>(ezAtomicUtils::Read(pTable->m_iNumDroppedSamples)) : 0;
+}
+
 // static
 ezMemoryTracker::Iterator ezMemoryTracker::GetIterator()
 {
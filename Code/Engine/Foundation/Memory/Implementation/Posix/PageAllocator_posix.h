@@ -2,7 +2,7 @@
 #include <Foundation/Time/Time.h>
 
 // static
-void* ezPageAllocator::AllocatePage(size_t uiSize)
+void* ezPageAllocator::AllocatePage(size_t uiSize, ezBitflags<ezMemoryTrackingFlags> flags)
 {
   ezTime fAllocationTime = ezTime::Now();
 
@@ -14,15 +14,21 @@ void* ezPageAllocator::AllocatePage(size_t uiSize)
 
   EZ_CHECK_ALIGNMENT(ptr, uiAlign);
 
-  ezMemoryTracker::AddAllocation(GetPageAllocatorId(), ezMemoryTrackingFlags::Default, ptr, uiSize, uiAlign, ezTime::Now() - fAllocationTime);
+  if (flags.IsSet(ezMemoryTrackingFlags::EnableAllocationTracking))
+  {
+    ezMemoryTracker::AddAllocation(GetPageAllocatorId(), flags, ptr, uiSize, uiAlign, ezTime::Now() - fAllocationTime);
+  }
 
   return ptr;
 }
 
 // static
-void ezPageAllocator::DeallocatePage(void* ptr)
+void ezPageAllocator::DeallocatePage(void* ptr, ezBitflags<ezMemoryTrackingFlags> flags)
 {
-  ezMemoryTracker::RemoveAllocation(GetPageAllocatorId(), ptr);
+  if (flags.IsSet(ezMemoryTrackingFlags::EnableAllocationTracking))
+  {
+    ezMemoryTracker::RemoveAllocation(GetPageAllocatorId(), ptr);
+  }
 
   free(ptr);
 }
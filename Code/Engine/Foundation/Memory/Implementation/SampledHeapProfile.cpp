@@ -0,0 +1,235 @@
+#include <FoundationPCH.h>
+
+#include <Foundation/Algorithm/HashingUtils.h>
+#include <Foundation/Containers/HashTable.h>
+#include <Foundation/IO/Stream.h>
+#include <Foundation/Memory/CommonAllocators.h>
+#include <Foundation/Memory/SampledHeapProfile.h>
+#include <Foundation/System/StackTracer.h>
+
+enum class ezSampledHeapProfileVersion : ezUInt8
+{
+  Version1 = 1,
+
+  // insert new version numbers above
+  ENUM_COUNT,
+  Current = ENUM_COUNT - 1
+};
+
+namespace
+{
+  EZ_ALWAYS_INLINE ezUInt64 GetEntryKey(const ezSampledHeapProfile::Entry& entry)
+  {
+    return ezHashingUtils::xxHash64(entry.m_sAllocatorName.GetData(), entry.m_sAllocatorName.GetElementCount(), entry.m_uiStackHash);
+  }
+} // namespace
+
+void ezSampledHeapProfile::Capture()
+{
+  Clear();
+
+  m_CaptureTime = ezTimestamp::CurrentTimestamp();
+  m_uiSamplingInterval = ezMemoryTracker::GetAllocationSamplingInterval();
+
+  // the temporary sample buffer is large, it must not show up in the profile itself
+  ezAllocator<ezMemoryPolicies::ezHeapAllocation, ezMemoryTrackingFlags::None> tempAllocator("SampledHeapProfile");
+
+  ezDynamicArray<ezMemoryTracker::SampledAllocation> samples(&tempAllocator);
+  samples.SetCountUninitialized(ezMemoryTracker::MaxSampledAllocations);
+  samples.SetCountUninitialized(ezMemoryTracker::GetSampledAllocations(samples));
+
+  ezHashTable<ezUInt32, ezString> allocatorNames;
+  for (auto it = ezMemoryTracker::GetIterator(); it.IsValid(); ++it)
+  {
+    allocatorNames.Insert(it.Id().m_Data, it.Name());
+  }
+
+  ezHashTable<ezUInt64, ezUInt32> entryIndices;
+
+  for (const ezMemoryTracker::SampledAllocation& sample : samples)
+  {
+    const ezString* pAllocatorName = nullptr;
+    if (!allocatorNames.TryGetValue(sample.m_AllocatorId.m_Data, pAllocatorName))
+      continue;
+
+    Entry tempEntry;
+    tempEntry.m_sAllocatorName = *pAllocatorName;
+    tempEntry.m_uiStackHash = ezHashingUtils::xxHash64(sample.m_StackTrace, sample.m_uiStackTraceLength * sizeof(void*));
+
+    ezUInt32 uiEntryIndex = m_Entries.GetCount();
+    if (!entryIndices.TryGetValue(GetEntryKey(tempEntry), uiEntryIndex))
+    {
+      entryIndices.Insert(GetEntryKey(tempEntry), uiEntryIndex);
+
+      Entry& entry = m_Entries.ExpandAndGetRef();
+      entry.m_sAllocatorName = tempEntry.m_sAllocatorName;
+      entry.m_uiStackHash = tempEntry.m_uiStackHash;
+
+      entry.m_StackTrace.SetCountUninitialized(sample.m_uiStackTraceLength);
+      for (ezUInt32 i = 0; i < sample.m_uiStackTraceLength; ++i)
+      {
+        entry.m_StackTrace[i] = reinterpret_cast<ezUInt64>(sample.m_StackTrace[i]);
+      }
+    }
+
+    Entry& entry = m_Entries[uiEntryIndex];
+    entry.m_fEstimatedBytes += sample.m_fWeight * sample.m_uiSize;
+    entry.m_fEstimatedAllocations += sample.m_fWeight;
+    entry.m_uiNumSamples++;
+  }
+
+  SortEntries();
+}
+
+void ezSampledHeapProfile::Clear()
+{
+  m_CaptureTime.Invalidate();
+  m_uiSamplingInterval = 0;
+  m_Entries.Clear();
+}
+
+void ezSampledHeapProfile::ComputeDifference(const ezSampledHeapProfile& before, const ezSampledHeapProfile& after)
+{
+  EZ_ASSERT_DEV(this != &before && this != &after, "The result of a difference can't be one of the inputs");
+
+  Clear();
+
+  m_CaptureTime = after.m_CaptureTime;
+  m_uiSamplingInterval = after.m_uiSamplingInterval;
+
+  ezHashTable<ezUInt64, ezUInt32> entryIndices;
+
+  for (const Entry& afterEntry : after.m_Entries)
+  {
+    entryIndices.Insert(GetEntryKey(afterEntry), m_Entries.GetCount());
+    m_Entries.PushBack(afterEntry);
+  }
+
+  for (const Entry& beforeEntry : before.m_Entries)
+  {
+    ezUInt32 uiEntryIndex = m_Entries.GetCount();
+    if (!entryIndices.TryGetValue(GetEntryKey(beforeEntry), uiEntryIndex))
+    {
+      Entry& entry = m_Entries.ExpandAndGetRef();
+      entry.m_sAllocatorName = beforeEntry.m_sAllocatorName;
+      entry.m_uiStackHash = beforeEntry.m_uiStackHash;
+      entry.m_StackTrace = beforeEntry.m_StackTrace;
+    }
+
+    Entry& entry = m_Entries[uiEntryIndex];
+    entry.m_fEstimatedBytes -= beforeEntry.m_fEstimatedBytes;
+    entry.m_fEstimatedAllocations -= beforeEntry.m_fEstimatedAllocations;
+    entry.m_uiNumSamples = ezMath::Max(entry.m_uiNumSamples, beforeEntry.m_uiNumSamples);
+  }
+
+  for (ezUInt32 i = m_Entries.GetCount(); i > 0; --i)
+  {
+    if (m_Entries[i - 1].m_fEstimatedBytes == 0.0 && m_Entries[i - 1].m_fEstimatedAllocations == 0.0)
+    {
+      m_Entries.RemoveAtAndSwap(i - 1);
+    }
+  }
+
+  SortEntries();
+}
+
+double ezSampledHeapProfile::GetEstimatedBytes(ezStringView sAllocatorName) const
+{
+  double fBytes = 0.0;
+
+  for (const Entry& entry : m_Entries)
+  {
+    if (sAllocatorName.IsEmpty() || entry.m_sAllocatorName == sAllocatorName)
+    {
+      fBytes += entry.m_fEstimatedBytes;
+    }
+  }
+
+  return fBytes;
+}
+
+void ezSampledHeapProfile::Save(ezStreamWriter& stream) const
+{
+  stream << (ezUInt8)ezSampledHeapProfileVersion::Current;
+  stream << m_CaptureTime;
+  stream << m_uiSamplingInterval;
+  stream << m_Entries.GetCount();
+
+  for (const Entry& entry : m_Entries)
+  {
+    stream << entry.m_sAllocatorName;
+    stream << entry.m_uiStackHash;
+    stream << entry.m_fEstimatedBytes;
+    stream << entry.m_fEstimatedAllocations;
+    stream << entry.m_uiNumSamples;
+    stream.WriteArray(entry.m_StackTrace);
+  }
+}
+
+ezResult ezSampledHeapProfile::Load(ezStreamReader& stream)
+{
+  Clear();
+
+  ezUInt8 uiVersion = 0;
+  stream >> uiVersion;
+
+  if (uiVersion == 0 || uiVersion > (ezUInt8)ezSampledHeapProfileVersion::Current)
+  {
+    ezLog::Error("Sampled heap profile has incorrect version ({0})", uiVersion);
+    return EZ_FAILURE;
+  }
+
+  stream >> m_CaptureTime;
+  stream >> m_uiSamplingInterval;
+
+  ezUInt32 uiNumEntries = 0;
+  stream >> uiNumEntries;
+  m_Entries.SetCount(uiNumEntries);
+
+  for (Entry& entry : m_Entries)
+  {
+    stream >> entry.m_sAllocatorName;
+    stream >> entry.m_uiStackHash;
+    stream >> entry.m_fEstimatedBytes;
+    stream >> entry.m_fEstimatedAllocations;
+    stream >> entry.m_uiNumSamples;
+    EZ_SUCCEED_OR_RETURN(stream.ReadArray(entry.m_StackTrace));
+  }
+
+  return EZ_SUCCESS;
+}
+
+void ezSampledHeapProfile::WriteReport(ezStringBuilder& out_sReport, ezUInt32 uiMaxEntries, bool bResolveStackTraces) const
+{
+  out_sReport.Clear();
+  out_sReport.AppendFormat("Sampled heap profile: {0} KB estimated in {1} call stacks, sampling interval {2} bytes\n",
+    ezArgF(GetEstimatedBytes() / 1024.0, 1), m_Entries.GetCount(), m_uiSamplingInterval);
+
+  ezHybridArray<void*, ezMemoryTracker::SampledAllocation::MaxStackTraceLength> stackTrace;
+
+  for (ezUInt32 i = 0; i < ezMath::Min(uiMaxEntries, m_Entries.GetCount()); ++i)
+  {
+    const Entry& entry = m_Entries[i];
+
+    out_sReport.AppendFormat("\n{0} KB in {1} allocations ({2} samples) from '{3}'\n", ezArgF(entry.m_fEstimatedBytes / 1024.0, 1),
+      ezArgF(entry.m_fEstimatedAllocations, 0), entry.m_uiNumSamples, entry.m_sAllocatorName);
+
+    if (bResolveStackTraces && !entry.m_StackTrace.IsEmpty())
+    {
+      stackTrace.SetCountUninitialized(entry.m_StackTrace.GetCount());
+      for (ezUInt32 j = 0; j < stackTrace.GetCount(); ++j)
+      {
+        stackTrace[j] = reinterpret_cast<void*>(entry.m_StackTrace[j]);
+      }
+
+      ezStackTracer::ResolveStackTrace(stackTrace.GetArrayPtr(), [&out_sReport](const char* szText) { out_sReport.Append("  ", szText); });
+    }
+  }
+}
+
+void ezSampledHeapProfile::SortEntries()
+{
+  m_Entries.Sort([](const Entry& a, const Entry& b) { return a.m_fEstimatedBytes > b.m_fEstimatedBytes; });
+}
+
+EZ_STATICLINK_FILE(Foundation, Foundation_Memory_Implementation_SampledHeapProfile);
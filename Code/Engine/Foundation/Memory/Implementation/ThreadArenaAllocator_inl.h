@@ -0,0 +1,81 @@
+template <ezUInt32 TrackingFlags>
+ezThreadArenaAllocator<TrackingFlags>::ezThreadArenaAllocator(const char* szName, ezAllocatorBase* pParent)
+  : ezAllocator<ezMemoryPolicies::ezThreadArenaAllocation, TrackingFlags>(szName, pParent)
+{
+}
+
+template <ezUInt32 TrackingFlags>
+ezThreadArenaAllocator<TrackingFlags>::~ezThreadArenaAllocator()
+{
+  Reset();
+}
+
+template <ezUInt32 TrackingFlags>
+void* ezThreadArenaAllocator<TrackingFlags>::Allocate(size_t uiSize, size_t uiAlign, ezMemoryUtils::DestructorFunction destructorFunc)
+{
+  void* ptr = ezAllocator<ezMemoryPolicies::ezThreadArenaAllocation, TrackingFlags>::Allocate(uiSize, uiAlign, destructorFunc);
+
+  if (destructorFunc != nullptr && ptr != nullptr)
+  {
+    this->m_allocator.AddDestructor(ptr, destructorFunc);
+  }
+
+  return ptr;
+}
+
+template <ezUInt32 TrackingFlags>
+void ezThreadArenaAllocator<TrackingFlags>::Deallocate(void* ptr)
+{
+  if (ptr == nullptr)
+    return;
+
+  // the object has been destroyed already, so its destructor must not be called again on reset
+  this->m_allocator.RemoveDestructor(ptr);
+
+  ezAllocator<ezMemoryPolicies::ezThreadArenaAllocation, TrackingFlags>::Deallocate(ptr);
+}
+
+template <ezUInt32 TrackingFlags>
+ezAllocatorBase::Stats ezThreadArenaAllocator<TrackingFlags>::GetStats() const
+{
+  if ((TrackingFlags & ezMemoryTrackingFlags::EnableAllocationTracking) != 0)
+  {
+    return ezMemoryTracker::GetAllocatorStats(this->m_Id);
+  }
+
+  ezAllocatorBase::Stats stats;
+  this->m_allocator.FillStats(stats);
+
+  if ((TrackingFlags & ezMemoryTrackingFlags::RegisterAllocator) != 0)
+  {
+    ezMemoryTracker::SetAllocatorStats(this->m_Id, stats);
+  }
+
+  return stats;
+}
+
+EZ_MSVC_ANALYSIS_WARNING_PUSH
+
+// Disable warning for incorrect operator (compiler complains about the TrackingFlags bitwise and in the case that flags = None)
+// even with the added guard of a check that it can't be 0.
+EZ_MSVC_ANALYSIS_WARNING_DISABLE(6313)
+
+template <ezUInt32 TrackingFlags>
+void ezThreadArenaAllocator<TrackingFlags>::Reset()
+{
+  this->m_allocator.Reset();
+
+  if ((TrackingFlags & ezMemoryTrackingFlags::EnableAllocationTracking) != 0)
+  {
+    ezMemoryTracker::RemoveAllAllocations(this->m_Id);
+  }
+  else if ((TrackingFlags & ezMemoryTrackingFlags::RegisterAllocator) != 0)
+  {
+    ezAllocatorBase::Stats stats;
+    this->m_allocator.FillStats(stats);
+
+    ezMemoryTracker::SetAllocatorStats(this->m_Id, stats);
+  }
+}
+
+EZ_MSVC_ANALYSIS_WARNING_POP
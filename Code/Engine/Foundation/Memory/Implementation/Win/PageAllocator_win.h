@@ -5,7 +5,7 @@ EZ_FOUNDATION_INTERNAL_HEADER
 #include <Foundation/Time/Time.h>
 
 // static
-void* ezPageAllocator::AllocatePage(size_t uiSize)
+void* ezPageAllocator::AllocatePage(size_t uiSize, ezBitflags<ezMemoryTrackingFlags> flags)
 {
   ezTime fAllocationTime = ezTime::Now();
 
@@ -15,15 +15,21 @@ void* ezPageAllocator::AllocatePage(size_t uiSize)
   size_t uiAlign = ezSystemInformation::Get().GetMemoryPageSize();
   EZ_CHECK_ALIGNMENT(ptr, uiAlign);
 
-  ezMemoryTracker::AddAllocation(GetPageAllocatorId(), ezMemoryTrackingFlags::Default, ptr, uiSize, uiAlign, ezTime::Now() - fAllocationTime);
+  if (flags.IsSet(ezMemoryTrackingFlags::EnableAllocationTracking))
+  {
+    ezMemoryTracker::AddAllocation(GetPageAllocatorId(), flags, ptr, uiSize, uiAlign, ezTime::Now() - fAllocationTime);
+  }
 
   return ptr;
 }
 
 // static
-void ezPageAllocator::DeallocatePage(void* ptr)
+void ezPageAllocator::DeallocatePage(void* ptr, ezBitflags<ezMemoryTrackingFlags> flags)
 {
-  ezMemoryTracker::RemoveAllocation(GetPageAllocatorId(), ptr);
+  if (flags.IsSet(ezMemoryTrackingFlags::EnableAllocationTracking))
+  {
+    ezMemoryTracker::RemoveAllocation(GetPageAllocatorId(), ptr);
+  }
 
   EZ_VERIFY(::VirtualFree(ptr, 0, MEM_RELEASE), "Could not free memory pages. Error Code '{0}'", ezArgErrorCode(::GetLastError()));
 }
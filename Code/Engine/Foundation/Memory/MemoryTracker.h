@@ -15,8 +15,9 @@ struct ezMemoryTrackingFlags
                                    ///< allocator implementation whether it collects usable stats or not.
     EnableAllocationTracking = EZ_BIT(1), ///< Enable tracking of individual allocations
     EnableStackTrace = EZ_BIT(2),         ///< Enable stack traces for each allocation
+    EnableAllocationSampling = EZ_BIT(3), ///< Record a random sample of the allocations, see ezMemoryTracker::SetAllocationSamplingInterval
 
-    All = RegisterAllocator | EnableAllocationTracking | EnableStackTrace,
+    All = RegisterAllocator | EnableAllocationTracking | EnableStackTrace | EnableAllocationSampling,
 
     Default = 0
 #if EZ_ENABLED(EZ_USE_ALLOCATION_TRACKING)
@@ -24,6 +25,9 @@ struct ezMemoryTrackingFlags
 #endif
 #if EZ_ENABLED(EZ_USE_ALLOCATION_STACK_TRACING)
               | EnableStackTrace
+#endif
+#if EZ_ENABLED(EZ_USE_ALLOCATION_SAMPLING)
+              | RegisterAllocator | EnableAllocationSampling
 #endif
   };
 
@@ -32,6 +36,7 @@ struct ezMemoryTrackingFlags
     StorageType RegisterAllocator : 1;
     StorageType EnableAllocationTracking : 1;
     StorageType EnableStackTrace : 1;
+    StorageType EnableAllocationSampling : 1;
   };
 };
 
@@ -72,6 +77,25 @@ public:
     }
   };
 
+  /// \brief A live allocation that was picked by allocation sampling.
+  struct SampledAllocation
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    enum
+    {
+      MaxStackTraceLength = 24
+    };
+
+    ezAllocatorId m_AllocatorId;
+    size_t m_uiSize;
+    double m_fWeight; ///< How many allocations of this size this sample represents statistically.
+    ezUInt32 m_uiStackTraceLength;
+    void* m_StackTrace[MaxStackTraceLength];
+
+    EZ_ALWAYS_INLINE ezArrayPtr<void* const> GetStackTrace() const { return ezArrayPtr<void* const>(m_StackTrace, m_uiStackTraceLength); }
+  };
+
   class EZ_FOUNDATION_DLL Iterator
   {
   public:
@@ -116,5 +140,40 @@ public:
 
   static void DumpMemoryLeaks();
 
+  /// \name Allocation sampling
+  ///
+  /// Allocators with the EnableAllocationSampling flag report every allocation to SampleAllocation(), which picks on average one
+  /// allocation per sampling interval bytes on each thread. Only the picked allocations are recorded (with their stack trace) in a
+  /// lock-free table, all other allocations and deallocations just decrement a thread local counter or do a lookup without any lock.
+  /// Every sample carries a weight, so that summing up the weighted sizes of all samples gives an unbiased estimate of the live heap.
+  /// The table has a fixed capacity of MaxSampledAllocations, samples that do not fit are dropped.
+  ///
+  /// \see ezSampledHeapProfile
+  ///@{
+
+  enum
+  {
+    DefaultSamplingInterval = 512 * 1024, ///< Average number of allocated bytes between two samples.
+    MaxSampledAllocations = 8 * 1024,     ///< How many live sampled allocations are recorded at most.
+  };
+
+  /// \brief Sets the average number of bytes between two sampled allocations on a thread. 0 disables sampling.
+  static void SetAllocationSamplingInterval(ezUInt32 uiAverageBytes);
+  static ezUInt32 GetAllocationSamplingInterval();
+
+  /// \brief Called by allocators with the EnableAllocationSampling flag for every allocation.
+  static void SampleAllocation(ezAllocatorId allocatorId, const void* ptr, size_t uiSize);
+
+  /// \brief Called by allocators with the EnableAllocationSampling flag for every deallocation.
+  static void RemoveSampledAllocation(const void* ptr);
+
+  /// \brief Copies the currently live sampled allocations into out_Samples and returns how many were written.
+  static ezUInt32 GetSampledAllocations(ezArrayPtr<SampledAllocation> out_Samples);
+
+  /// \brief Returns the number of samples that were dropped because the sample table was full.
+  static ezUInt64 GetNumDroppedSamples();
+
+  ///@}
+
   static Iterator GetIterator();
 };
@@ -1,13 +1,18 @@
 #pragma once
 
 #include <Foundation/Basics.h>
+#include <Foundation/Memory/MemoryTracker.h>
 
 /// \brief This helper class can reserve and allocate whole memory pages.
+///
+/// The pages are only registered with the ezMemoryTracker if EnableAllocationTracking is set in \a flags.
+/// Allocators that report the pages through their own stats can pass ezMemoryTrackingFlags::None.
+/// DeallocatePage() must be called with the same flags as AllocatePage().
 class EZ_FOUNDATION_DLL ezPageAllocator
 {
 public:
-  static void* AllocatePage(size_t uiSize);
-  static void DeallocatePage(void* ptr);
+  static void* AllocatePage(size_t uiSize, ezBitflags<ezMemoryTrackingFlags> flags = ezMemoryTrackingFlags::Default);
+  static void DeallocatePage(void* ptr, ezBitflags<ezMemoryTrackingFlags> flags = ezMemoryTrackingFlags::Default);
 
   static ezAllocatorId GetId();
 };
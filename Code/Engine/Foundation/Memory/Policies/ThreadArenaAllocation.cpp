@@ -0,0 +1,395 @@
+#include <FoundationPCH.h>
+
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Memory/Policies/ThreadArenaAllocation.h>
+#include <Foundation/Threading/Lock.h>
+
+namespace ezMemoryPolicies
+{
+  namespace
+  {
+    struct ArenaSlot
+    {
+      ezThreadArenaAllocation::Arena* m_pArena;
+      ezUInt64 m_uiInstanceId;
+    };
+
+    // plain old data, so accessing it does not require any thread_local initialization checks
+    static thread_local ArenaSlot s_ArenaSlots[ezThreadArenaAllocation::MaxInstances];
+
+    EZ_ALWAYS_INLINE ezUInt8* AlignArenaPointer(ezUInt8* ptr, size_t uiAlign)
+    {
+      return ezMemoryUtils::Align(ptr + uiAlign - 1, uiAlign);
+    }
+  } // namespace
+
+  struct ezThreadArenaAllocation::Arena
+  {
+    struct DestructData
+    {
+      EZ_DECLARE_POD_TYPE();
+
+      ezMemoryUtils::DestructorFunction m_Func;
+      void* m_Ptr;
+    };
+
+    Arena(ezAllocatorBase* pParent)
+      : m_Chunks(pParent)
+      , m_DedicatedBlocks(pParent)
+      , m_Destructors(pParent)
+    {
+    }
+
+    Arena* m_pNext = nullptr;
+    Arena* m_pNextUnused = nullptr;
+
+    ezUInt8* m_pCurrent = nullptr;
+    ezUInt8* m_pEnd = nullptr;
+    ezUInt32 m_uiCurrentChunk = 0;
+
+    ezDynamicArray<ezUInt8*> m_Chunks;
+    ezDynamicArray<ezArrayPtr<ezUInt8>> m_DedicatedBlocks;
+    ezDynamicArray<DestructData> m_Destructors;
+
+    // only written by the owning thread, read by FillStats()
+    volatile ezUInt64 m_uiNumAllocations = 0;
+    volatile ezUInt64 m_uiUsedMemory = 0;
+  };
+
+  struct ezThreadArenaAllocationDetail
+  {
+    static ezMutex& GetRegistryMutex()
+    {
+      static ezMutex s_Mutex;
+      return s_Mutex;
+    }
+
+    static ezThreadArenaAllocation* s_Instances[ezThreadArenaAllocation::MaxInstances];
+    static ezUInt64 s_uiNextInstanceId;
+
+    static void OnThreadExit()
+    {
+      EZ_LOCK(GetRegistryMutex());
+
+      for (ezUInt32 i = 0; i < ezThreadArenaAllocation::MaxInstances; ++i)
+      {
+        ArenaSlot& slot = s_ArenaSlots[i];
+
+        // the allocator might have been destroyed in the mean time, its arenas are gone then as well
+        if (slot.m_pArena != nullptr && s_Instances[i] != nullptr && s_Instances[i]->m_uiInstanceId == slot.m_uiInstanceId)
+        {
+          s_Instances[i]->ReleaseArena(slot.m_pArena);
+        }
+
+        slot.m_pArena = nullptr;
+        slot.m_uiInstanceId = 0;
+      }
+    }
+  };
+
+  ezThreadArenaAllocation* ezThreadArenaAllocationDetail::s_Instances[ezThreadArenaAllocation::MaxInstances];
+  ezUInt64 ezThreadArenaAllocationDetail::s_uiNextInstanceId = 0;
+
+  namespace
+  {
+    // forces a destructor call for every thread that created an arena
+    struct ArenaThreadExitHandler
+    {
+      ~ArenaThreadExitHandler()
+      {
+        if (m_bActive)
+        {
+          ezThreadArenaAllocationDetail::OnThreadExit();
+        }
+      }
+
+      bool m_bActive = false;
+    };
+
+    static thread_local ArenaThreadExitHandler s_ArenaThreadExitHandler;
+  } // namespace
+
+  using ArenaDetail = ezThreadArenaAllocationDetail;
+
+  //////////////////////////////////////////////////////////////////////////
+
+  ezThreadArenaAllocation::ezThreadArenaAllocation(ezAllocatorBase* pParent)
+    : m_pParent(pParent != nullptr ? pParent : ezFoundation::GetAlignedAllocator())
+  {
+    EZ_LOCK(ArenaDetail::GetRegistryMutex());
+
+    m_uiSlot = MaxInstances;
+    for (ezUInt32 i = 0; i < MaxInstances; ++i)
+    {
+      if (ArenaDetail::s_Instances[i] == nullptr)
+      {
+        m_uiSlot = i;
+        break;
+      }
+    }
+
+    EZ_ASSERT_RELEASE(m_uiSlot < MaxInstances, "Too many ezThreadArenaAllocation instances, at most {0} may exist at the same time", (ezUInt32)MaxInstances);
+
+    ArenaDetail::s_Instances[m_uiSlot] = this;
+    m_uiInstanceId = ++ArenaDetail::s_uiNextInstanceId;
+  }
+
+  ezThreadArenaAllocation::~ezThreadArenaAllocation()
+  {
+    {
+      EZ_LOCK(ArenaDetail::GetRegistryMutex());
+      ArenaDetail::s_Instances[m_uiSlot] = nullptr;
+    }
+
+    // the arena slots of other threads still reference this instance, but the instance id won't match anymore
+
+    while (m_pArenas != nullptr)
+    {
+      Arena* pArena = m_pArenas;
+      m_pArenas = pArena->m_pNext;
+
+      ResetArena(pArena);
+
+      for (ezUInt8* pChunk : pArena->m_Chunks)
+      {
+        m_pParent->Deallocate(pChunk);
+      }
+
+      EZ_DELETE(m_pParent, pArena);
+    }
+  }
+
+  EZ_FORCE_INLINE ezThreadArenaAllocation::Arena* ezThreadArenaAllocation::GetArena()
+  {
+    const ArenaSlot& slot = s_ArenaSlots[m_uiSlot];
+
+    if (slot.m_uiInstanceId == m_uiInstanceId)
+      return slot.m_pArena;
+
+    return CreateArena();
+  }
+
+  ezThreadArenaAllocation::Arena* ezThreadArenaAllocation::CreateArena()
+  {
+    Arena* pArena = nullptr;
+
+    {
+      EZ_LOCK(m_Mutex);
+
+      // prefer the arena of a thread that has exited, it may still own chunks
+      if (m_pUnusedArenas != nullptr)
+      {
+        pArena = m_pUnusedArenas;
+        m_pUnusedArenas = pArena->m_pNextUnused;
+        pArena->m_pNextUnused = nullptr;
+      }
+      else
+      {
+        pArena = EZ_NEW(m_pParent, Arena, m_pParent);
+        pArena->m_pNext = m_pArenas;
+        m_pArenas = pArena;
+      }
+    }
+
+    s_ArenaThreadExitHandler.m_bActive = true;
+
+    ArenaSlot& slot = s_ArenaSlots[m_uiSlot];
+    slot.m_pArena = pArena;
+    slot.m_uiInstanceId = m_uiInstanceId;
+
+    return pArena;
+  }
+
+  void ezThreadArenaAllocation::ReleaseArena(Arena* pArena)
+  {
+    // the memory of the arena stays valid until the next reset, it is only handed to another thread
+    EZ_LOCK(m_Mutex);
+    pArena->m_pNextUnused = m_pUnusedArenas;
+    m_pUnusedArenas = pArena;
+  }
+
+  void* ezThreadArenaAllocation::Allocate(size_t uiSize, size_t uiAlign)
+  {
+    EZ_ASSERT_DEBUG(ezMath::IsPowerOf2((ezUInt32)uiAlign), "Alignment must be power of two");
+
+    Arena* pArena = GetArena();
+
+    if (pArena->m_pCurrent != nullptr)
+    {
+      ezUInt8* pAligned = AlignArenaPointer(pArena->m_pCurrent, uiAlign);
+
+      if (pAligned <= pArena->m_pEnd && static_cast<size_t>(pArena->m_pEnd - pAligned) >= uiSize)
+      {
+        pArena->m_uiUsedMemory = pArena->m_uiUsedMemory + (pAligned + uiSize - pArena->m_pCurrent);
+        pArena->m_uiNumAllocations = pArena->m_uiNumAllocations + 1;
+        pArena->m_pCurrent = pAligned + uiSize;
+
+        return pAligned;
+      }
+    }
+
+    if (uiSize > MaxChunkAllocationSize)
+      return AllocateDedicated(pArena, uiSize, uiAlign);
+
+    return AllocateFromNextChunk(pArena, uiSize, uiAlign);
+  }
+
+  void* ezThreadArenaAllocation::AllocateFromNextChunk(Arena* pArena, size_t uiSize, size_t uiAlign)
+  {
+    if (pArena->m_pCurrent != nullptr)
+    {
+      ++pArena->m_uiCurrentChunk;
+    }
+
+    if (pArena->m_uiCurrentChunk >= pArena->m_Chunks.GetCount())
+    {
+      pArena->m_Chunks.PushBack(static_cast<ezUInt8*>(m_pParent->Allocate(ChunkSize, EZ_ALIGNMENT_MINIMUM)));
+    }
+
+    ezUInt8* pChunk = pArena->m_Chunks[pArena->m_uiCurrentChunk];
+    ezUInt8* pAligned = AlignArenaPointer(pChunk, uiAlign);
+
+    // the skipped rest of the previous chunk is not counted, it is available again after the next reset
+    pArena->m_uiUsedMemory = pArena->m_uiUsedMemory + (pAligned + uiSize - pChunk);
+    pArena->m_uiNumAllocations = pArena->m_uiNumAllocations + 1;
+    pArena->m_pCurrent = pAligned + uiSize;
+    pArena->m_pEnd = pChunk + ChunkSize;
+
+    return pAligned;
+  }
+
+  void* ezThreadArenaAllocation::AllocateDedicated(Arena* pArena, size_t uiSize, size_t uiAlign)
+  {
+    ezUInt8* pBlock = static_cast<ezUInt8*>(m_pParent->Allocate(uiSize, uiAlign));
+    pArena->m_DedicatedBlocks.PushBack(ezArrayPtr<ezUInt8>(pBlock, static_cast<ezUInt32>(uiSize)));
+
+    pArena->m_uiUsedMemory = pArena->m_uiUsedMemory + uiSize;
+    pArena->m_uiNumAllocations = pArena->m_uiNumAllocations + 1;
+
+    return pBlock;
+  }
+
+  void ezThreadArenaAllocation::AddDestructor(void* ptr, ezMemoryUtils::DestructorFunction destructorFunc)
+  {
+    auto& data = GetArena()->m_Destructors.ExpandAndGetRef();
+    data.m_Func = destructorFunc;
+    data.m_Ptr = ptr;
+  }
+
+  void ezThreadArenaAllocation::RemoveDestructor(void* ptr)
+  {
+    auto RemoveFromArena = [ptr](Arena* pArena) -> bool {
+      for (ezUInt32 i = pArena->m_Destructors.GetCount(); i-- > 0;)
+      {
+        if (pArena->m_Destructors[i].m_Ptr == ptr)
+        {
+          pArena->m_Destructors[i].m_Func = nullptr;
+          return true;
+        }
+      }
+
+      return false;
+    };
+
+    if (RemoveFromArena(GetArena()))
+      return;
+
+    EZ_LOCK(m_Mutex);
+
+    for (Arena* pArena = m_pArenas; pArena != nullptr; pArena = pArena->m_pNext)
+    {
+      if (RemoveFromArena(pArena))
+        return;
+    }
+  }
+
+  void ezThreadArenaAllocation::Reset()
+  {
+    EZ_LOCK(m_Mutex);
+
+    m_uiPeakUsedMemory = ezMath::Max(m_uiPeakUsedMemory, GetUsedMemory());
+
+    for (Arena* pArena = m_pArenas; pArena != nullptr; pArena = pArena->m_pNext)
+    {
+      ResetArena(pArena);
+    }
+  }
+
+  void ezThreadArenaAllocation::ResetArena(Arena* pArena)
+  {
+    for (ezUInt32 i = pArena->m_Destructors.GetCount(); i-- > 0;)
+    {
+      const auto& data = pArena->m_Destructors[i];
+      if (data.m_Func != nullptr)
+        data.m_Func(data.m_Ptr);
+    }
+
+    pArena->m_Destructors.Clear();
+
+    for (auto block : pArena->m_DedicatedBlocks)
+    {
+      m_pParent->Deallocate(block.GetPtr());
+    }
+
+    pArena->m_DedicatedBlocks.Clear();
+
+    pArena->m_uiCurrentChunk = 0;
+    pArena->m_pCurrent = pArena->m_Chunks.IsEmpty() ? nullptr : pArena->m_Chunks[0];
+    pArena->m_pEnd = pArena->m_Chunks.IsEmpty() ? nullptr : pArena->m_Chunks[0] + ChunkSize;
+    pArena->m_uiUsedMemory = 0;
+    pArena->m_uiNumAllocations = 0;
+  }
+
+  void ezThreadArenaAllocation::FillStats(ezAllocatorBase::Stats& out_Stats) const
+  {
+    EZ_LOCK(m_Mutex);
+
+    out_Stats = ezAllocatorBase::Stats();
+
+    for (const Arena* pArena = m_pArenas; pArena != nullptr; pArena = pArena->m_pNext)
+    {
+      out_Stats.m_uiNumAllocations += pArena->m_uiNumAllocations;
+      out_Stats.m_uiAllocationSize += pArena->m_uiUsedMemory;
+    }
+  }
+
+  ezUInt64 ezThreadArenaAllocation::GetUsedMemory() const
+  {
+    EZ_LOCK(m_Mutex);
+
+    ezUInt64 uiUsedMemory = 0;
+
+    for (const Arena* pArena = m_pArenas; pArena != nullptr; pArena = pArena->m_pNext)
+    {
+      uiUsedMemory += pArena->m_uiUsedMemory;
+    }
+
+    return uiUsedMemory;
+  }
+
+  ezUInt64 ezThreadArenaAllocation::GetUsedMemoryOfCurrentThread()
+  {
+    return GetArena()->m_uiUsedMemory;
+  }
+
+  ezUInt64 ezThreadArenaAllocation::GetReservedMemory() const
+  {
+    EZ_LOCK(m_Mutex);
+
+    ezUInt64 uiReservedMemory = 0;
+
+    for (const Arena* pArena = m_pArenas; pArena != nullptr; pArena = pArena->m_pNext)
+    {
+      uiReservedMemory += static_cast<ezUInt64>(pArena->m_Chunks.GetCount()) * ChunkSize;
+
+      for (auto block : pArena->m_DedicatedBlocks)
+      {
+        uiReservedMemory += block.GetCount();
+      }
+    }
+
+    return uiReservedMemory;
+  }
+} // namespace ezMemoryPolicies
+
+EZ_STATICLINK_FILE(Foundation, Foundation_Memory_Policies_ThreadArenaAllocation);
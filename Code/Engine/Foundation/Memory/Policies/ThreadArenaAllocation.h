@@ -0,0 +1,90 @@
+#pragma once
+
+#include <Foundation/Basics.h>
+#include <Foundation/Memory/MemoryUtils.h>
+#include <Foundation/Threading/Mutex.h>
+
+namespace ezMemoryPolicies
+{
+  /// \brief Allocation policy with one linear arena per thread, for data that is allocated in bulk and freed all at once.
+  ///
+  /// Every thread that allocates gets its own arena, allocating just bumps a pointer in the current chunk of that arena, so it never
+  /// takes a lock or executes an atomic operation. Chunks of ChunkSize bytes are requested from the parent allocator and kept
+  /// when the arenas are reset, so after a few resets the arenas don't allocate anymore.
+  /// Allocations above MaxChunkAllocationSize get a dedicated block from the parent allocator, which is freed again on reset.
+  ///
+  /// Memory can't be freed individually, Deallocate() does nothing. Reset() rewinds all arenas at once and calls the
+  /// destructors that were registered with AddDestructor(). Reset() must not be called while other threads allocate.
+  /// When a thread exits, its arena is kept around and handed to the next thread that starts allocating.
+  ///
+  /// \see ezThreadArenaAllocator
+  class EZ_FOUNDATION_DLL ezThreadArenaAllocation
+  {
+  public:
+    enum
+    {
+      ChunkSize = 64 * 1024,                     ///< Size of the chunks that the arenas allocate from the parent allocator.
+      MaxChunkAllocationSize = ChunkSize / 4,    ///< Allocations above this size get a dedicated block from the parent allocator.
+      MaxInstances = 16,                         ///< How many instances of this policy may exist at the same time.
+    };
+
+    ezThreadArenaAllocation(ezAllocatorBase* pParent);
+    ~ezThreadArenaAllocation();
+
+    void* Allocate(size_t uiSize, size_t uiAlign);
+    void Deallocate(void* ptr) {}
+
+    /// \brief Registers a destructor that is called for ptr on the next Reset(). Must be called on the thread that allocated ptr.
+    void AddDestructor(void* ptr, ezMemoryUtils::DestructorFunction destructorFunc);
+
+    /// \brief Removes the destructor for ptr again, e.g. because the object was already destroyed manually.
+    ///
+    /// This is a linear search, starting in the arena of the calling thread. It is only meant for the rare case that an object
+    /// is deleted before the reset.
+    void RemoveDestructor(void* ptr);
+
+    /// \brief Calls all registered destructors and rewinds all arenas. Chunks are kept for reuse, dedicated blocks are freed.
+    void Reset();
+
+    EZ_ALWAYS_INLINE ezAllocatorBase* GetParent() const { return m_pParent; }
+
+    /// \brief Sums up the counters of all arenas since the last reset.
+    void FillStats(ezAllocatorBase::Stats& out_Stats) const;
+
+    /// \brief Returns the number of bytes that were handed out by all arenas since the last reset, including alignment padding.
+    ezUInt64 GetUsedMemory() const;
+
+    /// \brief Returns the number of bytes that were handed out by the arena of the calling thread since the last reset.
+    ezUInt64 GetUsedMemoryOfCurrentThread();
+
+    /// \brief Returns the largest value of GetUsedMemory() that was observed by Reset().
+    ezUInt64 GetPeakUsedMemory() const { return m_uiPeakUsedMemory; }
+
+    /// \brief Returns the number of bytes that are currently held in chunks and dedicated blocks.
+    ezUInt64 GetReservedMemory() const;
+
+    struct Arena;
+
+  private:
+    friend struct ezThreadArenaAllocationDetail;
+
+    Arena* GetArena();
+    Arena* CreateArena();
+    void ReleaseArena(Arena* pArena);
+
+    void* AllocateFromNextChunk(Arena* pArena, size_t uiSize, size_t uiAlign);
+    void* AllocateDedicated(Arena* pArena, size_t uiSize, size_t uiAlign);
+    void ResetArena(Arena* pArena);
+
+    ezAllocatorBase* m_pParent = nullptr;
+
+    mutable ezMutex m_Mutex;
+    ezUInt32 m_uiSlot = 0;
+    ezUInt64 m_uiInstanceId = 0;
+
+    Arena* m_pArenas = nullptr;
+    Arena* m_pUnusedArenas = nullptr;
+
+    ezUInt64 m_uiPeakUsedMemory = 0;
+  };
+} // namespace ezMemoryPolicies
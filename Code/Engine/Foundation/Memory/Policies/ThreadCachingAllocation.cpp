@@ -0,0 +1,800 @@
+#include <FoundationPCH.h>
+
+#include <Foundation/Math/Math.h>
+#include <Foundation/Memory/PageAllocator.h>
+#include <Foundation/Memory/Policies/ThreadCachingAllocation.h>
+#include <Foundation/Threading/AtomicUtils.h>
+#include <Foundation/Threading/Lock.h>
+
+namespace ezMemoryPolicies
+{
+  namespace
+  {
+    enum class SpanList : ezUInt8
+    {
+      None,
+      Active,
+      Partial,
+      Full,
+      Pool,
+    };
+
+    // the span header sits at the start of every span, the first block follows after it
+    static constexpr ezUInt32 SpanHeaderSize = 128;
+
+    // medium size classes use spans that are large enough for this many blocks, up to half a segment
+    static constexpr ezUInt32 MinBlocksPerSpan = 4;
+
+    // the page map covers 48 bit addresses, the page index is split into three levels
+    static constexpr ezUInt32 PageMapLeafBits = 10;
+    static constexpr ezUInt32 PageMapNodeBits = 10;
+    static constexpr ezUInt32 PageMapRootBits = 48 - 16 - PageMapLeafBits - PageMapNodeBits;
+
+    // placed directly in front of every allocation that does not come from a span
+    struct LargeHeader
+    {
+      void* m_pAllocation;
+      size_t m_uiSize;
+    };
+
+    struct CacheSlot
+    {
+      ezThreadCachingAllocation::ThreadCache* m_pCache;
+      ezUInt64 m_uiInstanceId;
+    };
+
+    // plain old data, so accessing it does not require any thread_local initialization checks
+    static thread_local CacheSlot s_CacheSlots[ezThreadCachingAllocation::MaxInstances];
+  } // namespace
+
+  struct ezThreadCachingAllocation::Span
+  {
+    SpanList m_List;
+    ezUInt8 m_uiSizeClass;
+    ezUInt8 m_uiFirstPage;
+    ezUInt8 m_uiNumPages;
+    ezUInt32 m_uiBlockSize;
+    ezUInt32 m_uiCapacity;
+    ezUInt32 m_uiNumUsed;
+    ezUInt32 m_uiNumCarved;
+    void* m_pFreeList;
+    Span* m_pNext;
+    Span* m_pPrev;
+    ThreadCache* m_pOwner;
+    Segment* m_pSegment;
+  };
+
+  struct ezThreadCachingAllocation::Segment
+  {
+    Segment* m_pNext;
+    Segment* m_pPrev;
+    ezUInt8* m_pFirstSpan;
+    ezUInt32 m_uiUsedPages; // one bit per page
+    ezUInt32 m_uiNumFreeSpans;
+  };
+
+  // maps every page of every span to the span header, pages that do not belong to this allocator map to nullptr
+  struct ezThreadCachingAllocation::PageMap
+  {
+    struct Leaf
+    {
+      Span* volatile m_Spans[1 << PageMapLeafBits];
+    };
+
+    struct Node
+    {
+      Leaf* volatile m_Leaves[1 << PageMapNodeBits];
+    };
+
+    Node* volatile m_Nodes[1 << PageMapRootBits];
+  };
+
+  struct ezThreadCachingAllocation::ThreadCache
+  {
+    struct Bin
+    {
+      Span* m_pActive = nullptr;
+      Span* m_pPartial = nullptr;
+      Span* m_pFull = nullptr;
+    };
+
+    ThreadCache* m_pNext = nullptr;
+    ThreadCache* m_pNextUnused = nullptr;
+
+    // only written by the owning thread, read by FillStats()
+    volatile ezInt64 m_iNumAllocations = 0;
+    volatile ezInt64 m_iNumDeallocations = 0;
+    volatile ezInt64 m_iAllocatedBytes = 0;
+
+    Bin m_Bins[NumSizeClasses];
+
+    // written by other threads, keep them on their own cache line
+    EZ_ALIGN_VARIABLE(void* volatile m_pRemoteFrees, 64) = nullptr;
+    volatile ezInt64 m_iNumRemoteDeallocations = 0;
+    volatile ezInt64 m_iRemoteDeallocatedBytes = 0;
+  };
+
+  static_assert(sizeof(ezThreadCachingAllocation::Span) <= SpanHeaderSize, "Span header is too large");
+  static_assert(ezThreadCachingAllocation::SegmentSpans <= 32, "Segment pages must fit into a 32 bit mask");
+  static_assert(ezThreadCachingAllocation::SpanSize == (1 << 16), "The page map expects 64 KB pages");
+  static_assert(sizeof(LargeHeader) <= ezThreadCachingAllocation::MaxSmallAlignment, "Large allocation header is too large");
+
+  struct ezThreadCachingAllocationDetail
+  {
+    static ezMutex& GetRegistryMutex()
+    {
+      static ezMutex s_Mutex;
+      return s_Mutex;
+    }
+
+    static ezThreadCachingAllocation* s_Instances[ezThreadCachingAllocation::MaxInstances];
+    static ezUInt64 s_uiNextInstanceId;
+
+    static void OnThreadExit()
+    {
+      EZ_LOCK(GetRegistryMutex());
+
+      for (ezUInt32 i = 0; i < ezThreadCachingAllocation::MaxInstances; ++i)
+      {
+        CacheSlot& slot = s_CacheSlots[i];
+
+        // the allocator might have been destroyed in the mean time, its caches are gone then as well
+        if (slot.m_pCache != nullptr && s_Instances[i] != nullptr && s_Instances[i]->m_uiInstanceId == slot.m_uiInstanceId)
+        {
+          s_Instances[i]->ReleaseThreadCache(slot.m_pCache);
+        }
+
+        slot.m_pCache = nullptr;
+        slot.m_uiInstanceId = 0;
+      }
+    }
+
+    template <typename T>
+    static void PushFront(T*& pHead, T* pItem)
+    {
+      pItem->m_pPrev = nullptr;
+      pItem->m_pNext = pHead;
+
+      if (pHead != nullptr)
+        pHead->m_pPrev = pItem;
+
+      pHead = pItem;
+    }
+
+    template <typename T>
+    static void Unlink(T*& pHead, T* pItem)
+    {
+      if (pItem->m_pPrev != nullptr)
+        pItem->m_pPrev->m_pNext = pItem->m_pNext;
+      else
+        pHead = pItem->m_pNext;
+
+      if (pItem->m_pNext != nullptr)
+        pItem->m_pNext->m_pPrev = pItem->m_pPrev;
+
+      pItem->m_pNext = nullptr;
+      pItem->m_pPrev = nullptr;
+    }
+
+    // returns nullptr if ptr was not allocated from a span of this allocator
+    EZ_ALWAYS_INLINE static ezThreadCachingAllocation::Span* LookupSpan(const ezThreadCachingAllocation::PageMap* pPageMap, const void* ptr)
+    {
+      const ezUInt64 uiPage = static_cast<ezUInt64>(reinterpret_cast<size_t>(ptr)) >> 16;
+      const ezUInt64 uiRoot = uiPage >> (PageMapLeafBits + PageMapNodeBits);
+
+      if (uiRoot >= (1u << PageMapRootBits))
+        return nullptr;
+
+      const ezThreadCachingAllocation::PageMap::Node* pNode = pPageMap->m_Nodes[uiRoot];
+      if (pNode == nullptr)
+        return nullptr;
+
+      const ezThreadCachingAllocation::PageMap::Leaf* pLeaf = pNode->m_Leaves[(uiPage >> PageMapLeafBits) & ((1u << PageMapNodeBits) - 1)];
+      if (pLeaf == nullptr)
+        return nullptr;
+
+      return pLeaf->m_Spans[uiPage & ((1u << PageMapLeafBits) - 1)];
+    }
+
+    EZ_ALWAYS_INLINE static LargeHeader* GetLargeHeader(const void* ptr)
+    {
+      return reinterpret_cast<LargeHeader*>(const_cast<ezUInt8*>(static_cast<const ezUInt8*>(ptr)) - sizeof(LargeHeader));
+    }
+
+    template <typename T>
+    static T* AllocateZeroed()
+    {
+      T* pResult = static_cast<T*>(ezPageAllocator::AllocatePage(sizeof(T), ezMemoryTrackingFlags::None));
+      ezMemoryUtils::ZeroFill(pResult, 1);
+      return pResult;
+    }
+
+    static ezUInt32 GetSizeClassNumPages(ezUInt32 uiBlockSize)
+    {
+      const ezUInt32 uiNumPages = (SpanHeaderSize + MinBlocksPerSpan * uiBlockSize + ezThreadCachingAllocation::SpanSize - 1) / ezThreadCachingAllocation::SpanSize;
+      return ezMath::Clamp<ezUInt32>(uiNumPages, 1, ezThreadCachingAllocation::SegmentSpans / 2);
+    }
+  };
+
+  ezThreadCachingAllocation* ezThreadCachingAllocationDetail::s_Instances[ezThreadCachingAllocation::MaxInstances];
+  ezUInt64 ezThreadCachingAllocationDetail::s_uiNextInstanceId = 0;
+
+  namespace
+  {
+    // forces a destructor call for every thread that created a thread cache
+    struct ThreadExitHandler
+    {
+      ~ThreadExitHandler()
+      {
+        if (m_bActive)
+        {
+          ezThreadCachingAllocationDetail::OnThreadExit();
+        }
+      }
+
+      bool m_bActive = false;
+    };
+
+    static thread_local ThreadExitHandler s_ThreadExitHandler;
+  } // namespace
+
+  using Detail = ezThreadCachingAllocationDetail;
+
+  //////////////////////////////////////////////////////////////////////////
+
+  ezThreadCachingAllocation::ezThreadCachingAllocation(ezAllocatorBase* pParent)
+  {
+    EZ_LOCK(Detail::GetRegistryMutex());
+
+    m_uiSlot = MaxInstances;
+    for (ezUInt32 i = 0; i < MaxInstances; ++i)
+    {
+      if (Detail::s_Instances[i] == nullptr)
+      {
+        m_uiSlot = i;
+        break;
+      }
+    }
+
+    EZ_ASSERT_RELEASE(m_uiSlot < MaxInstances, "Too many ezThreadCachingAllocation instances, at most {0} may exist at the same time", (ezUInt32)MaxInstances);
+
+    Detail::s_Instances[m_uiSlot] = this;
+    m_uiInstanceId = ++Detail::s_uiNextInstanceId;
+
+    m_pPageMap = Detail::AllocateZeroed<PageMap>();
+    m_iReservedMemory = sizeof(PageMap);
+  }
+
+  ezThreadCachingAllocation::~ezThreadCachingAllocation()
+  {
+    {
+      EZ_LOCK(Detail::GetRegistryMutex());
+      Detail::s_Instances[m_uiSlot] = nullptr;
+    }
+
+    // the thread caches of other threads still reference this instance, but the instance id won't match anymore
+
+    while (m_pThreadCaches != nullptr)
+    {
+      ThreadCache* pCache = m_pThreadCaches;
+      m_pThreadCaches = pCache->m_pNext;
+
+      pCache->~ThreadCache();
+      ezPageAllocator::DeallocatePage(pCache, ezMemoryTrackingFlags::None);
+    }
+
+    while (m_pSegments != nullptr)
+    {
+      Segment* pSegment = m_pSegments;
+      m_pSegments = pSegment->m_pNext;
+
+      ezPageAllocator::DeallocatePage(pSegment, ezMemoryTrackingFlags::None);
+    }
+
+    for (ezUInt32 uiRoot = 0; uiRoot < (1u << PageMapRootBits); ++uiRoot)
+    {
+      PageMap::Node* pNode = m_pPageMap->m_Nodes[uiRoot];
+      if (pNode == nullptr)
+        continue;
+
+      for (ezUInt32 uiNode = 0; uiNode < (1u << PageMapNodeBits); ++uiNode)
+      {
+        if (pNode->m_Leaves[uiNode] != nullptr)
+          ezPageAllocator::DeallocatePage(pNode->m_Leaves[uiNode], ezMemoryTrackingFlags::None);
+      }
+
+      ezPageAllocator::DeallocatePage(pNode, ezMemoryTrackingFlags::None);
+    }
+
+    ezPageAllocator::DeallocatePage(m_pPageMap, ezMemoryTrackingFlags::None);
+  }
+
+  ezUInt32 ezThreadCachingAllocation::GetSizeClass(size_t uiSize)
+  {
+    EZ_ASSERT_DEBUG(uiSize <= MaxMediumSize, "Size {0} is too large for a size class", uiSize);
+
+    if (uiSize <= 128)
+    {
+      return static_cast<ezUInt32>((ezMath::Max<size_t>(uiSize, 1) + 15) / 16 - 1);
+    }
+
+    // sizes in (2^b; 2^(b+1)] are split into four classes
+    const ezUInt32 uiMinusOne = static_cast<ezUInt32>(uiSize - 1);
+    const ezUInt32 b = ezMath::FirstBitHigh(uiMinusOne);
+    const ezUInt32 uiSub = (uiMinusOne - (1u << b)) >> (b - 2);
+
+    return 8 + (b - 7) * 4 + uiSub;
+  }
+
+  ezUInt32 ezThreadCachingAllocation::GetSizeClassBlockSize(ezUInt32 uiSizeClass)
+  {
+    EZ_ASSERT_DEBUG(uiSizeClass < NumSizeClasses, "Invalid size class {0}", uiSizeClass);
+
+    if (uiSizeClass < 8)
+    {
+      return (uiSizeClass + 1) * 16;
+    }
+
+    const ezUInt32 b = (uiSizeClass - 8) / 4 + 7;
+    const ezUInt32 uiSub = (uiSizeClass - 8) % 4;
+
+    return (1u << b) + (uiSub + 1) * (1u << (b - 2));
+  }
+
+  EZ_ALWAYS_INLINE ezThreadCachingAllocation::ThreadCache* ezThreadCachingAllocation::GetThreadCache()
+  {
+    const CacheSlot& slot = s_CacheSlots[m_uiSlot];
+
+    if (slot.m_uiInstanceId == m_uiInstanceId)
+      return slot.m_pCache;
+
+    return CreateThreadCache();
+  }
+
+  ezThreadCachingAllocation::ThreadCache* ezThreadCachingAllocation::CreateThreadCache()
+  {
+    ThreadCache* pCache = nullptr;
+
+    {
+      EZ_LOCK(m_Mutex);
+
+      // prefer the cache of a thread that has exited, it may still own spans
+      if (m_pUnusedThreadCaches != nullptr)
+      {
+        pCache = m_pUnusedThreadCaches;
+        m_pUnusedThreadCaches = pCache->m_pNextUnused;
+        pCache->m_pNextUnused = nullptr;
+      }
+      else
+      {
+        pCache = new (ezPageAllocator::AllocatePage(sizeof(ThreadCache), ezMemoryTrackingFlags::None)) ThreadCache();
+        pCache->m_pNext = m_pThreadCaches;
+        m_pThreadCaches = pCache;
+
+        ezAtomicUtils::Add(m_iReservedMemory, sizeof(ThreadCache));
+      }
+    }
+
+    s_ThreadExitHandler.m_bActive = true;
+
+    CacheSlot& slot = s_CacheSlots[m_uiSlot];
+    slot.m_pCache = pCache;
+    slot.m_uiInstanceId = m_uiInstanceId;
+
+    return pCache;
+  }
+
+  void ezThreadCachingAllocation::ReleaseThreadCache(ThreadCache* pCache)
+  {
+    ProcessRemoteFrees(pCache);
+
+    for (ezUInt32 i = 0; i < NumSizeClasses; ++i)
+    {
+      ThreadCache::Bin& bin = pCache->m_Bins[i];
+
+      if (bin.m_pActive != nullptr && bin.m_pActive->m_uiNumUsed == 0)
+      {
+        ReleaseSpan(bin.m_pActive);
+        bin.m_pActive = nullptr;
+      }
+    }
+
+    EZ_LOCK(m_Mutex);
+    pCache->m_pNextUnused = m_pUnusedThreadCaches;
+    m_pUnusedThreadCaches = pCache;
+  }
+
+  EZ_FORCE_INLINE void* ezThreadCachingAllocation::AllocateSmall(ThreadCache* pCache, ezUInt32 uiSizeClass)
+  {
+    Span* pSpan = pCache->m_Bins[uiSizeClass].m_pActive;
+
+    if (pSpan != nullptr)
+    {
+      void* ptr = pSpan->m_pFreeList;
+
+      if (ptr != nullptr)
+      {
+        pSpan->m_pFreeList = *static_cast<void**>(ptr);
+      }
+      else if (pSpan->m_uiNumCarved < pSpan->m_uiCapacity)
+      {
+        // blocks are carved lazily, so that untouched parts of a span are never committed
+        ptr = reinterpret_cast<ezUInt8*>(pSpan) + SpanHeaderSize + pSpan->m_uiNumCarved * pSpan->m_uiBlockSize;
+        ++pSpan->m_uiNumCarved;
+      }
+      else
+      {
+        return RefillBin(pCache, uiSizeClass);
+      }
+
+      ++pSpan->m_uiNumUsed;
+      pCache->m_iNumAllocations = pCache->m_iNumAllocations + 1;
+      pCache->m_iAllocatedBytes = pCache->m_iAllocatedBytes + pSpan->m_uiBlockSize;
+
+      return ptr;
+    }
+
+    return RefillBin(pCache, uiSizeClass);
+  }
+
+  void* ezThreadCachingAllocation::Allocate(size_t uiSize, size_t uiAlign)
+  {
+    if (uiSize > MaxMediumSize || uiAlign > MaxSmallAlignment)
+    {
+      return AllocateLarge(uiSize, uiAlign);
+    }
+
+    return AllocateSmall(GetThreadCache(), GetSizeClass(uiSize));
+  }
+
+  void* ezThreadCachingAllocation::RefillBin(ThreadCache* pCache, ezUInt32 uiSizeClass)
+  {
+    // blocks that other threads have freed might make the active span usable again
+    ProcessRemoteFrees(pCache);
+
+    ThreadCache::Bin& bin = pCache->m_Bins[uiSizeClass];
+    Span* pSpan = bin.m_pActive;
+
+    if (pSpan != nullptr)
+    {
+      if (pSpan->m_pFreeList != nullptr || pSpan->m_uiNumCarved < pSpan->m_uiCapacity)
+        return AllocateSmall(pCache, uiSizeClass);
+
+      pSpan->m_List = SpanList::Full;
+      Detail::PushFront(bin.m_pFull, pSpan);
+      bin.m_pActive = nullptr;
+    }
+
+    if (bin.m_pPartial != nullptr)
+    {
+      pSpan = bin.m_pPartial;
+      Detail::Unlink(bin.m_pPartial, pSpan);
+    }
+    else
+    {
+      const ezUInt32 uiBlockSize = GetSizeClassBlockSize(uiSizeClass);
+
+      pSpan = AcquireSpan(Detail::GetSizeClassNumPages(uiBlockSize));
+      pSpan->m_uiSizeClass = static_cast<ezUInt8>(uiSizeClass);
+      pSpan->m_uiBlockSize = uiBlockSize;
+      pSpan->m_uiCapacity = (pSpan->m_uiNumPages * SpanSize - SpanHeaderSize) / uiBlockSize;
+      pSpan->m_uiNumUsed = 0;
+      pSpan->m_uiNumCarved = 0;
+      pSpan->m_pFreeList = nullptr;
+      pSpan->m_pOwner = pCache;
+    }
+
+    pSpan->m_List = SpanList::Active;
+    bin.m_pActive = pSpan;
+
+    return AllocateSmall(pCache, uiSizeClass);
+  }
+
+  void* ezThreadCachingAllocation::Reallocate(void* ptr, size_t uiCurrentSize, size_t uiNewSize, size_t uiAlign)
+  {
+    const Span* pSpan = Detail::LookupSpan(m_pPageMap, ptr);
+
+    if (pSpan != nullptr)
+    {
+      if (uiNewSize <= MaxMediumSize && uiAlign <= MaxSmallAlignment && GetSizeClass(uiNewSize) == pSpan->m_uiSizeClass)
+        return ptr;
+    }
+    else
+    {
+      const size_t uiLargeSize = Detail::GetLargeHeader(ptr)->m_uiSize;
+
+      if (uiNewSize <= uiLargeSize && uiNewSize > uiLargeSize / 2 && ezMemoryUtils::IsAligned(ptr, uiAlign))
+        return ptr;
+    }
+
+    void* pNewMem = Allocate(uiNewSize, uiAlign);
+    ezMemoryUtils::Copy(static_cast<ezUInt8*>(pNewMem), static_cast<const ezUInt8*>(ptr), ezMath::Min(uiCurrentSize, uiNewSize));
+    Deallocate(ptr);
+
+    return pNewMem;
+  }
+
+  void ezThreadCachingAllocation::Deallocate(void* ptr)
+  {
+    if (ptr == nullptr)
+      return;
+
+    Span* pSpan = Detail::LookupSpan(m_pPageMap, ptr);
+
+    if (pSpan == nullptr)
+    {
+      FreeLarge(ptr);
+      return;
+    }
+
+    // the owner cannot change while the span contains a used block
+    ThreadCache* pOwner = pSpan->m_pOwner;
+    const CacheSlot& slot = s_CacheSlots[m_uiSlot];
+
+    if (slot.m_pCache == pOwner && slot.m_uiInstanceId == m_uiInstanceId)
+    {
+      pOwner->m_iNumDeallocations = pOwner->m_iNumDeallocations + 1;
+      pOwner->m_iAllocatedBytes = pOwner->m_iAllocatedBytes - pSpan->m_uiBlockSize;
+
+      FreeLocal(pOwner, pSpan, ptr);
+      return;
+    }
+
+    ezAtomicUtils::Increment(pOwner->m_iNumRemoteDeallocations);
+    ezAtomicUtils::Add(pOwner->m_iRemoteDeallocatedBytes, pSpan->m_uiBlockSize);
+
+    void* pHead;
+    do
+    {
+      pHead = pOwner->m_pRemoteFrees;
+      *static_cast<void**>(ptr) = pHead;
+    } while (!ezAtomicUtils::TestAndSet(const_cast<void**>(&pOwner->m_pRemoteFrees), pHead, ptr));
+  }
+
+  void ezThreadCachingAllocation::FreeLocal(ThreadCache* pCache, Span* pSpan, void* ptr)
+  {
+    *static_cast<void**>(ptr) = pSpan->m_pFreeList;
+    pSpan->m_pFreeList = ptr;
+    --pSpan->m_uiNumUsed;
+
+    ThreadCache::Bin& bin = pCache->m_Bins[pSpan->m_uiSizeClass];
+
+    if (pSpan->m_List == SpanList::Full)
+    {
+      Detail::Unlink(bin.m_pFull, pSpan);
+
+      if (pSpan->m_uiNumUsed == 0)
+      {
+        ReleaseSpan(pSpan);
+      }
+      else
+      {
+        pSpan->m_List = SpanList::Partial;
+        Detail::PushFront(bin.m_pPartial, pSpan);
+      }
+    }
+    else if (pSpan->m_List == SpanList::Partial && pSpan->m_uiNumUsed == 0)
+    {
+      // the active span is kept even when it is empty, to not return and re-acquire it over and over
+      Detail::Unlink(bin.m_pPartial, pSpan);
+      ReleaseSpan(pSpan);
+    }
+  }
+
+  void ezThreadCachingAllocation::ProcessRemoteFrees(ThreadCache* pCache)
+  {
+    if (pCache->m_pRemoteFrees == nullptr)
+      return;
+
+    void* pList;
+    do
+    {
+      pList = pCache->m_pRemoteFrees;
+    } while (!ezAtomicUtils::TestAndSet(const_cast<void**>(&pCache->m_pRemoteFrees), pList, nullptr));
+
+    while (pList != nullptr)
+    {
+      void* pNext = *static_cast<void**>(pList);
+      FreeLocal(pCache, Detail::LookupSpan(m_pPageMap, pList), pList);
+      pList = pNext;
+    }
+  }
+
+  ezThreadCachingAllocation::Span* ezThreadCachingAllocation::AcquireSpan(ezUInt32 uiNumPages)
+  {
+    EZ_LOCK(m_Mutex);
+
+    const ezUInt32 uiRunMask = (1u << uiNumPages) - 1;
+    ezUInt32 uiFirstPage = SegmentSpans;
+
+    // segments that recently got pages back are at the front of the list
+    Segment* pSegment = m_pSegments;
+    for (; pSegment != nullptr; pSegment = pSegment->m_pNext)
+    {
+      if (pSegment->m_uiNumFreeSpans < uiNumPages)
+        continue;
+
+      for (ezUInt32 i = 0; i + uiNumPages <= SegmentSpans; ++i)
+      {
+        if ((pSegment->m_uiUsedPages & (uiRunMask << i)) == 0)
+        {
+          uiFirstPage = i;
+          break;
+        }
+      }
+
+      if (uiFirstPage < SegmentSpans)
+        break;
+    }
+
+    if (pSegment == nullptr)
+    {
+      const size_t uiSegmentSize = (SegmentSpans + 1) * SpanSize;
+
+      pSegment = static_cast<Segment*>(ezPageAllocator::AllocatePage(uiSegmentSize, ezMemoryTrackingFlags::None));
+      pSegment->m_pFirstSpan = ezMemoryUtils::Align(reinterpret_cast<ezUInt8*>(pSegment) + sizeof(Segment) + SpanSize - 1, SpanSize);
+      pSegment->m_uiUsedPages = 0;
+      pSegment->m_uiNumFreeSpans = SegmentSpans;
+
+      Detail::PushFront(m_pSegments, pSegment);
+      ezAtomicUtils::Add(m_iReservedMemory, uiSegmentSize);
+
+      m_uiNumFreeSpans += SegmentSpans;
+      uiFirstPage = 0;
+    }
+
+    pSegment->m_uiUsedPages |= uiRunMask << uiFirstPage;
+    pSegment->m_uiNumFreeSpans -= uiNumPages;
+    m_uiNumFreeSpans -= uiNumPages;
+
+    Span* pSpan = reinterpret_cast<Span*>(pSegment->m_pFirstSpan + uiFirstPage * SpanSize);
+    pSpan->m_List = SpanList::None;
+    pSpan->m_uiFirstPage = static_cast<ezUInt8>(uiFirstPage);
+    pSpan->m_uiNumPages = static_cast<ezUInt8>(uiNumPages);
+    pSpan->m_pSegment = pSegment;
+    pSpan->m_pNext = nullptr;
+    pSpan->m_pPrev = nullptr;
+
+    MapPages(reinterpret_cast<ezUInt8*>(pSpan), uiNumPages, pSpan);
+
+    return pSpan;
+  }
+
+  void ezThreadCachingAllocation::ReleaseSpan(Span* pSpan)
+  {
+    EZ_LOCK(m_Mutex);
+
+    pSpan->m_List = SpanList::Pool;
+    pSpan->m_pOwner = nullptr;
+
+    // the page map entries stay until the pages are reused or the segment is returned, no valid pointer refers to them anymore
+    Segment* pSegment = pSpan->m_pSegment;
+    pSegment->m_uiUsedPages &= ~(((1u << pSpan->m_uiNumPages) - 1) << pSpan->m_uiFirstPage);
+    pSegment->m_uiNumFreeSpans += pSpan->m_uiNumPages;
+    m_uiNumFreeSpans += pSpan->m_uiNumPages;
+
+    // return entirely unused segments to the system, but keep some spare pages around to not thrash
+    if (pSegment->m_uiNumFreeSpans == SegmentSpans && m_uiNumFreeSpans > 2 * SegmentSpans)
+    {
+      MapPages(pSegment->m_pFirstSpan, SegmentSpans, nullptr);
+
+      m_uiNumFreeSpans -= SegmentSpans;
+
+      Detail::Unlink(m_pSegments, pSegment);
+      ezPageAllocator::DeallocatePage(pSegment, ezMemoryTrackingFlags::None);
+
+      ezAtomicUtils::Add(m_iReservedMemory, -static_cast<ezInt64>((SegmentSpans + 1) * SpanSize));
+      return;
+    }
+
+    if (m_pSegments != pSegment)
+    {
+      Detail::Unlink(m_pSegments, pSegment);
+      Detail::PushFront(m_pSegments, pSegment);
+    }
+  }
+
+  void ezThreadCachingAllocation::MapPages(ezUInt8* pFirstPage, ezUInt32 uiNumPages, Span* pSpan)
+  {
+    // called with m_Mutex locked, readers don't lock, so nodes and leaves are only published once they are initialized
+
+    for (ezUInt32 i = 0; i < uiNumPages; ++i)
+    {
+      const ezUInt64 uiPage = static_cast<ezUInt64>(reinterpret_cast<size_t>(pFirstPage + i * SpanSize)) >> 16;
+      const ezUInt64 uiRoot = uiPage >> (PageMapLeafBits + PageMapNodeBits);
+      const ezUInt32 uiNode = static_cast<ezUInt32>(uiPage >> PageMapLeafBits) & ((1u << PageMapNodeBits) - 1);
+      const ezUInt32 uiLeaf = static_cast<ezUInt32>(uiPage) & ((1u << PageMapLeafBits) - 1);
+
+      EZ_ASSERT_RELEASE(uiRoot < (1u << PageMapRootBits), "Address {0} is outside of the range that the page map covers", ezArgP(pFirstPage));
+
+      PageMap::Node* pNode = m_pPageMap->m_Nodes[uiRoot];
+      if (pNode == nullptr)
+      {
+        pNode = Detail::AllocateZeroed<PageMap::Node>();
+        ezAtomicUtils::Add(m_iReservedMemory, sizeof(PageMap::Node));
+        ezAtomicUtils::TestAndSet(reinterpret_cast<void**>(const_cast<PageMap::Node**>(&m_pPageMap->m_Nodes[uiRoot])), nullptr, pNode);
+      }
+
+      PageMap::Leaf* pLeaf = pNode->m_Leaves[uiNode];
+      if (pLeaf == nullptr)
+      {
+        pLeaf = Detail::AllocateZeroed<PageMap::Leaf>();
+        ezAtomicUtils::Add(m_iReservedMemory, sizeof(PageMap::Leaf));
+        ezAtomicUtils::TestAndSet(reinterpret_cast<void**>(const_cast<PageMap::Leaf**>(&pNode->m_Leaves[uiNode])), nullptr, pLeaf);
+      }
+
+      pLeaf->m_Spans[uiLeaf] = pSpan;
+    }
+  }
+
+  void* ezThreadCachingAllocation::AllocateLarge(size_t uiSize, size_t uiAlign)
+  {
+    uiAlign = ezMath::Max<size_t>(uiAlign, MaxSmallAlignment);
+
+    // the system heap does not need a global lock for this, Deallocate() finds the header because the page map knows nothing about the pointer
+    void* pAllocation = malloc(uiSize + sizeof(LargeHeader) + uiAlign - 1);
+    EZ_ASSERT_RELEASE(pAllocation != nullptr, "Out of memory, failed to allocate {0} bytes", uiSize);
+
+    ezUInt8* ptr = ezMemoryUtils::Align(static_cast<ezUInt8*>(pAllocation) + sizeof(LargeHeader) + uiAlign - 1, uiAlign);
+
+    LargeHeader* pHeader = Detail::GetLargeHeader(ptr);
+    pHeader->m_pAllocation = pAllocation;
+    pHeader->m_uiSize = uiSize;
+
+    ezAtomicUtils::Add(m_iReservedMemory, static_cast<ezInt64>(ptr - static_cast<ezUInt8*>(pAllocation) + uiSize));
+    ezAtomicUtils::Increment(m_iLargeAllocations);
+    ezAtomicUtils::Add(m_iLargeAllocationSize, uiSize);
+
+    return ptr;
+  }
+
+  void ezThreadCachingAllocation::FreeLarge(void* ptr)
+  {
+    const LargeHeader* pHeader = Detail::GetLargeHeader(ptr);
+
+    ezAtomicUtils::Add(m_iReservedMemory, -static_cast<ezInt64>(static_cast<ezUInt8*>(ptr) - static_cast<ezUInt8*>(pHeader->m_pAllocation) + pHeader->m_uiSize));
+    ezAtomicUtils::Increment(m_iLargeDeallocations);
+    ezAtomicUtils::Add(m_iLargeAllocationSize, -static_cast<ezInt64>(pHeader->m_uiSize));
+
+    free(pHeader->m_pAllocation);
+  }
+
+  size_t ezThreadCachingAllocation::AllocatedSize(const void* ptr) const
+  {
+    const Span* pSpan = Detail::LookupSpan(m_pPageMap, ptr);
+
+    if (pSpan == nullptr)
+      return Detail::GetLargeHeader(ptr)->m_uiSize;
+
+    return pSpan->m_uiBlockSize;
+  }
+
+  void ezThreadCachingAllocation::FillStats(ezAllocatorBase::Stats& out_Stats) const
+  {
+    ezInt64 iNumAllocations = ezAtomicUtils::Read(m_iLargeAllocations);
+    ezInt64 iNumDeallocations = ezAtomicUtils::Read(m_iLargeDeallocations);
+    ezInt64 iAllocationSize = ezAtomicUtils::Read(m_iLargeAllocationSize);
+
+    {
+      EZ_LOCK(m_Mutex);
+
+      for (const ThreadCache* pCache = m_pThreadCaches; pCache != nullptr; pCache = pCache->m_pNext)
+      {
+        iNumAllocations += pCache->m_iNumAllocations;
+        iNumDeallocations += pCache->m_iNumDeallocations + ezAtomicUtils::Read(pCache->m_iNumRemoteDeallocations);
+        iAllocationSize += pCache->m_iAllocatedBytes - ezAtomicUtils::Read(pCache->m_iRemoteDeallocatedBytes);
+      }
+    }
+
+    out_Stats.m_uiNumAllocations = static_cast<ezUInt64>(iNumAllocations);
+    out_Stats.m_uiNumDeallocations = static_cast<ezUInt64>(iNumDeallocations);
+    out_Stats.m_uiAllocationSize = static_cast<ezUInt64>(iAllocationSize);
+  }
+
+  ezUInt64 ezThreadCachingAllocation::GetReservedMemory() const
+  {
+    return static_cast<ezUInt64>(ezAtomicUtils::Read(m_iReservedMemory));
+  }
+} // namespace ezMemoryPolicies
+
+EZ_STATICLINK_FILE(Foundation, Foundation_Memory_Policies_ThreadCachingAllocation);
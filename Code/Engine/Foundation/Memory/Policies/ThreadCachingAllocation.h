@@ -0,0 +1,107 @@
+#pragma once
+
+#include <Foundation/Basics.h>
+#include <Foundation/Threading/Mutex.h>
+
+namespace ezMemoryPolicies
+{
+  /// \brief Allocation policy with per-thread caches of size classes, for heavy small object churn.
+  ///
+  /// Allocations up to MaxMediumSize bytes are rounded up to one of NumSizeClasses size classes. Every thread owns a cache with
+  /// one bin per size class, a bin hands out blocks from spans which belong exclusively to that thread cache.
+  /// Allocating and freeing on the owning thread thus never takes a lock or executes an atomic operation.
+  /// Spans consist of one (small size classes) or several (medium size classes) pages of SpanSize bytes, which are carved out of
+  /// larger segments that are allocated through ezPageAllocator. A page map translates addresses to their span.
+  /// The pages are not registered with the ezMemoryTracker, since the allocator keeps them for reuse and reports them in its own stats.
+  ///
+  /// Freeing a block on another thread pushes it onto a lock-free remote-free queue of the owning thread cache,
+  /// the owner processes its queue the next time one of its bins runs out of blocks.
+  /// Spans that become entirely empty are returned to a shared pool, from where any thread can pick them up again.
+  /// When a thread exits, its cache is kept around and handed to the next thread that starts allocating.
+  ///
+  /// Larger allocations and allocations with an alignment above 16 bytes go directly to the system heap, with a small header in front.
+  ///
+  /// The policy counts allocations itself, use FillStats() to retrieve the numbers. See ezThreadCachingAllocator.
+  ///
+  /// \see ezAllocator
+  class EZ_FOUNDATION_DLL ezThreadCachingAllocation
+  {
+  public:
+    enum
+    {
+      SpanSize = 64 * 1024,          ///< Size and alignment of the pages that spans consist of.
+      SegmentSpans = 32,             ///< How many pages are allocated at once from ezPageAllocator.
+      MaxSmallSize = 8 * 1024,       ///< Size classes up to this size use spans of a single page.
+      MaxMediumSize = 256 * 1024,    ///< Allocations above this size are forwarded to the system heap.
+      MaxSmallAlignment = 16,        ///< Allocations with a larger alignment are forwarded to the system heap.
+      NumSizeClasses = 52,           ///< 16 byte steps up to 128 bytes, above that four size classes per power of two.
+      MaxInstances = 16,             ///< How many instances of this policy may exist at the same time.
+    };
+
+    ezThreadCachingAllocation(ezAllocatorBase* pParent);
+    ~ezThreadCachingAllocation();
+
+    void* Allocate(size_t uiSize, size_t uiAlign);
+    void* Reallocate(void* ptr, size_t uiCurrentSize, size_t uiNewSize, size_t uiAlign);
+    void Deallocate(void* ptr);
+
+    /// \brief Returns the usable size of the given allocation, which may be larger than what was requested.
+    size_t AllocatedSize(const void* ptr) const;
+
+    EZ_ALWAYS_INLINE ezAllocatorBase* GetParent() const { return nullptr; }
+
+    /// \brief Sums up the counters of all thread caches.
+    ///
+    /// Sizes are counted with the size of the size class, not the requested size. Per-frame values are not tracked.
+    void FillStats(ezAllocatorBase::Stats& out_Stats) const;
+
+    /// \brief Returns the number of bytes that were requested from ezPageAllocator and are currently held by this allocator.
+    ezUInt64 GetReservedMemory() const;
+
+    /// \brief Returns the index of the size class that is used for allocations of the given size. uiSize must not exceed MaxMediumSize.
+    static ezUInt32 GetSizeClass(size_t uiSize);
+
+    /// \brief Returns the block size of the given size class.
+    static ezUInt32 GetSizeClassBlockSize(ezUInt32 uiSizeClass);
+
+    struct Span;
+    struct Segment;
+    struct ThreadCache;
+    struct PageMap;
+
+  private:
+    friend struct ezThreadCachingAllocationDetail;
+
+    ThreadCache* GetThreadCache();
+    ThreadCache* CreateThreadCache();
+    void ReleaseThreadCache(ThreadCache* pCache);
+
+    void* AllocateSmall(ThreadCache* pCache, ezUInt32 uiSizeClass);
+    void* RefillBin(ThreadCache* pCache, ezUInt32 uiSizeClass);
+    void FreeLocal(ThreadCache* pCache, Span* pSpan, void* ptr);
+    void ProcessRemoteFrees(ThreadCache* pCache);
+
+    Span* AcquireSpan(ezUInt32 uiNumPages);
+    void ReleaseSpan(Span* pSpan);
+    void MapPages(ezUInt8* pFirstPage, ezUInt32 uiNumPages, Span* pSpan);
+
+    void* AllocateLarge(size_t uiSize, size_t uiAlign);
+    void FreeLarge(void* ptr);
+
+    mutable ezMutex m_Mutex;
+    ezUInt32 m_uiSlot = 0;
+    ezUInt64 m_uiInstanceId = 0;
+
+    PageMap* m_pPageMap = nullptr;
+    Segment* m_pSegments = nullptr;
+    ezUInt32 m_uiNumFreeSpans = 0;
+
+    ThreadCache* m_pThreadCaches = nullptr;
+    ThreadCache* m_pUnusedThreadCaches = nullptr;
+
+    volatile ezInt64 m_iReservedMemory = 0;
+    volatile ezInt64 m_iLargeAllocations = 0;
+    volatile ezInt64 m_iLargeDeallocations = 0;
+    volatile ezInt64 m_iLargeAllocationSize = 0;
+  };
+} // namespace ezMemoryPolicies
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Memory/MemoryTracker.h>
+#include <Foundation/Strings/String.h>
+#include <Foundation/Time/Timestamp.h>
+
+class ezStreamReader;
+class ezStreamWriter;
+
+/// \brief A heap profile built from the allocation samples of the ezMemoryTracker.
+///
+/// All live samples with the same allocator and the same call stack are combined into one entry. The sizes of the samples are scaled by
+/// their weights, so the entries contain estimates of how many bytes and allocations are currently live for each call stack.
+/// Only allocators with the ezMemoryTrackingFlags::EnableAllocationSampling flag contribute to the profile.
+///
+/// Profiles can be saved and loaded, and two profiles of the same process can be compared with ComputeDifference() to find
+/// out where memory usage grows over a long run.
+class EZ_FOUNDATION_DLL ezSampledHeapProfile
+{
+public:
+  struct Entry
+  {
+    ezString m_sAllocatorName;
+    ezUInt64 m_uiStackHash = 0;
+    double m_fEstimatedBytes = 0.0;
+    double m_fEstimatedAllocations = 0.0;
+    ezUInt32 m_uiNumSamples = 0;
+    ezDynamicArray<ezUInt64> m_StackTrace; ///< Return addresses, only meaningful within the process that captured the profile.
+  };
+
+  /// \brief Replaces the content of the profile with the currently live allocation samples.
+  void Capture();
+
+  void Clear();
+
+  /// \brief Sets this profile to the entries of 'after' minus the entries of 'before'. Entries that did not change are skipped.
+  ///
+  /// Entries with a positive estimate grew between the two captures, entries with a negative estimate shrank.
+  void ComputeDifference(const ezSampledHeapProfile& before, const ezSampledHeapProfile& after);
+
+  /// \brief The entries, sorted by estimated bytes in descending order.
+  const ezDynamicArray<Entry>& GetEntries() const { return m_Entries; }
+
+  /// \brief Returns the estimated number of live bytes, either of all allocators or of the allocator with the given name.
+  double GetEstimatedBytes(ezStringView sAllocatorName = ezStringView()) const;
+
+  /// \brief When the profile was captured. For a difference this is the capture time of the later profile.
+  ezTimestamp GetCaptureTime() const { return m_CaptureTime; }
+
+  void Save(ezStreamWriter& stream) const;
+  ezResult Load(ezStreamReader& stream);
+
+  /// \brief Writes the uiMaxEntries largest entries in a human readable form, optionally with resolved stack traces.
+  void WriteReport(ezStringBuilder& out_sReport, ezUInt32 uiMaxEntries = 32, bool bResolveStackTraces = true) const;
+
+private:
+  void SortEntries();
+
+  ezTimestamp m_CaptureTime;
+  ezUInt32 m_uiSamplingInterval = 0;
+  ezDynamicArray<Entry> m_Entries;
+};
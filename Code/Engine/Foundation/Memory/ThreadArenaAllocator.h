@@ -0,0 +1,40 @@
+#pragma once
+
+#include <Foundation/Memory/Allocator.h>
+#include <Foundation/Memory/Policies/ThreadArenaAllocation.h>
+
+/// \brief An allocator with one linear arena per thread, see ezMemoryPolicies::ezThreadArenaAllocation.
+///
+/// Works like ezStackAllocator, i.e. everything is freed at once with Reset() and the destructors of objects created with EZ_NEW are
+/// called then, but threads never contend with each other when allocating.
+///
+/// By default only RegisterAllocator is set as tracking flag. Tracking individual allocations goes through the mutex of the
+/// ezMemoryTracker, which would defeat the purpose of this allocator.
+template <ezUInt32 TrackingFlags = ezMemoryTrackingFlags::RegisterAllocator>
+class ezThreadArenaAllocator : public ezAllocator<ezMemoryPolicies::ezThreadArenaAllocation, TrackingFlags>
+{
+public:
+  ezThreadArenaAllocator(const char* szName, ezAllocatorBase* pParent = nullptr);
+  ~ezThreadArenaAllocator();
+
+  virtual void* Allocate(size_t uiSize, size_t uiAlign, ezMemoryUtils::DestructorFunction destructorFunc) override;
+  virtual void Deallocate(void* ptr) override;
+  virtual ezAllocatorBase::Stats GetStats() const override;
+
+  /// \brief Frees all memory and calls the destructors of all objects. Must not be called while other threads allocate.
+  void Reset();
+
+  /// \brief Returns the number of bytes that were allocated by all threads since the last reset.
+  ezUInt64 GetUsedMemory() const { return this->m_allocator.GetUsedMemory(); }
+
+  /// \brief Returns the number of bytes that were allocated by the calling thread since the last reset.
+  ezUInt64 GetUsedMemoryOfCurrentThread() { return this->m_allocator.GetUsedMemoryOfCurrentThread(); }
+
+  /// \brief Returns the largest number of bytes that were in use at the time of a reset.
+  ezUInt64 GetPeakUsedMemory() const { return this->m_allocator.GetPeakUsedMemory(); }
+
+  /// \brief Returns the number of bytes that the allocator currently holds, including unused parts of its chunks.
+  ezUInt64 GetReservedMemory() const { return this->m_allocator.GetReservedMemory(); }
+};
+
+#include <Foundation/Memory/Implementation/ThreadArenaAllocator_inl.h>
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <Foundation/Memory/Allocator.h>
+#include <Foundation/Memory/Policies/ThreadCachingAllocation.h>
+
+/// \brief A heap allocator with per-thread caches, see ezMemoryPolicies::ezThreadCachingAllocation.
+///
+/// By default only RegisterAllocator is set as tracking flag. Tracking individual allocations goes through the mutex of the
+/// ezMemoryTracker, which would defeat the purpose of this allocator. The stats are collected by the allocation policy instead
+/// and forwarded to the memory tracker whenever GetStats() is called.
+///
+/// Define EZ_USE_THREAD_CACHING_ALLOCATOR in UserConfig.h or pass '-ThreadCachingAllocator' on the command line to use this allocator
+/// as the default heap allocator.
+template <ezUInt32 TrackingFlags = ezMemoryTrackingFlags::RegisterAllocator>
+class ezThreadCachingAllocator : public ezAllocator<ezMemoryPolicies::ezThreadCachingAllocation, TrackingFlags>
+{
+public:
+  ezThreadCachingAllocator(const char* szName, ezAllocatorBase* pParent = nullptr)
+    : ezAllocator<ezMemoryPolicies::ezThreadCachingAllocation, TrackingFlags>(szName, pParent)
+  {
+  }
+
+  virtual size_t AllocatedSize(const void* ptr) override { return this->m_allocator.AllocatedSize(ptr); }
+
+  virtual ezAllocatorBase::Stats GetStats() const override
+  {
+    if ((TrackingFlags & ezMemoryTrackingFlags::EnableAllocationTracking) != 0)
+    {
+      return ezMemoryTracker::GetAllocatorStats(this->m_Id);
+    }
+
+    ezAllocatorBase::Stats stats;
+    this->m_allocator.FillStats(stats);
+
+    if ((TrackingFlags & ezMemoryTrackingFlags::RegisterAllocator) != 0)
+    {
+      ezMemoryTracker::SetAllocatorStats(this->m_Id, stats);
+    }
+
+    return stats;
+  }
+
+  /// \brief Returns the number of bytes that the allocator currently holds, including unused parts of spans and bookkeeping data.
+  ezUInt64 GetReservedMemory() const { return this->m_allocator.GetReservedMemory(); }
+};
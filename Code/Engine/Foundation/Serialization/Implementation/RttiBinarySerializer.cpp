@@ -0,0 +1,1093 @@
+#include <FoundationPCH.h>
+
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Reflection/ReflectionUtils.h>
+#include <Foundation/Serialization/RttiBinarySerializer.h>
+#include <Foundation/Types/ScopeExit.h>
+
+namespace
+{
+  /// How a property is encoded in the written data.
+  enum class ezRttiBinaryFieldKind : ezUInt8
+  {
+    Pod,         ///< The raw bytes of a standard type without heap data.
+    Value,       ///< Any other standard type, written as ezVariant.
+    Enum,        ///< Enum or bitflags value, written as ezInt64.
+    Object,      ///< A struct behind accessors, written as nested object data.
+    PodArray,    ///< Element count followed by the raw bytes of all elements.
+    ValueArray,  ///< Element count followed by all elements as ezVariant.
+    ObjectArray, ///< Element count followed by the nested object data of all elements.
+    Set,         ///< Element count followed by all elements as ezVariant.
+    Map,         ///< Element count followed by the key string and the value as ezVariant of all elements.
+    Count
+  };
+
+  constexpr ezUInt8 s_uiRttiBinaryFormatVersion = 1;
+
+  // large enough for every plain data type that an ezVariant can hold (ezMat4 is the largest)
+  constexpr ezUInt32 s_uiRttiBinaryMaxPodSize = 64;
+
+  bool IsRttiBinaryPodType(ezVariantType::Enum type)
+  {
+    if (type == ezVariantType::String || type == ezVariantType::StringView || type == ezVariantType::DataBuffer)
+      return false;
+
+    return type > ezVariantType::FirstStandardType && type < ezVariantType::LastStandardType;
+  }
+
+  bool IsRttiBinaryArrayKind(ezRttiBinaryFieldKind kind)
+  {
+    return kind == ezRttiBinaryFieldKind::PodArray || kind == ezRttiBinaryFieldKind::ValueArray || kind == ezRttiBinaryFieldKind::Set;
+  }
+
+  struct ezRttiBinaryPodToVariant
+  {
+    template <typename T>
+    EZ_FORCE_INLINE void operator()()
+    {
+      if constexpr (std::is_trivially_copyable<T>::value)
+      {
+        T value;
+        ezMemoryUtils::RawByteCopy(&value, m_pData, sizeof(T));
+        *m_pResult = value;
+      }
+    }
+
+    const void* m_pData;
+    ezVariant* m_pResult;
+  };
+
+  ezVariant RttiBinaryPodToVariant(ezVariantType::Enum type, const void* pData)
+  {
+    ezVariant result;
+    ezRttiBinaryPodToVariant func;
+    func.m_pData = pData;
+    func.m_pResult = &result;
+    ezVariant::DispatchTo(func, type);
+    return result;
+  }
+
+  /// Whether ezReflectionUtils can assign the value to a property of the given type.
+  bool CanAssignRttiBinaryValue(const ezAbstractProperty* pProp, const ezVariant& value)
+  {
+    if (pProp->GetFlags().IsAnySet(ezPropertyFlags::IsEnum | ezPropertyFlags::Bitflags))
+      return value.IsA<ezString>() || value.CanConvertTo<ezInt64>();
+
+    if (pProp->GetSpecificType() == ezGetStaticRTTI<ezVariant>())
+      return true;
+
+    return value.CanConvertTo(pProp->GetSpecificType()->GetVariantType());
+  }
+} // namespace
+
+struct ezRttiBinarySerializer::Field
+{
+  ezString m_sName;
+  ezRttiBinaryFieldKind m_Kind = ezRttiBinaryFieldKind::Value;
+  ezUInt8 m_uiVariantType = ezVariantType::Invalid; ///< The type of the value or the array elements
+  ezUInt32 m_uiSize = 0;                            ///< Pod, PodArray: size of the value or of one array element
+  ezUInt32 m_uiOwnerOffset = 0;                     ///< Offset of the embedded struct that m_pProperty belongs to
+  ezUInt32 m_uiValueOffset = ezInvalidIndex;        ///< Pod with direct access: offset of the value in the object
+  ezAbstractProperty* m_pProperty = nullptr;
+  const ezRTTI* m_pClassType = nullptr; ///< Object, ObjectArray: type of the nested objects
+};
+
+struct ezRttiBinarySerializer::TypePlan
+{
+  struct Step
+  {
+    ezUInt32 m_uiField = ezInvalidIndex; ///< ezInvalidIndex for a block of direct Pod fields
+    ezUInt32 m_uiOffset = 0;
+    ezUInt32 m_uiSize = 0;
+  };
+
+  const ezRTTI* m_pType = nullptr;
+  ezDynamicArray<Field> m_Fields;
+  ezDynamicArray<Step> m_Steps;
+  ezString m_sError; ///< Set if the type has properties that cannot be serialized
+};
+
+struct ezRttiBinarySerializer::StoredField
+{
+  ezString m_sName;
+  ezRttiBinaryFieldKind m_Kind = ezRttiBinaryFieldKind::Value;
+  ezUInt8 m_uiVariantType = ezVariantType::Invalid;
+  ezUInt32 m_uiSize = 0;
+  ezUInt32 m_uiTypeIndex = ezInvalidIndex;
+};
+
+struct ezRttiBinarySerializer::StoredType
+{
+  ezString m_sName;
+  ezUInt32 m_uiVersion = 0;
+  ezDynamicArray<StoredField> m_Fields;
+
+  // how the stored fields map to the plan that was used last for reading this type
+  const TypePlan* m_pResolvedPlan = nullptr;
+  bool m_bMatchesPlan = false;
+  ezDynamicArray<ezUInt32> m_FieldMapping;
+};
+
+struct ezRttiBinarySerializer::ReadContext
+{
+  ezStreamReader* m_pStream = nullptr;
+  ezDynamicArray<StoredType> m_Types;
+};
+
+ezRttiBinarySerializer::ezRttiBinarySerializer() = default;
+ezRttiBinarySerializer::~ezRttiBinarySerializer() = default;
+
+ezResult ezRttiBinarySerializer::WriteObject(ezStreamWriter& stream, const ezRTTI* pRtti, const void* pObject)
+{
+  EZ_ASSERT_DEV(pRtti != nullptr && pObject != nullptr, "Invalid object");
+
+  if (pRtti->IsDerivedFrom<ezReflectedClass>())
+    pRtti = static_cast<const ezReflectedClass*>(pObject)->GetDynamicRTTI();
+
+  const TypePlan* pPlan = GetPlan(pRtti, pObject);
+  EZ_SUCCEED_OR_RETURN(WriteSchema(stream, pPlan));
+  return WriteObjectData(stream, *pPlan, pObject);
+}
+
+void* ezRttiBinarySerializer::ReadObject(ezStreamReader& stream, const ezRTTI*& out_pRtti)
+{
+  out_pRtti = nullptr;
+
+  ReadContext ctx;
+  ctx.m_pStream = &stream;
+
+  if (ReadSchema(ctx).Failed())
+    return nullptr;
+
+  const ezRTTI* pRtti = ezRTTI::FindTypeByName(ctx.m_Types[0].m_sName);
+  if (pRtti == nullptr || pRtti->GetAllocator() == nullptr || !pRtti->GetAllocator()->CanAllocate())
+  {
+    ezLog::Error("Cannot read object of unknown or non-allocatable type '{0}'", ctx.m_Types[0].m_sName);
+    return nullptr;
+  }
+
+  void* pObject = pRtti->GetAllocator()->Allocate<void>();
+
+  if (ReadObjectData(ctx, 0, pRtti, pObject).Failed())
+  {
+    pRtti->GetAllocator()->Deallocate(pObject);
+    return nullptr;
+  }
+
+  out_pRtti = pRtti;
+  return pObject;
+}
+
+ezResult ezRttiBinarySerializer::ReadObjectProperties(ezStreamReader& stream, const ezRTTI* pRtti, void* pObject)
+{
+  EZ_ASSERT_DEV(pRtti != nullptr && pObject != nullptr, "Invalid object");
+
+  if (pRtti->IsDerivedFrom<ezReflectedClass>())
+    pRtti = static_cast<const ezReflectedClass*>(pObject)->GetDynamicRTTI();
+
+  ReadContext ctx;
+  ctx.m_pStream = &stream;
+
+  EZ_SUCCEED_OR_RETURN(ReadSchema(ctx));
+  return ReadObjectData(ctx, 0, pRtti, pObject);
+}
+
+void ezRttiBinarySerializer::ClearCache()
+{
+  m_Plans.Clear();
+}
+
+const ezRttiBinarySerializer::TypePlan* ezRttiBinarySerializer::GetPlan(const ezRTTI* pRtti, const void* pSampleObject)
+{
+  if (const ezUniquePtr<TypePlan>* pExisting = m_Plans.GetValue(pRtti))
+    return pExisting->Borrow();
+
+  // insert the plan before compiling it, so that types which contain arrays of themselves find it
+  ezUniquePtr<TypePlan> pNewPlan = EZ_DEFAULT_NEW(TypePlan);
+  TypePlan& plan = *pNewPlan;
+  plan.m_pType = pRtti;
+  m_Plans.Insert(pRtti, std::move(pNewPlan));
+
+  // the offsets of the direct members can only be determined from an actual instance
+  void* pTempObject = nullptr;
+  if (pSampleObject == nullptr)
+  {
+    if (pRtti->GetAllocator() == nullptr || !pRtti->GetAllocator()->CanAllocate())
+    {
+      ezStringBuilder sError;
+      sError.Format("Type '{0}' cannot be allocated", pRtti->GetTypeName());
+      plan.m_sError = sError;
+      return &plan;
+    }
+
+    pTempObject = pRtti->GetAllocator()->Allocate<void>();
+    pSampleObject = pTempObject;
+  }
+
+  CompileProperties(plan, pRtti, pSampleObject, 0, "");
+  CompileSteps(plan);
+
+  if (pTempObject != nullptr)
+    pRtti->GetAllocator()->Deallocate(pTempObject);
+
+  return &plan;
+}
+
+void ezRttiBinarySerializer::CompileProperties(
+  TypePlan& plan, const ezRTTI* pRtti, const void* pOwner, ezUInt32 uiOwnerOffset, const char* szPrefix)
+{
+  if (pRtti->GetParentType() != nullptr)
+    CompileProperties(plan, pRtti->GetParentType(), pOwner, uiOwnerOffset, szPrefix);
+
+  auto SetError = [&](const ezAbstractProperty* pProp) {
+    if (plan.m_sError.IsEmpty())
+    {
+      ezStringBuilder sError;
+      sError.Format("Property '{0}{1}' of type '{2}' is not supported", szPrefix, pProp->GetPropertyName(), plan.m_pType->GetTypeName());
+      plan.m_sError = sError;
+    }
+  };
+
+  for (ezAbstractProperty* pProp : pRtti->GetProperties())
+  {
+    const ezBitflags<ezPropertyFlags> flags = pProp->GetFlags();
+    const ezPropertyCategory::Enum category = pProp->GetCategory();
+
+    if (flags.IsSet(ezPropertyFlags::ReadOnly) || category == ezPropertyCategory::Constant || category == ezPropertyCategory::Function)
+      continue;
+
+    if (flags.IsSet(ezPropertyFlags::Pointer))
+    {
+      SetError(pProp);
+      continue;
+    }
+
+    ezStringBuilder sName(szPrefix, pProp->GetPropertyName());
+    const ezRTTI* pPropType = pProp->GetSpecificType();
+
+    Field field;
+    field.m_sName = sName;
+    field.m_uiOwnerOffset = uiOwnerOffset;
+    field.m_pProperty = pProp;
+    field.m_uiVariantType = static_cast<ezUInt8>(pPropType->GetVariantType());
+
+    switch (category)
+    {
+      case ezPropertyCategory::Member:
+      {
+        auto pMember = static_cast<ezAbstractMemberProperty*>(pProp);
+        const void* pDirect = pMember->GetPropertyPointer(pOwner);
+        const ezUInt32 uiDirectOffset = static_cast<ezUInt32>(static_cast<const ezUInt8*>(pDirect) - static_cast<const ezUInt8*>(pOwner));
+
+        if (flags.IsAnySet(ezPropertyFlags::IsEnum | ezPropertyFlags::Bitflags))
+        {
+          field.m_Kind = ezRttiBinaryFieldKind::Enum;
+        }
+        else if (flags.IsSet(ezPropertyFlags::StandardType))
+        {
+          if (IsRttiBinaryPodType(pPropType->GetVariantType()) && pPropType->GetTypeSize() <= s_uiRttiBinaryMaxPodSize)
+          {
+            field.m_Kind = ezRttiBinaryFieldKind::Pod;
+            field.m_uiSize = pPropType->GetTypeSize();
+
+            if (pDirect != nullptr)
+              field.m_uiValueOffset = uiOwnerOffset + uiDirectOffset;
+          }
+          else
+          {
+            field.m_Kind = ezRttiBinaryFieldKind::Value;
+          }
+        }
+        else if (flags.IsSet(ezPropertyFlags::Class))
+        {
+          if (pDirect != nullptr)
+          {
+            // fold the members of embedded structs into this plan
+            sName.Append(".");
+            CompileProperties(plan, pPropType, pDirect, uiOwnerOffset + uiDirectOffset, sName);
+            continue;
+          }
+
+          if (pPropType->GetAllocator() == nullptr || !pPropType->GetAllocator()->CanAllocate())
+          {
+            SetError(pProp);
+            continue;
+          }
+
+          field.m_Kind = ezRttiBinaryFieldKind::Object;
+          field.m_pClassType = pPropType;
+        }
+        else
+        {
+          SetError(pProp);
+          continue;
+        }
+      }
+      break;
+
+      case ezPropertyCategory::Array:
+      {
+        if (flags.IsSet(ezPropertyFlags::StandardType))
+        {
+          if (IsRttiBinaryPodType(pPropType->GetVariantType()) && pPropType->GetTypeSize() <= s_uiRttiBinaryMaxPodSize)
+          {
+            field.m_Kind = ezRttiBinaryFieldKind::PodArray;
+            field.m_uiSize = pPropType->GetTypeSize();
+          }
+          else
+          {
+            field.m_Kind = ezRttiBinaryFieldKind::ValueArray;
+          }
+        }
+        else if (flags.IsSet(ezPropertyFlags::Class) && pPropType->GetAllocator() != nullptr && pPropType->GetAllocator()->CanAllocate())
+        {
+          field.m_Kind = ezRttiBinaryFieldKind::ObjectArray;
+          field.m_pClassType = pPropType;
+        }
+        else
+        {
+          SetError(pProp);
+          continue;
+        }
+      }
+      break;
+
+      case ezPropertyCategory::Set:
+      case ezPropertyCategory::Map:
+      {
+        if (!flags.IsSet(ezPropertyFlags::StandardType))
+        {
+          SetError(pProp);
+          continue;
+        }
+
+        field.m_Kind = category == ezPropertyCategory::Set ? ezRttiBinaryFieldKind::Set : ezRttiBinaryFieldKind::Map;
+      }
+      break;
+
+      default:
+        continue;
+    }
+
+    plan.m_Fields.PushBack(field);
+  }
+}
+
+void ezRttiBinarySerializer::CompileSteps(TypePlan& plan)
+{
+  plan.m_Steps.Clear();
+
+  for (ezUInt32 i = 0; i < plan.m_Fields.GetCount(); ++i)
+  {
+    const Field& field = plan.m_Fields[i];
+
+    if (field.m_Kind == ezRttiBinaryFieldKind::Pod && field.m_uiValueOffset != ezInvalidIndex)
+    {
+      // merge directly adjacent members into one block
+      if (!plan.m_Steps.IsEmpty())
+      {
+        TypePlan::Step& prev = plan.m_Steps.PeekBack();
+        if (prev.m_uiField == ezInvalidIndex && prev.m_uiOffset + prev.m_uiSize == field.m_uiValueOffset)
+        {
+          prev.m_uiSize += field.m_uiSize;
+          continue;
+        }
+      }
+
+      TypePlan::Step& step = plan.m_Steps.ExpandAndGetRef();
+      step.m_uiOffset = field.m_uiValueOffset;
+      step.m_uiSize = field.m_uiSize;
+    }
+    else
+    {
+      plan.m_Steps.ExpandAndGetRef().m_uiField = i;
+    }
+  }
+}
+
+ezResult ezRttiBinarySerializer::WriteSchema(ezStreamWriter& stream, const TypePlan* pRootPlan)
+{
+  // gather all types that can occur in the data, the root type comes first
+  ezHybridArray<const TypePlan*, 16> types;
+  ezHashTable<const ezRTTI*, ezUInt32> typeIndices;
+
+  types.PushBack(pRootPlan);
+  typeIndices.Insert(pRootPlan->m_pType, 0);
+
+  for (ezUInt32 i = 0; i < types.GetCount(); ++i)
+  {
+    if (!types[i]->m_sError.IsEmpty())
+    {
+      ezLog::Error("Cannot serialize '{0}': {1}", pRootPlan->m_pType->GetTypeName(), types[i]->m_sError);
+      return EZ_FAILURE;
+    }
+
+    for (const Field& field : types[i]->m_Fields)
+    {
+      if (field.m_pClassType != nullptr && !typeIndices.Contains(field.m_pClassType))
+      {
+        typeIndices.Insert(field.m_pClassType, types.GetCount());
+        types.PushBack(GetPlan(field.m_pClassType, nullptr));
+      }
+    }
+  }
+
+  stream << s_uiRttiBinaryFormatVersion;
+  stream << types.GetCount();
+
+  for (const TypePlan* pPlan : types)
+  {
+    EZ_SUCCEED_OR_RETURN(stream.WriteString(pPlan->m_pType->GetTypeName()));
+    stream << pPlan->m_pType->GetTypeVersion();
+    stream << pPlan->m_Fields.GetCount();
+
+    for (const Field& field : pPlan->m_Fields)
+    {
+      EZ_SUCCEED_OR_RETURN(stream.WriteString(field.m_sName));
+      stream << static_cast<ezUInt8>(field.m_Kind);
+      stream << field.m_uiVariantType;
+      stream << field.m_uiSize;
+      stream << (field.m_pClassType != nullptr ? *typeIndices.GetValue(field.m_pClassType) : ezInvalidIndex);
+    }
+  }
+
+  return EZ_SUCCESS;
+}
+
+ezResult ezRttiBinarySerializer::WriteObjectData(ezStreamWriter& stream, const TypePlan& plan, const void* pObject)
+{
+  const ezUInt8* pBytes = static_cast<const ezUInt8*>(pObject);
+
+  for (const TypePlan::Step& step : plan.m_Steps)
+  {
+    if (step.m_uiField == ezInvalidIndex)
+    {
+      EZ_SUCCEED_OR_RETURN(stream.WriteBytes(pBytes + step.m_uiOffset, step.m_uiSize));
+    }
+    else
+    {
+      const Field& field = plan.m_Fields[step.m_uiField];
+      EZ_SUCCEED_OR_RETURN(WriteField(stream, field, pBytes + field.m_uiOwnerOffset));
+    }
+  }
+
+  return EZ_SUCCESS;
+}
+
+ezResult ezRttiBinarySerializer::WriteField(ezStreamWriter& stream, const Field& field, const void* pOwner)
+{
+  ezUInt64 podBuffer[s_uiRttiBinaryMaxPodSize / sizeof(ezUInt64)];
+
+  switch (field.m_Kind)
+  {
+    case ezRttiBinaryFieldKind::Pod:
+    {
+      static_cast<const ezAbstractMemberProperty*>(field.m_pProperty)->GetValuePtr(pOwner, podBuffer);
+      return stream.WriteBytes(podBuffer, field.m_uiSize);
+    }
+
+    case ezRttiBinaryFieldKind::Value:
+      stream << ezReflectionUtils::GetMemberPropertyValue(static_cast<const ezAbstractMemberProperty*>(field.m_pProperty), pOwner);
+      return EZ_SUCCESS;
+
+    case ezRttiBinaryFieldKind::Enum:
+      stream << static_cast<const ezAbstractEnumerationProperty*>(field.m_pProperty)->GetValue(pOwner);
+      return EZ_SUCCESS;
+
+    case ezRttiBinaryFieldKind::Object:
+    {
+      void* pTemp = field.m_pClassType->GetAllocator()->Allocate<void>();
+      EZ_SCOPE_EXIT(field.m_pClassType->GetAllocator()->Deallocate(pTemp));
+
+      static_cast<const ezAbstractMemberProperty*>(field.m_pProperty)->GetValuePtr(pOwner, pTemp);
+      return WriteObjectData(stream, *GetPlan(field.m_pClassType, pTemp), pTemp);
+    }
+
+    case ezRttiBinaryFieldKind::PodArray:
+    {
+      auto pArray = static_cast<const ezAbstractArrayProperty*>(field.m_pProperty);
+      const ezUInt32 uiCount = pArray->GetCount(pOwner);
+      stream << uiCount;
+
+      for (ezUInt32 i = 0; i < uiCount; ++i)
+      {
+        pArray->GetValue(pOwner, i, podBuffer);
+        EZ_SUCCEED_OR_RETURN(stream.WriteBytes(podBuffer, field.m_uiSize));
+      }
+      return EZ_SUCCESS;
+    }
+
+    case ezRttiBinaryFieldKind::ValueArray:
+    {
+      auto pArray = static_cast<const ezAbstractArrayProperty*>(field.m_pProperty);
+      const ezUInt32 uiCount = pArray->GetCount(pOwner);
+      stream << uiCount;
+
+      for (ezUInt32 i = 0; i < uiCount; ++i)
+      {
+        stream << ezReflectionUtils::GetArrayPropertyValue(pArray, pOwner, i);
+      }
+      return EZ_SUCCESS;
+    }
+
+    case ezRttiBinaryFieldKind::ObjectArray:
+    {
+      auto pArray = static_cast<const ezAbstractArrayProperty*>(field.m_pProperty);
+      const ezUInt32 uiCount = pArray->GetCount(pOwner);
+      stream << uiCount;
+
+      if (uiCount == 0)
+        return EZ_SUCCESS;
+
+      void* pTemp = field.m_pClassType->GetAllocator()->Allocate<void>();
+      EZ_SCOPE_EXIT(field.m_pClassType->GetAllocator()->Deallocate(pTemp));
+      const TypePlan& elementPlan = *GetPlan(field.m_pClassType, pTemp);
+
+      for (ezUInt32 i = 0; i < uiCount; ++i)
+      {
+        pArray->GetValue(pOwner, i, pTemp);
+        EZ_SUCCEED_OR_RETURN(WriteObjectData(stream, elementPlan, pTemp));
+      }
+      return EZ_SUCCESS;
+    }
+
+    case ezRttiBinaryFieldKind::Set:
+    {
+      ezHybridArray<ezVariant, 16> values;
+      static_cast<const ezAbstractSetProperty*>(field.m_pProperty)->GetValues(pOwner, values);
+
+      stream << values.GetCount();
+      for (const ezVariant& value : values)
+      {
+        stream << value;
+      }
+      return EZ_SUCCESS;
+    }
+
+    case ezRttiBinaryFieldKind::Map:
+    {
+      auto pMap = static_cast<const ezAbstractMapProperty*>(field.m_pProperty);
+
+      ezHybridArray<ezString, 16> keys;
+      pMap->GetKeys(pOwner, keys);
+
+      stream << keys.GetCount();
+      for (const ezString& sKey : keys)
+      {
+        EZ_SUCCEED_OR_RETURN(stream.WriteString(sKey));
+        stream << ezReflectionUtils::GetMapPropertyValue(pMap, pOwner, sKey);
+      }
+      return EZ_SUCCESS;
+    }
+
+    default:
+      EZ_ASSERT_NOT_IMPLEMENTED;
+      return EZ_FAILURE;
+  }
+}
+
+ezResult ezRttiBinarySerializer::ReadSchema(ReadContext& ctx)
+{
+  ezStreamReader& stream = *ctx.m_pStream;
+
+  ezUInt8 uiFormatVersion = 0;
+  stream >> uiFormatVersion;
+
+  if (uiFormatVersion != s_uiRttiBinaryFormatVersion)
+  {
+    ezLog::Error("Unsupported binary object format version {0}", uiFormatVersion);
+    return EZ_FAILURE;
+  }
+
+  ezUInt32 uiNumTypes = 0;
+  EZ_SUCCEED_OR_RETURN(stream.ReadDWordValue(&uiNumTypes));
+
+  if (uiNumTypes == 0)
+  {
+    ezLog::Error("Binary object data contains no types");
+    return EZ_FAILURE;
+  }
+
+  ctx.m_Types.SetCount(uiNumTypes);
+
+  for (StoredType& type : ctx.m_Types)
+  {
+    EZ_SUCCEED_OR_RETURN(stream.ReadString(type.m_sName));
+    EZ_SUCCEED_OR_RETURN(stream.ReadDWordValue(&type.m_uiVersion));
+
+    ezUInt32 uiNumFields = 0;
+    EZ_SUCCEED_OR_RETURN(stream.ReadDWordValue(&uiNumFields));
+    type.m_Fields.SetCount(uiNumFields);
+
+    for (StoredField& field : type.m_Fields)
+    {
+      ezUInt8 uiKind = 0;
+      EZ_SUCCEED_OR_RETURN(stream.ReadString(field.m_sName));
+      stream >> uiKind;
+      stream >> field.m_uiVariantType;
+      stream >> field.m_uiSize;
+      EZ_SUCCEED_OR_RETURN(stream.ReadDWordValue(&field.m_uiTypeIndex));
+
+      field.m_Kind = static_cast<ezRttiBinaryFieldKind>(uiKind);
+
+      bool bValid = uiKind < static_cast<ezUInt8>(ezRttiBinaryFieldKind::Count);
+
+      if (field.m_Kind == ezRttiBinaryFieldKind::Pod || field.m_Kind == ezRttiBinaryFieldKind::PodArray)
+      {
+        const ezVariantType::Enum type = static_cast<ezVariantType::Enum>(field.m_uiVariantType);
+        bValid = bValid && IsRttiBinaryPodType(type) && ezReflectionUtils::GetTypeFromVariant(type)->GetTypeSize() == field.m_uiSize;
+      }
+
+      if (field.m_Kind == ezRttiBinaryFieldKind::Object || field.m_Kind == ezRttiBinaryFieldKind::ObjectArray)
+      {
+        bValid = bValid && field.m_uiTypeIndex < uiNumTypes;
+      }
+
+      if (!bValid)
+      {
+        ezLog::Error("Binary object data is corrupt, invalid field '{0}' in type '{1}'", field.m_sName, type.m_sName);
+        return EZ_FAILURE;
+      }
+    }
+  }
+
+  return EZ_SUCCESS;
+}
+
+void ezRttiBinarySerializer::ResolveStoredType(ReadContext& ctx, StoredType& storedType, const TypePlan& plan)
+{
+  if (storedType.m_pResolvedPlan == &plan)
+    return;
+
+  storedType.m_pResolvedPlan = &plan;
+  storedType.m_FieldMapping.SetCount(storedType.m_Fields.GetCount());
+
+  bool bMatches = storedType.m_sName == plan.m_pType->GetTypeName() && storedType.m_Fields.GetCount() == plan.m_Fields.GetCount();
+
+  for (ezUInt32 i = 0; i < storedType.m_Fields.GetCount(); ++i)
+  {
+    const StoredField& storedField = storedType.m_Fields[i];
+
+    ezUInt32 uiField = ezInvalidIndex;
+    for (ezUInt32 j = 0; j < plan.m_Fields.GetCount(); ++j)
+    {
+      if (plan.m_Fields[j].m_sName == storedField.m_sName)
+      {
+        uiField = j;
+        break;
+      }
+    }
+
+    storedType.m_FieldMapping[i] = uiField;
+
+    if (!bMatches)
+      continue;
+
+    const Field& field = plan.m_Fields[i];
+    bMatches = uiField == i && field.m_Kind == storedField.m_Kind && field.m_uiVariantType == storedField.m_uiVariantType &&
+               field.m_uiSize == storedField.m_uiSize;
+
+    if (bMatches && field.m_pClassType != nullptr)
+    {
+      bMatches = storedField.m_uiTypeIndex < ctx.m_Types.GetCount() &&
+                 ctx.m_Types[storedField.m_uiTypeIndex].m_sName == field.m_pClassType->GetTypeName();
+    }
+  }
+
+  storedType.m_bMatchesPlan = bMatches;
+}
+
+ezResult ezRttiBinarySerializer::ReadObjectData(ReadContext& ctx, ezUInt32 uiStoredType, const ezRTTI* pRtti, void* pObject)
+{
+  StoredType& storedType = ctx.m_Types[uiStoredType];
+
+  // without a target object, the data is only skipped
+  const TypePlan* pPlan = (pRtti != nullptr && pObject != nullptr) ? GetPlan(pRtti, pObject) : nullptr;
+
+  if (pPlan != nullptr)
+  {
+    ResolveStoredType(ctx, storedType, *pPlan);
+
+    if (storedType.m_bMatchesPlan)
+    {
+      EZ_SUCCEED_OR_RETURN(ReadObjectDataMatching(ctx, storedType, *pPlan, pObject));
+
+      if (storedType.m_uiVersion != pRtti->GetTypeVersion() && m_VersionPatchFunc.IsValid())
+        m_VersionPatchFunc(pRtti, pObject, storedType.m_uiVersion, ezVariantDictionary());
+
+      return EZ_SUCCESS;
+    }
+  }
+
+  ezVariantDictionary unmatchedValues;
+  EZ_SUCCEED_OR_RETURN(ReadObjectDataConverting(ctx, storedType, pPlan, pObject, unmatchedValues));
+
+  if (pPlan != nullptr && m_VersionPatchFunc.IsValid())
+    m_VersionPatchFunc(pRtti, pObject, storedType.m_uiVersion, unmatchedValues);
+
+  return EZ_SUCCESS;
+}
+
+ezResult ezRttiBinarySerializer::ReadObjectDataMatching(ReadContext& ctx, const StoredType& storedType, const TypePlan& plan, void* pObject)
+{
+  ezUInt8* pBytes = static_cast<ezUInt8*>(pObject);
+
+  for (const TypePlan::Step& step : plan.m_Steps)
+  {
+    if (step.m_uiField == ezInvalidIndex)
+    {
+      if (ctx.m_pStream->ReadBytes(pBytes + step.m_uiOffset, step.m_uiSize) != step.m_uiSize)
+        return EZ_FAILURE;
+    }
+    else
+    {
+      const Field& field = plan.m_Fields[step.m_uiField];
+      EZ_SUCCEED_OR_RETURN(ReadField(ctx, storedType.m_Fields[step.m_uiField], field, pBytes + field.m_uiOwnerOffset));
+    }
+  }
+
+  return EZ_SUCCESS;
+}
+
+ezResult ezRttiBinarySerializer::ReadField(ReadContext& ctx, const StoredField& storedField, const Field& field, void* pOwner)
+{
+  ezStreamReader& stream = *ctx.m_pStream;
+  ezUInt64 podBuffer[s_uiRttiBinaryMaxPodSize / sizeof(ezUInt64)];
+
+  switch (field.m_Kind)
+  {
+    case ezRttiBinaryFieldKind::Pod:
+    {
+      if (stream.ReadBytes(podBuffer, field.m_uiSize) != field.m_uiSize)
+        return EZ_FAILURE;
+
+      static_cast<ezAbstractMemberProperty*>(field.m_pProperty)->SetValuePtr(pOwner, podBuffer);
+      return EZ_SUCCESS;
+    }
+
+    case ezRttiBinaryFieldKind::Value:
+    {
+      ezVariant value;
+      stream >> value;
+      ezReflectionUtils::SetMemberPropertyValue(static_cast<ezAbstractMemberProperty*>(field.m_pProperty), pOwner, value);
+      return EZ_SUCCESS;
+    }
+
+    case ezRttiBinaryFieldKind::Enum:
+    {
+      ezInt64 iValue = 0;
+      stream >> iValue;
+      static_cast<ezAbstractEnumerationProperty*>(field.m_pProperty)->SetValue(pOwner, iValue);
+      return EZ_SUCCESS;
+    }
+
+    case ezRttiBinaryFieldKind::Object:
+    {
+      void* pTemp = field.m_pClassType->GetAllocator()->Allocate<void>();
+      EZ_SCOPE_EXIT(field.m_pClassType->GetAllocator()->Deallocate(pTemp));
+
+      auto pMember = static_cast<ezAbstractMemberProperty*>(field.m_pProperty);
+      pMember->GetValuePtr(pOwner, pTemp);
+      EZ_SUCCEED_OR_RETURN(ReadObjectData(ctx, storedField.m_uiTypeIndex, field.m_pClassType, pTemp));
+      pMember->SetValuePtr(pOwner, pTemp);
+      return EZ_SUCCESS;
+    }
+
+    case ezRttiBinaryFieldKind::PodArray:
+    {
+      auto pArray = static_cast<ezAbstractArrayProperty*>(field.m_pProperty);
+
+      ezUInt32 uiCount = 0;
+      EZ_SUCCEED_OR_RETURN(stream.ReadDWordValue(&uiCount));
+      pArray->SetCount(pOwner, uiCount);
+
+      for (ezUInt32 i = 0; i < uiCount; ++i)
+      {
+        if (stream.ReadBytes(podBuffer, field.m_uiSize) != field.m_uiSize)
+          return EZ_FAILURE;
+
+        pArray->SetValue(pOwner, i, podBuffer);
+      }
+      return EZ_SUCCESS;
+    }
+
+    case ezRttiBinaryFieldKind::ValueArray:
+    {
+      auto pArray = static_cast<ezAbstractArrayProperty*>(field.m_pProperty);
+
+      ezUInt32 uiCount = 0;
+      EZ_SUCCEED_OR_RETURN(stream.ReadDWordValue(&uiCount));
+      pArray->SetCount(pOwner, uiCount);
+
+      ezVariant value;
+      for (ezUInt32 i = 0; i < uiCount; ++i)
+      {
+        stream >> value;
+        ezReflectionUtils::SetArrayPropertyValue(pArray, pOwner, i, value);
+      }
+      return EZ_SUCCESS;
+    }
+
+    case ezRttiBinaryFieldKind::ObjectArray:
+    {
+      auto pArray = static_cast<ezAbstractArrayProperty*>(field.m_pProperty);
+
+      ezUInt32 uiCount = 0;
+      EZ_SUCCEED_OR_RETURN(stream.ReadDWordValue(&uiCount));
+      pArray->SetCount(pOwner, uiCount);
+
+      if (uiCount == 0)
+        return EZ_SUCCESS;
+
+      void* pTemp = field.m_pClassType->GetAllocator()->Allocate<void>();
+      EZ_SCOPE_EXIT(field.m_pClassType->GetAllocator()->Deallocate(pTemp));
+
+      for (ezUInt32 i = 0; i < uiCount; ++i)
+      {
+        EZ_SUCCEED_OR_RETURN(ReadObjectData(ctx, storedField.m_uiTypeIndex, field.m_pClassType, pTemp));
+        pArray->SetValue(pOwner, i, pTemp);
+      }
+      return EZ_SUCCESS;
+    }
+
+    case ezRttiBinaryFieldKind::Set:
+    {
+      auto pSet = static_cast<ezAbstractSetProperty*>(field.m_pProperty);
+      pSet->Clear(pOwner);
+
+      ezUInt32 uiCount = 0;
+      EZ_SUCCEED_OR_RETURN(stream.ReadDWordValue(&uiCount));
+
+      ezVariant value;
+      for (ezUInt32 i = 0; i < uiCount; ++i)
+      {
+        stream >> value;
+        ezReflectionUtils::InsertSetPropertyValue(pSet, pOwner, value);
+      }
+      return EZ_SUCCESS;
+    }
+
+    case ezRttiBinaryFieldKind::Map:
+    {
+      auto pMap = static_cast<ezAbstractMapProperty*>(field.m_pProperty);
+      pMap->Clear(pOwner);
+
+      ezUInt32 uiCount = 0;
+      EZ_SUCCEED_OR_RETURN(stream.ReadDWordValue(&uiCount));
+
+      ezStringBuilder sKey;
+      ezVariant value;
+      for (ezUInt32 i = 0; i < uiCount; ++i)
+      {
+        EZ_SUCCEED_OR_RETURN(stream.ReadString(sKey));
+        stream >> value;
+        ezReflectionUtils::SetMapPropertyValue(pMap, pOwner, sKey, value);
+      }
+      return EZ_SUCCESS;
+    }
+
+    default:
+      EZ_ASSERT_NOT_IMPLEMENTED;
+      return EZ_FAILURE;
+  }
+}
+
+ezResult ezRttiBinarySerializer::ReadObjectDataConverting(
+  ReadContext& ctx, const StoredType& storedType, const TypePlan* pPlan, void* pObject, ezVariantDictionary& out_unmatchedValues)
+{
+  for (ezUInt32 i = 0; i < storedType.m_Fields.GetCount(); ++i)
+  {
+    const ezUInt32 uiField = pPlan != nullptr ? storedType.m_FieldMapping[i] : ezInvalidIndex;
+    const Field* pField = uiField != ezInvalidIndex ? &pPlan->m_Fields[uiField] : nullptr;
+
+    EZ_SUCCEED_OR_RETURN(ReadFieldConverting(ctx, storedType.m_Fields[i], pField, pObject, out_unmatchedValues));
+  }
+
+  return EZ_SUCCESS;
+}
+
+ezResult ezRttiBinarySerializer::ReadFieldConverting(
+  ReadContext& ctx, const StoredField& storedField, const Field* pField, void* pObject, ezVariantDictionary& out_unmatchedValues)
+{
+  ezStreamReader& stream = *ctx.m_pStream;
+  void* pOwner = pField != nullptr ? static_cast<ezUInt8*>(pObject) + pField->m_uiOwnerOffset : nullptr;
+  const bool bTrackUnmatched = pObject != nullptr;
+
+  ezUInt64 podBuffer[s_uiRttiBinaryMaxPodSize / sizeof(ezUInt64)];
+  const ezVariantType::Enum storedType = static_cast<ezVariantType::Enum>(storedField.m_uiVariantType);
+
+  auto ReadValue = [&](ezRttiBinaryFieldKind kind, ezVariant& out_value) -> ezResult {
+    switch (kind)
+    {
+      case ezRttiBinaryFieldKind::Pod:
+      case ezRttiBinaryFieldKind::PodArray:
+        if (stream.ReadBytes(podBuffer, storedField.m_uiSize) != storedField.m_uiSize)
+          return EZ_FAILURE;
+        out_value = RttiBinaryPodToVariant(storedType, podBuffer);
+        return EZ_SUCCESS;
+
+      case ezRttiBinaryFieldKind::Enum:
+      {
+        ezInt64 iValue = 0;
+        stream >> iValue;
+        out_value = iValue;
+        return EZ_SUCCESS;
+      }
+
+      default:
+        stream >> out_value;
+        return EZ_SUCCESS;
+    }
+  };
+
+  switch (storedField.m_Kind)
+  {
+    case ezRttiBinaryFieldKind::Pod:
+    case ezRttiBinaryFieldKind::Value:
+    case ezRttiBinaryFieldKind::Enum:
+    {
+      ezVariant value;
+      EZ_SUCCEED_OR_RETURN(ReadValue(storedField.m_Kind, value));
+
+      const bool bAssignable = pField != nullptr && pField->m_pProperty->GetCategory() == ezPropertyCategory::Member &&
+                               pField->m_Kind != ezRttiBinaryFieldKind::Object && CanAssignRttiBinaryValue(pField->m_pProperty, value);
+
+      if (bAssignable)
+        ezReflectionUtils::SetMemberPropertyValue(static_cast<ezAbstractMemberProperty*>(pField->m_pProperty), pOwner, value);
+      else if (bTrackUnmatched)
+        out_unmatchedValues.Insert(storedField.m_sName, value);
+
+      return EZ_SUCCESS;
+    }
+
+    case ezRttiBinaryFieldKind::PodArray:
+    case ezRttiBinaryFieldKind::ValueArray:
+    case ezRttiBinaryFieldKind::Set:
+    {
+      ezUInt32 uiCount = 0;
+      EZ_SUCCEED_OR_RETURN(stream.ReadDWordValue(&uiCount));
+
+      ezVariantArray values;
+      values.SetCount(uiCount);
+
+      const ezRttiBinaryFieldKind elementKind =
+        storedField.m_Kind == ezRttiBinaryFieldKind::PodArray ? ezRttiBinaryFieldKind::Pod : ezRttiBinaryFieldKind::Value;
+
+      bool bAssignable = pField != nullptr && IsRttiBinaryArrayKind(pField->m_Kind);
+
+      for (ezVariant& value : values)
+      {
+        EZ_SUCCEED_OR_RETURN(ReadValue(elementKind, value));
+        bAssignable = bAssignable && CanAssignRttiBinaryValue(pField->m_pProperty, value);
+      }
+
+      if (bAssignable && pField->m_Kind == ezRttiBinaryFieldKind::Set)
+      {
+        auto pSet = static_cast<ezAbstractSetProperty*>(pField->m_pProperty);
+        pSet->Clear(pOwner);
+
+        for (const ezVariant& value : values)
+          ezReflectionUtils::InsertSetPropertyValue(pSet, pOwner, value);
+      }
+      else if (bAssignable)
+      {
+        auto pArray = static_cast<ezAbstractArrayProperty*>(pField->m_pProperty);
+        pArray->SetCount(pOwner, uiCount);
+
+        for (ezUInt32 i = 0; i < uiCount; ++i)
+          ezReflectionUtils::SetArrayPropertyValue(pArray, pOwner, i, values[i]);
+      }
+      else if (bTrackUnmatched)
+      {
+        out_unmatchedValues.Insert(storedField.m_sName, values);
+      }
+
+      return EZ_SUCCESS;
+    }
+
+    case ezRttiBinaryFieldKind::Map:
+    {
+      ezUInt32 uiCount = 0;
+      EZ_SUCCEED_OR_RETURN(stream.ReadDWordValue(&uiCount));
+
+      ezVariantDictionary values;
+      bool bAssignable = pField != nullptr && pField->m_Kind == ezRttiBinaryFieldKind::Map;
+
+      ezStringBuilder sKey;
+      ezVariant value;
+      for (ezUInt32 i = 0; i < uiCount; ++i)
+      {
+        EZ_SUCCEED_OR_RETURN(stream.ReadString(sKey));
+        stream >> value;
+        bAssignable = bAssignable && CanAssignRttiBinaryValue(pField->m_pProperty, value);
+        values.Insert(sKey, value);
+      }
+
+      if (bAssignable)
+      {
+        auto pMap = static_cast<ezAbstractMapProperty*>(pField->m_pProperty);
+        pMap->Clear(pOwner);
+
+        for (auto it = values.GetIterator(); it.IsValid(); ++it)
+          ezReflectionUtils::SetMapPropertyValue(pMap, pOwner, it.Key(), it.Value());
+      }
+      else if (bTrackUnmatched)
+      {
+        out_unmatchedValues.Insert(storedField.m_sName, values);
+      }
+
+      return EZ_SUCCESS;
+    }
+
+    case ezRttiBinaryFieldKind::Object:
+    {
+      if (pField == nullptr || pField->m_Kind != ezRttiBinaryFieldKind::Object)
+        return ReadObjectData(ctx, storedField.m_uiTypeIndex, nullptr, nullptr);
+
+      void* pTemp = pField->m_pClassType->GetAllocator()->Allocate<void>();
+      EZ_SCOPE_EXIT(pField->m_pClassType->GetAllocator()->Deallocate(pTemp));
+
+      auto pMember = static_cast<ezAbstractMemberProperty*>(pField->m_pProperty);
+      pMember->GetValuePtr(pOwner, pTemp);
+      EZ_SUCCEED_OR_RETURN(ReadObjectData(ctx, storedField.m_uiTypeIndex, pField->m_pClassType, pTemp));
+      pMember->SetValuePtr(pOwner, pTemp);
+      return EZ_SUCCESS;
+    }
+
+    case ezRttiBinaryFieldKind::ObjectArray:
+    {
+      ezUInt32 uiCount = 0;
+      EZ_SUCCEED_OR_RETURN(stream.ReadDWordValue(&uiCount));
+
+      if (pField == nullptr || pField->m_Kind != ezRttiBinaryFieldKind::ObjectArray)
+      {
+        for (ezUInt32 i = 0; i < uiCount; ++i)
+          EZ_SUCCEED_OR_RETURN(ReadObjectData(ctx, storedField.m_uiTypeIndex, nullptr, nullptr));
+
+        return EZ_SUCCESS;
+      }
+
+      auto pArray = static_cast<ezAbstractArrayProperty*>(pField->m_pProperty);
+      pArray->SetCount(pOwner, uiCount);
+
+      if (uiCount == 0)
+        return EZ_SUCCESS;
+
+      void* pTemp = pField->m_pClassType->GetAllocator()->Allocate<void>();
+      EZ_SCOPE_EXIT(pField->m_pClassType->GetAllocator()->Deallocate(pTemp));
+
+      for (ezUInt32 i = 0; i < uiCount; ++i)
+      {
+        EZ_SUCCEED_OR_RETURN(ReadObjectData(ctx, storedField.m_uiTypeIndex, pField->m_pClassType, pTemp));
+        pArray->SetValue(pOwner, i, pTemp);
+      }
+      return EZ_SUCCESS;
+    }
+
+    default:
+      EZ_ASSERT_NOT_IMPLEMENTED;
+      return EZ_FAILURE;
+  }
+}
+
+EZ_STATICLINK_FILE(Foundation, Foundation_Serialization_Implementation_RttiBinarySerializer);
@@ -0,0 +1,90 @@
+#pragma once
+
+/// \file
+
+#include <Foundation/Basics.h>
+#include <Foundation/Containers/HashTable.h>
+#include <Foundation/IO/Stream.h>
+#include <Foundation/Reflection/Reflection.h>
+#include <Foundation/Types/Delegate.h>
+#include <Foundation/Types/UniquePtr.h>
+
+/// \brief Writes reflected objects to packed binary data and reads them back, without going through an ezAbstractObjectGraph.
+///
+/// For every type that it encounters, the serializer compiles a layout plan once and caches it: member properties with direct access
+/// and a plain data type (numbers, vectors, matrices, colors, ...) are read and written straight from and to the object memory,
+/// consecutive ones as a single block. Everything else (strings, enums, properties behind accessors, arrays, sets, maps, embedded
+/// structs) gets a dedicated step in the plan. Members of embedded structs with direct access are folded into the plan of the outer type.
+///
+/// The written data starts with the schema of all types that it contains (property names and encodings). When reading, data whose
+/// schema matches the runtime type is read with the compiled plan directly. Otherwise the values are matched to the runtime properties
+/// by name and converted where necessary, and the version patch function (see SetVersionPatchFunc()) gets to handle the rest.
+///
+/// Pointer properties are not supported, WriteObject() fails for types that have any. Read-only properties are skipped.
+/// The cached plans reference the ezRTTI types, so an instance must not outlive the plugins whose types it serialized.
+/// An instance must not be used from multiple threads at the same time.
+class EZ_FOUNDATION_DLL ezRttiBinarySerializer
+{
+  EZ_DISALLOW_COPY_AND_ASSIGN(ezRttiBinarySerializer);
+
+public:
+  /// \brief Called after an object was read, if its type has a different version or a different schema than when it was written.
+  ///
+  /// unmatchedValues contains all stored values that could not be assigned to a property of the runtime type, because the property
+  /// does not exist anymore or its type is incompatible. Arrays and sets are passed as ezVariantArray, maps as ezVariantDictionary,
+  /// values of embedded structs use the name of the struct property as a prefix, e.g. "Transform.Position".
+  using VersionPatchFunc =
+    ezDelegate<void(const ezRTTI* pType, void* pObject, ezUInt32 uiStoredVersion, const ezVariantDictionary& unmatchedValues)>;
+
+  ezRttiBinarySerializer();
+  ~ezRttiBinarySerializer();
+
+  /// \brief Sets the function through which objects can be patched after reading data from an older version of their type.
+  void SetVersionPatchFunc(const VersionPatchFunc& func) { m_VersionPatchFunc = func; }
+
+  /// \brief Writes all properties of pObject to the stream. Fails if the type has properties that cannot be serialized.
+  ///
+  /// For types derived from ezReflectedClass, the dynamic type of the object is written.
+  ezResult WriteObject(ezStreamWriter& stream, const ezRTTI* pRtti, const void* pObject); // [tested]
+
+  /// \brief Allocates an object of the written type and reads its properties. Returns nullptr if the data could not be read.
+  ///
+  /// The object is allocated through the ezRTTIAllocator of its type and must be deallocated through it as well.
+  void* ReadObject(ezStreamReader& stream, const ezRTTI*& out_pRtti); // [tested]
+
+  /// \brief Reads the properties of the written object into the given existing object.
+  ///
+  /// The type of pObject does not have to match the written type. Properties are then matched by name.
+  ezResult ReadObjectProperties(ezStreamReader& stream, const ezRTTI* pRtti, void* pObject); // [tested]
+
+  /// \brief Discards all compiled plans. Must be called when types are unloaded, e.g. when a plugin gets reloaded.
+  void ClearCache();
+
+private:
+  struct Field;
+  struct TypePlan;
+  struct StoredField;
+  struct StoredType;
+  struct ReadContext;
+
+  const TypePlan* GetPlan(const ezRTTI* pRtti, const void* pSampleObject);
+  void CompileProperties(TypePlan& plan, const ezRTTI* pRtti, const void* pOwner, ezUInt32 uiOwnerOffset, const char* szPrefix);
+  void CompileSteps(TypePlan& plan);
+
+  ezResult WriteSchema(ezStreamWriter& stream, const TypePlan* pRootPlan);
+  ezResult WriteObjectData(ezStreamWriter& stream, const TypePlan& plan, const void* pObject);
+  ezResult WriteField(ezStreamWriter& stream, const Field& field, const void* pOwner);
+
+  ezResult ReadSchema(ReadContext& ctx);
+  void ResolveStoredType(ReadContext& ctx, StoredType& storedType, const TypePlan& plan);
+  ezResult ReadObjectData(ReadContext& ctx, ezUInt32 uiStoredType, const ezRTTI* pRtti, void* pObject);
+  ezResult ReadObjectDataMatching(ReadContext& ctx, const StoredType& storedType, const TypePlan& plan, void* pObject);
+  ezResult ReadField(ReadContext& ctx, const StoredField& storedField, const Field& field, void* pOwner);
+  ezResult ReadObjectDataConverting(
+    ReadContext& ctx, const StoredType& storedType, const TypePlan* pPlan, void* pObject, ezVariantDictionary& out_unmatchedValues);
+  ezResult ReadFieldConverting(ReadContext& ctx, const StoredField& storedField, const Field* pField, void* pObject,
+    ezVariantDictionary& out_unmatchedValues);
+
+  ezHashTable<const ezRTTI*, ezUniquePtr<TypePlan>> m_Plans;
+  VersionPatchFunc m_VersionPatchFunc;
+};
@@ -108,6 +108,9 @@ void ezCrashHandler_WriteMiniDump::HandleCrash(void* pOsSpecificData)
   {
     ezLog::Error("Application crashed. Crash-dump written to '{}'.", m_sDumpFilePath);
   }
+
+  // the process is about to terminate, make sure the log writers received everything
+  ezGlobalLog::FlushAsyncMessages();
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -75,8 +75,18 @@
 #    endif
 #  endif
 
+// Uncomment to sample allocations for heap profiles, see ezSampledHeapProfile. This is cheap enough to be used in release builds.
+//#undef EZ_USE_ALLOCATION_SAMPLING
+//#define EZ_USE_ALLOCATION_SAMPLING EZ_ON
+
 // Uncomment to use guarded allocations. This will use a lot of memory and should only be used in 64bit builds.
 //#undef EZ_USE_GUARDED_ALLOCATIONS
 //#define EZ_USE_GUARDED_ALLOCATIONS EZ_ON
 
+// Uncomment to use ezThreadCachingAllocator as the default heap allocator. Individual allocations are not tracked then,
+// which means memory leaks of the default heap are not reported.
+// Applications can also choose it at startup with the command line option '-ThreadCachingAllocator [on|off]', which overrides this.
+//#undef EZ_USE_THREAD_CACHING_ALLOCATOR
+//#define EZ_USE_THREAD_CACHING_ALLOCATOR EZ_ON
+
 #endif
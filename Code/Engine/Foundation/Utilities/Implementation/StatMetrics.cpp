@@ -0,0 +1,348 @@
+#include <FoundationPCH.h>
+
+#include <Foundation/Strings/StringBuilder.h>
+#include <Foundation/Threading/AtomicInteger.h>
+#include <Foundation/Threading/Mutex.h>
+#include <Foundation/Utilities/StatMetrics.h>
+#include <Foundation/Utilities/Stats.h>
+
+EZ_ENUMERABLE_CLASS_IMPLEMENTATION(ezStatMetric);
+
+namespace
+{
+  static ezMutex s_StatMetricsMutex;
+  static ezAtomicInteger32 s_iNextShardIndex;
+  static thread_local ezUInt32 s_uiThreadShardIndex = ezInvalidIndex;
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+
+ezStatMetric::ezStatMetric(const char* szName)
+  : m_szName(szName)
+{
+}
+
+void ezStatMetric::UpdateAll(bool bPublishToStats /*= true*/)
+{
+  EZ_LOCK(s_StatMetricsMutex);
+
+  for (ezStatMetric* pMetric = GetFirstInstance(); pMetric != nullptr; pMetric = pMetric->GetNextInstance())
+  {
+    pMetric->Aggregate();
+
+    if (bPublishToStats)
+    {
+      pMetric->Publish();
+    }
+  }
+}
+
+ezStatMetric* ezStatMetric::FindMetricByName(const char* szName)
+{
+  for (ezStatMetric* pMetric = GetFirstInstance(); pMetric != nullptr; pMetric = pMetric->GetNextInstance())
+  {
+    if (ezStringUtils::IsEqual(pMetric->GetName(), szName))
+      return pMetric;
+  }
+
+  return nullptr;
+}
+
+ezUInt32 ezStatMetric::GetThreadShardIndex()
+{
+  if (s_uiThreadShardIndex == ezInvalidIndex)
+  {
+    // distribute threads round robin, so that the worker threads end up on different shards
+    s_uiThreadShardIndex = static_cast<ezUInt32>(s_iNextShardIndex.PostIncrement()) % NumShards;
+  }
+
+  return s_uiThreadShardIndex;
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+ezStatCounter::ezStatCounter(const char* szName, bool bPublishPerFrame /*= false*/)
+  : ezStatMetric(szName)
+  , m_bPublishPerFrame(bPublishPerFrame)
+{
+}
+
+void ezStatCounter::Add(ezInt64 iValue)
+{
+  ezAtomicUtils::Add(m_Shards[GetThreadShardIndex()].m_iValue, iValue);
+}
+
+ezInt64 ezStatCounter::GetValue() const
+{
+  // Aggregate() moves the shard values into m_iTotal, which is not atomic
+  EZ_LOCK(s_StatMetricsMutex);
+
+  ezInt64 iValue = m_iTotal;
+
+  for (const Shard& shard : m_Shards)
+  {
+    iValue += ezAtomicUtils::Read(shard.m_iValue);
+  }
+
+  return iValue;
+}
+
+void ezStatCounter::Reset()
+{
+  EZ_LOCK(s_StatMetricsMutex);
+
+  for (Shard& shard : m_Shards)
+  {
+    ezAtomicUtils::Set(shard.m_iValue, 0);
+  }
+
+  m_iTotal = 0;
+  m_iLastFrameValue = 0;
+}
+
+void ezStatCounter::Aggregate()
+{
+  ezInt64 iFrameValue = 0;
+
+  for (Shard& shard : m_Shards)
+  {
+    iFrameValue += ezAtomicUtils::Set(shard.m_iValue, 0);
+  }
+
+  m_iTotal += iFrameValue;
+  m_iLastFrameValue = iFrameValue;
+}
+
+void ezStatCounter::Publish() const
+{
+  ezStats::SetStat(m_szName, m_bPublishPerFrame ? m_iLastFrameValue : m_iTotal);
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+ezStatGauge::ezStatGauge(const char* szName)
+  : ezStatMetric(szName)
+{
+}
+
+void ezStatGauge::Set(ezInt64 iValue)
+{
+  ezAtomicUtils::Set(m_iValue, iValue);
+}
+
+void ezStatGauge::Add(ezInt64 iValue)
+{
+  ezAtomicUtils::Add(m_iValue, iValue);
+}
+
+ezInt64 ezStatGauge::GetValue() const
+{
+  return ezAtomicUtils::Read(m_iValue);
+}
+
+void ezStatGauge::Reset()
+{
+  EZ_LOCK(s_StatMetricsMutex);
+
+  ezAtomicUtils::Set(m_iValue, 0);
+  m_iMaxValue = 0;
+}
+
+void ezStatGauge::Aggregate()
+{
+  m_iMaxValue = ezMath::Max(m_iMaxValue, GetValue());
+}
+
+void ezStatGauge::Publish() const
+{
+  ezStats::SetStat(m_szName, GetValue());
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+double ezStatHistogramSnapshot::GetMean() const
+{
+  if (m_uiCount == 0)
+    return 0.0;
+
+  return static_cast<double>(m_uiSum) / static_cast<double>(m_uiCount);
+}
+
+ezUInt64 ezStatHistogramSnapshot::GetPercentile(double fPercentile) const
+{
+  if (m_uiCount == 0)
+    return 0;
+
+  const ezUInt64 uiTarget = ezMath::Max<ezUInt64>(1, static_cast<ezUInt64>(ezMath::Ceil(ezMath::Clamp(fPercentile, 0.0, 1.0) * m_uiCount)));
+
+  ezUInt64 uiCumulative = 0;
+  for (ezUInt32 i = 0; i < m_BucketCounts.GetCount(); ++i)
+  {
+    uiCumulative += m_BucketCounts[i];
+
+    if (uiCumulative >= uiTarget)
+    {
+      return ezMath::Clamp(ezStatHistogram::GetBucketUpperBound(i), m_uiMin, m_uiMax);
+    }
+  }
+
+  return m_uiMax;
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+ezStatHistogram::ezStatHistogram(const char* szName)
+  : ezStatMetric(szName)
+{
+  m_Aggregated.m_BucketCounts.SetCount(NumBuckets);
+}
+
+void ezStatHistogram::Record(ezUInt64 uiValue)
+{
+  uiValue = ezMath::Min(uiValue, MaxValue);
+
+  const ezUInt32 uiBucketIndex = GetBucketIndex(uiValue);
+
+  Shard& shard = m_Shards[GetThreadShardIndex()];
+  EZ_LOCK(shard.m_Mutex);
+
+  ++shard.m_Buckets[uiBucketIndex];
+  ++shard.m_uiCount;
+  shard.m_uiSum += uiValue;
+  shard.m_uiMin = ezMath::Min(shard.m_uiMin, uiValue);
+  shard.m_uiMax = ezMath::Max(shard.m_uiMax, uiValue);
+}
+
+void ezStatHistogram::GetSnapshot(ezStatHistogramSnapshot& out_Snapshot)
+{
+  EZ_LOCK(s_StatMetricsMutex);
+
+  Aggregate();
+  out_Snapshot = m_Aggregated;
+}
+
+void ezStatHistogram::Reset()
+{
+  EZ_LOCK(s_StatMetricsMutex);
+
+  for (Shard& shard : m_Shards)
+  {
+    EZ_LOCK(shard.m_Mutex);
+
+    shard.m_uiCount = 0;
+    shard.m_uiSum = 0;
+    shard.m_uiMin = ezMath::MaxValue<ezUInt64>();
+    shard.m_uiMax = 0;
+
+    for (ezUInt32& uiCount : shard.m_Buckets)
+    {
+      uiCount = 0;
+    }
+  }
+
+  m_Aggregated.m_uiCount = 0;
+  m_Aggregated.m_uiSum = 0;
+  m_Aggregated.m_uiMin = 0;
+  m_Aggregated.m_uiMax = 0;
+
+  for (ezUInt64& uiCount : m_Aggregated.m_BucketCounts)
+  {
+    uiCount = 0;
+  }
+}
+
+ezUInt32 ezStatHistogram::GetBucketIndex(ezUInt64 uiValue)
+{
+  uiValue = ezMath::Min(uiValue, MaxValue);
+
+  if (uiValue < SubBucketCount)
+    return static_cast<ezUInt32>(uiValue);
+
+  const ezUInt32 uiHigh = static_cast<ezUInt32>(uiValue >> 32);
+  const ezUInt32 uiHighestBit = uiHigh != 0 ? 32 + ezMath::FirstBitHigh(uiHigh) : ezMath::FirstBitHigh(static_cast<ezUInt32>(uiValue));
+  const ezUInt32 uiShift = uiHighestBit - SubBucketBits;
+  const ezUInt32 uiSubBucket = static_cast<ezUInt32>(uiValue >> uiShift) & (SubBucketCount - 1);
+
+  return (uiShift + 1) * SubBucketCount + uiSubBucket;
+}
+
+ezUInt64 ezStatHistogram::GetBucketLowerBound(ezUInt32 uiBucketIndex)
+{
+  if (uiBucketIndex < SubBucketCount)
+    return uiBucketIndex;
+
+  const ezUInt32 uiShift = uiBucketIndex / SubBucketCount - 1;
+  const ezUInt64 uiSubBucket = uiBucketIndex % SubBucketCount;
+
+  return (SubBucketCount + uiSubBucket) << uiShift;
+}
+
+ezUInt64 ezStatHistogram::GetBucketUpperBound(ezUInt32 uiBucketIndex)
+{
+  if (uiBucketIndex < SubBucketCount)
+    return uiBucketIndex;
+
+  const ezUInt32 uiShift = uiBucketIndex / SubBucketCount - 1;
+  return GetBucketLowerBound(uiBucketIndex) + (1ull << uiShift) - 1;
+}
+
+void ezStatHistogram::Aggregate()
+{
+  for (Shard& shard : m_Shards)
+  {
+    EZ_LOCK(shard.m_Mutex);
+
+    // skip the (large) bucket array of shards that did not receive any records since the last update
+    if (shard.m_uiCount == 0)
+      continue;
+
+    for (ezUInt32 i = 0; i < NumBuckets; ++i)
+    {
+      // most buckets are empty, reading first avoids writing to cache lines that are not affected
+      if (shard.m_Buckets[i] == 0)
+        continue;
+
+      m_Aggregated.m_BucketCounts[i] += shard.m_Buckets[i];
+      shard.m_Buckets[i] = 0;
+    }
+
+    m_Aggregated.m_uiMin = m_Aggregated.m_uiCount == 0 ? shard.m_uiMin : ezMath::Min(m_Aggregated.m_uiMin, shard.m_uiMin);
+    m_Aggregated.m_uiMax = ezMath::Max(m_Aggregated.m_uiMax, shard.m_uiMax);
+    m_Aggregated.m_uiCount += shard.m_uiCount;
+    m_Aggregated.m_uiSum += shard.m_uiSum;
+
+    shard.m_uiCount = 0;
+    shard.m_uiSum = 0;
+    shard.m_uiMin = ezMath::MaxValue<ezUInt64>();
+    shard.m_uiMax = 0;
+  }
+}
+
+void ezStatHistogram::Publish() const
+{
+  if (m_Aggregated.m_uiCount == 0)
+    return;
+
+  ezStringBuilder sName;
+
+  sName.Set(m_szName, "/Count");
+  ezStats::SetStat(sName, m_Aggregated.m_uiCount);
+
+  sName.Set(m_szName, "/Mean");
+  ezStats::SetStat(sName, m_Aggregated.GetMean());
+
+  sName.Set(m_szName, "/P50");
+  ezStats::SetStat(sName, m_Aggregated.GetPercentile(0.5));
+
+  sName.Set(m_szName, "/P90");
+  ezStats::SetStat(sName, m_Aggregated.GetPercentile(0.9));
+
+  sName.Set(m_szName, "/P99");
+  ezStats::SetStat(sName, m_Aggregated.GetPercentile(0.99));
+
+  sName.Set(m_szName, "/Max");
+  ezStats::SetStat(sName, m_Aggregated.m_uiMax);
+}
+
+
+EZ_STATICLINK_FILE(Foundation, Foundation_Utilities_Implementation_StatMetrics);
@@ -0,0 +1,224 @@
+#pragma once
+
+#include <Foundation/Basics.h>
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Math/Math.h>
+#include <Foundation/Threading/Mutex.h>
+#include <Foundation/Time/Time.h>
+#include <Foundation/Utilities/EnumerableClass.h>
+
+/// \brief Describes of which type an ezStatMetric is. Use that info to cast an ezStatMetric* to the proper derived class.
+struct ezStatMetricType
+{
+  enum Enum
+  {
+    Counter,   ///< Can cast the ezStatMetric* to ezStatCounter*
+    Gauge,     ///< Can cast the ezStatMetric* to ezStatGauge*
+    Histogram, ///< Can cast the ezStatMetric* to ezStatHistogram*
+    ENUM_COUNT
+  };
+};
+
+/// \brief Base class for typed, pre-registered statistics that are cheap enough to be updated from hot code paths.
+///
+/// ezStats stores arbitrary ezVariant values in a mutex protected map and broadcasts an event on every change, which is
+/// too expensive to be called thousands of times per frame. Stat metrics are instead declared as global objects (similar to CVars),
+/// updating them only touches a per-thread shard. Counters update it with a single atomic operation, histograms take the lock of the shard,
+/// which is only contended while the shard is aggregated or when more threads than shards record values at the same time.
+/// Once per frame UpdateAll() aggregates all shards and publishes the results through ezStats, which means they also show up in
+/// ezInspector through ezTelemetry.
+///
+/// The name may contain slashes to define groups, just like the names passed to ezStats::SetStat().
+/// The name string must stay valid for the lifetime of the metric, typically it is a string literal.
+class EZ_FOUNDATION_DLL ezStatMetric : public ezEnumerable<ezStatMetric>
+{
+  EZ_DECLARE_ENUMERABLE_CLASS(ezStatMetric);
+
+public:
+  /// \brief The number of shards that updates are distributed across. Each thread always writes to the same shard.
+  static constexpr ezUInt32 NumShards = 8;
+
+  /// \brief Aggregates the per-thread data of all metrics and optionally publishes the values through ezStats.
+  ///
+  /// Should be called once per frame. ezGameApplicationBase does this automatically at the end of every frame.
+  static void UpdateAll(bool bPublishToStats = true);
+
+  /// \brief Searches all metrics for one with the given name. Returns nullptr if no metric could be found. The name is case-sensitive.
+  static ezStatMetric* FindMetricByName(const char* szName);
+
+  /// \brief Returns the name of the metric.
+  const char* GetName() const { return m_szName; }
+
+  /// \brief Returns the type of the metric.
+  virtual ezStatMetricType::Enum GetType() const = 0;
+
+  /// \brief Resets all accumulated data of the metric.
+  virtual void Reset() = 0;
+
+protected:
+  ezStatMetric(const char* szName);
+
+  /// \brief Returns the shard that the calling thread writes to.
+  static ezUInt32 GetThreadShardIndex();
+
+  /// \brief Folds the per-thread data into the aggregated values. Called with the update mutex held.
+  virtual void Aggregate() = 0;
+
+  /// \brief Publishes the aggregated values through ezStats.
+  virtual void Publish() const = 0;
+
+  const char* m_szName;
+};
+
+/// \brief A monotonically increasing (or decreasing) 64 bit counter, e.g. for the number of processed items.
+///
+/// If bPublishPerFrame is true, the value that is published through ezStats is the delta accumulated during the last frame,
+/// otherwise it is the total value.
+class EZ_FOUNDATION_DLL ezStatCounter : public ezStatMetric
+{
+public:
+  ezStatCounter(const char* szName, bool bPublishPerFrame = false);
+
+  virtual ezStatMetricType::Enum GetType() const override { return ezStatMetricType::Counter; }
+
+  /// \brief Adds one to the counter. Lock-free and safe to call from any thread.
+  void Increment() { Add(1); }
+
+  /// \brief Adds the given value to the counter. Lock-free and safe to call from any thread.
+  void Add(ezInt64 iValue);
+
+  /// \brief Returns the total value including updates that have not been aggregated yet.
+  ///
+  /// Takes the same lock as ezStatMetric::UpdateAll(), so that no update is missed or counted twice while the shards are aggregated.
+  ezInt64 GetValue() const;
+
+  /// \brief Returns the value that was accumulated between the last two calls to ezStatMetric::UpdateAll().
+  ezInt64 GetValueLastFrame() const { return m_iLastFrameValue; }
+
+  virtual void Reset() override;
+
+protected:
+  virtual void Aggregate() override;
+  virtual void Publish() const override;
+
+private:
+  struct EZ_ALIGN(Shard, 64)
+  {
+    volatile ezInt64 m_iValue = 0;
+  };
+
+  bool m_bPublishPerFrame;
+  ezInt64 m_iTotal = 0;
+  ezInt64 m_iLastFrameValue = 0;
+  Shard m_Shards[NumShards];
+};
+
+/// \brief A value that is set to an absolute value, e.g. the number of currently active objects.
+///
+/// Gauges don't use per-thread shards, since only the last written value matters.
+class EZ_FOUNDATION_DLL ezStatGauge : public ezStatMetric
+{
+public:
+  ezStatGauge(const char* szName);
+
+  virtual ezStatMetricType::Enum GetType() const override { return ezStatMetricType::Gauge; }
+
+  /// \brief Sets the value of the gauge. Lock-free and safe to call from any thread.
+  void Set(ezInt64 iValue);
+
+  /// \brief Adds to the value of the gauge. Lock-free and safe to call from any thread.
+  void Add(ezInt64 iValue);
+
+  /// \brief Returns the current value.
+  ezInt64 GetValue() const;
+
+  /// \brief Returns the largest value that the gauge had at the time of any UpdateAll() call since the last reset.
+  ezInt64 GetMaxValue() const { return m_iMaxValue; }
+
+  virtual void Reset() override;
+
+protected:
+  virtual void Aggregate() override;
+  virtual void Publish() const override;
+
+private:
+  volatile ezInt64 m_iValue = 0;
+  ezInt64 m_iMaxValue = 0;
+};
+
+/// \brief The aggregated state of an ezStatHistogram at some point in time.
+struct EZ_FOUNDATION_DLL ezStatHistogramSnapshot
+{
+  ezUInt64 m_uiCount = 0;
+  ezUInt64 m_uiSum = 0;
+  ezUInt64 m_uiMin = 0;
+  ezUInt64 m_uiMax = 0;
+  ezDynamicArray<ezUInt64> m_BucketCounts;
+
+  /// \brief Returns the average of all recorded values.
+  double GetMean() const;
+
+  /// \brief Returns an upper bound for the value below which the given fraction of all recorded values fall.
+  ///
+  /// fPercentile must be in [0; 1] range, e.g. 0.99 for the 99th percentile.
+  /// The result is accurate within the relative precision of the histogram buckets (about 6%) and always in [min; max] range.
+  ezUInt64 GetPercentile(double fPercentile) const;
+};
+
+/// \brief A histogram with logarithmically spaced buckets (HDR histogram style) for latencies or sizes.
+///
+/// Values below 16 are recorded exactly. Above that, every power of two is split into 16 linear sub-buckets,
+/// which bounds the relative error to 1/16. Values larger than MaxValue are clamped.
+/// Data is accumulated until Reset() is called, percentiles are thus computed over the whole recorded range.
+class EZ_FOUNDATION_DLL ezStatHistogram : public ezStatMetric
+{
+public:
+  static constexpr ezUInt32 SubBucketBits = 4;
+  static constexpr ezUInt32 SubBucketCount = 1u << SubBucketBits;
+  static constexpr ezUInt32 MaxValueBits = 40;
+  static constexpr ezUInt64 MaxValue = (1ull << MaxValueBits) - 1;
+  static constexpr ezUInt32 NumBuckets = (MaxValueBits - SubBucketBits + 1) * SubBucketCount;
+
+  ezStatHistogram(const char* szName);
+
+  virtual ezStatMetricType::Enum GetType() const override { return ezStatMetricType::Histogram; }
+
+  /// \brief Records one value. Safe to call from any thread, only locks the shard of the calling thread.
+  void Record(ezUInt64 uiValue);
+
+  /// \brief Records a duration in microseconds.
+  void RecordTime(ezTime duration) { Record(static_cast<ezUInt64>(ezMath::Max(0.0, duration.GetMicroseconds()))); }
+
+  /// \brief Aggregates all pending records and returns the current state of the histogram.
+  void GetSnapshot(ezStatHistogramSnapshot& out_Snapshot);
+
+  virtual void Reset() override;
+
+  /// \brief Returns the index of the bucket into which the given value is sorted.
+  static ezUInt32 GetBucketIndex(ezUInt64 uiValue);
+
+  /// \brief Returns the smallest value that is sorted into the given bucket.
+  static ezUInt64 GetBucketLowerBound(ezUInt32 uiBucketIndex);
+
+  /// \brief Returns the largest value that is sorted into the given bucket.
+  static ezUInt64 GetBucketUpperBound(ezUInt32 uiBucketIndex);
+
+protected:
+  virtual void Aggregate() override;
+  virtual void Publish() const override;
+
+private:
+  /// All values of a shard are updated under its mutex, so that count, sum and buckets always match.
+  struct EZ_ALIGN(Shard, 64)
+  {
+    ezMutex m_Mutex;
+    ezUInt64 m_uiCount = 0;
+    ezUInt64 m_uiSum = 0;
+    ezUInt64 m_uiMin = ezMath::MaxValue<ezUInt64>();
+    ezUInt64 m_uiMax = 0;
+    ezUInt32 m_Buckets[NumBuckets] = {};
+  };
+
+  ezStatHistogramSnapshot m_Aggregated;
+  Shard m_Shards[NumShards];
+};
@@ -15,6 +15,9 @@ static void CompileDummy()
   graph.Initialize(ezVec3::ZeroVector(), ezVec3::ZeroVector());
   auto& pt = graph.AddPoint(ezVec3::ZeroVector());
 
+  ezVec3 positions[2];
+  graph.AddPoints(positions);
+
   ezDynamicArray<ezUInt32> points;
   graph.FindPointsOfInterest(ezVec3::ZeroVector(), 0, points);
 }
@@ -15,11 +15,32 @@ POINTTYPE& ezPointOfInterestGraph<POINTTYPE>::AddPoint(const ezVec3& position)
   const ezUInt32 id = m_Points.GetCount();
   auto& pt = m_Points.ExpandAndGetRef();
 
-  m_Octree.InsertObject(position, ezVec3::ZeroVector(), 0, id, nullptr, true);
+  m_Octree.InsertObject(position, ezVec3::ZeroVector(), 0, id, true).IgnoreResult();
 
   return pt;
 }
 
+template <typename POINTTYPE>
+ezUInt32 ezPointOfInterestGraph<POINTTYPE>::AddPoints(ezArrayPtr<const ezVec3> positions)
+{
+  const ezUInt32 uiFirstID = m_Points.GetCount();
+  m_Points.SetCount(uiFirstID + positions.GetCount());
+
+  ezDynamicArray<ezLinearTreeObjectDesc> objects;
+  objects.SetCount(positions.GetCount());
+
+  for (ezUInt32 i = 0; i < positions.GetCount(); ++i)
+  {
+    objects[i].m_vCenter = positions[i];
+    objects[i].m_vHalfExtents.SetZero();
+    objects[i].m_iObjectInstance = uiFirstID + i;
+  }
+
+  m_Octree.InsertObjects(objects, true);
+
+  return uiFirstID;
+}
+
 template <typename POINTTYPE>
 void ezPointOfInterestGraph<POINTTYPE>::FindPointsOfInterest(const ezVec3& position, float radius, ezDynamicArray<ezUInt32>& out_Points) const
 {
@@ -34,10 +55,10 @@ void ezPointOfInterestGraph<POINTTYPE>::FindPointsOfInterest(const ezVec3& posit
   Data data;
   data.m_pResults = &out_Points;
 
-  auto cb = [](void* pPassThrough, ezDynamicTreeObjectConst Object) -> bool {
+  auto cb = [](void* pPassThrough, const ezLinearTreeObject& Object) -> bool {
     auto pData = static_cast<Data*>(pPassThrough);
 
-    const ezUInt32 id = (ezUInt32)Object.Value().m_iObjectInstance;
+    const ezUInt32 id = (ezUInt32)Object.m_iObjectInstance;
     pData->m_pResults->PushBack(id);
 
     return true;
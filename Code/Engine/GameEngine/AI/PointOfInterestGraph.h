@@ -1,8 +1,9 @@
 #pragma once
 
+#include <Foundation/Containers/Deque.h>
 #include <Foundation/Math/Vec3.h>
 #include <GameEngine/GameEngineDLL.h>
-#include <Utilities/DataStructures/DynamicOctree.h>
+#include <Utilities/DataStructures/LinearOctree.h>
 
 template <typename POINTTYPE>
 class ezPointOfInterestGraph
@@ -12,6 +13,9 @@ public:
 
   POINTTYPE& AddPoint(const ezVec3& position);
 
+  /// \brief Adds all points at once, which is much faster than calling AddPoint() for each of them. Returns the index of the first new point.
+  ezUInt32 AddPoints(ezArrayPtr<const ezVec3> positions);
+
   void FindPointsOfInterest(const ezVec3& position, float radius, ezDynamicArray<ezUInt32>& out_Points) const;
 
   const ezDeque<POINTTYPE>& GetPoints() const { return m_Points; }
@@ -19,7 +23,7 @@ public:
 
 private:
   ezDeque<POINTTYPE> m_Points;
-  ezDynamicOctree m_Octree;
+  ezLinearOctree m_Octree;
 };
 
 #include <GameEngine/AI/Implementation/PointOfInterestGraph_inl.h>
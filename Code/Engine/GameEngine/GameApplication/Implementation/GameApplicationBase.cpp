@@ -12,6 +12,7 @@
 #include <Foundation/Threading/TaskSystem.h>
 #include <Foundation/Time/Clock.h>
 #include <Foundation/Time/Timestamp.h>
+#include <Foundation/Utilities/StatMetrics.h>
 #include <GameEngine/ActorSystem/ActorManager.h>
 #include <GameEngine/GameApplication/GameApplicationBase.h>
 #include <GameEngine/Interfaces/FrameCaptureInterface.h>
@@ -508,6 +509,7 @@ void ezGameApplicationBase::Run_FinishFrame()
   ezTaskSystem::FinishFrameTasks();
   ezFrameAllocator::Swap();
   ezProfilingSystem::StartNewFrame();
+  ezStatMetric::UpdateAll();
 
   // if many messages have been logged, make sure they get written to disk
   ezLog::Flush(100, ezTime::Seconds(10));
@@ -42,6 +42,35 @@ void ezPrefabResource::InstantiatePrefab(ezWorld& world, const ezTransform& root
   }
 }
 
+void ezPrefabResource::InstantiatePrefabs(ezWorld& world, ezArrayPtr<const ezTransform> rootTransforms, ezGameObjectHandle hParent,
+  ezDynamicArray<ezGameObject*>* out_CreatedRootObjects, const ezUInt16* pOverrideTeamID,
+  const ezArrayMap<ezHashedString, ezVariant>* pExposedParamValues, bool bForceDynamic)
+{
+  if (GetLoadingState() != ezResourceState::Loaded)
+    return;
+
+  if (pExposedParamValues != nullptr && !pExposedParamValues->IsEmpty())
+  {
+    // exposed parameters need the created objects of every individual instance
+    ezHybridArray<ezGameObject*, 8> createdRootObjects;
+
+    for (const ezTransform& rootTransform : rootTransforms)
+    {
+      createdRootObjects.Clear();
+      InstantiatePrefab(world, rootTransform, hParent, &createdRootObjects, pOverrideTeamID, pExposedParamValues, bForceDynamic);
+
+      if (out_CreatedRootObjects != nullptr)
+      {
+        out_CreatedRootObjects->PushBackRange(createdRootObjects);
+      }
+    }
+  }
+  else
+  {
+    m_WorldReader.InstantiatePrefabs(world, rootTransforms, hParent, out_CreatedRootObjects, pOverrideTeamID, bForceDynamic);
+  }
+}
+
 void ezPrefabResource::ApplyExposedParameterValues(const ezArrayMap<ezHashedString, ezVariant>* pExposedParamValues,
   const ezHybridArray<ezGameObject*, 8>& createdChildObjects, const ezHybridArray<ezGameObject*, 8>& createdRootObjects) const
 {
@@ -40,6 +40,13 @@ public:
     ezHybridArray<ezGameObject*, 8>* out_CreatedRootObjects, const ezUInt16* pOverrideTeamID,
     const ezArrayMap<ezHashedString, ezVariant>* pExposedParamValues, bool bForceDynamic);
 
+  /// \brief Creates one instance of this prefab per given root transform, which is cheaper than calling InstantiatePrefab() in a loop.
+  ///
+  /// If out_CreatedRootObjects is valid, the root objects of all instances are appended to it.
+  void InstantiatePrefabs(ezWorld& world, ezArrayPtr<const ezTransform> rootTransforms, ezGameObjectHandle hParent,
+    ezDynamicArray<ezGameObject*>* out_CreatedRootObjects, const ezUInt16* pOverrideTeamID,
+    const ezArrayMap<ezHashedString, ezVariant>* pExposedParamValues, bool bForceDynamic);
+
   void ApplyExposedParameterValues(const ezArrayMap<ezHashedString, ezVariant>* pExposedParamValues,
     const ezHybridArray<ezGameObject*, 8>& createdChildObjects, const ezHybridArray<ezGameObject*, 8>& createdRootObjects) const;
 
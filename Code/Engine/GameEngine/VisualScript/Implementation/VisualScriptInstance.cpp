@@ -13,6 +13,33 @@
 
 ezMap<ezVisualScriptInstance::AssignFuncKey, ezVisualScriptDataPinAssignFunc> ezVisualScriptInstance::s_DataPinAssignFunctions;
 
+namespace
+{
+  /// \brief Places each node at the position inside the memory block of the instance that the execution plan reserved for it.
+  class ezVisualScriptNodeAllocator : public ezAllocatorBase
+  {
+  public:
+    virtual void* Allocate(size_t uiSize, size_t uiAlign, ezMemoryUtils::DestructorFunction destructorFunc) override
+    {
+      EZ_ASSERT_DEV(m_pNextNode != nullptr && uiSize <= m_uiNextNodeSize, "Node does not fit into the memory that was reserved for it.");
+      EZ_ASSERT_DEV(uiAlign <= ezVisualScriptExecutionPlan::NodeAlignment, "Unsupported node alignment {0}", uiAlign);
+
+      void* pNode = m_pNextNode;
+      m_pNextNode = nullptr;
+      return pNode;
+    }
+
+    // the memory is owned by the instance
+    virtual void Deallocate(void* ptr) override {}
+    virtual size_t AllocatedSize(const void* ptr) override { return 0; }
+    virtual ezAllocatorId GetId() const override { return ezAllocatorId(); }
+    virtual Stats GetStats() const override { return Stats(); }
+
+    void* m_pNextNode = nullptr;
+    ezUInt32 m_uiNextNodeSize = 0;
+  };
+} // namespace
+
 bool ezVisualScriptAssignNumberNumber(const void* src, void* dst)
 {
   const bool res = *reinterpret_cast<double*>(dst) != *reinterpret_cast<const double*>(src);
@@ -93,49 +120,38 @@ ezVisualScriptInstance::~ezVisualScriptInstance()
 
 void ezVisualScriptInstance::Clear()
 {
+  ezVisualScriptNodeAllocator nodeAllocator;
+
   for (ezUInt32 i = 0; i < m_Nodes.GetCount(); ++i)
   {
-    m_Nodes[i]->GetDynamicRTTI()->GetAllocator()->Deallocate(m_Nodes[i]);
+    if (m_Nodes[i] != nullptr)
+    {
+      m_Nodes[i]->GetDynamicRTTI()->GetAllocator()->Deallocate(m_Nodes[i], &nodeAllocator);
+    }
+  }
+
+  if (m_pMemoryBlock != nullptr)
+  {
+    ezFoundation::GetAlignedAllocator()->Deallocate(m_pMemoryBlock);
+    m_pMemoryBlock = nullptr;
   }
 
   m_pWorld = nullptr;
+  m_pPlan = nullptr;
+  m_pMessageHandlers = nullptr;
   m_Nodes.Clear();
-  m_ExecutionConnections.Clear();
-  m_DataConnections.Clear();
+  m_DataPinTargets.Clear();
   m_LocalVariables.Clear();
   m_hScriptResource.Invalidate();
 }
 
 
-void ezVisualScriptInstance::ComputeNodeDependencies()
-{
-  m_NodeDependencies.SetCount(m_Nodes.GetCount());
-
-  for (auto it = m_DataConnections.GetIterator(); it.IsValid(); ++it)
-  {
-    const ezVisualScriptPinConnectionID src = it.Key();
-
-    const ezUInt16 uiSourceNode = (src >> 16) & 0xFFFF;
-
-    if (m_Nodes[uiSourceNode]->IsManuallyStepped())
-      continue;
-
-    const ezHybridArray<DataPinConnection, 2>& dst = it.Value();
-
-    for (const DataPinConnection& target : dst)
-    {
-      m_NodeDependencies[target.m_uiTargetNode].PushBack(uiSourceNode);
-    }
-  }
-}
-
-
 void ezVisualScriptInstance::ExecuteDependentNodes(ezUInt16 uiNode)
 {
-  const auto& dep = m_NodeDependencies[uiNode];
-  for (ezUInt32 i = 0; i < dep.GetCount(); ++i)
+  const auto& node = m_pPlan->m_Nodes[uiNode];
+  for (ezUInt32 i = 0; i < node.m_uiNumDependencies; ++i)
   {
-    const ezUInt16 uiDependency = dep[i];
+    const ezUInt16 uiDependency = m_pPlan->m_Dependencies[node.m_uiFirstDependency + i];
     auto* pNode = m_Nodes[uiDependency];
 
     // recurse to the most dependent nodes first
@@ -154,7 +170,7 @@ void ezVisualScriptInstance::Configure(const ezVisualScriptResourceHandle& hScri
 
   ezResourceLock<ezVisualScriptResource> pScript(hScript, ezResourceAcquireMode::BlockTillLoaded);
   const auto& resource = pScript->GetDescriptor();
-  m_pMessageHandlers = &resource.m_MessageHandlers;
+  const auto& plan = pScript->GetExecutionPlan();
 
   m_hScriptResource = hScript;
 
@@ -164,54 +180,72 @@ void ezVisualScriptInstance::Configure(const ezVisualScriptResourceHandle& hScri
     m_pWorld = pOwner->GetWorld();
   }
 
-  m_Nodes.Reserve(resource.m_Nodes.GetCount());
+  // the plan is empty, if the script contains invalid nodes (the error is logged when the resource is loaded)
+  if (plan.m_Nodes.GetCount() != resource.m_Nodes.GetCount())
+    return;
+
+  m_pPlan = &plan;
+  m_pMessageHandlers = &resource.m_MessageHandlers;
+
+  // one allocation for all nodes, the node pointers and the data pin targets
+  {
+    const ezUInt32 uiNodeMemorySize = ezMemoryUtils::AlignSize<ezUInt32>(plan.m_uiNodeMemorySize, EZ_ALIGNMENT_OF(void*));
+    const ezUInt32 uiNumNodes = plan.m_Nodes.GetCount();
+    const ezUInt32 uiNumDataConnections = plan.m_DataConnections.GetCount();
+    const size_t uiBlockSize = uiNodeMemorySize + sizeof(ezVisualScriptNode*) * uiNumNodes + sizeof(void*) * uiNumDataConnections;
+
+    if (uiBlockSize > 0)
+    {
+      m_pMemoryBlock = ezFoundation::GetAlignedAllocator()->Allocate(uiBlockSize, ezVisualScriptExecutionPlan::NodeAlignment);
+
+      ezUInt8* pNodePointers = static_cast<ezUInt8*>(m_pMemoryBlock) + uiNodeMemorySize;
+      m_Nodes = ezArrayPtr<ezVisualScriptNode*>(reinterpret_cast<ezVisualScriptNode**>(pNodePointers), uiNumNodes);
+      m_DataPinTargets = ezArrayPtr<void*>(reinterpret_cast<void**>(pNodePointers + sizeof(ezVisualScriptNode*) * uiNumNodes), uiNumDataConnections);
+
+      for (ezUInt32 n = 0; n < uiNumNodes; ++n)
+      {
+        m_Nodes[n] = nullptr;
+      }
+    }
+  }
+
+  ezVisualScriptNodeAllocator nodeAllocator;
 
   for (ezUInt32 n = 0; n < resource.m_Nodes.GetCount(); ++n)
   {
     const auto& node = resource.m_Nodes[n];
 
+    nodeAllocator.m_pNextNode = static_cast<ezUInt8*>(m_pMemoryBlock) + plan.m_Nodes[n].m_uiMemoryOffset;
+    nodeAllocator.m_uiNextNodeSize = plan.m_Nodes[n].m_pType->GetTypeSize();
+
     if (node.m_isFunctionCall)
     {
-      CreateFunctionCallNode(n, resource);
+      CreateFunctionCallNode(n, resource, &nodeAllocator);
     }
     else if (node.m_pType->IsDerivedFrom<ezMessage>())
     {
+      // the plan only accepts message nodes that are either senders or handlers
       if (node.m_isMsgSender)
       {
-        CreateFunctionMessageNode(n, resource);
+        CreateFunctionMessageNode(n, resource, &nodeAllocator);
       }
-      else if (node.m_isMsgHandler)
+      else
       {
-        CreateEventMessageNode(n, resource);
+        CreateEventMessageNode(n, resource, &nodeAllocator);
       }
     }
-    else if (node.m_pType->IsDerivedFrom<ezVisualScriptNode>())
-    {
-      CreateVisualScriptNode(n, resource);
-    }
     else
     {
-      ezLog::Error("Invalid node type '{0}' in visual script", node.m_sTypeName);
-      Clear();
-      return;
+      CreateVisualScriptNode(n, resource, &nodeAllocator);
     }
   }
 
-  m_ExecutionConnections.Reserve(resource.m_ExecutionPaths.GetCount());
-
-  for (const auto& con : resource.m_ExecutionPaths)
+  for (ezUInt32 i = 0; i < plan.m_DataConnections.GetCount(); ++i)
   {
-    ConnectExecutionPins(con.m_uiSourceNode, con.m_uiOutputPin, con.m_uiTargetNode, con.m_uiInputPin);
+    const auto& con = plan.m_DataConnections[i];
+    m_DataPinTargets[i] = m_Nodes[con.m_uiTargetNode]->GetInputPinDataPointer(con.m_uiTargetPin);
   }
 
-  for (const auto& con : resource.m_DataPaths)
-  {
-    ConnectDataPins(con.m_uiSourceNode, con.m_uiOutputPin, (ezVisualScriptDataPinType::Enum)con.m_uiOutputPinType, con.m_uiTargetNode,
-      con.m_uiInputPin, (ezVisualScriptDataPinType::Enum)con.m_uiInputPinType);
-  }
-
-  ComputeNodeDependencies();
-
   // initialize local variables
   {
     for (const auto& p : resource.m_BoolParameters)
@@ -227,40 +261,38 @@ void ezVisualScriptInstance::Configure(const ezVisualScriptResourceHandle& hScri
 }
 
 
-void ezVisualScriptInstance::CreateVisualScriptNode(ezUInt32 uiNodeIdx, const ezVisualScriptResourceDescriptor& resource)
+void ezVisualScriptInstance::CreateVisualScriptNode(ezUInt32 uiNodeIdx, const ezVisualScriptResourceDescriptor& resource, ezAllocatorBase* pAllocator)
 {
   EZ_ASSERT_DEBUG(uiNodeIdx < ezMath::MaxValue<ezUInt16>(), "Max supported node index is 16 bit.");
 
   const auto& node = resource.m_Nodes[uiNodeIdx];
 
-  ezVisualScriptNode* pNode = node.m_pType->GetAllocator()->Allocate<ezVisualScriptNode>();
+  ezVisualScriptNode* pNode = node.m_pType->GetAllocator()->Allocate<ezVisualScriptNode>(pAllocator);
   pNode->m_uiNodeID = static_cast<ezUInt16>(uiNodeIdx);
 
   // assign all property values
   for (ezUInt32 i = 0; i < node.m_uiNumProperties; ++i)
   {
     const ezUInt32 uiProp = node.m_uiFirstProperty + i;
-    const auto& prop = resource.m_Properties[uiProp];
 
-    ezAbstractProperty* pAbstract = pNode->GetDynamicRTTI()->FindPropertyByName(prop.m_sName);
-    if (pAbstract->GetCategory() != ezPropertyCategory::Member)
+    ezAbstractMemberProperty* pMember = m_pPlan->m_MemberProperties[uiProp];
+    if (pMember == nullptr)
       continue;
 
-    ezAbstractMemberProperty* pMember = static_cast<ezAbstractMemberProperty*>(pAbstract);
-    ezReflectionUtils::SetMemberPropertyValue(pMember, pNode, prop.m_Value);
+    ezReflectionUtils::SetMemberPropertyValue(pMember, pNode, resource.m_Properties[uiProp].m_Value);
   }
 
-  m_Nodes.PushBack(pNode);
+  m_Nodes[uiNodeIdx] = pNode;
 }
 
-void ezVisualScriptInstance::CreateFunctionMessageNode(ezUInt32 uiNodeIdx, const ezVisualScriptResourceDescriptor& resource)
+void ezVisualScriptInstance::CreateFunctionMessageNode(ezUInt32 uiNodeIdx, const ezVisualScriptResourceDescriptor& resource, ezAllocatorBase* pAllocator)
 {
   EZ_ASSERT_DEBUG(uiNodeIdx < ezMath::MaxValue<ezUInt16>(), "Max supported node index is 16 bit.");
 
   const auto& node = resource.m_Nodes[uiNodeIdx];
 
   ezVisualScriptNode_MessageSender* pNode =
-    ezGetStaticRTTI<ezVisualScriptNode_MessageSender>()->GetAllocator()->Allocate<ezVisualScriptNode_MessageSender>();
+    ezGetStaticRTTI<ezVisualScriptNode_MessageSender>()->GetAllocator()->Allocate<ezVisualScriptNode_MessageSender>(pAllocator);
   pNode->m_uiNodeID = static_cast<ezUInt16>(uiNodeIdx);
 
   pNode->m_pMessageToSend = node.m_pType->GetAllocator()->Allocate<ezMessage>();
@@ -272,8 +304,8 @@ void ezVisualScriptInstance::CreateFunctionMessageNode(ezUInt32 uiNodeIdx, const
       const ezUInt32 uiProp = node.m_uiFirstProperty + i;
       const auto& prop = resource.m_Properties[uiProp];
 
-      ezAbstractProperty* pAbstract = pNode->m_pMessageToSend->GetDynamicRTTI()->FindPropertyByName(prop.m_sName);
-      if (pAbstract == nullptr)
+      ezAbstractMemberProperty* pMember = m_pPlan->m_MemberProperties[uiProp];
+      if (pMember == nullptr)
       {
         if (prop.m_sName == "Delay" && prop.m_Value.CanConvertTo<ezTime>())
         {
@@ -287,31 +319,27 @@ void ezVisualScriptInstance::CreateFunctionMessageNode(ezUInt32 uiNodeIdx, const
         continue;
       }
 
-      if (pAbstract->GetCategory() != ezPropertyCategory::Member)
-        continue;
-
-      ezAbstractMemberProperty* pMember = static_cast<ezAbstractMemberProperty*>(pAbstract);
       ezReflectionUtils::SetMemberPropertyValue(pMember, pNode->m_pMessageToSend, prop.m_Value);
     }
   }
 
-  m_Nodes.PushBack(pNode);
+  m_Nodes[uiNodeIdx] = pNode;
 }
 
 
-void ezVisualScriptInstance::CreateEventMessageNode(ezUInt32 uiNodeIdx, const ezVisualScriptResourceDescriptor& resource)
+void ezVisualScriptInstance::CreateEventMessageNode(ezUInt32 uiNodeIdx, const ezVisualScriptResourceDescriptor& resource, ezAllocatorBase* pAllocator)
 {
   EZ_ASSERT_DEBUG(uiNodeIdx < ezMath::MaxValue<ezUInt16>(), "Max supported node index is 16 bit.");
 
   const auto& node = resource.m_Nodes[uiNodeIdx];
 
   ezVisualScriptNode_GenericEvent* pNode =
-    ezGetStaticRTTI<ezVisualScriptNode_GenericEvent>()->GetAllocator()->Allocate<ezVisualScriptNode_GenericEvent>();
+    ezGetStaticRTTI<ezVisualScriptNode_GenericEvent>()->GetAllocator()->Allocate<ezVisualScriptNode_GenericEvent>(pAllocator);
   pNode->m_uiNodeID = static_cast<ezUInt16>(uiNodeIdx);
 
   pNode->m_sEventType = node.m_sTypeName;
 
-  m_Nodes.PushBack(pNode);
+  m_Nodes[uiNodeIdx] = pNode;
 }
 
 ezAbstractFunctionProperty* ezVisualScriptInstance::SearchForScriptableFunctionOnType(
@@ -341,14 +369,14 @@ ezAbstractFunctionProperty* ezVisualScriptInstance::SearchForScriptableFunctionO
   return nullptr;
 }
 
-void ezVisualScriptInstance::CreateFunctionCallNode(ezUInt32 uiNodeIdx, const ezVisualScriptResourceDescriptor& resource)
+void ezVisualScriptInstance::CreateFunctionCallNode(ezUInt32 uiNodeIdx, const ezVisualScriptResourceDescriptor& resource, ezAllocatorBase* pAllocator)
 {
   EZ_ASSERT_DEBUG(uiNodeIdx < ezMath::MaxValue<ezUInt16>(), "Max supported node index is 16 bit.");
 
   const auto& node = resource.m_Nodes[uiNodeIdx];
 
   ezVisualScriptNode_FunctionCall* pNode =
-    ezGetStaticRTTI<ezVisualScriptNode_FunctionCall>()->GetAllocator()->Allocate<ezVisualScriptNode_FunctionCall>();
+    ezGetStaticRTTI<ezVisualScriptNode_FunctionCall>()->GetAllocator()->Allocate<ezVisualScriptNode_FunctionCall>(pAllocator);
   pNode->m_uiNodeID = static_cast<ezUInt16>(uiNodeIdx);
 
   pNode->m_pExpectedType = node.m_pType;
@@ -408,7 +436,7 @@ void ezVisualScriptInstance::CreateFunctionCallNode(ezUInt32 uiNodeIdx, const ez
     ezLog::Error("Expected target object type is null for vis script function call node '{}'", node.m_sTypeName);
   }
 
-  m_Nodes.PushBack(pNode);
+  m_Nodes[uiNodeIdx] = pNode;
 }
 
 void ezVisualScriptInstance::ExecuteScript(ezVisualScriptInstanceActivity* pActivity /*= nullptr*/)
@@ -462,36 +490,24 @@ bool ezVisualScriptInstance::HandleMessage(ezMessage& msg)
   return bHandled;
 }
 
-void ezVisualScriptInstance::ConnectExecutionPins(ezUInt16 uiSourceNode, ezUInt8 uiOutputSlot, ezUInt16 uiTargetNode, ezUInt8 uiTargetPin)
-{
-  auto& con = m_ExecutionConnections[((ezUInt32)uiSourceNode << 16) | (ezUInt32)uiOutputSlot];
-  con.m_uiTargetNode = uiTargetNode;
-  con.m_uiTargetPin = uiTargetPin;
-}
-
-void ezVisualScriptInstance::ConnectDataPins(ezUInt16 uiSourceNode, ezUInt8 uiSourcePin, ezVisualScriptDataPinType::Enum sourcePinType,
-  ezUInt16 uiTargetNode, ezUInt8 uiTargetPin, ezVisualScriptDataPinType::Enum targetPinType)
-{
-  DataPinConnection& con = m_DataConnections[((ezUInt32)uiSourceNode << 16) | (ezUInt32)uiSourcePin].ExpandAndGetRef();
-  con.m_uiTargetNode = uiTargetNode;
-  con.m_uiTargetPin = uiTargetPin;
-  con.m_pTargetData = m_Nodes[uiTargetNode]->GetInputPinDataPointer(uiTargetPin);
-  con.m_AssignFunc = FindDataPinAssignFunction(sourcePinType, targetPinType);
-}
-
 void ezVisualScriptInstance::SetOutputPinValue(const ezVisualScriptNode* pNode, ezUInt8 uiPin, const void* pValue)
 {
-  const ezUInt32 uiConnectionID = ((ezUInt32)pNode->m_uiNodeID << 16) | (ezUInt32)uiPin;
+  const auto& node = m_pPlan->m_Nodes[pNode->m_uiNodeID];
+  if (uiPin >= node.m_uiNumDataOutputs)
+    return;
 
-  ezHybridArray<DataPinConnection, 2>* TargetNodeAndPins;
-  if (!m_DataConnections.TryGetValue(uiConnectionID, TargetNodeAndPins))
+  const auto& output = m_pPlan->m_DataOutputs[node.m_uiFirstDataOutput + uiPin];
+  if (output.m_uiNumConnections == 0)
     return;
 
-  for (const DataPinConnection& TargetNodeAndPin : *TargetNodeAndPins)
+  const ezUInt32 uiEndConnection = output.m_uiFirstConnection + output.m_uiNumConnections;
+  for (ezUInt32 i = output.m_uiFirstConnection; i < uiEndConnection; ++i)
   {
+    const auto& TargetNodeAndPin = m_pPlan->m_DataConnections[i];
+
     if (TargetNodeAndPin.m_AssignFunc)
     {
-      if (TargetNodeAndPin.m_AssignFunc(pValue, TargetNodeAndPin.m_pTargetData))
+      if (TargetNodeAndPin.m_AssignFunc(pValue, m_DataPinTargets[i]))
       {
         m_Nodes[TargetNodeAndPin.m_uiTargetNode]->m_bInputValuesChanged = true;
       }
@@ -500,7 +516,7 @@ void ezVisualScriptInstance::SetOutputPinValue(const ezVisualScriptNode* pNode,
 
   if (m_pActivity != nullptr)
   {
-    m_pActivity->m_ActiveDataConnections.PushBack(uiConnectionID);
+    m_pActivity->m_ActiveDataConnections.PushBack(((ezUInt32)pNode->m_uiNodeID << 16) | (ezUInt32)uiPin);
   }
 }
 
@@ -511,10 +527,12 @@ Otherwise visual script graph execution can end up in an endless recursion with
 Override ezVisualScriptNode::IsManuallyStepped() for type '{}' if necessary.",
     pNode->GetDynamicRTTI()->GetTypeName());
 
-  const ezUInt32 uiConnectionID = ((ezUInt32)pNode->m_uiNodeID << 16) | (ezUInt32)uiNthTarget;
+  const auto& node = m_pPlan->m_Nodes[pNode->m_uiNodeID];
+  if (uiNthTarget >= node.m_uiNumExecOutputs)
+    return;
 
-  ExecPinConnection TargetNode;
-  if (!m_ExecutionConnections.TryGetValue(uiConnectionID, TargetNode))
+  const auto& TargetNode = m_pPlan->m_ExecOutputs[node.m_uiFirstExecOutput + uiNthTarget];
+  if (TargetNode.m_uiTargetNode == ezVisualScriptExecutionPlan::InvalidNode)
     return;
 
   auto* pTargetNode = m_Nodes[TargetNode.m_uiTargetNode];
@@ -526,7 +544,7 @@ Override ezVisualScriptNode::IsManuallyStepped() for type '{}' if necessary.",
 
   if (m_pActivity != nullptr)
   {
-    m_pActivity->m_ActiveExecutionConnections.PushBack(uiConnectionID);
+    m_pActivity->m_ActiveExecutionConnections.PushBack(((ezUInt32)pNode->m_uiNodeID << 16) | (ezUInt32)uiNthTarget);
   }
 }
 
@@ -3,17 +3,16 @@
 #include <Core/ResourceManager/ResourceHandle.h>
 #include <Foundation/Containers/ArrayMap.h>
 #include <Foundation/Containers/DynamicArray.h>
-#include <Foundation/Containers/HashTable.h>
 #include <Foundation/Containers/HybridArray.h>
 #include <Foundation/Containers/Map.h>
 #include <Foundation/Types/Variant.h>
 #include <GameEngine/GameEngineDLL.h>
 #include <GameEngine/GameState/StateMap.h>
 #include <GameEngine/VisualScript/VisualScriptNode.h>
+#include <GameEngine/VisualScript/VisualScriptResource.h>
 
 class ezVisualScriptNode;
 class ezMessage;
-struct ezVisualScriptResourceDescriptor;
 class ezGameObject;
 class ezWorld;
 struct ezVisualScriptInstanceActivity;
@@ -21,11 +20,10 @@ struct ezEventMessage;
 
 typedef ezUInt32 ezVisualScriptNodeConnectionID;
 typedef ezUInt32 ezVisualScriptPinConnectionID;
-typedef ezTypedResourceHandle<class ezVisualScriptResource> ezVisualScriptResourceHandle;
-
-typedef bool (*ezVisualScriptDataPinAssignFunc)(const void* src, void* dst);
-
 /// \brief An instance of a visual script resource. Stores the current script state and executes nodes.
+///
+/// The connections between the nodes are stored in the ezVisualScriptExecutionPlan of the resource, which is shared by all instances.
+/// The instance itself only allocates one memory block for all its nodes and the target pointers of the data connections.
 class EZ_GAMEENGINE_DLL ezVisualScriptInstance
 {
 public:
@@ -75,45 +73,27 @@ private:
   friend class ezVisualScriptNode;
 
   void Clear();
-  void ComputeNodeDependencies();
   void ExecuteDependentNodes(ezUInt16 uiNode);
 
-  void ConnectExecutionPins(ezUInt16 uiSourceNode, ezUInt8 uiOutputSlot, ezUInt16 uiTargetNode, ezUInt8 uiTargetPin);
-  void ConnectDataPins(ezUInt16 uiSourceNode, ezUInt8 uiSourcePin, ezVisualScriptDataPinType::Enum sourcePinType, ezUInt16 uiTargetNode,
-    ezUInt8 uiTargetPin, ezVisualScriptDataPinType::Enum targetPinType);
-
-  void CreateVisualScriptNode(ezUInt32 uiNodeIdx, const ezVisualScriptResourceDescriptor& resource);
-  void CreateFunctionMessageNode(ezUInt32 uiNodeIdx, const ezVisualScriptResourceDescriptor& resource);
-  void CreateEventMessageNode(ezUInt32 uiNodeIdx, const ezVisualScriptResourceDescriptor& resource);
-  void CreateFunctionCallNode(ezUInt32 uiNodeIdx, const ezVisualScriptResourceDescriptor& resource);
+  void CreateVisualScriptNode(ezUInt32 uiNodeIdx, const ezVisualScriptResourceDescriptor& resource, ezAllocatorBase* pAllocator);
+  void CreateFunctionMessageNode(ezUInt32 uiNodeIdx, const ezVisualScriptResourceDescriptor& resource, ezAllocatorBase* pAllocator);
+  void CreateEventMessageNode(ezUInt32 uiNodeIdx, const ezVisualScriptResourceDescriptor& resource, ezAllocatorBase* pAllocator);
+  void CreateFunctionCallNode(ezUInt32 uiNodeIdx, const ezVisualScriptResourceDescriptor& resource, ezAllocatorBase* pAllocator);
   ezAbstractFunctionProperty* SearchForScriptableFunctionOnType(
     const ezRTTI* pObjectType, ezStringView sFuncName, const ezScriptableFunctionAttribute*& out_pSfAttr) const;
 
-  struct DataPinConnection
-  {
-    EZ_DECLARE_POD_TYPE();
-
-    ezUInt16 m_uiTargetNode;
-    ezUInt8 m_uiTargetPin;
-    ezVisualScriptDataPinAssignFunc m_AssignFunc = nullptr;
-    void* m_pTargetData = nullptr;
-  };
-
-  struct ExecPinConnection
-  {
-    EZ_DECLARE_POD_TYPE();
-
-    ezUInt16 m_uiTargetNode;
-    ezUInt8 m_uiTargetPin;
-  };
-
   ezVisualScriptResourceHandle m_hScriptResource;
   ezGameObjectHandle m_hOwner;
   ezWorld* m_pWorld = nullptr;
-  ezDynamicArray<ezVisualScriptNode*> m_Nodes;
-  ezDynamicArray<ezHybridArray<ezUInt16, 2>> m_NodeDependencies;
-  ezHashTable<ezVisualScriptNodeConnectionID, ExecPinConnection> m_ExecutionConnections;
-  ezHashTable<ezVisualScriptPinConnectionID, ezHybridArray<DataPinConnection, 2>> m_DataConnections;
+  const ezVisualScriptExecutionPlan* m_pPlan = nullptr;
+
+  /// \brief Holds all nodes, followed by m_Nodes and m_DataPinTargets.
+  void* m_pMemoryBlock = nullptr;
+  ezArrayPtr<ezVisualScriptNode*> m_Nodes;
+
+  /// \brief The input pin data pointer for every entry in ezVisualScriptExecutionPlan::m_DataConnections.
+  ezArrayPtr<void*> m_DataPinTargets;
+
   ezStateMap m_LocalVariables;
   ezVisualScriptInstanceActivity* m_pActivity = nullptr;
   const ezArrayMap<ezMessageId, ezUInt16>* m_pMessageHandlers = nullptr;
@@ -7,6 +7,8 @@
 
 typedef ezTypedResourceHandle<class ezVisualScriptResource> ezVisualScriptResourceHandle;
 
+typedef bool (*ezVisualScriptDataPinAssignFunc)(const void* src, void* dst);
+
 /// \brief Describes a visual script graph (node types and connections)
 struct EZ_GAMEENGINE_DLL ezVisualScriptResourceDescriptor
 {
@@ -83,6 +85,78 @@ struct EZ_GAMEENGINE_DLL ezVisualScriptResourceDescriptor
   ezDynamicArray<LocalParameterNumber> m_NumberParameters;
 };
 
+/// \brief The immutable, pre-processed form of a visual script, which is shared by all ezVisualScriptInstance's of the same resource.
+///
+/// All connections are resolved into flat tables that are indexed by node and pin index, such that executing a script never needs
+/// to look anything up. The instances only store their nodes and the target pointers of the data connections in one memory block.
+struct EZ_GAMEENGINE_DLL ezVisualScriptExecutionPlan
+{
+  /// \brief Builds the plan for the given script. Fails if the script contains invalid node types, in which case the plan stays empty.
+  ezResult Compile(const ezVisualScriptResourceDescriptor& desc);
+  void Clear();
+
+  ezUInt64 GetHeapMemoryUsage() const;
+
+  /// \brief Marks an execution pin that is not connected to anything.
+  static const ezUInt16 InvalidNode = 0xFFFF;
+
+  /// \brief The alignment of every node inside the memory block of an instance.
+  static const ezUInt32 NodeAlignment = 16;
+
+  struct Node
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    const ezRTTI* m_pType;      ///< The ezVisualScriptNode type that gets instantiated for this node
+    ezUInt32 m_uiMemoryOffset;  ///< Where the node is placed inside the memory block of an instance
+    ezUInt32 m_uiFirstExecOutput;
+    ezUInt32 m_uiFirstDataOutput;
+    ezUInt32 m_uiFirstDependency;
+    ezUInt16 m_uiNumDependencies;
+    ezUInt8 m_uiNumExecOutputs; ///< Highest connected execution output pin + 1
+    ezUInt8 m_uiNumDataOutputs; ///< Highest connected data output pin + 1
+  };
+
+  struct ExecOutput
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt16 m_uiTargetNode;
+    ezUInt8 m_uiTargetPin;
+  };
+
+  struct DataOutput
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt32 m_uiFirstConnection;
+    ezUInt32 m_uiNumConnections;
+  };
+
+  struct DataConnection
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt16 m_uiTargetNode;
+    ezUInt8 m_uiTargetPin;
+    ezVisualScriptDataPinAssignFunc m_AssignFunc;
+  };
+
+  ezDynamicArray<Node> m_Nodes;
+  ezDynamicArray<ExecOutput> m_ExecOutputs;
+  ezDynamicArray<DataOutput> m_DataOutputs;
+  ezDynamicArray<DataConnection> m_DataConnections;
+
+  /// \brief For every node the nodes that are not manually stepped and feed its input data pins. These are executed before the node itself.
+  ezDynamicArray<ezUInt16> m_Dependencies;
+
+  /// \brief The resolved member property for every entry in ezVisualScriptResourceDescriptor::m_Properties, or nullptr.
+  ezDynamicArray<ezAbstractMemberProperty*> m_MemberProperties;
+
+  /// \brief How many bytes all nodes of one instance need.
+  ezUInt32 m_uiNodeMemorySize = 0;
+};
+
 class EZ_GAMEENGINE_DLL ezVisualScriptResource : public ezResource
 {
   EZ_ADD_DYNAMIC_REFLECTION(ezVisualScriptResource, ezResource);
@@ -94,6 +168,7 @@ public:
   ~ezVisualScriptResource();
 
   const ezVisualScriptResourceDescriptor& GetDescriptor() const { return m_Descriptor; }
+  const ezVisualScriptExecutionPlan& GetExecutionPlan() const { return m_ExecutionPlan; }
 
 private:
   virtual ezResourceLoadDesc UnloadData(Unload WhatToUnload) override;
@@ -102,4 +177,5 @@ private:
 
 private:
   ezVisualScriptResourceDescriptor m_Descriptor;
+  ezVisualScriptExecutionPlan m_ExecutionPlan;
 };
@@ -36,6 +36,9 @@ public:
 
   void SortAndBatch();
 
+  /// \brief Removes all render data but keeps the array capacities for the next frame.
+  ///
+  /// The capacities are only shrunk when they were far above the highest count of the last CompactInterval frames.
   void Clear();
 
   ezRenderDataBatchList GetRenderDataBatchesWithCategory(
@@ -50,10 +53,18 @@ public:
 private:
   const ezRenderData* GetFrameData(const ezRTTI* pRtti) const;
 
+  enum
+  {
+    CompactInterval = 120
+  };
+
   struct DataPerCategory
   {
     ezDynamicArray<ezRenderDataBatch> m_Batches;
     ezDynamicArray<ezRenderDataBatch::SortableRenderData> m_SortableRenderData;
+
+    ezUInt32 m_uiMaxBatches = 0;
+    ezUInt32 m_uiMaxSortableRenderData = 0;
   };
 
   ezCamera m_Camera;
@@ -65,4 +76,6 @@ private:
 
   ezHybridArray<DataPerCategory, 16> m_DataPerCategory;
   ezHybridArray<const ezRenderData*, 16> m_FrameData;
+
+  ezUInt32 m_uiFramesSinceCompact = 0;
 };
@@ -66,20 +66,55 @@ void ezExtractedRenderData::SortAndBatch()
     }
 
     dataPerCategory.m_Batches.ExpandAndGetRef().m_Data = ezMakeArrayPtr(&data[uiCurrentBatchStartIndex], data.GetCount() - uiCurrentBatchStartIndex);
+
+    dataPerCategory.m_uiMaxBatches = ezMath::Max(dataPerCategory.m_uiMaxBatches, dataPerCategory.m_Batches.GetCount());
+    dataPerCategory.m_uiMaxSortableRenderData = ezMath::Max(dataPerCategory.m_uiMaxSortableRenderData, data.GetCount());
   }
+
+  ++m_uiFramesSinceCompact;
 }
 
+namespace
+{
+  template <typename T>
+  void ShrinkToHighWaterMark(ezDynamicArray<T>& ref_array, ezUInt32 uiHighWaterMark)
+  {
+    // some slack so that the arrays don't grow again right away
+    const ezUInt32 uiTargetCapacity = uiHighWaterMark + uiHighWaterMark / 4;
+
+    if (ref_array.GetCapacity() > ezMath::Max(2 * uiTargetCapacity, 64u))
+    {
+      ref_array.Compact();
+      ref_array.Reserve(uiTargetCapacity);
+    }
+  }
+} // namespace
+
 void ezExtractedRenderData::Clear()
 {
+  const bool bCompact = m_uiFramesSinceCompact >= CompactInterval;
+
   for (auto& dataPerCategory : m_DataPerCategory)
   {
     dataPerCategory.m_Batches.Clear();
     dataPerCategory.m_SortableRenderData.Clear();
+
+    if (bCompact)
+    {
+      ShrinkToHighWaterMark(dataPerCategory.m_Batches, dataPerCategory.m_uiMaxBatches);
+      ShrinkToHighWaterMark(dataPerCategory.m_SortableRenderData, dataPerCategory.m_uiMaxSortableRenderData);
+
+      dataPerCategory.m_uiMaxBatches = 0;
+      dataPerCategory.m_uiMaxSortableRenderData = 0;
+    }
   }
 
   m_FrameData.Clear();
 
-  // TODO: intelligent compact
+  if (bCompact)
+  {
+    m_uiFramesSinceCompact = 0;
+  }
 }
 
 ezRenderDataBatchList ezExtractedRenderData::GetRenderDataBatchesWithCategory(ezRenderData::Category category, ezRenderDataBatch::Filter filter) const
@@ -58,8 +58,9 @@ template <typename T>
 static T* ezCreateRenderDataForThisFrame(const ezGameObject* pOwner)
 {
   EZ_CHECK_AT_COMPILETIME(EZ_IS_DERIVED_FROM_STATIC(ezRenderData, T));
+  EZ_ASSERT_DEV(ezRenderWorld::IsExtractingThread(), "Render data must be created on the thread that extracts the view");
 
-  T* pRenderData = EZ_NEW(ezFrameAllocator::GetCurrentAllocator(), T);
+  T* pRenderData = EZ_NEW(ezRenderWorld::GetRenderDataAllocator(), T);
 
   if (pOwner != nullptr)
   {
@@ -13,6 +13,10 @@
 #include <RendererCore/RenderWorld/RenderWorld.h>
 #include <RendererFoundation/Profiling/Profiling.h>
 
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+#  include <Foundation/Utilities/Stats.h>
+#endif
+
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
 ezCVarBool ezRenderPipeline::s_DebugCulling("r_DebugCulling", false, ezCVarFlags::Default, "Enables debug visualization of visibility culling");
 
@@ -873,6 +877,13 @@ void ezRenderPipeline::ExtractData(const ezView& view)
   data.SetWorldDebugContext(view.GetWorld());
   data.SetViewDebugContext(view.GetHandle());
 
+  // The peak memory stat only looks at the arena of this thread, it requires that the render data of a view is created on the thread
+  // that extracts it. Extractors must not hand work off to other threads, ezCreateRenderDataForThisFrame asserts that.
+  ezThreadArenaAllocator<>* pRenderDataAllocator = ezRenderWorld::GetRenderDataAllocator();
+  const ezUInt64 uiRenderDataMemoryBefore = pRenderDataAllocator->GetUsedMemoryOfCurrentThread();
+
+  ezRenderWorld::BeginExtractionOnThisThread();
+
   // Extract object render data
   for (auto& pExtractor : m_Extractors)
   {
@@ -896,6 +907,24 @@ void ezRenderPipeline::ExtractData(const ezView& view)
     }
   }
 
+  ezRenderWorld::EndExtractionOnThisThread();
+
+  const ezUInt64 uiRenderDataMemory = pRenderDataAllocator->GetUsedMemoryOfCurrentThread() - uiRenderDataMemoryBefore;
+  if (uiRenderDataMemory > m_uiPeakRenderDataMemory)
+  {
+    m_uiPeakRenderDataMemory = uiRenderDataMemory;
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+    ezStringBuilder sStatName;
+    sStatName.Format("Render Data/{0}/Peak Memory", view.GetName());
+
+    ezStringBuilder sStatValue;
+    sStatValue.Format("{0} KB", ezArgF(m_uiPeakRenderDataMemory / 1024.0, 1));
+
+    ezStats::SetStat(sStatName, sStatValue.GetData());
+#endif
+  }
+
   m_CurrentExtractThread = (ezThreadID)0;
 }
 
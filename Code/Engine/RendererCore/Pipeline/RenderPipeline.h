@@ -51,6 +51,10 @@ public:
   }
 
   const ezExtractedRenderData& GetRenderData() const;
+
+  /// \brief Returns the largest amount of render data memory in bytes that a single extraction of this pipeline has allocated so far.
+  ezUInt64 GetPeakRenderDataMemory() const { return m_uiPeakRenderDataMemory; }
+
   ezRenderDataBatchList GetRenderDataBatchesWithCategory(
     ezRenderData::Category category, ezRenderDataBatch::Filter filter = ezRenderDataBatch::Filter()) const;
 
@@ -94,6 +98,7 @@ private: // Member data
   // Pipeline render data
   ezExtractedRenderData m_Data[2];
   ezDynamicArray<const ezGameObject*> m_visibleObjects;
+  ezUInt64 m_uiPeakRenderDataMemory = 0;
 
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
   ezTime m_AverageCullingTime;
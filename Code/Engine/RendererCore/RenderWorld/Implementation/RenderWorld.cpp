@@ -28,6 +28,7 @@ namespace
 {
   static bool s_bInExtract;
   static ezThreadID s_RenderingThreadID;
+  static thread_local ezUInt32 s_uiExtractionsOnThisThread = 0;
 
   static ezMutex s_ExtractTasksMutex;
   static ezDynamicArray<ezTaskGroupID> s_ExtractTasks;
@@ -54,6 +55,7 @@ namespace
   static ezDynamicArray<PipelineToRebuild> s_PipelinesToRebuild;
 
   static ezProxyAllocator* s_pCacheAllocator;
+  static ezThreadArenaAllocator<>* s_pRenderDataAllocators[2];
 
   static ezMutex s_CachedRenderDataMutex;
   typedef ezHybridArray<const ezRenderData*, 4> CachedRenderDataPerComponent;
@@ -591,6 +593,9 @@ void ezRenderWorld::EndFrame()
   ClearRenderDataCache();
   UpdateRenderDataCache();
 
+  // The data in this allocator has been rendered by now and the render data cache holds copies of everything it needs.
+  s_pRenderDataAllocators[GetDataIndexForExtraction()]->Reset();
+
   s_RenderingThreadID = (ezThreadID)0;
 }
 
@@ -605,6 +610,16 @@ bool ezRenderWorld::IsRenderingThread()
   return s_RenderingThreadID == ezThreadUtils::GetCurrentThreadID();
 }
 
+bool ezRenderWorld::IsExtractingThread()
+{
+  return s_uiExtractionsOnThisThread > 0;
+}
+
+ezThreadArenaAllocator<>* ezRenderWorld::GetRenderDataAllocator()
+{
+  return s_pRenderDataAllocators[GetDataIndexForExtraction()];
+}
+
 void ezRenderWorld::DeleteCachedRenderDataInternal(const ezGameObjectHandle& hOwnerObject)
 {
   ezUInt32 uiCacheIndex = hOwnerObject.GetInternalID().m_InstanceIndex;
@@ -733,6 +748,19 @@ void ezRenderWorld::AddRenderPipelineToRebuild(ezRenderPipeline* pRenderPipeline
   pipelineToRebuild.m_hView = hView;
 }
 
+// static
+void ezRenderWorld::BeginExtractionOnThisThread()
+{
+  ++s_uiExtractionsOnThisThread;
+}
+
+// static
+void ezRenderWorld::EndExtractionOnThisThread()
+{
+  EZ_ASSERT_DEBUG(s_uiExtractionsOnThisThread > 0, "Unbalanced extraction");
+  --s_uiExtractionsOnThisThread;
+}
+
 // static
 void ezRenderWorld::RebuildPipelines()
 {
@@ -756,6 +784,9 @@ void ezRenderWorld::OnEngineStartup()
   s_pCacheAllocator = EZ_DEFAULT_NEW(ezProxyAllocator, "Cached Render Data", ezFoundation::GetDefaultAllocator());
 
   s_CachedRenderData = ezHashTable<ezComponentHandle, CachedRenderDataPerComponent>(s_pCacheAllocator);
+
+  s_pRenderDataAllocators[0] = EZ_DEFAULT_NEW(ezThreadArenaAllocator<>, "Render Data 0");
+  s_pRenderDataAllocators[1] = EZ_DEFAULT_NEW(ezThreadArenaAllocator<>, "Render Data 1");
 }
 
 void ezRenderWorld::OnEngineShutdown()
@@ -775,6 +806,9 @@ void ezRenderWorld::OnEngineShutdown()
 
   EZ_DEFAULT_DELETE(s_pCacheAllocator);
 
+  EZ_DEFAULT_DELETE(s_pRenderDataAllocators[0]);
+  EZ_DEFAULT_DELETE(s_pRenderDataAllocators[1]);
+
   s_FilteredRenderPipelines[0].Clear();
   s_FilteredRenderPipelines[1].Clear();
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Core/ResourceManager/ResourceHandle.h>
+#include <Foundation/Memory/ThreadArenaAllocator.h>
 #include <RendererCore/Pipeline/Declarations.h>
 
 typedef ezTypedResourceHandle<class ezRenderPipelineResource> ezRenderPipelineResourceHandle;
@@ -84,6 +85,15 @@ public:
 
   static bool IsRenderingThread();
 
+  /// \brief Returns whether the calling thread currently extracts a view.
+  static bool IsExtractingThread();
+
+  /// \brief Returns the allocator that render data for the frame that is currently extracted is allocated from.
+  ///
+  /// Every extraction thread allocates from its own arena. The allocator is double buffered like the extracted data,
+  /// it is reset in EndFrame() once the data that was allocated from it has been rendered.
+  static ezThreadArenaAllocator<>* GetRenderDataAllocator();
+
   /// \name Render To Texture
   /// @{
 public:
@@ -116,6 +126,9 @@ private:
   static void UpdateRenderDataCache();
 
   static void AddRenderPipelineToRebuild(ezRenderPipeline* pRenderPipeline, const ezViewHandle& hView);
+
+  static void BeginExtractionOnThisThread();
+  static void EndExtractionOnThisThread();
   static void RebuildPipelines();
 
   static void OnEngineStartup();
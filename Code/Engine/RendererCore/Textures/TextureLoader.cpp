@@ -163,6 +163,16 @@ void ezTextureResourceLoader::CloseDataStream(const ezResource* pResource, const
   EZ_DEFAULT_DELETE(pData);
 }
 
+bool ezTextureResourceLoader::GetFileToPrefetch(const ezResource* pResource, ezStringBuilder& out_sFile) const
+{
+  // solid color textures are generated, there is no file to read
+  if (ezPathUtils::HasExtension(pResource->GetResourceID(), "color"))
+    return false;
+
+  out_sFile = pResource->GetResourceID();
+  return true;
+}
+
 bool ezTextureResourceLoader::IsResourceOutdated(const ezResource* pResource) const
 {
   // solid color textures are never outdated
@@ -29,6 +29,7 @@ public:
   virtual ezResourceLoadData OpenDataStream(const ezResource* pResource) override;
   virtual void CloseDataStream(const ezResource* pResource, const ezResourceLoadData& LoaderData) override;
   virtual bool IsResourceOutdated(const ezResource* pResource) const override;
+  virtual bool GetFileToPrefetch(const ezResource* pResource, ezStringBuilder& out_sFile) const override;
 
   static ezResult LoadTexFile(ezStreamReader& stream, LoadedData& data);
   static void WriteTextureLoadStream(ezStreamWriter& stream, const LoadedData& data);
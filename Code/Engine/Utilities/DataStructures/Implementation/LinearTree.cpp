@@ -0,0 +1,594 @@
+#include <UtilitiesPCH.h>
+
+#include <Foundation/Containers/HybridArray.h>
+#include <Foundation/SimdMath/SimdBSphere.h>
+#include <Foundation/SimdMath/SimdConversion.h>
+#include <Utilities/DataStructures/Implementation/LinearTree.h>
+
+namespace
+{
+  /// The lowest bits of every node key store the node's level. Since the Morton code is padded to the finest level,
+  /// a parent node sorts directly before all of its children and every sub-tree is one contiguous range of keys.
+  static const ezUInt32 s_uiLevelBits = 5;
+
+  /// The maximum depths are chosen such that the padded Morton code plus the level fit into 64 bits.
+  static const ezUInt32 s_uiMaxOctreeDepth = 19;
+  static const ezUInt32 s_uiMaxQuadtreeDepth = 29;
+
+  /// The quadtree ignores the Y axis, so its nodes extend (nearly) infinitely in that direction.
+  static const float s_fQuadtreeNodeHeight = 1.0e30f;
+
+  /// \brief Returns the first index in [uiBegin; uiEnd) whose key is not smaller than uiKey (or larger, if bUpper is set).
+  EZ_ALWAYS_INLINE ezUInt32 BinarySearchKey(const ezUInt64* pKeys, ezUInt32 uiBegin, ezUInt32 uiEnd, ezUInt64 uiKey, bool bUpper)
+  {
+    while (uiBegin < uiEnd)
+    {
+      const ezUInt32 uiMiddle = uiBegin + (uiEnd - uiBegin) / 2;
+
+      if (pKeys[uiMiddle] < uiKey || (bUpper && pKeys[uiMiddle] == uiKey))
+        uiBegin = uiMiddle + 1;
+      else
+        uiEnd = uiMiddle;
+    }
+
+    return uiBegin;
+  }
+
+  EZ_ALWAYS_INLINE ezUInt64 SpreadBitsBy2(ezUInt32 x)
+  {
+    ezUInt64 v = x & 0x1FFFFF;
+    v = (v | v << 32) & 0x001F00000000FFFFull;
+    v = (v | v << 16) & 0x001F0000FF0000FFull;
+    v = (v | v << 8) & 0x100F00F00F00F00Full;
+    v = (v | v << 4) & 0x10C30C30C30C30C3ull;
+    v = (v | v << 2) & 0x1249249249249249ull;
+    return v;
+  }
+
+  EZ_ALWAYS_INLINE ezUInt64 SpreadBitsBy1(ezUInt32 x)
+  {
+    ezUInt64 v = x;
+    v = (v | v << 16) & 0x0000FFFF0000FFFFull;
+    v = (v | v << 8) & 0x00FF00FF00FF00FFull;
+    v = (v | v << 4) & 0x0F0F0F0F0F0F0F0Full;
+    v = (v | v << 2) & 0x3333333333333333ull;
+    v = (v | v << 1) & 0x5555555555555555ull;
+    return v;
+  }
+
+  /// \brief Unlike ezSimdBBox::Overlaps() this also returns true for touching boxes, which is needed for point-sized objects.
+  EZ_ALWAYS_INLINE bool OverlapsInclusive(const ezSimdBBox& a, const ezSimdBBox& b)
+  {
+    return ((a.m_Max >= b.m_Min) && (a.m_Min <= b.m_Max)).AllSet<3>();
+  }
+
+  EZ_ALWAYS_INLINE bool SphereContainsBox(const ezSimdBSphere& sphere, const ezSimdBBox& box)
+  {
+    const ezSimdVec4f vCenter = sphere.GetCenter();
+    const ezSimdVec4f vFarthest = (box.m_Min - vCenter).Abs().CompMax((box.m_Max - vCenter).Abs());
+    const ezSimdFloat fRadius = sphere.GetRadius();
+
+    return vFarthest.GetLengthSquared<3>() <= fRadius * fRadius;
+  }
+} // namespace
+
+struct ezLinearTree::Node
+{
+  ezUInt32 m_uiLevel;
+  ezUInt64 m_uiMortonCode;
+  ezVec3U32 m_vCell;
+
+  /// The range of objects in this node and all its children.
+  ezUInt32 m_uiBegin;
+  ezUInt32 m_uiEnd;
+};
+
+struct ezLinearTree::FrustumQuery
+{
+  EZ_ALWAYS_INLINE bool OverlapsNode(const ezSimdBBox& node) const { return m_pFrustum->Overlaps(node); }
+  EZ_ALWAYS_INLINE bool ContainsNode(const ezSimdBBox&) const { return false; }
+  EZ_ALWAYS_INLINE bool OverlapsObject(const ezSimdBBox& object) const { return m_pFrustum->Overlaps(object); }
+
+  const ezFrustum* m_pFrustum;
+};
+
+struct ezLinearTree::PointQuery
+{
+  EZ_ALWAYS_INLINE bool OverlapsNode(const ezSimdBBox& node) const { return node.Contains(m_vPoint); }
+  EZ_ALWAYS_INLINE bool ContainsNode(const ezSimdBBox&) const { return false; }
+  EZ_ALWAYS_INLINE bool OverlapsObject(const ezSimdBBox& object) const { return object.Contains(m_vPoint); }
+
+  ezSimdVec4f m_vPoint;
+};
+
+struct ezLinearTree::SphereQuery
+{
+  EZ_ALWAYS_INLINE bool OverlapsNode(const ezSimdBBox& node) const { return node.Overlaps(m_Sphere); }
+  EZ_ALWAYS_INLINE bool ContainsNode(const ezSimdBBox& node) const { return SphereContainsBox(m_Sphere, node); }
+  EZ_ALWAYS_INLINE bool OverlapsObject(const ezSimdBBox& object) const { return object.Overlaps(m_Sphere); }
+
+  ezSimdBSphere m_Sphere;
+};
+
+struct ezLinearTree::BoxQuery
+{
+  EZ_ALWAYS_INLINE bool OverlapsNode(const ezSimdBBox& node) const { return OverlapsInclusive(m_Box, node); }
+  EZ_ALWAYS_INLINE bool ContainsNode(const ezSimdBBox& node) const { return m_Box.Contains(node); }
+  EZ_ALWAYS_INLINE bool OverlapsObject(const ezSimdBBox& object) const { return OverlapsInclusive(m_Box, object); }
+
+  ezSimdBBox m_Box;
+};
+
+ezLinearTree::ezLinearTree(ezUInt32 uiDimensions)
+  : m_uiDimensions(uiDimensions)
+{
+  EZ_ASSERT_DEV(uiDimensions == 2 || uiDimensions == 3, "Only quadtrees and octrees are supported.");
+}
+
+void ezLinearTree::CreateTree(const ezVec3& vCenter, const ezVec3& vHalfExtents, float fMinNodeSize)
+{
+  RemoveAllObjects();
+
+  // the real bounding box might be long and thin -> bad node-size
+  // but still it can be used to reject inserting objects that are entirely outside the world
+  m_RealBBox.SetCenterAndHalfExtents(vCenter, vHalfExtents);
+
+  // the bounding box should be square, so use the maximum of the x, y and z extents (the quadtree ignores y)
+  if (m_uiDimensions == 3)
+  {
+    const float fMax = ezMath::Max(vHalfExtents.x, ezMath::Max(vHalfExtents.y, vHalfExtents.z));
+    m_BBox.SetCenterAndHalfExtents(vCenter, ezVec3(fMax));
+  }
+  else
+  {
+    const float fMax = ezMath::Max(vHalfExtents.x, vHalfExtents.z);
+    m_BBox.SetCenterAndHalfExtents(vCenter, ezVec3(fMax, vHalfExtents.y, fMax));
+  }
+
+  const ezUInt32 uiDepthLimit = m_uiDimensions == 3 ? s_uiMaxOctreeDepth : s_uiMaxQuadtreeDepth;
+
+  float fLength = m_BBox.GetExtents().x;
+
+  m_uiMaxTreeDepth = 0;
+  while (fLength > fMinNodeSize && m_uiMaxTreeDepth < uiDepthLimit)
+  {
+    ++m_uiMaxTreeDepth;
+    fLength *= 0.5f;
+  }
+}
+
+ezResult ezLinearTree::InsertObject(
+  const ezVec3& vCenter, const ezVec3& vHalfExtents, ezInt32 iObjectType, ezInt32 iObjectInstance, bool bOnlyIfInside)
+{
+  if (bOnlyIfInside && !IsInside(vCenter, vHalfExtents))
+    return EZ_FAILURE;
+
+  const ezUInt64 uiKey = ComputeObjectKey(vCenter, vHalfExtents);
+
+  // insert behind all objects with the same key, so that objects in the same node stay in insertion order
+  const ezUInt32 uiIndex = BinarySearchKey(m_NodeKeys.GetData(), 0, m_NodeKeys.GetCount(), uiKey, true);
+
+  ezLinearTreeObject obj;
+  obj.m_iObjectType = iObjectType;
+  obj.m_iObjectInstance = iObjectInstance;
+
+  ezSimdBBox bounds;
+  bounds.SetCenterAndHalfExtents(ezSimdConversion::ToVec3(vCenter), ezSimdConversion::ToVec3(vHalfExtents));
+
+  m_NodeKeys.Insert(uiKey, uiIndex);
+  m_Objects.Insert(obj, uiIndex);
+  m_ObjectBounds.Insert(bounds, uiIndex);
+
+  return EZ_SUCCESS;
+}
+
+ezUInt32 ezLinearTree::InsertObjects(ezArrayPtr<const ezLinearTreeObjectDesc> objects, bool bOnlyIfInside)
+{
+  struct SortedObject
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt64 m_uiKey;
+    ezUInt32 m_uiIndex;
+
+    EZ_ALWAYS_INLINE bool operator<(const SortedObject& rhs) const
+    {
+      if (m_uiKey != rhs.m_uiKey)
+        return m_uiKey < rhs.m_uiKey;
+
+      return m_uiIndex < rhs.m_uiIndex;
+    }
+  };
+
+  ezDynamicArray<SortedObject> newObjects;
+  newObjects.Reserve(objects.GetCount());
+
+  for (ezUInt32 i = 0; i < objects.GetCount(); ++i)
+  {
+    const ezLinearTreeObjectDesc& desc = objects[i];
+
+    if (bOnlyIfInside && !IsInside(desc.m_vCenter, desc.m_vHalfExtents))
+      continue;
+
+    auto& newObj = newObjects.ExpandAndGetRef();
+    newObj.m_uiKey = ComputeObjectKey(desc.m_vCenter, desc.m_vHalfExtents);
+    newObj.m_uiIndex = i;
+  }
+
+  newObjects.Sort();
+
+  // merge the sorted new objects into the existing ones, starting at the back, so that nothing needs to be moved twice
+  const ezUInt32 uiNumNew = newObjects.GetCount();
+  ezUInt32 uiOld = m_NodeKeys.GetCount();
+  ezUInt32 uiNew = uiNumNew;
+  ezUInt32 uiTarget = uiOld + uiNumNew;
+
+  m_NodeKeys.SetCountUninitialized(uiTarget);
+  m_Objects.SetCountUninitialized(uiTarget);
+  m_ObjectBounds.SetCountUninitialized(uiTarget);
+
+  while (uiNew > 0)
+  {
+    --uiTarget;
+
+    // on equal keys the new objects go behind the old ones, the same as in InsertObject()
+    if (uiOld > 0 && m_NodeKeys[uiOld - 1] > newObjects[uiNew - 1].m_uiKey)
+    {
+      --uiOld;
+      m_NodeKeys[uiTarget] = m_NodeKeys[uiOld];
+      m_Objects[uiTarget] = m_Objects[uiOld];
+      m_ObjectBounds[uiTarget] = m_ObjectBounds[uiOld];
+    }
+    else
+    {
+      --uiNew;
+      const ezLinearTreeObjectDesc& desc = objects[newObjects[uiNew].m_uiIndex];
+
+      m_NodeKeys[uiTarget] = newObjects[uiNew].m_uiKey;
+      m_Objects[uiTarget].m_iObjectType = desc.m_iObjectType;
+      m_Objects[uiTarget].m_iObjectInstance = desc.m_iObjectInstance;
+      m_ObjectBounds[uiTarget].SetCenterAndHalfExtents(
+        ezSimdConversion::ToVec3(desc.m_vCenter), ezSimdConversion::ToVec3(desc.m_vHalfExtents));
+    }
+  }
+
+  return uiNumNew;
+}
+
+void ezLinearTree::FindVisibleObjects(const ezFrustum& Viewfrustum, EZ_LINEAR_TREE_CALLBACK Callback, void* pPassThrough) const
+{
+  if (IsEmpty())
+    return;
+
+  FrustumQuery query;
+  query.m_pFrustum = &Viewfrustum;
+
+  const Node root = {0, 0, ezVec3U32(0), 0, m_NodeKeys.GetCount()};
+  Traverse(query, root, false, Callback, pPassThrough);
+}
+
+void ezLinearTree::FindObjectsInRange(const ezVec3& vPoint, EZ_LINEAR_TREE_CALLBACK Callback, void* pPassThrough) const
+{
+  if (IsEmpty())
+    return;
+
+  PointQuery query;
+  query.m_vPoint = ezSimdConversion::ToVec3(vPoint);
+
+  const Node root = {0, 0, ezVec3U32(0), 0, m_NodeKeys.GetCount()};
+  Traverse(query, root, false, Callback, pPassThrough);
+}
+
+void ezLinearTree::FindObjectsInRange(const ezVec3& vPoint, float fRadius, EZ_LINEAR_TREE_CALLBACK Callback, void* pPassThrough) const
+{
+  if (IsEmpty())
+    return;
+
+  SphereQuery query;
+  query.m_Sphere = ezSimdBSphere(ezSimdConversion::ToVec3(vPoint), fRadius);
+
+  const Node root = {0, 0, ezVec3U32(0), 0, m_NodeKeys.GetCount()};
+  Traverse(query, root, false, Callback, pPassThrough);
+}
+
+void ezLinearTree::FindObjectsInBox(const ezBoundingBox& Box, EZ_LINEAR_TREE_CALLBACK Callback, void* pPassThrough) const
+{
+  if (IsEmpty())
+    return;
+
+  BoxQuery query;
+  query.m_Box = ezSimdConversion::ToBBox(Box);
+
+  const Node root = {0, 0, ezVec3U32(0), 0, m_NodeKeys.GetCount()};
+  Traverse(query, root, false, Callback, pPassThrough);
+}
+
+void ezLinearTree::FindObjectsInRange(
+  ezArrayPtr<const ezVec3> points, float fRadius, EZ_LINEAR_TREE_BATCH_CALLBACK Callback, void* pPassThrough) const
+{
+  if (IsEmpty() || points.IsEmpty())
+    return;
+
+  ezDynamicArray<ezSimdBSphere, ezAlignedAllocatorWrapper> spheres;
+  spheres.SetCountUninitialized(points.GetCount());
+
+  ezHybridArray<ezUInt32, 64> activeQueries;
+  activeQueries.SetCountUninitialized(points.GetCount());
+
+  for (ezUInt32 i = 0; i < points.GetCount(); ++i)
+  {
+    spheres[i] = ezSimdBSphere(ezSimdConversion::ToVec3(points[i]), fRadius);
+    activeQueries[i] = i;
+  }
+
+  const Node root = {0, 0, ezVec3U32(0), 0, m_NodeKeys.GetCount()};
+  TraverseBatch(spheres.GetData(), activeQueries, root, Callback, pPassThrough);
+}
+
+void ezLinearTree::RemoveObject(ezInt32 iObjectType, ezInt32 iObjectInstance)
+{
+  for (ezUInt32 i = 0; i < m_Objects.GetCount(); ++i)
+  {
+    if (m_Objects[i].m_iObjectInstance == iObjectInstance && m_Objects[i].m_iObjectType == iObjectType)
+    {
+      m_NodeKeys.RemoveAtAndCopy(i);
+      m_Objects.RemoveAtAndCopy(i);
+      m_ObjectBounds.RemoveAtAndCopy(i);
+      return;
+    }
+  }
+}
+
+void ezLinearTree::RemoveObjectsOfType(ezInt32 iObjectType)
+{
+  ezUInt32 uiTarget = 0;
+
+  for (ezUInt32 i = 0; i < m_Objects.GetCount(); ++i)
+  {
+    if (m_Objects[i].m_iObjectType == iObjectType)
+      continue;
+
+    if (uiTarget != i)
+    {
+      m_NodeKeys[uiTarget] = m_NodeKeys[i];
+      m_Objects[uiTarget] = m_Objects[i];
+      m_ObjectBounds[uiTarget] = m_ObjectBounds[i];
+    }
+
+    ++uiTarget;
+  }
+
+  m_NodeKeys.SetCountUninitialized(uiTarget);
+  m_Objects.SetCountUninitialized(uiTarget);
+  m_ObjectBounds.SetCountUninitialized(uiTarget);
+}
+
+void ezLinearTree::RemoveAllObjects()
+{
+  m_NodeKeys.Clear();
+  m_Objects.Clear();
+  m_ObjectBounds.Clear();
+}
+
+bool ezLinearTree::IsInside(const ezVec3& vCenter, const ezVec3& vHalfExtents) const
+{
+  if (vCenter.x + vHalfExtents.x < m_RealBBox.m_vMin.x || vCenter.x - vHalfExtents.x > m_RealBBox.m_vMax.x)
+    return false;
+
+  if (vCenter.z + vHalfExtents.z < m_RealBBox.m_vMin.z || vCenter.z - vHalfExtents.z > m_RealBBox.m_vMax.z)
+    return false;
+
+  // the quadtree does not care about the height of objects
+  if (m_uiDimensions == 3 && (vCenter.y + vHalfExtents.y < m_RealBBox.m_vMin.y || vCenter.y - vHalfExtents.y > m_RealBBox.m_vMax.y))
+    return false;
+
+  return true;
+}
+
+ezUInt64 ezLinearTree::ComputeObjectKey(const ezVec3& vCenter, const ezVec3& vHalfExtents) const
+{
+  const ezVec3 vRelPos = (vCenter - m_BBox.m_vMin) / m_BBox.GetExtents().x;
+  const bool bIs3D = m_uiDimensions == 3;
+
+  // objects whose center is outside the tree are stored at the root node, which is never culled
+  if (vRelPos.x < 0.0f || vRelPos.x >= 1.0f || vRelPos.z < 0.0f || vRelPos.z >= 1.0f || (bIs3D && (vRelPos.y < 0.0f || vRelPos.y >= 1.0f)))
+    return ComputeNodeKey(0, 0);
+
+  const float fMaxHalfExtent = ezMath::Max(ezMath::Max(vHalfExtents.x, vHalfExtents.z), bIs3D ? vHalfExtents.y : 0.0f);
+
+  // the loose bounds of a node extend by half a node size on each side,
+  // so an object fits into the node that contains its center, if its half extents are at most half the node size
+  ezUInt32 uiLevel = m_uiMaxTreeDepth;
+  while (uiLevel > 0 && m_BBox.GetExtents().x / static_cast<float>(1u << uiLevel) * 0.5f < fMaxHalfExtent)
+  {
+    --uiLevel;
+  }
+
+  const ezUInt32 uiNumCells = 1u << uiLevel;
+  const float fNumCells = static_cast<float>(uiNumCells);
+  const ezUInt32 uiCellX = ezMath::Min(static_cast<ezUInt32>(vRelPos.x * fNumCells), uiNumCells - 1);
+  const ezUInt32 uiCellY = bIs3D ? ezMath::Min(static_cast<ezUInt32>(vRelPos.y * fNumCells), uiNumCells - 1) : 0;
+  const ezUInt32 uiCellZ = ezMath::Min(static_cast<ezUInt32>(vRelPos.z * fNumCells), uiNumCells - 1);
+
+  // the child index of a node is made up of one bit per axis, in the same order as the bits of the Morton code
+  ezUInt64 uiMortonCode;
+  if (bIs3D)
+    uiMortonCode = SpreadBitsBy2(uiCellX) | (SpreadBitsBy2(uiCellY) << 1) | (SpreadBitsBy2(uiCellZ) << 2);
+  else
+    uiMortonCode = SpreadBitsBy1(uiCellX) | (SpreadBitsBy1(uiCellZ) << 1);
+
+  return ComputeNodeKey(uiLevel, uiMortonCode);
+}
+
+EZ_ALWAYS_INLINE ezUInt64 ezLinearTree::ComputeNodeKey(ezUInt32 uiLevel, ezUInt64 uiMortonCode) const
+{
+  return ((uiMortonCode << (m_uiDimensions * (m_uiMaxTreeDepth - uiLevel))) << s_uiLevelBits) | uiLevel;
+}
+
+EZ_ALWAYS_INLINE ezUInt64 ezLinearTree::ComputeSubTreeEndKey(ezUInt32 uiLevel, ezUInt64 uiMortonCode) const
+{
+  return ((uiMortonCode + 1) << (m_uiDimensions * (m_uiMaxTreeDepth - uiLevel))) << s_uiLevelBits;
+}
+
+EZ_ALWAYS_INLINE ezSimdBBox ezLinearTree::ComputeLooseNodeBounds(const Node& node) const
+{
+  const float fNodeSize = m_BBox.GetExtents().x / static_cast<float>(1u << node.m_uiLevel);
+
+  const ezVec3 vCell(static_cast<float>(node.m_vCell.x), static_cast<float>(node.m_vCell.y), static_cast<float>(node.m_vCell.z));
+
+  ezVec3 vMin = m_BBox.m_vMin + vCell * fNodeSize;
+  ezVec3 vMax = vMin + ezVec3(fNodeSize);
+
+  vMin -= ezVec3(fNodeSize * 0.5f);
+  vMax += ezVec3(fNodeSize * 0.5f);
+
+  if (m_uiDimensions == 2)
+  {
+    vMin.y = -s_fQuadtreeNodeHeight;
+    vMax.y = s_fQuadtreeNodeHeight;
+  }
+
+  return ezSimdBBox(ezSimdConversion::ToVec3(vMin), ezSimdConversion::ToVec3(vMax));
+}
+
+EZ_ALWAYS_INLINE void ezLinearTree::ComputeChildNode(const Node& parent, ezUInt32 uiChild, ezUInt32 uiBegin, Node& out_Child) const
+{
+  const ezUInt32 uiLastChild = (1u << m_uiDimensions) - 1;
+
+  out_Child.m_uiLevel = parent.m_uiLevel + 1;
+  out_Child.m_uiMortonCode = (parent.m_uiMortonCode << m_uiDimensions) | uiChild;
+  out_Child.m_uiBegin = uiBegin;
+
+  if (uiChild == uiLastChild)
+  {
+    out_Child.m_uiEnd = parent.m_uiEnd;
+  }
+  else
+  {
+    const ezUInt64 uiEndKey = ComputeSubTreeEndKey(out_Child.m_uiLevel, out_Child.m_uiMortonCode);
+    out_Child.m_uiEnd = BinarySearchKey(m_NodeKeys.GetData(), uiBegin, parent.m_uiEnd, uiEndKey, false);
+  }
+
+  if (m_uiDimensions == 3)
+  {
+    out_Child.m_vCell.Set(parent.m_vCell.x * 2 + (uiChild & 1), parent.m_vCell.y * 2 + ((uiChild >> 1) & 1), parent.m_vCell.z * 2 + ((uiChild >> 2) & 1));
+  }
+  else
+  {
+    out_Child.m_vCell.Set(parent.m_vCell.x * 2 + (uiChild & 1), 0, parent.m_vCell.z * 2 + ((uiChild >> 1) & 1));
+  }
+}
+
+template <typename Query>
+bool ezLinearTree::Traverse(const Query& query, const Node& node, bool bNodeInsideQuery, EZ_LINEAR_TREE_CALLBACK Callback, void* pPassThrough) const
+{
+  // if the node is entirely inside the query, all objects in the sub-tree overlap it
+  if (bNodeInsideQuery)
+  {
+    for (ezUInt32 i = node.m_uiBegin; i < node.m_uiEnd; ++i)
+    {
+      if (!Callback(pPassThrough, m_Objects[i]))
+        return false;
+    }
+
+    return true;
+  }
+
+  // the objects of this node come first, followed by the objects of all children
+  const ezUInt64 uiNodeKey = ComputeNodeKey(node.m_uiLevel, node.m_uiMortonCode);
+
+  ezUInt32 uiCur = node.m_uiBegin;
+  for (; uiCur < node.m_uiEnd && m_NodeKeys[uiCur] == uiNodeKey; ++uiCur)
+  {
+    if (query.OverlapsObject(m_ObjectBounds[uiCur]))
+    {
+      if (!Callback(pPassThrough, m_Objects[uiCur]))
+        return false;
+    }
+  }
+
+  if (node.m_uiLevel == m_uiMaxTreeDepth)
+    return true;
+
+  const ezUInt32 uiNumChildren = 1u << m_uiDimensions;
+
+  for (ezUInt32 uiChild = 0; uiChild < uiNumChildren && uiCur < node.m_uiEnd; ++uiChild)
+  {
+    Node child;
+    ComputeChildNode(node, uiChild, uiCur, child);
+    uiCur = child.m_uiEnd;
+
+    // empty sub-trees are skipped without looking at their bounds
+    if (child.m_uiBegin == child.m_uiEnd)
+      continue;
+
+    const ezSimdBBox childBounds = ComputeLooseNodeBounds(child);
+
+    if (!query.OverlapsNode(childBounds))
+      continue;
+
+    if (!Traverse(query, child, query.ContainsNode(childBounds), Callback, pPassThrough))
+      return false;
+  }
+
+  return true;
+}
+
+bool ezLinearTree::TraverseBatch(const ezSimdBSphere* pSpheres, ezArrayPtr<const ezUInt32> activeQueries, const Node& node,
+  EZ_LINEAR_TREE_BATCH_CALLBACK Callback, void* pPassThrough) const
+{
+  const ezUInt64 uiNodeKey = ComputeNodeKey(node.m_uiLevel, node.m_uiMortonCode);
+
+  ezUInt32 uiCur = node.m_uiBegin;
+  for (; uiCur < node.m_uiEnd && m_NodeKeys[uiCur] == uiNodeKey; ++uiCur)
+  {
+    const ezSimdBBox& objectBounds = m_ObjectBounds[uiCur];
+
+    for (ezUInt32 uiQuery : activeQueries)
+    {
+      if (objectBounds.Overlaps(pSpheres[uiQuery]))
+      {
+        if (!Callback(pPassThrough, uiQuery, m_Objects[uiCur]))
+          return false;
+      }
+    }
+  }
+
+  if (node.m_uiLevel == m_uiMaxTreeDepth)
+    return true;
+
+  const ezUInt32 uiNumChildren = 1u << m_uiDimensions;
+  ezHybridArray<ezUInt32, 64> childQueries;
+
+  for (ezUInt32 uiChild = 0; uiChild < uiNumChildren && uiCur < node.m_uiEnd; ++uiChild)
+  {
+    Node child;
+    ComputeChildNode(node, uiChild, uiCur, child);
+    uiCur = child.m_uiEnd;
+
+    if (child.m_uiBegin == child.m_uiEnd)
+      continue;
+
+    const ezSimdBBox childBounds = ComputeLooseNodeBounds(child);
+
+    // only the queries that overlap the child are passed on
+    childQueries.Clear();
+    for (ezUInt32 uiQuery : activeQueries)
+    {
+      if (childBounds.Overlaps(pSpheres[uiQuery]))
+      {
+        childQueries.PushBack(uiQuery);
+      }
+    }
+
+    if (childQueries.IsEmpty())
+      continue;
+
+    if (!TraverseBatch(pSpheres, childQueries, child, Callback, pPassThrough))
+      return false;
+  }
+
+  return true;
+}
+
+EZ_STATICLINK_FILE(Utilities, Utilities_DataStructures_Implementation_LinearTree);
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Math/BoundingBox.h>
+#include <Foundation/Math/Frustum.h>
+#include <Foundation/Math/Vec3.h>
+#include <Foundation/Memory/AllocatorWrapper.h>
+#include <Foundation/SimdMath/SimdBBox.h>
+#include <Utilities/UtilitiesDLL.h>
+
+class ezSimdBSphere;
+
+/// \brief The two user values that are stored for every object in an ezLinearOctree or ezLinearQuadtree.
+struct ezLinearTreeObject
+{
+  EZ_DECLARE_POD_TYPE();
+
+  ezInt32 m_iObjectType;
+  ezInt32 m_iObjectInstance;
+};
+
+/// \brief Describes one object for ezLinearTree::InsertObjects().
+struct ezLinearTreeObjectDesc
+{
+  ezVec3 m_vCenter;
+  ezVec3 m_vHalfExtents;
+  ezInt32 m_iObjectType = 0;
+  ezInt32 m_iObjectInstance = 0;
+};
+
+/// \brief Callback type for object queries. Return "false" to abort a search (e.g. when the desired element has been found).
+typedef bool (*EZ_LINEAR_TREE_CALLBACK)(void* pPassThrough, const ezLinearTreeObject& Object);
+
+/// \brief Callback type for batched object queries. uiQueryIndex is the index of the query point that the object was found for.
+/// Return "false" to abort the whole search.
+typedef bool (*EZ_LINEAR_TREE_BATCH_CALLBACK)(void* pPassThrough, ezUInt32 uiQueryIndex, const ezLinearTreeObject& Object);
+
+/// \brief Base class for ezLinearOctree and ezLinearQuadtree. See ezLinearOctree for details.
+class EZ_UTILITIES_DLL ezLinearTree
+{
+public:
+  /// \brief Initializes the tree with a fixed size and minimum node dimensions. Removes all objects.
+  ///
+  /// The parameters have the same meaning as in ezDynamicOctree::CreateTree(). The tree depth is limited to 19 levels for the
+  /// octree and 29 levels for the quadtree.
+  void CreateTree(const ezVec3& vCenter, const ezVec3& vHalfExtents, float fMinNodeSize); // [tested]
+
+  /// \brief Returns true when there are no objects stored inside the tree.
+  bool IsEmpty() const { return m_NodeKeys.IsEmpty(); } // [tested]
+
+  /// \brief Returns the number of objects that have been inserted into the tree.
+  ezUInt32 GetCount() const { return m_NodeKeys.GetCount(); } // [tested]
+
+  /// \brief Adds an object at position vCenter with bounding-box dimensions vHalfExtents to the tree. If the object is outside the tree and
+  /// bOnlyIfInside is true, nothing will be inserted.
+  ///
+  /// Returns EZ_FAILURE when the object was rejected, which can only happen when bOnlyIfInside is set to true.
+  /// This is O(n) since the objects behind the new one are moved. Use InsertObjects() to add many objects at once.
+  ezResult InsertObject(
+    const ezVec3& vCenter, const ezVec3& vHalfExtents, ezInt32 iObjectType, ezInt32 iObjectInstance, bool bOnlyIfInside = false); // [tested]
+
+  /// \brief Adds all the given objects with a single sort and merge. Returns the number of objects that were inserted.
+  ezUInt32 InsertObjects(ezArrayPtr<const ezLinearTreeObjectDesc> objects, bool bOnlyIfInside = false); // [tested]
+
+  /// \brief Calls the Callback for every object whose bounding box overlaps the view-frustum.
+  void FindVisibleObjects(const ezFrustum& Viewfrustum, EZ_LINEAR_TREE_CALLBACK Callback, void* pPassThrough = nullptr) const; // [tested]
+
+  /// \brief Calls the Callback for every object whose bounding box contains the given point.
+  ///
+  /// \note Unlike ezDynamicOctree, this only returns objects that actually overlap with the query, not all objects in the touched nodes.
+  void FindObjectsInRange(const ezVec3& vPoint, EZ_LINEAR_TREE_CALLBACK Callback, void* pPassThrough = nullptr) const; // [tested]
+
+  /// \brief Calls the Callback for every object whose bounding box overlaps the sphere with center vPoint and radius fRadius.
+  void FindObjectsInRange(
+    const ezVec3& vPoint, float fRadius, EZ_LINEAR_TREE_CALLBACK Callback, void* pPassThrough = nullptr) const; // [tested]
+
+  /// \brief Calls the Callback for every object whose bounding box overlaps the given box.
+  void FindObjectsInBox(const ezBoundingBox& Box, EZ_LINEAR_TREE_CALLBACK Callback, void* pPassThrough = nullptr) const; // [tested]
+
+  /// \brief Does one sphere query for each of the given points with one traversal of the tree.
+  ///
+  /// Nodes are only visited once for all queries that overlap them. Works best when the points are close to each other.
+  void FindObjectsInRange(ezArrayPtr<const ezVec3> points, float fRadius, EZ_LINEAR_TREE_BATCH_CALLBACK Callback,
+    void* pPassThrough = nullptr) const; // [tested]
+
+  /// \brief Removes the given Object. This is an O(n) operation.
+  void RemoveObject(ezInt32 iObjectType, ezInt32 iObjectInstance); // [tested]
+
+  /// \brief Removes all Objects of the given Type. This is an O(n) operation.
+  void RemoveObjectsOfType(ezInt32 iObjectType); // [tested]
+
+  /// \brief Removes all Objects, but the tree stays intact.
+  void RemoveAllObjects(); // [tested]
+
+  /// \brief Returns the tree's adjusted (square) AABB.
+  const ezBoundingBox& GetBoundingBox() const { return m_BBox; } // [tested]
+
+  /// \brief Returns how many levels the tree has below the root node.
+  ezUInt32 GetMaxTreeDepth() const { return m_uiMaxTreeDepth; }
+
+protected:
+  explicit ezLinearTree(ezUInt32 uiDimensions);
+
+private:
+  struct Node;
+  struct FrustumQuery;
+  struct PointQuery;
+  struct SphereQuery;
+  struct BoxQuery;
+
+  /// \brief Returns false, if the object is not inside the tree bounds (only relevant for bOnlyIfInside).
+  bool IsInside(const ezVec3& vCenter, const ezVec3& vHalfExtents) const;
+
+  /// \brief Computes the key of the deepest node that fully contains the object.
+  ezUInt64 ComputeObjectKey(const ezVec3& vCenter, const ezVec3& vHalfExtents) const;
+
+  ezUInt64 ComputeNodeKey(ezUInt32 uiLevel, ezUInt64 uiMortonCode) const;
+  ezUInt64 ComputeSubTreeEndKey(ezUInt32 uiLevel, ezUInt64 uiMortonCode) const;
+  ezSimdBBox ComputeLooseNodeBounds(const Node& node) const;
+  void ComputeChildNode(const Node& parent, ezUInt32 uiChild, ezUInt32 uiBegin, Node& out_Child) const;
+
+  /// \brief Visits all nodes that overlap the query and calls the callback for all objects that overlap it as well.
+  template <typename Query>
+  bool Traverse(const Query& query, const Node& node, bool bNodeInsideQuery, EZ_LINEAR_TREE_CALLBACK Callback, void* pPassThrough) const;
+
+  bool TraverseBatch(const ezSimdBSphere* pSpheres, ezArrayPtr<const ezUInt32> activeQueries, const Node& node,
+    EZ_LINEAR_TREE_BATCH_CALLBACK Callback, void* pPassThrough) const;
+
+  /// \brief 3 for the octree, 2 for the quadtree (which ignores the Y axis)
+  const ezUInt32 m_uiDimensions;
+
+  ezUInt32 m_uiMaxTreeDepth = 0;
+
+  /// \brief The square bounding Box (to prevent long thin nodes)
+  ezBoundingBox m_BBox;
+
+  /// \brief The actual bounding box (to discard objects that are outside the world)
+  ezBoundingBox m_RealBBox;
+
+  /// \brief The node keys of all objects, sorted in Morton order, such that every sub-tree is a contiguous range.
+  ezDynamicArray<ezUInt64> m_NodeKeys;
+
+  /// \brief The user data of all objects, in the same order as m_NodeKeys.
+  ezDynamicArray<ezLinearTreeObject> m_Objects;
+
+  /// \brief The bounds of all objects, in the same order as m_NodeKeys.
+  ezDynamicArray<ezSimdBBox, ezAlignedAllocatorWrapper> m_ObjectBounds;
+};
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <Utilities/DataStructures/Implementation/LinearTree.h>
+
+/// \brief A loose Octree that stores all objects in a few flat arrays, sorted by the Morton code of their node.
+///
+/// Like ezDynamicOctree, this tree does not store any bookkeeping information per node and its memory usage is linear in
+/// the number of objects. Instead of a map, the node keys, the user data and the bounding boxes of all objects are stored
+/// in three arrays, which are sorted by node key.\n
+/// The node keys are Morton codes, padded to the finest level of the tree. This makes all objects of a node and its whole
+/// sub-tree one contiguous range in the arrays, so traversals only do a binary search per visited node and read the
+/// objects linearly. Empty sub-trees are skipped without any further work.\n
+/// \n
+/// Every node is twice the size of its cell (half a cell on each side), so objects are inserted into the deepest node that
+/// contains their center and has at least twice their size. This needs no recursion and is O(log n) to find the spot,
+/// plus O(n) to move the following objects. InsertObjects() adds many objects with a single sort and merge.\n
+/// \n
+/// Since the bounding box of every object is stored, queries only return the objects that actually overlap with the query
+/// (unlike ezDynamicOctree, which returns all objects in the touched nodes). The tests are done with the SIMD math classes.\n
+/// \n
+/// Removing objects is O(n), so this tree is best suited for data that is queried much more often than it changes.
+class ezLinearOctree : public ezLinearTree
+{
+public:
+  ezLinearOctree()
+    : ezLinearTree(3)
+  {
+  }
+};
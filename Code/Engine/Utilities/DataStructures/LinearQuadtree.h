@@ -0,0 +1,17 @@
+#pragma once
+
+#include <Utilities/DataStructures/Implementation/LinearTree.h>
+
+/// \brief A loose Quadtree that stores all objects in a few flat arrays, sorted by the Morton code of their node.
+///
+/// This is the two-dimensional version of ezLinearOctree, see there for details.\n
+/// The tree is spanned over the X and Z axes, the Y axis is ignored for the node placement, the same as in ezDynamicQuadtree.
+/// The queries still test the full 3D bounding boxes of the objects though.
+class ezLinearQuadtree : public ezLinearTree
+{
+public:
+  ezLinearQuadtree()
+    : ezLinearTree(2)
+  {
+  }
+};
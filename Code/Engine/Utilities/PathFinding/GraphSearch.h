@@ -1,5 +1,6 @@
 #pragma once
 
+#include <Foundation/Containers/DynamicArray.h>
 #include <Foundation/Math/Math.h>
 #include <Utilities/PathFinding/PathState.h>
 #include <Utilities/UtilitiesDLL.h>
@@ -11,6 +12,9 @@
 ///
 /// PathStateType must be derived from ezPathState and can be used for keeping track of certain state along a path and to modify
 /// the path search dynamically.
+///
+/// The nodes that still need to be expanded are kept in a binary heap, so picking the next node only costs O(log n).
+/// All memory is kept and reused by the following searches, so reuse ezPathSearch objects instead of creating one per search.
 template <typename PathStateType>
 class ezPathSearch
 {
@@ -56,16 +60,59 @@ public:
   /// \brief Needs to be called by the used ezPathStateGenerator to add nodes to evaluate.
   void AddPathNode(ezInt64 iNodeIndex, const PathStateType& NewState);
 
+  /// \brief Tells the path search that most node indices of the graph are in the range [0; uiNumNodes), e.g. the cell indices of a grid.
+  ///
+  /// The path states of those nodes are then found through a flat table instead of a hash table, which is a lot faster.
+  /// The table needs 8 bytes per node, it is kept for all following searches and does not need to be cleared between them.
+  /// Nodes outside the range still work, they use the hash table.
+  void SetDenseNodeIndexRange(ezUInt32 uiNumNodes);
+
 private:
+  struct NodeState
+  {
+    PathStateType m_State;
+    ezInt64 m_iNodeIndex;
+    ezUInt32 m_uiOpenListIndex; ///< Position in m_OpenList, ezInvalidIndex once the node was expanded
+  };
+
+  struct OpenListEntry
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    float m_fEstimatedCostToTarget;
+    ezUInt32 m_uiNodeState;
+  };
+
+  struct DenseNodeEntry
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt32 m_uiGeneration; ///< The entry is only valid if this equals m_uiGeneration
+    ezUInt32 m_uiNodeState;
+  };
+
   void ClearPathStates();
+  ezUInt32 FindNodeState(ezInt64 iNodeIndex) const;
+  ezUInt32 CreateNodeState(ezInt64 iNodeIndex);
+  void AddStartNode(ezUInt32 uiNodeState, const PathStateType& StartState);
   ezInt64 FindBestNodeToExpand(PathStateType*& out_pPathState);
   void FillOutPathResult(ezInt64 iEndNodeIndex, ezDeque<PathResultData>& out_Path);
 
-  ezPathStateGenerator<PathStateType>* m_pStateGenerator;
+  void PushToOpenList(ezUInt32 uiNodeState);
+  void MoveUpInOpenList(ezUInt32 uiOpenListIndex);
+  void MoveDownInOpenList(ezUInt32 uiOpenListIndex);
+  void SetOpenListEntry(ezUInt32 uiOpenListIndex, const OpenListEntry& entry);
+
+  ezPathStateGenerator<PathStateType>* m_pStateGenerator = nullptr;
 
-  ezHashTable<ezInt64, PathStateType> m_PathStates;
+  // all nodes that were reached by the current search
+  ezDynamicArray<NodeState> m_NodeStates;
+  ezHashTable<ezInt64, ezUInt32> m_NodeToState;
+  ezDynamicArray<DenseNodeEntry> m_DenseNodeToState;
+  ezUInt32 m_uiGeneration = 0;
 
-  ezDeque<ezInt64> m_StateQueue;
+  // binary min-heap of the nodes that still need to be expanded
+  ezDynamicArray<OpenListEntry> m_OpenList;
 
   ezInt64 m_iCurNodeIndex;
   PathStateType m_CurState;
@@ -1,39 +1,149 @@
 #pragma once
 
+template <typename PathStateType>
+void ezPathSearch<PathStateType>::SetDenseNodeIndexRange(ezUInt32 uiNumNodes)
+{
+  // new entries are zero, which is never the generation of a running search
+  m_DenseNodeToState.SetCount(uiNumNodes);
+}
+
 template <typename PathStateType>
 void ezPathSearch<PathStateType>::ClearPathStates()
 {
-  m_PathStates.Clear();
-  m_StateQueue.Clear();
+  // all containers keep their memory, so following searches don't need to allocate anything
+  m_NodeStates.Clear();
+  m_NodeToState.Clear();
+  m_OpenList.Clear();
+
+  // invalidates all entries in the dense table at once
+  ++m_uiGeneration;
+
+  if (m_uiGeneration == 0)
+  {
+    ezMemoryUtils::ZeroFill(m_DenseNodeToState.GetData(), m_DenseNodeToState.GetCount());
+    m_uiGeneration = 1;
+  }
 }
 
 template <typename PathStateType>
-ezInt64 ezPathSearch<PathStateType>::FindBestNodeToExpand(PathStateType*& out_pPathState)
+ezUInt32 ezPathSearch<PathStateType>::FindNodeState(ezInt64 iNodeIndex) const
 {
-  float fLowestEstimation = ezMath::Infinity<float>();
-  out_pPathState = nullptr;
-  ezUInt32 iBestInQueue = 0;
+  if (iNodeIndex >= 0 && iNodeIndex < m_DenseNodeToState.GetCount())
+  {
+    const DenseNodeEntry& entry = m_DenseNodeToState[static_cast<ezUInt32>(iNodeIndex)];
+    return entry.m_uiGeneration == m_uiGeneration ? entry.m_uiNodeState : ezInvalidIndex;
+  }
 
-  for (ezUInt32 i = 0; i < m_StateQueue.GetCount(); ++i)
+  ezUInt32 uiNodeState = ezInvalidIndex;
+  m_NodeToState.TryGetValue(iNodeIndex, uiNodeState);
+  return uiNodeState;
+}
+
+template <typename PathStateType>
+ezUInt32 ezPathSearch<PathStateType>::CreateNodeState(ezInt64 iNodeIndex)
+{
+  const ezUInt32 uiNodeState = m_NodeStates.GetCount();
+
+  NodeState& nodeState = m_NodeStates.ExpandAndGetRef();
+  nodeState.m_iNodeIndex = iNodeIndex;
+  nodeState.m_uiOpenListIndex = ezInvalidIndex;
+
+  if (iNodeIndex >= 0 && iNodeIndex < m_DenseNodeToState.GetCount())
+  {
+    DenseNodeEntry& entry = m_DenseNodeToState[static_cast<ezUInt32>(iNodeIndex)];
+    entry.m_uiGeneration = m_uiGeneration;
+    entry.m_uiNodeState = uiNodeState;
+  }
+  else
   {
-    const ezInt64 iNodeIndex = m_StateQueue[i];
+    m_NodeToState.Insert(iNodeIndex, uiNodeState);
+  }
 
-    PathStateType* pState = &m_PathStates[iNodeIndex];
+  return uiNodeState;
+}
 
-    if (pState->m_fEstimatedCostToTarget < fLowestEstimation)
-    {
-      fLowestEstimation = pState->m_fEstimatedCostToTarget;
-      out_pPathState = pState;
-      iBestInQueue = i;
-    }
+template <typename PathStateType>
+void ezPathSearch<PathStateType>::SetOpenListEntry(ezUInt32 uiOpenListIndex, const OpenListEntry& entry)
+{
+  m_OpenList[uiOpenListIndex] = entry;
+  m_NodeStates[entry.m_uiNodeState].m_uiOpenListIndex = uiOpenListIndex;
+}
+
+template <typename PathStateType>
+void ezPathSearch<PathStateType>::MoveUpInOpenList(ezUInt32 uiOpenListIndex)
+{
+  const OpenListEntry entry = m_OpenList[uiOpenListIndex];
+
+  while (uiOpenListIndex > 0)
+  {
+    const ezUInt32 uiParent = (uiOpenListIndex - 1) / 2;
+
+    if (m_OpenList[uiParent].m_fEstimatedCostToTarget <= entry.m_fEstimatedCostToTarget)
+      break;
+
+    SetOpenListEntry(uiOpenListIndex, m_OpenList[uiParent]);
+    uiOpenListIndex = uiParent;
+  }
+
+  SetOpenListEntry(uiOpenListIndex, entry);
+}
+
+template <typename PathStateType>
+void ezPathSearch<PathStateType>::MoveDownInOpenList(ezUInt32 uiOpenListIndex)
+{
+  const OpenListEntry entry = m_OpenList[uiOpenListIndex];
+  const ezUInt32 uiCount = m_OpenList.GetCount();
+
+  while (true)
+  {
+    ezUInt32 uiChild = uiOpenListIndex * 2 + 1;
+
+    if (uiChild >= uiCount)
+      break;
+
+    // pick the cheaper child
+    if (uiChild + 1 < uiCount && m_OpenList[uiChild + 1].m_fEstimatedCostToTarget < m_OpenList[uiChild].m_fEstimatedCostToTarget)
+      ++uiChild;
+
+    if (entry.m_fEstimatedCostToTarget <= m_OpenList[uiChild].m_fEstimatedCostToTarget)
+      break;
+
+    SetOpenListEntry(uiOpenListIndex, m_OpenList[uiChild]);
+    uiOpenListIndex = uiChild;
   }
 
-  EZ_ASSERT_DEV(out_pPathState != nullptr, "Implementation Error");
+  SetOpenListEntry(uiOpenListIndex, entry);
+}
 
-  const ezInt64 iBestNodeIndex = m_StateQueue[iBestInQueue];
-  m_StateQueue.RemoveAtAndSwap(iBestInQueue);
+template <typename PathStateType>
+void ezPathSearch<PathStateType>::PushToOpenList(ezUInt32 uiNodeState)
+{
+  OpenListEntry& entry = m_OpenList.ExpandAndGetRef();
+  entry.m_fEstimatedCostToTarget = m_NodeStates[uiNodeState].m_State.m_fEstimatedCostToTarget;
+  entry.m_uiNodeState = uiNodeState;
 
-  return iBestNodeIndex;
+  MoveUpInOpenList(m_OpenList.GetCount() - 1);
+}
+
+template <typename PathStateType>
+ezInt64 ezPathSearch<PathStateType>::FindBestNodeToExpand(PathStateType*& out_pPathState)
+{
+  EZ_ASSERT_DEV(!m_OpenList.IsEmpty(), "Implementation Error");
+
+  NodeState& best = m_NodeStates[m_OpenList[0].m_uiNodeState];
+  best.m_uiOpenListIndex = ezInvalidIndex;
+
+  const OpenListEntry last = m_OpenList.PeekBack();
+  m_OpenList.PopBack();
+
+  if (!m_OpenList.IsEmpty())
+  {
+    m_OpenList[0] = last;
+    MoveDownInOpenList(0);
+  }
+
+  out_pPathState = &best.m_State;
+  return best.m_iNodeIndex;
 }
 
 template <typename PathStateType>
@@ -43,7 +153,7 @@ void ezPathSearch<PathStateType>::FillOutPathResult(ezInt64 iEndNodeIndex, ezDeq
 
   while (true)
   {
-    const PathStateType* pCurState = &m_PathStates[iEndNodeIndex];
+    const PathStateType* pCurState = &m_NodeStates[FindNodeState(iEndNodeIndex)].m_State;
 
     PathResultData r;
     r.m_iNodeIndex = iEndNodeIndex;
@@ -69,28 +179,54 @@ void ezPathSearch<PathStateType>::AddPathNode(ezInt64 iNodeIndex, const PathStat
   // ezArgF(m_pCurPathState->m_fEstimatedCostToTarget, 2), ezArgF(NewState.m_fEstimatedCostToTarget, 2));
   EZ_ASSERT_DEV(NewState.m_fEstimatedCostToTarget >= NewState.m_fCostToNode, "Unrealistic expectations will get you nowhere.");
 
-  PathStateType* pExistingState;
+  ezUInt32 uiNodeState = FindNodeState(iNodeIndex);
 
-  if (m_PathStates.TryGetValue(iNodeIndex, pExistingState))
+  if (uiNodeState != ezInvalidIndex)
   {
-    // state already exists in the hash table, and has a lower cost -> ignore the new state
-    if (pExistingState->m_fCostToNode <= NewState.m_fCostToNode)
+    NodeState& existing = m_NodeStates[uiNodeState];
+
+    // state already exists, and has a lower cost -> ignore the new state
+    if (existing.m_State.m_fCostToNode <= NewState.m_fCostToNode)
       return;
 
     // incoming state is better than the existing state -> update existing state
-    *pExistingState = NewState;
-    pExistingState->m_iReachedThroughNode = m_iCurNodeIndex;
+    existing.m_State = NewState;
+    existing.m_State.m_iReachedThroughNode = m_iCurNodeIndex;
+
+    // if it still needs to be expanded, move it to its new place in the queue
+    if (existing.m_uiOpenListIndex != ezInvalidIndex)
+    {
+      const ezUInt32 uiOpenListIndex = existing.m_uiOpenListIndex;
+      m_OpenList[uiOpenListIndex].m_fEstimatedCostToTarget = existing.m_State.m_fEstimatedCostToTarget;
+
+      MoveUpInOpenList(uiOpenListIndex);
+      MoveDownInOpenList(existing.m_uiOpenListIndex);
+    }
+
     return;
   }
 
   // the state has not been reached before -> insert it
-  pExistingState = &m_PathStates[iNodeIndex];
+  uiNodeState = CreateNodeState(iNodeIndex);
 
-  *pExistingState = NewState;
-  pExistingState->m_iReachedThroughNode = m_iCurNodeIndex;
+  PathStateType& state = m_NodeStates[uiNodeState].m_State;
+  state = NewState;
+  state.m_iReachedThroughNode = m_iCurNodeIndex;
 
   // put it into the queue of states that still need to be expanded
-  m_StateQueue.PushBack(iNodeIndex);
+  PushToOpenList(uiNodeState);
+}
+
+template <typename PathStateType>
+void ezPathSearch<PathStateType>::AddStartNode(ezUInt32 uiNodeState, const PathStateType& StartState)
+{
+  // make sure the first state references itself, as that is a termination criterion
+  NodeState& FirstState = m_NodeStates[uiNodeState];
+  FirstState.m_State = StartState;
+  FirstState.m_State.m_iReachedThroughNode = FirstState.m_iNodeIndex;
+
+  // put the start state into the to-be-expanded queue
+  PushToOpenList(uiNodeState);
 }
 
 template <typename PathStateType>
@@ -103,13 +239,12 @@ ezResult ezPathSearch<PathStateType>::FindPath(ezInt64 iStartNodeIndex, const Pa
 
   if (iStartNodeIndex == iTargetNodeIndex)
   {
-    m_PathStates.Reserve(1);
-
-    m_PathStates[iTargetNodeIndex] = StartState;
+    PathStateType& TargetState = m_NodeStates[CreateNodeState(iTargetNodeIndex)].m_State;
+    TargetState = StartState;
 
     PathResultData r;
     r.m_iNodeIndex = iTargetNodeIndex;
-    r.m_pPathState = &m_PathStates[iTargetNodeIndex];
+    r.m_pPathState = &TargetState;
 
     out_Path.Clear();
     out_Path.PushBack(r);
@@ -117,21 +252,14 @@ ezResult ezPathSearch<PathStateType>::FindPath(ezInt64 iStartNodeIndex, const Pa
     return EZ_SUCCESS;
   }
 
-  m_PathStates.Reserve(10000);
-
-  PathStateType& FirstState = m_PathStates[iStartNodeIndex];
+  const ezUInt32 uiStartNodeState = CreateNodeState(iStartNodeIndex);
 
-  m_pStateGenerator->StartSearch(iStartNodeIndex, &FirstState, iTargetNodeIndex);
-
-  // make sure the first state references itself, as that is a termination criterion
-  FirstState = StartState;
-  FirstState.m_iReachedThroughNode = iStartNodeIndex;
+  m_pStateGenerator->StartSearch(iStartNodeIndex, &m_NodeStates[uiStartNodeState].m_State, iTargetNodeIndex);
 
-  // put the start state into the to-be-expanded queue
-  m_StateQueue.PushBack(iStartNodeIndex);
+  AddStartNode(uiStartNodeState, StartState);
 
   // while the queue is not empty, expand the next node and see where that gets us
-  while (!m_StateQueue.IsEmpty())
+  while (!m_OpenList.IsEmpty())
   {
     PathStateType* pCurState;
     m_iCurNodeIndex = FindBestNodeToExpand(pCurState);
@@ -153,6 +281,7 @@ ezResult ezPathSearch<PathStateType>::FindPath(ezInt64 iStartNodeIndex, const Pa
       return EZ_FAILURE;
     }
 
+    // pCurState is invalidated when the generator adds new nodes
     m_CurState = *pCurState;
 
     // let the generate append all the nodes that we can reach from here
@@ -172,21 +301,14 @@ ezResult ezPathSearch<PathStateType>::FindClosest(
 
   ClearPathStates();
 
-  m_PathStates.Reserve(10000);
-
-  PathStateType& FirstState = m_PathStates[iStartNodeIndex];
+  const ezUInt32 uiStartNodeState = CreateNodeState(iStartNodeIndex);
 
-  m_pStateGenerator->StartSearchForClosest(iStartNodeIndex, &FirstState);
+  m_pStateGenerator->StartSearchForClosest(iStartNodeIndex, &m_NodeStates[uiStartNodeState].m_State);
 
-  // make sure the first state references itself, as that is a termination criterion
-  FirstState = StartState;
-  FirstState.m_iReachedThroughNode = iStartNodeIndex;
-
-  // put the start state into the to-be-expanded queue
-  m_StateQueue.PushBack(iStartNodeIndex);
+  AddStartNode(uiStartNodeState, StartState);
 
   // while the queue is not empty, expand the next node and see where that gets us
-  while (!m_StateQueue.IsEmpty())
+  while (!m_OpenList.IsEmpty())
   {
     PathStateType* pCurState;
     m_iCurNodeIndex = FindBestNodeToExpand(pCurState);
@@ -208,6 +330,7 @@ ezResult ezPathSearch<PathStateType>::FindClosest(
       return EZ_FAILURE;
     }
 
+    // pCurState is invalidated when the generator adds new nodes
     m_CurState = *pCurState;
 
     // let the generate append all the nodes that we can reach from here
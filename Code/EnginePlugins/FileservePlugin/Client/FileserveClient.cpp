@@ -9,11 +9,19 @@
 #include <Foundation/Logging/Log.h>
 #include <Foundation/Types/ScopeExit.h>
 #include <Foundation/Utilities/CommandLineUtils.h>
+#include <Foundation/Utilities/Compression.h>
 
 EZ_IMPLEMENT_SINGLETON(ezFileserveClient);
 
 bool ezFileserveClient::s_bEnableFileserve = true;
 
+// enough requests in flight to hide the network latency, without buffering too much data on the client
+static const ezUInt32 s_uiFilesPerPrefetchBatch = 64;
+static const ezUInt32 s_uiMaxPrefetchBatchesInFlight = 8;
+
+// servers that don't answer the handshake within this time are too old to know about it
+static const ezTime s_HandshakeTimeout = ezTime::Seconds(2);
+
 ezFileserveClient::ezFileserveClient()
   : m_SingletonRegistrar(this)
 {
@@ -53,6 +61,14 @@ ezFileserveClient::ezFileserveClient()
 
 ezFileserveClient::~ezFileserveClient()
 {
+  for (const DataDir& dd : m_MountedDataDirs)
+  {
+    if (dd.m_bMounted)
+    {
+      SaveCacheIndex(dd);
+    }
+  }
+
   ShutdownConnection();
 }
 
@@ -74,6 +90,7 @@ void ezFileserveClient::ClearState()
   m_CurFileRequestGuid = ezUuid();
   m_sCurFileRequest.Clear();
   m_Download.Clear();
+  AbortPrefetches();
 }
 
 ezResult ezFileserveClient::EnsureConnected(ezTime timeout)
@@ -126,7 +143,14 @@ ezResult ezFileserveClient::EnsureConnected(ezTime timeout)
       ezLog::Success("Connected to ezFileserver '{0}", m_sServerConnectionAddress);
       m_Network->SetMessageHandler('FSRV', ezMakeDelegate(&ezFileserveClient::NetworkMsgHandler, this));
 
-      m_Network->Send('FSRV', 'HELO'); // be friendly
+      // be friendly, servers that support prefetching answer with their protocol version
+      ezRemoteMessage msg('FSRV', 'HELO');
+      msg.GetWriter() << ezFileserveProtocolVersion;
+      m_Network->Send(ezRemoteTransmitMode::Reliable, msg);
+
+      m_uiServerProtocolVersion = 0;
+      m_bServerProtocolVersionKnown = false;
+      m_HandshakeStartTime = ezTime::Now();
     }
 
     m_bFailedToConnect = false;
@@ -154,6 +178,8 @@ void ezFileserveClient::UpdateClient()
   m_CurrentTime = ezTime::Now();
 
   m_Network->ExecuteAllMessageHandlers();
+
+  SendQueuedPrefetches();
 }
 
 void ezFileserveClient::AddServerAddressToTry(const char* szAddress)
@@ -192,6 +218,7 @@ void ezFileserveClient::UploadFile(ezUInt16 uiDataDirID, const char* szFile, con
     }
 
     WriteMetaFile(sCachedMetaFile, 0, uiHash);
+    m_MountedDataDirs[uiDataDirID].m_CachedFiles.Insert(szFile);
 
     InvalidateFileCache(uiDataDirID, szFile, uiHash);
   }
@@ -258,6 +285,7 @@ void ezFileserveClient::InvalidateFileCache(ezUInt16 uiDataDirID, const char* sz
   cache.m_FileHash = uiHash;
   cache.m_TimeStamp = 0;
   cache.m_LastCheck.SetZero(); // will trigger a server request and that in turn will update the file timestamp
+  cache.m_uiConfirmedEpoch = 0;
 
   // redirect the next access to this cache entry
   // together with the zero LastCheck that will make sure the best match gets updated as well
@@ -281,6 +309,7 @@ void ezFileserveClient::FillFileStatusCache(const char* szFile)
 
     DetermineCacheStatus(dd, szFile, cache);
     cache.m_LastCheck.SetZero();
+    cache.m_uiConfirmedEpoch = 0;
 
     if (cache.m_TimeStamp != 0 && cache.m_FileHash != 0) // file exists
     {
@@ -334,6 +363,55 @@ void ezFileserveClient::GetFullDataDirCachePath(const char* szDataDir, ezStringB
   out_sFullPathMeta.AppendPath(sMountPoint);
 }
 
+void ezFileserveClient::LoadCacheIndex(DataDir& dd) const
+{
+  EZ_LOCK(m_Mutex);
+  ezStringBuilder sIndexFile = m_sFileserveCacheMetaFolder;
+  sIndexFile.AppendPath(dd.m_sMountPoint);
+  sIndexFile.Append(".index");
+
+  ezOSFile file;
+  if (file.Open(sIndexFile, ezFileOpenMode::Read).Failed())
+    return;
+
+  ezDynamicArray<ezUInt8> content;
+  file.ReadAll(content);
+  content.PushBack(0);
+
+  // one file path per line
+  ezStringBuilder sContent = (const char*)content.GetData();
+  ezHybridArray<ezStringView, 32> lines;
+  sContent.Split(false, lines, "\n");
+
+  for (const ezStringView& line : lines)
+  {
+    dd.m_CachedFiles.Insert(line);
+  }
+}
+
+void ezFileserveClient::SaveCacheIndex(const DataDir& dd) const
+{
+  EZ_LOCK(m_Mutex);
+  ezStringBuilder sIndexFile = m_sFileserveCacheMetaFolder;
+  sIndexFile.AppendPath(dd.m_sMountPoint);
+  sIndexFile.Append(".index");
+
+  ezStringBuilder sContent;
+  for (const ezString& sFile : dd.m_CachedFiles)
+  {
+    sContent.Append(sFile, "\n");
+  }
+
+  ezOSFile file;
+  if (file.Open(sIndexFile, ezFileOpenMode::Write).Failed())
+  {
+    ezLog::Error("Failed to write fileserve cache index to '{0}'", sIndexFile);
+    return;
+  }
+
+  file.Write(sContent.GetData(), sContent.GetElementCount());
+}
+
 void ezFileserveClient::NetworkMsgHandler(ezRemoteMessage& msg)
 {
   EZ_LOCK(m_Mutex);
@@ -349,11 +427,33 @@ void ezFileserveClient::NetworkMsgHandler(ezRemoteMessage& msg)
     return;
   }
 
+  if (msg.GetMessageID() == 'PDAT')
+  {
+    HandlePrefetchDataMsg(msg);
+    return;
+  }
+
+  if (msg.GetMessageID() == 'PMAN')
+  {
+    HandlePrefetchManifestMsg(msg);
+    return;
+  }
+
+  if (msg.GetMessageID() == 'VERS')
+  {
+    msg.GetReader() >> m_uiServerProtocolVersion;
+    m_bServerProtocolVersionKnown = true;
+    return;
+  }
+
   static bool s_bReloadResources = false;
 
   if (msg.GetMessageID() == 'RLDR')
   {
     s_bReloadResources = true;
+
+    // files may have changed on the server, prefetched files have to be checked again
+    ++m_uiCacheEpoch;
   }
 
   if (!m_bDownloading && s_bReloadResources)
@@ -403,6 +503,14 @@ ezUInt16 ezFileserveClient::MountDataDirectory(const char* szDataDirectory, cons
   dd.m_sMountPoint = sMountPoint;
   dd.m_bMounted = true;
 
+  LoadCacheIndex(dd);
+
+  // the files that were cached in previous runs are revalidated in bulk in the background, instead of one by one on first access
+  for (const ezString& sFile : dd.m_CachedFiles)
+  {
+    QueuePrefetch(sFile);
+  }
+
   return uiDataDirID;
 }
 
@@ -410,6 +518,11 @@ ezUInt16 ezFileserveClient::MountDataDirectory(const char* szDataDirectory, cons
 void ezFileserveClient::UnmountDataDirectory(ezUInt16 uiDataDir)
 {
   EZ_LOCK(m_Mutex);
+  if (m_MountedDataDirs[uiDataDir].m_bMounted)
+  {
+    SaveCacheIndex(m_MountedDataDirs[uiDataDir]);
+  }
+
   if (!m_Network->IsConnectedToServer())
     return;
 
@@ -501,46 +614,60 @@ void ezFileserveClient::HandleFileTransferFinishedMsg(ezRemoteMessage& msg)
   ezUInt16 uiFoundInDataDir = 0;
   msg.GetReader() >> uiFoundInDataDir;
 
+  UpdateFileCache(m_sCurFileRequest, fileState, iFileTimeStamp, uiFileHash, uiFoundInDataDir, m_Download, false);
+}
+
+void ezFileserveClient::UpdateFileCache(const char* szFile, ezFileserveFileState fileState, ezInt64 iFileTimeStamp, ezUInt64 uiFileHash,
+  ezUInt16 uiFoundInDataDir, ezArrayPtr<const ezUInt8> content, bool bConfirmUntilReload)
+{
+  EZ_LOCK(m_Mutex);
+  const ezUInt32 uiConfirmedEpoch = bConfirmUntilReload ? m_uiCacheEpoch : 0;
+
   if (uiFoundInDataDir == 0xffff) // file does not exist on server in any data dir
   {
-    m_FileDataDir[m_sCurFileRequest] = 0; // placeholder
+    m_FileDataDir[szFile] = 0; // placeholder
 
     for (ezUInt32 i = 0; i < m_MountedDataDirs.GetCount(); ++i)
     {
-      auto& ref = m_MountedDataDirs[i].m_CacheStatus[m_sCurFileRequest];
+      auto& ref = m_MountedDataDirs[i].m_CacheStatus[szFile];
       ref.m_FileHash = 0;
       ref.m_TimeStamp = 0;
       ref.m_LastCheck = m_CurrentTime;
+      ref.m_uiConfirmedEpoch = uiConfirmedEpoch;
     }
 
     return;
   }
   else
   {
-    m_FileDataDir[m_sCurFileRequest] = uiFoundInDataDir;
+    m_FileDataDir[szFile] = uiFoundInDataDir;
 
-    auto& ref = m_MountedDataDirs[uiFoundInDataDir].m_CacheStatus[m_sCurFileRequest];
+    auto& ref = m_MountedDataDirs[uiFoundInDataDir].m_CacheStatus[szFile];
     ref.m_FileHash = uiFileHash;
     ref.m_TimeStamp = iFileTimeStamp;
     ref.m_LastCheck = m_CurrentTime;
+    ref.m_uiConfirmedEpoch = uiConfirmedEpoch;
   }
 
-  // nothing changed
-  if (fileState == ezFileserveFileState::SameTimestamp || fileState == ezFileserveFileState::NonExistantEither)
+  // the file doesn't exist on either side
+  if (fileState == ezFileserveFileState::NonExistantEither)
     return;
 
-  const ezString& sMountPoint = m_MountedDataDirs[uiFoundInDataDir].m_sMountPoint;
+  DataDir& dd = m_MountedDataDirs[uiFoundInDataDir];
   ezStringBuilder sCachedFile, sCachedMetaFile;
-  BuildPathInCache(m_sCurFileRequest, sMountPoint, &sCachedFile, &sCachedMetaFile);
+  BuildPathInCache(szFile, dd.m_sMountPoint, &sCachedFile, &sCachedMetaFile);
 
   if (fileState == ezFileserveFileState::NonExistant)
   {
     // remove them from the cache as well, if they still exist there
     ezOSFile::DeleteFile(sCachedFile);
     ezOSFile::DeleteFile(sCachedMetaFile);
+    dd.m_CachedFiles.Remove(szFile);
     return;
   }
 
+  dd.m_CachedFiles.Insert(szFile);
+
   // timestamp changed, but hash is still the same -> update timestamp
   if (fileState == ezFileserveFileState::SameHash)
   {
@@ -549,7 +676,7 @@ void ezFileserveClient::HandleFileTransferFinishedMsg(ezRemoteMessage& msg)
 
   if (fileState == ezFileserveFileState::Different)
   {
-    WriteDownloadToDisk(sCachedFile);
+    WriteDownloadToDisk(sCachedFile, content);
     WriteMetaFile(sCachedMetaFile, iFileTimeStamp, uiFileHash);
   }
 }
@@ -571,14 +698,14 @@ void ezFileserveClient::WriteMetaFile(ezStringBuilder sCachedMetaFile, ezInt64 i
   }
 }
 
-void ezFileserveClient::WriteDownloadToDisk(ezStringBuilder sCachedFile)
+void ezFileserveClient::WriteDownloadToDisk(ezStringBuilder sCachedFile, ezArrayPtr<const ezUInt8> content)
 {
   EZ_LOCK(m_Mutex);
   ezOSFile file;
   if (file.Open(sCachedFile, ezFileOpenMode::Write).Succeeded())
   {
-    if (!m_Download.IsEmpty())
-      file.Write(m_Download.GetData(), m_Download.GetCount());
+    if (!content.IsEmpty())
+      file.Write(content.GetPtr(), content.GetCount());
 
     file.Close();
   }
@@ -615,7 +742,8 @@ ezResult ezFileserveClient::DownloadFile(ezUInt16 uiDataDirID, const char* szFil
   const ezUInt16 uiUseDataDirCache = bForceThisDataDir ? uiDataDirID : itFileDataDir.Value();
   const FileCacheStatus& CacheStatus = m_MountedDataDirs[uiUseDataDirCache].m_CacheStatus[szFile];
 
-  if (m_CurrentTime - CacheStatus.m_LastCheck < ezTime::Seconds(5.0f))
+  // prefetched files stay valid until the server sends the next reload command
+  if (CacheStatus.m_uiConfirmedEpoch == m_uiCacheEpoch || m_CurrentTime - CacheStatus.m_LastCheck < ezTime::Seconds(5.0f))
   {
     if (CacheStatus.m_FileHash == 0) // file does not exist
       return EZ_FAILURE;
@@ -676,6 +804,377 @@ ezResult ezFileserveClient::DownloadFile(ezUInt16 uiDataDirID, const char* szFil
   }
 }
 
+ezResult ezFileserveClient::PrefetchFiles(const ezArrayPtr<const ezString>& files, ezTime timeout)
+{
+  EZ_LOCK(m_Mutex);
+  if (m_bDownloading)
+  {
+    ezLog::Warning("Trying to prefetch files over fileserve while another file is already downloading. Recursive prefetch is ignored.");
+    return EZ_FAILURE;
+  }
+
+  if (m_Network == nullptr || !m_Network->IsConnectedToServer() || m_MountedDataDirs.IsEmpty())
+    return EZ_FAILURE;
+
+  const ezTime tStart = ezTime::Now();
+
+  if (!ServerSupportsPrefetching(true))
+  {
+    // the server only understands single file requests
+    for (const ezString& sFile : files)
+    {
+      const ezUInt16 uiDataDirID = GetBestDataDir(sFile);
+      if (m_MountedDataDirs[uiDataDirID].m_bMounted)
+      {
+        // files that don't exist are cached as such, too
+        DownloadFile(uiDataDirID, sFile, false, nullptr).IgnoreResult();
+      }
+
+      if (!m_Network->IsConnectedToServer() || (timeout.IsPositive() && ezTime::Now() - tStart > timeout))
+      {
+        ezLog::Error("Downloading {0} files over fileserve failed", files.GetCount());
+        return EZ_FAILURE;
+      }
+    }
+
+    return EZ_SUCCESS;
+  }
+
+  // also prevents resource reloads while the cache is being updated
+  m_bDownloading = true;
+  EZ_SCOPE_EXIT(m_bDownloading = false);
+
+  ezUInt32 uiNextFile = 0;
+
+  while (uiNextFile < files.GetCount() || !m_PrefetchBatches.IsEmpty())
+  {
+    // keep several batches in flight, so that the server always has the next request at hand
+    while (uiNextFile < files.GetCount() && m_PrefetchBatches.GetCount() < s_uiMaxPrefetchBatchesInFlight)
+    {
+      const ezUInt32 uiNumFiles = ezMath::Min(s_uiFilesPerPrefetchBatch, files.GetCount() - uiNextFile);
+      SendPrefetchBatch(files.GetSubArray(uiNextFile, uiNumFiles));
+      uiNextFile += uiNumFiles;
+    }
+
+    m_Network->UpdateRemoteInterface();
+    m_Network->ExecuteAllMessageHandlers();
+
+    m_CurrentTime = ezTime::Now();
+
+    if (!m_Network->IsConnectedToServer() || (timeout.IsPositive() && m_CurrentTime - tStart > timeout))
+    {
+      ezLog::Error("Prefetching {0} files over fileserve failed", files.GetCount());
+
+      // answers to the batches in flight are ignored from now on
+      AbortPrefetches();
+      return EZ_FAILURE;
+    }
+  }
+
+  return EZ_SUCCESS;
+}
+
+ezResult ezFileserveClient::PrefetchCachedFiles(ezTime timeout)
+{
+  EZ_LOCK(m_Mutex);
+
+  // the same file may be cached for several data directories, but is only requested once
+  ezSet<ezString> cachedFiles;
+
+  for (const DataDir& dd : m_MountedDataDirs)
+  {
+    if (!dd.m_bMounted)
+      continue;
+
+    for (const ezString& sFile : dd.m_CachedFiles)
+    {
+      cachedFiles.Insert(sFile);
+    }
+  }
+
+  ezDynamicArray<ezString> files;
+  files.Reserve(cachedFiles.GetCount());
+
+  for (const ezString& sFile : cachedFiles)
+  {
+    files.PushBack(sFile);
+  }
+
+  return PrefetchFiles(files, timeout);
+}
+
+void ezFileserveClient::SendPrefetchBatch(const ezArrayPtr<const ezString>& files)
+{
+  EZ_LOCK(m_Mutex);
+
+  ezUuid batchGuid;
+  batchGuid.CreateNewUuid();
+
+  PrefetchBatch& batch = m_PrefetchBatches[batchGuid];
+  batch.m_Files = files;
+
+  // tell the server whether it may send compressed data
+  ezUInt8 uiCompressionMode = 0;
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+  uiCompressionMode = 1;
+#endif
+
+  ezRemoteMessage msg('FSRV', 'PREF');
+  msg.GetWriter() << batchGuid;
+  msg.GetWriter() << uiCompressionMode;
+  msg.GetWriter() << files.GetCount();
+
+  for (const ezString& sFile : files)
+  {
+    const ezUInt16 uiDataDirID = GetBestDataDir(sFile);
+    const FileCacheStatus& CacheStatus = m_MountedDataDirs[uiDataDirID].m_CacheStatus[sFile];
+
+    msg.GetWriter() << uiDataDirID;
+    msg.GetWriter() << sFile;
+    msg.GetWriter() << CacheStatus.m_TimeStamp;
+    msg.GetWriter() << CacheStatus.m_FileHash;
+  }
+
+  m_Network->Send(ezRemoteTransmitMode::Reliable, msg);
+}
+
+bool ezFileserveClient::ServerSupportsPrefetching(bool bWaitForServer)
+{
+  EZ_LOCK(m_Mutex);
+
+  while (!m_bServerProtocolVersionKnown)
+  {
+    if (ezTime::Now() - m_HandshakeStartTime > s_HandshakeTimeout)
+    {
+      // older servers ignore the handshake, if the answer still arrives, the version is updated
+      m_bServerProtocolVersionKnown = true;
+      break;
+    }
+
+    if (!bWaitForServer || !m_Network->IsConnectedToServer())
+      return false;
+
+    m_Network->UpdateRemoteInterface();
+    m_Network->ExecuteAllMessageHandlers();
+  }
+
+  return m_uiServerProtocolVersion >= 1;
+}
+
+ezUInt16 ezFileserveClient::GetBestDataDir(const char* szFile)
+{
+  EZ_LOCK(m_Mutex);
+
+  bool bCachedYet = false;
+  auto itFileDataDir = m_FileDataDir.FindOrAdd(szFile, &bCachedYet);
+  if (!bCachedYet)
+  {
+    FillFileStatusCache(szFile);
+  }
+
+  return itFileDataDir.Value();
+}
+
+bool ezFileserveClient::IsConfirmedUntilReload(const char* szFile) const
+{
+  EZ_LOCK(m_Mutex);
+
+  auto itFileDataDir = m_FileDataDir.Find(szFile);
+  if (!itFileDataDir.IsValid())
+    return false;
+
+  auto itStatus = m_MountedDataDirs[itFileDataDir.Value()].m_CacheStatus.Find(szFile);
+  return itStatus.IsValid() && itStatus.Value().m_uiConfirmedEpoch == m_uiCacheEpoch;
+}
+
+void ezFileserveClient::QueuePrefetch(const char* szFile)
+{
+  // only locks the queue, so that this never waits for a download that is in progress on another thread
+  EZ_LOCK(m_PrefetchQueueMutex);
+
+  if (m_QueuedPrefetches.Contains(szFile))
+    return;
+
+  m_QueuedPrefetches.Insert(szFile);
+  m_PrefetchQueue.PushBack(szFile);
+}
+
+void ezFileserveClient::SendQueuedPrefetches()
+{
+  EZ_LOCK(m_Mutex);
+
+  if (m_bDownloading || m_MountedDataDirs.IsEmpty())
+    return;
+
+  if (!ServerSupportsPrefetching(false))
+  {
+    if (m_bServerProtocolVersionKnown)
+    {
+      // the files are requested one by one when they are read
+      EZ_LOCK(m_PrefetchQueueMutex);
+      m_PrefetchQueue.Clear();
+      m_QueuedPrefetches.Clear();
+    }
+
+    return;
+  }
+
+  ezDynamicArray<ezString> files;
+
+  {
+    EZ_LOCK(m_PrefetchQueueMutex);
+
+    const ezUInt32 uiMaxBatches = s_uiMaxPrefetchBatchesInFlight - ezMath::Min(m_PrefetchBatches.GetCount(), s_uiMaxPrefetchBatchesInFlight);
+
+    while (!m_PrefetchQueue.IsEmpty() && files.GetCount() < uiMaxBatches * s_uiFilesPerPrefetchBatch)
+    {
+      ezString sFile = m_PrefetchQueue.PeekFront();
+      m_PrefetchQueue.PopFront();
+
+      if (IsConfirmedUntilReload(sFile))
+      {
+        m_QueuedPrefetches.Remove(sFile);
+        continue;
+      }
+
+      files.PushBack(std::move(sFile));
+    }
+  }
+
+  for (ezUInt32 uiNextFile = 0; uiNextFile < files.GetCount(); uiNextFile += s_uiFilesPerPrefetchBatch)
+  {
+    SendPrefetchBatch(files.GetArrayPtr().GetSubArray(uiNextFile, ezMath::Min(s_uiFilesPerPrefetchBatch, files.GetCount() - uiNextFile)));
+  }
+}
+
+void ezFileserveClient::AbortPrefetches()
+{
+  EZ_LOCK(m_Mutex);
+  m_PrefetchBatches.Clear();
+
+  EZ_LOCK(m_PrefetchQueueMutex);
+  m_PrefetchQueue.Clear();
+  m_QueuedPrefetches.Clear();
+}
+
+void ezFileserveClient::HandlePrefetchDataMsg(ezRemoteMessage& msg)
+{
+  EZ_LOCK(m_Mutex);
+
+  PrefetchBatch* pBatch = nullptr;
+  {
+    ezUuid batchGuid;
+    msg.GetReader() >> batchGuid;
+
+    if (!m_PrefetchBatches.TryGetValue(batchGuid, pBatch))
+    {
+      // ezLog::Debug("Fileserver is answering someone else");
+      return;
+    }
+  }
+
+  ezUInt32 uiFileIdx = 0;
+  msg.GetReader() >> uiFileIdx;
+
+  ezUInt32 uiPayloadSize = 0;
+  msg.GetReader() >> uiPayloadSize;
+
+  ezUInt32 uiChunkSize = 0;
+  msg.GetReader() >> uiChunkSize;
+
+  ezDynamicArray<ezUInt8>& payload = pBatch->m_Payloads[uiFileIdx];
+
+  // make sure we don't need to reallocate
+  payload.Reserve(uiPayloadSize);
+
+  const ezUInt32 uiStartPos = payload.GetCount();
+  payload.SetCountUninitialized(uiStartPos + uiChunkSize);
+  msg.GetReader().ReadBytes(&payload[uiStartPos], uiChunkSize);
+}
+
+void ezFileserveClient::HandlePrefetchManifestMsg(ezRemoteMessage& msg)
+{
+  EZ_LOCK(m_Mutex);
+
+  ezUuid batchGuid;
+  msg.GetReader() >> batchGuid;
+
+  PrefetchBatch* pBatch = nullptr;
+  if (!m_PrefetchBatches.TryGetValue(batchGuid, pBatch))
+  {
+    // ezLog::Debug("Fileserver is answering someone else");
+    return;
+  }
+
+  EZ_SCOPE_EXIT(m_PrefetchBatches.Remove(batchGuid));
+
+  {
+    // the files can be queued again, after a reload they are requested again
+    EZ_LOCK(m_PrefetchQueueMutex);
+    for (const ezString& sFile : pBatch->m_Files)
+    {
+      m_QueuedPrefetches.Remove(sFile);
+    }
+  }
+
+  ezUInt32 uiNumFiles = 0;
+  msg.GetReader() >> uiNumFiles;
+
+  if (uiNumFiles != pBatch->m_Files.GetCount())
+  {
+    ezLog::Error("Fileserve prefetch manifest contains {0} files, but {1} files were requested", uiNumFiles, pBatch->m_Files.GetCount());
+    return;
+  }
+
+  ezDynamicArray<ezUInt8> decompressed;
+
+  for (ezUInt32 uiFileIdx = 0; uiFileIdx < uiNumFiles; ++uiFileIdx)
+  {
+    ezFileserveFileState fileState;
+    {
+      ezInt8 iFileStatus = 0;
+      msg.GetReader() >> iFileStatus;
+      fileState = (ezFileserveFileState)iFileStatus;
+    }
+
+    ezInt64 iFileTimeStamp = 0;
+    msg.GetReader() >> iFileTimeStamp;
+
+    ezUInt64 uiFileHash = 0;
+    msg.GetReader() >> uiFileHash;
+
+    ezUInt16 uiFoundInDataDir = 0;
+    msg.GetReader() >> uiFoundInDataDir;
+
+    ezUInt8 uiCompressionMode = 0;
+    msg.GetReader() >> uiCompressionMode;
+
+    const ezString& sFile = pBatch->m_Files[uiFileIdx];
+
+    // empty files don't send any data
+    ezArrayPtr<const ezUInt8> content;
+
+    if (const ezDynamicArray<ezUInt8>* pPayload = pBatch->m_Payloads.GetValue(uiFileIdx))
+    {
+      content = *pPayload;
+
+      if (uiCompressionMode == 1)
+      {
+        if (ezCompressionUtils::Decompress(*pPayload, ezCompressionMethod::ZStd, decompressed).Failed())
+        {
+          // the cache status stays outdated, so the file will be requested again on access
+          ezLog::Error("Failed to decompress file '{0}' sent by fileserver", sFile);
+          continue;
+        }
+
+        content = decompressed;
+      }
+    }
+
+    UpdateFileCache(sFile, fileState, iFileTimeStamp, uiFileHash, uiFoundInDataDir, content, true);
+  }
+}
+
 void ezFileserveClient::DetermineCacheStatus(ezUInt16 uiDataDirID, const char* szFile, FileCacheStatus& out_Status) const
 {
   EZ_LOCK(m_Mutex);
@@ -2,8 +2,12 @@
 
 #include <FileservePlugin/FileservePluginDLL.h>
 
+#include <FileservePlugin/Fileserver/ClientContext.h>
 #include <Foundation/Communication/RemoteInterface.h>
 #include <Foundation/Configuration/Singleton.h>
+#include <Foundation/Containers/Deque.h>
+#include <Foundation/Containers/HashTable.h>
+#include <Foundation/Containers/Set.h>
 #include <Foundation/Types/UniquePtr.h>
 #include <Foundation/Types/Uuid.h>
 
@@ -79,6 +83,28 @@ public:
   /// \brief Adds an address that should be tried for connecting with the server.
   void AddServerAddressToTry(const char* szAddress);
 
+  /// \brief Transfers the given files into the local fileserve cache with as few round-trips as possible.
+  ///
+  /// The files are requested in batches and several batches are in flight at the same time.
+  /// The server answers every batch with a single manifest, which confirms all up-to-date cached files (known by hash) in bulk.
+  /// Only files that changed are transferred and their content is zstd compressed, if the build supports it.
+  /// Files are looked up in all mounted data directories, just like a regular file access does.
+  /// Prefetched files are considered up-to-date until the server sends the next 'reload resources' command,
+  /// so accessing them afterwards does not require another request to the server.
+  ///
+  /// Waits until all files have been transferred or the timeout is reached. A zero timeout means the call waits indefinitely.
+  /// If the server is too old to support prefetching, the files are requested one by one instead.
+  ezResult PrefetchFiles(const ezArrayPtr<const ezString>& files, ezTime timeout = ezTime::Seconds(60));
+
+  /// \brief Calls PrefetchFiles() with all files that are stored in the local cache of the mounted data directories.
+  ///
+  /// Should be called after all data directories have been mounted. This validates all files from previous runs at once,
+  /// instead of asking the server about every single file when it is accessed for the first time.
+  /// The cached files are tracked in an index file per data directory, so this does not require file system iterators.
+  /// Mounting a data directory already queues its cached files for validation in the background, during UpdateClient().
+  /// This function is for applications that want to wait until all of them are validated.
+  ezResult PrefetchCachedFiles(ezTime timeout = ezTime::Seconds(60));
+
 private:
   friend class ezDataDirectory::FileserveType;
 
@@ -90,6 +116,7 @@ private:
     ezInt64 m_TimeStamp = 0;
     ezUInt64 m_FileHash = 0;
     ezTime m_LastCheck;
+    ezUInt32 m_uiConfirmedEpoch = 0; ///< If this equals m_uiCacheEpoch, the file was prefetched and is known to be up-to-date.
   };
 
   struct DataDir
@@ -100,6 +127,13 @@ private:
     bool m_bMounted = false;
 
     ezMap<ezString, FileCacheStatus> m_CacheStatus;
+    ezSet<ezString> m_CachedFiles; ///< All files that are stored in the local cache for this data directory
+  };
+
+  struct PrefetchBatch
+  {
+    ezDynamicArray<ezString> m_Files;
+    ezHashTable<ezUInt32, ezDynamicArray<ezUInt8>> m_Payloads; ///< The (compressed) content of changed files, by index into m_Files
   };
 
   void DeleteFile(ezUInt16 uiDataDir, const char* szFile);
@@ -108,11 +142,24 @@ private:
   static void ComputeDataDirMountPoint(const char* szDataDir, ezStringBuilder& out_sMountPoint);
   void BuildPathInCache(const char* szFile, const char* szMountPoint, ezStringBuilder* out_pAbsPath, ezStringBuilder* out_pFullPathMeta) const;
   void GetFullDataDirCachePath(const char* szDataDir, ezStringBuilder& out_sFullPath, ezStringBuilder& out_sFullPathMeta) const;
+  void LoadCacheIndex(DataDir& dd) const;
+  void SaveCacheIndex(const DataDir& dd) const;
   void NetworkMsgHandler(ezRemoteMessage& msg);
   void HandleFileTransferMsg(ezRemoteMessage& msg);
   void HandleFileTransferFinishedMsg(ezRemoteMessage& msg);
+  void HandlePrefetchDataMsg(ezRemoteMessage& msg);
+  void HandlePrefetchManifestMsg(ezRemoteMessage& msg);
+  void SendPrefetchBatch(const ezArrayPtr<const ezString>& files);
+  bool ServerSupportsPrefetching(bool bWaitForServer);
+  ezUInt16 GetBestDataDir(const char* szFile);
+  bool IsConfirmedUntilReload(const char* szFile) const;
+  void QueuePrefetch(const char* szFile);
+  void SendQueuedPrefetches();
+  void AbortPrefetches();
+  void UpdateFileCache(const char* szFile, ezFileserveFileState fileState, ezInt64 iFileTimeStamp, ezUInt64 uiFileHash, ezUInt16 uiFoundInDataDir,
+    ezArrayPtr<const ezUInt8> content, bool bConfirmUntilReload);
   static void WriteMetaFile(ezStringBuilder sCachedMetaFile, ezInt64 iFileTimeStamp, ezUInt64 uiFileHash);
-  void WriteDownloadToDisk(ezStringBuilder sCachedFile);
+  void WriteDownloadToDisk(ezStringBuilder sCachedFile, ezArrayPtr<const ezUInt8> content);
   ezResult DownloadFile(ezUInt16 uiDataDirID, const char* szFile, bool bForceThisDataDir, ezStringBuilder* out_pFullPath);
   void DetermineCacheStatus(ezUInt16 uiDataDirID, const char* szFile, FileCacheStatus& out_Status) const;
   void UploadFile(ezUInt16 uiDataDirID, const char* szFile, const ezDynamicArray<ezUInt8>& fileContent);
@@ -136,6 +183,16 @@ private:
   ezDynamicArray<ezUInt8> m_Download;
   ezTime m_CurrentTime;
   ezHybridArray<ezString, 4> m_TryServerAddresses;
+  ezHashTable<ezUuid, PrefetchBatch> m_PrefetchBatches;
+  ezUInt32 m_uiCacheEpoch = 1; ///< Incremented whenever the server requests a resource reload, which invalidates all prefetched files
+  ezUInt16 m_uiServerProtocolVersion = 0;
+  bool m_bServerProtocolVersionKnown = false;
+  ezTime m_HandshakeStartTime;
+
+  // files that ezDataDirectory::FileserveType::PrefetchFile() queued from any thread, they are requested during UpdateClient()
+  ezMutex m_PrefetchQueueMutex;
+  ezDeque<ezString> m_PrefetchQueue;
+  ezSet<ezString> m_QueuedPrefetches; ///< The files in m_PrefetchQueue and in the batches that were sent for them
 
   ezMap<ezString, ezUInt16> m_FileDataDir;
   ezHybridArray<DataDir, 8> m_MountedDataDirs;
@@ -122,6 +122,46 @@ bool ezDataDirectory::FileserveType::ExistsFile(const char* szFile, bool bOneSpe
   return ezFileserveClient::GetSingleton()->DownloadFile(m_uiDataDirID, sRedirected, bOneSpecificDataDir, nullptr).Succeeded();
 }
 
+bool ezDataDirectory::FileserveType::LocateFile(const char* szFile, bool bOneSpecificDataDir, ezStringBuilder& out_sOSFilePath)
+{
+  out_sOSFilePath.Clear();
+
+  ezStringBuilder sRedirected;
+  if (ResolveAssetRedirection(szFile, sRedirected))
+    bOneSpecificDataDir = true; // If this data dir can resolve the guid, only this should load it as well.
+
+  // we know that the server cannot resolve asset GUIDs, so don't even ask
+  if (ezConversionUtils::IsStringUuid(sRedirected))
+    return false;
+
+  // once downloaded, the file is a regular file in the local cache
+  if (ezFileserveClient::GetSingleton()->DownloadFile(m_uiDataDirID, sRedirected, bOneSpecificDataDir, &out_sOSFilePath).Failed())
+  {
+    out_sOSFilePath.Clear();
+    return false;
+  }
+
+  return true;
+}
+
+bool ezDataDirectory::FileserveType::PrefetchFile(const char* szFile, bool bOneSpecificDataDir)
+{
+  // fileserve cannot handle absolute paths
+  if (ezPathUtils::IsAbsolutePath(szFile) || ezFileserveClient::GetSingleton() == nullptr)
+    return false;
+
+  ezStringBuilder sRedirected;
+  ResolveAssetRedirection(szFile, sRedirected);
+
+  // we know that the server cannot resolve asset GUIDs, so don't even ask
+  if (ezConversionUtils::IsStringUuid(sRedirected))
+    return false;
+
+  // the server looks the file up in all data directories, so the lower ones don't need to do anything
+  ezFileserveClient::GetSingleton()->QueuePrefetch(sRedirected);
+  return true;
+}
+
 ezDataDirectoryType* ezDataDirectory::FileserveType::Factory(
   const char* szDataDirectory, const char* szGroup, const char* szRootName, ezFileSystem::DataDirUsage Usage)
 {
@@ -46,6 +46,9 @@ namespace ezDataDirectory
     virtual void RemoveDataDirectory() override;
     virtual void DeleteFile(const char* szFile) override;
     virtual bool ExistsFile(const char* szFile, bool bOneSpecificDataDir) override;
+    virtual bool LocateFile(const char* szFile, bool bOneSpecificDataDir, ezStringBuilder& out_sOSFilePath) override;
+    /// \brief Queues the file to be transferred in the next prefetch batch, see ezFileserveClient::PrefetchFiles().
+    virtual bool PrefetchFile(const char* szFile, bool bOneSpecificDataDir) override;
     /// \brief Limitation: Fileserve does not handle folders, only files. If someone stats a folder, this will fail.
     virtual ezResult GetFileStats(const char* szFileOrFolder, bool bOneSpecificDataDir, ezFileStats& out_Stats) override;
     virtual FolderReader* CreateFolderReader() const override;
@@ -14,6 +14,11 @@ enum class ezFileserveFileState
   Different = 5,
 };
 
+/// \brief The version of the fileserve protocol, which the client sends with 'HELO' and the server answers with 'VERS'.
+///
+/// Version 1 added batched prefetching ('PREF'). Older servers don't answer 'HELO' at all and only support single file requests.
+constexpr ezUInt16 ezFileserveProtocolVersion = 1;
+
 class EZ_FILESERVEPLUGIN_DLL ezFileserveClientContext
 {
 public:
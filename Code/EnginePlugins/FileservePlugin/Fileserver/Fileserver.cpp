@@ -6,6 +6,7 @@
 #include <Foundation/Communication/RemoteInterfaceEnet.h>
 #include <Foundation/IO/FileSystem/FileReader.h>
 #include <Foundation/Utilities/CommandLineUtils.h>
+#include <Foundation/Utilities/Compression.h>
 
 EZ_IMPLEMENT_SINGLETON(ezFileserver);
 
@@ -83,7 +84,17 @@ void ezFileserver::NetworkMsgHandler(ezRemoteMessage& msg)
   auto& client = DetermineClient(msg);
 
   if (msg.GetMessageID() == 'HELO')
+  {
+    // older clients send an empty 'HELO' and don't know about protocol versions
+    if (msg.GetMessageSize() > 0)
+    {
+      ezRemoteMessage ret('FSRV', 'VERS');
+      ret.GetWriter() << ezFileserveProtocolVersion;
+      m_Network->Send(ezRemoteTransmitMode::Reliable, ret);
+    }
+
     return;
+  }
 
   if (msg.GetMessageID() == 'RUTR')
   {
@@ -102,6 +113,12 @@ void ezFileserver::NetworkMsgHandler(ezRemoteMessage& msg)
     return;
   }
 
+  if (msg.GetMessageID() == 'PREF')
+  {
+    HandlePrefetchRequest(client, msg);
+    return;
+  }
+
   if (msg.GetMessageID() == 'UPLH')
   {
     HandleUploadFileHeader(client, msg);
@@ -334,6 +351,111 @@ void ezFileserver::HandleFileRequest(ezFileserveClientContext& client, ezRemoteM
   }
 }
 
+void ezFileserver::HandlePrefetchRequest(ezFileserveClientContext& client, ezRemoteMessage& msg)
+{
+  ezUuid batchGuid;
+  msg.GetReader() >> batchGuid;
+
+  ezUInt8 uiClientCompressionMode = 0;
+  msg.GetReader() >> uiClientCompressionMode;
+
+  ezUInt32 uiNumFiles = 0;
+  msg.GetReader() >> uiNumFiles;
+
+  // the state of all requested files is sent back in one message, after the content of all changed files
+  ezRemoteMessage manifest('FSRV', 'PMAN');
+  manifest.GetWriter() << batchGuid;
+  manifest.GetWriter() << uiNumFiles;
+
+  ezStringBuilder sRequestedFile;
+
+  ezFileserverEvent e;
+  e.m_uiClientID = client.m_uiApplicationID;
+
+  for (ezUInt32 uiFileIdx = 0; uiFileIdx < uiNumFiles; ++uiFileIdx)
+  {
+    ezUInt16 uiDataDirID = 0;
+    msg.GetReader() >> uiDataDirID;
+    msg.GetReader() >> sRequestedFile;
+
+    ezFileserveClientContext::FileStatus status;
+    msg.GetReader() >> status.m_iTimestamp;
+    msg.GetReader() >> status.m_uiHash;
+
+    const ezFileserveFileState filestate = client.GetFileStatus(uiDataDirID, sRequestedFile, status, m_SendToClient, false);
+
+    e.m_szPath = sRequestedFile;
+    e.m_uiSentTotal = 0;
+
+    {
+      e.m_Type = ezFileserverEvent::Type::FileDownloadRequest;
+      e.m_uiSizeTotal = m_SendToClient.GetCount();
+      e.m_FileState = filestate;
+      m_Events.Broadcast(e);
+    }
+
+    ezUInt8 uiCompressionMode = 0;
+
+    if (filestate == ezFileserveFileState::Different)
+    {
+      ezArrayPtr<const ezUInt8> payload = m_SendToClient;
+
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+      // only send compressed data, if it is actually smaller
+      if (uiClientCompressionMode == 1 &&
+          ezCompressionUtils::Compress(m_SendToClient, ezCompressionMethod::ZStd, m_CompressedSendToClient).Succeeded() &&
+          m_CompressedSendToClient.GetCount() < m_SendToClient.GetCount())
+      {
+        uiCompressionMode = 1;
+        payload = m_CompressedSendToClient;
+      }
+#endif
+
+      const ezUInt32 uiPayloadSize = payload.GetCount();
+      ezUInt32 uiNextByte = 0;
+
+      // send the file over in multiple packages of 64KB each
+      // empty files are only reported in the manifest
+      while (uiNextByte < uiPayloadSize)
+      {
+        const ezUInt32 uiChunkSize = ezMath::Min<ezUInt32>(64 * 1024, uiPayloadSize - uiNextByte);
+
+        ezRemoteMessage ret('FSRV', 'PDAT');
+        ret.GetWriter() << batchGuid;
+        ret.GetWriter() << uiFileIdx;
+        ret.GetWriter() << uiPayloadSize;
+        ret.GetWriter() << uiChunkSize;
+        ret.GetWriter().WriteBytes(&payload[uiNextByte], uiChunkSize);
+
+        m_Network->Send(ezRemoteTransmitMode::Reliable, ret);
+
+        uiNextByte += uiChunkSize;
+      }
+
+      // reuse previous values
+      {
+        e.m_Type = ezFileserverEvent::Type::FileDownloading;
+        e.m_uiSentTotal = m_SendToClient.GetCount();
+        m_Events.Broadcast(e);
+      }
+    }
+
+    manifest.GetWriter() << (ezInt8)filestate;
+    manifest.GetWriter() << status.m_iTimestamp;
+    manifest.GetWriter() << status.m_uiHash;
+    manifest.GetWriter() << uiDataDirID;
+    manifest.GetWriter() << uiCompressionMode;
+
+    // reuse previous values
+    {
+      e.m_Type = ezFileserverEvent::Type::FileDownloadFinished;
+      m_Events.Broadcast(e);
+    }
+  }
+
+  m_Network->Send(ezRemoteTransmitMode::Reliable, manifest);
+}
+
 void ezFileserver::HandleDeleteFileRequest(ezFileserveClientContext& client, ezRemoteMessage& msg)
 {
   ezUInt16 uiDataDirID = 0xffff;
@@ -96,6 +96,7 @@ private:
   void HandleMountRequest(ezFileserveClientContext& client, ezRemoteMessage& msg);
   void HandleUnmountRequest(ezFileserveClientContext& client, ezRemoteMessage& msg);
   void HandleFileRequest(ezFileserveClientContext& client, ezRemoteMessage& msg);
+  void HandlePrefetchRequest(ezFileserveClientContext& client, ezRemoteMessage& msg);
   void HandleDeleteFileRequest(ezFileserveClientContext& client, ezRemoteMessage& msg);
   void HandleUploadFileHeader(ezFileserveClientContext& client, ezRemoteMessage& msg);
   void HandleUploadFileTransfer(ezFileserveClientContext& client, ezRemoteMessage& msg);
@@ -104,6 +105,7 @@ private:
   ezHashTable<ezUInt32, ezFileserveClientContext> m_Clients;
   ezUniquePtr<ezRemoteInterface> m_Network;
   ezDynamicArray<ezUInt8> m_SendToClient;   // ie. 'downloads' from server to client
+  ezDynamicArray<ezUInt8> m_CompressedSendToClient;
   ezDynamicArray<ezUInt8> m_SentFromClient; // ie. 'uploads' from client to server
   ezStringBuilder m_sCurFileUpload;
   ezUuid m_FileUploadGuid;
@@ -93,6 +93,13 @@ void SetAppStats()
 #endif
   ezStats::SetStat("Features/Allocation Stack Tracing", sOut.GetData());
 
+#if EZ_ENABLED(EZ_USE_ALLOCATION_SAMPLING)
+  sOut = "Enabled";
+#else
+  sOut = "Disabled";
+#endif
+  ezStats::SetStat("Features/Allocation Sampling", sOut.GetData());
+
 #if EZ_ENABLED(EZ_PLATFORM_LITTLE_ENDIAN)
   sOut = "Little";
 #else
@@ -46,22 +46,29 @@ void ezRcAgentComponent::DeserializeComponent(ezWorldReader& stream)
   s >> m_fWalkSpeed;
 }
 
+void ezRcAgentComponent::Deinitialize()
+{
+  // the world module must not call back into this component anymore
+  CancelPathRequest();
+
+  SUPER::Deinitialize();
+}
+
 ezResult ezRcAgentComponent::InitializeRecast()
 {
   if (m_bRecastInitialized)
     return EZ_SUCCESS;
 
-  const dtNavMesh* pNavMesh = GetWorld()->GetOrCreateModule<ezRecastWorldModule>()->GetDetourNavMesh();
-  if (pNavMesh == nullptr)
+  dtNavMeshQuery* pQuery = GetWorld()->GetOrCreateModule<ezRecastWorldModule>()->GetNavMeshQuery();
+  if (pQuery == nullptr)
     return EZ_FAILURE;
 
   m_bRecastInitialized = true;
 
-  m_pQuery = EZ_DEFAULT_NEW(dtNavMeshQuery);
+  m_pQuery = pQuery;
   m_pCorridor = EZ_DEFAULT_NEW(dtPathCorridor);
 
   /// \todo Hard-coded limits
-  m_pQuery->init(pNavMesh, 512);
   m_pCorridor->init(256);
 
   return EZ_SUCCESS;
@@ -73,7 +80,7 @@ void ezRcAgentComponent::UninitializeRecast()
     return;
 
   m_bRecastInitialized = false;
-  m_pQuery.Clear();
+  m_pQuery = nullptr;
   m_pCorridor.Clear();
 
   if (m_PathToTargetState != ezAgentPathFindingState::HasNoTarget)
@@ -84,6 +91,8 @@ void ezRcAgentComponent::UninitializeRecast()
 
 void ezRcAgentComponent::ClearTargetPosition()
 {
+  CancelPathRequest();
+
   m_iNumNextSteps = 0;
   m_iFirstNextStep = 0;
   m_PathCorridor.Clear();
@@ -122,66 +131,35 @@ ezVec3 ezRcAgentComponent::GetTargetPosition() const
 ezResult ezRcAgentComponent::FindNavMeshPolyAt(const ezVec3& vPosition, dtPolyRef& out_PolyRef, ezVec3* out_vAdjustedPosition /*= nullptr*/,
   float fPlaneEpsilon /*= 0.01f*/, float fHeightEpsilon /*= 1.0f*/) const
 {
-  ezRcPos rcPos = vPosition;
-  ezVec3 vSize(fPlaneEpsilon, fHeightEpsilon, fPlaneEpsilon);
-
-  ezRcPos resultPos;
-  dtQueryFilter filter; /// \todo Hard-coded filter
-  if (dtStatusFailed(m_pQuery->findNearestPoly(rcPos, &vSize.x, &m_QueryFilter, &out_PolyRef, resultPos)))
-    return EZ_FAILURE;
-
-  if (!ezMath::IsEqual(vPosition.x, resultPos.m_Pos[0], fPlaneEpsilon) || !ezMath::IsEqual(vPosition.y, resultPos.m_Pos[2], fPlaneEpsilon) ||
-      !ezMath::IsEqual(vPosition.z, resultPos.m_Pos[1], fHeightEpsilon))
-    return EZ_FAILURE;
-
-  if (out_vAdjustedPosition != nullptr)
-  {
-    *out_vAdjustedPosition = resultPos;
-  }
-
-  return EZ_SUCCESS;
+  return ezRecastWorldModule::FindNavMeshPolyAt(
+    *m_pQuery, m_QueryFilter, vPosition, out_PolyRef, out_vAdjustedPosition, fPlaneEpsilon, fHeightEpsilon);
 }
 
-ezResult ezRcAgentComponent::ComputePathCorridor(dtPolyRef startPoly, dtPolyRef endPoly, bool& bFoundPartialPath)
+void ezRcAgentComponent::RequestPathToTarget()
 {
-  bFoundPartialPath = false;
-
-  ezRcPos rcStart = m_vCurrentPositionOnNavmesh;
-  ezRcPos rcEnd = m_vTargetPosition;
-
-  ezInt32 iPathCorridorLength = 0;
-
-  // make enough room
-  m_PathCorridor.SetCountUninitialized(256);
-  if (dtStatusFailed(m_pQuery->findPath(
-        startPoly, endPoly, rcStart, rcEnd, &m_QueryFilter, m_PathCorridor.GetData(), &iPathCorridorLength, (int)m_PathCorridor.GetCount())) ||
-      iPathCorridorLength <= 0)
-  {
-    m_PathCorridor.Clear();
-    return EZ_FAILURE;
-  }
-
-  // reduce to actual length
-  m_PathCorridor.SetCountUninitialized(iPathCorridorLength);
-
-  if (m_PathCorridor[iPathCorridorLength - 1] != endPoly)
-  {
-    // if this is the case, the target position cannot be reached, but we can walk close to it
-    bFoundPartialPath = true;
-  }
+  ezRecastWorldModule* pModule = static_cast<ezRcAgentComponentManager*>(GetOwningManager())->GetRecastWorldModule();
+  m_uiPathQueryID =
+    pModule->RequestPath(GetOwner()->GetGlobalPosition(), m_vTargetPosition, ezMakeDelegate(&ezRcAgentComponent::OnPathQueryFinished, this));
+}
 
-  m_pCorridor->reset(startPoly, rcStart);
-  m_pCorridor->setCorridor(rcEnd, m_PathCorridor.GetData(), iPathCorridorLength);
+void ezRcAgentComponent::CancelPathRequest()
+{
+  if (m_uiPathQueryID == 0)
+    return;
 
-  return EZ_SUCCESS;
+  static_cast<ezRcAgentComponentManager*>(GetOwningManager())->GetRecastWorldModule()->CancelPathQuery(m_uiPathQueryID);
+  m_uiPathQueryID = 0;
 }
 
-ezResult ezRcAgentComponent::ComputePathToTarget()
+void ezRcAgentComponent::OnPathQueryFinished(ezRecastPathQueryResult& result)
 {
-  const ezVec3 vStartPos = GetOwner()->GetGlobalPosition();
+  m_uiPathQueryID = 0;
+
+  // the navmesh may have been unloaded in the meantime
+  if (!m_bRecastInitialized)
+    return;
 
-  dtPolyRef startPoly;
-  if (FindNavMeshPolyAt(vStartPos, startPoly, &m_vCurrentPositionOnNavmesh).Failed())
+  if (result.m_Status == ezRecastPathQueryStatus::StartOutsideNavMesh)
   {
     m_PathToTargetState = ezAgentPathFindingState::HasTargetPathFindingFailed;
 
@@ -189,11 +167,10 @@ ezResult ezRcAgentComponent::ComputePathToTarget()
     e.m_pComponent = this;
     e.m_Type = ezAgentSteeringEvent::ErrorOutsideNavArea;
     m_SteeringEvents.Broadcast(e);
-    return EZ_FAILURE;
+    return;
   }
 
-  dtPolyRef endPoly;
-  if (FindNavMeshPolyAt(m_vTargetPosition, endPoly).Failed())
+  if (result.m_Status == ezRecastPathQueryStatus::TargetOutsideNavMesh)
   {
     m_PathToTargetState = ezAgentPathFindingState::HasTargetPathFindingFailed;
 
@@ -201,13 +178,12 @@ ezResult ezRcAgentComponent::ComputePathToTarget()
     e.m_pComponent = this;
     e.m_Type = ezAgentSteeringEvent::ErrorInvalidTargetPosition;
     m_SteeringEvents.Broadcast(e);
-    return EZ_FAILURE;
+    return;
   }
 
   /// \todo Optimize case when endPoly is same as previously ?
 
-  bool bFoundPartialPath = false;
-  if (ComputePathCorridor(startPoly, endPoly, bFoundPartialPath).Failed() || bFoundPartialPath)
+  if (result.m_Status != ezRecastPathQueryStatus::Success)
   {
     m_PathToTargetState = ezAgentPathFindingState::HasTargetPathFindingFailed;
 
@@ -215,18 +191,28 @@ ezResult ezRcAgentComponent::ComputePathToTarget()
 
     ezAgentSteeringEvent e;
     e.m_pComponent = this;
-    e.m_Type = bFoundPartialPath ? ezAgentSteeringEvent::WarningNoFullPathToTarget : ezAgentSteeringEvent::ErrorNoPathToTarget;
+    e.m_Type = (result.m_Status == ezRecastPathQueryStatus::PartialPath) ? ezAgentSteeringEvent::WarningNoFullPathToTarget
+                                                                          : ezAgentSteeringEvent::ErrorNoPathToTarget;
     m_SteeringEvents.Broadcast(e);
-    return EZ_FAILURE;
+    return;
   }
 
+  m_vCurrentPositionOnNavmesh = result.m_vStartPosition;
+  m_PathCorridor = std::move(result.m_PathCorridor);
+
+  ezRcPos rcStart = m_vCurrentPositionOnNavmesh;
+  ezRcPos rcEnd = m_vTargetPosition;
+  m_pCorridor->reset(m_PathCorridor[0], rcStart);
+  m_pCorridor->setCorridor(rcEnd, m_PathCorridor.GetData(), (int)m_PathCorridor.GetCount());
+
   m_PathToTargetState = ezAgentPathFindingState::HasTargetAndValidPath;
 
+  PlanNextSteps();
+
   ezAgentSteeringEvent e;
   e.m_pComponent = this;
   e.m_Type = ezAgentSteeringEvent::PathToTargetFound;
   m_SteeringEvents.Broadcast(e);
-  return EZ_SUCCESS;
 }
 
 bool ezRcAgentComponent::HasReachedPosition(const ezVec3& pos, float fMaxDistance) const
@@ -267,7 +253,7 @@ void ezRcAgentComponent::PlanNextSteps()
   dtPolyRef stepPolys[16];
 
   m_iFirstNextStep = 0;
-  m_iNumNextSteps = m_pCorridor->findCorners(&m_vNextSteps[0].x, stepFlags, stepPolys, 4, m_pQuery.Borrow(), &m_QueryFilter);
+  m_iNumNextSteps = m_pCorridor->findCorners(&m_vNextSteps[0].x, stepFlags, stepPolys, 4, m_pQuery, &m_QueryFilter);
 
   // convert from Recast convention (Y up) to ez (Z up)
   for (ezInt32 i = 0; i < m_iNumNextSteps; ++i)
@@ -343,7 +329,7 @@ void ezRcAgentComponent::SyncSteeringWithReality()
 {
   const ezRcPos rcCurrentAgentPosition = GetOwner()->GetGlobalPosition();
 
-  if (!m_pCorridor->movePosition(rcCurrentAgentPosition, m_pQuery.Borrow(), &m_QueryFilter))
+  if (!m_pCorridor->movePosition(rcCurrentAgentPosition, m_pQuery, &m_QueryFilter))
   {
     ezAgentSteeringEvent e;
     e.m_pComponent = this;
@@ -373,13 +359,13 @@ void ezRcAgentComponent::Update()
     VisualizeTargetPosition();
   }
 
-  // target is set, but no path is computed yet
+  // target is set, but no path is computed yet, the result is delivered by the world module later
   if (GetPathToTargetState() == ezAgentPathFindingState::HasTargetWaitingForPath)
   {
-    if (ComputePathToTarget().Failed())
-      return;
+    if (m_uiPathQueryID == 0)
+      RequestPathToTarget();
 
-    PlanNextSteps();
+    return;
   }
 
   // from here on down, everything has to do with following a valid path
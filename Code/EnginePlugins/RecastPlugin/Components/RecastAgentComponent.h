@@ -10,6 +10,7 @@
 #include <RecastPlugin/RecastPluginDLL.h>
 
 class ezRecastWorldModule;
+struct ezRecastPathQueryResult;
 class ezPhysicsWorldModuleInterface;
 struct ezResourceEvent;
 
@@ -48,6 +49,7 @@ class EZ_RECASTPLUGIN_DLL ezRcAgentComponent : public ezAgentSteeringComponent
 protected:
   virtual void SerializeComponent(ezWorldWriter& stream) const override;
   virtual void DeserializeComponent(ezWorldReader& stream) override;
+  virtual void Deinitialize() override;
 
   //////////////////////////////////////////////////////////////////////////
   // ezAgentSteeringComponent
@@ -84,8 +86,9 @@ private:
   // Path Finding and Steering
 
 private:
-  ezResult ComputePathToTarget();
-  ezResult ComputePathCorridor(dtPolyRef startPoly, dtPolyRef endPoly, bool& bFoundPartialPath);
+  void RequestPathToTarget();
+  void CancelPathRequest();
+  void OnPathQueryFinished(ezRecastPathQueryResult& result);
   void ComputeSteeringDirection(float fMaxDistance);
   void ApplySteering(const ezVec3& vDirection, float fSpeed);
   void SyncSteeringWithReality();
@@ -94,7 +97,8 @@ private:
   ezVec3 m_vTargetPosition;
   ezEnum<ezAgentPathFindingState> m_PathToTargetState;
   ezVec3 m_vCurrentPositionOnNavmesh;      /// \todo ??? keep update ?
-  ezUniquePtr<dtNavMeshQuery> m_pQuery;    // careful, dtNavMeshQuery is not moveble
+  ezUInt32 m_uiPathQueryID = 0;            // the pending request at the ezRecastWorldModule, zero if none
+  dtNavMeshQuery* m_pQuery = nullptr;      // owned by the ezRecastWorldModule
   ezUniquePtr<dtPathCorridor> m_pCorridor; // careful, dtPathCorridor is not moveble
   dtQueryFilter m_QueryFilter;             /// \todo hard-coded filter
   ezDynamicArray<dtPolyRef> m_PathCorridor;
@@ -132,71 +132,86 @@ void ezRcNavMeshComponent::VisualizeNavMesh()
   if (pNavMesh.GetAcquireResult() != ezResourceAcquireResult::Final)
     return;
 
-  const auto* pMesh = pNavMesh->GetNavMeshPolygons();
+  ezUInt32 uiNumPolys = 0;
+  for (const ezRecastNavMeshTile& tile : pNavMesh->GetTiles())
+  {
+    if (tile.m_pPolygons != nullptr)
+    {
+      uiNumPolys += tile.m_pPolygons->npolys;
+    }
+  }
 
-  if (pMesh == nullptr)
+  if (uiNumPolys == 0)
     return;
 
   ezDynamicArray<ezDebugRenderer::Triangle> triangles;
-  triangles.Reserve(pMesh->npolys * 3);
+  triangles.Reserve(uiNumPolys * 3);
 
   ezDynamicArray<ezDebugRenderer::Line> contourLines;
-  contourLines.Reserve(pMesh->npolys * 2);
+  contourLines.Reserve(uiNumPolys * 2);
   ezDynamicArray<ezDebugRenderer::Line> innerLines;
-  innerLines.Reserve(pMesh->npolys * 3);
-
-  const ezInt32 iMaxNumVertInPoly = pMesh->nvp;
-  const float fCellSize = pMesh->cs;
-  const float fCellHeight = pMesh->ch;
-  // add a little height offset to move the visualization up a little
-  const ezVec3 vMeshOrigin(pMesh->bmin[0], pMesh->bmin[2], pMesh->bmin[1] + fCellHeight * 0.3f);
+  innerLines.Reserve(uiNumPolys * 3);
 
-  for (ezInt32 i = 0; i < pMesh->npolys; ++i)
+  for (const ezRecastNavMeshTile& tile : pNavMesh->GetTiles())
   {
-    const ezUInt16* polyVtxIndices = &pMesh->polys[i * (iMaxNumVertInPoly * 2)];
-    const ezUInt16* neighborData = &pMesh->polys[i * (iMaxNumVertInPoly * 2) + iMaxNumVertInPoly];
-
-    // const ezUInt8 areaType = pMesh->areas[i];
-    // if (areaType == RC_WALKABLE_AREA)
-    //  color = duRGBA(0, 192, 255, 64);
-    // else if (areaType == RC_NULL_AREA)
-    //  color = duRGBA(0, 0, 0, 64);
-    // else
-    //  color = dd->areaToCol(area);
-
-    ezInt32 j;
-    for (j = 1; j < iMaxNumVertInPoly; ++j)
+    const rcPolyMesh* pMesh = tile.m_pPolygons.Borrow();
+
+    if (pMesh == nullptr)
+      continue;
+
+    const ezInt32 iMaxNumVertInPoly = pMesh->nvp;
+    const float fCellSize = pMesh->cs;
+    const float fCellHeight = pMesh->ch;
+    // add a little height offset to move the visualization up a little
+    const ezVec3 vMeshOrigin(pMesh->bmin[0], pMesh->bmin[2], pMesh->bmin[1] + fCellHeight * 0.3f);
+
+    for (ezInt32 i = 0; i < pMesh->npolys; ++i)
     {
-      if (polyVtxIndices[j] == RC_MESH_NULL_IDX)
-        break;
+      const ezUInt16* polyVtxIndices = &pMesh->polys[i * (iMaxNumVertInPoly * 2)];
+      const ezUInt16* neighborData = &pMesh->polys[i * (iMaxNumVertInPoly * 2) + iMaxNumVertInPoly];
+
+      // const ezUInt8 areaType = pMesh->areas[i];
+      // if (areaType == RC_WALKABLE_AREA)
+      //  color = duRGBA(0, 192, 255, 64);
+      // else if (areaType == RC_NULL_AREA)
+      //  color = duRGBA(0, 0, 0, 64);
+      // else
+      //  color = dd->areaToCol(area);
+
+      ezInt32 j;
+      for (j = 1; j < iMaxNumVertInPoly; ++j)
+      {
+        if (polyVtxIndices[j] == RC_MESH_NULL_IDX)
+          break;
 
-      const bool bIsContour = neighborData[j - 1] == 0xffff;
+        const bool bIsContour = neighborData[j - 1] == 0xffff;
 
+        {
+          auto& line = bIsContour ? contourLines.ExpandAndGetRef() : innerLines.ExpandAndGetRef();
+          line.m_start = GetNavMeshVertex(pMesh, polyVtxIndices[j - 1], vMeshOrigin, fCellSize, fCellHeight);
+          line.m_end = GetNavMeshVertex(pMesh, polyVtxIndices[j], vMeshOrigin, fCellSize, fCellHeight);
+        }
+      }
+
+      // close the loop
+      const bool bIsContour = neighborData[j - 1] == 0xffff;
       {
         auto& line = bIsContour ? contourLines.ExpandAndGetRef() : innerLines.ExpandAndGetRef();
         line.m_start = GetNavMeshVertex(pMesh, polyVtxIndices[j - 1], vMeshOrigin, fCellSize, fCellHeight);
-        line.m_end = GetNavMeshVertex(pMesh, polyVtxIndices[j], vMeshOrigin, fCellSize, fCellHeight);
+        line.m_end = GetNavMeshVertex(pMesh, polyVtxIndices[0], vMeshOrigin, fCellSize, fCellHeight);
       }
-    }
-
-    // close the loop
-    const bool bIsContour = neighborData[j - 1] == 0xffff;
-    {
-      auto& line = bIsContour ? contourLines.ExpandAndGetRef() : innerLines.ExpandAndGetRef();
-      line.m_start = GetNavMeshVertex(pMesh, polyVtxIndices[j - 1], vMeshOrigin, fCellSize, fCellHeight);
-      line.m_end = GetNavMeshVertex(pMesh, polyVtxIndices[0], vMeshOrigin, fCellSize, fCellHeight);
-    }
 
-    for (j = 2; j < iMaxNumVertInPoly; ++j)
-    {
-      if (polyVtxIndices[j] == RC_MESH_NULL_IDX)
-        break;
+      for (j = 2; j < iMaxNumVertInPoly; ++j)
+      {
+        if (polyVtxIndices[j] == RC_MESH_NULL_IDX)
+          break;
 
-      auto& triangle = triangles.ExpandAndGetRef();
+        auto& triangle = triangles.ExpandAndGetRef();
 
-      triangle.m_position[0] = GetNavMeshVertex(pMesh, polyVtxIndices[0], vMeshOrigin, fCellSize, fCellHeight);
-      triangle.m_position[2] = GetNavMeshVertex(pMesh, polyVtxIndices[j - 1], vMeshOrigin, fCellSize, fCellHeight);
-      triangle.m_position[1] = GetNavMeshVertex(pMesh, polyVtxIndices[j], vMeshOrigin, fCellSize, fCellHeight);
+        triangle.m_position[0] = GetNavMeshVertex(pMesh, polyVtxIndices[0], vMeshOrigin, fCellSize, fCellHeight);
+        triangle.m_position[2] = GetNavMeshVertex(pMesh, polyVtxIndices[j - 1], vMeshOrigin, fCellSize, fCellHeight);
+        triangle.m_position[1] = GetNavMeshVertex(pMesh, polyVtxIndices[j], vMeshOrigin, fCellSize, fCellHeight);
+      }
     }
   }
 
@@ -2,6 +2,9 @@
 
 #include <Core/Utils/WorldGeoExtractionUtil.h>
 #include <Core/World/World.h>
+#include <Foundation/Algorithm/HashingUtils.h>
+#include <Foundation/IO/MemoryStream.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <Foundation/Time/Stopwatch.h>
 #include <Foundation/Types/ScopeExit.h>
 #include <Foundation/Utilities/Progress.h>
@@ -28,6 +31,7 @@ EZ_BEGIN_STATIC_REFLECTED_TYPE(ezRecastConfig, ezNoBase, 1, ezRTTIDefaultAllocat
     EZ_MEMBER_PROPERTY("SampleErrorFactor", m_fDetailMeshSampleErrorFactor)->AddAttributes(new ezDefaultValueAttribute(1.0f)),
     EZ_MEMBER_PROPERTY("MaxSimplification", m_fMaxSimplificationError)->AddAttributes(new ezDefaultValueAttribute(1.3f)),
     EZ_MEMBER_PROPERTY("MaxEdgeLength", m_fMaxEdgeLength)->AddAttributes(new ezDefaultValueAttribute(4.0f)),
+    EZ_MEMBER_PROPERTY("TileSize", m_fTileSize)->AddAttributes(new ezDefaultValueAttribute(16.0f), new ezClampValueAttribute(1.0f, ezVariant())),
   }
   EZ_END_PROPERTIES;
 }
@@ -66,11 +70,11 @@ ezRecastNavMeshBuilder::~ezRecastNavMeshBuilder() = default;
 
 void ezRecastNavMeshBuilder::Clear()
 {
-  m_BoundingBox.SetInvalid();
   m_Vertices.Clear();
   m_Triangles.Clear();
   m_TriangleAreaIDs.Clear();
-  m_pRecastContext = nullptr;
+  m_Tiles.Clear();
+  m_uiNumRebuiltTiles = 0;
 }
 
 ezResult ezRecastNavMeshBuilder::ExtractWorldGeometry(const ezWorld& world, ezWorldGeoExtractionUtil::Geometry& out_worldGeo)
@@ -81,22 +85,20 @@ ezResult ezRecastNavMeshBuilder::ExtractWorldGeometry(const ezWorld& world, ezWo
 }
 
 ezResult ezRecastNavMeshBuilder::Build(const ezRecastConfig& config, const ezWorldGeoExtractionUtil::Geometry& geo,
-  ezRecastNavMeshResourceDescriptor& out_NavMeshDesc, ezProgress& progress)
+  ezRecastNavMeshResourceDescriptor& out_NavMeshDesc, ezProgress& progress, ezRecastNavMeshResourceDescriptor* pPreviousNavMesh /*= nullptr*/)
 {
   EZ_LOG_BLOCK("ezRecastNavMeshBuilder::Build");
 
-  ezProgressRange pg("Generating NavMesh", 4, true, &progress);
+  EZ_ASSERT_DEV(pPreviousNavMesh != &out_NavMeshDesc, "The previous navmesh must be a different object than the output");
+
+  ezProgressRange pg("Generating NavMesh", 3, true, &progress);
   pg.SetStepWeighting(0, 0.1f);
   pg.SetStepWeighting(1, 0.1f);
-  pg.SetStepWeighting(2, 0.6f);
-  pg.SetStepWeighting(3, 0.2f);
+  pg.SetStepWeighting(2, 0.8f);
 
   Clear();
   out_NavMeshDesc.Clear();
 
-  ezUniquePtr<ezRcBuildContext> recastContext = EZ_DEFAULT_NEW(ezRcBuildContext);
-  m_pRecastContext = recastContext.Borrow();
-
   if (!pg.BeginNextStep("Triangulate Mesh"))
     return EZ_FAILURE;
 
@@ -108,25 +110,98 @@ ezResult ezRecastNavMeshBuilder::Build(const ezRecastConfig& config, const ezWor
     return EZ_SUCCESS;
   }
 
-  if (!pg.BeginNextStep("Compute AABB"))
+  if (!pg.BeginNextStep("Assign Triangles to Tiles"))
     return EZ_FAILURE;
 
-  ComputeBoundingBox();
+  MarkWalkableTriangles(config);
+  AssignTrianglesToTiles(config);
 
-  if (!pg.BeginNextStep("Build Poly Mesh"))
-    return EZ_FAILURE;
+  rcConfig cfg;
+  FillOutConfig(cfg, config);
 
-  out_NavMeshDesc.m_pNavMeshPolygons = EZ_DEFAULT_NEW(rcPolyMesh);
+  out_NavMeshDesc.m_uiConfigHash = ComputeConfigHash(config);
+  out_NavMeshDesc.m_fTileWidth = cfg.tileSize * cfg.cs;
+  out_NavMeshDesc.m_fTileHeight = cfg.tileSize * cfg.cs;
 
-  if (BuildRecastPolyMesh(config, *out_NavMeshDesc.m_pNavMeshPolygons, progress).Failed())
-    return EZ_FAILURE;
+  // find the tiles that did not change since the previous build
+  ezDynamicArray<ezUInt32> previousTileIndices;
+  previousTileIndices.SetCount(m_Tiles.GetCount(), ezInvalidIndex);
+
+  if (pPreviousNavMesh != nullptr && pPreviousNavMesh->m_uiConfigHash == out_NavMeshDesc.m_uiConfigHash &&
+      pPreviousNavMesh->m_vTileOrigin == out_NavMeshDesc.m_vTileOrigin && pPreviousNavMesh->m_fTileWidth == out_NavMeshDesc.m_fTileWidth &&
+      pPreviousNavMesh->m_fTileHeight == out_NavMeshDesc.m_fTileHeight)
+  {
+    ezHashTable<ezUInt64, ezUInt32> previousTiles;
+    for (ezUInt32 i = 0; i < pPreviousNavMesh->m_Tiles.GetCount(); ++i)
+    {
+      previousTiles.Insert(pPreviousNavMesh->m_Tiles[i].m_uiInputHash, i);
+    }
 
-  if (!pg.BeginNextStep("Build NavMesh"))
+    for (ezUInt32 i = 0; i < m_Tiles.GetCount(); ++i)
+    {
+      ezUInt32 uiPreviousTile;
+      if (previousTiles.TryGetValue(m_Tiles[i].m_uiInputHash, uiPreviousTile))
+      {
+        const ezRecastNavMeshTile& previousTile = pPreviousNavMesh->m_Tiles[uiPreviousTile];
+        if (previousTile.m_iTileX == m_Tiles[i].m_iTileX && previousTile.m_iTileY == m_Tiles[i].m_iTileY)
+        {
+          previousTileIndices[i] = uiPreviousTile;
+        }
+      }
+    }
+  }
+
+  if (!pg.BeginNextStep("Build Tiles"))
     return EZ_FAILURE;
 
-  if (BuildDetourNavMeshData(config, *out_NavMeshDesc.m_pNavMeshPolygons, out_NavMeshDesc.m_DetourNavmeshData).Failed())
+  ezDynamicArray<ezUInt32> tilesToBuild;
+  for (ezUInt32 i = 0; i < m_Tiles.GetCount(); ++i)
+  {
+    if (previousTileIndices[i] == ezInvalidIndex)
+      tilesToBuild.PushBack(i);
+  }
+
+  ezLog::Debug("Rebuilding {} of {} tiles", tilesToBuild.GetCount(), m_Tiles.GetCount());
+  m_uiNumRebuiltTiles = tilesToBuild.GetCount();
+
+  ezDynamicArray<ezRecastNavMeshTile> builtTiles;
+  builtTiles.SetCount(m_Tiles.GetCount());
+
+  ezAtomicInteger32 iNumFailedTiles;
+
+  // all tiles are independent of each other, the Recast functions only work on the data that is passed in
+  ezTaskSystem::ParallelForIndexed(
+    0, tilesToBuild.GetCount(),
+    [this, &config, &tilesToBuild, &builtTiles, &iNumFailedTiles, &progress](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex) {
+      for (ezUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+      {
+        if (iNumFailedTiles > 0 || progress.WasCanceled())
+          return;
+
+        const ezUInt32 uiTile = tilesToBuild[i];
+        if (BuildTile(config, m_Tiles[uiTile], builtTiles[uiTile]).Failed())
+        {
+          iNumFailedTiles.Increment();
+        }
+      }
+    },
+    "Build NavMesh Tiles");
+
+  if (iNumFailedTiles > 0 || progress.WasCanceled())
     return EZ_FAILURE;
 
+  for (ezUInt32 i = 0; i < m_Tiles.GetCount(); ++i)
+  {
+    if (previousTileIndices[i] != ezInvalidIndex)
+    {
+      out_NavMeshDesc.m_Tiles.PushBack(std::move(pPreviousNavMesh->m_Tiles[previousTileIndices[i]]));
+    }
+    else if (!builtTiles[i].m_DetourTileData.IsEmpty())
+    {
+      out_NavMeshDesc.m_Tiles.PushBack(std::move(builtTiles[i]));
+    }
+  }
+
   return EZ_SUCCESS;
 }
 
@@ -226,24 +301,84 @@ void ezRecastNavMeshBuilder::GenerateTriangleMeshFromDescription(const ezWorldGe
   ezLog::Debug("Vertices: {0}, Triangles: {1}", m_Vertices.GetCount(), m_Triangles.GetCount());
 }
 
+void ezRecastNavMeshBuilder::MarkWalkableTriangles(const ezRecastConfig& config)
+{
+  ezRcBuildContext context;
+
+  // TODO Instead of this, it should use area IDs and then clear the non-walkable triangles
+  rcMarkWalkableTriangles(&context, config.m_WalkableSlope.GetDegree(), &m_Vertices[0].x, m_Vertices.GetCount(), &m_Triangles[0].m_VertexIdx[0],
+    m_Triangles.GetCount(), m_TriangleAreaIDs.GetData());
+}
 
-void ezRecastNavMeshBuilder::ComputeBoundingBox()
+void ezRecastNavMeshBuilder::AssignTrianglesToTiles(const ezRecastConfig& config)
 {
-  if (!m_Vertices.IsEmpty())
+  EZ_LOG_BLOCK("ezRecastNavMeshBuilder::AssignTrianglesToTiles");
+
+  rcConfig cfg;
+  FillOutConfig(cfg, config);
+
+  const float fTileSize = cfg.tileSize * cfg.cs;
+  const float fBorderSize = cfg.borderSize * cfg.cs;
+  const ezUInt64 uiConfigHash = ComputeConfigHash(config);
+
+  // the tile grid starts at the origin, so that the tile coordinates do not change when the world geometry grows
+  ezHashTable<ezUInt64, ezUInt32> tileLookup;
+
+  for (ezUInt32 uiTriangle = 0; uiTriangle < m_Triangles.GetCount(); ++uiTriangle)
   {
-    m_BoundingBox.SetFromPoints(m_Vertices.GetData(), m_Vertices.GetCount());
+    const Triangle& tri = m_Triangles[uiTriangle];
+
+    ezBoundingBox triBox;
+    triBox.SetInvalid();
+    triBox.ExpandToInclude(m_Vertices[tri.m_VertexIdx[0]]);
+    triBox.ExpandToInclude(m_Vertices[tri.m_VertexIdx[1]]);
+    triBox.ExpandToInclude(m_Vertices[tri.m_VertexIdx[2]]);
+
+    // every tile also rasterizes the geometry in its border, so that neighboring tiles fit together
+    const ezInt32 iMinTileX = (ezInt32)ezMath::Floor((triBox.m_vMin.x - fBorderSize) / fTileSize);
+    const ezInt32 iMaxTileX = (ezInt32)ezMath::Floor((triBox.m_vMax.x + fBorderSize) / fTileSize);
+    const ezInt32 iMinTileY = (ezInt32)ezMath::Floor((triBox.m_vMin.z - fBorderSize) / fTileSize);
+    const ezInt32 iMaxTileY = (ezInt32)ezMath::Floor((triBox.m_vMax.z + fBorderSize) / fTileSize);
+
+    for (ezInt32 y = iMinTileY; y <= iMaxTileY; ++y)
+    {
+      for (ezInt32 x = iMinTileX; x <= iMaxTileX; ++x)
+      {
+        const ezUInt64 uiKey = (static_cast<ezUInt64>(static_cast<ezUInt32>(x)) << 32) | static_cast<ezUInt32>(y);
+
+        ezUInt32 uiTile;
+        if (!tileLookup.TryGetValue(uiKey, uiTile))
+        {
+          uiTile = m_Tiles.GetCount();
+          tileLookup.Insert(uiKey, uiTile);
+
+          TileInput& newTile = m_Tiles.ExpandAndGetRef();
+          newTile.m_iTileX = x;
+          newTile.m_iTileY = y;
+          newTile.m_fMinHeight = triBox.m_vMin.y;
+          newTile.m_fMaxHeight = triBox.m_vMax.y;
+          newTile.m_uiInputHash = ezHashingUtils::xxHash64(&uiKey, sizeof(uiKey), uiConfigHash);
+        }
+
+        TileInput& tile = m_Tiles[uiTile];
+        tile.m_Triangles.PushBack(uiTriangle);
+        tile.m_fMinHeight = ezMath::Min(tile.m_fMinHeight, triBox.m_vMin.y);
+        tile.m_fMaxHeight = ezMath::Max(tile.m_fMaxHeight, triBox.m_vMax.y);
+
+        // everything that influences the tile goes into its hash, so that changed tiles can be detected
+        ezVec3 triData[3] = {m_Vertices[tri.m_VertexIdx[0]], m_Vertices[tri.m_VertexIdx[1]], m_Vertices[tri.m_VertexIdx[2]]};
+        tile.m_uiInputHash = ezHashingUtils::xxHash64(triData, sizeof(triData), tile.m_uiInputHash);
+        tile.m_uiInputHash = ezHashingUtils::xxHash64(&m_TriangleAreaIDs[uiTriangle], sizeof(ezUInt8), tile.m_uiInputHash);
+      }
+    }
   }
+
+  ezLog::Debug("Tiles: {0}", m_Tiles.GetCount());
 }
 
-void ezRecastNavMeshBuilder::FillOutConfig(rcConfig& cfg, const ezRecastConfig& config, const ezBoundingBox& bbox)
+void ezRecastNavMeshBuilder::FillOutConfig(rcConfig& cfg, const ezRecastConfig& config)
 {
   ezMemoryUtils::ZeroFill(&cfg, 1);
-  cfg.bmin[0] = bbox.m_vMin.x;
-  cfg.bmin[1] = bbox.m_vMin.y;
-  cfg.bmin[2] = bbox.m_vMin.z;
-  cfg.bmax[0] = bbox.m_vMax.x;
-  cfg.bmax[1] = bbox.m_vMax.y;
-  cfg.bmax[2] = bbox.m_vMax.z;
   cfg.ch = config.m_fCellHeight;
   cfg.cs = config.m_fCellSize;
   cfg.walkableSlopeAngle = config.m_WalkableSlope.GetDegree();
@@ -258,44 +393,86 @@ void ezRecastNavMeshBuilder::FillOutConfig(rcConfig& cfg, const ezRecastConfig&
   cfg.detailSampleDist = config.m_fDetailMeshSampleDistanceFactor < 0.9f ? 0 : cfg.cs * config.m_fDetailMeshSampleDistanceFactor;
   cfg.detailSampleMaxError = cfg.ch * config.m_fDetailMeshSampleDistanceFactor;
 
-  rcCalcGridSize(cfg.bmin, cfg.bmax, cfg.cs, &cfg.width, &cfg.height);
+  cfg.tileSize = ezMath::Max((int)(config.m_fTileSize / cfg.cs), 8);
+  cfg.borderSize = cfg.walkableRadius + 3;
+  cfg.width = cfg.tileSize + cfg.borderSize * 2;
+  cfg.height = cfg.tileSize + cfg.borderSize * 2;
+}
+
+ezUInt64 ezRecastNavMeshBuilder::ComputeConfigHash(const ezRecastConfig& config)
+{
+  ezMemoryStreamStorage storage;
+  ezMemoryStreamWriter writer(&storage);
+  config.Serialize(writer).IgnoreResult();
+
+  return ezHashingUtils::xxHash64(storage.GetData(), storage.GetStorageSize());
 }
 
-ezResult ezRecastNavMeshBuilder::BuildRecastPolyMesh(const ezRecastConfig& config, rcPolyMesh& out_PolyMesh, ezProgress& progress)
+ezResult ezRecastNavMeshBuilder::BuildTile(const ezRecastConfig& config, const TileInput& tileInput, ezRecastNavMeshTile& out_Tile) const
 {
-  ezProgressRange pgRange("Build Poly Mesh", 13, true, &progress);
+  out_Tile.m_iTileX = tileInput.m_iTileX;
+  out_Tile.m_iTileY = tileInput.m_iTileY;
+  out_Tile.m_uiInputHash = tileInput.m_uiInputHash;
+  out_Tile.m_pPolygons = EZ_DEFAULT_NEW(rcPolyMesh);
+
+  EZ_SUCCEED_OR_RETURN(BuildRecastPolyMesh(config, tileInput, *out_Tile.m_pPolygons));
+
+  // tiles that only contain unwalkable geometry are skipped
+  if (out_Tile.m_pPolygons->npolys == 0)
+  {
+    out_Tile.m_pPolygons.Clear();
+    return EZ_SUCCESS;
+  }
 
+  return BuildDetourNavMeshData(config, tileInput, *out_Tile.m_pPolygons, out_Tile.m_DetourTileData);
+}
+
+ezResult ezRecastNavMeshBuilder::BuildRecastPolyMesh(const ezRecastConfig& config, const TileInput& tileInput, rcPolyMesh& out_PolyMesh) const
+{
   rcConfig cfg;
-  FillOutConfig(cfg, config, m_BoundingBox);
+  FillOutConfig(cfg, config);
+
+  // the tile plus its border
+  const float fTileSize = cfg.tileSize * cfg.cs;
+  const float fBorderSize = cfg.borderSize * cfg.cs;
+  cfg.bmin[0] = tileInput.m_iTileX * fTileSize - fBorderSize;
+  cfg.bmin[1] = tileInput.m_fMinHeight;
+  cfg.bmin[2] = tileInput.m_iTileY * fTileSize - fBorderSize;
+  cfg.bmax[0] = (tileInput.m_iTileX + 1) * fTileSize + fBorderSize;
+  cfg.bmax[1] = tileInput.m_fMaxHeight;
+  cfg.bmax[2] = (tileInput.m_iTileY + 1) * fTileSize + fBorderSize;
+
+  // each tile is built on its own thread, so it gets its own context
+  ezRcBuildContext context;
+  ezRcBuildContext* pContext = &context;
+
+  ezDynamicArray<Triangle> triangles;
+  ezDynamicArray<ezUInt8> triangleAreaIDs;
+  triangles.SetCount(tileInput.m_Triangles.GetCount());
+  triangleAreaIDs.SetCountUninitialized(tileInput.m_Triangles.GetCount());
+
+  for (ezUInt32 i = 0; i < tileInput.m_Triangles.GetCount(); ++i)
+  {
+    triangles[i] = m_Triangles[tileInput.m_Triangles[i]];
+    triangleAreaIDs[i] = m_TriangleAreaIDs[tileInput.m_Triangles[i]];
+  }
 
-  ezRcBuildContext* pContext = m_pRecastContext;
   const float* pVertices = &m_Vertices[0].x;
-  const ezInt32* pTriangles = &m_Triangles[0].m_VertexIdx[0];
+  const ezInt32* pTriangles = &triangles[0].m_VertexIdx[0];
 
   rcHeightfield* heightfield = rcAllocHeightfield();
   EZ_SCOPE_EXIT(rcFreeHeightField(heightfield));
 
-  if (!pgRange.BeginNextStep("Creating Heightfield"))
-    return EZ_FAILURE;
-
   if (!rcCreateHeightfield(pContext, *heightfield, cfg.width, cfg.height, cfg.bmin, cfg.bmax, cfg.cs, cfg.ch))
   {
     pContext->log(RC_LOG_ERROR, "Could not create solid heightfield");
     return EZ_FAILURE;
   }
 
-  if (!pgRange.BeginNextStep("Mark Walkable Area"))
-    return EZ_FAILURE;
-
-  // TODO Instead of this, it should use area IDs and then clear the non-walkable triangles
-  rcMarkWalkableTriangles(
-    pContext, cfg.walkableSlopeAngle, pVertices, m_Vertices.GetCount(), pTriangles, m_Triangles.GetCount(), m_TriangleAreaIDs.GetData());
-
-  if (!pgRange.BeginNextStep("Rasterize Triangles"))
-    return EZ_FAILURE;
+  // the walkable area was already marked for all triangles, see MarkWalkableTriangles()
 
   if (!rcRasterizeTriangles(
-        pContext, pVertices, m_Vertices.GetCount(), pTriangles, m_TriangleAreaIDs.GetData(), m_Triangles.GetCount(), *heightfield, cfg.walkableClimb))
+        pContext, pVertices, m_Vertices.GetCount(), pTriangles, triangleAreaIDs.GetData(), triangles.GetCount(), *heightfield, cfg.walkableClimb))
   {
     pContext->log(RC_LOG_ERROR, "Could not rasterize triangles");
     return EZ_FAILURE;
@@ -303,28 +480,16 @@ ezResult ezRecastNavMeshBuilder::BuildRecastPolyMesh(const ezRecastConfig& confi
 
   // Optional stuff
   {
-    if (!pgRange.BeginNextStep("Filter Low Hanging Obstacles"))
-      return EZ_FAILURE;
-
     // if (m_filterLowHangingObstacles)
     rcFilterLowHangingWalkableObstacles(pContext, cfg.walkableClimb, *heightfield);
 
-    if (!pgRange.BeginNextStep("Filter Ledge Spans"))
-      return EZ_FAILURE;
-
     // if (m_filterLedgeSpans)
     rcFilterLedgeSpans(pContext, cfg.walkableHeight, cfg.walkableClimb, *heightfield);
 
-    if (!pgRange.BeginNextStep("Filter Low Height Spans"))
-      return EZ_FAILURE;
-
     // if (m_filterWalkableLowHeightSpans)
     rcFilterWalkableLowHeightSpans(pContext, cfg.walkableHeight, *heightfield);
   }
 
-  if (!pgRange.BeginNextStep("Build Compact Heightfield"))
-    return EZ_FAILURE;
-
   rcCompactHeightfield* compactHeightfield = rcAllocCompactHeightfield();
   EZ_SCOPE_EXIT(rcFreeCompactHeightfield(compactHeightfield));
 
@@ -334,9 +499,6 @@ ezResult ezRecastNavMeshBuilder::BuildRecastPolyMesh(const ezRecastConfig& confi
     return EZ_FAILURE;
   }
 
-  if (!pgRange.BeginNextStep("Erode Walkable Area"))
-    return EZ_FAILURE;
-
   if (!rcErodeWalkableArea(pContext, cfg.walkableRadius, *compactHeightfield))
   {
     pContext->log(RC_LOG_ERROR, "Could not erode with character radius");
@@ -351,15 +513,11 @@ ezResult ezRecastNavMeshBuilder::BuildRecastPolyMesh(const ezRecastConfig& confi
   //    *compactHeightfield);
   //}
 
-
   // Partition the heightfield so that we can use simple algorithm later to triangulate the walkable areas.
   // Default algorithm is 'Watershed'
   {
     // PARTITION_WATERSHED
     {
-      if (!pgRange.BeginNextStep("Build Distance Field"))
-        return EZ_FAILURE;
-
       // Prepare for region partitioning, by calculating distance field along the walkable surface.
       if (!rcBuildDistanceField(pContext, *compactHeightfield))
       {
@@ -367,11 +525,8 @@ ezResult ezRecastNavMeshBuilder::BuildRecastPolyMesh(const ezRecastConfig& confi
         return EZ_FAILURE;
       }
 
-      if (!pgRange.BeginNextStep("Build Regions"))
-        return EZ_FAILURE;
-
       // Partition the walkable surface into simple regions without holes.
-      if (!rcBuildRegions(pContext, *compactHeightfield, 0, cfg.minRegionArea, cfg.mergeRegionArea))
+      if (!rcBuildRegions(pContext, *compactHeightfield, cfg.borderSize, cfg.minRegionArea, cfg.mergeRegionArea))
       {
         pContext->log(RC_LOG_ERROR, "Could not build watershed regions.");
         return EZ_FAILURE;
@@ -400,9 +555,6 @@ ezResult ezRecastNavMeshBuilder::BuildRecastPolyMesh(const ezRecastConfig& confi
     //}
   }
 
-  if (!pgRange.BeginNextStep("Build Contours"))
-    return EZ_FAILURE;
-
   rcContourSet* contourSet = rcAllocContourSet();
   EZ_SCOPE_EXIT(rcFreeContourSet(contourSet));
 
@@ -412,9 +564,6 @@ ezResult ezRecastNavMeshBuilder::BuildRecastPolyMesh(const ezRecastConfig& confi
     return EZ_FAILURE;
   }
 
-  if (!pgRange.BeginNextStep("Build Poly Mesh"))
-    return EZ_FAILURE;
-
   if (!rcBuildPolyMesh(pContext, *contourSet, cfg.maxVertsPerPoly, out_PolyMesh))
   {
     pContext->log(RC_LOG_ERROR, "Could not triangulate contours");
@@ -424,9 +573,6 @@ ezResult ezRecastNavMeshBuilder::BuildRecastPolyMesh(const ezRecastConfig& confi
   //////////////////////////////////////////////////////////////////////////
   // Detour Navmesh
 
-  if (!pgRange.BeginNextStep("Set Area Flags"))
-    return EZ_FAILURE;
-
   // TODO modify area IDs and flags
 
   for (int i = 0; i < out_PolyMesh.npolys; ++i)
@@ -440,7 +586,8 @@ ezResult ezRecastNavMeshBuilder::BuildRecastPolyMesh(const ezRecastConfig& confi
   return EZ_SUCCESS;
 }
 
-ezResult ezRecastNavMeshBuilder::BuildDetourNavMeshData(const ezRecastConfig& config, const rcPolyMesh& polyMesh, ezDataBuffer& NavmeshData)
+ezResult ezRecastNavMeshBuilder::BuildDetourNavMeshData(
+  const ezRecastConfig& config, const TileInput& tileInput, const rcPolyMesh& polyMesh, ezDataBuffer& NavmeshData)
 {
   dtNavMeshCreateParams params;
   ezMemoryUtils::ZeroFill(&params, 1);
@@ -460,6 +607,9 @@ ezResult ezRecastNavMeshBuilder::BuildDetourNavMeshData(const ezRecastConfig& co
   params.cs = config.m_fCellSize;
   params.ch = config.m_fCellHeight;
   params.buildBvTree = true;
+  params.tileX = tileInput.m_iTileX;
+  params.tileY = tileInput.m_iTileY;
+  params.tileLayer = 0;
 
   ezUInt8* navData = nullptr;
   ezInt32 navDataSize = 0;
@@ -479,7 +629,7 @@ ezResult ezRecastNavMeshBuilder::BuildDetourNavMeshData(const ezRecastConfig& co
 
 ezResult ezRecastConfig::Serialize(ezStreamWriter& stream) const
 {
-  stream.WriteVersion(1);
+  stream.WriteVersion(2);
 
   stream << m_fAgentHeight;
   stream << m_fAgentRadius;
@@ -493,13 +643,14 @@ ezResult ezRecastConfig::Serialize(ezStreamWriter& stream) const
   stream << m_fRegionMergeSize;
   stream << m_fDetailMeshSampleDistanceFactor;
   stream << m_fDetailMeshSampleErrorFactor;
+  stream << m_fTileSize;
 
   return EZ_SUCCESS;
 }
 
 ezResult ezRecastConfig::Deserialize(ezStreamReader& stream)
 {
-  stream.ReadVersion(1);
+  const ezTypeVersion version = stream.ReadVersion(2);
 
   stream >> m_fAgentHeight;
   stream >> m_fAgentRadius;
@@ -514,5 +665,10 @@ ezResult ezRecastConfig::Deserialize(ezStreamReader& stream)
   stream >> m_fDetailMeshSampleDistanceFactor;
   stream >> m_fDetailMeshSampleErrorFactor;
 
+  if (version >= 2)
+  {
+    stream >> m_fTileSize;
+  }
+
   return EZ_SUCCESS;
 }
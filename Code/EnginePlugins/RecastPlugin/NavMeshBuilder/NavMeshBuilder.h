@@ -11,6 +11,7 @@ struct rcPolyMeshDetail;
 class ezWorld;
 class dtNavMesh;
 struct ezRecastNavMeshResourceDescriptor;
+struct ezRecastNavMeshTile;
 class ezProgress;
 class ezStreamWriter;
 class ezStreamReader;
@@ -29,6 +30,7 @@ struct EZ_RECASTPLUGIN_DLL ezRecastConfig
   float m_fRegionMergeSize = 20.0f;
   float m_fDetailMeshSampleDistanceFactor = 1.0f;
   float m_fDetailMeshSampleErrorFactor = 1.0f;
+  float m_fTileSize = 16.0f;
 
   ezResult Serialize(ezStreamWriter& stream) const;
   ezResult Deserialize(ezStreamReader& stream);
@@ -38,6 +40,11 @@ EZ_DECLARE_REFLECTABLE_TYPE(EZ_RECASTPLUGIN_DLL, ezRecastConfig);
 
 
 
+/// \brief Builds a tiled navmesh from world geometry.
+///
+/// The world is divided into square tiles of ezRecastConfig::m_fTileSize, which are built independently of each other on the ezTaskSystem.
+/// Every tile stores a hash of the geometry that it was built from. When a previously built navmesh is passed to Build(),
+/// only the tiles whose geometry changed are rebuilt, all others are taken over from the previous navmesh.
 class EZ_RECASTPLUGIN_DLL ezRecastNavMeshBuilder
 {
 public:
@@ -46,18 +53,38 @@ public:
 
   static ezResult ExtractWorldGeometry(const ezWorld& world, ezWorldGeoExtractionUtil::Geometry& out_worldGeo);
 
+  /// \brief Builds the navmesh for the given geometry.
+  ///
+  /// If pPreviousNavMesh is given, all tiles that are still up-to-date are moved from it into out_NavMeshDesc, instead of being rebuilt.
   ezResult Build(const ezRecastConfig& config, const ezWorldGeoExtractionUtil::Geometry& worldGeo, ezRecastNavMeshResourceDescriptor& out_NavMeshDesc,
-    ezProgress& progress);
+    ezProgress& progress, ezRecastNavMeshResourceDescriptor* pPreviousNavMesh = nullptr);
+
+  /// \brief How many tiles the last call to Build() had to rebuild, the other tiles were taken from the previous navmesh.
+  ezUInt32 GetNumRebuiltTiles() const { return m_uiNumRebuiltTiles; }
 
 private:
-  static void FillOutConfig(struct rcConfig& cfg, const ezRecastConfig& config, const ezBoundingBox& bbox);
+  struct TileInput
+  {
+    ezInt32 m_iTileX = 0;
+    ezInt32 m_iTileY = 0;
+    ezUInt64 m_uiInputHash = 0;
+    float m_fMinHeight = 0.0f;
+    float m_fMaxHeight = 0.0f;
+    ezDynamicArray<ezUInt32> m_Triangles;
+  };
+
+  static void FillOutConfig(struct rcConfig& cfg, const ezRecastConfig& config);
+  static ezUInt64 ComputeConfigHash(const ezRecastConfig& config);
 
   void Clear();
   void ReserveMemory(const ezWorldGeoExtractionUtil::Geometry& desc);
   void GenerateTriangleMeshFromDescription(const ezWorldGeoExtractionUtil::Geometry& desc);
-  void ComputeBoundingBox();
-  ezResult BuildRecastPolyMesh(const ezRecastConfig& config, rcPolyMesh& out_PolyMesh, ezProgress& progress);
-  static ezResult BuildDetourNavMeshData(const ezRecastConfig& config, const rcPolyMesh& polyMesh, ezDataBuffer& NavmeshData);
+  void MarkWalkableTriangles(const ezRecastConfig& config);
+  void AssignTrianglesToTiles(const ezRecastConfig& config);
+  ezResult BuildTile(const ezRecastConfig& config, const TileInput& tileInput, ezRecastNavMeshTile& out_Tile) const;
+  ezResult BuildRecastPolyMesh(const ezRecastConfig& config, const TileInput& tileInput, rcPolyMesh& out_PolyMesh) const;
+  static ezResult BuildDetourNavMeshData(
+    const ezRecastConfig& config, const TileInput& tileInput, const rcPolyMesh& polyMesh, ezDataBuffer& NavmeshData);
 
   struct Triangle
   {
@@ -72,9 +99,9 @@ private:
     ezInt32 m_VertexIdx[3];
   };
 
-  ezBoundingBox m_BoundingBox;
   ezDynamicArray<ezVec3> m_Vertices;
   ezDynamicArray<Triangle> m_Triangles;
   ezDynamicArray<ezUInt8> m_TriangleAreaIDs;
-  ezRcBuildContext* m_pRecastContext = nullptr;
+  ezDynamicArray<TileInput> m_Tiles;
+  ezUInt32 m_uiNumRebuiltTiles = 0;
 };
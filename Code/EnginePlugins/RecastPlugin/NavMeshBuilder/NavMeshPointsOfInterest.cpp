@@ -285,19 +285,24 @@ void ezNavMeshPointOfInterestGraph::ExtractInterestPointsFromMesh(const rcPolyMe
 
   // add all points
   {
-    ezUInt32 uiNumPoints = 0;
+    ezDynamicArray<ezVec3> positions;
 
     for (auto potPoi : interestPoints)
     {
       if (potPoi.m_bUsed)
       {
-        ++uiNumPoints;
-
-        auto& poi = m_NavMeshPointGraph.AddPoint(potPoi.m_vPosition);
-        poi.m_vFloorPosition = potPoi.m_vPosition;
+        positions.PushBack(potPoi.m_vPosition);
       }
     }
 
-    ezLog::Dev("Num Points of Interest: {0}", uiNumPoints);
+    const ezUInt32 uiFirstPoint = m_NavMeshPointGraph.AddPoints(positions);
+
+    auto& points = m_NavMeshPointGraph.AccessPoints();
+    for (ezUInt32 i = 0; i < positions.GetCount(); ++i)
+    {
+      points[uiFirstPoint + i].m_vFloorPosition = positions[i];
+    }
+
+    ezLog::Dev("Num Points of Interest: {0}", positions.GetCount());
   }
 }
@@ -1,222 +1,420 @@
-#include <RecastPluginPCH.h>
-
-#include <Core/Assets/AssetFileHeader.h>
-#include <Foundation/IO/ChunkStream.h>
-#include <Recast/DetourNavMesh.h>
-#include <Recast/Recast.h>
-#include <Recast/RecastAlloc.h>
-#include <RecastPlugin/Resources/RecastNavMeshResource.h>
-
-// clang-format off
-EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezRecastNavMeshResource, 1, ezRTTIDefaultAllocator<ezRecastNavMeshResource>)
-EZ_END_DYNAMIC_REFLECTED_TYPE;
-
-EZ_RESOURCE_IMPLEMENT_COMMON_CODE(ezRecastNavMeshResource);
-// clang-format on
-
-//////////////////////////////////////////////////////////////////////////
-
-ezRecastNavMeshResourceDescriptor::ezRecastNavMeshResourceDescriptor() = default;
-ezRecastNavMeshResourceDescriptor::ezRecastNavMeshResourceDescriptor(ezRecastNavMeshResourceDescriptor&& rhs)
-{
-  *this = std::move(rhs);
-}
-
-ezRecastNavMeshResourceDescriptor::~ezRecastNavMeshResourceDescriptor()
-{
-  Clear();
-}
-
-void ezRecastNavMeshResourceDescriptor::operator=(ezRecastNavMeshResourceDescriptor&& rhs)
-{
-  m_DetourNavmeshData = std::move(rhs.m_DetourNavmeshData);
-
-  m_pNavMeshPolygons = rhs.m_pNavMeshPolygons;
-  rhs.m_pNavMeshPolygons = nullptr;
-}
-
-void ezRecastNavMeshResourceDescriptor::Clear()
-{
-  m_DetourNavmeshData.Clear();
-  EZ_DEFAULT_DELETE(m_pNavMeshPolygons);
-}
-
-//////////////////////////////////////////////////////////////////////////
-
-ezResult ezRecastNavMeshResourceDescriptor::Serialize(ezStreamWriter& stream) const
-{
-  stream.WriteVersion(1);
-  EZ_SUCCEED_OR_RETURN(stream.WriteArray(m_DetourNavmeshData));
-
-  const bool hasPolygons = m_pNavMeshPolygons != nullptr;
-  stream << hasPolygons;
-
-  if (hasPolygons)
-  {
-    EZ_CHECK_AT_COMPILETIME_MSG(sizeof(rcPolyMesh) == sizeof(void*) * 5 + sizeof(int) * 14, "rcPolyMesh data structure has changed");
-
-    const auto& mesh = *m_pNavMeshPolygons;
-
-    stream << (int)mesh.nverts;
-    stream << (int)mesh.npolys;
-    stream << (int)mesh.npolys; // do not use mesh.maxpolys
-    stream << (int)mesh.nvp;
-    stream << (float)mesh.bmin[0];
-    stream << (float)mesh.bmin[1];
-    stream << (float)mesh.bmin[2];
-    stream << (float)mesh.bmax[0];
-    stream << (float)mesh.bmax[1];
-    stream << (float)mesh.bmax[2];
-    stream << (float)mesh.cs;
-    stream << (float)mesh.ch;
-    stream << (int)mesh.borderSize;
-    stream << (float)mesh.maxEdgeError;
-
-    EZ_ASSERT_DEBUG(mesh.maxpolys >= mesh.npolys, "Invalid navmesh polygon count");
-
-    EZ_SUCCEED_OR_RETURN(stream.WriteBytes(mesh.verts, sizeof(ezUInt16) * mesh.nverts * 3));
-    EZ_SUCCEED_OR_RETURN(stream.WriteBytes(mesh.polys, sizeof(ezUInt16) * mesh.npolys * mesh.nvp * 2));
-    EZ_SUCCEED_OR_RETURN(stream.WriteBytes(mesh.regs, sizeof(ezUInt16) * mesh.npolys));
-    EZ_SUCCEED_OR_RETURN(stream.WriteBytes(mesh.flags, sizeof(ezUInt16) * mesh.npolys));
-    EZ_SUCCEED_OR_RETURN(stream.WriteBytes(mesh.areas, sizeof(ezUInt8) * mesh.npolys));
-  }
-
-  return EZ_SUCCESS;
-}
-
-ezResult ezRecastNavMeshResourceDescriptor::Deserialize(ezStreamReader& stream)
-{
-  Clear();
-
-  const ezTypeVersion version = stream.ReadVersion(1);
-  EZ_SUCCEED_OR_RETURN(stream.ReadArray(m_DetourNavmeshData));
-
-  bool hasPolygons = false;
-  stream >> hasPolygons;
-
-  if (hasPolygons)
-  {
-    EZ_CHECK_AT_COMPILETIME_MSG(sizeof(rcPolyMesh) == sizeof(void*) * 5 + sizeof(int) * 14, "rcPolyMesh data structure has changed");
-
-    m_pNavMeshPolygons = EZ_DEFAULT_NEW(rcPolyMesh);
-
-    auto& mesh = *m_pNavMeshPolygons;
-
-    stream >> mesh.nverts;
-    stream >> mesh.npolys;
-    stream >> mesh.maxpolys;
-    stream >> mesh.nvp;
-    stream >> mesh.bmin[0];
-    stream >> mesh.bmin[1];
-    stream >> mesh.bmin[2];
-    stream >> mesh.bmax[0];
-    stream >> mesh.bmax[1];
-    stream >> mesh.bmax[2];
-    stream >> mesh.cs;
-    stream >> mesh.ch;
-    stream >> mesh.borderSize;
-    stream >> mesh.maxEdgeError;
-
-    EZ_ASSERT_DEBUG(mesh.maxpolys >= mesh.npolys, "Invalid navmesh polygon count");
-
-    mesh.verts = (ezUInt16*)rcAlloc(sizeof(ezUInt16) * mesh.nverts * 3, RC_ALLOC_PERM);
-    mesh.polys = (ezUInt16*)rcAlloc(sizeof(ezUInt16) * mesh.maxpolys * mesh.nvp * 2, RC_ALLOC_PERM);
-    mesh.regs = (ezUInt16*)rcAlloc(sizeof(ezUInt16) * mesh.maxpolys, RC_ALLOC_PERM);
-    mesh.areas = (ezUInt8*)rcAlloc(sizeof(ezUInt8) * mesh.maxpolys, RC_ALLOC_PERM);
-
-    stream.ReadBytes(mesh.verts, sizeof(ezUInt16) * mesh.nverts * 3);
-    stream.ReadBytes(mesh.polys, sizeof(ezUInt16) * mesh.maxpolys * mesh.nvp * 2);
-    stream.ReadBytes(mesh.regs, sizeof(ezUInt16) * mesh.maxpolys);
-    stream.ReadBytes(mesh.flags, sizeof(ezUInt16) * mesh.maxpolys);
-    stream.ReadBytes(mesh.areas, sizeof(ezUInt8) * mesh.maxpolys);
-  }
-
-  return EZ_SUCCESS;
-}
-
-//////////////////////////////////////////////////////////////////////////
-
-ezRecastNavMeshResource::ezRecastNavMeshResource()
-  : ezResource(DoUpdate::OnAnyThread, 1)
-{
-  ModifyMemoryUsage().m_uiMemoryCPU = sizeof(ezRecastNavMeshResource);
-}
-
-ezRecastNavMeshResource::~ezRecastNavMeshResource()
-{
-  EZ_DEFAULT_DELETE(m_pNavMeshPolygons);
-  EZ_DEFAULT_DELETE(m_pNavMesh);
-}
-
-ezResourceLoadDesc ezRecastNavMeshResource::UnloadData(Unload WhatToUnload)
-{
-  ezResourceLoadDesc res;
-  res.m_uiQualityLevelsDiscardable = 0;
-  res.m_uiQualityLevelsLoadable = 0;
-  res.m_State = ezResourceState::Unloaded;
-
-  m_DetourNavmeshData.Clear();
-  EZ_DEFAULT_DELETE(m_pNavMesh);
-  EZ_DEFAULT_DELETE(m_pNavMeshPolygons);
-
-  return res;
-}
-
-ezResourceLoadDesc ezRecastNavMeshResource::UpdateContent(ezStreamReader* Stream)
-{
-  EZ_LOG_BLOCK("ezRecastNavMeshResource::UpdateContent", GetResourceDescription().GetData());
-
-  ezResourceLoadDesc res;
-  res.m_uiQualityLevelsDiscardable = 0;
-  res.m_uiQualityLevelsLoadable = 0;
-
-  if (Stream == nullptr)
-  {
-    res.m_State = ezResourceState::LoadedResourceMissing;
-    return res;
-  }
-
-  // skip the absolute file path data that the standard file reader writes into the stream
-  {
-    ezStringBuilder sAbsFilePath;
-    (*Stream) >> sAbsFilePath;
-  }
-
-  ezAssetFileHeader AssetHash;
-  AssetHash.Read(*Stream);
-
-  ezRecastNavMeshResourceDescriptor descriptor;
-  descriptor.Deserialize(*Stream);
-
-  return CreateResource(std::move(descriptor));
-}
-
-void ezRecastNavMeshResource::UpdateMemoryUsage(MemoryUsage& out_NewMemoryUsage)
-{
-  out_NewMemoryUsage.m_uiMemoryCPU = sizeof(ezRecastNavMeshResource);
-  out_NewMemoryUsage.m_uiMemoryCPU += m_DetourNavmeshData.GetHeapMemoryUsage();
-  out_NewMemoryUsage.m_uiMemoryCPU += m_pNavMesh != nullptr ? sizeof(dtNavMesh) : 0;
-  out_NewMemoryUsage.m_uiMemoryCPU += m_pNavMeshPolygons != nullptr ? sizeof(rcPolyMesh) : 0;
-  out_NewMemoryUsage.m_uiMemoryGPU = 0;
-}
-
-ezResourceLoadDesc ezRecastNavMeshResource::CreateResource(ezRecastNavMeshResourceDescriptor&& descriptor)
-{
-  ezResourceLoadDesc res;
-  res.m_uiQualityLevelsDiscardable = 0;
-  res.m_uiQualityLevelsLoadable = 0;
-  res.m_State = ezResourceState::Loaded;
-
-  m_pNavMeshPolygons = descriptor.m_pNavMeshPolygons;
-  descriptor.m_pNavMeshPolygons = nullptr;
-
-  m_DetourNavmeshData = std::move(descriptor.m_DetourNavmeshData);
-
-  m_pNavMesh = EZ_DEFAULT_NEW(dtNavMesh);
-
-  // the dtNavMesh does not need to free the data, the resource owns it
-  const int dtMeshFlags = 0;
-  m_pNavMesh->init(m_DetourNavmeshData.GetData(), m_DetourNavmeshData.GetCount(), dtMeshFlags);
-
-  return res;
-}
+#include <RecastPluginPCH.h>
+
+#include <Core/Assets/AssetFileHeader.h>
+#include <Foundation/IO/ChunkStream.h>
+#include <Recast/DetourCommon.h>
+#include <Recast/DetourNavMesh.h>
+#include <Recast/Recast.h>
+#include <Recast/RecastAlloc.h>
+#include <RecastPlugin/Resources/RecastNavMeshResource.h>
+
+// clang-format off
+EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezRecastNavMeshResource, 1, ezRTTIDefaultAllocator<ezRecastNavMeshResource>)
+EZ_END_DYNAMIC_REFLECTED_TYPE;
+
+EZ_RESOURCE_IMPLEMENT_COMMON_CODE(ezRecastNavMeshResource);
+// clang-format on
+
+//////////////////////////////////////////////////////////////////////////
+
+static ezResult WriteNavMeshPolygons(ezStreamWriter& stream, const rcPolyMesh* pPolygons)
+{
+  const bool hasPolygons = pPolygons != nullptr;
+  stream << hasPolygons;
+
+  if (hasPolygons)
+  {
+    EZ_CHECK_AT_COMPILETIME_MSG(sizeof(rcPolyMesh) == sizeof(void*) * 5 + sizeof(int) * 14, "rcPolyMesh data structure has changed");
+
+    const auto& mesh = *pPolygons;
+
+    stream << (int)mesh.nverts;
+    stream << (int)mesh.npolys;
+    stream << (int)mesh.npolys; // do not use mesh.maxpolys
+    stream << (int)mesh.nvp;
+    stream << (float)mesh.bmin[0];
+    stream << (float)mesh.bmin[1];
+    stream << (float)mesh.bmin[2];
+    stream << (float)mesh.bmax[0];
+    stream << (float)mesh.bmax[1];
+    stream << (float)mesh.bmax[2];
+    stream << (float)mesh.cs;
+    stream << (float)mesh.ch;
+    stream << (int)mesh.borderSize;
+    stream << (float)mesh.maxEdgeError;
+
+    EZ_ASSERT_DEBUG(mesh.maxpolys >= mesh.npolys, "Invalid navmesh polygon count");
+
+    EZ_SUCCEED_OR_RETURN(stream.WriteBytes(mesh.verts, sizeof(ezUInt16) * mesh.nverts * 3));
+    EZ_SUCCEED_OR_RETURN(stream.WriteBytes(mesh.polys, sizeof(ezUInt16) * mesh.npolys * mesh.nvp * 2));
+    EZ_SUCCEED_OR_RETURN(stream.WriteBytes(mesh.regs, sizeof(ezUInt16) * mesh.npolys));
+    EZ_SUCCEED_OR_RETURN(stream.WriteBytes(mesh.flags, sizeof(ezUInt16) * mesh.npolys));
+    EZ_SUCCEED_OR_RETURN(stream.WriteBytes(mesh.areas, sizeof(ezUInt8) * mesh.npolys));
+  }
+
+  return EZ_SUCCESS;
+}
+
+static ezResult ReadNavMeshPolygons(ezStreamReader& stream, ezUniquePtr<rcPolyMesh>& out_pPolygons)
+{
+  out_pPolygons.Clear();
+
+  bool hasPolygons = false;
+  stream >> hasPolygons;
+
+  if (hasPolygons)
+  {
+    EZ_CHECK_AT_COMPILETIME_MSG(sizeof(rcPolyMesh) == sizeof(void*) * 5 + sizeof(int) * 14, "rcPolyMesh data structure has changed");
+
+    out_pPolygons = EZ_DEFAULT_NEW(rcPolyMesh);
+
+    auto& mesh = *out_pPolygons;
+
+    stream >> mesh.nverts;
+    stream >> mesh.npolys;
+    stream >> mesh.maxpolys;
+    stream >> mesh.nvp;
+    stream >> mesh.bmin[0];
+    stream >> mesh.bmin[1];
+    stream >> mesh.bmin[2];
+    stream >> mesh.bmax[0];
+    stream >> mesh.bmax[1];
+    stream >> mesh.bmax[2];
+    stream >> mesh.cs;
+    stream >> mesh.ch;
+    stream >> mesh.borderSize;
+    stream >> mesh.maxEdgeError;
+
+    EZ_ASSERT_DEBUG(mesh.maxpolys >= mesh.npolys, "Invalid navmesh polygon count");
+
+    mesh.verts = (ezUInt16*)rcAlloc(sizeof(ezUInt16) * mesh.nverts * 3, RC_ALLOC_PERM);
+    mesh.polys = (ezUInt16*)rcAlloc(sizeof(ezUInt16) * mesh.maxpolys * mesh.nvp * 2, RC_ALLOC_PERM);
+    mesh.regs = (ezUInt16*)rcAlloc(sizeof(ezUInt16) * mesh.maxpolys, RC_ALLOC_PERM);
+    mesh.flags = (ezUInt16*)rcAlloc(sizeof(ezUInt16) * mesh.maxpolys, RC_ALLOC_PERM);
+    mesh.areas = (ezUInt8*)rcAlloc(sizeof(ezUInt8) * mesh.maxpolys, RC_ALLOC_PERM);
+
+    stream.ReadBytes(mesh.verts, sizeof(ezUInt16) * mesh.nverts * 3);
+    stream.ReadBytes(mesh.polys, sizeof(ezUInt16) * mesh.maxpolys * mesh.nvp * 2);
+    stream.ReadBytes(mesh.regs, sizeof(ezUInt16) * mesh.maxpolys);
+    stream.ReadBytes(mesh.flags, sizeof(ezUInt16) * mesh.maxpolys);
+    stream.ReadBytes(mesh.areas, sizeof(ezUInt8) * mesh.maxpolys);
+  }
+
+  return EZ_SUCCESS;
+}
+
+static const dtMeshHeader* GetDetourTileHeader(const ezDataBuffer& tileData)
+{
+  if (tileData.GetCount() < sizeof(dtMeshHeader))
+    return nullptr;
+
+  const dtMeshHeader* pHeader = reinterpret_cast<const dtMeshHeader*>(tileData.GetData());
+  if (pHeader->magic != DT_NAVMESH_MAGIC || pHeader->version != DT_NAVMESH_VERSION)
+    return nullptr;
+
+  return pHeader;
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+ezRecastNavMeshTile::ezRecastNavMeshTile() = default;
+ezRecastNavMeshTile::ezRecastNavMeshTile(ezRecastNavMeshTile&& rhs)
+{
+  *this = std::move(rhs);
+}
+
+ezRecastNavMeshTile::~ezRecastNavMeshTile() = default;
+
+void ezRecastNavMeshTile::operator=(ezRecastNavMeshTile&& rhs)
+{
+  m_iTileX = rhs.m_iTileX;
+  m_iTileY = rhs.m_iTileY;
+  m_uiInputHash = rhs.m_uiInputHash;
+  m_DetourTileData = std::move(rhs.m_DetourTileData);
+  m_pPolygons = std::move(rhs.m_pPolygons);
+}
+
+ezResult ezRecastNavMeshTile::Serialize(ezStreamWriter& stream) const
+{
+  stream << m_iTileX;
+  stream << m_iTileY;
+  stream << m_uiInputHash;
+  EZ_SUCCEED_OR_RETURN(stream.WriteArray(m_DetourTileData));
+  EZ_SUCCEED_OR_RETURN(WriteNavMeshPolygons(stream, m_pPolygons.Borrow()));
+
+  return EZ_SUCCESS;
+}
+
+ezResult ezRecastNavMeshTile::Deserialize(ezStreamReader& stream)
+{
+  stream >> m_iTileX;
+  stream >> m_iTileY;
+  stream >> m_uiInputHash;
+  EZ_SUCCEED_OR_RETURN(stream.ReadArray(m_DetourTileData));
+  EZ_SUCCEED_OR_RETURN(ReadNavMeshPolygons(stream, m_pPolygons));
+
+  return EZ_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+ezRecastNavMeshResourceDescriptor::ezRecastNavMeshResourceDescriptor() = default;
+ezRecastNavMeshResourceDescriptor::ezRecastNavMeshResourceDescriptor(ezRecastNavMeshResourceDescriptor&& rhs)
+{
+  *this = std::move(rhs);
+}
+
+ezRecastNavMeshResourceDescriptor::~ezRecastNavMeshResourceDescriptor()
+{
+  Clear();
+}
+
+void ezRecastNavMeshResourceDescriptor::operator=(ezRecastNavMeshResourceDescriptor&& rhs)
+{
+  m_vTileOrigin = rhs.m_vTileOrigin;
+  m_fTileWidth = rhs.m_fTileWidth;
+  m_fTileHeight = rhs.m_fTileHeight;
+  m_uiConfigHash = rhs.m_uiConfigHash;
+  m_Tiles = std::move(rhs.m_Tiles);
+}
+
+void ezRecastNavMeshResourceDescriptor::Clear()
+{
+  m_vTileOrigin.SetZero();
+  m_fTileWidth = 0.0f;
+  m_fTileHeight = 0.0f;
+  m_uiConfigHash = 0;
+  m_Tiles.Clear();
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+ezResult ezRecastNavMeshResourceDescriptor::Serialize(ezStreamWriter& stream) const
+{
+  stream.WriteVersion(2);
+
+  stream << m_vTileOrigin;
+  stream << m_fTileWidth;
+  stream << m_fTileHeight;
+  stream << m_uiConfigHash;
+
+  stream << m_Tiles.GetCount();
+  for (const auto& tile : m_Tiles)
+  {
+    EZ_SUCCEED_OR_RETURN(tile.Serialize(stream));
+  }
+
+  return EZ_SUCCESS;
+}
+
+ezResult ezRecastNavMeshResourceDescriptor::Deserialize(ezStreamReader& stream)
+{
+  Clear();
+
+  const ezTypeVersion version = stream.ReadVersion(2);
+
+  if (version == 1)
+  {
+    // a single navmesh, which is the same as a single tile
+    ezRecastNavMeshTile& tile = m_Tiles.ExpandAndGetRef();
+    EZ_SUCCEED_OR_RETURN(stream.ReadArray(tile.m_DetourTileData));
+    EZ_SUCCEED_OR_RETURN(ReadNavMeshPolygons(stream, tile.m_pPolygons));
+
+    if (const dtMeshHeader* pHeader = GetDetourTileHeader(tile.m_DetourTileData))
+    {
+      m_vTileOrigin.Set(pHeader->bmin[0], pHeader->bmin[1], pHeader->bmin[2]);
+      m_fTileWidth = pHeader->bmax[0] - pHeader->bmin[0];
+      m_fTileHeight = pHeader->bmax[2] - pHeader->bmin[2];
+      tile.m_iTileX = pHeader->x;
+      tile.m_iTileY = pHeader->y;
+    }
+    else
+    {
+      m_Tiles.Clear();
+    }
+
+    return EZ_SUCCESS;
+  }
+
+  stream >> m_vTileOrigin;
+  stream >> m_fTileWidth;
+  stream >> m_fTileHeight;
+  stream >> m_uiConfigHash;
+
+  ezUInt32 uiNumTiles = 0;
+  stream >> uiNumTiles;
+
+  m_Tiles.SetCount(uiNumTiles);
+  for (auto& tile : m_Tiles)
+  {
+    EZ_SUCCEED_OR_RETURN(tile.Deserialize(stream));
+  }
+
+  return EZ_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+ezRecastNavMeshResource::ezRecastNavMeshResource()
+  : ezResource(DoUpdate::OnAnyThread, 1)
+{
+  ModifyMemoryUsage().m_uiMemoryCPU = sizeof(ezRecastNavMeshResource);
+}
+
+ezRecastNavMeshResource::~ezRecastNavMeshResource()
+{
+  EZ_DEFAULT_DELETE(m_pNavMesh);
+}
+
+ezResourceLoadDesc ezRecastNavMeshResource::UnloadData(Unload WhatToUnload)
+{
+  ezResourceLoadDesc res;
+  res.m_uiQualityLevelsDiscardable = 0;
+  res.m_uiQualityLevelsLoadable = 0;
+  res.m_State = ezResourceState::Unloaded;
+
+  // the navmesh references the tile data, so it has to go first
+  EZ_DEFAULT_DELETE(m_pNavMesh);
+  m_Tiles.Clear();
+
+  return res;
+}
+
+ezResourceLoadDesc ezRecastNavMeshResource::UpdateContent(ezStreamReader* Stream)
+{
+  EZ_LOG_BLOCK("ezRecastNavMeshResource::UpdateContent", GetResourceDescription().GetData());
+
+  ezResourceLoadDesc res;
+  res.m_uiQualityLevelsDiscardable = 0;
+  res.m_uiQualityLevelsLoadable = 0;
+
+  if (Stream == nullptr)
+  {
+    res.m_State = ezResourceState::LoadedResourceMissing;
+    return res;
+  }
+
+  // skip the absolute file path data that the standard file reader writes into the stream
+  {
+    ezStringBuilder sAbsFilePath;
+    (*Stream) >> sAbsFilePath;
+  }
+
+  ezAssetFileHeader AssetHash;
+  AssetHash.Read(*Stream);
+
+  ezRecastNavMeshResourceDescriptor descriptor;
+  descriptor.Deserialize(*Stream);
+
+  return CreateResource(std::move(descriptor));
+}
+
+void ezRecastNavMeshResource::UpdateMemoryUsage(MemoryUsage& out_NewMemoryUsage)
+{
+  out_NewMemoryUsage.m_uiMemoryCPU = sizeof(ezRecastNavMeshResource);
+  out_NewMemoryUsage.m_uiMemoryCPU += m_Tiles.GetHeapMemoryUsage();
+  out_NewMemoryUsage.m_uiMemoryCPU += m_pNavMesh != nullptr ? sizeof(dtNavMesh) : 0;
+
+  for (const auto& tile : m_Tiles)
+  {
+    out_NewMemoryUsage.m_uiMemoryCPU += tile.m_DetourTileData.GetHeapMemoryUsage();
+    out_NewMemoryUsage.m_uiMemoryCPU += tile.m_pPolygons != nullptr ? sizeof(rcPolyMesh) : 0;
+  }
+
+  out_NewMemoryUsage.m_uiMemoryGPU = 0;
+}
+
+ezResourceLoadDesc ezRecastNavMeshResource::CreateResource(ezRecastNavMeshResourceDescriptor&& descriptor)
+{
+  ezResourceLoadDesc res;
+  res.m_uiQualityLevelsDiscardable = 0;
+  res.m_uiQualityLevelsLoadable = 0;
+  res.m_State = ezResourceState::Loaded;
+
+  m_Tiles = std::move(descriptor.m_Tiles);
+
+  int iMaxPolysPerTile = 1;
+  for (const auto& tile : m_Tiles)
+  {
+    if (const dtMeshHeader* pHeader = GetDetourTileHeader(tile.m_DetourTileData))
+    {
+      iMaxPolysPerTile = ezMath::Max(iMaxPolysPerTile, pHeader->polyCount);
+    }
+  }
+
+  dtNavMeshParams params;
+  dtVcopy(params.orig, &descriptor.m_vTileOrigin.x);
+  params.tileWidth = descriptor.m_fTileWidth;
+  params.tileHeight = descriptor.m_fTileHeight;
+  params.maxTiles = ezMath::Max<int>(m_Tiles.GetCount(), 1);
+  params.maxPolys = iMaxPolysPerTile;
+
+  m_pNavMesh = EZ_DEFAULT_NEW(dtNavMesh);
+
+  if (dtStatusFailed(m_pNavMesh->init(&params)))
+  {
+    // with 32 bit polygon references, the number of tiles and the number of polygons per tile share 22 bits
+    ezLog::Error("Navmesh with {} tiles and up to {} polygons per tile cannot be represented, use larger or smaller tiles.", m_Tiles.GetCount(),
+      iMaxPolysPerTile);
+    return res;
+  }
+
+  for (const auto& tile : m_Tiles)
+  {
+    AddTileToNavMesh(tile.m_iTileX, tile.m_iTileY).IgnoreResult();
+  }
+
+  return res;
+}
+
+ezRecastNavMeshTile* ezRecastNavMeshResource::FindTile(ezInt32 iTileX, ezInt32 iTileY)
+{
+  for (auto& tile : m_Tiles)
+  {
+    if (tile.m_iTileX == iTileX && tile.m_iTileY == iTileY)
+      return &tile;
+  }
+
+  return nullptr;
+}
+
+ezResult ezRecastNavMeshResource::AddTileToNavMesh(ezInt32 iTileX, ezInt32 iTileY)
+{
+  ezRecastNavMeshTile* pTile = FindTile(iTileX, iTileY);
+  if (m_pNavMesh == nullptr || pTile == nullptr || pTile->m_DetourTileData.IsEmpty())
+    return EZ_FAILURE;
+
+  if (IsTileInNavMesh(iTileX, iTileY))
+    return EZ_SUCCESS;
+
+  // the dtNavMesh does not need to free the data, the resource owns it
+  const int dtTileFlags = 0;
+  if (dtStatusFailed(m_pNavMesh->addTile(pTile->m_DetourTileData.GetData(), pTile->m_DetourTileData.GetCount(), dtTileFlags, 0, nullptr)))
+  {
+    ezLog::Error("Could not add navmesh tile ({}, {})", iTileX, iTileY);
+    return EZ_FAILURE;
+  }
+
+  return EZ_SUCCESS;
+}
+
+ezResult ezRecastNavMeshResource::RemoveTileFromNavMesh(ezInt32 iTileX, ezInt32 iTileY)
+{
+  if (m_pNavMesh == nullptr)
+    return EZ_FAILURE;
+
+  const dtTileRef tileRef = m_pNavMesh->getTileRefAt(iTileX, iTileY, 0);
+  if (tileRef == 0)
+    return EZ_FAILURE;
+
+  // the data is still owned by the resource
+  if (dtStatusFailed(m_pNavMesh->removeTile(tileRef, nullptr, nullptr)))
+    return EZ_FAILURE;
+
+  return EZ_SUCCESS;
+}
+
+bool ezRecastNavMeshResource::IsTileInNavMesh(ezInt32 iTileX, ezInt32 iTileY) const
+{
+  return m_pNavMesh != nullptr && m_pNavMesh->getTileAt(iTileX, iTileY, 0) != nullptr;
+}
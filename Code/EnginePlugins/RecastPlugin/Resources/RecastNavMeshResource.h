@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Core/ResourceManager/Resource.h>
+#include <Foundation/Types/UniquePtr.h>
 #include <RecastPlugin/RecastPluginDLL.h>
 
 struct rcPolyMesh;
@@ -8,6 +9,32 @@ class dtNavMesh;
 
 typedef ezTypedResourceHandle<class ezRecastNavMeshResource> ezRecastNavMeshResourceHandle;
 
+/// \brief One tile of a navmesh. Tiles are built independently and can be added to and removed from the navmesh at runtime.
+struct EZ_RECASTPLUGIN_DLL ezRecastNavMeshTile
+{
+  ezRecastNavMeshTile();
+  ezRecastNavMeshTile(const ezRecastNavMeshTile& rhs) = delete;
+  ezRecastNavMeshTile(ezRecastNavMeshTile&& rhs);
+  ~ezRecastNavMeshTile();
+  void operator=(ezRecastNavMeshTile&& rhs);
+  void operator=(const ezRecastNavMeshTile& rhs) = delete;
+
+  ezInt32 m_iTileX = 0;
+  ezInt32 m_iTileY = 0;
+
+  /// \brief Hash of the geometry and the configuration that the tile was built from, to detect which tiles need to be rebuilt.
+  ezUInt64 m_uiInputHash = 0;
+
+  /// \brief Data that was created by dtCreateNavMeshData() and will be used for dtNavMesh::addTile()
+  ezDataBuffer m_DetourTileData;
+
+  /// \brief Optional, if available the tile can be visualized at runtime
+  ezUniquePtr<rcPolyMesh> m_pPolygons;
+
+  ezResult Serialize(ezStreamWriter& stream) const;
+  ezResult Deserialize(ezStreamReader& stream);
+};
+
 struct EZ_RECASTPLUGIN_DLL ezRecastNavMeshResourceDescriptor
 {
   ezRecastNavMeshResourceDescriptor();
@@ -17,11 +44,17 @@ struct EZ_RECASTPLUGIN_DLL ezRecastNavMeshResourceDescriptor
   void operator=(ezRecastNavMeshResourceDescriptor&& rhs);
   void operator=(const ezRecastNavMeshResourceDescriptor& rhs) = delete;
 
-  /// \brief Data that was created by dtCreateNavMeshData() and will be used for dtNavMesh::init()
-  ezDataBuffer m_DetourNavmeshData;
+  /// \brief The origin of the tile grid, in Recast convention (Y up).
+  ezVec3 m_vTileOrigin = ezVec3::ZeroVector();
+
+  /// \brief The size of a tile along Recast's X and Z axis.
+  float m_fTileWidth = 0.0f;
+  float m_fTileHeight = 0.0f;
 
-  /// \brief Optional, if available the navmesh can be visualized at runtime
-  rcPolyMesh* m_pNavMeshPolygons = nullptr;
+  /// \brief Hash of the ezRecastConfig that the tiles were built with. If it changes, all tiles have to be rebuilt.
+  ezUInt64 m_uiConfigHash = 0;
+
+  ezDynamicArray<ezRecastNavMeshTile> m_Tiles;
 
   void Clear();
 
@@ -40,14 +73,30 @@ public:
   ~ezRecastNavMeshResource();
 
   const dtNavMesh* GetNavMesh() const { return m_pNavMesh; }
-  const rcPolyMesh* GetNavMeshPolygons() const { return m_pNavMeshPolygons; }
+
+  /// \brief All tiles of the navmesh, including the ones that are currently not added to the dtNavMesh.
+  ezArrayPtr<const ezRecastNavMeshTile> GetTiles() const { return m_Tiles; }
+
+  /// \brief Whether the given tile is currently part of the dtNavMesh.
+  ///
+  /// All tiles are added to the dtNavMesh when the resource is created. Use ezRecastWorldModule::AddNavMeshTile() and
+  /// ezRecastWorldModule::RemoveNavMeshTile() to remove tiles from the navmesh and add them back at runtime.
+  bool IsTileInNavMesh(ezInt32 iTileX, ezInt32 iTileY) const;
 
 private:
+  friend class ezRecastWorldModule;
+
+  // The dtNavMesh must not change while path queries are in flight, so only the world module calls these, at a time when it has none.
+  // The tile data stays in memory, only the navmesh itself changes.
+  ezResult AddTileToNavMesh(ezInt32 iTileX, ezInt32 iTileY);
+  ezResult RemoveTileFromNavMesh(ezInt32 iTileX, ezInt32 iTileY);
+
   virtual ezResourceLoadDesc UnloadData(Unload WhatToUnload) override;
   virtual ezResourceLoadDesc UpdateContent(ezStreamReader* Stream) override;
   virtual void UpdateMemoryUsage(MemoryUsage& out_NewMemoryUsage) override;
 
-  ezDataBuffer m_DetourNavmeshData;
+  ezRecastNavMeshTile* FindTile(ezInt32 iTileX, ezInt32 iTileY);
+
+  ezDynamicArray<ezRecastNavMeshTile> m_Tiles;
   dtNavMesh* m_pNavMesh = nullptr;
-  rcPolyMesh* m_pNavMeshPolygons = nullptr;
 };
@@ -1,8 +1,11 @@
 #include <RecastPluginPCH.h>
 
 #include <Core/World/World.h>
+#include <Foundation/Profiling/Profiling.h>
 #include <Recast/DetourCrowd.h>
+#include <Recast/Recast.h>
 #include <RecastPlugin/Resources/RecastNavMeshResource.h>
+#include <RecastPlugin/Utils/RcMath.h>
 #include <RecastPlugin/WorldModule/RecastWorldModule.h>
 
 // clang-format off
@@ -11,9 +14,31 @@ EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezRecastWorldModule, 1, ezRTTINoAllocator)
 EZ_END_DYNAMIC_REFLECTED_TYPE;
 // clang-format on
 
+/// \todo Hard-coded limits
+static constexpr int s_iMaxSearchNodes = 512;
+static constexpr ezUInt32 s_uiMaxPathCorridorLength = 256;
+
+/// \brief Processes the queued path queries, each invocation uses its own dtNavMeshQuery.
+class ezRecastPathQueryTask final : public ezTask
+{
+public:
+  ezRecastPathQueryTask(ezRecastWorldModule* pModule)
+    : m_pModule(pModule)
+  {
+    ConfigureTask("Recast Path Queries", ezTaskNesting::Never);
+  }
+
+private:
+  virtual void ExecuteWithMultiplicity(ezUInt32 uiInvocation) const override { m_pModule->ProcessPathQueries(uiInvocation); }
+
+  ezRecastWorldModule* m_pModule = nullptr;
+};
+
 ezRecastWorldModule::ezRecastWorldModule(ezWorld* pWorld)
   : ezWorldModule(pWorld)
 {
+  m_pNavMeshQuery = EZ_DEFAULT_NEW(dtNavMeshQuery);
+  m_pPathQueryTask = EZ_DEFAULT_NEW(ezRecastPathQueryTask, this);
 }
 
 ezRecastWorldModule::~ezRecastWorldModule() = default;
@@ -26,11 +51,31 @@ void ezRecastWorldModule::Initialize()
     auto updateDesc = EZ_CREATE_MODULE_UPDATE_FUNCTION_DESC(ezRecastWorldModule::UpdateNavMesh, this);
     updateDesc.m_Phase = ezWorldModule::UpdateFunctionDesc::Phase::PostAsync;
     updateDesc.m_bOnlyUpdateWhenSimulating = false;
+    // Lower than FinishPathQueries, so that no path queries are in flight when tiles are added or removed.
     updateDesc.m_fPriority = 0.0f;
 
     RegisterUpdateFunction(updateDesc);
   }
 
+  {
+    auto startDesc = EZ_CREATE_MODULE_UPDATE_FUNCTION_DESC(ezRecastWorldModule::StartPathQueries, this);
+    startDesc.m_Phase = ezWorldModule::UpdateFunctionDesc::Phase::PreAsync;
+    startDesc.m_bOnlyUpdateWhenSimulating = true;
+    // Start as late as possible, so that the requests of all agents from this frame are included.
+    startDesc.m_fPriority = -100000.0f;
+
+    RegisterUpdateFunction(startDesc);
+  }
+
+  {
+    auto finishDesc = EZ_CREATE_MODULE_UPDATE_FUNCTION_DESC(ezRecastWorldModule::FinishPathQueries, this);
+    finishDesc.m_Phase = ezWorldModule::UpdateFunctionDesc::Phase::PostAsync;
+    finishDesc.m_bOnlyUpdateWhenSimulating = true;
+    finishDesc.m_fPriority = 100000.0f;
+
+    RegisterUpdateFunction(finishDesc);
+  }
+
   ezResourceManager::GetResourceEvents().AddEventHandler(ezMakeDelegate(&ezRecastWorldModule::ResourceEventHandler, this));
 }
 
@@ -38,14 +83,22 @@ void ezRecastWorldModule::Deinitialize()
 {
   ezResourceManager::GetResourceEvents().RemoveEventHandler(ezMakeDelegate(&ezRecastWorldModule::ResourceEventHandler, this));
 
+  ezTaskSystem::WaitForGroup(m_PathQueryTaskGroup);
+  m_PathQueriesInFlight.Clear();
+  m_PendingPathQueries.Clear();
+  m_PathQueryObjects.Clear();
+
   SUPER::Deinitialize();
 }
 
 void ezRecastWorldModule::SetNavMeshResource(const ezRecastNavMeshResourceHandle& hNavMesh)
 {
+  AbortPathQueriesInFlight();
+
   m_hNavMesh = hNavMesh;
   m_pDetourNavMesh = nullptr;
   m_pNavMeshPointsOfInterest.Clear();
+  m_PendingTileChanges.Clear();
 }
 
 void ezRecastWorldModule::UpdateNavMesh(const UpdateContext& ctxt)
@@ -58,9 +111,47 @@ void ezRecastWorldModule::UpdateNavMesh(const UpdateContext& ctxt)
       return;
 
     m_pDetourNavMesh = pNavMesh->GetNavMesh();
+    m_pNavMeshQuery->init(m_pDetourNavMesh, s_iMaxSearchNodes);
+
+    // the worker query objects are recreated for the new navmesh
+    m_PathQueryObjects.Clear();
 
     m_pNavMeshPointsOfInterest = EZ_DEFAULT_NEW(ezNavMeshPointOfInterestGraph);
-    m_pNavMeshPointsOfInterest->ExtractInterestPointsFromMesh(*pNavMesh->GetNavMeshPolygons());
+
+    // the graph has to cover all tiles, so it is initialized once and the tiles are added one by one
+    {
+      ezBoundingBox box;
+      box.SetInvalid();
+
+      for (const ezRecastNavMeshTile& tile : pNavMesh->GetTiles())
+      {
+        if (tile.m_pPolygons == nullptr)
+          continue;
+
+        const rcPolyMesh& mesh = *tile.m_pPolygons;
+        box.ExpandToInclude(ezVec3(mesh.bmin[0], mesh.bmin[2], mesh.bmin[1]));
+        box.ExpandToInclude(ezVec3(mesh.bmax[0], mesh.bmax[2], mesh.bmax[1]));
+      }
+
+      if (box.IsValid())
+      {
+        box.Grow(ezVec3(1.0f));
+        m_pNavMeshPointsOfInterest->GetGraph().Initialize(box.GetCenter(), box.GetHalfExtents());
+
+        for (const ezRecastNavMeshTile& tile : pNavMesh->GetTiles())
+        {
+          if (tile.m_pPolygons != nullptr)
+          {
+            m_pNavMeshPointsOfInterest->ExtractInterestPointsFromMesh(*tile.m_pPolygons, false);
+          }
+        }
+      }
+    }
+  }
+
+  if (m_pDetourNavMesh != nullptr)
+  {
+    ApplyTileChanges();
   }
 
   if (m_pNavMeshPointsOfInterest)
@@ -69,11 +160,333 @@ void ezRecastWorldModule::UpdateNavMesh(const UpdateContext& ctxt)
   }
 }
 
+void ezRecastWorldModule::AddNavMeshTile(ezInt32 iTileX, ezInt32 iTileY)
+{
+  TileChange& change = m_PendingTileChanges.ExpandAndGetRef();
+  change.m_iTileX = iTileX;
+  change.m_iTileY = iTileY;
+  change.m_bAdd = true;
+}
+
+void ezRecastWorldModule::RemoveNavMeshTile(ezInt32 iTileX, ezInt32 iTileY)
+{
+  TileChange& change = m_PendingTileChanges.ExpandAndGetRef();
+  change.m_iTileX = iTileX;
+  change.m_iTileY = iTileY;
+  change.m_bAdd = false;
+}
+
+void ezRecastWorldModule::ApplyTileChanges()
+{
+  if (m_PendingTileChanges.IsEmpty())
+    return;
+
+  EZ_ASSERT_DEV(m_PathQueriesInFlight.IsEmpty(), "The navmesh must not change while path queries are in flight");
+
+  EZ_PROFILE_SCOPE("Apply NavMesh Tile Changes");
+
+  ezResourceLock<ezRecastNavMeshResource> pNavMesh(m_hNavMesh, ezResourceAcquireMode::BlockTillLoaded_NeverFail);
+  if (pNavMesh.GetAcquireResult() != ezResourceAcquireResult::Final)
+    return;
+
+  // applied in the order of the requests, so that the last request for a tile wins
+  for (const TileChange& change : m_PendingTileChanges)
+  {
+    if (change.m_bAdd)
+    {
+      if (pNavMesh->AddTileToNavMesh(change.m_iTileX, change.m_iTileY).Failed())
+      {
+        ezLog::Warning("Navmesh tile ({}, {}) could not be added", change.m_iTileX, change.m_iTileY);
+      }
+    }
+    else
+    {
+      pNavMesh->RemoveTileFromNavMesh(change.m_iTileX, change.m_iTileY).IgnoreResult();
+    }
+  }
+
+  m_PendingTileChanges.Clear();
+}
+
 void ezRecastWorldModule::ResourceEventHandler(const ezResourceEvent& e)
 {
   if (e.m_Type == ezResourceEvent::Type::ResourceContentUnloading && e.m_pResource->GetDynamicRTTI()->IsDerivedFrom<ezRecastNavMeshResource>())
   {
+    // the queries in flight may still access the old navmesh
+    AbortPathQueriesInFlight();
+
     // triggers a recreation in the next update
     m_pDetourNavMesh = nullptr;
   }
 }
+
+ezResult ezRecastWorldModule::FindNavMeshPolyAt(const dtNavMeshQuery& query, const dtQueryFilter& filter, const ezVec3& vPosition,
+  dtPolyRef& out_PolyRef, ezVec3* out_vAdjustedPosition /*= nullptr*/, float fPlaneEpsilon /*= 0.01f*/, float fHeightEpsilon /*= 1.0f*/)
+{
+  ezRcPos rcPos = vPosition;
+  ezVec3 vSize(fPlaneEpsilon, fHeightEpsilon, fPlaneEpsilon);
+
+  ezRcPos resultPos;
+  if (dtStatusFailed(query.findNearestPoly(rcPos, &vSize.x, &filter, &out_PolyRef, resultPos)))
+    return EZ_FAILURE;
+
+  if (!ezMath::IsEqual(vPosition.x, resultPos.m_Pos[0], fPlaneEpsilon) || !ezMath::IsEqual(vPosition.y, resultPos.m_Pos[2], fPlaneEpsilon) ||
+      !ezMath::IsEqual(vPosition.z, resultPos.m_Pos[1], fHeightEpsilon))
+    return EZ_FAILURE;
+
+  if (out_vAdjustedPosition != nullptr)
+  {
+    *out_vAdjustedPosition = resultPos;
+  }
+
+  return EZ_SUCCESS;
+}
+
+ezUInt32 ezRecastWorldModule::RequestPath(const ezVec3& vStart, const ezVec3& vTarget, PathQueryCallback callback)
+{
+  // zero is never used as an ID, so that it can be used for 'no request'
+  if (++m_uiNextPathQueryID == 0)
+    ++m_uiNextPathQueryID;
+
+  PathQuery& query = m_PendingPathQueries.ExpandAndGetRef();
+  query.m_vStart = vStart;
+  query.m_RequestTime = ezTime::Now();
+  query.m_uiRequestFrame = m_uiPathQueryFrame;
+  query.m_Callback = callback;
+  query.m_Result.m_uiRequestID = m_uiNextPathQueryID;
+  query.m_Result.m_vTargetPosition = vTarget;
+
+  m_PathQueryStats.m_uiNumPendingQueries = m_PendingPathQueries.GetCount();
+
+  return m_uiNextPathQueryID;
+}
+
+void ezRecastWorldModule::CancelPathQuery(ezUInt32 uiRequestID)
+{
+  if (uiRequestID == 0)
+    return;
+
+  for (ezUInt32 i = 0; i < m_PendingPathQueries.GetCount(); ++i)
+  {
+    if (m_PendingPathQueries[i].m_Result.m_uiRequestID == uiRequestID)
+    {
+      m_PendingPathQueries.RemoveAtAndCopy(i);
+      m_PathQueryStats.m_uiNumPendingQueries = m_PendingPathQueries.GetCount();
+      return;
+    }
+  }
+
+  // the worker tasks never look at this flag, it is only checked before the result is delivered
+  for (PathQuery& query : m_PathQueriesInFlight)
+  {
+    if (query.m_Result.m_uiRequestID == uiRequestID)
+    {
+      query.m_bCanceled = true;
+      return;
+    }
+  }
+}
+
+void ezRecastWorldModule::SetPathQueryBudget(ezUInt32 uiMaxQueriesPerFrame, ezTime maxTimePerFrame)
+{
+  m_uiMaxPathQueriesPerFrame = ezMath::Max(uiMaxQueriesPerFrame, 1u);
+  m_MaxPathQueryTimePerFrame = maxTimePerFrame;
+}
+
+void ezRecastWorldModule::ResetPathQueryStats()
+{
+  const ezUInt32 uiNumPending = m_PathQueryStats.m_uiNumPendingQueries;
+
+  m_PathQueryStats = ezRecastPathQueryStats();
+  m_PathQueryStats.m_uiNumPendingQueries = uiNumPending;
+  m_TotalPathQueryLatency.SetZero();
+}
+
+void ezRecastWorldModule::StartPathQueries(const UpdateContext& ctxt)
+{
+  ++m_uiPathQueryFrame;
+
+  if (m_pDetourNavMesh == nullptr || m_PendingPathQueries.IsEmpty() || !m_PathQueriesInFlight.IsEmpty())
+    return;
+
+  EZ_PROFILE_SCOPE("Start Path Queries");
+
+  const ezUInt32 uiNumQueries = ezMath::Min(m_PendingPathQueries.GetCount(), m_uiMaxPathQueriesPerFrame);
+  m_PathQueriesInFlight.SetCount(uiNumQueries);
+  for (ezUInt32 i = 0; i < uiNumQueries; ++i)
+  {
+    m_PathQueriesInFlight[i] = std::move(m_PendingPathQueries[i]);
+  }
+  m_PendingPathQueries.PopFront(uiNumQueries);
+
+  const ezUInt32 uiNumWorkers = ezMath::Max(ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::ShortTasks), 1u);
+  const ezUInt32 uiNumInvocations = ezMath::Min(uiNumQueries, uiNumWorkers);
+
+  for (ezUInt32 i = m_PathQueryObjects.GetCount(); i < uiNumInvocations; ++i)
+  {
+    ezUniquePtr<dtNavMeshQuery>& pQuery = m_PathQueryObjects.ExpandAndGetRef();
+    pQuery = EZ_DEFAULT_NEW(dtNavMeshQuery);
+    pQuery->init(m_pDetourNavMesh, s_iMaxSearchNodes);
+  }
+
+  m_PathQueryTaskTimes.SetCount(uiNumInvocations);
+  m_iNextPathQueryToProcess = 0;
+  m_PathQueryDeadline = ezTime::Now() + m_MaxPathQueryTimePerFrame;
+
+  m_pPathQueryTask->SetMultiplicity(uiNumInvocations);
+  m_PathQueryTaskGroup = ezTaskSystem::StartSingleTask(m_pPathQueryTask, ezTaskPriority::EarlyThisFrame);
+}
+
+void ezRecastWorldModule::ProcessPathQueries(ezUInt32 uiInvocation)
+{
+  dtNavMeshQuery& query = *m_PathQueryObjects[uiInvocation].Borrow();
+  const ezUInt32 uiNumQueries = m_PathQueriesInFlight.GetCount();
+
+  const ezTime tStart = ezTime::Now();
+  ezTime tNow = tStart;
+
+  // always process at least one query, even if the deadline has passed before this task got to run
+  do
+  {
+    const ezUInt32 uiQuery = static_cast<ezUInt32>(m_iNextPathQueryToProcess.PostIncrement());
+    if (uiQuery >= uiNumQueries)
+      break;
+
+    ExecutePathQuery(query, m_PathQueriesInFlight[uiQuery]);
+    tNow = ezTime::Now();
+
+  } while (tNow < m_PathQueryDeadline);
+
+  m_PathQueryTaskTimes[uiInvocation] = tNow - tStart;
+}
+
+void ezRecastWorldModule::ExecutePathQuery(dtNavMeshQuery& query, PathQuery& pathQuery) const
+{
+  ezRecastPathQueryResult& result = pathQuery.m_Result;
+  pathQuery.m_bProcessed = true;
+
+  dtPolyRef startPoly;
+  if (FindNavMeshPolyAt(query, m_PathQueryFilter, pathQuery.m_vStart, startPoly, &result.m_vStartPosition).Failed())
+  {
+    result.m_Status = ezRecastPathQueryStatus::StartOutsideNavMesh;
+    return;
+  }
+
+  dtPolyRef endPoly;
+  if (FindNavMeshPolyAt(query, m_PathQueryFilter, result.m_vTargetPosition, endPoly).Failed())
+  {
+    result.m_Status = ezRecastPathQueryStatus::TargetOutsideNavMesh;
+    return;
+  }
+
+  ezRcPos rcStart = result.m_vStartPosition;
+  ezRcPos rcEnd = result.m_vTargetPosition;
+
+  ezInt32 iPathCorridorLength = 0;
+
+  // make enough room
+  result.m_PathCorridor.SetCountUninitialized(s_uiMaxPathCorridorLength);
+  if (dtStatusFailed(query.findPath(startPoly, endPoly, rcStart, rcEnd, &m_PathQueryFilter, result.m_PathCorridor.GetData(),
+        &iPathCorridorLength, (int)result.m_PathCorridor.GetCount())) ||
+      iPathCorridorLength <= 0)
+  {
+    result.m_PathCorridor.Clear();
+    result.m_Status = ezRecastPathQueryStatus::NoPath;
+    return;
+  }
+
+  // reduce to actual length
+  result.m_PathCorridor.SetCountUninitialized(iPathCorridorLength);
+
+  // if the path does not end at the target polygon, the target position cannot be reached, but one can get close to it
+  result.m_Status = (result.m_PathCorridor.PeekBack() == endPoly) ? ezRecastPathQueryStatus::Success : ezRecastPathQueryStatus::PartialPath;
+}
+
+void ezRecastWorldModule::FinishPathQueries(const UpdateContext& ctxt)
+{
+  if (m_PathQueriesInFlight.IsEmpty())
+  {
+    m_PathQueryStats.m_uiNumQueriesLastFrame = 0;
+    m_PathQueryStats.m_QueryTimeLastFrame.SetZero();
+    return;
+  }
+
+  {
+    EZ_PROFILE_SCOPE("Wait for Path Queries");
+    ezTaskSystem::WaitForGroup(m_PathQueryTaskGroup);
+  }
+
+  EZ_PROFILE_SCOPE("Deliver Path Queries");
+
+  m_PathQueryStats.m_QueryTimeLastFrame.SetZero();
+  for (ezTime taskTime : m_PathQueryTaskTimes)
+  {
+    m_PathQueryStats.m_QueryTimeLastFrame += taskTime;
+  }
+
+  // queries that did not fit into the time budget go back to the front of the queue, in their original order
+  for (ezUInt32 i = m_PathQueriesInFlight.GetCount(); i > 0; --i)
+  {
+    PathQuery& query = m_PathQueriesInFlight[i - 1];
+    if (!query.m_bProcessed && !query.m_bCanceled)
+    {
+      m_PendingPathQueries.PushFront(std::move(query));
+    }
+  }
+
+  const ezTime tNow = ezTime::Now();
+  ezUInt32 uiNumProcessed = 0;
+
+  // callbacks may request new queries or cancel queries that have not been delivered yet
+  for (ezUInt32 i = 0; i < m_PathQueriesInFlight.GetCount(); ++i)
+  {
+    PathQuery& query = m_PathQueriesInFlight[i];
+    if (!query.m_bProcessed)
+      continue;
+
+    ++uiNumProcessed;
+
+    if (query.m_bCanceled)
+      continue;
+
+    query.m_Result.m_Latency = tNow - query.m_RequestTime;
+
+    m_TotalPathQueryLatency += query.m_Result.m_Latency;
+    m_PathQueryStats.m_uiTotalNumQueries++;
+    m_PathQueryStats.m_MaxLatency = ezMath::Max(m_PathQueryStats.m_MaxLatency, query.m_Result.m_Latency);
+    m_PathQueryStats.m_uiMaxLatencyFrames =
+      ezMath::Max(m_PathQueryStats.m_uiMaxLatencyFrames, static_cast<ezUInt32>(m_uiPathQueryFrame - query.m_uiRequestFrame));
+
+    query.m_Callback(query.m_Result);
+  }
+
+  m_PathQueryStats.m_uiNumQueriesLastFrame = uiNumProcessed;
+  m_PathQueryStats.m_uiNumPendingQueries = m_PendingPathQueries.GetCount();
+
+  if (m_PathQueryStats.m_uiTotalNumQueries > 0)
+  {
+    m_PathQueryStats.m_AverageLatency = m_TotalPathQueryLatency / static_cast<double>(m_PathQueryStats.m_uiTotalNumQueries);
+  }
+
+  m_PathQueriesInFlight.Clear();
+}
+
+void ezRecastWorldModule::AbortPathQueriesInFlight()
+{
+  ezTaskSystem::WaitForGroup(m_PathQueryTaskGroup);
+
+  // the results may reference the old navmesh, so all queries in flight are repeated
+  for (ezUInt32 i = m_PathQueriesInFlight.GetCount(); i > 0; --i)
+  {
+    PathQuery& query = m_PathQueriesInFlight[i - 1];
+    if (!query.m_bCanceled)
+    {
+      query.m_bProcessed = false;
+      query.m_Result.m_PathCorridor.Clear();
+      m_PendingPathQueries.PushFront(std::move(query));
+    }
+  }
+
+  m_PathQueriesInFlight.Clear();
+  m_PathQueryStats.m_uiNumPendingQueries = m_PendingPathQueries.GetCount();
+}
@@ -4,7 +4,11 @@
 
 #include <Core/ResourceManager/ResourceHandle.h>
 #include <Core/World/WorldModule.h>
+#include <Foundation/Containers/Deque.h>
+#include <Foundation/Threading/AtomicInteger.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <NavMeshBuilder/NavMeshPointsOfInterest.h>
+#include <Recast/DetourNavMeshQuery.h>
 
 class dtCrowd;
 class dtNavMesh;
@@ -12,6 +16,44 @@ struct ezResourceEvent;
 
 typedef ezTypedResourceHandle<class ezRecastNavMeshResource> ezRecastNavMeshResourceHandle;
 
+/// \brief The outcome of a path query, see ezRecastWorldModule::RequestPath().
+struct ezRecastPathQueryStatus
+{
+  typedef ezUInt8 StorageType;
+
+  enum Enum
+  {
+    Success,              ///< A path to the target position was found.
+    PartialPath,          ///< The target cannot be reached, the path leads to the closest reachable polygon.
+    StartOutsideNavMesh,  ///< There is no navmesh polygon at the start position.
+    TargetOutsideNavMesh, ///< There is no navmesh polygon at the target position.
+    NoPath,               ///< The path search failed.
+
+    Default = NoPath
+  };
+};
+
+struct ezRecastPathQueryResult
+{
+  ezUInt32 m_uiRequestID = 0;
+  ezEnum<ezRecastPathQueryStatus> m_Status;
+  ezVec3 m_vStartPosition;                  ///< The start position projected onto the navmesh.
+  ezVec3 m_vTargetPosition;                 ///< The target position as it was requested.
+  ezDynamicArray<dtPolyRef> m_PathCorridor; ///< The navmesh polygons from the start to the target (or the closest reachable) position.
+  ezTime m_Latency;                         ///< How long it took from the request until the result was delivered.
+};
+
+struct ezRecastPathQueryStats
+{
+  ezUInt32 m_uiNumPendingQueries = 0;   ///< Queries that wait to be processed.
+  ezUInt32 m_uiNumQueriesLastFrame = 0; ///< Queries that were processed in the last frame.
+  ezTime m_QueryTimeLastFrame;          ///< Time that all worker tasks together spent on path queries in the last frame.
+  ezUInt64 m_uiTotalNumQueries = 0;     ///< Queries that were delivered since the stats were reset.
+  ezTime m_AverageLatency;
+  ezTime m_MaxLatency;
+  ezUInt32 m_uiMaxLatencyFrames = 0; ///< The most frames that a query had to wait for its result.
+};
+
 class EZ_RECASTPLUGIN_DLL ezRecastWorldModule : public ezWorldModule
 {
   EZ_DECLARE_WORLD_MODULE();
@@ -31,11 +73,109 @@ public:
   const ezNavMeshPointOfInterestGraph* GetNavMeshPointsOfInterestGraph() const { return m_pNavMeshPointsOfInterest.Borrow(); }
   ezNavMeshPointOfInterestGraph* AccessNavMeshPointsOfInterestGraph() const { return m_pNavMeshPointsOfInterest.Borrow(); }
 
+  /// \brief A query object for the current navmesh that can be used on the main thread, e.g. by agents during their update.
+  ///
+  /// Returns nullptr as long as no navmesh is available.
+  dtNavMeshQuery* GetNavMeshQuery() const { return m_pDetourNavMesh != nullptr ? m_pNavMeshQuery.Borrow() : nullptr; }
+
+  /// \brief Finds the navmesh polygon at vPosition. Fails if the closest polygon is further away than the given epsilons.
+  static ezResult FindNavMeshPolyAt(const dtNavMeshQuery& query, const dtQueryFilter& filter, const ezVec3& vPosition,
+    dtPolyRef& out_PolyRef, ezVec3* out_vAdjustedPosition = nullptr, float fPlaneEpsilon = 0.01f, float fHeightEpsilon = 1.0f);
+
+  /// \name Path Queries
+  ///@{
+
+  typedef ezDelegate<void(ezRecastPathQueryResult&)> PathQueryCallback;
+
+  /// \brief Queues a path search from vStart to vTarget and returns an ID for the request.
+  ///
+  /// Queued requests are processed in batches on worker tasks during the asynchronous update phase,
+  /// within the budget set through SetPathQueryBudget(). The callback is executed on the main thread,
+  /// at the end of the frame in which the query was processed.
+  /// Requests that do not fit into the budget of one frame are processed in one of the next frames.
+  /// The callback is never executed from within RequestPath() itself.
+  ///
+  /// All path query functions must only be called from the main thread.
+  ezUInt32 RequestPath(const ezVec3& vStart, const ezVec3& vTarget, PathQueryCallback callback);
+
+  /// \brief Removes a request from the queue. Its callback will not be executed.
+  ///
+  /// Must be called for all pending requests whose callback is about to become invalid.
+  void CancelPathQuery(ezUInt32 uiRequestID);
+
+  /// \brief Limits how many path queries are processed per frame and how long the worker tasks may work on them.
+  ///
+  /// Each worker task processes at least one query per frame, so the time limit cannot stall the queue.
+  void SetPathQueryBudget(ezUInt32 uiMaxQueriesPerFrame, ezTime maxTimePerFrame);
+
+  const ezRecastPathQueryStats& GetPathQueryStats() const { return m_PathQueryStats; }
+  void ResetPathQueryStats();
+
+  ///@}
+
+  /// \name Tile Streaming
+  ///
+  /// Tiles of the navmesh can be removed from the dtNavMesh and added back at runtime, for example depending on the distance to the player.
+  /// Path queries read the dtNavMesh on worker tasks, so the changes are queued and applied in the post-async phase,
+  /// after the path queries of the frame have finished.
+  ///@{
+
+  void AddNavMeshTile(ezInt32 iTileX, ezInt32 iTileY);
+  void RemoveNavMeshTile(ezInt32 iTileX, ezInt32 iTileY);
+
+  ///@}
+
 private:
+  struct TileChange
+  {
+    ezInt32 m_iTileX = 0;
+    ezInt32 m_iTileY = 0;
+    bool m_bAdd = false;
+  };
+
+  struct PathQuery
+  {
+    ezVec3 m_vStart;
+    ezTime m_RequestTime;
+    ezUInt64 m_uiRequestFrame = 0;
+    PathQueryCallback m_Callback;
+    bool m_bProcessed = false;
+    bool m_bCanceled = false;
+    ezRecastPathQueryResult m_Result;
+  };
+
+  friend class ezRecastPathQueryTask;
+
   void UpdateNavMesh(const UpdateContext& ctxt);
+  void ApplyTileChanges();
   void ResourceEventHandler(const ezResourceEvent& e);
 
+  void StartPathQueries(const UpdateContext& ctxt);
+  void FinishPathQueries(const UpdateContext& ctxt);
+  void ProcessPathQueries(ezUInt32 uiInvocation);
+  void ExecutePathQuery(dtNavMeshQuery& query, PathQuery& pathQuery) const;
+  void AbortPathQueriesInFlight();
+
   const dtNavMesh* m_pDetourNavMesh = nullptr;
   ezRecastNavMeshResourceHandle m_hNavMesh;
   ezUniquePtr<ezNavMeshPointOfInterestGraph> m_pNavMeshPointsOfInterest;
+  ezUniquePtr<dtNavMeshQuery> m_pNavMeshQuery; // careful, dtNavMeshQuery is not moveable
+  ezDynamicArray<TileChange> m_PendingTileChanges;
+
+  ezUInt32 m_uiNextPathQueryID = 0;
+  ezUInt64 m_uiPathQueryFrame = 0;
+  ezUInt32 m_uiMaxPathQueriesPerFrame = 64;
+  ezTime m_MaxPathQueryTimePerFrame = ezTime::Milliseconds(2);
+  ezRecastPathQueryStats m_PathQueryStats;
+  ezTime m_TotalPathQueryLatency;
+  dtQueryFilter m_PathQueryFilter; /// \todo hard-coded filter
+
+  ezDeque<PathQuery> m_PendingPathQueries;
+  ezDynamicArray<PathQuery> m_PathQueriesInFlight;
+  ezAtomicInteger32 m_iNextPathQueryToProcess;
+  ezTime m_PathQueryDeadline;
+  ezDynamicArray<ezUniquePtr<dtNavMeshQuery>> m_PathQueryObjects; // one per task invocation
+  ezDynamicArray<ezTime> m_PathQueryTaskTimes;                   // one per task invocation
+  ezSharedPtr<ezTask> m_pPathQueryTask;
+  ezTaskGroupID m_PathQueryTaskGroup;
 };
@@ -0,0 +1,299 @@
+#include <FileservePlugin/Client/FileserveClient.h>
+#include <FileservePlugin/Fileserver/Fileserver.h>
+#include <Foundation/Application/Application.h>
+#include <Foundation/Configuration/Startup.h>
+#include <Foundation/IO/FileSystem/FileReader.h>
+#include <Foundation/IO/FileSystem/FileSystem.h>
+#include <Foundation/IO/OSFile.h>
+#include <Foundation/Logging/ConsoleWriter.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Logging/VisualStudioWriter.h>
+#include <Foundation/System/Process.h>
+#include <Foundation/Threading/ThreadUtils.h>
+#include <Foundation/Time/Stopwatch.h>
+#include <Foundation/Utilities/CommandLineUtils.h>
+
+// This sample shows how ezFileserveClient::PrefetchFiles() transfers many files into the local fileserve cache with few round-trips.
+//
+// Without arguments the application runs as the client. A process that runs an ezFileserver never acts as a fileserve client,
+// so the client starts a second instance with '-server', which generates the files and serves them.
+// On platforms where ezProcess cannot launch processes, start 'FileservePrefetch -server' manually before the client.
+//
+// The client prefetches all files and checks that their content is read correctly from the cache.
+// The server checks that every file was requested exactly once, ie. that no file was requested again when the client read it.
+// Both instances return a non-zero exit code when a check fails.
+
+static constexpr ezUInt32 s_uiNumFiles = 500;
+static constexpr ezUInt16 s_uiPort = 1043; // not the default port, so that a running Fileserve application does not interfere
+static const char* s_szMissingFile = "Files/DoesNotExist.txt";
+
+static void BuildFilePath(ezUInt32 uiFile, ezStringBuilder& out_sPath)
+{
+  out_sPath.Format("Files/File{0}.txt", uiFile);
+}
+
+static void BuildFileContent(ezUInt32 uiFile, ezStringBuilder& out_sContent)
+{
+  // files of different sizes, the larger ones are sent in several chunks
+  out_sContent.Format("File {0}\n", uiFile);
+
+  for (ezUInt32 i = 0; i < (uiFile % 50) * 40; ++i)
+  {
+    out_sContent.AppendFormat("Line {0} of file {1}\n", i, uiFile);
+  }
+}
+
+class ezFileservePrefetchApp : public ezApplication
+{
+public:
+  typedef ezApplication SUPER;
+
+  ezFileservePrefetchApp()
+    : ezApplication("FileservePrefetch")
+  {
+  }
+
+  virtual ezResult BeforeCoreSystemsStartup() override
+  {
+    m_bServer = ezCommandLineUtils::GetGlobalInstance()->GetBoolOption("-server");
+
+    // the fileserve plugin does not create a client in tools
+    if (m_bServer)
+    {
+      ezStartup::AddApplicationTag("tool");
+    }
+
+    return SUPER::BeforeCoreSystemsStartup();
+  }
+
+  virtual void AfterCoreSystemsStartup() override
+  {
+    ezGlobalLog::AddLogWriter(ezLogWriter::Console::LogMessageHandler);
+    ezGlobalLog::AddLogWriter(ezLogWriter::VisualStudio::LogMessageHandler);
+
+    // the client mounts the special directory, the server maps it to the folder with the generated files
+    ezFileSystem::SetSpecialDirectory("samplefiles", ezOSFile::GetTempDataFolder("FileservePrefetchSample"));
+  }
+
+  virtual void BeforeCoreSystemsShutdown() override
+  {
+    // prevent further output during shutdown
+    ezGlobalLog::RemoveLogWriter(ezLogWriter::Console::LogMessageHandler);
+    ezGlobalLog::RemoveLogWriter(ezLogWriter::VisualStudio::LogMessageHandler);
+
+    SUPER::BeforeCoreSystemsShutdown();
+  }
+
+  virtual ApplicationExecution Run() override
+  {
+    const ezResult res = m_bServer ? RunServer() : RunClient();
+
+    if (res.Failed())
+    {
+      SetReturnCode(1);
+    }
+
+    return ezApplication::Quit;
+  }
+
+private:
+  ezResult RunServer()
+  {
+    EZ_SUCCEED_OR_RETURN(WriteFiles());
+
+    // the data directories of the client are resolved to absolute paths
+    ezFileSystem::AddDataDirectory("", "Server", ":", ezFileSystem::ReadOnly).IgnoreResult();
+
+    ezUInt32 uiNumFileRequests = 0;
+    bool bClientDisconnected = false;
+
+    ezFileserver server;
+    server.SetPort(s_uiPort);
+    server.m_Events.AddEventHandler([&uiNumFileRequests, &bClientDisconnected](const ezFileserverEvent& e) {
+      if (e.m_Type == ezFileserverEvent::Type::FileDownloadRequest && ezStringUtils::StartsWith(e.m_szPath, "Files/"))
+      {
+        ++uiNumFileRequests;
+      }
+
+      if (e.m_Type == ezFileserverEvent::Type::ClientDisconnected)
+      {
+        bClientDisconnected = true;
+      }
+    });
+
+    server.StartServer();
+    ezLog::Info("Serving {0} files on port {1}", s_uiNumFiles, s_uiPort);
+
+    // the client disconnects when it shuts down, after it has checked the files
+    const ezTime tTimeout = ezTime::Now() + ezTime::Seconds(60);
+    while (!bClientDisconnected && ezTime::Now() < tTimeout)
+    {
+      if (!server.UpdateServer())
+      {
+        ezThreadUtils::Sleep(ezTime::Milliseconds(1));
+      }
+    }
+
+    server.StopServer();
+
+    if (!bClientDisconnected)
+    {
+      ezLog::Error("The client did not finish in time");
+      return EZ_FAILURE;
+    }
+
+    // the prefetch asks for every file once, including the one that does not exist
+    const ezUInt32 uiExpectedRequests = s_uiNumFiles + 1;
+    if (uiNumFileRequests != uiExpectedRequests)
+    {
+      ezLog::Error("The files were requested {0} times, expected {1} requests", uiNumFileRequests, uiExpectedRequests);
+      return EZ_FAILURE;
+    }
+
+    ezLog::Success("Every file was requested exactly once");
+    return EZ_SUCCESS;
+  }
+
+  ezResult WriteFiles() const
+  {
+    const ezString sFolder = ezOSFile::GetTempDataFolder("FileservePrefetchSample");
+    ezStringBuilder sPath, sContent;
+
+    for (ezUInt32 i = 0; i < s_uiNumFiles; ++i)
+    {
+      BuildFilePath(i, sPath);
+      sPath.Prepend(sFolder, "/");
+      BuildFileContent(i, sContent);
+
+      ezOSFile file;
+      if (file.Open(sPath, ezFileOpenMode::Write).Failed() || file.Write(sContent.GetData(), sContent.GetElementCount()).Failed())
+      {
+        ezLog::Error("Failed to write '{0}'", sPath);
+        return EZ_FAILURE;
+      }
+    }
+
+    sPath = sFolder;
+    sPath.AppendPath(s_szMissingFile);
+    ezOSFile::DeleteFile(sPath).IgnoreResult();
+
+    return EZ_SUCCESS;
+  }
+
+  ezResult RunClient()
+  {
+    ezFileserveClient* pClient = ezFileserveClient::GetSingleton();
+    if (pClient == nullptr)
+    {
+      ezLog::Error("The fileserve client is not available, it may have been disabled with '-fs_off'");
+      return EZ_FAILURE;
+    }
+
+#if EZ_ENABLED(EZ_PLATFORM_WINDOWS_DESKTOP)
+    {
+      ezProcessOptions opt;
+      opt.m_sProcess = GetArgument(0);
+      opt.m_Arguments.PushBack("-server");
+      opt.m_bHideConsoleWindow = false;
+
+      // the server quits by itself when the client disconnects
+      ezProcess serverProcess;
+      if (serverProcess.Launch(opt, ezProcessLaunchFlags::Detached).Failed())
+      {
+        ezLog::Error("Failed to launch the server process");
+        return EZ_FAILURE;
+      }
+    }
+#else
+    ezLog::Info("Connecting to 'FileservePrefetch -server'");
+#endif
+
+    ezStringBuilder sAddress;
+    sAddress.Format("localhost:{0}", s_uiPort);
+    pClient->AddServerAddressToTry(sAddress);
+
+    if (pClient->EnsureConnected(ezTime::Seconds(30)).Failed())
+    {
+      ezLog::Error("Could not connect to the server at '{0}'", sAddress);
+      return EZ_FAILURE;
+    }
+
+    // this is the only data directory, so all files are read from the fileserve cache
+    if (ezFileSystem::AddDataDirectory(">samplefiles/", "FileservePrefetch", "sample").Failed())
+    {
+      ezLog::Error("Failed to mount the fileserve data directory");
+      return EZ_FAILURE;
+    }
+
+    ezDynamicArray<ezString> files;
+    files.Reserve(s_uiNumFiles + 1);
+
+    ezStringBuilder sFile;
+    for (ezUInt32 i = 0; i < s_uiNumFiles; ++i)
+    {
+      BuildFilePath(i, sFile);
+      files.PushBack(sFile);
+    }
+
+    files.PushBack(s_szMissingFile);
+
+    ezStopwatch sw;
+
+    if (pClient->PrefetchFiles(files).Failed())
+    {
+      ezLog::Error("Prefetching the files failed");
+      return EZ_FAILURE;
+    }
+
+    ezLog::Info("Prefetched {0} files in {1} ms", files.GetCount(), ezArgF(sw.GetRunningTotal().GetMilliseconds(), 1));
+
+    return CheckCachedFiles();
+  }
+
+  ezResult CheckCachedFiles() const
+  {
+    ezStringBuilder sFile, sExpected;
+    ezDynamicArray<ezUInt8> content;
+    ezUInt32 uiNumErrors = 0;
+
+    for (ezUInt32 i = 0; i < s_uiNumFiles; ++i)
+    {
+      BuildFilePath(i, sFile);
+      BuildFileContent(i, sExpected);
+
+      ezFileReader file;
+      if (file.Open(sFile).Failed())
+      {
+        ezLog::Error("'{0}' is not in the fileserve cache", sFile);
+        ++uiNumErrors;
+        continue;
+      }
+
+      content.SetCountUninitialized((ezUInt32)file.GetFileSize());
+      const ezUInt64 uiRead = file.ReadBytes(content.GetData(), content.GetCount());
+
+      if (uiRead != sExpected.GetElementCount() || !ezMemoryUtils::IsEqual(content.GetData(), (const ezUInt8*)sExpected.GetData(), content.GetCount()))
+      {
+        ezLog::Error("The cached content of '{0}' does not match the file on the server", sFile);
+        ++uiNumErrors;
+      }
+    }
+
+    // files that don't exist on the server are cached as such as well
+    if (ezFileSystem::ExistsFile(s_szMissingFile))
+    {
+      ezLog::Error("'{0}' does not exist on the server, but it was found", s_szMissingFile);
+      ++uiNumErrors;
+    }
+
+    if (uiNumErrors > 0)
+      return EZ_FAILURE;
+
+    ezLog::Success("All {0} files were read from the fileserve cache", s_uiNumFiles);
+    return EZ_SUCCESS;
+  }
+
+  bool m_bServer = false;
+};
+
+EZ_CONSOLEAPP_ENTRY_POINT(ezFileservePrefetchApp);
@@ -18,6 +18,7 @@ Options to be specific:
 -pack "path/to/folder" "path/to/another/folder" ...
 -unpack "path/to/file.ezArchive" "another/file.ezArchive"
 -out "path/to/file/or/folder"
+-dict
 
 -pack and -unpack can take multiple inputs to either aggregate multiple folders into one archive (pack)
 or to unpack multiple archives at the same time.
@@ -28,6 +29,9 @@ For unpacking the target should be a folder (may or may not exist) into which th
 
 If no -out is specified, it is determined to be where the input file is located.
 
+-dict trains zstd dictionaries for small files of the same type when packing. This improves the compression of many small files,
+but the archive can then only be read by engine versions that support dictionaries.
+
 If neither -pack nor -unpack is specified, the mode is detected automatically from the list of inputs.
 If all inputs are folders, mode is going to be 'pack'.
 If all inputs are files, mode is going to be 'unpack'.
@@ -100,6 +104,7 @@ public:
 
   ezDynamicArray<ezString> m_sInputs;
   ezString m_sOutput;
+  bool m_bTrainDictionaries = false;
 
   ezArchiveTool()
     : ezApplication("ArchiveTool")
@@ -117,6 +122,7 @@ public:
     ezCommandLineUtils& cmd = *ezCommandLineUtils::GetGlobalInstance();
 
     m_sOutput = cmd.GetStringOption("-out");
+    m_bTrainDictionaries = cmd.GetBoolOption("-dict");
 
     ezStringBuilder path;
 
@@ -176,6 +182,9 @@ public:
         if (ezStringUtils::IsEqual_NoCase(szArg, "-out"))
           break;
 
+        if (ezStringUtils::IsEqual_NoCase(szArg, "-dict"))
+          continue;
+
         m_sInputs.PushBack(ezOSFile::MakePathAbsoluteWithCWD(szArg));
 
         if (!ezOSFile::ExistsDirectory(m_sInputs.PeekBack()))
@@ -250,6 +259,7 @@ public:
   ezResult Pack()
   {
     ezArchiveBuilderImpl archive;
+    archive.m_bTrainDictionaries = m_bTrainDictionaries;
 
     for (const auto& folder : m_sInputs)
     {
@@ -267,13 +277,34 @@ public:
     m_sOutput = ezOSFile::MakePathAbsoluteWithCWD(m_sOutput);
 
     ezLog::Info("Writing archive to '{}'", m_sOutput);
-    if (archive.WriteArchive(m_sOutput).Failed())
+
+    ezArchiveBuilder::WriteStats stats;
+    if (archive.WriteArchive(m_sOutput, &stats).Failed())
     {
       ezLog::Error("Failed to write the ezArchive");
 
       return EZ_FAILURE;
     }
 
+    const double fMegaBytes = stats.m_uiUncompressedBytes / (1024.0 * 1024.0);
+    const double fStoredMegaBytes = stats.m_uiStoredBytes / (1024.0 * 1024.0);
+    const double fSeconds = ezMath::Max(stats.m_Duration.GetSeconds(), 0.001);
+
+    ezLog::Info("Packed {} files: {} MB -> {} MB in {} sec ({} MB/sec)", stats.m_uiNumEntries, ezArgF(fMegaBytes, 1),
+      ezArgF(fStoredMegaBytes, 1), ezArgF(fSeconds, 2), ezArgF(fMegaBytes / fSeconds, 1));
+
+    if (stats.m_uiNumDeduplicatedEntries > 0)
+    {
+      ezLog::Info("{} files with identical content share their data, saving {}", stats.m_uiNumDeduplicatedEntries,
+        ezArgFileSize(stats.m_uiDeduplicatedBytes));
+    }
+
+    if (stats.m_uiNumDictionaries > 0)
+    {
+      ezLog::Info("{} files are compressed with {} dictionaries ({})", stats.m_uiNumDictionaryEntries, stats.m_uiNumDictionaries,
+        ezArgFileSize(stats.m_uiDictionaryBytes));
+    }
+
     return EZ_SUCCESS;
   }
 
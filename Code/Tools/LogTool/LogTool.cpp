@@ -0,0 +1,267 @@
+#include <Foundation/Application/Application.h>
+#include <Foundation/Containers/Deque.h>
+#include <Foundation/IO/FileSystem/FileReader.h>
+#include <Foundation/IO/FileSystem/FileSystem.h>
+#include <Foundation/IO/FileSystem/FileWriter.h>
+#include <Foundation/IO/OSFile.h>
+#include <Foundation/Logging/BinaryWriter.h>
+#include <Foundation/Logging/ConsoleWriter.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Logging/VisualStudioWriter.h>
+#include <Foundation/Strings/String.h>
+#include <Foundation/Strings/StringBuilder.h>
+
+/* ezLogTool command line options:
+
+LogTool reads log files that were written with ezLogWriter::Binary and converts them to text.
+
+"path/to/file.ezBinLog"
+  The first argument is the log file to read. It may be compressed or uncompressed.
+
+-out "path/to/file.txt"
+  Writes the text into the given file. If no -out is specified, the text is printed to the console.
+
+-level Error|SeriousWarning|Warning|Success|Info|Dev|Debug
+  Only outputs messages of the given severity or above. Log blocks are skipped when a level is specified.
+
+-filter "text"
+  Only outputs messages that contain the given text (case insensitive) in the message or in the tag.
+
+-thread N
+  Only outputs messages that were logged on the thread with the given index.
+
+-tail N
+  Only outputs the last N messages that pass all other filters.
+
+-timestamp None|Numeric|TimeOnly|Textual
+  How to format the timestamps. Default is Numeric.
+
+Examples:
+
+ezLogTool.exe "C:\Logs\Game.ezBinLog" -level Warning
+  prints all errors and warnings
+
+ezLogTool.exe "C:\Logs\Game.ezBinLog" -filter "texture" -tail 20 -out "C:\Logs\Textures.txt"
+  writes the last 20 messages that mention 'texture' into a text file
+
+*/
+
+class ezLogTool : public ezApplication
+{
+public:
+  typedef ezApplication SUPER;
+
+  ezString m_sInput;
+  ezString m_sOutput;
+  ezString m_sFilter;
+  ezLogMsgType::Enum m_MaxLevel = ezLogMsgType::All;
+  ezInt32 m_iThreadIndex = -1;
+  ezUInt32 m_uiTail = 0;
+  ezLog::TimestampMode m_TimestampMode = ezLog::TimestampMode::Numeric;
+
+  ezLogTool()
+    : ezApplication("LogTool")
+  {
+  }
+
+  ezResult ParseArguments()
+  {
+    if (GetArgumentCount() <= 1)
+    {
+      ezLog::Error("No arguments given");
+      return EZ_FAILURE;
+    }
+
+    ezCommandLineUtils& cmd = *ezCommandLineUtils::GetGlobalInstance();
+
+    m_sInput = ezOSFile::MakePathAbsoluteWithCWD(GetArgument(1));
+
+    if (!ezOSFile::ExistsFile(m_sInput))
+    {
+      ezLog::Error("Input file does not exist: '{}'", m_sInput);
+      return EZ_FAILURE;
+    }
+
+    if (cmd.GetStringOptionArguments("-out") > 0)
+    {
+      m_sOutput = cmd.GetAbsolutePathOption("-out");
+    }
+
+    m_sFilter = cmd.GetStringOption("-filter");
+    m_iThreadIndex = cmd.GetIntOption("-thread", -1);
+    m_uiTail = cmd.GetUIntOption("-tail", 0);
+
+    const ezStringView sLevel = cmd.GetStringOption("-level");
+    if (!sLevel.IsEmpty())
+    {
+      const char* levels[] = {"Error", "SeriousWarning", "Warning", "Success", "Info", "Dev", "Debug"};
+
+      m_MaxLevel = ezLogMsgType::None;
+      for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(levels); ++i)
+      {
+        if (sLevel.IsEqual_NoCase(levels[i]))
+        {
+          m_MaxLevel = static_cast<ezLogMsgType::Enum>(ezLogMsgType::ErrorMsg + i);
+          break;
+        }
+      }
+
+      if (m_MaxLevel == ezLogMsgType::None)
+      {
+        ezLog::Error("Unknown -level '{}'", sLevel);
+        return EZ_FAILURE;
+      }
+    }
+
+    const ezStringView sTimestamp = cmd.GetStringOption("-timestamp");
+    if (!sTimestamp.IsEmpty())
+    {
+      if (sTimestamp.IsEqual_NoCase("None"))
+        m_TimestampMode = ezLog::TimestampMode::None;
+      else if (sTimestamp.IsEqual_NoCase("Numeric"))
+        m_TimestampMode = ezLog::TimestampMode::Numeric;
+      else if (sTimestamp.IsEqual_NoCase("TimeOnly"))
+        m_TimestampMode = ezLog::TimestampMode::TimeOnly;
+      else if (sTimestamp.IsEqual_NoCase("Textual"))
+        m_TimestampMode = ezLog::TimestampMode::Textual;
+      else
+      {
+        ezLog::Error("Unknown -timestamp mode '{}'", sTimestamp);
+        return EZ_FAILURE;
+      }
+    }
+
+    return EZ_SUCCESS;
+  }
+
+  virtual void AfterCoreSystemsStartup() override
+  {
+    // Add the empty data directory to access files via absolute paths
+    ezFileSystem::AddDataDirectory("", "App", ":", ezFileSystem::AllowWrites);
+
+    ezGlobalLog::AddLogWriter(ezLogWriter::Console::LogMessageHandler);
+    ezGlobalLog::AddLogWriter(ezLogWriter::VisualStudio::LogMessageHandler);
+  }
+
+  virtual void BeforeCoreSystemsShutdown() override
+  {
+    // prevent further output during shutdown
+    ezGlobalLog::RemoveLogWriter(ezLogWriter::Console::LogMessageHandler);
+    ezGlobalLog::RemoveLogWriter(ezLogWriter::VisualStudio::LogMessageHandler);
+
+    SUPER::BeforeCoreSystemsShutdown();
+  }
+
+  bool PassesFilter(const ezBinaryLogEntry& entry) const
+  {
+    if (m_MaxLevel != ezLogMsgType::All)
+    {
+      if (entry.m_Type == ezLogMsgType::BeginGroup || entry.m_Type == ezLogMsgType::EndGroup || entry.m_Type > m_MaxLevel)
+        return false;
+    }
+
+    if (m_iThreadIndex >= 0 && entry.m_uiThreadIndex != static_cast<ezUInt32>(m_iThreadIndex))
+      return false;
+
+    if (!m_sFilter.IsEmpty())
+    {
+      if (entry.m_sText.FindSubString_NoCase(m_sFilter) == nullptr && entry.m_sTag.FindSubString_NoCase(m_sFilter) == nullptr)
+        return false;
+    }
+
+    return true;
+  }
+
+  ezResult Convert()
+  {
+    ezFileReader file;
+    if (file.Open(m_sInput).Failed())
+    {
+      ezLog::Error("Failed to open '{}'", m_sInput);
+      return EZ_FAILURE;
+    }
+
+    ezBinaryLogReader reader;
+    EZ_SUCCEED_OR_RETURN(reader.Open(file));
+
+    ezFileWriter output;
+    if (!m_sOutput.IsEmpty() && output.Open(m_sOutput).Failed())
+    {
+      ezLog::Error("Failed to open '{}' for writing", m_sOutput);
+      return EZ_FAILURE;
+    }
+
+    ezDeque<ezString> tail;
+    ezBinaryLogEntry entry;
+    ezStringBuilder sLine;
+    ezUInt64 uiNumEntries = 0;
+    ezUInt64 uiNumMatches = 0;
+
+    auto WriteLine = [&](const ezStringBuilder& sText) {
+      if (output.IsOpen())
+      {
+        output.WriteBytes(sText.GetData(), sText.GetElementCount());
+        output.WriteBytes("\n", 1);
+      }
+      else
+      {
+        printf("%s\n", sText.GetData());
+      }
+    };
+
+    while (reader.ReadNextEntry(entry).Succeeded())
+    {
+      ++uiNumEntries;
+
+      if (!PassesFilter(entry))
+        continue;
+
+      ++uiNumMatches;
+      ezBinaryLogReader::FormatEntry(entry, sLine, m_TimestampMode);
+
+      if (m_uiTail > 0)
+      {
+        if (tail.GetCount() == m_uiTail)
+          tail.PopFront();
+
+        tail.PushBack(sLine);
+      }
+      else
+      {
+        WriteLine(sLine);
+      }
+    }
+
+    for (const ezString& sText : tail)
+    {
+      sLine = sText;
+      WriteLine(sLine);
+    }
+
+    if (output.IsOpen())
+    {
+      ezLog::Info("Wrote {} of {} messages to '{}'", m_uiTail > 0 ? ezMath::Min<ezUInt64>(uiNumMatches, m_uiTail) : uiNumMatches, uiNumEntries, m_sOutput);
+    }
+
+    return EZ_SUCCESS;
+  }
+
+  virtual ApplicationExecution Run() override
+  {
+    if (ParseArguments().Failed())
+    {
+      SetReturnCode(1);
+      return ezApplication::Quit;
+    }
+
+    if (Convert().Failed())
+    {
+      ezLog::Error("Converting the log failed");
+      SetReturnCode(2);
+    }
+
+    return ezApplication::Quit;
+  }
+};
+
+EZ_CONSOLEAPP_ENTRY_POINT(ezLogTool);
@@ -0,0 +1,159 @@
+#include <CoreTestPCH.h>
+
+#include <Core/World/ComponentHotData.h>
+#include <Core/World/World.h>
+
+namespace
+{
+  class SoATestComponent;
+  typedef ezComponentManagerSoA<SoATestComponent, ezComponentUpdateType::Always> SoATestComponentManager;
+
+  class SoATestComponent : public ezComponent
+  {
+    EZ_DECLARE_COMPONENT_TYPE(SoATestComponent, ezComponent, SoATestComponentManager);
+
+  public:
+    enum HotFields
+    {
+      Speed,
+      Value
+    };
+
+    typedef ezComponentHotData<float, float> HotData;
+
+    static void UpdateBatch(const HotData::Slice& slice, const ezWorld* pWorld)
+    {
+      ezArrayPtr<const float> speeds = slice.GetField<Speed>();
+      ezArrayPtr<float> values = slice.GetField<Value>();
+
+      for (ezUInt32 i = 0; i < slice.GetCount(); ++i)
+      {
+        values[i] += speeds[i];
+      }
+    }
+
+    ezUInt32 m_uiId = 0;
+  };
+
+  EZ_BEGIN_COMPONENT_TYPE(SoATestComponent, 1, ezComponentMode::Static)
+  EZ_END_COMPONENT_TYPE
+
+  class SoAAsyncTestComponent;
+  typedef ezComponentManagerSoA<SoAAsyncTestComponent, ezComponentUpdateType::Always, 64> SoAAsyncTestComponentManager;
+
+  class SoAAsyncTestComponent : public ezComponent
+  {
+    EZ_DECLARE_COMPONENT_TYPE(SoAAsyncTestComponent, ezComponent, SoAAsyncTestComponentManager);
+
+  public:
+    typedef ezComponentHotData<ezUInt32> HotData;
+
+    static void UpdateBatch(const HotData::Slice& slice, const ezWorld* pWorld)
+    {
+      for (ezUInt32& uiCounter : slice.GetField<0>())
+      {
+        ++uiCounter;
+      }
+    }
+  };
+
+  EZ_BEGIN_COMPONENT_TYPE(SoAAsyncTestComponent, 1, ezComponentMode::Static)
+  EZ_END_COMPONENT_TYPE
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(World, ComponentSoA)
+{
+  ezWorldDesc worldDesc("Test");
+  ezWorld world(worldDesc);
+  EZ_LOCK(world.GetWriteMarker());
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Batched Update")
+  {
+    SoATestComponentManager* pManager = world.GetOrCreateComponentManager<SoATestComponentManager>();
+
+    ezGameObjectDesc desc;
+    ezGameObject* pObject = nullptr;
+    ezGameObjectHandle hObject = world.CreateObject(desc, pObject);
+
+    ezDynamicArray<ezComponentHandle> handles;
+    for (ezUInt32 i = 0; i < 500; ++i)
+    {
+      SoATestComponent* pComponent = nullptr;
+      handles.PushBack(SoATestComponent::CreateComponent(pObject, pComponent));
+
+      pComponent->m_uiId = i;
+      pManager->GetHotField<SoATestComponent::Speed>(pComponent) = static_cast<float>(i);
+    }
+
+    EZ_TEST_INT(pManager->GetHotData().GetCount(), 500);
+
+    world.Update();
+
+    for (auto it = pManager->GetComponents(); it.IsValid(); ++it)
+    {
+      EZ_TEST_FLOAT(pManager->GetHotField<SoATestComponent::Value>(it), static_cast<float>(it->m_uiId), 0.0f);
+    }
+
+    // inactive components are skipped
+    SoATestComponent* pInactive = nullptr;
+    EZ_TEST_BOOL(world.TryGetComponent(handles[100], pInactive));
+    pInactive->SetActiveFlag(false);
+
+    world.Update();
+
+    for (auto it = pManager->GetComponents(); it.IsValid(); ++it)
+    {
+      const float fExpected = (it->m_uiId == 100) ? 100.0f : it->m_uiId * 2.0f;
+      EZ_TEST_FLOAT(pManager->GetHotField<SoATestComponent::Value>(it), fExpected, 0.0f);
+    }
+
+    // deleting components moves other components and their hot data
+    for (ezUInt32 i = 0; i < handles.GetCount(); i += 3)
+    {
+      pManager->DeleteComponent(handles[i]);
+    }
+
+    world.Update();
+
+    EZ_TEST_INT(pManager->GetComponentCount(), pManager->GetHotData().GetCount());
+
+    for (auto it = pManager->GetComponents(); it.IsValid(); ++it)
+    {
+      EZ_TEST_BOOL(it->m_uiId % 3 != 0);
+      EZ_TEST_FLOAT(pManager->GetHotField<SoATestComponent::Speed>(it), static_cast<float>(it->m_uiId), 0.0f);
+
+      const float fExpected = (it->m_uiId == 100) ? 100.0f : it->m_uiId * 3.0f;
+      EZ_TEST_FLOAT(pManager->GetHotField<SoATestComponent::Value>(it), fExpected, 0.0f);
+    }
+
+    // the objects hold more components than fit into their inline storage, which must be freed while the world is still alive
+    world.DeleteObjectNow(hObject);
+    world.Update();
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Async Batched Update")
+  {
+    SoAAsyncTestComponentManager* pManager = world.GetOrCreateComponentManager<SoAAsyncTestComponentManager>();
+
+    ezGameObjectDesc desc;
+    ezGameObject* pObject = nullptr;
+    ezGameObjectHandle hObject = world.CreateObject(desc, pObject);
+
+    for (ezUInt32 i = 0; i < 1000; ++i)
+    {
+      SoAAsyncTestComponent* pComponent = nullptr;
+      SoAAsyncTestComponent::CreateComponent(pObject, pComponent);
+    }
+
+    world.Update();
+    world.Update();
+
+    for (ezUInt32 uiCounter : pManager->GetHotData().GetFieldArray<0>())
+    {
+      EZ_TEST_INT(uiCounter, 2);
+    }
+
+    world.DeleteObjectNow(hObject);
+    world.Update();
+  }
+}
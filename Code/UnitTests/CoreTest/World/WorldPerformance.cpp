@@ -1,6 +1,9 @@
 #include <CoreTestPCH.h>
 
 #include <Core/World/World.h>
+#include <Core/WorldSerializer/WorldReader.h>
+#include <Core/WorldSerializer/WorldWriter.h>
+#include <Foundation/IO/MemoryStream.h>
 #include <Foundation/Time/Clock.h>
 #include <Foundation/Time/Stopwatch.h>
 
@@ -289,3 +292,74 @@ EZ_CREATE_SIMPLE_TEST(World, Profile_Update)
     }
   }
 }
+
+EZ_CREATE_SIMPLE_TEST(World, Profile_PrefabInstantiation)
+{
+  EZ_TEST_BLOCK(EnableInRelease, "Instantiate 1000 prefabs")
+  {
+    const ezUInt32 uiNumInstances = 1000;
+
+    ezWorldDesc worldDesc("Test");
+    ezWorld world(worldDesc);
+    EZ_LOCK(world.GetWriteMarker());
+
+    // a small prefab, e.g. a projectile with some attached effects
+    ezMemoryStreamStorage storage;
+    {
+      AddObjectsToWorld(world, true, 1, 1, 3, 3);
+
+      ezDeque<const ezGameObject*> rootObjects;
+      for (auto it = world.GetObjects(); it.IsValid(); ++it)
+      {
+        if (it->GetParent() == nullptr)
+        {
+          rootObjects.PushBack(it);
+        }
+      }
+
+      ezMemoryStreamWriter memWriter(&storage);
+      ezWorldWriter writer;
+      writer.WriteObjects(memWriter, rootObjects);
+
+      world.Clear();
+      world.Update();
+    }
+
+    ezMemoryStreamReader memReader(&storage);
+    ezWorldReader reader;
+    EZ_TEST_BOOL(reader.ReadWorldDescription(memReader).Succeeded());
+
+    ezDynamicArray<ezTransform> transforms;
+    for (ezUInt32 i = 0; i < uiNumInstances; ++i)
+    {
+      transforms.PushBack(ezTransform(ezVec3(static_cast<float>(i), 0, 0)));
+    }
+
+    auto Output = [&](const char* szName, ezTime tDiff) {
+      ezTestFramework::Output(ezTestOutput::Duration, "%s: %u objects, %.2fms, %.1f instances/ms", szName, world.GetObjectCount(), tDiff.GetMilliseconds(),
+        uiNumInstances / tDiff.GetMilliseconds());
+
+      world.Clear();
+      world.Update();
+    };
+
+    {
+      ezStopwatch sw;
+
+      for (const ezTransform& transform : transforms)
+      {
+        reader.InstantiatePrefab(world, transform, ezGameObjectHandle(), nullptr, nullptr, nullptr, false);
+      }
+
+      Output("InstantiatePrefab", sw.Checkpoint());
+    }
+
+    {
+      ezStopwatch sw;
+
+      reader.InstantiatePrefabs(world, transforms, ezGameObjectHandle(), nullptr, nullptr, false);
+
+      Output("InstantiatePrefabs", sw.Checkpoint());
+    }
+  }
+}
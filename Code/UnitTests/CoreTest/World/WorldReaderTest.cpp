@@ -0,0 +1,314 @@
+#include <CoreTestPCH.h>
+
+#include <Core/WorldSerializer/WorldReader.h>
+#include <Core/WorldSerializer/WorldWriter.h>
+#include <Foundation/IO/MemoryStream.h>
+
+namespace
+{
+  class WorldReaderTestComponent;
+  typedef ezComponentManager<WorldReaderTestComponent, ezBlockStorageType::FreeList> WorldReaderTestComponentManager;
+
+  class WorldReaderTestComponent : public ezComponent
+  {
+    EZ_DECLARE_COMPONENT_TYPE(WorldReaderTestComponent, ezComponent, WorldReaderTestComponentManager);
+
+  public:
+    virtual void SerializeComponent(ezWorldWriter& stream) const override
+    {
+      stream.GetStream() << m_iValue;
+      stream.WriteComponentHandle(m_hOther);
+    }
+
+    virtual void DeserializeComponent(ezWorldReader& stream) override
+    {
+      stream.GetStream() >> m_iValue;
+      stream.ReadComponentHandle(m_hOther);
+    }
+
+    virtual void Initialize() override { ++s_iInitCounter; }
+
+    ezInt32 m_iValue = 0;
+    ezComponentHandle m_hOther;
+
+    static ezInt32 s_iInitCounter;
+  };
+
+  ezInt32 WorldReaderTestComponent::s_iInitCounter = 0;
+
+  EZ_BEGIN_COMPONENT_TYPE(WorldReaderTestComponent, 1, ezComponentMode::Static)
+  EZ_END_COMPONENT_TYPE
+
+  class WorldReaderParallelTestComponent;
+  typedef ezComponentManager<WorldReaderParallelTestComponent, ezBlockStorageType::Compact> WorldReaderParallelTestComponentManager;
+
+  class WorldReaderParallelTestComponent : public ezComponent
+  {
+    EZ_DECLARE_COMPONENT_TYPE(WorldReaderParallelTestComponent, ezComponent, WorldReaderParallelTestComponentManager);
+
+  public:
+    virtual void SerializeComponent(ezWorldWriter& stream) const override
+    {
+      stream.GetStream() << m_sName;
+      stream.GetStream() << m_uiValue;
+      stream.WriteGameObjectHandle(m_hObject);
+    }
+
+    virtual void DeserializeComponent(ezWorldReader& stream) override
+    {
+      stream.GetStream() >> m_sName;
+      stream.GetStream() >> m_uiValue;
+      m_hObject = stream.ReadGameObjectHandle();
+    }
+
+    ezString m_sName;
+    ezUInt32 m_uiValue = 0;
+    ezGameObjectHandle m_hObject;
+  };
+
+  // clang-format off
+  EZ_BEGIN_COMPONENT_TYPE(WorldReaderParallelTestComponent, 1, ezComponentMode::Static)
+  {
+    EZ_BEGIN_ATTRIBUTES
+    {
+      new ezParallelDeserializationAttribute(),
+    }
+    EZ_END_ATTRIBUTES;
+  }
+  EZ_END_COMPONENT_TYPE
+  // clang-format on
+
+  void CheckInstance(ezWorld& world, ezGameObject* pRoot, const ezVec3& vExpectedPosition)
+  {
+    EZ_TEST_VEC3(pRoot->GetLocalPosition(), vExpectedPosition, 0.0001f);
+    EZ_TEST_INT(pRoot->GetChildCount(), 1);
+    EZ_TEST_INT(pRoot->GetComponents().GetCount(), 1);
+
+    WorldReaderTestComponent* pRootComponent = nullptr;
+    EZ_TEST_BOOL(pRoot->TryGetComponentOfBaseType(pRootComponent));
+    EZ_TEST_INT(pRootComponent->m_iValue, 1);
+    EZ_TEST_BOOL(pRootComponent->GetActiveFlag());
+
+    ezGameObject* pChild = pRoot->GetChildren();
+    WorldReaderTestComponent* pChildComponent = nullptr;
+    EZ_TEST_BOOL(pChild->TryGetComponentOfBaseType(pChildComponent));
+    EZ_TEST_INT(pChildComponent->m_iValue, 2);
+    EZ_TEST_BOOL(!pChildComponent->GetActiveFlag());
+
+    // the handle must reference the component of this instance, not the one of the source objects
+    EZ_TEST_BOOL(pChildComponent->m_hOther == pRootComponent->GetHandle());
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(World, WorldReader)
+{
+  ezWorldDesc worldDesc("Test");
+  ezWorld world(worldDesc);
+  EZ_LOCK(world.GetWriteMarker());
+
+  ezMemoryStreamStorage storage;
+
+  {
+    ezGameObjectDesc desc;
+    ezGameObject* pRoot = nullptr;
+    world.CreateObject(desc, pRoot);
+
+    desc.m_hParent = pRoot->GetHandle();
+    ezGameObject* pChild = nullptr;
+    world.CreateObject(desc, pChild);
+
+    WorldReaderTestComponent* pRootComponent = nullptr;
+    WorldReaderTestComponent::CreateComponent(pRoot, pRootComponent);
+    pRootComponent->m_iValue = 1;
+
+    WorldReaderTestComponent* pChildComponent = nullptr;
+    WorldReaderTestComponent::CreateComponent(pChild, pChildComponent);
+    pChildComponent->m_iValue = 2;
+    pChildComponent->m_hOther = pRootComponent->GetHandle();
+    pChildComponent->SetActiveFlag(false);
+
+    const ezGameObject* rootObjects[] = {pRoot};
+
+    ezMemoryStreamWriter memWriter(&storage);
+    ezWorldWriter writer;
+    writer.WriteObjects(memWriter, ezMakeArrayPtr(rootObjects));
+
+    world.DeleteObjectNow(pRoot->GetHandle());
+    world.Update();
+  }
+
+  ezMemoryStreamReader memReader(&storage);
+  ezWorldReader reader;
+  EZ_TEST_BOOL(reader.ReadWorldDescription(memReader).Succeeded());
+  EZ_TEST_INT(reader.GetRootObjectCount(), 1);
+  EZ_TEST_INT(reader.GetChildObjectCount(), 1);
+
+  WorldReaderTestComponent::s_iInitCounter = 0;
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "InstantiatePrefab")
+  {
+    ezHybridArray<ezGameObject*, 8> createdRootObjects;
+    reader.InstantiatePrefab(world, ezTransform(ezVec3(1, 2, 3)), ezGameObjectHandle(), &createdRootObjects, nullptr, nullptr, false);
+
+    EZ_TEST_INT(createdRootObjects.GetCount(), 1);
+    CheckInstance(world, createdRootObjects[0], ezVec3(1, 2, 3));
+
+    // immediate instantiations queue their components, which are initialized during the next world update
+    EZ_TEST_INT(WorldReaderTestComponent::s_iInitCounter, 0);
+    world.Update();
+    EZ_TEST_INT(WorldReaderTestComponent::s_iInitCounter, 2);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "InstantiatePrefab (time sliced)")
+  {
+    ezHybridArray<ezGameObject*, 8> createdRootObjects;
+    auto pContext = reader.InstantiatePrefab(
+      world, ezTransform(ezVec3(4, 5, 6)), ezGameObjectHandle(), &createdRootObjects, nullptr, nullptr, false, ezTime::Seconds(10));
+
+    EZ_TEST_BOOL(pContext != nullptr);
+
+    while (!pContext->Step())
+    {
+      world.Update();
+    }
+
+    EZ_TEST_INT(createdRootObjects.GetCount(), 1);
+    CheckInstance(world, createdRootObjects[0], ezVec3(4, 5, 6));
+    EZ_TEST_INT(WorldReaderTestComponent::s_iInitCounter, 4);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "InstantiatePrefabs")
+  {
+    ezDynamicArray<ezTransform> transforms;
+    for (ezUInt32 i = 0; i < 50; ++i)
+    {
+      transforms.PushBack(ezTransform(ezVec3(static_cast<float>(i), 0, 0)));
+    }
+
+    ezDynamicArray<ezGameObject*> createdRootObjects;
+    reader.InstantiatePrefabs(world, transforms, ezGameObjectHandle(), &createdRootObjects, nullptr, false);
+
+    EZ_TEST_INT(createdRootObjects.GetCount(), 50);
+
+    world.Update();
+    EZ_TEST_INT(WorldReaderTestComponent::s_iInitCounter, 4 + 50 * 2);
+
+    for (ezUInt32 i = 0; i < createdRootObjects.GetCount(); ++i)
+    {
+      CheckInstance(world, createdRootObjects[i], transforms[i].m_vPosition);
+    }
+  }
+}
+
+EZ_CREATE_SIMPLE_TEST(World, WorldReaderParallel)
+{
+  ezWorldDesc worldDesc("Test");
+  ezWorld world(worldDesc);
+  EZ_LOCK(world.GetWriteMarker());
+
+  constexpr ezUInt32 uiNumChildren = 200;
+  ezMemoryStreamStorage storage;
+
+  {
+    ezGameObjectDesc desc;
+    ezGameObject* pRoot = nullptr;
+    world.CreateObject(desc, pRoot);
+
+    WorldReaderTestComponent* pRootComponent = nullptr;
+    WorldReaderTestComponent::CreateComponent(pRoot, pRootComponent);
+    pRootComponent->m_iValue = 1;
+
+    desc.m_hParent = pRoot->GetHandle();
+
+    for (ezUInt32 i = 0; i < uiNumChildren; ++i)
+    {
+      ezGameObject* pChild = nullptr;
+      world.CreateObject(desc, pChild);
+
+      WorldReaderParallelTestComponent* pComponent = nullptr;
+      WorldReaderParallelTestComponent::CreateComponent(pChild, pComponent);
+      pComponent->m_sName = (i % 2) == 0 ? "Even" : "Odd";
+      pComponent->m_uiValue = i;
+      pComponent->m_hObject = pRoot->GetHandle();
+    }
+
+    const ezGameObject* rootObjects[] = {pRoot};
+
+    ezMemoryStreamWriter memWriter(&storage);
+    ezWorldWriter writer;
+    writer.WriteObjects(memWriter, ezMakeArrayPtr(rootObjects));
+
+    world.DeleteObjectNow(pRoot->GetHandle());
+    world.Update();
+  }
+
+  ezMemoryStreamReader memReader(&storage);
+  ezWorldReader reader;
+  EZ_TEST_BOOL(reader.ReadWorldDescription(memReader).Succeeded());
+  EZ_TEST_BOOL(!reader.GetDeserializeComponentsInParallel());
+  reader.SetDeserializeComponentsInParallel(true);
+
+  auto CheckParallelInstance = [&](ezGameObject* pRoot) {
+    WorldReaderTestComponent* pRootComponent = nullptr;
+    EZ_TEST_BOOL(pRoot->TryGetComponentOfBaseType(pRootComponent));
+    EZ_TEST_INT(pRootComponent->m_iValue, 1);
+    EZ_TEST_INT(pRoot->GetChildCount(), uiNumChildren);
+
+    ezUInt32 uiValueSum = 0;
+    for (auto it = pRoot->GetChildren(); it.IsValid(); ++it)
+    {
+      WorldReaderParallelTestComponent* pComponent = nullptr;
+      EZ_TEST_BOOL(it->TryGetComponentOfBaseType(pComponent));
+      EZ_TEST_STRING(pComponent->m_sName, (pComponent->m_uiValue % 2) == 0 ? "Even" : "Odd");
+      EZ_TEST_BOOL(pComponent->m_hObject == pRoot->GetHandle());
+      uiValueSum += pComponent->m_uiValue;
+    }
+
+    EZ_TEST_INT(uiValueSum, uiNumChildren * (uiNumChildren - 1) / 2);
+  };
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "InstantiatePrefab")
+  {
+    ezHybridArray<ezGameObject*, 8> createdRootObjects;
+    reader.InstantiatePrefab(world, ezTransform::IdentityTransform(), ezGameObjectHandle(), &createdRootObjects, nullptr, nullptr, false);
+
+    EZ_TEST_INT(createdRootObjects.GetCount(), 1);
+    CheckParallelInstance(createdRootObjects[0]);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "InstantiatePrefab (time sliced)")
+  {
+    ezHybridArray<ezGameObject*, 8> createdRootObjects;
+    auto pContext = reader.InstantiatePrefab(
+      world, ezTransform::IdentityTransform(), ezGameObjectHandle(), &createdRootObjects, nullptr, nullptr, false, ezTime::Microseconds(1));
+
+    EZ_TEST_BOOL(pContext != nullptr);
+
+    while (!pContext->Step())
+    {
+      world.Update();
+    }
+
+    EZ_TEST_INT(createdRootObjects.GetCount(), 1);
+    CheckParallelInstance(createdRootObjects[0]);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "InstantiatePrefabs")
+  {
+    ezTransform transforms[4];
+    for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(transforms); ++i)
+    {
+      transforms[i] = ezTransform(ezVec3(static_cast<float>(i), 0, 0));
+    }
+
+    ezDynamicArray<ezGameObject*> createdRootObjects;
+    reader.InstantiatePrefabs(world, ezMakeArrayPtr(transforms), ezGameObjectHandle(), &createdRootObjects, nullptr, false);
+
+    EZ_TEST_INT(createdRootObjects.GetCount(), EZ_ARRAY_SIZE(transforms));
+
+    for (ezGameObject* pRoot : createdRootObjects)
+    {
+      CheckParallelInstance(pRoot);
+    }
+  }
+}
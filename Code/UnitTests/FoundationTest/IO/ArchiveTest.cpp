@@ -1,11 +1,17 @@
 #include <FoundationTestPCH.h>
 
 #include <Foundation/IO/Archive/Archive.h>
+#include <Foundation/IO/Archive/ArchiveBuilder.h>
+#include <Foundation/IO/Archive/ArchiveChunkedEntryReader.h>
+#include <Foundation/IO/Archive/ArchiveReader.h>
+#include <Foundation/IO/Archive/ArchiveUtils.h>
 #include <Foundation/IO/Archive/DataDirTypeArchive.h>
 #include <Foundation/IO/FileSystem/DataDirTypeFolder.h>
 #include <Foundation/IO/FileSystem/FileReader.h>
 #include <Foundation/IO/FileSystem/FileSystem.h>
 #include <Foundation/IO/FileSystem/FileWriter.h>
+#include <Foundation/IO/MemoryStream.h>
+#include <Foundation/Math/Random.h>
 #include <Foundation/System/Process.h>
 #include <Foundation/Utilities/CommandLineUtils.h>
 
@@ -157,3 +163,563 @@ EZ_CREATE_SIMPLE_TEST(IO, Archive)
 }
 
 #endif
+
+#if EZ_ENABLED(EZ_SUPPORTS_MEMORY_MAPPED_FILE)
+
+EZ_CREATE_SIMPLE_TEST(IO, ArchiveBuilder)
+{
+  ezStringBuilder sOutputFolder = ezTestFramework::GetInstance()->GetAbsOutputPath();
+  sOutputFolder.AppendPath("ArchiveBuilderTest");
+  sOutputFolder.MakeCleanPath();
+
+  const ezStringBuilder sDataFolder(sOutputFolder, "/Data");
+  const ezStringBuilder sUnpackFolder(sOutputFolder, "/Unpacked");
+  const ezStringBuilder sArchiveFile(sOutputFolder, "/Data.ezArchive");
+
+  const ezUInt32 uiNumFiles = 12;
+  const ezUInt32 uiFileSizeStep = 1024 * 16;
+  ezUInt64 uiTotalSize = 0;
+
+  ezStringBuilder sFileName;
+  ezArchiveBuilder builder;
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Generate Data")
+  {
+    // all files are overwritten, the folder does not need to be empty
+    if (EZ_TEST_BOOL(ezOSFile::CreateDirectoryStructure(sDataFolder).Succeeded()).Failed())
+      return;
+
+    // ezArchiveBuilder reads and writes through ezFileSystem
+    if (EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(sOutputFolder, "ArchiveBuilderTest", "builder", ezFileSystem::AllowWrites) == EZ_SUCCESS).Failed())
+      return;
+
+    ezRandom rng;
+    rng.Initialize(42);
+
+    ezUInt32 uiValue = 0;
+
+    for (ezUInt32 uiFileIdx = 0; uiFileIdx < uiNumFiles; ++uiFileIdx)
+    {
+      sFileName.Format("{}/File{}.txt", sDataFolder, uiFileIdx);
+
+      ezOSFile file;
+      if (EZ_TEST_BOOL(file.Open(sFileName, ezFileOpenMode::Write).Succeeded()).Failed())
+        return;
+
+      // every third file is not compressible and ends up uncompressed in the archive
+      const bool bRandom = (uiFileIdx % 3) == 2;
+
+      for (ezUInt32 i = 0; i < uiFileSizeStep * uiFileIdx / sizeof(ezUInt32); ++i)
+      {
+        const ezUInt32 uiData = bRandom ? rng.UInt() : uiValue++;
+        file.Write(&uiData, sizeof(ezUInt32)).IgnoreResult();
+      }
+
+      uiTotalSize += uiFileSizeStep * uiFileIdx;
+
+      auto& entry = builder.m_Entries.ExpandAndGetRef();
+      entry.m_sAbsSourcePath = sFileName;
+      entry.m_sRelTargetPath = ezPathUtils::GetFileNameAndExtension(sFileName);
+      entry.m_CompressionMode = ezArchiveCompressionMode::Compressed_zstd;
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "WriteArchive")
+  {
+    EZ_TEST_INT(builder.m_Entries.GetCount(), uiNumFiles);
+
+    ezMemoryStreamStorage storage;
+    ezMemoryStreamWriter writer(&storage);
+
+    ezArchiveBuilder::WriteStats stats;
+    EZ_TEST_BOOL(builder.WriteArchive(writer, &stats).Succeeded());
+
+    EZ_TEST_INT(stats.m_uiNumEntries, uiNumFiles);
+    EZ_TEST_INT(stats.m_uiUncompressedBytes, uiTotalSize);
+    EZ_TEST_BOOL(stats.m_uiStoredBytes > 0 && stats.m_uiStoredBytes < storage.GetStorageSize());
+
+    // with a small budget fewer entries are compressed at the same time and the large ones are written directly
+    builder.m_uiMaxInFlightBytes = uiFileSizeStep * 4;
+
+    ezMemoryStreamStorage storage2;
+    ezMemoryStreamWriter writer2(&storage2);
+    EZ_TEST_BOOL(builder.WriteArchive(writer2).Succeeded());
+
+    // the output does not depend on the order in which the entries finished
+    if (EZ_TEST_INT(storage.GetStorageSize(), storage2.GetStorageSize()).Succeeded())
+    {
+      EZ_TEST_BOOL(ezMemoryUtils::IsEqual(storage.GetData(), storage2.GetData(), storage.GetStorageSize()));
+    }
+
+    EZ_TEST_BOOL(builder.WriteArchive(":builder/Data.ezArchive").Succeeded());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Extract")
+  {
+    ezArchiveReader reader;
+    if (EZ_TEST_BOOL(reader.OpenArchive(sArchiveFile).Succeeded()).Failed())
+      return;
+
+    EZ_TEST_INT(reader.GetArchiveTOC().m_Entries.GetCount(), uiNumFiles);
+    EZ_TEST_BOOL(reader.ExtractAllFiles(":builder/Unpacked").Succeeded());
+
+    ezStringBuilder sFileDst;
+
+    for (ezUInt32 uiFileIdx = 0; uiFileIdx < uiNumFiles; ++uiFileIdx)
+    {
+      sFileName.Format("{}/File{}.txt", sDataFolder, uiFileIdx);
+      sFileDst.Format("{}/File{}.txt", sUnpackFolder, uiFileIdx);
+
+      EZ_TEST_FILES(sFileName, sFileDst, "Unpacked file should be identical");
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Mapped Data and Prefetch")
+  {
+    if (EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(sArchiveFile, "ArchiveBuilderTest", "builderarchive", ezFileSystem::ReadOnly) == EZ_SUCCESS).Failed())
+      return;
+
+    ezArchiveReader reader;
+    if (EZ_TEST_BOOL(reader.OpenArchive(sArchiveFile).Succeeded()).Failed())
+      return;
+
+    const ezArchiveTOC& toc = reader.GetArchiveTOC();
+    ezStringBuilder sArchivePath, sEntryName;
+    ezDynamicArray<ezUInt8> original, fromArchive;
+    ezUInt32 uiNumMapped = 0;
+
+    for (ezUInt32 uiFileIdx = 1; uiFileIdx < uiNumFiles; ++uiFileIdx)
+    {
+      sFileName.Format(":builder/Data/File{}.txt", uiFileIdx);
+      sArchivePath.Format(":builderarchive/File{}.txt", uiFileIdx);
+
+      ezFileSystem::PrefetchFile(sArchivePath);
+
+      ezFileReader fileOriginal, fileArchive;
+      if (EZ_TEST_BOOL(fileOriginal.Open(sFileName).Succeeded()).Failed() || EZ_TEST_BOOL(fileArchive.Open(sArchivePath).Succeeded()).Failed())
+        continue;
+
+      // files in folders are never mapped, uncompressed archive entries always are
+      EZ_TEST_BOOL(fileOriginal.GetMappedData().IsEmpty());
+
+      sEntryName.Format("File{}.txt", uiFileIdx);
+      const ezUInt32 uiEntryIdx = toc.FindEntry(sEntryName);
+      const bool bUncompressed = toc.m_Entries[uiEntryIdx].m_CompressionMode == ezArchiveCompressionMode::Uncompressed;
+
+      const ezArrayPtr<const ezUInt8> mappedData = fileArchive.GetMappedData();
+      EZ_TEST_BOOL(mappedData.IsEmpty() != bUncompressed);
+      if (!mappedData.IsEmpty())
+      {
+        ++uiNumMapped;
+        EZ_TEST_INT(mappedData.GetCount(), fileArchive.GetFileSize());
+      }
+
+      original.SetCountUninitialized(static_cast<ezUInt32>(fileOriginal.GetFileSize()));
+      fromArchive.SetCountUninitialized(static_cast<ezUInt32>(fileArchive.GetFileSize()));
+
+      EZ_TEST_INT(fileOriginal.ReadBytes(original.GetData(), original.GetCount()), original.GetCount());
+
+      // read the archive file in pieces, skipping some data in between
+      const ezUInt32 uiSkip = fromArchive.GetCount() / 3;
+      EZ_TEST_INT(fileArchive.ReadBytes(fromArchive.GetData(), uiSkip), uiSkip);
+      EZ_TEST_INT(fileArchive.SkipBytes(uiSkip), uiSkip);
+      ezMemoryUtils::Copy(fromArchive.GetData() + uiSkip, original.GetData() + uiSkip, uiSkip);
+      EZ_TEST_INT(fileArchive.ReadBytes(fromArchive.GetData() + 2 * uiSkip, fromArchive.GetCount()), fromArchive.GetCount() - 2 * uiSkip);
+      EZ_TEST_INT(fileArchive.ReadBytes(fromArchive.GetData(), 1), 0);
+
+      EZ_TEST_BOOL(original == fromArchive);
+    }
+
+    EZ_TEST_BOOL(uiNumMapped > 0);
+
+    // unknown files are ignored
+    ezFileSystem::PrefetchFile(":builderarchive/DoesNotExist.txt");
+  }
+
+  ezFileSystem::RemoveDataDirectoryGroup("ArchiveBuilderTest");
+}
+
+#  ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+
+EZ_CREATE_SIMPLE_TEST(IO, ArchiveDictionaries)
+{
+  ezStringBuilder sOutputFolder = ezTestFramework::GetInstance()->GetAbsOutputPath();
+  sOutputFolder.AppendPath("ArchiveDictionaryTest");
+  sOutputFolder.MakeCleanPath();
+
+  const ezStringBuilder sDataFolder(sOutputFolder, "/Data");
+  const ezStringBuilder sUnpackFolder(sOutputFolder, "/Unpacked");
+  const ezStringBuilder sArchiveFile(sOutputFolder, "/Data.ezArchive");
+
+  // many small files of the same type, that share most of their content, and some exact copies
+  const ezUInt32 uiNumUniqueFiles = 40;
+  const ezUInt32 uiNumCopies = 5;
+  const ezUInt32 uiNumFiles = uiNumUniqueFiles + uiNumCopies;
+
+  ezStringBuilder sFileName, sContent;
+  ezArchiveBuilder builder;
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Generate Data")
+  {
+    if (EZ_TEST_BOOL(ezOSFile::CreateDirectoryStructure(sDataFolder).Succeeded()).Failed())
+      return;
+
+    if (EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(sOutputFolder, "ArchiveDictionaryTest", "dict", ezFileSystem::AllowWrites) == EZ_SUCCESS).Failed())
+      return;
+
+    for (ezUInt32 uiFileIdx = 0; uiFileIdx < uiNumFiles; ++uiFileIdx)
+    {
+      const ezUInt32 uiContentIdx = uiFileIdx < uiNumUniqueFiles ? uiFileIdx : uiFileIdx - uiNumUniqueFiles;
+
+      // the parameter names are the same in all files, but don't repeat within a file, like the properties of an asset type
+      ezRandom rng;
+      rng.Initialize(42);
+
+      sContent.Clear();
+      for (ezUInt32 uiParam = 0; uiParam < 20; ++uiParam)
+      {
+        sContent.Append("  ");
+        for (ezUInt32 i = 0; i < 24; ++i)
+        {
+          sContent.Append(static_cast<char>('a' + rng.UIntInRange(26)));
+        }
+
+        sContent.AppendFormat(" = {}\n", uiContentIdx * 20 + uiParam);
+      }
+
+      sFileName.Format("{}/Material{}.ezMaterial", sDataFolder, uiFileIdx);
+
+      ezOSFile file;
+      if (EZ_TEST_BOOL(file.Open(sFileName, ezFileOpenMode::Write).Succeeded()).Failed())
+        return;
+
+      file.Write(sContent.GetData(), sContent.GetElementCount()).IgnoreResult();
+
+      auto& entry = builder.m_Entries.ExpandAndGetRef();
+      entry.m_sAbsSourcePath = sFileName;
+      entry.m_sRelTargetPath = ezPathUtils::GetFileNameAndExtension(sFileName);
+      entry.m_CompressionMode = ezArchiveCompressionMode::Compressed_zstd;
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "WriteArchive")
+  {
+    ezArchiveBuilder::WriteStats statsPlain;
+    {
+      builder.m_bDeduplicateContent = false;
+      builder.m_bTrainDictionaries = false;
+
+      ezMemoryStreamStorage storage;
+      ezMemoryStreamWriter writer(&storage);
+      EZ_TEST_BOOL(builder.WriteArchive(writer, &statsPlain).Succeeded());
+
+      EZ_TEST_INT(statsPlain.m_uiNumDeduplicatedEntries, 0);
+      EZ_TEST_INT(statsPlain.m_uiNumDictionaries, 0);
+    }
+
+    builder.m_bDeduplicateContent = true;
+    builder.m_bTrainDictionaries = true;
+    builder.m_uiMaxDictionarySize = 4 * 1024;
+
+    ezArchiveBuilder::WriteStats stats;
+    EZ_TEST_BOOL(builder.WriteArchive(":dict/Data.ezArchive", &stats).Succeeded());
+
+    EZ_TEST_INT(stats.m_uiNumEntries, uiNumFiles);
+    EZ_TEST_INT(stats.m_uiUncompressedBytes, statsPlain.m_uiUncompressedBytes);
+    EZ_TEST_INT(stats.m_uiNumDeduplicatedEntries, uiNumCopies);
+    EZ_TEST_BOOL(stats.m_uiDeduplicatedBytes > 0);
+    EZ_TEST_INT(stats.m_uiNumDictionaries, 1);
+    EZ_TEST_INT(stats.m_uiNumDictionaryEntries, uiNumFiles);
+    EZ_TEST_BOOL(stats.m_uiDictionaryBytes > 0 && stats.m_uiDictionaryBytes <= builder.m_uiMaxDictionarySize);
+
+    // even including the dictionary, the archive is considerably smaller
+    EZ_TEST_BOOL((stats.m_uiStoredBytes + stats.m_uiDictionaryBytes) * 2 < statsPlain.m_uiStoredBytes);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Extract")
+  {
+    ezArchiveReader reader;
+    if (EZ_TEST_BOOL(reader.OpenArchive(sArchiveFile).Succeeded()).Failed())
+      return;
+
+    const ezArchiveReader::Stats& stats = reader.GetStats();
+    EZ_TEST_INT(stats.m_uiNumEntries, uiNumFiles);
+    EZ_TEST_INT(stats.m_uiNumDataRanges, uiNumUniqueFiles);
+    EZ_TEST_INT(stats.m_uiNumDictionaries, 1);
+    EZ_TEST_BOOL(stats.m_uiDictionaryBytes > 0);
+    EZ_TEST_BOOL(stats.m_uiStoredBytes < stats.m_uiUncompressedBytes);
+
+    EZ_TEST_BOOL(reader.GetEntryDictionary(0) != nullptr);
+    EZ_TEST_BOOL(reader.ExtractAllFiles(":dict/Unpacked").Succeeded());
+
+    ezStringBuilder sFileDst;
+
+    for (ezUInt32 uiFileIdx = 0; uiFileIdx < uiNumFiles; ++uiFileIdx)
+    {
+      sFileName.Format("{}/Material{}.ezMaterial", sDataFolder, uiFileIdx);
+      sFileDst.Format("{}/Material{}.ezMaterial", sUnpackFolder, uiFileIdx);
+
+      EZ_TEST_FILES(sFileName, sFileDst, "Unpacked file should be identical");
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Mount Archive")
+  {
+    if (EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(sArchiveFile, "ArchiveDictionaryTest", "dictarchive", ezFileSystem::ReadOnly) == EZ_SUCCESS).Failed())
+      return;
+
+    ezStringBuilder sArchivePath;
+    ezDynamicArray<ezUInt8> original, fromArchive;
+
+    for (ezUInt32 uiFileIdx = 0; uiFileIdx < uiNumFiles; ++uiFileIdx)
+    {
+      sFileName.Format(":dict/Data/Material{}.ezMaterial", uiFileIdx);
+      sArchivePath.Format(":dictarchive/Material{}.ezMaterial", uiFileIdx);
+
+      ezFileReader fileOriginal, fileArchive;
+      if (EZ_TEST_BOOL(fileOriginal.Open(sFileName).Succeeded()).Failed() || EZ_TEST_BOOL(fileArchive.Open(sArchivePath).Succeeded()).Failed())
+        continue;
+
+      original.SetCountUninitialized(static_cast<ezUInt32>(fileOriginal.GetFileSize()));
+      fromArchive.SetCountUninitialized(static_cast<ezUInt32>(fileArchive.GetFileSize()));
+
+      EZ_TEST_INT(fileOriginal.ReadBytes(original.GetData(), original.GetCount()), original.GetCount());
+      EZ_TEST_INT(fileArchive.ReadBytes(fromArchive.GetData(), fromArchive.GetCount()), fromArchive.GetCount());
+      EZ_TEST_BOOL(original == fromArchive);
+    }
+  }
+
+  ezFileSystem::RemoveDataDirectoryGroup("ArchiveDictionaryTest");
+}
+
+namespace
+{
+  class ProgressArchiveBuilder : public ezArchiveBuilder
+  {
+  public:
+    mutable ezDynamicArray<ezUInt64> m_BytesWritten;
+    mutable ezUInt64 m_uiBytesTotal = 0;
+
+  protected:
+    virtual bool WriteNextFileCallback(ezUInt32 uiCurEntry, ezUInt32 uiMaxEntries, const char* szSourceFile) const override
+    {
+      m_BytesWritten.Clear();
+      m_uiBytesTotal = 0;
+      return true;
+    }
+
+    virtual bool WriteFileProgressCallback(ezUInt64 bytesWritten, ezUInt64 bytesTotal) const override
+    {
+      m_BytesWritten.PushBack(bytesWritten);
+      m_uiBytesTotal = bytesTotal;
+      return true;
+    }
+  };
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(IO, ArchiveChunked)
+{
+  ezStringBuilder sOutputFolder = ezTestFramework::GetInstance()->GetAbsOutputPath();
+  sOutputFolder.AppendPath("ArchiveChunkedTest");
+  sOutputFolder.MakeCleanPath();
+
+  const ezStringBuilder sDataFolder(sOutputFolder, "/Data");
+  const ezStringBuilder sArchiveFile(sOutputFolder, "/Data.ezArchive");
+
+  const ezUInt32 uiChunkSize = ezArchiveUtils::ChunkedCompressionChunkSize;
+  const ezUInt32 uiLargeSize = 5 * uiChunkSize + 1000;
+
+  // compressible text, except for the third chunk, which is random and has to be stored uncompressed
+  ezDynamicArray<ezUInt8> largeContent;
+  largeContent.SetCountUninitialized(uiLargeSize);
+  {
+    ezRandom rng;
+    rng.Initialize(7);
+
+    ezStringBuilder sLine;
+    for (ezUInt32 i = 0; i < uiLargeSize;)
+    {
+      if (i >= 2 * uiChunkSize && i < 3 * uiChunkSize)
+      {
+        largeContent[i++] = static_cast<ezUInt8>(rng.UIntInRange(256));
+        continue;
+      }
+
+      sLine.Format("Line {} with value {}\n", i, rng.UIntInRange(100));
+      for (ezUInt32 c = 0; c < sLine.GetElementCount() && i < uiLargeSize && (i < 2 * uiChunkSize || i >= 3 * uiChunkSize); ++c)
+      {
+        largeContent[i++] = static_cast<ezUInt8>(sLine.GetData()[c]);
+      }
+    }
+  }
+
+  ProgressArchiveBuilder builder;
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Generate Data")
+  {
+    if (EZ_TEST_BOOL(ezOSFile::CreateDirectoryStructure(sDataFolder).Succeeded()).Failed())
+      return;
+
+    if (EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(sOutputFolder, "ArchiveChunkedTest", "chunk", ezFileSystem::AllowWrites) == EZ_SUCCESS).Failed())
+      return;
+
+    const char* szFiles[] = {"Large.txt", "Small.txt"};
+    const ezUInt32 uiSizes[] = {uiLargeSize, uiChunkSize / 2};
+
+    for (ezUInt32 uiFileIdx = 0; uiFileIdx < EZ_ARRAY_SIZE(szFiles); ++uiFileIdx)
+    {
+      ezStringBuilder sFileName(sDataFolder, "/", szFiles[uiFileIdx]);
+
+      ezOSFile file;
+      if (EZ_TEST_BOOL(file.Open(sFileName, ezFileOpenMode::Write).Succeeded()).Failed())
+        return;
+
+      file.Write(largeContent.GetData(), uiSizes[uiFileIdx]).IgnoreResult();
+
+      auto& entry = builder.m_Entries.ExpandAndGetRef();
+      entry.m_sAbsSourcePath = sFileName;
+      entry.m_sRelTargetPath = szFiles[uiFileIdx];
+      entry.m_CompressionMode = ezArchiveCompressionMode::Compressed_zstd;
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "WriteArchive")
+  {
+    builder.m_uiChunkedCompressionThreshold = uiChunkSize;
+
+    ezArchiveBuilder::WriteStats stats;
+    EZ_TEST_BOOL(builder.WriteArchive(":chunk/Data.ezArchive", &stats).Succeeded());
+
+    EZ_TEST_INT(stats.m_uiNumEntries, 2);
+    EZ_TEST_BOOL(stats.m_uiStoredBytes < stats.m_uiUncompressedBytes);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Progress")
+  {
+    // the large entry is compressed on a task, its progress is passed on while it is written
+    builder.m_Entries.SetCount(1);
+
+    ezMemoryStreamStorage storage;
+    ezMemoryStreamWriter writer(&storage);
+    EZ_TEST_BOOL(builder.WriteArchive(writer).Succeeded());
+
+    EZ_TEST_INT(builder.m_uiBytesTotal, uiLargeSize);
+
+    if (EZ_TEST_BOOL(!builder.m_BytesWritten.IsEmpty()).Succeeded())
+    {
+      EZ_TEST_INT(builder.m_BytesWritten.PeekBack(), uiLargeSize);
+
+      for (ezUInt32 i = 1; i < builder.m_BytesWritten.GetCount(); ++i)
+      {
+        EZ_TEST_BOOL(builder.m_BytesWritten[i - 1] <= builder.m_BytesWritten[i]);
+      }
+    }
+  }
+
+  ezArchiveReader reader;
+  if (EZ_TEST_BOOL(reader.OpenArchive(sArchiveFile).Succeeded()).Failed())
+    return;
+
+  const ezUInt32 uiLargeEntry = reader.GetArchiveTOC().FindEntry("Large.txt");
+  const ezUInt32 uiSmallEntry = reader.GetArchiveTOC().FindEntry("Small.txt");
+
+  if (EZ_TEST_BOOL(uiLargeEntry != ezInvalidIndex && uiSmallEntry != ezInvalidIndex).Failed())
+    return;
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Compression Modes")
+  {
+    EZ_TEST_BOOL(reader.GetArchiveTOC().m_Entries[uiLargeEntry].m_CompressionMode == ezArchiveCompressionMode::Compressed_zstd_chunked);
+    EZ_TEST_BOOL(reader.GetArchiveTOC().m_Entries[uiSmallEntry].m_CompressionMode == ezArchiveCompressionMode::Compressed_zstd);
+
+    ezArchiveChunkedEntryReader chunkedReader;
+    EZ_TEST_BOOL(reader.ConfigureChunkedEntryReader(uiLargeEntry, chunkedReader).Succeeded());
+    EZ_TEST_INT(chunkedReader.GetNumChunks(), 6);
+    EZ_TEST_INT(chunkedReader.GetChunkSize(), uiChunkSize);
+    EZ_TEST_INT(chunkedReader.GetUncompressedSize(), uiLargeSize);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "ReadEntryRange")
+  {
+    struct Range
+    {
+      ezUInt32 m_uiOffset;
+      ezUInt32 m_uiBytes;
+      ezUInt32 m_uiExpected;
+    };
+
+    const Range ranges[] = {
+      {0, uiLargeSize, uiLargeSize},                   // everything
+      {uiLargeSize - 100, 1000, 100},                  // the tail, clamped to the end
+      {uiChunkSize - 10, 20, 20},                      // across a chunk boundary
+      {2 * uiChunkSize + 5, uiChunkSize, uiChunkSize}, // the uncompressed chunk and the next one
+      {300000, 600000, 600000},                        // several chunks, partial at both ends
+      {uiLargeSize, 10, 0},                            // past the end
+    };
+
+    ezDynamicArray<ezUInt8> buffer;
+
+    for (const Range& range : ranges)
+    {
+      buffer.SetCount(range.m_uiBytes);
+      EZ_TEST_INT(reader.ReadEntryRange(uiLargeEntry, range.m_uiOffset, buffer.GetData(), range.m_uiBytes), range.m_uiExpected);
+      EZ_TEST_BOOL(ezMemoryUtils::IsEqual(buffer.GetData(), largeContent.GetData() + range.m_uiOffset, range.m_uiExpected));
+    }
+
+    // entries that are not chunked support this as well
+    buffer.SetCount(1000);
+    EZ_TEST_INT(reader.ReadEntryRange(uiSmallEntry, 5000, buffer.GetData(), 1000), 1000);
+    EZ_TEST_BOOL(ezMemoryUtils::IsEqual(buffer.GetData(), largeContent.GetData() + 5000, 1000));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Seek and Read")
+  {
+    ezArchiveChunkedEntryReader chunkedReader;
+    if (EZ_TEST_BOOL(reader.ConfigureChunkedEntryReader(uiLargeEntry, chunkedReader).Succeeded()).Failed())
+      return;
+
+    ezUInt8 buffer[5000];
+
+    chunkedReader.SetReadPosition(uiLargeSize - 3000);
+    EZ_TEST_INT(chunkedReader.ReadBytes(buffer, 5000), 3000);
+    EZ_TEST_BOOL(ezMemoryUtils::IsEqual(buffer, largeContent.GetData() + uiLargeSize - 3000, 3000));
+    EZ_TEST_INT(chunkedReader.GetReadPosition(), uiLargeSize);
+
+    chunkedReader.SetReadPosition(100);
+    EZ_TEST_INT(chunkedReader.SkipBytes(3 * uiChunkSize), 3 * uiChunkSize);
+    EZ_TEST_INT(chunkedReader.GetReadPosition(), 3 * uiChunkSize + 100);
+    EZ_TEST_INT(chunkedReader.ReadBytes(buffer, 5000), 5000);
+    EZ_TEST_BOOL(ezMemoryUtils::IsEqual(buffer, largeContent.GetData() + 3 * uiChunkSize + 100, 5000));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Extract")
+  {
+    EZ_TEST_BOOL(reader.ExtractAllFiles(":chunk/Unpacked").Succeeded());
+
+    ezStringBuilder sFileSrc(sDataFolder, "/Large.txt");
+    ezStringBuilder sFileDst(sOutputFolder, "/Unpacked/Large.txt");
+    EZ_TEST_FILES(sFileSrc, sFileDst, "Unpacked file should be identical");
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Mount Archive")
+  {
+    if (EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(sArchiveFile, "ArchiveChunkedTest", "chunkarchive", ezFileSystem::ReadOnly) == EZ_SUCCESS).Failed())
+      return;
+
+    ezFileReader file;
+    if (EZ_TEST_BOOL(file.Open(":chunkarchive/Large.txt").Succeeded()).Failed())
+      return;
+
+    EZ_TEST_INT(file.GetFileSize(), uiLargeSize);
+
+    ezDynamicArray<ezUInt8> fromArchive;
+    fromArchive.SetCountUninitialized(uiLargeSize);
+    EZ_TEST_INT(file.ReadBytes(fromArchive.GetData(), uiLargeSize), uiLargeSize);
+    EZ_TEST_BOOL(fromArchive == largeContent);
+  }
+
+  ezFileSystem::RemoveDataDirectoryGroup("ArchiveChunkedTest");
+}
+
+#  endif
+
+#endif
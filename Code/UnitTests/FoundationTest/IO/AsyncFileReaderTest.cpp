@@ -0,0 +1,219 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/IO/Archive/ArchiveBuilder.h>
+#include <Foundation/IO/FileSystem/AsyncFileReader.h>
+#include <Foundation/IO/FileSystem/FileSystem.h>
+#include <Foundation/IO/FileSystem/FileWriter.h>
+#include <Foundation/IO/OSFile.h>
+
+namespace
+{
+  ezUInt8 AsyncFileReaderTestByte(ezUInt32 uiFile, ezUInt32 uiIndex)
+  {
+    return static_cast<ezUInt8>(uiIndex * 7 + uiIndex / 251 + uiFile);
+  }
+
+  bool AsyncFileReaderTestCompare(ezUInt32 uiFile, ezUInt32 uiOffset, const ezDynamicArray<ezUInt8>& data)
+  {
+    for (ezUInt32 i = 0; i < data.GetCount(); ++i)
+    {
+      if (data[i] != AsyncFileReaderTestByte(uiFile, uiOffset + i))
+        return false;
+    }
+
+    return true;
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(IO, AsyncFileReader)
+{
+  ezStringBuilder sOutputFolder = ezTestFramework::GetInstance()->GetAbsOutputPath();
+  sOutputFolder.AppendPath("AsyncFileReaderTest");
+  sOutputFolder.MakeCleanPath();
+
+  // the large file is read in several pieces
+  const ezUInt32 fileSizes[] = {0, 1, 1000, 3 * 512 * 1024 + 17};
+  const ezUInt32 uiNumFiles = EZ_ARRAY_SIZE(fileSizes);
+
+  ezStringBuilder sFile;
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Setup")
+  {
+    if (EZ_TEST_BOOL(ezOSFile::CreateDirectoryStructure(sOutputFolder).Succeeded()).Failed())
+      return;
+
+    if (EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(sOutputFolder, "AsyncFileReaderTest", "async", ezFileSystem::AllowWrites) == EZ_SUCCESS).Failed())
+      return;
+
+    for (ezUInt32 uiFile = 0; uiFile < uiNumFiles; ++uiFile)
+    {
+      ezDynamicArray<ezUInt8> content;
+      content.SetCountUninitialized(fileSizes[uiFile]);
+      for (ezUInt32 i = 0; i < content.GetCount(); ++i)
+      {
+        content[i] = AsyncFileReaderTestByte(uiFile, i);
+      }
+
+      sFile.Format(":async/File{}.bin", uiFile);
+
+      ezFileWriter file;
+      if (EZ_TEST_BOOL(file.Open(sFile).Succeeded()).Failed())
+        return;
+
+      EZ_TEST_BOOL(file.WriteBytes(content.GetData(), content.GetCount()).Succeeded());
+    }
+
+    ezStringBuilder sAbsolutePath;
+    EZ_TEST_BOOL(ezFileSystem::GetOSFilePath(":async/File1.bin", sAbsolutePath).Succeeded());
+    EZ_TEST_BOOL(sAbsolutePath.EndsWith("AsyncFileReaderTest/File1.bin"));
+    EZ_TEST_BOOL(ezFileSystem::GetOSFilePath(":async/DoesNotExist.bin", sAbsolutePath).Failed());
+    EZ_TEST_BOOL(sAbsolutePath.IsEmpty());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Read Files")
+  {
+    ezAsyncFileReader reader;
+    ezAsyncFileReadResult results[uiNumFiles];
+
+    for (ezUInt32 uiFile = 0; uiFile < uiNumFiles; ++uiFile)
+    {
+      sFile.Format(":async/File{}.bin", uiFile);
+      reader.ReadFile(sFile, [&results, uiFile](ezAsyncFileReadResult& result) { results[uiFile] = std::move(result); });
+    }
+
+    EZ_TEST_INT(reader.GetNumPendingReads(), uiNumFiles);
+    reader.WaitForAll();
+    EZ_TEST_INT(reader.GetNumPendingReads(), 0);
+
+    for (ezUInt32 uiFile = 0; uiFile < uiNumFiles; ++uiFile)
+    {
+      EZ_TEST_BOOL(results[uiFile].m_Result.Succeeded());
+      EZ_TEST_INT(results[uiFile].m_uiRequestID, uiFile + 1);
+      EZ_TEST_INT(results[uiFile].m_Data.GetCount(), fileSizes[uiFile]);
+      EZ_TEST_BOOL(AsyncFileReaderTestCompare(uiFile, 0, results[uiFile].m_Data));
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Offset and Size")
+  {
+    ezAsyncFileReader reader;
+    ezAsyncFileReadResult resultRange, resultTail, resultBehindEnd;
+
+    reader.ReadFile(":async/File3.bin", [&](ezAsyncFileReadResult& result) { resultRange = std::move(result); }, 1000, 600000);
+    reader.ReadFile(":async/File3.bin", [&](ezAsyncFileReadResult& result) { resultTail = std::move(result); }, fileSizes[3] - 10);
+    reader.ReadFile(":async/File2.bin", [&](ezAsyncFileReadResult& result) { resultBehindEnd = std::move(result); }, 5000);
+    reader.WaitForAll();
+
+    EZ_TEST_BOOL(resultRange.m_Result.Succeeded());
+    EZ_TEST_INT(resultRange.m_Data.GetCount(), 600000);
+    EZ_TEST_BOOL(AsyncFileReaderTestCompare(3, 1000, resultRange.m_Data));
+
+    EZ_TEST_BOOL(resultTail.m_Result.Succeeded());
+    EZ_TEST_INT(resultTail.m_Data.GetCount(), 10);
+    EZ_TEST_BOOL(AsyncFileReaderTestCompare(3, fileSizes[3] - 10, resultTail.m_Data));
+
+    EZ_TEST_BOOL(resultBehindEnd.m_Result.Succeeded());
+    EZ_TEST_BOOL(resultBehindEnd.m_Data.IsEmpty());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Missing File")
+  {
+    ezAsyncFileReader reader;
+    ezAsyncFileReadResult missing;
+    missing.m_Result = EZ_SUCCESS;
+
+    reader.ReadFile(":async/DoesNotExist.bin", [&](ezAsyncFileReadResult& result) { missing = std::move(result); });
+    reader.WaitForAll();
+
+    EZ_TEST_BOOL(missing.m_Result.Failed());
+    EZ_TEST_STRING(missing.m_sFile, ":async/DoesNotExist.bin");
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Poll and Chained Reads")
+  {
+    // a small queue, so that the pieces of the large file have to wait for free slots
+    ezAsyncFileReader reader(2);
+    ezUInt32 uiNumCompleted = 0;
+    ezUInt32 uiNumSucceeded = 0;
+
+    ezAsyncFileReader::CompletionCallback onCompleted = [&](ezAsyncFileReadResult& result) {
+      ++uiNumCompleted;
+      if (result.m_Result.Succeeded() && result.m_Data.GetCount() == fileSizes[3] && AsyncFileReaderTestCompare(3, 0, result.m_Data))
+        ++uiNumSucceeded;
+
+      // start the next read from within the callback
+      if (uiNumCompleted < 4)
+        reader.ReadFile(":async/File3.bin", onCompleted);
+    };
+
+    reader.ReadFile(":async/File3.bin", onCompleted);
+
+    ezUInt32 uiNumPolled = 0;
+    while (reader.GetNumPendingReads() > 0)
+    {
+      uiNumPolled += reader.Poll();
+    }
+
+    EZ_TEST_INT(uiNumPolled, 4);
+    EZ_TEST_INT(uiNumCompleted, 4);
+    EZ_TEST_INT(uiNumSucceeded, 4);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Destruction With Reads In Flight")
+  {
+    ezUInt32 uiNumCompleted = 0;
+
+    {
+      ezAsyncFileReader reader;
+      for (ezUInt32 uiFile = 0; uiFile < uiNumFiles; ++uiFile)
+      {
+        sFile.Format(":async/File{}.bin", uiFile);
+        reader.ReadFile(sFile, [&](ezAsyncFileReadResult& result) { ++uiNumCompleted; });
+      }
+    }
+
+    EZ_TEST_INT(uiNumCompleted, 0);
+  }
+
+#if EZ_ENABLED(EZ_SUPPORTS_MEMORY_MAPPED_FILE)
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Files In Archives")
+  {
+    // these cannot be read by the OS directly and go through ezFileReader on worker tasks
+    ezArchiveBuilder builder;
+    for (ezUInt32 uiFile = 2; uiFile < uiNumFiles; ++uiFile)
+    {
+      auto& entry = builder.m_Entries.ExpandAndGetRef();
+      sFile.Format("{}/File{}.bin", sOutputFolder, uiFile);
+      entry.m_sAbsSourcePath = sFile;
+      entry.m_sRelTargetPath = ezPathUtils::GetFileNameAndExtension(sFile);
+    }
+
+    if (EZ_TEST_BOOL(builder.WriteArchive(":async/Files.ezArchive").Succeeded()).Failed())
+      return;
+
+    const ezStringBuilder sArchiveFile(sOutputFolder, "/Files.ezArchive");
+    if (EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(sArchiveFile, "AsyncFileReaderTest", "asyncarchive", ezFileSystem::ReadOnly) == EZ_SUCCESS).Failed())
+      return;
+
+    ezStringBuilder sAbsolutePath;
+    EZ_TEST_BOOL(ezFileSystem::GetOSFilePath(":asyncarchive/File3.bin", sAbsolutePath).Failed());
+
+    ezAsyncFileReader reader;
+    ezAsyncFileReadResult resultFull, resultRange;
+
+    reader.ReadFile(":asyncarchive/File3.bin", [&](ezAsyncFileReadResult& result) { resultFull = std::move(result); });
+    reader.ReadFile(":asyncarchive/File2.bin", [&](ezAsyncFileReadResult& result) { resultRange = std::move(result); }, 100, 200);
+    reader.WaitForAll();
+
+    EZ_TEST_BOOL(resultFull.m_Result.Succeeded());
+    EZ_TEST_INT(resultFull.m_Data.GetCount(), fileSizes[3]);
+    EZ_TEST_BOOL(AsyncFileReaderTestCompare(3, 0, resultFull.m_Data));
+
+    EZ_TEST_BOOL(resultRange.m_Result.Succeeded());
+    EZ_TEST_INT(resultRange.m_Data.GetCount(), 200);
+    EZ_TEST_BOOL(AsyncFileReaderTestCompare(2, 100, resultRange.m_Data));
+  }
+#endif
+
+  ezFileSystem::RemoveDataDirectoryGroup("AsyncFileReaderTest");
+}
@@ -136,4 +136,83 @@ EZ_CREATE_SIMPLE_TEST(IO, CompressedStreamZstd)
   }
 }
 
+EZ_CREATE_SIMPLE_TEST(IO, CompressedStreamZstdDictionary)
+{
+  // small records that share most of their content, this is where a dictionary helps most
+  auto MakeRecord = [](ezUInt32 uiIndex, ezStringBuilder& out_sRecord) {
+    out_sRecord.Format("Material\n  Shader = \"Shaders/Materials/DefaultMaterial.ezShader\"\n  BaseTexture = \"Textures/Texture{}.dds\"\n"
+                       "  NormalTexture = \"Textures/Texture{}_n.dds\"\n  BaseColor = (1.0, {}, 0.5, 1.0)\n  RoughnessValue = 0.{}\n"
+                       "  MetallicValue = 0.0\n  BlendMode = \"Opaque\"\n  TwoSided = false\n",
+      uiIndex, uiIndex, uiIndex % 7, uiIndex % 10);
+  };
+
+  ezStringBuilder sRecord;
+  ezDynamicArray<ezUInt8> dictionaryData;
+
+  for (ezUInt32 i = 0; i < 4; ++i)
+  {
+    MakeRecord(i, sRecord);
+    dictionaryData.PushBackRange(ezArrayPtr<const ezUInt8>(reinterpret_cast<const ezUInt8*>(sRecord.GetData()), sRecord.GetElementCount()));
+  }
+
+  ezCompressedStreamZstdDictionary compressionDictionary;
+  ezCompressedStreamZstdDictionary decompressionDictionary;
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Initialize")
+  {
+    EZ_TEST_BOOL(compressionDictionary.InitializeForCompression(dictionaryData).Succeeded());
+    EZ_TEST_BOOL(decompressionDictionary.InitializeForDecompression(dictionaryData).Succeeded());
+
+    EZ_TEST_INT(compressionDictionary.GetDictionarySize(), dictionaryData.GetCount());
+    EZ_TEST_INT(decompressionDictionary.GetDictionarySize(), dictionaryData.GetCount());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Compress and Uncompress")
+  {
+    ezCompressedStreamWriterZstd writer;
+    ezCompressedStreamReaderZstd reader;
+
+    // the same writer and reader are reused with and without the dictionary
+    for (ezUInt32 uiRecord = 10; uiRecord < 20; ++uiRecord)
+    {
+      MakeRecord(uiRecord, sRecord);
+
+      ezMemoryStreamStorage storagePlain;
+      ezMemoryStreamWriter writerPlain(&storagePlain);
+      writer.SetOutputStream(&writerPlain);
+      writer.SetDictionary(nullptr);
+      EZ_TEST_BOOL(writer.WriteBytes(sRecord.GetData(), sRecord.GetElementCount()).Succeeded());
+      EZ_TEST_BOOL(writer.FinishCompressedStream().Succeeded());
+
+      ezMemoryStreamStorage storageDict;
+      ezMemoryStreamWriter writerDict(&storageDict);
+      writer.SetOutputStream(&writerDict);
+      writer.SetDictionary(&compressionDictionary);
+      EZ_TEST_BOOL(writer.WriteBytes(sRecord.GetData(), sRecord.GetElementCount()).Succeeded());
+      EZ_TEST_BOOL(writer.FinishCompressedStream().Succeeded());
+
+      // most of the record is found in the dictionary
+      EZ_TEST_BOOL(storageDict.GetStorageSize() * 2 < storagePlain.GetStorageSize());
+
+      ezHybridArray<char, 512> decompressed;
+      decompressed.SetCount(sRecord.GetElementCount());
+
+      ezMemoryStreamReader readerPlain(&storagePlain);
+      reader.SetInputStream(&readerPlain);
+      reader.SetDictionary(nullptr);
+      EZ_TEST_INT(reader.ReadBytes(decompressed.GetData(), decompressed.GetCount()), sRecord.GetElementCount());
+      EZ_TEST_BOOL(ezMemoryUtils::IsEqual(decompressed.GetData(), sRecord.GetData(), sRecord.GetElementCount()));
+
+      decompressed.SetCount(0);
+      decompressed.SetCount(sRecord.GetElementCount());
+
+      ezMemoryStreamReader readerDict(&storageDict);
+      reader.SetInputStream(&readerDict);
+      reader.SetDictionary(&decompressionDictionary);
+      EZ_TEST_INT(reader.ReadBytes(decompressed.GetData(), decompressed.GetCount()), sRecord.GetElementCount());
+      EZ_TEST_BOOL(ezMemoryUtils::IsEqual(decompressed.GetData(), sRecord.GetData(), sRecord.GetElementCount()));
+    }
+  }
+}
+
 #endif
@@ -331,4 +331,63 @@ string{\"s\\2\",\"bla\"}\n\
     ezOpenDdlReader doc;
     EZ_TEST_BOOL(doc.ParseDocument(stream).Failed());
   }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Parse From Memory")
+  {
+    // long strings and whitespace runs that cross the internal read buffer of the stream version
+    ezStringBuilder sLong;
+    for (ezUInt32 i = 0; i < 2000; ++i)
+    {
+      sLong.AppendFormat("abc{}\\\"xyz ", i);
+    }
+
+    ezStringBuilder sDoc;
+    for (ezUInt32 i = 0; i < 100; ++i)
+    {
+      ezStringBuilder sIndex;
+      sIndex.Format("{}", i);
+
+      sDoc.Append("Obj", sIndex, "\n{\n  // comment\n  string{\"", (i % 10 == 0) ? sLong.GetData() : "plain", "\",  \"s");
+      sDoc.Append(sIndex, "\"}\n                                        \n");
+      sDoc.Append("  int32 $Value", sIndex, "{", sIndex, ", /* comment */ 2}\n}\n");
+    }
+
+    StringStream stream(sDoc);
+
+    ezOpenDdlReader docStream;
+    EZ_TEST_BOOL(docStream.ParseDocument(stream).Succeeded());
+
+    ezOpenDdlReader docMem;
+    EZ_TEST_BOOL(docMem.ParseDocument(ezArrayPtr<const ezUInt8>((const ezUInt8*)sDoc.GetData(), sDoc.GetElementCount())).Succeeded());
+    EZ_TEST_INT(docMem.GetRootElement()->GetNumChildObjects(), 100);
+    EZ_TEST_BOOL(docMem.FindElement("Value99") != nullptr);
+
+    ezStringBuilder sExpected = sLong;
+    sExpected.ReplaceAll("\\\"", "\"");
+    EZ_TEST_BOOL(docMem.GetRootElement()->GetFirstChild()->GetFirstChild()->GetPrimitivesString()[0] == sExpected);
+
+    ezStringBuilder sFromStream, sFromMemory;
+    WriteToString(docStream, sFromStream);
+    WriteToString(docMem, sFromMemory);
+    TestEqual(sFromStream, sFromMemory);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Fatal Errors From Memory")
+  {
+    const char* szTestData = "\
+string{\"s1\",\"back\\slash\"\n\
+string{\"s\\2\",\"bla\"}\n\
+";
+
+    ezTestLogInterface log;
+    ezTestLogSystemScope logSystemScope(&log);
+
+    log.ExpectMessage("Unknown escape-sequence '\\s'", ezLogMsgType::WarningMsg);
+    log.ExpectMessage("Line 2 (2): Expected , or } or a \"", ezLogMsgType::ErrorMsg);
+
+    const ezArrayPtr<const ezUInt8> data((const ezUInt8*)szTestData, ezStringUtils::GetStringElementCount(szTestData));
+
+    ezOpenDdlReader doc;
+    EZ_TEST_BOOL(doc.ParseDocument(data).Failed());
+  }
 }
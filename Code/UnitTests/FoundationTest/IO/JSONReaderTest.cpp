@@ -465,5 +465,53 @@ EZ_CREATE_SIMPLE_TEST(IO, JSONReader)
     JSONReaderTestDetail::TraverseTree(reader.GetTopLevelObject(), sCompare);
 
     EZ_TEST_BOOL(sCompare.IsEmpty());
+
+    // parsing from memory must give the same result
+    ezJSONReader readerMem;
+    const ezArrayPtr<const ezUInt8> data((const ezUInt8*)szTestData, ezStringUtils::GetStringElementCount(szTestData));
+    EZ_TEST_BOOL(readerMem.Parse(data).Succeeded());
+    EZ_TEST_BOOL(readerMem.GetTopLevelObject() == reader.GetTopLevelObject());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Parse From Memory")
+  {
+    // long strings and whitespace runs that cross the internal read buffer of the stream version
+    ezStringBuilder sLong;
+    for (ezUInt32 i = 0; i < 2000; ++i)
+    {
+      sLong.AppendFormat("abc{}\\\"xyz ", i);
+    }
+
+    ezStringBuilder sDoc;
+    sDoc.Append("{\n");
+    for (ezUInt32 i = 0; i < 100; ++i)
+    {
+      const char* szValue = (i % 10 == 0) ? sLong.GetData() : "plain value";
+      sDoc.AppendFormat("\"var{}\" :\t\"{}\",\n                                        \n", i, szValue);
+    }
+    sDoc.Append("\"last\" : [1, 2, \"three\"]\n}");
+
+    JSONReaderTestDetail::StringStream stream(sDoc.GetData());
+
+    ezJSONReader readerStream;
+    EZ_TEST_BOOL(readerStream.Parse(stream).Succeeded());
+
+    ezJSONReader readerMem;
+    EZ_TEST_BOOL(readerMem.Parse(ezArrayPtr<const ezUInt8>((const ezUInt8*)sDoc.GetData(), sDoc.GetElementCount())).Succeeded());
+
+    EZ_TEST_INT(readerMem.GetTopLevelObject().GetCount(), 101);
+    EZ_TEST_BOOL(readerMem.GetTopLevelObject() == readerStream.GetTopLevelObject());
+
+    ezStringBuilder sExpected = sLong;
+    sExpected.ReplaceAll("\\\"", "\"");
+    EZ_TEST_STRING(readerMem.GetTopLevelObject().GetValue("var20")->Get<ezString>(), sExpected);
+    EZ_TEST_STRING(readerMem.GetTopLevelObject().GetValue("var21")->Get<ezString>(), "plain value");
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Parse Empty Memory")
+  {
+    ezJSONReader reader;
+    EZ_TEST_BOOL(reader.Parse(ezArrayPtr<const ezUInt8>()).Succeeded());
+    EZ_TEST_INT(reader.GetTopLevelObject().GetCount(), 0);
   }
 }
@@ -35,6 +35,42 @@ namespace
     ezInt32 m_uiMember1 = 0x42;
     ezInt32 m_uiMember2 = 0x23;
   };
+
+  class CountingStreamWriter : public ezStreamWriter
+  {
+  public:
+    CountingStreamWriter(ezStreamWriter& writer)
+      : m_Writer(writer)
+    {
+    }
+
+    virtual ezResult WriteBytes(const void* pWriteBuffer, ezUInt64 uiBytesToWrite) override
+    {
+      ++m_uiNumCalls;
+      return m_Writer.WriteBytes(pWriteBuffer, uiBytesToWrite);
+    }
+
+    ezStreamWriter& m_Writer;
+    ezUInt32 m_uiNumCalls = 0;
+  };
+
+  class CountingStreamReader : public ezStreamReader
+  {
+  public:
+    CountingStreamReader(ezStreamReader& reader)
+      : m_Reader(reader)
+    {
+    }
+
+    virtual ezUInt64 ReadBytes(void* pReadBuffer, ezUInt64 uiBytesToRead) override
+    {
+      ++m_uiNumCalls;
+      return m_Reader.ReadBytes(pReadBuffer, uiBytesToRead);
+    }
+
+    ezStreamReader& m_Reader;
+    ezUInt32 m_uiNumCalls = 0;
+  };
 } // namespace
 
 EZ_CREATE_SIMPLE_TEST(IO, StreamOperation)
@@ -182,6 +218,114 @@ EZ_CREATE_SIMPLE_TEST(IO, StreamOperation)
     }
   }
 
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Binary Stream Arrays of POD Types")
+  {
+    EZ_CHECK_AT_COMPILETIME(ezIsStreamPodType<ezVec3>);
+    EZ_CHECK_AT_COMPILETIME(ezIsStreamPodType<ezMat4d>);
+    EZ_CHECK_AT_COMPILETIME(ezIsStreamPodType<ezColorGammaUB>);
+    EZ_CHECK_AT_COMPILETIME(!ezIsStreamPodType<ezTransform>);
+    EZ_CHECK_AT_COMPILETIME(!ezIsStreamPodType<bool>);
+    EZ_CHECK_AT_COMPILETIME(!ezIsStreamPodType<SerializableStructWithMethods>);
+
+    ezMemoryStreamStorage StreamStorage(4096);
+
+    ezDynamicArray<ezVec3> positions;
+    ezQuat rotations[3];
+    ezDynamicArray<ezTransform> transforms;
+
+    for (ezUInt32 i = 0; i < 100; ++i)
+    {
+      positions.PushBack(ezVec3(i * 1.0f, i * 2.0f, i * -3.0f));
+    }
+
+    for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(rotations); ++i)
+    {
+      rotations[i].SetFromAxisAndAngle(ezVec3(0, 0, 1), ezAngle::Degree(i * 10.0f));
+      transforms.PushBack(ezTransform(positions[i], rotations[i], ezVec3(1, 2, 3)));
+    }
+
+    {
+      ezMemoryStreamWriter StreamWriter(&StreamStorage);
+      CountingStreamWriter writer(StreamWriter);
+
+      writer.WriteArray(positions);
+      EZ_TEST_INT(writer.m_uiNumCalls, 2);
+
+      writer.WriteArray(rotations);
+      EZ_TEST_INT(writer.m_uiNumCalls, 4);
+
+      // stored in a different order than in memory, so each member is written separately
+      writer.WriteArray(transforms);
+      EZ_TEST_INT(writer.m_uiNumCalls, 5 + 3 * 3);
+
+      writer << positions[1];
+      EZ_TEST_INT(writer.m_uiNumCalls, 15);
+    }
+
+    // the data in the stream must not have changed compared to writing each member separately
+    {
+      ezMemoryStreamReader StreamReader(&StreamStorage);
+
+      ezUInt64 uiCount = 0;
+      StreamReader >> uiCount;
+      EZ_TEST_INT(uiCount, positions.GetCount());
+
+      for (const ezVec3& v : positions)
+      {
+        float x, y, z;
+        StreamReader >> x;
+        StreamReader >> y;
+        StreamReader >> z;
+        EZ_TEST_VEC3(ezVec3(x, y, z), v, 0.0f);
+      }
+    }
+
+    {
+      ezMemoryStreamReader StreamReader(&StreamStorage);
+      CountingStreamReader reader(StreamReader);
+
+      ezHybridArray<ezVec3, 4> readPositions;
+      ezQuat readRotations[3];
+      ezDynamicArray<ezTransform> readTransforms;
+      ezVec3 vReadPosition;
+
+      EZ_TEST_BOOL(reader.ReadArray(readPositions).Succeeded());
+      EZ_TEST_INT(reader.m_uiNumCalls, 2);
+      EZ_TEST_BOOL(readPositions == positions);
+
+      EZ_TEST_BOOL(reader.ReadArray(readRotations).Succeeded());
+      EZ_TEST_INT(reader.m_uiNumCalls, 4);
+
+      EZ_TEST_BOOL(reader.ReadArray(readTransforms).Succeeded());
+      EZ_TEST_BOOL(readTransforms == transforms);
+
+      reader >> vReadPosition;
+      EZ_TEST_VEC3(vReadPosition, positions[1], 0.0f);
+
+      for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(rotations); ++i)
+      {
+        EZ_TEST_BOOL(readRotations[i] == rotations[i]);
+      }
+    }
+
+    // a truncated stream fails and does not leave uninitialized elements behind
+    {
+      ezMemoryStreamStorage TruncatedStorage;
+      ezMemoryStreamWriter StreamWriter(&TruncatedStorage);
+
+      const ezUInt64 uiCount = 10;
+      StreamWriter << uiCount;
+      StreamWriter << ezVec3(1, 2, 3);
+
+      ezMemoryStreamReader StreamReader(&TruncatedStorage);
+      ezDynamicArray<ezVec3> readPositions;
+      readPositions.PushBack(ezVec3(4, 5, 6));
+
+      EZ_TEST_BOOL(StreamReader.ReadArray(readPositions).Failed());
+      EZ_TEST_BOOL(readPositions.IsEmpty());
+    }
+  }
+
   EZ_TEST_BLOCK(ezTestBlock::Enabled, "ezSet Stream Operators")
   {
     ezMemoryStreamStorage StreamStorage(4096);
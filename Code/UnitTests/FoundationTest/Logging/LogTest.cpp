@@ -2,6 +2,8 @@
 
 #include <Foundation/Configuration/Startup.h>
 #include <Foundation/IO/FileSystem/DataDirTypeFolder.h>
+#include <Foundation/IO/MemoryStream.h>
+#include <Foundation/Logging/BinaryWriter.h>
 #include <Foundation/Logging/ConsoleWriter.h>
 #include <Foundation/Logging/HTMLWriter.h>
 #include <Foundation/Logging/Log.h>
@@ -61,6 +63,44 @@ namespace
     ezStringBuilder m_Result;
   };
 
+  class BinaryLogTestInterface : public ezLogInterface
+  {
+  public:
+    virtual void HandleLogMessage(const ezLoggingEventData& le) override { m_Writer.LogMessageHandler(le); }
+
+    ezLogWriter::Binary m_Writer;
+  };
+
+  void WriteBinaryTestLog(ezMemoryStreamStorage& storage, bool bCompress)
+  {
+    ezMemoryStreamWriter writer(&storage);
+
+    BinaryLogTestInterface log;
+    log.SetLogLevel(ezLogMsgType::All);
+    log.m_Writer.BeginLog(writer, bCompress);
+
+    {
+      ezLogSystemScope logScope(&log);
+
+      ezLog::Info("Loaded {0} objects", 12);
+      ezLog::Info("Loaded {0} objects", 345);
+
+      {
+        EZ_LOG_BLOCK("Outer Block");
+        ezLog::Warning("Value 007 at {0}", 1.5f);
+
+        {
+          EZ_LOG_BLOCK("Inner Block");
+          ezLog::Error("Id 12345678901234567890123 is invalid");
+        }
+      }
+
+      ezLog::Dev("No arguments");
+    }
+
+    EZ_TEST_INT(log.m_Writer.GetNumWrittenMessages(), 9);
+    log.m_Writer.EndLog();
+  }
 } // namespace
 
 EZ_CREATE_SIMPLE_TEST(Logging, Log)
@@ -254,3 +294,280 @@ EZ_CREATE_SIMPLE_TEST(Logging, GlobalTestLog)
     }
   }
 }
+
+EZ_CREATE_SIMPLE_TEST(Logging, AsyncMode)
+{
+  struct AsyncLogWriter
+  {
+    void LogMessageHandler(const ezLoggingEventData& le)
+    {
+      if (le.m_EventType == ezLogMsgType::InfoMsg && ezStringUtils::StartsWith(le.m_szText, "Async "))
+      {
+        m_Messages.PushBack(le.m_szText);
+      }
+      else if (le.m_EventType == ezLogMsgType::WarningMsg && ezStringUtils::FindSubString(le.m_szText, "were dropped") != nullptr)
+      {
+        ++m_uiDropWarnings;
+      }
+    }
+
+    ezDynamicArray<ezString> m_Messages;
+    ezUInt32 m_uiDropWarnings = 0;
+  };
+
+  ezLogInterface* pLog = ezLog::GetThreadLocalLogSystem();
+  const ezLogMsgType::Enum prevLogLevel = pLog->GetLogLevel();
+  pLog->SetLogLevel(ezLogMsgType::All);
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Ordering and Flush")
+  {
+    AsyncLogWriter writer;
+    ezGlobalLog::AddLogWriter(ezMakeDelegate(&AsyncLogWriter::LogMessageHandler, &writer));
+
+    ezAsyncLogConfig config;
+    config.m_OverflowPolicy = ezAsyncLogConfig::OverflowPolicy::Block;
+    ezGlobalLog::EnableAsyncMode(config);
+    EZ_TEST_BOOL(ezGlobalLog::IsAsyncModeEnabled());
+
+    for (ezUInt32 i = 0; i < 1000; ++i)
+    {
+      ezLog::Info(pLog, "Async {0}", i);
+    }
+
+    ezGlobalLog::FlushAsyncMessages();
+
+    EZ_TEST_INT(writer.m_Messages.GetCount(), 1000);
+
+    if (writer.m_Messages.GetCount() == 1000)
+    {
+      ezStringBuilder sExpected;
+      for (ezUInt32 i = 0; i < 1000; ++i)
+      {
+        sExpected.Format("Async {0}", i);
+        EZ_TEST_STRING(writer.m_Messages[i], sExpected);
+      }
+    }
+
+    ezGlobalLog::DisableAsyncMode();
+    EZ_TEST_BOOL(!ezGlobalLog::IsAsyncModeEnabled());
+
+    // synchronous again
+    ezLog::Info(pLog, "Async sync");
+    EZ_TEST_INT(writer.m_Messages.GetCount(), 1001);
+
+    ezGlobalLog::RemoveLogWriter(ezMakeDelegate(&AsyncLogWriter::LogMessageHandler, &writer));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Multiple Threads")
+  {
+    AsyncLogWriter writer;
+    ezGlobalLog::AddLogWriter(ezMakeDelegate(&AsyncLogWriter::LogMessageHandler, &writer));
+
+    ezAsyncLogConfig config;
+    config.m_OverflowPolicy = ezAsyncLogConfig::OverflowPolicy::Block;
+    config.m_uiBufferSizePerThread = 4 * 1024;
+    ezGlobalLog::EnableAsyncMode(config);
+
+    class AsyncLogThread : public ezThread
+    {
+    public:
+      virtual ezUInt32 Run() override
+      {
+        for (ezUInt32 i = 0; i < 500; ++i)
+        {
+          ezLog::Info("Async {0}", i);
+        }
+        return 0;
+      }
+    };
+
+    AsyncLogThread threads[4];
+
+    for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(threads); ++i)
+    {
+      threads[i].Start();
+    }
+
+    for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(threads); ++i)
+    {
+      threads[i].Join();
+    }
+
+    ezGlobalLog::DisableAsyncMode();
+
+    EZ_TEST_INT(writer.m_Messages.GetCount(), 2000);
+    EZ_TEST_INT(writer.m_uiDropWarnings, 0);
+
+    ezGlobalLog::RemoveLogWriter(ezMakeDelegate(&AsyncLogWriter::LogMessageHandler, &writer));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Drop Policy")
+  {
+    AsyncLogWriter writer;
+    ezGlobalLog::AddLogWriter(ezMakeDelegate(&AsyncLogWriter::LogMessageHandler, &writer));
+
+    ezAsyncLogConfig config;
+    config.m_OverflowPolicy = ezAsyncLogConfig::OverflowPolicy::Drop;
+    config.m_uiBufferSizePerThread = 1024;
+    config.m_ProcessingInterval = ezTime::Seconds(10);
+    ezGlobalLog::EnableAsyncMode(config);
+
+    const ezUInt64 uiPrevDropped = ezGlobalLog::GetNumDroppedAsyncMessages();
+
+    for (ezUInt32 i = 0; i < 1000; ++i)
+    {
+      ezLog::Info(pLog, "Async {0}", i);
+    }
+
+    ezGlobalLog::FlushAsyncMessages();
+
+    const ezUInt64 uiDropped = ezGlobalLog::GetNumDroppedAsyncMessages() - uiPrevDropped;
+    EZ_TEST_BOOL(uiDropped > 0);
+    EZ_TEST_INT(writer.m_Messages.GetCount() + uiDropped, 1000);
+    EZ_TEST_INT(writer.m_uiDropWarnings, 1);
+
+    ezGlobalLog::DisableAsyncMode();
+    ezGlobalLog::RemoveLogWriter(ezMakeDelegate(&AsyncLogWriter::LogMessageHandler, &writer));
+  }
+
+  pLog->SetLogLevel(prevLogLevel);
+}
+
+EZ_CREATE_SIMPLE_TEST(Logging, BinaryWriter)
+{
+  for (ezUInt32 iCompress = 0; iCompress < 2; ++iCompress)
+  {
+    EZ_TEST_BLOCK(ezTestBlock::Enabled, iCompress == 0 ? "Uncompressed Round Trip" : "Compressed Round Trip")
+    {
+      ezMemoryStreamStorage storage;
+      WriteBinaryTestLog(storage, iCompress != 0);
+
+      ezMemoryStreamReader stream(&storage);
+      ezBinaryLogReader reader;
+      EZ_TEST_BOOL(reader.Open(stream).Succeeded());
+
+      ezBinaryLogEntry entries[10];
+      ezUInt32 uiNumEntries = 0;
+      while (uiNumEntries < EZ_ARRAY_SIZE(entries) && reader.ReadNextEntry(entries[uiNumEntries]).Succeeded())
+      {
+        ++uiNumEntries;
+      }
+
+      EZ_TEST_INT(uiNumEntries, 9);
+      if (uiNumEntries != 9)
+        continue;
+
+      EZ_TEST_INT(entries[0].m_Type, ezLogMsgType::InfoMsg);
+      EZ_TEST_STRING(entries[0].m_sText, "Loaded 12 objects");
+      EZ_TEST_STRING(entries[1].m_sText, "Loaded 345 objects");
+      EZ_TEST_INT(entries[0].m_uiTemplateIndex, entries[1].m_uiTemplateIndex);
+
+      EZ_TEST_INT(entries[2].m_Type, ezLogMsgType::BeginGroup);
+      EZ_TEST_STRING(entries[2].m_sText, "Outer Block");
+      EZ_TEST_INT(entries[3].m_Type, ezLogMsgType::WarningMsg);
+      EZ_TEST_STRING(entries[3].m_sText, "Value 007 at 1.5");
+      EZ_TEST_INT(entries[3].m_uiIndentation, 1);
+      EZ_TEST_INT(entries[4].m_Type, ezLogMsgType::BeginGroup);
+      EZ_TEST_STRING(entries[4].m_sText, "Inner Block");
+      EZ_TEST_INT(entries[5].m_Type, ezLogMsgType::ErrorMsg);
+      EZ_TEST_STRING(entries[5].m_sText, "Id 12345678901234567890123 is invalid");
+      EZ_TEST_INT(entries[5].m_uiIndentation, 2);
+      EZ_TEST_INT(entries[6].m_Type, ezLogMsgType::EndGroup);
+      EZ_TEST_STRING(entries[6].m_sText, "Inner Block");
+      EZ_TEST_INT(entries[7].m_Type, ezLogMsgType::EndGroup);
+      EZ_TEST_STRING(entries[7].m_sText, "Outer Block");
+      EZ_TEST_INT(entries[8].m_Type, ezLogMsgType::DevMsg);
+      EZ_TEST_STRING(entries[8].m_sText, "No arguments");
+
+      for (ezUInt32 i = 0; i < uiNumEntries; ++i)
+      {
+        EZ_TEST_INT(entries[i].m_uiThreadIndex, entries[0].m_uiThreadIndex);
+        EZ_TEST_BOOL(entries[i].m_iTimestamp >= entries[0].m_iTimestamp);
+      }
+
+      ezStringBuilder sLine;
+      ezBinaryLogReader::FormatEntry(entries[5], sLine, ezLog::TimestampMode::None);
+      EZ_TEST_BOOL(sLine.EndsWith("  Error: Id 12345678901234567890123 is invalid"));
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Async Mode")
+  {
+    ezMemoryStreamStorage storage;
+    ezMemoryStreamWriter writer(&storage);
+
+    ezLogWriter::Binary binaryWriter;
+    binaryWriter.BeginLog(writer, false);
+    ezGlobalLog::AddLogWriter(ezMakeDelegate(&ezLogWriter::Binary::LogMessageHandler, &binaryWriter));
+
+    ezAsyncLogConfig config;
+    config.m_OverflowPolicy = ezAsyncLogConfig::OverflowPolicy::Block;
+    config.m_ProcessingInterval = ezTime::Seconds(10);
+    ezGlobalLog::EnableAsyncMode(config);
+
+    class BinaryLogThread : public ezThread
+    {
+    public:
+      virtual ezUInt32 Run() override
+      {
+        m_uiThreadIndex = ezLog::GetCurrentThreadIndex();
+
+        for (ezUInt32 i = 0; i < 10; ++i)
+        {
+          ezLog::Info("Async Binary {0}", i);
+        }
+        return 0;
+      }
+
+      ezUInt16 m_uiThreadIndex = 0;
+    };
+
+    BinaryLogThread thread;
+    thread.Start();
+    thread.Join();
+
+    // the messages are written later, the entries must still carry the time and thread of the ezLog call
+    const ezInt64 iLoggedBefore = ezTimestamp::CurrentTimestamp().GetInt64(ezSIUnitOfTime::Microsecond);
+    ezThreadUtils::Sleep(ezTime::Milliseconds(50));
+
+    ezGlobalLog::FlushAsyncMessages();
+    ezGlobalLog::DisableAsyncMode();
+    ezGlobalLog::RemoveLogWriter(ezMakeDelegate(&ezLogWriter::Binary::LogMessageHandler, &binaryWriter));
+    binaryWriter.EndLog();
+
+    EZ_TEST_BOOL(thread.m_uiThreadIndex != ezLog::GetCurrentThreadIndex());
+
+    ezMemoryStreamReader stream(&storage);
+    ezBinaryLogReader reader;
+    EZ_TEST_BOOL(reader.Open(stream).Succeeded());
+
+    ezBinaryLogEntry entry;
+    ezUInt32 uiNumEntries = 0;
+    while (reader.ReadNextEntry(entry).Succeeded())
+    {
+      if (!entry.m_sText.StartsWith("Async Binary "))
+        continue;
+
+      ++uiNumEntries;
+      EZ_TEST_INT(entry.m_uiThreadIndex, thread.m_uiThreadIndex);
+      EZ_TEST_BOOL(entry.m_iTimestamp <= iLoggedBefore);
+    }
+
+    EZ_TEST_INT(uiNumEntries, 10);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Invalid Stream")
+  {
+    ezMemoryStreamStorage storage;
+    ezMemoryStreamWriter writer(&storage);
+    writer << "Not a log";
+
+    ezTestLogInterface log;
+    ezTestLogSystemScope logSystemScope(&log);
+    log.ExpectMessage("does not contain a binary log", ezLogMsgType::ErrorMsg);
+
+    ezMemoryStreamReader stream(&storage);
+    ezBinaryLogReader reader;
+    EZ_TEST_BOOL(reader.Open(stream).Failed());
+  }
+}
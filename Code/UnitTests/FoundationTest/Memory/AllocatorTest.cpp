@@ -1,8 +1,13 @@
 #include <FoundationTestPCH.h>
 
+#include <Foundation/IO/MemoryStream.h>
 #include <Foundation/Memory/CommonAllocators.h>
 #include <Foundation/Memory/LargeBlockAllocator.h>
+#include <Foundation/Memory/SampledHeapProfile.h>
 #include <Foundation/Memory/StackAllocator.h>
+#include <Foundation/Memory/ThreadArenaAllocator.h>
+#include <Foundation/Memory/ThreadCachingAllocator.h>
+#include <Foundation/Threading/Thread.h>
 
 struct EZ_ALIGN(NonAlignedVector, EZ_ALIGNMENT_MINIMUM)
 {
@@ -75,6 +80,44 @@ void TestAlignmentHelper(size_t uiExpectedAlignment)
   EZ_TEST_BOOL(stats.m_uiNumAllocations - stats.m_uiNumDeallocations == 0);
 }
 
+namespace
+{
+  class ThreadCachingTestThread : public ezThread
+  {
+  public:
+    ThreadCachingTestThread(ezAllocatorBase* pAllocator, ezDynamicArray<void*>& blocks, bool bAllocate)
+      : ezThread("Allocator Test Thread")
+      , m_pAllocator(pAllocator)
+      , m_Blocks(blocks)
+      , m_bAllocate(bAllocate)
+    {
+    }
+
+    virtual ezUInt32 Run() override
+    {
+      for (ezUInt32 i = 0; i < m_Blocks.GetCount(); ++i)
+      {
+        if (m_bAllocate)
+        {
+          m_Blocks[i] = m_pAllocator->Allocate(i % 200 + 1, 8);
+        }
+        else
+        {
+          m_pAllocator->Deallocate(m_Blocks[i]);
+          m_Blocks[i] = nullptr;
+        }
+      }
+
+      return 0;
+    }
+
+  private:
+    ezAllocatorBase* m_pAllocator;
+    ezDynamicArray<void*>& m_Blocks;
+    bool m_bAllocate;
+  };
+} // namespace
+
 EZ_CREATE_SIMPLE_TEST_GROUP(Memory);
 
 EZ_CREATE_SIMPLE_TEST(Memory, Allocator)
@@ -235,4 +278,309 @@ EZ_CREATE_SIMPLE_TEST(Memory, Allocator)
 
     EZ_TEST_BOOL(ezConstructionCounter::HasDestructed(50));
   }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "ThreadCachingAllocator")
+  {
+    using Policy = ezMemoryPolicies::ezThreadCachingAllocation;
+
+    for (ezUInt32 uiSize = 1; uiSize <= Policy::MaxMediumSize; ++uiSize)
+    {
+      const ezUInt32 uiSizeClass = Policy::GetSizeClass(uiSize);
+      EZ_TEST_BOOL(uiSizeClass < Policy::NumSizeClasses);
+      EZ_TEST_BOOL(Policy::GetSizeClassBlockSize(uiSizeClass) >= uiSize);
+      EZ_TEST_BOOL(uiSizeClass == 0 || Policy::GetSizeClassBlockSize(uiSizeClass - 1) < uiSize);
+    }
+
+    EZ_TEST_INT(Policy::GetSizeClass(Policy::MaxMediumSize), Policy::NumSizeClasses - 1);
+
+    ezThreadCachingAllocator<> allocator("TestThreadCachingAllocator");
+
+    // small, medium and large allocations
+    {
+      ezDynamicArray<void*> blocks;
+      size_t uiTotalSize = 0;
+
+      for (ezUInt32 i = 0; i < 2000; ++i)
+      {
+        const size_t uiSize = (i < 1000) ? (i * 37) % (Policy::MaxSmallSize + 4096) + 1 : (i * 4099) % (Policy::MaxMediumSize + 65536) + 1;
+        void* ptr = allocator.Allocate(uiSize, 8);
+
+        EZ_TEST_BOOL(ezMemoryUtils::IsAligned(ptr, 16));
+        EZ_TEST_BOOL(allocator.AllocatedSize(ptr) >= uiSize);
+        ezMemoryUtils::PatternFill(static_cast<ezUInt8*>(ptr), static_cast<ezUInt8>(i), uiSize);
+
+        uiTotalSize += allocator.AllocatedSize(ptr);
+        blocks.PushBack(ptr);
+      }
+
+      ezAllocatorBase::Stats stats = allocator.GetStats();
+      EZ_TEST_INT(stats.m_uiNumAllocations - stats.m_uiNumDeallocations, 2000);
+      EZ_TEST_INT(stats.m_uiAllocationSize, uiTotalSize);
+
+      for (ezUInt32 i = 0; i < blocks.GetCount(); ++i)
+      {
+        EZ_TEST_INT(*static_cast<ezUInt8*>(blocks[i]), static_cast<ezUInt8>(i));
+        allocator.Deallocate(blocks[i]);
+      }
+
+      stats = allocator.GetStats();
+      EZ_TEST_INT(stats.m_uiNumAllocations, stats.m_uiNumDeallocations);
+      EZ_TEST_INT(stats.m_uiAllocationSize, 0);
+    }
+
+    // large allocations only carry a small header
+    {
+      const ezUInt64 uiReservedMemory = allocator.GetReservedMemory();
+
+      void* pLarge = allocator.Allocate(Policy::MaxMediumSize + 1, 8);
+      EZ_TEST_BOOL(allocator.GetReservedMemory() - uiReservedMemory < Policy::MaxMediumSize + 1 + Policy::MaxSmallAlignment * 2);
+      EZ_TEST_INT(allocator.AllocatedSize(pLarge), Policy::MaxMediumSize + 1);
+
+      allocator.Deallocate(pLarge);
+      EZ_TEST_INT(allocator.GetReservedMemory(), uiReservedMemory);
+    }
+
+    // alignment and reallocation
+    {
+      void* pAligned = allocator.Allocate(100, 64);
+      EZ_TEST_BOOL(ezMemoryUtils::IsAligned(pAligned, 64));
+      allocator.Deallocate(pAligned);
+
+      ezUInt8* pData = static_cast<ezUInt8*>(allocator.Allocate(20, 8));
+      for (ezUInt8 i = 0; i < 20; ++i)
+        pData[i] = i;
+
+      EZ_TEST_BOOL(allocator.Reallocate(pData, 20, 30, 8) == pData);
+
+      pData = static_cast<ezUInt8*>(allocator.Reallocate(pData, 30, 20000, 8));
+      for (ezUInt8 i = 0; i < 20; ++i)
+        EZ_TEST_INT(pData[i], i);
+
+      allocator.Deallocate(pData);
+    }
+
+    // blocks that are freed on another thread
+    {
+      ezDynamicArray<void*> blocks;
+      blocks.SetCount(5000);
+
+      for (ezUInt32 i = 0; i < blocks.GetCount(); ++i)
+        blocks[i] = allocator.Allocate(i % 200 + 1, 8);
+
+      ThreadCachingTestThread freeThread(&allocator, blocks, false);
+      freeThread.Start();
+      freeThread.Join();
+
+      ezAllocatorBase::Stats stats = allocator.GetStats();
+      EZ_TEST_INT(stats.m_uiNumAllocations, stats.m_uiNumDeallocations);
+      EZ_TEST_INT(stats.m_uiAllocationSize, 0);
+
+      // the remotely freed blocks are reused
+      for (ezUInt32 i = 0; i < blocks.GetCount(); ++i)
+        blocks[i] = allocator.Allocate(i % 200 + 1, 8);
+
+      for (ezUInt32 i = 0; i < blocks.GetCount(); ++i)
+        allocator.Deallocate(blocks[i]);
+    }
+
+    // blocks that are allocated on a thread that exits before they are freed
+    {
+      ezDynamicArray<void*> blocks;
+      blocks.SetCount(5000);
+
+      ThreadCachingTestThread allocThread(&allocator, blocks, true);
+      allocThread.Start();
+      allocThread.Join();
+
+      for (ezUInt32 i = 0; i < blocks.GetCount(); ++i)
+        allocator.Deallocate(blocks[i]);
+
+      // a new thread takes over the cache of the exited thread and processes the frees
+      ThreadCachingTestThread allocThread2(&allocator, blocks, true);
+      allocThread2.Start();
+      allocThread2.Join();
+
+      ThreadCachingTestThread freeThread(&allocator, blocks, false);
+      freeThread.Start();
+      freeThread.Join();
+
+      ezAllocatorBase::Stats stats = allocator.GetStats();
+      EZ_TEST_INT(stats.m_uiNumAllocations, stats.m_uiNumDeallocations);
+      EZ_TEST_INT(stats.m_uiAllocationSize, 0);
+    }
+
+    EZ_TEST_BOOL(allocator.GetReservedMemory() > 0);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "ThreadArenaAllocator")
+  {
+    using Policy = ezMemoryPolicies::ezThreadArenaAllocation;
+
+    ezThreadArenaAllocator<> allocator("TestThreadArenaAllocator");
+
+    // linear allocations
+    {
+      ezUInt8* pPrev = nullptr;
+      for (ezUInt32 i = 0; i < 64; ++i)
+      {
+        ezUInt8* ptr = static_cast<ezUInt8*>(allocator.Allocate(24, 8, nullptr));
+        EZ_TEST_BOOL(ezMemoryUtils::IsAligned(ptr, 8));
+
+        if (pPrev != nullptr)
+        {
+          EZ_TEST_BOOL(ptr == pPrev + 24);
+        }
+
+        pPrev = ptr;
+      }
+
+      EZ_TEST_INT(allocator.GetUsedMemory(), 64 * 24);
+      EZ_TEST_INT(allocator.GetUsedMemoryOfCurrentThread(), 64 * 24);
+      EZ_TEST_INT(allocator.GetStats().m_uiNumAllocations, 64);
+
+      void* pAligned = allocator.Allocate(100, 64, nullptr);
+      EZ_TEST_BOOL(ezMemoryUtils::IsAligned(pAligned, 64));
+
+      // larger than a chunk allows
+      void* pLarge = allocator.Allocate(Policy::ChunkSize * 2, 16, nullptr);
+      ezMemoryUtils::PatternFill(static_cast<ezUInt8*>(pLarge), 0xAB, Policy::ChunkSize * 2);
+      EZ_TEST_INT(allocator.GetReservedMemory(), Policy::ChunkSize * 3);
+
+      // chunks are kept on reset, the dedicated block is freed
+      const ezUInt64 uiUsedMemory = allocator.GetUsedMemory();
+      allocator.Reset();
+
+      EZ_TEST_INT(allocator.GetUsedMemory(), 0);
+      EZ_TEST_INT(allocator.GetPeakUsedMemory(), uiUsedMemory);
+      EZ_TEST_INT(allocator.GetReservedMemory(), Policy::ChunkSize);
+
+      // the same memory is handed out again
+      EZ_TEST_BOOL(allocator.Allocate(24, 8, nullptr) == pPrev - 63 * 24);
+      allocator.Reset();
+    }
+
+    // destructors are called on reset, unless the object was deleted already
+    {
+      static ezInt32 s_iDestructed = 0;
+
+      struct Destructible
+      {
+        ~Destructible() { ++s_iDestructed; }
+        ezUInt32 m_uiValue = 42;
+      };
+
+      Destructible* pObjects[8];
+      for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(pObjects); ++i)
+      {
+        pObjects[i] = EZ_NEW(&allocator, Destructible);
+        EZ_TEST_INT(pObjects[i]->m_uiValue, 42);
+      }
+
+      EZ_DELETE(&allocator, pObjects[3]);
+      EZ_TEST_INT(s_iDestructed, 1);
+
+      allocator.Reset();
+      EZ_TEST_INT(s_iDestructed, 8);
+    }
+
+    // every thread allocates from its own arena
+    {
+      ezDynamicArray<void*> blocks;
+      blocks.SetCount(5000);
+
+      ThreadCachingTestThread allocThread(&allocator, blocks, true);
+      allocThread.Start();
+      allocThread.Join();
+
+      EZ_TEST_INT(allocator.GetUsedMemoryOfCurrentThread(), 0);
+      EZ_TEST_BOOL(allocator.GetUsedMemory() >= 5000);
+      EZ_TEST_INT(allocator.GetStats().m_uiNumAllocations, 5000);
+
+      // a new thread takes over the arena of the exited thread
+      const ezUInt64 uiReservedMemory = allocator.GetReservedMemory();
+      allocator.Reset();
+
+      ThreadCachingTestThread allocThread2(&allocator, blocks, true);
+      allocThread2.Start();
+      allocThread2.Join();
+
+      EZ_TEST_INT(allocator.GetReservedMemory(), uiReservedMemory);
+      allocator.Reset();
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "AllocationSampling")
+  {
+    typedef ezAllocator<ezMemoryPolicies::ezHeapAllocation,
+      ezMemoryTrackingFlags::RegisterAllocator | ezMemoryTrackingFlags::EnableAllocationSampling>
+      SamplingAllocator;
+
+    const ezUInt32 uiOldInterval = ezMemoryTracker::GetAllocationSamplingInterval();
+    ezMemoryTracker::SetAllocationSamplingInterval(4096);
+
+    {
+      SamplingAllocator allocator("SamplingTestAllocator");
+
+      ezSampledHeapProfile before;
+      before.Capture();
+      EZ_TEST_DOUBLE(before.GetEstimatedBytes("SamplingTestAllocator"), 0.0, 0.0);
+
+      const ezUInt32 uiNumBlocks = 20000;
+      const ezUInt32 uiBlockSize = 128;
+
+      ezDynamicArray<void*> blocks;
+      for (ezUInt32 i = 0; i < uiNumBlocks; ++i)
+      {
+        blocks.PushBack(allocator.Allocate(uiBlockSize, 8));
+      }
+
+      // roughly 600 samples, the estimate should be well within 20%
+      const double fExpectedBytes = uiNumBlocks * uiBlockSize;
+
+      ezSampledHeapProfile after;
+      after.Capture();
+      EZ_TEST_DOUBLE(after.GetEstimatedBytes("SamplingTestAllocator"), fExpectedBytes, fExpectedBytes * 0.2);
+      EZ_TEST_BOOL(!after.GetEntries().IsEmpty());
+      EZ_TEST_BOOL(after.GetCaptureTime().IsValid());
+
+      ezSampledHeapProfile diff;
+      diff.ComputeDifference(before, after);
+      EZ_TEST_DOUBLE(diff.GetEstimatedBytes("SamplingTestAllocator"), after.GetEstimatedBytes("SamplingTestAllocator"), 0.001);
+
+      ezMemoryStreamStorage storage;
+      {
+        ezMemoryStreamWriter writer(&storage);
+        after.Save(writer);
+      }
+
+      ezSampledHeapProfile loaded;
+      {
+        ezMemoryStreamReader reader(&storage);
+        EZ_TEST_BOOL(loaded.Load(reader).Succeeded());
+      }
+
+      EZ_TEST_INT(loaded.GetEntries().GetCount(), after.GetEntries().GetCount());
+      EZ_TEST_DOUBLE(loaded.GetEstimatedBytes(), after.GetEstimatedBytes(), 0.001);
+      EZ_TEST_BOOL(loaded.GetCaptureTime().Compare(after.GetCaptureTime(), ezTimestamp::CompareMode::Identical));
+
+      ezStringBuilder sReport;
+      loaded.WriteReport(sReport, 4, false);
+      EZ_TEST_BOOL(sReport.StartsWith("Sampled heap profile"));
+      EZ_TEST_BOOL(sReport.FindSubString("SamplingTestAllocator") != nullptr);
+
+      for (void* ptr : blocks)
+      {
+        allocator.Deallocate(ptr);
+      }
+
+      ezSampledHeapProfile freed;
+      freed.Capture();
+      EZ_TEST_DOUBLE(freed.GetEstimatedBytes("SamplingTestAllocator"), 0.0, 0.0);
+
+      diff.ComputeDifference(after, freed);
+      EZ_TEST_DOUBLE(diff.GetEstimatedBytes("SamplingTestAllocator"), -after.GetEstimatedBytes("SamplingTestAllocator"), 0.001);
+    }
+
+    ezMemoryTracker::SetAllocationSamplingInterval(uiOldInterval);
+  }
 }
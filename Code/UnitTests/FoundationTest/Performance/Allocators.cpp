@@ -0,0 +1,102 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Memory/CommonAllocators.h>
+#include <Foundation/Memory/ThreadCachingAllocator.h>
+#include <Foundation/Threading/TaskSystem.h>
+#include <Foundation/Time/Time.h>
+
+namespace
+{
+  enum AllocatorChurnConstants
+  {
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
+    CHURN_NUM_ROUNDS = 4,
+    CHURN_NUM_BLOCKS = 1024 * 16,
+    CHURN_NUM_BATCHES = 16,
+#else
+    CHURN_NUM_ROUNDS = 32,
+    CHURN_NUM_BLOCKS = 1024 * 64,
+    CHURN_NUM_BATCHES = 64,
+#endif
+  };
+
+  /// Allocates and frees blocks of typical small object sizes, interleaved so that the allocator cannot just hand out the same block again.
+  void AllocatorChurn(ezAllocatorBase* pAllocator, ezUInt32 uiSeed)
+  {
+    ezDynamicArray<void*> blocks;
+    blocks.SetCount(CHURN_NUM_BLOCKS / CHURN_NUM_BATCHES);
+
+    for (ezUInt32 uiRound = 0; uiRound < CHURN_NUM_ROUNDS; ++uiRound)
+    {
+      for (ezUInt32 i = 0; i < blocks.GetCount(); ++i)
+      {
+        blocks[i] = pAllocator->Allocate(((i + uiSeed) * 13) % 256 + 8, 8);
+      }
+
+      for (ezUInt32 i = 0; i < blocks.GetCount(); i += 2)
+      {
+        pAllocator->Deallocate(blocks[i]);
+      }
+
+      for (ezUInt32 i = 1; i < blocks.GetCount(); i += 2)
+      {
+        pAllocator->Deallocate(blocks[i]);
+      }
+    }
+  }
+
+  ezTime MeasureChurn(ezAllocatorBase* pAllocator, bool bParallel)
+  {
+    const ezTime t0 = ezTime::Now();
+
+    if (bParallel)
+    {
+      ezTaskSystem::ParallelForIndexed(0, CHURN_NUM_BATCHES, [pAllocator](ezUInt32 uiStart, ezUInt32 uiEnd) {
+        for (ezUInt32 i = uiStart; i < uiEnd; ++i)
+        {
+          AllocatorChurn(pAllocator, i);
+        }
+      });
+    }
+    else
+    {
+      for (ezUInt32 i = 0; i < CHURN_NUM_BATCHES; ++i)
+      {
+        AllocatorChurn(pAllocator, i);
+      }
+    }
+
+    return ezTime::Now() - t0;
+  }
+} // namespace
+
+// Enable when needed
+#ifndef EZ_PERFORMANCE_TESTS_STATE
+#  define EZ_PERFORMANCE_TESTS_STATE ezTestBlock::DisabledNoWarning
+#endif
+
+EZ_CREATE_SIMPLE_TEST(Performance, Allocators)
+{
+  ezHeapAllocator heapAllocator("PerfHeapAllocator");
+  ezThreadCachingAllocator<> threadCachingAllocator("PerfThreadCachingAllocator");
+
+  EZ_TEST_BLOCK(EZ_PERFORMANCE_TESTS_STATE, "Small Object Churn")
+  {
+    const ezTime tHeap = MeasureChurn(&heapAllocator, false);
+    const ezTime tThreadCaching = MeasureChurn(&threadCachingAllocator, false);
+
+    ezLog::Info("[test]Small Object Churn ezHeapAllocator: {0}ms", ezArgF(tHeap.GetMilliseconds(), 4));
+    ezLog::Info("[test]Small Object Churn ezThreadCachingAllocator: {0}ms", ezArgF(tThreadCaching.GetMilliseconds(), 4));
+  }
+
+  EZ_TEST_BLOCK(EZ_PERFORMANCE_TESTS_STATE, "Small Object Churn Parallel")
+  {
+    const ezTime tHeap = MeasureChurn(&heapAllocator, true);
+    const ezTime tThreadCaching = MeasureChurn(&threadCachingAllocator, true);
+
+    ezLog::Info("[test]Small Object Churn Parallel ezHeapAllocator: {0}ms", ezArgF(tHeap.GetMilliseconds(), 4));
+    ezLog::Info("[test]Small Object Churn Parallel ezThreadCachingAllocator: {0}ms", ezArgF(tThreadCaching.GetMilliseconds(), 4));
+  }
+}
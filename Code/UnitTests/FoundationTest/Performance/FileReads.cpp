@@ -0,0 +1,117 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/IO/FileSystem/AsyncFileReader.h>
+#include <Foundation/IO/FileSystem/FileReader.h>
+#include <Foundation/IO/FileSystem/FileSystem.h>
+#include <Foundation/IO/FileSystem/FileWriter.h>
+#include <Foundation/IO/OSFile.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Time/Time.h>
+
+namespace
+{
+  enum FileReadsPerfConstants
+  {
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
+    FILEREADSPERF_NUM_SMALL_FILES = 200,
+    FILEREADSPERF_NUM_LARGE_FILES = 2,
+#else
+    FILEREADSPERF_NUM_SMALL_FILES = 2000,
+    FILEREADSPERF_NUM_LARGE_FILES = 8,
+#endif
+    FILEREADSPERF_SMALL_FILE_SIZE = 4 * 1024,
+    FILEREADSPERF_LARGE_FILE_SIZE = 16 * 1024 * 1024,
+  };
+
+  void FileReadsPerfWriteFiles(const char* szName, ezUInt32 uiNumFiles, ezUInt32 uiFileSize)
+  {
+    ezDynamicArray<ezUInt8> content;
+    content.SetCount(uiFileSize, 0xAB);
+
+    ezStringBuilder sFile;
+    for (ezUInt32 i = 0; i < uiNumFiles; ++i)
+    {
+      sFile.Format(":perf/{}{}.bin", szName, i);
+
+      ezFileWriter file;
+      if (file.Open(sFile).Succeeded())
+      {
+        file.WriteBytes(content.GetData(), content.GetCount()).IgnoreResult();
+      }
+    }
+  }
+
+  /// Reads all files completely, once one after the other with ezFileReader and once all at the same time with ezAsyncFileReader.
+  /// The files were just written, so this mostly measures the overhead of the reads on files in the OS cache.
+  void MeasureFileReads(const char* szName, ezUInt32 uiNumFiles, ezUInt32 uiFileSize)
+  {
+    ezStringBuilder sFile;
+    ezDynamicArray<ezUInt8> data;
+
+    ezTime t0 = ezTime::Now();
+    ezUInt64 uiBytesBlocking = 0;
+    for (ezUInt32 i = 0; i < uiNumFiles; ++i)
+    {
+      sFile.Format(":perf/{}{}.bin", szName, i);
+
+      ezFileReader file;
+      if (EZ_TEST_BOOL(file.Open(sFile).Succeeded()).Failed())
+        return;
+
+      data.SetCountUninitialized(static_cast<ezUInt32>(file.GetFileSize()));
+      uiBytesBlocking += file.ReadBytes(data.GetData(), data.GetCount());
+    }
+    ezTime t1 = ezTime::Now();
+    const ezTime tBlocking = t1 - t0;
+
+    ezAsyncFileReader reader;
+    ezUInt64 uiBytesAsync = 0;
+    for (ezUInt32 i = 0; i < uiNumFiles; ++i)
+    {
+      sFile.Format(":perf/{}{}.bin", szName, i);
+      reader.ReadFile(sFile, [&uiBytesAsync](ezAsyncFileReadResult& result) { uiBytesAsync += result.m_Data.GetCount(); });
+    }
+    reader.WaitForAll();
+    t0 = ezTime::Now();
+    const ezTime tAsync = t0 - t1;
+
+    EZ_TEST_INT(uiBytesBlocking, static_cast<ezUInt64>(uiNumFiles) * uiFileSize);
+    EZ_TEST_INT(uiBytesAsync, uiBytesBlocking);
+
+    const double fMegaBytes = uiBytesBlocking / (1024.0 * 1024.0);
+    ezLog::Info("[test]{0} x {1}: ezFileReader {2}ms ({3} MB/s), ezAsyncFileReader {4}ms ({5} MB/s, {6})", uiNumFiles,
+      ezArgFileSize(uiFileSize), ezArgF(tBlocking.GetMilliseconds(), 2), ezArgF(fMegaBytes / tBlocking.GetSeconds(), 0),
+      ezArgF(tAsync.GetMilliseconds(), 2), ezArgF(fMegaBytes / tAsync.GetSeconds(), 0),
+      reader.UsesOSAsyncIO() ? "OS async I/O" : "worker tasks");
+  }
+} // namespace
+
+// Enable when needed
+#ifndef EZ_PERFORMANCE_TESTS_STATE
+#  define EZ_PERFORMANCE_TESTS_STATE ezTestBlock::DisabledNoWarning
+#endif
+
+EZ_CREATE_SIMPLE_TEST(Performance, FileReads)
+{
+  ezStringBuilder sOutputFolder = ezTestFramework::GetInstance()->GetAbsOutputPath();
+  sOutputFolder.AppendPath("FileReadsPerf");
+  sOutputFolder.MakeCleanPath();
+
+  if (ezOSFile::CreateDirectoryStructure(sOutputFolder).Failed() ||
+      ezFileSystem::AddDataDirectory(sOutputFolder, "FileReadsPerf", "perf", ezFileSystem::AllowWrites).Failed())
+    return;
+
+  EZ_TEST_BLOCK(EZ_PERFORMANCE_TESTS_STATE, "Small Files")
+  {
+    FileReadsPerfWriteFiles("Small", FILEREADSPERF_NUM_SMALL_FILES, FILEREADSPERF_SMALL_FILE_SIZE);
+    MeasureFileReads("Small", FILEREADSPERF_NUM_SMALL_FILES, FILEREADSPERF_SMALL_FILE_SIZE);
+  }
+
+  EZ_TEST_BLOCK(EZ_PERFORMANCE_TESTS_STATE, "Large Files")
+  {
+    FileReadsPerfWriteFiles("Large", FILEREADSPERF_NUM_LARGE_FILES, FILEREADSPERF_LARGE_FILE_SIZE);
+    MeasureFileReads("Large", FILEREADSPERF_NUM_LARGE_FILES, FILEREADSPERF_LARGE_FILE_SIZE);
+  }
+
+  ezFileSystem::RemoveDataDirectoryGroup("FileReadsPerf");
+}
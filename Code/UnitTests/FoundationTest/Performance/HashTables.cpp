@@ -0,0 +1,131 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Containers/FlatHashTable.h>
+#include <Foundation/Containers/HashTable.h>
+#include <Foundation/Containers/Map.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Time/Time.h>
+
+namespace
+{
+  enum HashTablePerfConstants
+  {
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
+    HASHPERF_NUM_KEYS = 1024 * 16,
+    HASHPERF_NUM_ROUNDS = 4,
+#else
+    HASHPERF_NUM_KEYS = 1024 * 256,
+    HASHPERF_NUM_ROUNDS = 16,
+#endif
+  };
+
+  struct HashTablePerfResult
+  {
+    ezTime m_Insert;
+    ezTime m_FindHit;
+    ezTime m_FindMiss;
+    ezTime m_Iterate;
+    ezTime m_Erase;
+    ezUInt64 m_uiChecksum = 0;
+  };
+
+  template <typename MapType>
+  HashTablePerfResult MeasureHashTable(const ezDynamicArray<ezUInt64>& keys)
+  {
+    HashTablePerfResult res;
+
+    for (ezUInt32 uiRound = 0; uiRound < HASHPERF_NUM_ROUNDS; ++uiRound)
+    {
+      MapType map;
+
+      ezTime t0 = ezTime::Now();
+      for (ezUInt32 i = 0; i < keys.GetCount(); ++i)
+      {
+        map.Insert(keys[i], i);
+      }
+      ezTime t1 = ezTime::Now();
+      res.m_Insert += t1 - t0;
+
+      for (ezUInt32 i = 0; i < keys.GetCount(); ++i)
+      {
+        res.m_uiChecksum += map.Contains(keys[i]) ? 1 : 0;
+      }
+      t0 = ezTime::Now();
+      res.m_FindHit += t0 - t1;
+
+      // the keys are odd, so even keys are never contained
+      for (ezUInt32 i = 0; i < keys.GetCount(); ++i)
+      {
+        res.m_uiChecksum += map.Contains(keys[i] + 1) ? 1 : 0;
+      }
+      t1 = ezTime::Now();
+      res.m_FindMiss += t1 - t0;
+
+      for (auto it = map.GetIterator(); it.IsValid(); it.Next())
+      {
+        res.m_uiChecksum += it.Value();
+      }
+      t0 = ezTime::Now();
+      res.m_Iterate += t0 - t1;
+
+      for (ezUInt32 i = 0; i < keys.GetCount(); ++i)
+      {
+        map.Remove(keys[i]);
+      }
+      t1 = ezTime::Now();
+      res.m_Erase += t1 - t0;
+    }
+
+    return res;
+  }
+
+  void LogHashTablePerf(const char* szName, const HashTablePerfResult& res)
+  {
+    const double fDivider = static_cast<double>(HASHPERF_NUM_ROUNDS);
+
+    ezLog::Info("[test]{0}: insert {1}ms, find hit {2}ms, find miss {3}ms, iterate {4}ms, erase {5}ms ({6})", szName,
+      ezArgF(res.m_Insert.GetMilliseconds() / fDivider, 4), ezArgF(res.m_FindHit.GetMilliseconds() / fDivider, 4),
+      ezArgF(res.m_FindMiss.GetMilliseconds() / fDivider, 4), ezArgF(res.m_Iterate.GetMilliseconds() / fDivider, 4),
+      ezArgF(res.m_Erase.GetMilliseconds() / fDivider, 4), res.m_uiChecksum);
+  }
+} // namespace
+
+// Enable when needed
+#ifndef EZ_PERFORMANCE_TESTS_STATE
+#  define EZ_PERFORMANCE_TESTS_STATE ezTestBlock::DisabledNoWarning
+#endif
+
+EZ_CREATE_SIMPLE_TEST(Performance, HashTables)
+{
+  ezDynamicArray<ezUInt64> keys;
+  keys.SetCountUninitialized(HASHPERF_NUM_KEYS);
+
+  ezUInt64 uiState = 0x9E3779B97F4A7C15ull;
+  for (ezUInt32 i = 0; i < keys.GetCount(); ++i)
+  {
+    uiState ^= uiState << 13;
+    uiState ^= uiState >> 7;
+    uiState ^= uiState << 17;
+    keys[i] = uiState | 1;
+  }
+
+  EZ_TEST_BLOCK(EZ_PERFORMANCE_TESTS_STATE, "ezUInt64 keys")
+  {
+    LogHashTablePerf("ezMap", MeasureHashTable<ezMap<ezUInt64, ezUInt32>>(keys));
+    LogHashTablePerf("ezHashTable", MeasureHashTable<ezHashTable<ezUInt64, ezUInt32>>(keys));
+    LogHashTablePerf("ezFlatHashTable", MeasureHashTable<ezFlatHashTable<ezUInt64, ezUInt32>>(keys));
+  }
+
+  EZ_TEST_BLOCK(EZ_PERFORMANCE_TESTS_STATE, "Sequential ezUInt64 keys")
+  {
+    for (ezUInt32 i = 0; i < keys.GetCount(); ++i)
+    {
+      keys[i] = i * 2 + 1;
+    }
+
+    LogHashTablePerf("ezMap", MeasureHashTable<ezMap<ezUInt64, ezUInt32>>(keys));
+    LogHashTablePerf("ezHashTable", MeasureHashTable<ezHashTable<ezUInt64, ezUInt32>>(keys));
+    LogHashTablePerf("ezFlatHashTable", MeasureHashTable<ezFlatHashTable<ezUInt64, ezUInt32>>(keys));
+  }
+}
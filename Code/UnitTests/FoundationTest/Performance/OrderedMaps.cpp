@@ -0,0 +1,240 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/Containers/ArrayMap.h>
+#include <Foundation/Containers/BTreeMap.h>
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Containers/Map.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Time/Time.h>
+
+namespace
+{
+  enum OrderedMapPerfConstants
+  {
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
+    ORDEREDPERF_NUM_KEYS = 1024 * 16,
+    ORDEREDPERF_NUM_ROUNDS = 4,
+#else
+    ORDEREDPERF_NUM_KEYS = 1024 * 256,
+    ORDEREDPERF_NUM_ROUNDS = 16,
+#endif
+    ORDEREDPERF_RANGE_LENGTH = 16,
+  };
+
+  struct OrderedMapPerfResult
+  {
+    ezTime m_Insert;
+    ezTime m_Find;
+    ezTime m_Iterate;
+    ezTime m_Range;
+    ezTime m_Erase;
+    ezUInt64 m_uiChecksum = 0;
+  };
+
+  template <typename MapType>
+  void OrderedMapPerfInsertAll(MapType& map, const ezDynamicArray<ezUInt64>& keys)
+  {
+    for (ezUInt32 i = 0; i < keys.GetCount(); ++i)
+    {
+      map.Insert(keys[i], i);
+    }
+  }
+
+  void OrderedMapPerfInsertAll(ezArrayMap<ezUInt64, ezUInt32>& map, const ezDynamicArray<ezUInt64>& keys)
+  {
+    // the intended usage of ezArrayMap: insert unsorted, sort once
+    for (ezUInt32 i = 0; i < keys.GetCount(); ++i)
+    {
+      map.Insert(keys[i], i);
+    }
+    map.Sort();
+  }
+
+  template <typename MapType>
+  ezUInt64 OrderedMapPerfIterate(const MapType& map)
+  {
+    ezUInt64 uiSum = 0;
+    for (auto it = map.GetIterator(); it.IsValid(); ++it)
+    {
+      uiSum += it.Value();
+    }
+    return uiSum;
+  }
+
+  ezUInt64 OrderedMapPerfIterate(const ezArrayMap<ezUInt64, ezUInt32>& map)
+  {
+    ezUInt64 uiSum = 0;
+    for (ezUInt32 i = 0; i < map.GetCount(); ++i)
+    {
+      uiSum += map.GetValue(i);
+    }
+    return uiSum;
+  }
+
+  template <typename MapType>
+  ezUInt64 OrderedMapPerfRange(const MapType& map, ezUInt64 uiStart)
+  {
+    ezUInt64 uiSum = 0;
+    auto it = map.LowerBound(uiStart);
+    for (ezUInt32 j = 0; j < ORDEREDPERF_RANGE_LENGTH && it.IsValid(); ++j, ++it)
+    {
+      uiSum += it.Value();
+    }
+    return uiSum;
+  }
+
+  ezUInt64 OrderedMapPerfRange(const ezArrayMap<ezUInt64, ezUInt32>& map, ezUInt64 uiStart)
+  {
+    ezUInt64 uiSum = 0;
+    const ezUInt32 uiFirst = map.LowerBound(uiStart);
+    for (ezUInt32 j = uiFirst; j < uiFirst + ORDEREDPERF_RANGE_LENGTH && j < map.GetCount(); ++j)
+    {
+      uiSum += map.GetValue(j);
+    }
+    return uiSum;
+  }
+
+  template <typename MapType>
+  void OrderedMapPerfRemoveAll(MapType& map, const ezDynamicArray<ezUInt64>& keys)
+  {
+    for (ezUInt32 i = 0; i < keys.GetCount(); ++i)
+    {
+      map.Remove(keys[i]);
+    }
+  }
+
+  void OrderedMapPerfRemoveAll(ezArrayMap<ezUInt64, ezUInt32>& map, const ezDynamicArray<ezUInt64>& keys)
+  {
+    // removing individual keys while staying sorted is O(n) per key, so only the sorted removal from the back is measured
+    while (!map.IsEmpty())
+    {
+      map.RemoveAtAndCopy(map.GetCount() - 1, true);
+    }
+  }
+
+  template <typename MapType>
+  OrderedMapPerfResult MeasureOrderedMap(const ezDynamicArray<ezUInt64>& keys)
+  {
+    OrderedMapPerfResult res;
+
+    for (ezUInt32 uiRound = 0; uiRound < ORDEREDPERF_NUM_ROUNDS; ++uiRound)
+    {
+      MapType map;
+
+      ezTime t0 = ezTime::Now();
+      OrderedMapPerfInsertAll(map, keys);
+      ezTime t1 = ezTime::Now();
+      res.m_Insert += t1 - t0;
+
+      for (ezUInt32 i = 0; i < keys.GetCount(); ++i)
+      {
+        res.m_uiChecksum += map.Contains(keys[i]) ? 1 : 0;
+      }
+      t0 = ezTime::Now();
+      res.m_Find += t0 - t1;
+
+      res.m_uiChecksum += OrderedMapPerfIterate(map);
+      t1 = ezTime::Now();
+      res.m_Iterate += t1 - t0;
+
+      // the keys are odd, so the search always starts between two elements
+      for (ezUInt32 i = 0; i < keys.GetCount(); i += ORDEREDPERF_RANGE_LENGTH)
+      {
+        res.m_uiChecksum += OrderedMapPerfRange(map, keys[i] + 1);
+      }
+      t0 = ezTime::Now();
+      res.m_Range += t0 - t1;
+
+      OrderedMapPerfRemoveAll(map, keys);
+      t1 = ezTime::Now();
+      res.m_Erase += t1 - t0;
+    }
+
+    return res;
+  }
+
+  void LogOrderedMapPerf(const char* szName, const OrderedMapPerfResult& res)
+  {
+    const double fDivider = static_cast<double>(ORDEREDPERF_NUM_ROUNDS);
+
+    ezLog::Info("[test]{0}: insert {1}ms, find {2}ms, iterate {3}ms, range {4}ms, erase {5}ms ({6})", szName,
+      ezArgF(res.m_Insert.GetMilliseconds() / fDivider, 4), ezArgF(res.m_Find.GetMilliseconds() / fDivider, 4),
+      ezArgF(res.m_Iterate.GetMilliseconds() / fDivider, 4), ezArgF(res.m_Range.GetMilliseconds() / fDivider, 4),
+      ezArgF(res.m_Erase.GetMilliseconds() / fDivider, 4), res.m_uiChecksum);
+  }
+} // namespace
+
+// Enable when needed
+#ifndef EZ_PERFORMANCE_TESTS_STATE
+#  define EZ_PERFORMANCE_TESTS_STATE ezTestBlock::DisabledNoWarning
+#endif
+
+EZ_CREATE_SIMPLE_TEST(Performance, OrderedMaps)
+{
+  ezDynamicArray<ezUInt64> keys;
+  keys.SetCountUninitialized(ORDEREDPERF_NUM_KEYS);
+
+  ezUInt64 uiState = 0x9E3779B97F4A7C15ull;
+  for (ezUInt32 i = 0; i < keys.GetCount(); ++i)
+  {
+    uiState ^= uiState << 13;
+    uiState ^= uiState >> 7;
+    uiState ^= uiState << 17;
+    keys[i] = uiState | 1;
+  }
+
+  EZ_TEST_BLOCK(EZ_PERFORMANCE_TESTS_STATE, "Random ezUInt64 keys")
+  {
+    LogOrderedMapPerf("ezMap", MeasureOrderedMap<ezMap<ezUInt64, ezUInt32>>(keys));
+    LogOrderedMapPerf("ezArrayMap", MeasureOrderedMap<ezArrayMap<ezUInt64, ezUInt32>>(keys));
+    LogOrderedMapPerf("ezBTreeMap", MeasureOrderedMap<ezBTreeMap<ezUInt64, ezUInt32>>(keys));
+  }
+
+  EZ_TEST_BLOCK(EZ_PERFORMANCE_TESTS_STATE, "Bulk load")
+  {
+    ezDynamicArray<ezUInt64> sortedKeys = keys;
+    sortedKeys.Sort();
+
+    ezDynamicArray<ezUInt32> values;
+    values.SetCount(sortedKeys.GetCount());
+
+    ezTime tMap, tArrayMap, tBTreeMap;
+
+    for (ezUInt32 uiRound = 0; uiRound < ORDEREDPERF_NUM_ROUNDS; ++uiRound)
+    {
+      ezTime t0 = ezTime::Now();
+      {
+        ezMap<ezUInt64, ezUInt32> map;
+        for (ezUInt32 i = 0; i < sortedKeys.GetCount(); ++i)
+        {
+          map.Insert(sortedKeys[i], values[i]);
+        }
+      }
+      ezTime t1 = ezTime::Now();
+      tMap += t1 - t0;
+
+      {
+        ezArrayMap<ezUInt64, ezUInt32> map;
+        map.Reserve(sortedKeys.GetCount());
+        for (ezUInt32 i = 0; i < sortedKeys.GetCount(); ++i)
+        {
+          map.Insert(sortedKeys[i], values[i]);
+        }
+        map.Sort();
+      }
+      t0 = ezTime::Now();
+      tArrayMap += t0 - t1;
+
+      {
+        ezBTreeMap<ezUInt64, ezUInt32> map;
+        map.BuildFromSorted(sortedKeys, values);
+      }
+      t1 = ezTime::Now();
+      tBTreeMap += t1 - t0;
+    }
+
+    const double fDivider = static_cast<double>(ORDEREDPERF_NUM_ROUNDS);
+    ezLog::Info("[test]Bulk load: ezMap {0}ms, ezArrayMap {1}ms, ezBTreeMap {2}ms", ezArgF(tMap.GetMilliseconds() / fDivider, 4),
+      ezArgF(tArrayMap.GetMilliseconds() / fDivider, 4), ezArgF(tBTreeMap.GetMilliseconds() / fDivider, 4));
+  }
+}
@@ -0,0 +1,243 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/IO/JSONParser.h>
+#include <Foundation/IO/JSONReader.h>
+#include <Foundation/IO/MemoryStream.h>
+#include <Foundation/IO/OpenDdlParser.h>
+#include <Foundation/IO/OpenDdlReader.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Strings/StringBuilder.h>
+#include <Foundation/Time/Time.h>
+
+namespace
+{
+  enum ParserPerfConstants
+  {
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
+    PARSERPERF_NUM_OBJECTS = 1000,
+    PARSERPERF_NUM_ROUNDS = 2,
+#else
+    PARSERPERF_NUM_OBJECTS = 50000,
+    PARSERPERF_NUM_ROUNDS = 8,
+#endif
+  };
+
+  // a document that looks like typical exported asset data: nested objects, names, strings, float and integer lists
+  void ParserPerfBuildDdl(ezStringBuilder& out_sDoc)
+  {
+    for (ezUInt32 i = 0; i < PARSERPERF_NUM_OBJECTS; ++i)
+    {
+      out_sDoc.AppendFormat("Object %%obj{0}\n{\n  string %%Name{ \"Some object name {0}\" }\n"
+                            "  string %%Path{ \"Data/Objects/Sub\\\\Folder/obj_{0}.ezObject\" }\n"
+                            "  float %%Transform{ 1.5, 0, 0, {0}.25, 0, 1, 0, -17.125, 0, 0, 1, 3.75 }\n"
+                            "  unsigned_int32 %%Ids{ {0}, 1234567, 42, 7, 99999 }\n  bool %%Active{ true }\n}\n\n",
+        i);
+    }
+  }
+
+  void ParserPerfBuildJson(ezStringBuilder& out_sDoc)
+  {
+    out_sDoc.Append("{\n");
+
+    for (ezUInt32 i = 0; i < PARSERPERF_NUM_OBJECTS; ++i)
+    {
+      out_sDoc.AppendFormat("  \"obj{0}\" :\n  {\n    \"name\" : \"Some object name {0}\",\n"
+                            "    \"path\" : \"Data/Objects/Sub\\\\Folder/obj_{0}.ezObject\",\n"
+                            "    \"transform\" : [1.5, 0, 0, {0}.25, 0, 1, 0, -17.125, 0, 0, 1, 3.75],\n"
+                            "    \"ids\" : [{0}, 1234567, 42, 7, 99999],\n    \"active\" : true\n  },\n",
+        i);
+    }
+
+    out_sDoc.Append("  \"last\" : null\n}\n");
+  }
+
+  /// Hands out one byte per call, which is how the parsers used to read their input.
+  class ParserPerfByteStream : public ezStreamReader
+  {
+  public:
+    ParserPerfByteStream(ezArrayPtr<const ezUInt8> data)
+      : m_Data(data)
+    {
+    }
+
+    virtual ezUInt64 ReadBytes(void* pReadBuffer, ezUInt64 uiBytesToRead) override
+    {
+      if (uiBytesToRead == 0 || m_uiPosition >= m_Data.GetCount())
+        return 0;
+
+      *static_cast<ezUInt8*>(pReadBuffer) = m_Data[m_uiPosition++];
+      return 1;
+    }
+
+  private:
+    ezArrayPtr<const ezUInt8> m_Data;
+    ezUInt32 m_uiPosition = 0;
+  };
+
+  /// Only counts the callbacks, to measure the parser itself without building a document.
+  class ParserPerfDdlCounter : public ezOpenDdlParser
+  {
+  public:
+    ezUInt32 Parse(ezStreamReader& stream)
+    {
+      SetInputStream(stream);
+      ParseAll();
+      return m_uiNumCallbacks;
+    }
+
+    ezUInt32 Parse(ezArrayPtr<const ezUInt8> data)
+    {
+      SetInputMemory(data);
+      ParseAll();
+      return m_uiNumCallbacks;
+    }
+
+  protected:
+    virtual void OnBeginObject(const char* szType, const char* szName, bool bGlobalName) override { ++m_uiNumCallbacks; }
+    virtual void OnEndObject() override { ++m_uiNumCallbacks; }
+    virtual void OnBeginPrimitiveList(ezOpenDdlPrimitiveType type, const char* szName, bool bGlobalName) override { ++m_uiNumCallbacks; }
+    virtual void OnEndPrimitiveList() override { ++m_uiNumCallbacks; }
+    virtual void OnPrimitiveBool(ezUInt32 count, const bool* pData, bool bThisIsAll) override { ++m_uiNumCallbacks; }
+    virtual void OnPrimitiveInt8(ezUInt32 count, const ezInt8* pData, bool bThisIsAll) override { ++m_uiNumCallbacks; }
+    virtual void OnPrimitiveInt16(ezUInt32 count, const ezInt16* pData, bool bThisIsAll) override { ++m_uiNumCallbacks; }
+    virtual void OnPrimitiveInt32(ezUInt32 count, const ezInt32* pData, bool bThisIsAll) override { ++m_uiNumCallbacks; }
+    virtual void OnPrimitiveInt64(ezUInt32 count, const ezInt64* pData, bool bThisIsAll) override { ++m_uiNumCallbacks; }
+    virtual void OnPrimitiveUInt8(ezUInt32 count, const ezUInt8* pData, bool bThisIsAll) override { ++m_uiNumCallbacks; }
+    virtual void OnPrimitiveUInt16(ezUInt32 count, const ezUInt16* pData, bool bThisIsAll) override { ++m_uiNumCallbacks; }
+    virtual void OnPrimitiveUInt32(ezUInt32 count, const ezUInt32* pData, bool bThisIsAll) override { ++m_uiNumCallbacks; }
+    virtual void OnPrimitiveUInt64(ezUInt32 count, const ezUInt64* pData, bool bThisIsAll) override { ++m_uiNumCallbacks; }
+    virtual void OnPrimitiveFloat(ezUInt32 count, const float* pData, bool bThisIsAll) override { ++m_uiNumCallbacks; }
+    virtual void OnPrimitiveDouble(ezUInt32 count, const double* pData, bool bThisIsAll) override { ++m_uiNumCallbacks; }
+    virtual void OnPrimitiveString(ezUInt32 count, const ezStringView* pData, bool bThisIsAll) override { ++m_uiNumCallbacks; }
+
+    ezUInt32 m_uiNumCallbacks = 0;
+  };
+
+  class ParserPerfJsonCounter : public ezJSONParser
+  {
+  public:
+    ezUInt32 Parse(ezStreamReader& stream)
+    {
+      SetInputStream(stream);
+      ParseAll();
+      return m_uiNumCallbacks;
+    }
+
+    ezUInt32 Parse(ezArrayPtr<const ezUInt8> data)
+    {
+      SetInputMemory(data);
+      ParseAll();
+      return m_uiNumCallbacks;
+    }
+
+  private:
+    virtual bool OnVariable(const char* szVarName) override
+    {
+      ++m_uiNumCallbacks;
+      return true;
+    }
+
+    virtual void OnReadValue(const char* szValue) override { ++m_uiNumCallbacks; }
+    virtual void OnReadValue(double fValue) override { ++m_uiNumCallbacks; }
+    virtual void OnReadValue(bool bValue) override { ++m_uiNumCallbacks; }
+    virtual void OnReadValueNULL() override { ++m_uiNumCallbacks; }
+    virtual void OnBeginObject() override { ++m_uiNumCallbacks; }
+    virtual void OnEndObject() override { ++m_uiNumCallbacks; }
+    virtual void OnBeginArray() override { ++m_uiNumCallbacks; }
+    virtual void OnEndArray() override { ++m_uiNumCallbacks; }
+
+    ezUInt32 m_uiNumCallbacks = 0;
+  };
+
+  /// Parses the document with a counting parser from a byte-wise stream, a regular stream and from memory, and with the full reader
+  /// from a stream and from memory.
+  template <typename Counter, typename Reader, typename ReaderParseFunc>
+  void MeasureParser(const char* szName, ezArrayPtr<const ezUInt8> data, ReaderParseFunc readerParse)
+  {
+    ezTime tBytes, tStream, tMemory, tReaderStream, tReaderMemory;
+
+    for (ezUInt32 uiRound = 0; uiRound < PARSERPERF_NUM_ROUNDS; ++uiRound)
+    {
+      ezTime t0 = ezTime::Now();
+      ezUInt32 uiCallbacksBytes = 0;
+      {
+        ParserPerfByteStream stream(data);
+        Counter parser;
+        uiCallbacksBytes = parser.Parse(stream);
+      }
+      ezTime t1 = ezTime::Now();
+      tBytes += t1 - t0;
+
+      ezUInt32 uiCallbacksStream = 0;
+      {
+        ezRawMemoryStreamReader stream(data.GetPtr(), data.GetCount());
+        Counter parser;
+        uiCallbacksStream = parser.Parse(stream);
+      }
+      t0 = ezTime::Now();
+      tStream += t0 - t1;
+
+      ezUInt32 uiCallbacksMemory = 0;
+      {
+        Counter parser;
+        uiCallbacksMemory = parser.Parse(data);
+      }
+      t1 = ezTime::Now();
+      tMemory += t1 - t0;
+
+      EZ_TEST_INT(uiCallbacksBytes, uiCallbacksMemory);
+      EZ_TEST_INT(uiCallbacksStream, uiCallbacksMemory);
+
+      {
+        ezRawMemoryStreamReader stream(data.GetPtr(), data.GetCount());
+        Reader reader;
+        EZ_TEST_BOOL(readerParse(reader, stream).Succeeded());
+      }
+      t0 = ezTime::Now();
+      tReaderStream += t0 - t1;
+
+      {
+        Reader reader;
+        EZ_TEST_BOOL(readerParse(reader, data).Succeeded());
+      }
+      t1 = ezTime::Now();
+      tReaderMemory += t1 - t0;
+    }
+
+    const double fDivider = static_cast<double>(PARSERPERF_NUM_ROUNDS);
+    ezLog::Info("[test]{0} ({1} KB): parser byte-wise {2}ms, stream {3}ms, memory {4}ms; reader stream {5}ms, memory {6}ms", szName,
+      data.GetCount() / 1024, ezArgF(tBytes.GetMilliseconds() / fDivider, 4), ezArgF(tStream.GetMilliseconds() / fDivider, 4),
+      ezArgF(tMemory.GetMilliseconds() / fDivider, 4), ezArgF(tReaderStream.GetMilliseconds() / fDivider, 4),
+      ezArgF(tReaderMemory.GetMilliseconds() / fDivider, 4));
+  }
+} // namespace
+
+// Enable when needed
+#ifndef EZ_PERFORMANCE_TESTS_STATE
+#  define EZ_PERFORMANCE_TESTS_STATE ezTestBlock::DisabledNoWarning
+#endif
+
+EZ_CREATE_SIMPLE_TEST(Performance, Parsers)
+{
+  EZ_TEST_BLOCK(EZ_PERFORMANCE_TESTS_STATE, "OpenDDL")
+  {
+    ezStringBuilder sDoc;
+    ParserPerfBuildDdl(sDoc);
+
+    const ezArrayPtr<const ezUInt8> data(reinterpret_cast<const ezUInt8*>(sDoc.GetData()), sDoc.GetElementCount());
+
+    MeasureParser<ParserPerfDdlCounter, ezOpenDdlReader>("OpenDDL", data,
+      [](ezOpenDdlReader& reader, auto& input) { return reader.ParseDocument(input); });
+  }
+
+  EZ_TEST_BLOCK(EZ_PERFORMANCE_TESTS_STATE, "JSON")
+  {
+    ezStringBuilder sDoc;
+    ParserPerfBuildJson(sDoc);
+
+    const ezArrayPtr<const ezUInt8> data(reinterpret_cast<const ezUInt8*>(sDoc.GetData()), sDoc.GetElementCount());
+
+    MeasureParser<ParserPerfJsonCounter, ezJSONReader>("JSON", data,
+      [](ezJSONReader& reader, auto& input) { return reader.Parse(input); });
+  }
+}
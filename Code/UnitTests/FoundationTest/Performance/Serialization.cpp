@@ -0,0 +1,194 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/IO/MemoryStream.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Serialization/ReflectionSerializer.h>
+#include <Foundation/Serialization/RttiBinarySerializer.h>
+#include <Foundation/Time/Time.h>
+#include <FoundationTest/Reflection/ReflectionTestClasses.h>
+
+namespace
+{
+  enum SerializationPerfConstants
+  {
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
+    SERIALIZATIONPERF_NUM_OBJECTS = 200,
+    SERIALIZATIONPERF_NUM_ELEMENTS = 1000,
+#else
+    SERIALIZATIONPERF_NUM_OBJECTS = 5000,
+    SERIALIZATIONPERF_NUM_ELEMENTS = 50000,
+#endif
+  };
+
+  /// Writes and reads all objects once with the object graph based ezReflectionSerializer and once with ezRttiBinarySerializer.
+  template <typename T>
+  void MeasureSerialization(const char* szName, const ezDynamicArray<T>& objects)
+  {
+    const ezRTTI* pRtti = ezGetStaticRTTI<T>();
+
+    ezMemoryStreamStorage graphStorage;
+    ezMemoryStreamStorage binaryStorage;
+    ezRttiBinarySerializer serializer;
+
+    ezTime t0 = ezTime::Now();
+    {
+      ezMemoryStreamWriter writer(&graphStorage);
+      for (const T& object : objects)
+        ezReflectionSerializer::WriteObjectToBinary(writer, pRtti, &object);
+    }
+    ezTime t1 = ezTime::Now();
+    const ezTime tGraphWrite = t1 - t0;
+
+    {
+      ezMemoryStreamWriter writer(&binaryStorage);
+      for (const T& object : objects)
+        EZ_TEST_BOOL(serializer.WriteObject(writer, pRtti, &object).Succeeded());
+    }
+    t0 = ezTime::Now();
+    const ezTime tBinaryWrite = t0 - t1;
+
+    ezDynamicArray<T> graphObjects;
+    graphObjects.SetCount(objects.GetCount());
+    {
+      ezMemoryStreamReader reader(&graphStorage);
+      for (T& object : graphObjects)
+        ezReflectionSerializer::ReadObjectPropertiesFromBinary(reader, *pRtti, &object);
+    }
+    t1 = ezTime::Now();
+    const ezTime tGraphRead = t1 - t0;
+
+    ezDynamicArray<T> binaryObjects;
+    binaryObjects.SetCount(objects.GetCount());
+    {
+      ezMemoryStreamReader reader(&binaryStorage);
+      for (T& object : binaryObjects)
+        EZ_TEST_BOOL(serializer.ReadObjectProperties(reader, pRtti, &object).Succeeded());
+    }
+    t0 = ezTime::Now();
+    const ezTime tBinaryRead = t0 - t1;
+
+    for (ezUInt32 i = 0; i < objects.GetCount(); ++i)
+    {
+      EZ_TEST_BOOL(objects[i] == graphObjects[i]);
+      EZ_TEST_BOOL(objects[i] == binaryObjects[i]);
+    }
+
+    ezLog::Info("[test]{0}: graph write {1}ms, read {2}ms, {3} KB; compiled write {4}ms, read {5}ms, {6} KB", szName,
+      ezArgF(tGraphWrite.GetMilliseconds(), 4), ezArgF(tGraphRead.GetMilliseconds(), 4), graphStorage.GetStorageSize() / 1024,
+      ezArgF(tBinaryWrite.GetMilliseconds(), 4), ezArgF(tBinaryRead.GetMilliseconds(), 4), binaryStorage.GetStorageSize() / 1024);
+  }
+
+  /// Writes and reads the array once element by element with the stream operators and once with WriteArray() / ReadArray(),
+  /// which use a single call for arrays of stream POD types.
+  template <typename T>
+  void MeasureArraySerialization(const char* szName, const ezDynamicArray<T>& elements)
+  {
+    ezMemoryStreamStorage elementStorage;
+    ezMemoryStreamStorage arrayStorage;
+
+    ezTime t0 = ezTime::Now();
+    {
+      ezMemoryStreamWriter writer(&elementStorage);
+      for (const T& element : elements)
+        writer << element;
+    }
+    ezTime t1 = ezTime::Now();
+    const ezTime tElementWrite = t1 - t0;
+
+    {
+      ezMemoryStreamWriter writer(&arrayStorage);
+      EZ_TEST_BOOL(writer.WriteArray(elements).Succeeded());
+    }
+    t0 = ezTime::Now();
+    const ezTime tArrayWrite = t0 - t1;
+
+    ezDynamicArray<T> readElements;
+    readElements.SetCount(elements.GetCount());
+    {
+      ezMemoryStreamReader reader(&elementStorage);
+      for (T& element : readElements)
+        reader >> element;
+    }
+    t1 = ezTime::Now();
+    const ezTime tElementRead = t1 - t0;
+
+    ezDynamicArray<T> readArray;
+    {
+      ezMemoryStreamReader reader(&arrayStorage);
+      EZ_TEST_BOOL(reader.ReadArray(readArray).Succeeded());
+    }
+    t0 = ezTime::Now();
+    const ezTime tArrayRead = t0 - t1;
+
+    EZ_TEST_BOOL(readElements == elements);
+    EZ_TEST_BOOL(readArray == elements);
+
+    const double fMegaBytes = elementStorage.GetStorageSize() / (1024.0 * 1024.0);
+    ezLog::Info("[test]{0}: {1} MB; per element write {2} MB/s, read {3} MB/s; array write {4} MB/s, read {5} MB/s", szName,
+      ezArgF(fMegaBytes, 2), ezArgF(fMegaBytes / tElementWrite.GetSeconds(), 0), ezArgF(fMegaBytes / tElementRead.GetSeconds(), 0),
+      ezArgF(fMegaBytes / tArrayWrite.GetSeconds(), 0), ezArgF(fMegaBytes / tArrayRead.GetSeconds(), 0));
+  }
+} // namespace
+
+// Enable when needed
+#ifndef EZ_PERFORMANCE_TESTS_STATE
+#  define EZ_PERFORMANCE_TESTS_STATE ezTestBlock::DisabledNoWarning
+#endif
+
+EZ_CREATE_SIMPLE_TEST(Performance, Serialization)
+{
+  EZ_TEST_BLOCK(EZ_PERFORMANCE_TESTS_STATE, "Many Small Objects")
+  {
+    ezDynamicArray<ezTestClass1> objects;
+    objects.SetCount(SERIALIZATIONPERF_NUM_OBJECTS);
+
+    for (ezUInt32 i = 0; i < objects.GetCount(); ++i)
+    {
+      objects[i].m_Color = ezColor(i * 0.001f, 0.5f, 1.0f);
+      objects[i].m_Struct.m_fFloat1 = static_cast<float>(i);
+      objects[i].m_Struct.m_UInt8 = static_cast<ezUInt8>(i);
+      objects[i].m_Struct.m_vVec3I = ezVec3I32(i, -1, 2);
+    }
+
+    MeasureSerialization("ezTestClass1", objects);
+  }
+
+  EZ_TEST_BLOCK(EZ_PERFORMANCE_TESTS_STATE, "Large Arrays")
+  {
+    ezDynamicArray<ezTestArrays> objects;
+    objects.SetCount(4);
+
+    for (ezTestArrays& object : objects)
+    {
+      for (ezUInt32 i = 0; i < SERIALIZATIONPERF_NUM_ELEMENTS; ++i)
+      {
+        object.m_Hybrid.PushBack(i * 0.5);
+        object.m_Dynamic.PushBack(ezTestStruct3(i * 0.25, static_cast<ezInt16>(i)));
+      }
+    }
+
+    MeasureSerialization("ezTestArrays", objects);
+  }
+
+  EZ_TEST_BLOCK(EZ_PERFORMANCE_TESTS_STATE, "POD Arrays")
+  {
+    ezDynamicArray<ezVec3> positions;
+    ezDynamicArray<ezMat4> matrices;
+    ezDynamicArray<ezTransform> transforms;
+
+    for (ezUInt32 i = 0; i < SERIALIZATIONPERF_NUM_ELEMENTS * 10; ++i)
+    {
+      const ezVec3 vPos(i * 0.5f, 1.0f, -2.0f);
+      positions.PushBack(vPos);
+
+      ezMat4& m = matrices.ExpandAndGetRef();
+      m.SetTranslationMatrix(vPos);
+
+      transforms.PushBack(ezTransform(vPos));
+    }
+
+    MeasureArraySerialization("ezVec3", positions);
+    MeasureArraySerialization("ezMat4", matrices);
+    MeasureArraySerialization("ezTransform", transforms);
+  }
+}
@@ -0,0 +1,229 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/IO/MemoryStream.h>
+#include <Foundation/Serialization/RttiBinarySerializer.h>
+#include <FoundationTest/Reflection/ReflectionTestClasses.h>
+#include <TestFramework/Utilities/TestLogInterface.h>
+
+template <typename T>
+void TestRttiBinarySerialize(ezRttiBinarySerializer& serializer, const T& object)
+{
+  const ezRTTI* pRtti = ezGetStaticRTTI<T>();
+
+  ezMemoryStreamStorage storage;
+  ezMemoryStreamWriter writer(&storage);
+  EZ_TEST_BOOL(serializer.WriteObject(writer, pRtti, &object).Succeeded());
+
+  {
+    ezMemoryStreamReader reader(&storage);
+
+    T clone;
+    EZ_TEST_BOOL(serializer.ReadObjectProperties(reader, pRtti, &clone).Succeeded());
+    EZ_TEST_BOOL(object == clone);
+    EZ_TEST_INT(reader.ReadBytes(nullptr, 1), 0);
+  }
+
+  {
+    ezMemoryStreamReader reader(&storage);
+
+    const ezRTTI* pReadRtti = nullptr;
+    void* pObject = serializer.ReadObject(reader, pReadRtti);
+
+    EZ_TEST_BOOL(pReadRtti == pRtti);
+    if (EZ_TEST_BOOL(pObject != nullptr).Succeeded())
+    {
+      EZ_TEST_BOOL(object == *static_cast<T*>(pObject));
+      pReadRtti->GetAllocator()->Deallocate(pObject);
+    }
+  }
+
+  // a fresh serializer compiles all plans from scratch when reading
+  {
+    ezMemoryStreamReader reader(&storage);
+    ezRttiBinarySerializer serializer2;
+
+    T clone;
+    EZ_TEST_BOOL(serializer2.ReadObjectProperties(reader, pRtti, &clone).Succeeded());
+    EZ_TEST_BOOL(object == clone);
+  }
+}
+
+EZ_CREATE_SIMPLE_TEST(Serialization, RttiBinarySerializer)
+{
+  ezRttiBinarySerializer serializer;
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "PODs")
+  {
+    ezTestStruct t1;
+    t1.m_fFloat1 = 5.0f;
+    t1.m_UInt8 = 222;
+    t1.m_variant = "A";
+    t1.m_Angle = ezAngle::Degree(5);
+    t1.m_DataBuffer.PushBack(1);
+    t1.m_DataBuffer.PushBack(5);
+    t1.m_vVec3I = ezVec3I32(0, 1, 333);
+    TestRttiBinarySerialize(serializer, t1);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Enum and Bitflags")
+  {
+    ezTestEnumStruct t1;
+    t1.m_enum = ezExampleEnum::Value2;
+    t1.m_enumClass = ezExampleEnum::Value3;
+    t1.SetEnum(ezExampleEnum::Value2);
+    t1.SetEnumClass(ezExampleEnum::Value3);
+    TestRttiBinarySerialize(serializer, t1);
+
+    ezTestBitflagsStruct t2;
+    t2.m_bitflagsClass.SetValue(0);
+    t2.SetBitflagsClass(ezExampleBitflags::Value1 | ezExampleBitflags::Value2);
+    TestRttiBinarySerialize(serializer, t2);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Derived Class")
+  {
+    ezTestClass2 t1;
+    t1.m_Color = ezColor::Yellow;
+    t1.m_Struct.m_fFloat1 = 5.0f;
+    t1.m_Struct.m_UInt8 = 222;
+    t1.m_Struct.m_variant = "A";
+    t1.m_Struct.m_Angle = ezAngle::Degree(5);
+    t1.m_Struct.m_DataBuffer.PushBack(1);
+    t1.m_Struct.m_vVec3I = ezVec3I32(0, 1, 333);
+    t1.m_Time = ezTime::Seconds(22.2f);
+    t1.m_enumClass = ezExampleEnum::Value3;
+    t1.m_bitflagsClass = ezExampleBitflags::Value1 | ezExampleBitflags::Value2;
+    t1.m_array.PushBack(40.0f);
+    t1.m_array.PushBack(-1.5f);
+    t1.m_Variant = ezVec4(1, 2, 3, 4);
+    t1.SetText("LALALALA");
+    TestRttiBinarySerialize(serializer, t1);
+
+    // the comparison operator of ezTestClass2 only checks its own members
+    ezMemoryStreamStorage storage;
+    ezMemoryStreamWriter writer(&storage);
+    ezMemoryStreamReader reader(&storage);
+    EZ_TEST_BOOL(serializer.WriteObject(writer, ezGetStaticRTTI<ezTestClass1>(), &t1).Succeeded());
+
+    ezTestClass2 clone;
+    EZ_TEST_BOOL(serializer.ReadObjectProperties(reader, ezGetStaticRTTI<ezTestClass1>(), &clone).Succeeded());
+    EZ_TEST_BOOL(t1 == clone);
+    EZ_TEST_BOOL(static_cast<const ezTestClass1&>(t1) == static_cast<const ezTestClass1&>(clone));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Arrays")
+  {
+    ezTestArrays t1;
+    t1.m_Hybrid.PushBack(4.5f);
+    t1.m_Hybrid.PushBack(2.3f);
+    t1.m_HybridChar.PushBack("Test");
+    t1.m_HybridChar.PushBack("Test2");
+
+    ezTestStruct3 ts;
+    ts.m_fFloat1 = 5.0f;
+    ts.m_UInt8 = 22;
+    t1.m_Dynamic.PushBack(ts);
+    t1.m_Dynamic.PushBack(ts);
+
+    ezTestArrays& nested = t1.m_Deque.ExpandAndGetRef();
+    nested.m_Hybrid.PushBack(-1.0);
+    nested.m_Deque.PushBack(ezTestArrays());
+    TestRttiBinarySerialize(serializer, t1);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Sets")
+  {
+    ezTestSets t1;
+    t1.m_SetMember.Insert(0);
+    t1.m_SetMember.Insert(5);
+    t1.m_SetMember.Insert(-33);
+    t1.m_SetAccessor.Insert(-0.0f);
+    t1.m_SetAccessor.Insert(5.4f);
+    t1.m_SetAccessor.Insert(-33.0f);
+    t1.m_Deque.PushBack(3);
+    t1.m_Deque.PushBack(33);
+    t1.m_Array.PushBack("Test");
+    t1.m_Array.PushBack("Bla");
+    TestRttiBinarySerialize(serializer, t1);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Maps")
+  {
+    ezTestMaps t1;
+    t1.m_MapMember.Insert("a", 3);
+    t1.m_MapMember.Insert("b", 5);
+    t1.m_MapAccessor.Insert("c", -7);
+    t1.m_HashTableMember.Insert("d", 1.5);
+    t1.m_HashTableAccessor.Insert("e", "Text");
+    t1.Insert3("f", ezVec2(1, 2));
+    TestRttiBinarySerialize(serializer, t1);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Schema Mismatch")
+  {
+    // ezTestClass2b derives privately from ezReflectedClass, so ezGetStaticRTTI() cannot be used for it
+    const ezRTTI* pRtti2b = ezRTTI::FindTypeByName("ezTestClass2b");
+
+    ezTestClass2b t1;
+    t1.SetText("Different");
+    t1.m_Struct.m_fFloat1 = 2.5;
+    t1.m_Struct.m_UInt8 = 17;
+    t1.m_Color = ezColor::Red;
+
+    ezMemoryStreamStorage storage;
+    ezMemoryStreamWriter writer(&storage);
+    ezMemoryStreamReader reader(&storage);
+    EZ_TEST_BOOL(serializer.WriteObject(writer, pRtti2b, &t1).Succeeded());
+
+    ezUInt32 uiStoredVersion = 0;
+    ezVariantDictionary unmatchedValues;
+    serializer.SetVersionPatchFunc(
+      [&](const ezRTTI* pType, void* pObject, ezUInt32 uiVersion, const ezVariantDictionary& unmatched) {
+        if (pType == ezGetStaticRTTI<ezTestClass2>())
+        {
+          uiStoredVersion = uiVersion;
+          unmatchedValues = unmatched;
+        }
+      });
+
+    // properties with the same name are assigned, converting double to float and ezInt16 to ezUInt8
+    ezTestClass2 clone;
+    EZ_TEST_BOOL(serializer.ReadObjectProperties(reader, ezGetStaticRTTI<ezTestClass2>(), &clone).Succeeded());
+    EZ_TEST_FLOAT(clone.m_Struct.m_fFloat1, 2.5f, 0.0f);
+    EZ_TEST_INT(clone.m_Struct.m_UInt8, 17);
+    EZ_TEST_BOOL(clone.m_Color == ezColor::Red);
+    EZ_TEST_STRING(clone.GetText(), "Legen");
+
+    EZ_TEST_INT(uiStoredVersion, pRtti2b->GetTypeVersion());
+    EZ_TEST_INT(unmatchedValues.GetCount(), 1);
+    if (EZ_TEST_BOOL(unmatchedValues.Contains("Text2b")).Succeeded())
+    {
+      EZ_TEST_BOOL(unmatchedValues["Text2b"] == ezVariant("Different"));
+    }
+
+    serializer.SetVersionPatchFunc(ezRttiBinarySerializer::VersionPatchFunc());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Unsupported Pointers")
+  {
+    ezTestLogInterface log;
+    ezTestLogSystemScope logSystemScope(&log);
+    log.ExpectMessage("Cannot serialize 'ezTestPtr'", ezLogMsgType::ErrorMsg);
+
+    ezTestPtr t1;
+    t1.m_sString = "Ttttest";
+
+    ezMemoryStreamStorage storage;
+    ezMemoryStreamWriter writer(&storage);
+    EZ_TEST_BOOL(serializer.WriteObject(writer, ezGetStaticRTTI<ezTestPtr>(), &t1).Failed());
+    EZ_TEST_INT(storage.GetStorageSize(), 0);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "ClearCache")
+  {
+    serializer.ClearCache();
+
+    ezTestStruct3 t1(3.0, 4);
+    TestRttiBinarySerialize(serializer, t1);
+  }
+}
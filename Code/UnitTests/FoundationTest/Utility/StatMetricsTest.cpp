@@ -0,0 +1,196 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/Threading/TaskSystem.h>
+#include <Foundation/Threading/Thread.h>
+#include <Foundation/Utilities/StatMetrics.h>
+#include <Foundation/Utilities/Stats.h>
+
+static ezStatCounter s_TestCounter("UnitTest/StatMetrics/Counter", true);
+static ezStatGauge s_TestGauge("UnitTest/StatMetrics/Gauge");
+static ezStatHistogram s_TestHistogram("UnitTest/StatMetrics/Histogram");
+
+EZ_CREATE_SIMPLE_TEST(Utility, StatMetrics)
+{
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "FindMetricByName")
+  {
+    EZ_TEST_BOOL(ezStatMetric::FindMetricByName("UnitTest/StatMetrics/Counter") == &s_TestCounter);
+    EZ_TEST_BOOL(ezStatMetric::FindMetricByName("UnitTest/StatMetrics/Gauge") == &s_TestGauge);
+    EZ_TEST_BOOL(ezStatMetric::FindMetricByName("UnitTest/StatMetrics/Histogram") == &s_TestHistogram);
+    EZ_TEST_BOOL(ezStatMetric::FindMetricByName("UnitTest/StatMetrics/Unknown") == nullptr);
+
+    EZ_TEST_INT(s_TestCounter.GetType(), ezStatMetricType::Counter);
+    EZ_TEST_INT(s_TestGauge.GetType(), ezStatMetricType::Gauge);
+    EZ_TEST_INT(s_TestHistogram.GetType(), ezStatMetricType::Histogram);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Counter")
+  {
+    s_TestCounter.Reset();
+
+    ezTaskSystem::ParallelForIndexed(0, 10000, [](ezUInt32 uiStart, ezUInt32 uiEnd) {
+      for (ezUInt32 i = uiStart; i < uiEnd; ++i)
+      {
+        s_TestCounter.Increment();
+      }
+    });
+
+    EZ_TEST_INT(s_TestCounter.GetValue(), 10000);
+    EZ_TEST_INT(s_TestCounter.GetValueLastFrame(), 0);
+
+    ezStatMetric::UpdateAll();
+
+    EZ_TEST_INT(s_TestCounter.GetValue(), 10000);
+    EZ_TEST_INT(s_TestCounter.GetValueLastFrame(), 10000);
+    EZ_TEST_INT(ezStats::GetStat("UnitTest/StatMetrics/Counter").ConvertTo<ezInt64>(), 10000);
+
+    s_TestCounter.Add(5);
+    ezStatMetric::UpdateAll();
+
+    EZ_TEST_INT(s_TestCounter.GetValue(), 10005);
+    EZ_TEST_INT(s_TestCounter.GetValueLastFrame(), 5);
+    EZ_TEST_INT(ezStats::GetStat("UnitTest/StatMetrics/Counter").ConvertTo<ezInt64>(), 5);
+
+    s_TestCounter.Reset();
+    EZ_TEST_INT(s_TestCounter.GetValue(), 0);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Gauge")
+  {
+    s_TestGauge.Reset();
+
+    s_TestGauge.Set(42);
+    EZ_TEST_INT(s_TestGauge.GetValue(), 42);
+
+    ezStatMetric::UpdateAll();
+    EZ_TEST_INT(ezStats::GetStat("UnitTest/StatMetrics/Gauge").ConvertTo<ezInt64>(), 42);
+
+    s_TestGauge.Add(-40);
+    ezStatMetric::UpdateAll();
+
+    EZ_TEST_INT(s_TestGauge.GetValue(), 2);
+    EZ_TEST_INT(s_TestGauge.GetMaxValue(), 42);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Histogram Buckets")
+  {
+    for (ezUInt64 i = 0; i < 100000; i += 7)
+    {
+      const ezUInt32 uiBucket = ezStatHistogram::GetBucketIndex(i);
+      EZ_TEST_BOOL(uiBucket < ezStatHistogram::NumBuckets);
+      EZ_TEST_BOOL(ezStatHistogram::GetBucketLowerBound(uiBucket) <= i);
+      EZ_TEST_BOOL(ezStatHistogram::GetBucketUpperBound(uiBucket) >= i);
+    }
+
+    for (ezUInt32 i = 0; i < ezStatHistogram::NumBuckets; ++i)
+    {
+      EZ_TEST_INT(ezStatHistogram::GetBucketIndex(ezStatHistogram::GetBucketLowerBound(i)), i);
+      EZ_TEST_INT(ezStatHistogram::GetBucketIndex(ezStatHistogram::GetBucketUpperBound(i)), i);
+    }
+
+    EZ_TEST_INT(ezStatHistogram::GetBucketIndex(ezMath::MaxValue<ezUInt64>()), ezStatHistogram::NumBuckets - 1);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Histogram Percentiles")
+  {
+    s_TestHistogram.Reset();
+
+    ezTaskSystem::ParallelForIndexed(1, 999, [](ezUInt32 uiStart, ezUInt32 uiEnd) {
+      for (ezUInt32 i = uiStart; i < uiEnd; ++i)
+      {
+        s_TestHistogram.Record(i);
+      }
+    });
+
+    s_TestHistogram.Record(1000);
+
+    ezStatHistogramSnapshot snapshot;
+    s_TestHistogram.GetSnapshot(snapshot);
+
+    EZ_TEST_INT(snapshot.m_uiCount, 1000);
+    EZ_TEST_INT(snapshot.m_uiMin, 1);
+    EZ_TEST_INT(snapshot.m_uiMax, 1000);
+    EZ_TEST_DOUBLE(snapshot.GetMean(), 500.5, 0.0001);
+
+    // the bucket precision guarantees a relative error below 1/16
+    EZ_TEST_DOUBLE(static_cast<double>(snapshot.GetPercentile(0.5)), 500.0, 500.0 / 16.0);
+    EZ_TEST_DOUBLE(static_cast<double>(snapshot.GetPercentile(0.9)), 900.0, 900.0 / 16.0);
+    EZ_TEST_DOUBLE(static_cast<double>(snapshot.GetPercentile(0.99)), 990.0, 990.0 / 16.0);
+    EZ_TEST_INT(snapshot.GetPercentile(0.0), 1);
+    EZ_TEST_INT(snapshot.GetPercentile(1.0), 1000);
+
+    ezStatMetric::UpdateAll();
+    EZ_TEST_INT(ezStats::GetStat("UnitTest/StatMetrics/Histogram/Count").ConvertTo<ezUInt64>(), 1000);
+    EZ_TEST_INT(ezStats::GetStat("UnitTest/StatMetrics/Histogram/Max").ConvertTo<ezUInt64>(), 1000);
+
+    s_TestHistogram.Reset();
+    s_TestHistogram.GetSnapshot(snapshot);
+    EZ_TEST_INT(snapshot.m_uiCount, 0);
+    EZ_TEST_INT(snapshot.GetPercentile(0.5), 0);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Concurrent Aggregation")
+  {
+    s_TestCounter.Reset();
+    s_TestHistogram.Reset();
+
+    class RecordThread : public ezThread
+    {
+    public:
+      virtual ezUInt32 Run() override
+      {
+        for (ezUInt32 i = 0; i < 20000; ++i)
+        {
+          s_TestCounter.Increment();
+          s_TestHistogram.Record(3);
+        }
+        return 0;
+      }
+    };
+
+    RecordThread threads[4];
+
+    for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(threads); ++i)
+    {
+      threads[i].Start();
+    }
+
+    // while the values are aggregated, readers must neither miss updates nor see them twice
+    ezInt64 iLastValue = 0;
+    ezStatHistogramSnapshot snapshot;
+
+    for (ezUInt32 i = 0; i < 200; ++i)
+    {
+      ezStatMetric::UpdateAll(false);
+
+      const ezInt64 iValue = s_TestCounter.GetValue();
+      EZ_TEST_BOOL(iValue >= iLastValue);
+      iLastValue = iValue;
+
+      s_TestHistogram.GetSnapshot(snapshot);
+      EZ_TEST_INT(snapshot.m_uiSum, snapshot.m_uiCount * 3);
+      EZ_TEST_INT(snapshot.m_BucketCounts[ezStatHistogram::GetBucketIndex(3)], snapshot.m_uiCount);
+    }
+
+    for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(threads); ++i)
+    {
+      threads[i].Join();
+    }
+
+    s_TestHistogram.GetSnapshot(snapshot);
+    EZ_TEST_INT(s_TestCounter.GetValue(), 80000);
+    EZ_TEST_INT(snapshot.m_uiCount, 80000);
+    EZ_TEST_INT(snapshot.m_uiSum, 240000);
+
+    s_TestCounter.Reset();
+    s_TestHistogram.Reset();
+  }
+
+  ezStats::RemoveStat("UnitTest/StatMetrics/Counter");
+  ezStats::RemoveStat("UnitTest/StatMetrics/Gauge");
+  ezStats::RemoveStat("UnitTest/StatMetrics/Histogram/Count");
+  ezStats::RemoveStat("UnitTest/StatMetrics/Histogram/Mean");
+  ezStats::RemoveStat("UnitTest/StatMetrics/Histogram/P50");
+  ezStats::RemoveStat("UnitTest/StatMetrics/Histogram/P90");
+  ezStats::RemoveStat("UnitTest/StatMetrics/Histogram/P99");
+  ezStats::RemoveStat("UnitTest/StatMetrics/Histogram/Max");
+}
@@ -0,0 +1,396 @@
+#include <GameEngineTestPCH.h>
+
+#include <Foundation/Math/Random.h>
+#include <Foundation/SimdMath/SimdBSphere.h>
+#include <Foundation/SimdMath/SimdConversion.h>
+#include <Foundation/Time/Stopwatch.h>
+#include <Utilities/DataStructures/DynamicOctree.h>
+#include <Utilities/DataStructures/LinearOctree.h>
+
+namespace LinearOctreeTestDetail
+{
+  static bool CollectObject(void* pPassThrough, const ezLinearTreeObject& Object)
+  {
+    static_cast<ezDynamicArray<ezInt32>*>(pPassThrough)->PushBack(Object.m_iObjectInstance);
+    return true;
+  }
+
+  static bool CollectBatchObject(void* pPassThrough, ezUInt32 uiQueryIndex, const ezLinearTreeObject& Object)
+  {
+    auto& results = *static_cast<ezDynamicArray<ezDynamicArray<ezInt32>>*>(pPassThrough);
+    results[uiQueryIndex].PushBack(Object.m_iObjectInstance);
+    return true;
+  }
+
+  static bool CountObject(void* pPassThrough, const ezLinearTreeObject&)
+  {
+    ++(*static_cast<ezUInt32*>(pPassThrough));
+    return true;
+  }
+
+  static bool CountDynamicObject(void* pPassThrough, ezDynamicTreeObjectConst)
+  {
+    ++(*static_cast<ezUInt32*>(pPassThrough));
+    return true;
+  }
+
+  static bool CountBatchObject(void* pPassThrough, ezUInt32, const ezLinearTreeObject&)
+  {
+    ++(*static_cast<ezUInt32*>(pPassThrough));
+    return true;
+  }
+
+  static void CreateRandomObjects(ezUInt32 uiNumObjects, float fWorldSize, float fMaxObjectSize, ezDynamicArray<ezLinearTreeObjectDesc>& out_Objects)
+  {
+    ezRandom rng;
+    rng.Initialize(42);
+
+    out_Objects.SetCount(uiNumObjects);
+    for (ezUInt32 i = 0; i < uiNumObjects; ++i)
+    {
+      auto& obj = out_Objects[i];
+      obj.m_vCenter.Set(rng.FloatMinMax(-fWorldSize, fWorldSize), rng.FloatMinMax(-fWorldSize, fWorldSize), rng.FloatMinMax(-fWorldSize, fWorldSize));
+      obj.m_vHalfExtents.Set(rng.FloatMinMax(0, fMaxObjectSize), rng.FloatMinMax(0, fMaxObjectSize), rng.FloatMinMax(0, fMaxObjectSize));
+      obj.m_iObjectType = i % 3;
+      obj.m_iObjectInstance = i;
+    }
+  }
+
+  /// \brief Checks that the tree returns exactly the objects whose bounding box passes the given test.
+  template <typename FUNC>
+  static void CheckQuery(const ezDynamicArray<ezLinearTreeObjectDesc>& objects, ezDynamicArray<ezInt32>& found, FUNC overlaps)
+  {
+    ezDynamicArray<ezInt32> expected;
+    for (const auto& obj : objects)
+    {
+      ezBoundingBox box;
+      box.SetCenterAndHalfExtents(obj.m_vCenter, obj.m_vHalfExtents);
+
+      if (overlaps(box))
+        expected.PushBack(obj.m_iObjectInstance);
+    }
+
+    found.Sort();
+    EZ_TEST_INT(found.GetCount(), expected.GetCount());
+
+    if (found.GetCount() == expected.GetCount())
+    {
+      EZ_TEST_BOOL(found == expected);
+    }
+  }
+} // namespace LinearOctreeTestDetail
+
+EZ_CREATE_SIMPLE_TEST(DataStructures, LinearOctree)
+{
+  using namespace LinearOctreeTestDetail;
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "CreateTree / GetBoundingBox")
+  {
+    ezLinearOctree o;
+    o.CreateTree(ezVec3(100, 200, 300), ezVec3(300, 400, 500), 1.0f);
+
+    const ezBoundingBox& bb = o.GetBoundingBox();
+
+    EZ_TEST_VEC3(bb.GetCenter(), ezVec3(100, 200, 300), 0.01f);
+    EZ_TEST_VEC3(bb.GetHalfExtents(), ezVec3(500), 0.01f);
+    EZ_TEST_INT(o.GetMaxTreeDepth(), 10);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Insert Inside / Outside")
+  {
+    const ezVec3 c(100, 200, 300);
+    const float e = 50;
+
+    ezLinearOctree o;
+    o.CreateTree(c, ezVec3(e), 1.0f);
+    ezInt32 iInstance = 0;
+    ezUInt32 uiInside = 0;
+
+    for (float z = -e - 99; z < e + 100; z += 10.0f)
+    {
+      for (float y = -e - 99; y < e + 100; y += 10.0f)
+      {
+        for (float x = -e - 99; x < e + 100; x += 10.0f)
+        {
+          // only objects that are entirely outside the tree are rejected
+          const bool bInside = (z + 1 >= -e) && (z - 1 <= e) && (y + 1 >= -e) && (y - 1 <= e) && (x + 1 >= -e) && (x - 1 <= e);
+
+          EZ_TEST_BOOL(o.InsertObject(c + ezVec3(x, y, z), ezVec3(1.0f), 0, iInstance, true) == (bInside ? EZ_SUCCESS : EZ_FAILURE));
+          EZ_TEST_BOOL(o.InsertObject(c + ezVec3(x, y, z), ezVec3(1.0f), 1, iInstance, false) == EZ_SUCCESS);
+
+          uiInside += bInside ? 1 : 0;
+          ++iInstance;
+        }
+      }
+    }
+
+    EZ_TEST_INT(o.GetCount(), uiInside + iInstance);
+
+    // objects outside the tree are still found
+    ezDynamicArray<ezInt32> found;
+    o.FindObjectsInRange(c + ezVec3(-e - 99), 0.5f, CollectObject, &found);
+    EZ_TEST_INT(found.GetCount(), 1);
+  }
+
+  ezDynamicArray<ezLinearTreeObjectDesc> objects;
+  CreateRandomObjects(2000, 100.0f, 5.0f, objects);
+
+  ezLinearOctree tree;
+  tree.CreateTree(ezVec3::ZeroVector(), ezVec3(100.0f), 1.0f);
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "InsertObject / InsertObjects")
+  {
+    EZ_TEST_BOOL(tree.IsEmpty());
+
+    // half of the objects one by one, the other half in two batches, to test the merge
+    const ezUInt32 uiHalf = objects.GetCount() / 2;
+    for (ezUInt32 i = 0; i < uiHalf; ++i)
+    {
+      const auto& obj = objects[i];
+      EZ_TEST_BOOL(tree.InsertObject(obj.m_vCenter, obj.m_vHalfExtents, obj.m_iObjectType, obj.m_iObjectInstance).Succeeded());
+    }
+
+    EZ_TEST_INT(tree.InsertObjects(objects.GetArrayPtr().GetSubArray(uiHalf, 300)), 300);
+    EZ_TEST_INT(tree.InsertObjects(objects.GetArrayPtr().GetSubArray(uiHalf + 300)), objects.GetCount() - uiHalf - 300);
+
+    EZ_TEST_BOOL(!tree.IsEmpty());
+    EZ_TEST_INT(tree.GetCount(), objects.GetCount());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "FindObjectsInRange(Point)")
+  {
+    ezRandom rng;
+    rng.Initialize(1);
+
+    for (ezUInt32 q = 0; q < 100; ++q)
+    {
+      const ezVec3 vPoint(rng.FloatMinMax(-110, 110), rng.FloatMinMax(-110, 110), rng.FloatMinMax(-110, 110));
+
+      ezDynamicArray<ezInt32> found;
+      tree.FindObjectsInRange(vPoint, CollectObject, &found);
+
+      CheckQuery(objects, found, [&](const ezBoundingBox& box) { return box.Contains(vPoint); });
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "FindObjectsInRange(Radius)")
+  {
+    ezRandom rng;
+    rng.Initialize(2);
+
+    for (ezUInt32 q = 0; q < 100; ++q)
+    {
+      const ezVec3 vPoint(rng.FloatMinMax(-110, 110), rng.FloatMinMax(-110, 110), rng.FloatMinMax(-110, 110));
+      const float fRadius = rng.FloatMinMax(0, 50);
+
+      ezDynamicArray<ezInt32> found;
+      tree.FindObjectsInRange(vPoint, fRadius, CollectObject, &found);
+
+      CheckQuery(objects, found, [&](const ezBoundingBox& box) { return box.GetDistanceSquaredTo(vPoint) <= fRadius * fRadius; });
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "FindObjectsInBox")
+  {
+    ezRandom rng;
+    rng.Initialize(3);
+
+    for (ezUInt32 q = 0; q < 100; ++q)
+    {
+      ezBoundingBox queryBox;
+      queryBox.SetCenterAndHalfExtents(ezVec3(rng.FloatMinMax(-110, 110), rng.FloatMinMax(-110, 110), rng.FloatMinMax(-110, 110)),
+        ezVec3(rng.FloatMinMax(0, 50), rng.FloatMinMax(0, 50), rng.FloatMinMax(0, 50)));
+
+      ezDynamicArray<ezInt32> found;
+      tree.FindObjectsInBox(queryBox, CollectObject, &found);
+
+      CheckQuery(objects, found, [&](const ezBoundingBox& box) {
+        return box.m_vMax.x >= queryBox.m_vMin.x && box.m_vMin.x <= queryBox.m_vMax.x && box.m_vMax.y >= queryBox.m_vMin.y &&
+               box.m_vMin.y <= queryBox.m_vMax.y && box.m_vMax.z >= queryBox.m_vMin.z && box.m_vMin.z <= queryBox.m_vMax.z;
+      });
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "FindVisibleObjects")
+  {
+    ezRandom rng;
+    rng.Initialize(4);
+
+    for (ezUInt32 q = 0; q < 20; ++q)
+    {
+      const ezVec3 vPos(rng.FloatMinMax(-50, 50), rng.FloatMinMax(-50, 50), rng.FloatMinMax(-50, 50));
+      ezVec3 vDir(rng.FloatMinMax(-1, 1), rng.FloatMinMax(-1, 1), rng.FloatMinMax(-1, 1));
+      vDir.NormalizeIfNotZero(ezVec3(1, 0, 0));
+
+      ezFrustum frustum;
+      frustum.SetFrustum(vPos, vDir, vDir.GetOrthogonalVector(), ezAngle::Degree(60), ezAngle::Degree(45), 0.1f, 80.0f);
+
+      ezDynamicArray<ezInt32> found;
+      tree.FindVisibleObjects(frustum, CollectObject, &found);
+
+      CheckQuery(objects, found, [&](const ezBoundingBox& box) { return frustum.Overlaps(ezSimdConversion::ToBBox(box)); });
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "FindObjectsInRange(Batch)")
+  {
+    ezRandom rng;
+    rng.Initialize(5);
+
+    ezDynamicArray<ezVec3> points;
+    for (ezUInt32 q = 0; q < 50; ++q)
+    {
+      points.PushBack(ezVec3(rng.FloatMinMax(-30, 30), rng.FloatMinMax(-30, 30), rng.FloatMinMax(-30, 30)));
+    }
+
+    ezDynamicArray<ezDynamicArray<ezInt32>> batchResults;
+    batchResults.SetCount(points.GetCount());
+    tree.FindObjectsInRange(points, 10.0f, CollectBatchObject, &batchResults);
+
+    for (ezUInt32 q = 0; q < points.GetCount(); ++q)
+    {
+      ezDynamicArray<ezInt32> found;
+      tree.FindObjectsInRange(points[q], 10.0f, CollectObject, &found);
+      found.Sort();
+      batchResults[q].Sort();
+
+      EZ_TEST_BOOL(found == batchResults[q]);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "RemoveObject / RemoveObjectsOfType / RemoveAllObjects")
+  {
+    ezDynamicArray<ezInt32> found;
+    tree.FindObjectsInRange(objects[7].m_vCenter, CollectObject, &found);
+    EZ_TEST_BOOL(found.Contains(7));
+
+    tree.RemoveObject(objects[7].m_iObjectType, 7);
+    EZ_TEST_INT(tree.GetCount(), objects.GetCount() - 1);
+
+    found.Clear();
+    tree.FindObjectsInRange(objects[7].m_vCenter, CollectObject, &found);
+    EZ_TEST_BOOL(!found.Contains(7));
+
+    objects.RemoveAtAndCopy(7);
+
+    tree.RemoveObjectsOfType(1);
+
+    for (ezUInt32 i = objects.GetCount(); i > 0; --i)
+    {
+      if (objects[i - 1].m_iObjectType == 1)
+        objects.RemoveAtAndCopy(i - 1);
+    }
+
+    EZ_TEST_INT(tree.GetCount(), objects.GetCount());
+
+    // the order of the remaining objects must still be correct
+    found.Clear();
+    tree.FindObjectsInRange(ezVec3(10, 20, 30), 40.0f, CollectObject, &found);
+    CheckQuery(objects, found, [&](const ezBoundingBox& box) { return box.GetDistanceSquaredTo(ezVec3(10, 20, 30)) <= 40.0f * 40.0f; });
+
+    tree.RemoveAllObjects();
+    EZ_TEST_BOOL(tree.IsEmpty());
+    EZ_TEST_INT(tree.GetCount(), 0);
+  }
+}
+
+// Enable when needed
+#ifndef EZ_PERFORMANCE_TESTS_STATE
+#  define EZ_PERFORMANCE_TESTS_STATE ezTestBlock::DisabledNoWarning
+#endif
+
+EZ_CREATE_SIMPLE_TEST(DataStructures, LinearOctreePerformance)
+{
+  using namespace LinearOctreeTestDetail;
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
+  const ezUInt32 uiNumObjects = 10000;
+  const ezUInt32 uiNumQueries = 1000;
+#else
+  const ezUInt32 uiNumObjects = 100000;
+  const ezUInt32 uiNumQueries = 10000;
+#endif
+
+  // points, like the ones in ezPointOfInterestGraph
+  ezDynamicArray<ezLinearTreeObjectDesc> objects;
+  CreateRandomObjects(uiNumObjects, 500.0f, 0.0f, objects);
+
+  ezDynamicArray<ezVec3> queryPoints;
+  {
+    ezRandom rng;
+    rng.Initialize(7);
+
+    for (ezUInt32 i = 0; i < uiNumQueries; ++i)
+    {
+      queryPoints.PushBack(ezVec3(rng.FloatMinMax(-500, 500), rng.FloatMinMax(-500, 500), rng.FloatMinMax(-500, 500)));
+    }
+
+    // the batched queries work best for points that are close to each other, e.g. all agents of a group
+    queryPoints.Sort([](const ezVec3& a, const ezVec3& b) { return a.x < b.x; });
+  }
+
+  const float fRadius = 20.0f;
+
+  // ezDynamicOctree computes its node IDs with 32 bit, which overflows for deeper trees
+  const float fMinNodeSize = 10.0f;
+
+  EZ_TEST_BLOCK(EZ_PERFORMANCE_TESTS_STATE, "ezDynamicOctree")
+  {
+    ezDynamicOctree tree;
+    tree.CreateTree(ezVec3::ZeroVector(), ezVec3(500.0f), fMinNodeSize);
+
+    ezStopwatch sw;
+
+    for (const auto& obj : objects)
+    {
+      tree.InsertObject(obj.m_vCenter, obj.m_vHalfExtents, obj.m_iObjectType, obj.m_iObjectInstance, nullptr, true).IgnoreResult();
+    }
+
+    const ezTime tInsert = sw.Checkpoint();
+
+    ezUInt32 uiFound = 0;
+    for (const ezVec3& vPoint : queryPoints)
+    {
+      tree.FindObjectsInRange(vPoint, fRadius, CountDynamicObject, &uiFound);
+    }
+
+    const ezTime tQuery = sw.Checkpoint();
+
+    ezLog::Info("ezDynamicOctree: Insert {0} points: {1}ms, {2} queries: {3}ms, {4} candidates", uiNumObjects,
+      ezArgF(tInsert.GetMilliseconds(), 2), uiNumQueries, ezArgF(tQuery.GetMilliseconds(), 2), uiFound);
+  }
+
+  EZ_TEST_BLOCK(EZ_PERFORMANCE_TESTS_STATE, "ezLinearOctree")
+  {
+    ezLinearOctree tree;
+    tree.CreateTree(ezVec3::ZeroVector(), ezVec3(500.0f), fMinNodeSize);
+
+    ezStopwatch sw;
+
+    tree.InsertObjects(objects, true);
+
+    const ezTime tInsert = sw.Checkpoint();
+
+    ezUInt32 uiFound = 0;
+    for (const ezVec3& vPoint : queryPoints)
+    {
+      tree.FindObjectsInRange(vPoint, fRadius, CountObject, &uiFound);
+    }
+
+    const ezTime tQuery = sw.Checkpoint();
+
+    ezUInt32 uiFoundBatched = 0;
+    for (ezUInt32 i = 0; i < queryPoints.GetCount(); i += 16)
+    {
+      tree.FindObjectsInRange(queryPoints.GetArrayPtr().GetSubArray(i, ezMath::Min(16u, queryPoints.GetCount() - i)), fRadius,
+        CountBatchObject, &uiFoundBatched);
+    }
+
+    const ezTime tBatched = sw.Checkpoint();
+
+    EZ_TEST_INT(uiFound, uiFoundBatched);
+
+    ezLog::Info("ezLinearOctree: Insert {0} points: {1}ms, {2} queries: {3}ms, batched: {4}ms, {5} results", uiNumObjects,
+      ezArgF(tInsert.GetMilliseconds(), 2), uiNumQueries, ezArgF(tQuery.GetMilliseconds(), 2), ezArgF(tBatched.GetMilliseconds(), 2), uiFound);
+  }
+}
@@ -0,0 +1,89 @@
+#include <GameEngineTestPCH.h>
+
+#include <Foundation/Math/Random.h>
+#include <Utilities/DataStructures/LinearQuadtree.h>
+
+namespace LinearQuadtreeTestDetail
+{
+  static bool CollectObject(void* pPassThrough, const ezLinearTreeObject& Object)
+  {
+    static_cast<ezDynamicArray<ezInt32>*>(pPassThrough)->PushBack(Object.m_iObjectInstance);
+    return true;
+  }
+} // namespace LinearQuadtreeTestDetail
+
+EZ_CREATE_SIMPLE_TEST(DataStructures, LinearQuadtree)
+{
+  using namespace LinearQuadtreeTestDetail;
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "CreateTree / GetBoundingBox")
+  {
+    ezLinearQuadtree o;
+    o.CreateTree(ezVec3(100, 200, 300), ezVec3(300, 400, 500), 1.0f);
+
+    const ezBoundingBox& bb = o.GetBoundingBox();
+
+    EZ_TEST_VEC3(bb.GetCenter(), ezVec3(100, 200, 300), 0.01f);
+    EZ_TEST_VEC3(bb.GetHalfExtents(), ezVec3(500, 400, 500), 0.01f);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Insert Inside / Outside")
+  {
+    const ezVec3 c(100, 200, 300);
+    const float e = 50;
+
+    ezLinearQuadtree o;
+    o.CreateTree(c, ezVec3(e), 1.0f);
+
+    // the height is ignored
+    EZ_TEST_BOOL(o.InsertObject(c + ezVec3(0, 1000, 0), ezVec3(1.0f), 0, 0, true).Succeeded());
+    EZ_TEST_BOOL(o.InsertObject(c + ezVec3(0, 0, 1000), ezVec3(1.0f), 0, 1, true).Failed());
+    EZ_TEST_BOOL(o.InsertObject(c + ezVec3(1000, 0, 0), ezVec3(1.0f), 0, 2, true).Failed());
+    EZ_TEST_BOOL(o.InsertObject(c + ezVec3(1000, 0, 0), ezVec3(1.0f), 0, 3, false).Succeeded());
+
+    EZ_TEST_INT(o.GetCount(), 2);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "FindObjectsInRange")
+  {
+    ezRandom rng;
+    rng.Initialize(42);
+
+    ezDynamicArray<ezLinearTreeObjectDesc> objects;
+    objects.SetCount(1000);
+
+    for (ezUInt32 i = 0; i < objects.GetCount(); ++i)
+    {
+      auto& obj = objects[i];
+      obj.m_vCenter.Set(rng.FloatMinMax(-100, 100), rng.FloatMinMax(-500, 500), rng.FloatMinMax(-100, 100));
+      obj.m_vHalfExtents.Set(rng.FloatMinMax(0, 5), rng.FloatMinMax(0, 5), rng.FloatMinMax(0, 5));
+      obj.m_iObjectInstance = i;
+    }
+
+    ezLinearQuadtree o;
+    o.CreateTree(ezVec3::ZeroVector(), ezVec3(100, 10, 100), 1.0f);
+    EZ_TEST_INT(o.InsertObjects(objects, true), objects.GetCount());
+
+    for (ezUInt32 q = 0; q < 100; ++q)
+    {
+      const ezVec3 vPoint(rng.FloatMinMax(-110, 110), rng.FloatMinMax(-500, 500), rng.FloatMinMax(-110, 110));
+      const float fRadius = rng.FloatMinMax(0, 100);
+
+      ezDynamicArray<ezInt32> found;
+      o.FindObjectsInRange(vPoint, fRadius, CollectObject, &found);
+      found.Sort();
+
+      ezDynamicArray<ezInt32> expected;
+      for (const auto& obj : objects)
+      {
+        ezBoundingBox box;
+        box.SetCenterAndHalfExtents(obj.m_vCenter, obj.m_vHalfExtents);
+
+        if (box.GetDistanceSquaredTo(vPoint) <= fRadius * fRadius)
+          expected.PushBack(obj.m_iObjectInstance);
+      }
+
+      EZ_TEST_BOOL(found == expected);
+    }
+  }
+}
@@ -0,0 +1,375 @@
+#include <GameEngineTestPCH.h>
+
+#include <Foundation/Containers/Deque.h>
+#include <Foundation/Time/Stopwatch.h>
+#include <Utilities/PathFinding/GraphSearch.h>
+#include <Utilities/PathFinding/GridNavmesh.h>
+
+EZ_CREATE_SIMPLE_TEST_GROUP(PathFinding);
+
+namespace PathSearchTestDetail
+{
+  /// A grid where every cell is connected to its 4 neighbors, with walls that have a single gap at alternating ends.
+  class GridGraph : public ezPathStateGenerator<ezPathState>
+  {
+  public:
+    void Create(ezUInt16 uiSize, ezUInt32 uiWallDistance)
+    {
+      m_Grid.CreateGrid(uiSize, uiSize);
+
+      for (ezUInt32 i = 0; i < m_Grid.GetNumCells(); ++i)
+      {
+        m_Grid.GetCell(i) = 0;
+      }
+
+      for (ezUInt32 x = uiWallDistance; x < uiSize; x += uiWallDistance)
+      {
+        const ezUInt32 uiGap = ((x / uiWallDistance) % 2 == 0) ? 0 : uiSize - 1;
+
+        for (ezUInt32 y = 0; y < uiSize; ++y)
+        {
+          if (y != uiGap)
+            m_Grid.GetCell(ezVec2I32(x, y)) = 1;
+        }
+      }
+    }
+
+    bool IsBlocked(ezInt64 iNode) const { return m_Grid.GetCell(static_cast<ezUInt32>(iNode)) != 0; }
+
+    bool AreNeighbors(ezInt64 iNode1, ezInt64 iNode2) const
+    {
+      const ezVec2I32 c1 = m_Grid.ConvertCellIndexToCoordinate(static_cast<ezUInt32>(iNode1));
+      const ezVec2I32 c2 = m_Grid.ConvertCellIndexToCoordinate(static_cast<ezUInt32>(iNode2));
+      return ezMath::Abs(c1.x - c2.x) + ezMath::Abs(c1.y - c2.y) == 1;
+    }
+
+    /// Reference result: breadth-first search, all steps have the same costs.
+    ezInt32 ComputeShortestDistance(ezInt64 iStart, ezInt64 iTarget) const
+    {
+      ezDynamicArray<ezInt32> distances;
+      distances.SetCount(m_Grid.GetNumCells(), -1);
+
+      ezDeque<ezUInt32> queue;
+      queue.PushBack(static_cast<ezUInt32>(iStart));
+      distances[static_cast<ezUInt32>(iStart)] = 0;
+
+      while (!queue.IsEmpty())
+      {
+        const ezUInt32 uiCell = queue.PeekFront();
+        queue.PopFront();
+
+        if (uiCell == iTarget)
+          return distances[uiCell];
+
+        ezUInt32 neighbors[4];
+        const ezUInt32 uiNumNeighbors = GetNeighbors(uiCell, neighbors);
+
+        for (ezUInt32 i = 0; i < uiNumNeighbors; ++i)
+        {
+          if (distances[neighbors[i]] < 0)
+          {
+            distances[neighbors[i]] = distances[uiCell] + 1;
+            queue.PushBack(neighbors[i]);
+          }
+        }
+      }
+
+      return -1;
+    }
+
+    virtual void StartSearch(ezInt64 iStartNodeIndex, const ezPathState* pStartState, ezInt64 iTargetNodeIndex) override
+    {
+      m_vTarget = m_Grid.ConvertCellIndexToCoordinate(static_cast<ezUInt32>(iTargetNodeIndex));
+      m_bUseHeuristic = true;
+    }
+
+    virtual void StartSearchForClosest(ezInt64 iStartNodeIndex, const ezPathState* pStartState) override { m_bUseHeuristic = false; }
+
+    virtual void GenerateAdjacentStates(ezInt64 iNodeIndex, const ezPathState& StartState, ezPathSearch<ezPathState>* pPathSearch) override
+    {
+      ezUInt32 neighbors[4];
+      const ezUInt32 uiNumNeighbors = GetNeighbors(static_cast<ezUInt32>(iNodeIndex), neighbors);
+
+      for (ezUInt32 i = 0; i < uiNumNeighbors; ++i)
+      {
+        const ezVec2I32 c = m_Grid.ConvertCellIndexToCoordinate(neighbors[i]);
+
+        ezPathState state;
+        state.m_fCostToNode = StartState.m_fCostToNode + 1.0f;
+        state.m_fEstimatedCostToTarget = state.m_fCostToNode;
+
+        if (m_bUseHeuristic)
+          state.m_fEstimatedCostToTarget += ezMath::Abs(c.x - m_vTarget.x) + ezMath::Abs(c.y - m_vTarget.y);
+
+        pPathSearch->AddPathNode(neighbors[i], state);
+      }
+    }
+
+    ezUInt32 GetNeighbors(ezUInt32 uiCell, ezUInt32* pNeighbors) const
+    {
+      const ezVec2I32 c = m_Grid.ConvertCellIndexToCoordinate(uiCell);
+      const ezVec2I32 offsets[4] = {ezVec2I32(1, 0), ezVec2I32(-1, 0), ezVec2I32(0, 1), ezVec2I32(0, -1)};
+
+      ezUInt32 uiNumNeighbors = 0;
+      for (const ezVec2I32& offset : offsets)
+      {
+        const ezVec2I32 n = c + offset;
+
+        if (m_Grid.IsValidCellCoordinate(n) && m_Grid.GetCell(n) == 0)
+          pNeighbors[uiNumNeighbors++] = m_Grid.ConvertCellCoordinateToIndex(n);
+      }
+
+      return uiNumNeighbors;
+    }
+
+    ezGameGrid<ezUInt8> m_Grid;
+    ezVec2I32 m_vTarget;
+    bool m_bUseHeuristic = true;
+  };
+
+  static bool IsSameCellType(ezUInt32 uiCell1, ezUInt32 uiCell2, void* pPassThrough)
+  {
+    const ezGameGrid<ezUInt8>* pGrid = static_cast<const ezGameGrid<ezUInt8>*>(pPassThrough);
+    return pGrid->GetCell(uiCell1) == pGrid->GetCell(uiCell2);
+  }
+
+  static bool IsCellBlocked(ezUInt32 uiCell, void* pPassThrough)
+  {
+    return static_cast<const ezGameGrid<ezUInt8>*>(pPassThrough)->GetCell(uiCell) != 0;
+  }
+
+  /// Uses the convex areas of an ezGridNavmesh as the nodes, connected by the area edges.
+  class NavmeshGraph : public ezPathStateGenerator<ezPathState>
+  {
+  public:
+    void Create(const ezGameGrid<ezUInt8>& grid)
+    {
+      void* pGrid = const_cast<ezGameGrid<ezUInt8>*>(&grid);
+      m_Navmesh.CreateFromGrid(grid, IsSameCellType, pGrid, IsCellBlocked, pGrid);
+    }
+
+    ezVec2 GetAreaCenter(ezInt64 iArea) const
+    {
+      const ezRectU32& rect = m_Navmesh.GetConvexArea(static_cast<ezInt32>(iArea)).m_Rect;
+      return ezVec2(rect.x + rect.width * 0.5f, rect.y + rect.height * 0.5f);
+    }
+
+    virtual void StartSearch(ezInt64 iStartNodeIndex, const ezPathState* pStartState, ezInt64 iTargetNodeIndex) override
+    {
+      m_vTarget = GetAreaCenter(iTargetNodeIndex);
+    }
+
+    virtual void GenerateAdjacentStates(ezInt64 iNodeIndex, const ezPathState& StartState, ezPathSearch<ezPathState>* pPathSearch) override
+    {
+      const ezGridNavmesh::ConvexArea& area = m_Navmesh.GetConvexArea(static_cast<ezInt32>(iNodeIndex));
+      const ezVec2 vCenter = GetAreaCenter(iNodeIndex);
+
+      for (ezUInt32 e = 0; e < area.m_uiNumEdges; ++e)
+      {
+        const ezInt32 iNeighbor = m_Navmesh.GetAreaEdge(area.m_uiFirstEdge + e).m_iNeighborArea;
+        const ezVec2 vNeighborCenter = GetAreaCenter(iNeighbor);
+
+        ezPathState state;
+        state.m_fCostToNode = StartState.m_fCostToNode + ezMath::Max(0.01f, (vNeighborCenter - vCenter).GetLength());
+        state.m_fEstimatedCostToTarget = state.m_fCostToNode + (m_vTarget - vNeighborCenter).GetLength();
+
+        pPathSearch->AddPathNode(iNeighbor, state);
+      }
+    }
+
+    ezGridNavmesh m_Navmesh;
+    ezVec2 m_vTarget;
+  };
+
+  static GridGraph* s_pClosestGraph = nullptr;
+  static ezInt64 s_iClosestTarget = 0;
+
+  static bool IsClosestTarget(ezInt64 iStartNodeIndex, const ezPathState& StartState)
+  {
+    return iStartNodeIndex == s_iClosestTarget;
+  }
+
+  static bool IsInLastColumn(ezInt64 iStartNodeIndex, const ezPathState& StartState)
+  {
+    return s_pClosestGraph->m_Grid.ConvertCellIndexToCoordinate(static_cast<ezUInt32>(iStartNodeIndex)).x ==
+           s_pClosestGraph->m_Grid.GetGridSizeX() - 1;
+  }
+} // namespace PathSearchTestDetail
+
+EZ_CREATE_SIMPLE_TEST(PathFinding, PathSearch)
+{
+  using namespace PathSearchTestDetail;
+
+  GridGraph graph;
+  graph.Create(64, 8);
+
+  const ezUInt32 uiNumCells = graph.m_Grid.GetNumCells();
+  const ezUInt32 uiTopRight = graph.m_Grid.ConvertCellCoordinateToIndex(ezVec2I32(63, 63));
+
+  ezDeque<ezPathSearch<ezPathState>::PathResultData> path;
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "FindPath")
+  {
+    ezPathSearch<ezPathState> search;
+    search.SetPathStateGenerator(&graph);
+
+    ezPathSearch<ezPathState> denseSearch;
+    denseSearch.SetPathStateGenerator(&graph);
+    denseSearch.SetDenseNodeIndexRange(uiNumCells);
+
+    // the same objects are reused for all searches
+    for (ezUInt32 uiStart = 0; uiStart < uiNumCells; uiStart += 97)
+    {
+      if (graph.IsBlocked(uiStart))
+        continue;
+
+      const ezInt32 iDistance = graph.ComputeShortestDistance(uiStart, uiTopRight);
+
+      for (ezPathSearch<ezPathState>* pSearch : {&search, &denseSearch})
+      {
+        if (EZ_TEST_BOOL(pSearch->FindPath(uiStart, ezPathState(), uiTopRight, path).Succeeded()).Failed())
+          continue;
+
+        EZ_TEST_INT(path.GetCount(), iDistance + 1);
+        EZ_TEST_INT(path[0].m_iNodeIndex, uiStart);
+        EZ_TEST_INT(path.PeekBack().m_iNodeIndex, uiTopRight);
+        EZ_TEST_FLOAT(path.PeekBack().m_pPathState->m_fCostToNode, static_cast<float>(iDistance), 0.0f);
+
+        for (ezUInt32 i = 1; i < path.GetCount(); ++i)
+        {
+          EZ_TEST_BOOL(graph.AreNeighbors(path[i - 1].m_iNodeIndex, path[i].m_iNodeIndex));
+          EZ_TEST_BOOL(!graph.IsBlocked(path[i].m_iNodeIndex));
+        }
+      }
+    }
+
+    EZ_TEST_BOOL(search.FindPath(uiTopRight, ezPathState(), uiTopRight, path).Succeeded());
+    EZ_TEST_INT(path.GetCount(), 1);
+
+    // blocked target
+    EZ_TEST_BOOL(denseSearch.FindPath(0, ezPathState(), graph.m_Grid.ConvertCellCoordinateToIndex(ezVec2I32(8, 32)), path).Failed());
+
+    // too expensive
+    EZ_TEST_BOOL(denseSearch.FindPath(0, ezPathState(), uiTopRight, path, 50.0f).Failed());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "FindClosest")
+  {
+    s_pClosestGraph = &graph;
+
+    ezPathSearch<ezPathState> search;
+    search.SetPathStateGenerator(&graph);
+    search.SetDenseNodeIndexRange(uiNumCells / 2);
+
+    const ezUInt32 uiStart = graph.m_Grid.ConvertCellCoordinateToIndex(ezVec2I32(60, 2));
+    EZ_TEST_BOOL(search.FindClosest(uiStart, ezPathState(), IsInLastColumn, path).Succeeded());
+    EZ_TEST_INT(path.GetCount(), 4);
+    EZ_TEST_INT(path.PeekBack().m_iNodeIndex, graph.m_Grid.ConvertCellCoordinateToIndex(ezVec2I32(63, 2)));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Navmesh")
+  {
+    NavmeshGraph navmesh;
+    navmesh.Create(graph.m_Grid);
+
+    const ezInt32 iStartArea = navmesh.m_Navmesh.GetAreaAt(ezVec2I32(0, 0));
+    const ezInt32 iTargetArea = navmesh.m_Navmesh.GetAreaAt(ezVec2I32(63, 63));
+
+    ezPathSearch<ezPathState> search;
+    search.SetPathStateGenerator(&navmesh);
+    search.SetDenseNodeIndexRange(navmesh.m_Navmesh.GetNumConvexAreas());
+
+    EZ_TEST_BOOL(search.FindPath(iStartArea, ezPathState(), iTargetArea, path).Succeeded());
+    EZ_TEST_BOOL(path.GetCount() > 1);
+    EZ_TEST_INT(path.PeekBack().m_iNodeIndex, iTargetArea);
+  }
+}
+
+// Enable when needed
+#ifndef EZ_PERFORMANCE_TESTS_STATE
+#  define EZ_PERFORMANCE_TESTS_STATE ezTestBlock::DisabledNoWarning
+#endif
+
+EZ_CREATE_SIMPLE_TEST(PathFinding, PathSearchPerformance)
+{
+  using namespace PathSearchTestDetail;
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
+  const ezUInt16 gridSizes[] = {64, 256};
+#else
+  const ezUInt16 gridSizes[] = {64, 256, 1024};
+#endif
+
+  ezDeque<ezPathSearch<ezPathState>::PathResultData> path;
+
+  for (ezUInt16 uiSize : gridSizes)
+  {
+    // a single wall in the middle, with the gap at the far end, so that the search has to flood half of the grid
+    GridGraph graph;
+    graph.Create(uiSize, uiSize / 2);
+
+    const ezUInt32 uiTarget = graph.m_Grid.ConvertCellCoordinateToIndex(ezVec2I32(uiSize - 1, 0));
+
+    EZ_TEST_BLOCK(EZ_PERFORMANCE_TESTS_STATE, "Grid")
+    {
+      ezPathSearch<ezPathState> search;
+      search.SetPathStateGenerator(&graph);
+
+      ezPathSearch<ezPathState> denseSearch;
+      denseSearch.SetPathStateGenerator(&graph);
+      denseSearch.SetDenseNodeIndexRange(graph.m_Grid.GetNumCells());
+
+      for (ezPathSearch<ezPathState>* pSearch : {&search, &denseSearch})
+      {
+        ezStopwatch sw;
+
+        for (ezUInt32 i = 0; i < 10; ++i)
+        {
+          EZ_TEST_BOOL(pSearch->FindPath(i, ezPathState(), uiTarget, path).Succeeded());
+        }
+
+        ezLog::Info("[test]Grid {0}x{0}{1}: {2}ms per path, {3} steps", uiSize, pSearch == &denseSearch ? " (dense)" : "",
+          ezArgF(sw.GetRunningTotal().GetMilliseconds() / 10.0, 3), path.GetCount());
+      }
+
+      // without a heuristic the search expands in all directions and many more nodes wait in the queue
+      s_iClosestTarget = uiTarget;
+
+      for (ezPathSearch<ezPathState>* pSearch : {&search, &denseSearch})
+      {
+        ezStopwatch sw;
+
+        for (ezUInt32 i = 0; i < 10; ++i)
+        {
+          EZ_TEST_BOOL(pSearch->FindClosest(i, ezPathState(), IsClosestTarget, path).Succeeded());
+        }
+
+        ezLog::Info("[test]Grid {0}x{0}{1} without heuristic: {2}ms per path, {3} steps", uiSize, pSearch == &denseSearch ? " (dense)" : "",
+          ezArgF(sw.GetRunningTotal().GetMilliseconds() / 10.0, 3), path.GetCount());
+      }
+    }
+
+    EZ_TEST_BLOCK(EZ_PERFORMANCE_TESTS_STATE, "Navmesh")
+    {
+      NavmeshGraph navmesh;
+      navmesh.Create(graph.m_Grid);
+
+      const ezInt32 iStartArea = navmesh.m_Navmesh.GetAreaAt(ezVec2I32(0, 0));
+      const ezInt32 iTargetArea = navmesh.m_Navmesh.GetAreaAt(ezVec2I32(uiSize - 1, 0));
+
+      ezPathSearch<ezPathState> search;
+      search.SetPathStateGenerator(&navmesh);
+      search.SetDenseNodeIndexRange(navmesh.m_Navmesh.GetNumConvexAreas());
+
+      ezStopwatch sw;
+
+      for (ezUInt32 i = 0; i < 10; ++i)
+      {
+        EZ_TEST_BOOL(search.FindPath(iStartArea, ezPathState(), iTargetArea, path).Succeeded());
+      }
+
+      ezLog::Info("[test]Navmesh {0}x{0}, {1} areas: {2}ms per path, {3} steps", uiSize, navmesh.m_Navmesh.GetNumConvexAreas(),
+        ezArgF(sw.GetRunningTotal().GetMilliseconds() / 10.0, 3), path.GetCount());
+    }
+  }
+}
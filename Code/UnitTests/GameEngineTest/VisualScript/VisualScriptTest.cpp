@@ -0,0 +1,210 @@
+#include <GameEngineTestPCH.h>
+
+#include <Core/ResourceManager/ResourceManager.h>
+#include <Foundation/Time/Stopwatch.h>
+#include <GameEngine/VisualScript/Nodes/VisualScriptMathNodes.h>
+#include <GameEngine/VisualScript/Nodes/VisualScriptMessageNodes.h>
+#include <GameEngine/VisualScript/Nodes/VisualScriptVariableNodes.h>
+#include <GameEngine/VisualScript/VisualScriptInstance.h>
+#include <GameEngine/VisualScript/VisualScriptResource.h>
+
+namespace VisualScriptTestDetail
+{
+  static ezUInt16 AddNode(ezVisualScriptResourceDescriptor& desc, const ezRTTI* pType)
+  {
+    auto& node = desc.m_Nodes.ExpandAndGetRef();
+    node.m_pType = pType;
+    node.m_sTypeName = pType->GetTypeName();
+    node.m_uiFirstProperty = static_cast<ezUInt16>(desc.m_Properties.GetCount());
+
+    return static_cast<ezUInt16>(desc.m_Nodes.GetCount() - 1);
+  }
+
+  static void AddProperty(ezVisualScriptResourceDescriptor& desc, const char* szName, const ezVariant& value)
+  {
+    auto& prop = desc.m_Properties.ExpandAndGetRef();
+    prop.m_sName = szName;
+    prop.m_Value = value;
+
+    desc.m_Nodes.PeekBack().m_uiNumProperties++;
+  }
+
+  static void AddExecutionConnection(ezVisualScriptResourceDescriptor& desc, ezUInt16 uiSource, ezUInt8 uiOutput, ezUInt16 uiTarget, ezUInt8 uiInput)
+  {
+    auto& con = desc.m_ExecutionPaths.ExpandAndGetRef();
+    con.m_uiSourceNode = uiSource;
+    con.m_uiOutputPin = uiOutput;
+    con.m_uiTargetNode = uiTarget;
+    con.m_uiInputPin = uiInput;
+  }
+
+  static void AddNumberConnection(ezVisualScriptResourceDescriptor& desc, ezUInt16 uiSource, ezUInt8 uiOutput, ezUInt16 uiTarget, ezUInt8 uiInput)
+  {
+    auto& con = desc.m_DataPaths.ExpandAndGetRef();
+    con.m_uiSourceNode = uiSource;
+    con.m_uiOutputPin = uiOutput;
+    con.m_uiOutputPinType = ezVisualScriptDataPinType::Number;
+    con.m_uiTargetNode = uiTarget;
+    con.m_uiInputPin = uiInput;
+    con.m_uiInputPinType = ezVisualScriptDataPinType::Number;
+  }
+
+  /// \brief Every update: Counter = Counter * 1 + Increment * 1
+  static ezVisualScriptResourceHandle CreateCounterScript(const char* szResourceID, double fIncrement)
+  {
+    ezVisualScriptResourceHandle hScript = ezResourceManager::GetExistingResource<ezVisualScriptResource>(szResourceID);
+    if (hScript.IsValid())
+      return hScript;
+
+    ezVisualScriptResourceDescriptor desc;
+
+    const ezUInt16 uiUpdate = AddNode(desc, ezGetStaticRTTI<ezVisualScriptNode_ScriptUpdateEvent>());
+
+    const ezUInt16 uiStore = AddNode(desc, ezGetStaticRTTI<ezVisualScriptNode_StoreNumber>());
+    AddProperty(desc, "Name", "Counter");
+
+    const ezUInt16 uiRead = AddNode(desc, ezGetStaticRTTI<ezVisualScriptNode_Number>());
+    AddProperty(desc, "Name", "Counter");
+
+    const ezUInt16 uiMultiplyAdd = AddNode(desc, ezGetStaticRTTI<ezVisualScriptNode_MultiplyAdd>());
+    AddProperty(desc, "b1", fIncrement);
+
+    AddExecutionConnection(desc, uiUpdate, 0, uiStore, 0);
+    AddNumberConnection(desc, uiRead, 0, uiMultiplyAdd, 0);
+    AddNumberConnection(desc, uiMultiplyAdd, 0, uiStore, 0);
+
+    desc.PrecomputeMessageHandlers();
+
+    return ezResourceManager::CreateResource<ezVisualScriptResource>(szResourceID, std::move(desc));
+  }
+
+  static double GetCounter(ezVisualScriptInstance& instance)
+  {
+    double fValue = 0;
+    instance.GetLocalVariables().RetrieveDouble("Counter", fValue);
+    return fValue;
+  }
+} // namespace VisualScriptTestDetail
+
+EZ_CREATE_SIMPLE_TEST_GROUP(VisualScript);
+
+EZ_CREATE_SIMPLE_TEST(VisualScript, VisualScriptInstance)
+{
+  using namespace VisualScriptTestDetail;
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "ExecutionPlan")
+  {
+    ezVisualScriptResourceHandle hScript = CreateCounterScript("VisualScriptTest_Counter", 2.0);
+
+    ezResourceLock<ezVisualScriptResource> pScript(hScript, ezResourceAcquireMode::BlockTillLoaded);
+    const ezVisualScriptExecutionPlan& plan = pScript->GetExecutionPlan();
+
+    EZ_TEST_INT(plan.m_Nodes.GetCount(), 4);
+    EZ_TEST_INT(plan.m_ExecOutputs.GetCount(), 1);
+    EZ_TEST_INT(plan.m_DataConnections.GetCount(), 2);
+
+    // the store node depends on the multiply-add node, which depends on the number node
+    EZ_TEST_INT(plan.m_Nodes[1].m_uiNumDependencies, 1);
+    EZ_TEST_INT(plan.m_Nodes[3].m_uiNumDependencies, 1);
+    EZ_TEST_INT(plan.m_Nodes[2].m_uiNumDependencies, 0);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "ExecuteScript")
+  {
+    ezVisualScriptResourceHandle hScript = CreateCounterScript("VisualScriptTest_Counter", 2.0);
+
+    ezVisualScriptInstance instance1;
+    instance1.Configure(hScript, nullptr);
+
+    ezVisualScriptInstance instance2;
+    instance2.Configure(hScript, nullptr);
+
+    for (ezUInt32 i = 0; i < 10; ++i)
+    {
+      instance1.ExecuteScript();
+    }
+
+    instance2.ExecuteScript();
+
+    // the instances share the execution plan, but not their state
+    EZ_TEST_DOUBLE(GetCounter(instance1), 20.0, 0.0);
+    EZ_TEST_DOUBLE(GetCounter(instance2), 2.0, 0.0);
+
+    // reconfiguring resets the state
+    instance1.Configure(hScript, nullptr);
+    instance1.ExecuteScript();
+    EZ_TEST_DOUBLE(GetCounter(instance1), 2.0, 0.0);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "ezVisualScriptInstanceActivity")
+  {
+    ezVisualScriptResourceHandle hScript = CreateCounterScript("VisualScriptTest_Counter", 2.0);
+
+    ezVisualScriptInstance instance;
+    instance.Configure(hScript, nullptr);
+
+    ezVisualScriptInstanceActivity activity;
+    instance.ExecuteScript(&activity);
+
+    EZ_TEST_INT(activity.m_ActiveExecutionConnections.GetCount(), 1);
+    EZ_TEST_INT(activity.m_ActiveExecutionConnections[0], 0);
+
+    EZ_TEST_INT(activity.m_ActiveDataConnections.GetCount(), 2);
+    EZ_TEST_BOOL(activity.m_ActiveDataConnections.Contains((2 << 16) | 0));
+    EZ_TEST_BOOL(activity.m_ActiveDataConnections.Contains((3 << 16) | 0));
+  }
+
+  ezResourceManager::FreeAllUnusedResources();
+}
+
+// Enable when needed
+#ifndef EZ_PERFORMANCE_TESTS_STATE
+#  define EZ_PERFORMANCE_TESTS_STATE ezTestBlock::DisabledNoWarning
+#endif
+
+EZ_CREATE_SIMPLE_TEST(VisualScript, VisualScriptPerformance)
+{
+  using namespace VisualScriptTestDetail;
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
+  const ezUInt32 uiNumInstances = 1000;
+  const ezUInt32 uiNumExecutions = 10;
+#else
+  const ezUInt32 uiNumInstances = 10000;
+  const ezUInt32 uiNumExecutions = 100;
+#endif
+
+  EZ_TEST_BLOCK(EZ_PERFORMANCE_TESTS_STATE, "Instances / Executions")
+  {
+    ezVisualScriptResourceHandle hScript = CreateCounterScript("VisualScriptTest_Performance", 1.0);
+
+    ezDynamicArray<ezVisualScriptInstance> instances;
+    instances.SetCount(uiNumInstances);
+
+    ezStopwatch sw;
+
+    for (auto& instance : instances)
+    {
+      instance.Configure(hScript, nullptr);
+    }
+
+    const ezTime tConfigure = sw.Checkpoint();
+
+    for (ezUInt32 i = 0; i < uiNumExecutions; ++i)
+    {
+      for (auto& instance : instances)
+      {
+        instance.ExecuteScript();
+      }
+    }
+
+    const ezTime tExecute = sw.Checkpoint();
+
+    EZ_TEST_DOUBLE(GetCounter(instances.PeekBack()), (double)uiNumExecutions, 0.0);
+
+    ezLog::Info("Visual script: {0} instances/ms, {1} executions/ms", ezArgF(uiNumInstances / tConfigure.GetMilliseconds(), 1),
+      ezArgF(uiNumInstances * uiNumExecutions / tExecute.GetMilliseconds(), 1));
+  }
+
+  ezResourceManager::FreeAllUnusedResources();
+}